@@ -0,0 +1,172 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+/** @file:   dora_ycsb.h
+ *
+ *  @brief:  The DORA YCSB class
+ */
+
+
+#ifndef __DORA_YCSB_H
+#define __DORA_YCSB_H
+
+
+#include <cstdio>
+
+#include "tls.h"
+
+#include "util.h"
+#include "workload/ycsb/shore_ycsb_env.h"
+#include "dora/dora_env.h"
+#include "dora.h"
+
+using namespace shore;
+using namespace ycsb;
+
+
+ENTER_NAMESPACE(dora);
+
+
+
+// Forward declarations
+
+// YCSB Read
+class final_rd_rvp;
+class r_ut_rd_action;
+
+// YCSB Update
+class final_up_rvp;
+class upd_ut_up_action;
+
+// YCSB Insert
+class final_in_rvp;
+class ins_ut_in_action;
+
+// YCSB Scan
+class final_sc_rvp;
+class r_ut_sc_action;
+
+// YCSB ReadModifyWrite
+class final_rmw_rvp;
+class upd_ut_rmw_action;
+
+
+/********************************************************************
+ *
+ * @class: dora_ycsb
+ *
+ * @brief: Container class for all the data partitions for the YCSB database
+ *
+ ********************************************************************/
+
+class DoraYCSBEnv : public ShoreYCSBEnv, public DoraEnv
+{
+public:
+
+    DoraYCSBEnv();
+    virtual ~DoraYCSBEnv();
+
+    //// Control Database
+
+    // {Start/Stop} the system; Resume/Pause come from ShoreYCSBEnv
+    int start();
+    int stop();
+    w_rc_t newrun();
+    int set(envVarMap* /* vars */) { return(0); /* do nothing */ };
+    int dump();
+    int info() const;
+    int statistics();
+    int conf();
+
+
+    //// Partition-related
+    w_rc_t update_partitioning();
+
+
+    //// DORA YCSB - PARTITIONED TABLES
+
+    DECLARE_DORA_PARTS(ut);  // Usertable
+
+
+    //// DORA YCSB - TRXs
+
+
+    //////////
+    // Read //
+    //////////
+
+    DECLARE_DORA_TRX(read_rec);
+
+    DECLARE_DORA_FINAL_RVP_GEN_FUNC(final_rd_rvp);
+
+    DECLARE_DORA_ACTION_GEN_FUNC(r_ut_rd_action,rvp_t,read_rec_input_t);
+
+
+    ////////////
+    // Update //
+    ////////////
+
+    DECLARE_DORA_TRX(update_rec);
+
+    DECLARE_DORA_FINAL_RVP_GEN_FUNC(final_up_rvp);
+
+    DECLARE_DORA_ACTION_GEN_FUNC(upd_ut_up_action,rvp_t,update_rec_input_t);
+
+
+    ////////////
+    // Insert //
+    ////////////
+
+    DECLARE_DORA_TRX(insert_rec);
+
+    DECLARE_DORA_FINAL_RVP_GEN_FUNC(final_in_rvp);
+
+    DECLARE_DORA_ACTION_GEN_FUNC(ins_ut_in_action,rvp_t,insert_rec_input_t);
+
+
+    //////////
+    // Scan //
+    //////////
+
+    DECLARE_DORA_TRX(scan_rec);
+
+    DECLARE_DORA_FINAL_RVP_GEN_FUNC(final_sc_rvp);
+
+    DECLARE_DORA_ACTION_GEN_FUNC(r_ut_sc_action,rvp_t,scan_rec_input_t);
+
+
+    /////////////////////
+    // ReadModifyWrite //
+    /////////////////////
+
+    DECLARE_DORA_TRX(rmw_rec);
+
+    DECLARE_DORA_FINAL_RVP_GEN_FUNC(final_rmw_rvp);
+
+    DECLARE_DORA_ACTION_GEN_FUNC(upd_ut_rmw_action,rvp_t,rmw_rec_input_t);
+
+}; // EOF: DoraYCSBEnv
+
+
+EXIT_NAMESPACE(dora);
+
+#endif // __DORA_YCSB_H
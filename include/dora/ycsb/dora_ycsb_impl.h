@@ -0,0 +1,145 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+/** @file:   dora_ycsb_impl.h
+ *
+ *  @brief:  DORA YCSB TRXs
+ *
+ *  @note:   Definition of RVPs and Actions that synthesize (according to DORA)
+ *           the YCSB trxs
+ */
+
+
+#ifndef __DORA_YCSB_IMPL_H
+#define __DORA_YCSB_IMPL_H
+
+
+#include "dora.h"
+#include "workload/ycsb/shore_ycsb_env.h"
+#include "dora/ycsb/dora_ycsb.h"
+
+using namespace shore;
+using namespace ycsb;
+
+
+ENTER_NAMESPACE(dora);
+
+
+// Each YCSB operation touches a single record (or, for the scan, a
+// single range of records), so each transaction is one action and
+// its final RVP.
+
+
+/********************************************************************
+ *
+ * DORA YCSB READ
+ *
+ ********************************************************************/
+
+DECLARE_DORA_FINAL_RVP_CLASS(final_rd_rvp,DoraYCSBEnv,1,1);
+
+DECLARE_DORA_ACTION_NO_RVP_CLASS(r_ut_rd_action,int,DoraYCSBEnv,read_rec_input_t,1);
+
+
+
+/********************************************************************
+ *
+ * DORA YCSB UPDATE
+ *
+ ********************************************************************/
+
+DECLARE_DORA_FINAL_RVP_CLASS(final_up_rvp,DoraYCSBEnv,1,1);
+
+DECLARE_DORA_ACTION_NO_RVP_CLASS(upd_ut_up_action,int,DoraYCSBEnv,update_rec_input_t,1);
+
+
+
+/********************************************************************
+ *
+ * DORA YCSB INSERT
+ *
+ ********************************************************************/
+
+// As DECLARE_DORA_FINAL_RVP_CLASS, but it keeps the inserted key to
+// note whether it committed (see ycsb_insert_done())
+class final_in_rvp : public terminal_rvp_t
+{
+private:
+    typedef object_cache_t<final_in_rvp> rvp_cache;
+    DoraYCSBEnv* _penv;
+    rvp_cache* _cache;
+    int _key;
+public:
+    final_in_rvp() : terminal_rvp_t(), _penv(NULL), _cache(NULL), _key(-1) { }
+    ~final_in_rvp() { _cache=NULL; _penv=NULL; }
+
+    // access methods
+    inline void set(xct_t* axct, const tid_t& atid, const int axctid,
+                    trx_result_tuple_t& presult,
+                    DoraYCSBEnv* penv, rvp_cache* pc)
+    {
+        assert (penv);
+        _penv = penv;
+        assert (pc);
+        _cache = pc;
+        _key = -1;
+        _set(penv->db(),penv,axct,atid,axctid,presult,1,1);
+    }
+    inline void set_key(const int key) { _key = key; }
+    inline void giveback() { _cache->giveback(this); }
+
+    // interface
+    void upd_committed_stats(); // update the committed trx stats
+    void upd_aborted_stats(); // update the aborted trx stats
+
+}; // EOF: final_in_rvp
+
+DECLARE_DORA_ACTION_NO_RVP_CLASS(ins_ut_in_action,int,DoraYCSBEnv,insert_rec_input_t,1);
+
+
+
+/********************************************************************
+ *
+ * DORA YCSB SCAN
+ *
+ ********************************************************************/
+
+DECLARE_DORA_FINAL_RVP_CLASS(final_sc_rvp,DoraYCSBEnv,1,1);
+
+DECLARE_DORA_ACTION_NO_RVP_CLASS(r_ut_sc_action,int,DoraYCSBEnv,scan_rec_input_t,1);
+
+
+
+/********************************************************************
+ *
+ * DORA YCSB READ-MODIFY-WRITE
+ *
+ ********************************************************************/
+
+DECLARE_DORA_FINAL_RVP_CLASS(final_rmw_rvp,DoraYCSBEnv,1,1);
+
+DECLARE_DORA_ACTION_NO_RVP_CLASS(upd_ut_rmw_action,int,DoraYCSBEnv,rmw_rec_input_t,1);
+
+
+EXIT_NAMESPACE(dora);
+
+#endif /** __DORA_YCSB_IMPL_H */
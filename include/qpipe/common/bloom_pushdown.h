@@ -0,0 +1,132 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   bloom_pushdown.h
+ *
+ *  @brief:  Bloom filters pushed from the build side of a hash join
+ *           into the scan that feeds its probe side
+ */
+
+#ifndef __QPIPE_BLOOM_PUSHDOWN_H
+#define __QPIPE_BLOOM_PUSHDOWN_H
+
+#include "qpipe/core/functors.h"
+#include "qpipe/core/memory_manager.h"
+#include "util/bloom_filter.h"
+#include "util/fnv.h"
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+/* Global switch ("qpipe-bloom-pushdown" in the config file) */
+bool bloom_pushdown_enabled();
+void set_bloom_pushdown(bool enabled);
+
+
+
+/**
+ *  @brief Output filter of a probe-side scan once a hash join pushed
+ *  its Bloom filter into it. The original filter selects and
+ *  projects as before; tuples whose projected join key is not in the
+ *  Bloom filter are then dropped before they reach the tuple_fifo.
+ *
+ *  The key is hashed with fnv_hash(), like the hash join does when it
+ *  builds the filter.
+ */
+class bloom_pushdown_filter_t : public tuple_filter_t
+{
+    /* not owned, packets never delete their output filter */
+    tuple_filter_t* _base;
+    bloom_filter_t* _bloom;
+
+    /* the Bloom filter's bytes, charged to the query while we hold it */
+    memory_grant_t _memory;
+    query_memory_t* _query;
+
+    size_t _out_size;
+    size_t _key_offset;
+    size_t _key_size;
+
+    /* select() projects here, project() copies it out */
+    char*  _scratch;
+
+    size_t _checked;
+    size_t _dropped;
+
+public:
+
+    /**
+     *  @param base The current output filter of the scan.
+     *
+     *  @param bloom The filter over the build keys. We take ownership.
+     *
+     *  @param out_size The size of the tuples (base) projects.
+     *
+     *  @param key_offset, key_size Where the join key lives in the
+     *  projected tuple.
+     *
+     *  @param memory The query the Bloom filter is charged to, if any.
+     *  The charge is forced: the filter already exists.
+     */
+    bloom_pushdown_filter_t(tuple_filter_t* base, bloom_filter_t* bloom,
+                            size_t out_size, size_t key_offset, size_t key_size,
+                            query_memory_t* memory=NULL);
+    bloom_pushdown_filter_t(bloom_pushdown_filter_t const &other);
+    virtual ~bloom_pushdown_filter_t();
+
+    virtual bool select(const tuple_t &src) {
+        if (!_base->select(src))
+            return (false);
+
+        tuple_t out(_scratch, _out_size);
+        _base->project(out, src);
+        _checked++;
+        if (!_bloom->may_contain(fnv_hash(_scratch + _key_offset, _key_size))) {
+            _dropped++;
+            return (false);
+        }
+        return (true);
+    }
+
+    /* only ever called right after a successful select() */
+    virtual void project(tuple_t &dest, const tuple_t &) {
+        dest.assign(tuple_t(_scratch, _out_size));
+    }
+
+    virtual tuple_filter_t* clone() const {
+        return new bloom_pushdown_filter_t(*this);
+    }
+
+    virtual c_str to_string() const;
+
+private:
+
+    bloom_pushdown_filter_t &operator =(bloom_pushdown_filter_t const &);
+
+}; // EOF: bloom_pushdown_filter_t
+
+
+EXIT_NAMESPACE(qpipe);
+
+#endif /** __QPIPE_BLOOM_PUSHDOWN_H */
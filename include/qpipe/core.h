@@ -26,11 +26,15 @@
 
 #include "qpipe/core/cpu_bind.h"
 #include "qpipe/core/dispatcher.h"
+#include "qpipe/core/memory_manager.h"
 #include "qpipe/core/functors.h"
 #include "qpipe/core/packet.h"
+#include "qpipe/core/query_profile.h"
 #include "qpipe/core/stage.h"
 #include "qpipe/core/stage_container.h"
 #include "qpipe/core/tuple.h"
+#include "qpipe/core/recycling_page_pool.h"
 #include "qpipe/core/tuple_fifo.h"
+#include "qpipe/core/tuple_fifo_bench.h"
 
 #endif
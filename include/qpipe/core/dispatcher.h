@@ -27,6 +27,7 @@
 #include "qpipe/core/tuple.h"
 #include "qpipe/core/packet.h"
 #include "qpipe/core/stage_container.h"
+#include "qpipe/core/memory_manager.h"
 #include "util/resource_declare.h"
 #include "util/resource_releaser.h"
 #include <map>
@@ -143,7 +144,7 @@ public:
     }
 
     /* worker thread methods */
-    static worker_reserver_t* reserver_acquire();
+    static worker_reserver_t* reserver_acquire(query_memory_t* memory=NULL);
     static void reserver_release(worker_reserver_t* wr);
     static worker_releaser_t* releaser_acquire();
     static void releaser_release(worker_releaser_t* wr);
@@ -158,18 +159,28 @@ private:
 
     dispatcher_t*   _dispatcher;
     map<c_str, int> _worker_needs;
+
+    /* memory account of the query (may be NULL) and its needs */
+    query_memory_t* _memory;
+    size_t          _memory_needs;
     
 public:
 
-    worker_reserver_t (dispatcher_t* dispatcher)
-        : _dispatcher(dispatcher)
+    worker_reserver_t (dispatcher_t* dispatcher, query_memory_t* memory=NULL)
+        : _dispatcher(dispatcher), _memory(memory), _memory_needs(0)
     {
     }
+
+    ~worker_reserver_t();
     
     virtual void declare(const c_str& name, int count) {
         int curr_needs = _worker_needs[name];
         _worker_needs[name] = curr_needs + count;
     }
+
+    virtual void declare_memory(size_t bytes) {
+        _memory_needs += bytes;
+    }
     
     void acquire_resources();
 };
@@ -0,0 +1,242 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   memory_manager.h
+ *
+ *  @brief:  Global memory budget and admission control for QPipe
+ *           queries
+ */
+
+#ifndef __QPIPE_MEMORY_MANAGER_H
+#define __QPIPE_MEMORY_MANAGER_H
+
+#include "util.h"
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+class memory_manager_t;
+
+
+/**
+ *  @brief The memory account of one query. Every query_state_t owns
+ *  one. Consumers (tuple_fifos, hash join partitions, sort runs) ask
+ *  the account for memory before they grow; a refused grant means
+ *  "spill instead".
+ *
+ *  A query may use up to the amount it was admitted with. Beyond
+ *  that it may borrow whatever part of the global budget is not
+ *  reserved by other queries.
+ *
+ *  The account is reference counted because consumers, for example
+ *  the input buffers of a stage that finishes early, may outlive the
+ *  query_state_t that created it.
+ */
+class query_memory_t
+{
+    friend class memory_manager_t;
+
+    memory_manager_t* _manager;
+    volatile unsigned _refs;
+
+    /* protected by the manager lock */
+    size_t _declared;
+    size_t _reserved;
+    size_t _used;
+    size_t _peak;
+    size_t _grants;
+    size_t _denied;
+    size_t _spills;
+    bool   _admitted;
+
+public:
+
+    query_memory_t();
+
+    void acquire_ref();
+    void release_ref();
+
+    /**
+     *  @brief Ask for (bytes) more memory. With (force) the grant
+     *  always succeeds, even if it takes the query over budget; use
+     *  it for the minimum a consumer needs to make progress.
+     *
+     *  @return false if the consumer should spill instead
+     */
+    bool grant(size_t bytes, bool force=false);
+
+    void release(size_t bytes);
+
+    /* a consumer went to disk because grant() failed */
+    void note_spill();
+
+    size_t used() const { return (_used); }
+    size_t peak() const { return (_peak); }
+
+    void trace_stats(const char* label) const;
+
+private:
+
+    ~query_memory_t() { }
+
+    query_memory_t(query_memory_t const &);
+    query_memory_t &operator =(query_memory_t const &);
+};
+
+
+
+/**
+ *  @brief Memory charged to one consumer. Attached to the query
+ *  account (or to nothing, in which case every grant succeeds) and
+ *  gives everything back when destroyed.
+ */
+class memory_grant_t
+{
+    query_memory_t* _memory;
+    size_t          _bytes;
+
+public:
+
+    memory_grant_t(query_memory_t* memory=NULL)
+        : _memory(NULL), _bytes(0)
+    {
+        attach(memory);
+    }
+
+    ~memory_grant_t() {
+        detach();
+    }
+
+    void attach(query_memory_t* memory) {
+        detach();
+        _memory = memory;
+        if (_memory)
+            _memory->acquire_ref();
+    }
+
+    void detach() {
+        if (_memory) {
+            if (_bytes)
+                _memory->release(_bytes);
+            _memory->release_ref();
+        }
+        _memory = NULL;
+        _bytes = 0;
+    }
+
+    bool grow(size_t bytes, bool force=false) {
+        if (_memory && !_memory->grant(bytes, force))
+            return (false);
+        _bytes += bytes;
+        return (true);
+    }
+
+    void shrink(size_t bytes) {
+        assert(bytes <= _bytes);
+        if (_memory)
+            _memory->release(bytes);
+        _bytes -= bytes;
+    }
+
+    void note_spill() {
+        if (_memory)
+            _memory->note_spill();
+    }
+
+    size_t bytes() const { return (_bytes); }
+
+private:
+
+    memory_grant_t(memory_grant_t const &);
+    memory_grant_t &operator =(memory_grant_t const &);
+};
+
+
+
+/**
+ *  @brief Owner of the global QPipe memory budget.
+ *
+ *  Queries are admitted in arrival order: a query whose declared
+ *  needs do not fit next to the reservations of the running queries
+ *  waits, and so does every query that arrives after it. Needs larger
+ *  than the whole budget are clamped to it, so that every query can
+ *  eventually run alone. A budget of 0 means unlimited; accounting
+ *  still happens so that per-query statistics are available.
+ *
+ *  Like the dispatcher this is a singleton with static wrappers.
+ */
+class memory_manager_t
+{
+    friend class query_memory_t;
+
+    static memory_manager_t _instance;
+
+    pthread_mutex_t _lock;
+    pthread_cond_t  _admission;
+
+    size_t _budget;
+    size_t _reserved;  /* sum of the reservations of admitted queries */
+    size_t _overflow;  /* memory used beyond those reservations */
+    size_t _peak;
+
+    /* FIFO admission tickets */
+    unsigned _next_ticket;
+    unsigned _now_serving;
+    unsigned _queued;
+
+    memory_manager_t();
+    ~memory_manager_t();
+
+public:
+
+    /* 0 means unlimited */
+    static void set_budget(size_t bytes);
+    static size_t budget();
+
+    static void admit(query_memory_t* memory, size_t declared);
+    static void release(query_memory_t* memory);
+
+    static void trace_stats();
+
+private:
+
+    static size_t _over(size_t used, size_t reserved) {
+        return (used > reserved? used - reserved : 0);
+    }
+
+    bool _fits(size_t bytes) const {
+        return (!_budget || (_reserved + _overflow + bytes <= _budget));
+    }
+
+    bool _grant(query_memory_t* memory, size_t bytes, bool force);
+    void _release(query_memory_t* memory, size_t bytes);
+
+    memory_manager_t(memory_manager_t const &);
+    memory_manager_t &operator =(memory_manager_t const &);
+};
+
+
+EXIT_NAMESPACE(qpipe);
+
+#endif /** __QPIPE_MEMORY_MANAGER_H */
@@ -53,6 +53,8 @@ void set_osp_for_type(const c_str& packet_type, bool osp_switch);
 class   packet_t;
 typedef list<packet_t*> packet_list_t;
 
+struct packet_profile_t;
+
 struct query_plan {
     c_str action;
     c_str filter;
@@ -67,6 +69,19 @@ struct query_plan {
 
 
 
+/**
+ *  @brief Walks the packets of a plan. Passed to
+ *  declare_worker_needs(), it sees every packet that declares itself
+ *  and ignores the resources.
+ */
+struct packet_declare_t : public resource_declare_t
+{
+    virtual void declare(const c_str&, int) { }
+    virtual void declare_packet(packet_t* packet)=0;
+};
+
+
+
 /**
  *  @brief A packet in QPIPE is a unit of work that can be processed
  *  by a stage's worker thread.
@@ -144,6 +159,15 @@ public:
     //MA: Dirty solution to avoid the double-free bug.
     tuple_filter_t* _output_filter;
 
+private:
+    /* a filter pushed down into us by our consumer; unlike the
+       original output filter we own it */
+    guard<tuple_filter_t> _pushed_filter;
+
+    /* our node in the query's profile, if it is being profiled */
+    packet_profile_t* _profile;
+
+public:
     
     /** Should be set to the stage's _stage_next_tuple field when this
 	packet is merged into the stage. Should be initialized to 0
@@ -223,17 +247,64 @@ public:
 
     void assign_query_state(query_state_t* qstate) {
         _qstate = qstate;
+        /* our output buffer now draws on the query's memory */
+        if (qstate && _output_buffer)
+            _output_buffer->set_memory_account(qstate->memory());
     }
 
     query_state_t* get_query_state() {
         return _qstate;
     }
 
+    /* memory account of our query, NULL if we have no query state */
+    query_memory_t* query_memory() {
+        return _qstate? _qstate->memory() : NULL;
+    }
+
     bool unreserve_worker_on_completion() {
         return _unreserve_on_completion;
     }
     
+    /**
+     *  @brief Bytes this packet expects to hold while it runs. Used for
+     *  admission control; by default the in-memory capacity of the
+     *  output buffer.
+     */
+    virtual size_t memory_needs() {
+        return _output_buffer? _output_buffer->memory_capacity() : 0;
+    }
+
     virtual void declare_worker_needs(resource_declare_t* declare)=0;
+
+    /**
+     *  @brief Whether our consumer may push a filter into us (see
+     *  push_down_filter()). Only packets whose stage runs every tuple
+     *  it produces through the output filter, such as table scans,
+     *  should say yes.
+     */
+    virtual bool accepts_pushdown() {
+        return false;
+    }
+
+    void push_down_filter(tuple_filter_t* filter);
+
+    packet_profile_t* profile() {
+        return _profile;
+    }
+
+    void set_profile(packet_profile_t* profile);
+
+protected:
+
+    /* Declares the worker and the memory needed by this packet
+       alone. Subclasses recurse into their inputs themselves. */
+    void declare_self(resource_declare_t* declare) {
+        packet_declare_t* walker = dynamic_cast<packet_declare_t*>(declare);
+        if (walker != NULL)
+            walker->declare_packet(this);
+        declare->declare(_packet_type, 1);
+        declare->declare_memory(memory_needs());
+    }
 };
 
 
@@ -0,0 +1,139 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   page_ring.h
+ *
+ *  @brief:  Lock-free single-producer/single-consumer ring of pages
+ */
+
+#ifndef __QPIPE_PAGE_RING_H
+#define __QPIPE_PAGE_RING_H
+
+#include "qpipe/core/tuple.h"
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+/**
+ *  @brief Bounded ring of page pointers with exactly one producer
+ *  and exactly one consumer. Neither side ever blocks or takes a
+ *  lock; push() fails when the ring is full and pop() returns NULL
+ *  when it is empty. Blocking (if any) is the caller's business.
+ *
+ *  The head and tail counters grow monotonically and are masked on
+ *  access, so size() is simply (tail - head). They live on separate
+ *  cache lines so the two threads do not false-share.
+ */
+class page_ring
+{
+    enum { PADDING = 64 };
+
+    page**          _slots;
+    size_t          _mask;
+
+    char            _pad0[PADDING];
+    volatile size_t _head; /* written only by the consumer */
+    char            _pad1[PADDING - sizeof(size_t)];
+    volatile size_t _tail; /* written only by the producer */
+    char            _pad2[PADDING - sizeof(size_t)];
+
+public:
+
+    /**
+     *  @brief Creates a ring that can hold at least (capacity)
+     *  pages. The actual capacity is rounded up to a power of two.
+     */
+    page_ring(size_t capacity)
+        : _slots(NULL), _mask(0), _head(0), _tail(0)
+    {
+        size_t cap = 1;
+        while (cap < capacity)
+            cap <<= 1;
+        _slots = new page*[cap];
+        _mask = cap - 1;
+    }
+
+    ~page_ring() {
+        delete [] _slots;
+    }
+
+    size_t capacity() const {
+        return _mask + 1;
+    }
+
+    /* Exact when called by either endpoint, a snapshot otherwise */
+    size_t size() const {
+        return *&_tail - *&_head;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     *  @brief Producer only. Publishes (p) to the consumer.
+     *
+     *  @return false if the ring is full
+     */
+    bool push(page* p) {
+        size_t tail = _tail;
+        if (tail - *&_head > _mask)
+            return false;
+        _slots[tail & _mask] = p;
+        /* the slot must be visible before the new tail */
+        membar_producer();
+        _tail = tail + 1;
+        return true;
+    }
+
+    /**
+     *  @brief Consumer only. Removes the oldest page.
+     *
+     *  @return NULL if the ring is empty
+     */
+    page* pop() {
+        size_t head = _head;
+        if (head == *&_tail)
+            return NULL;
+        /* do not read the slot before we have seen the tail */
+        membar_consumer();
+        page* p = _slots[head & _mask];
+        /* the slot must be read before the producer may reuse it */
+        membar_exit();
+        _head = head + 1;
+        return p;
+    }
+
+private:
+
+    page_ring(page_ring const &);
+    page_ring &operator =(page_ring const &);
+
+}; // EOF: page_ring
+
+
+EXIT_NAMESPACE(qpipe);
+
+
+#endif
@@ -0,0 +1,178 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   query_profile.h
+ *
+ *  @brief:  Per-packet execution profile ("EXPLAIN ANALYZE") of a
+ *           QPipe query
+ */
+
+#ifndef __QPIPE_QUERY_PROFILE_H
+#define __QPIPE_QUERY_PROFILE_H
+
+#include "util/command/command_handler.h"
+#include "util/stopwatch.h"
+#include "qpipe/core/packet.h"
+
+#include <string>
+#include <vector>
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+class query_profile_t;
+
+
+/**
+ *  @brief What one packet of a profiled query did. The stage adaptor
+ *  fills in the time spent in process_packet() (primary packets
+ *  only), the dispatcher whether the packet merged, and the packet's
+ *  output tuple_fifo the tuples, pages, blocking and spills. The
+ *  reader side of that fifo reports how long the consumer waited,
+ *  which is the consumer's time blocked on input.
+ */
+struct packet_profile_t
+{
+    query_profile_t*  _query;
+    c_str             _packet_id;
+    c_str             _packet_type;
+    c_str             _action;
+    query_plan const* _plan;     /* only valid until attach() returns */
+    std::vector<packet_profile_t*> _children;
+    bool              _has_parent;
+
+    /* stage */
+    int       _runs;
+    long long _wall_us;
+    long long _cpu_us;
+    bool      _merged;
+    c_str     _merged_into;
+
+    /* output tuple_fifo, writer side */
+    size_t    _tuples_out;
+    size_t    _pages_out;
+    size_t    _spill_bytes;
+    long long _blocked_out_us;
+
+    /* output tuple_fifo, reader side */
+    long long _consumer_wait_us;
+
+    packet_profile_t(query_profile_t* query, packet_t* packet);
+};
+
+
+
+/**
+ *  @brief Profile of one query: one packet_profile_t per packet of
+ *  the plan, linked into a tree through the packets' query_plans.
+ *
+ *  Packets and their output tuple_fifos keep a reference on the
+ *  profile since they outlive the query's result loop. When the last
+ *  reference goes away every stage is done, and the profile renders
+ *  itself (see last_query_profile()).
+ */
+class query_profile_t
+{
+    pthread_mutex_t _lock;
+    volatile unsigned _refs;
+
+    c_str _name;
+    query_memory_t* _memory;
+
+    std::vector<packet_profile_t*> _packets;
+    stopwatch_t _timer;
+    long long   _wall_us;
+
+public:
+
+    /* (memory) may be NULL; otherwise we report its peak */
+    query_profile_t(const c_str &name, query_memory_t* memory);
+
+    void acquire_ref();
+    void release_ref();
+
+    /* Creates a node for every packet below (root) and hands it to
+       the packet and its output buffer. Call before dispatching. */
+    void attach(packet_t* root);
+
+    /* Stops the clock. Call after the last tuple was read. */
+    void finish();
+
+    /* the annotated plan tree */
+    std::string render();
+
+    /* recording, each may be called from any thread */
+    static void record_stage(packet_profile_t* p, long long wall_us, long long cpu_us);
+    static void record_merge(packet_profile_t* p, const c_str &host_id);
+    static void record_plan(packet_profile_t* p, query_plan const* plan);
+    static void record_output(packet_profile_t* p, size_t tuples, size_t pages,
+                              size_t spill_bytes, long long blocked_us);
+    static void record_consumer_wait(packet_profile_t* p, long long wait_us);
+
+    /* CPU time of the calling thread, 0 if the platform cannot tell */
+    static long long thread_cpu_us();
+
+private:
+
+    ~query_profile_t();
+
+    void _render(std::string &out, packet_profile_t* p, int depth);
+
+    query_profile_t(query_profile_t const &);
+    query_profile_t &operator =(query_profile_t const &);
+
+}; // EOF: query_profile_t
+
+
+
+/* Global switch; process_query() profiles every query while it is on
+   and traces the rendered plan when the query finishes */
+bool query_profiling_enabled();
+void set_query_profiling(bool enabled);
+
+/* the rendering of the most recently finished profiled query */
+std::string last_query_profile();
+void        set_last_query_profile(const std::string &profile);
+
+
+
+class qprofile_cmd_t : public command_handler_t
+{
+public:
+
+    qprofile_cmd_t() { }
+    ~qprofile_cmd_t() { }
+
+    int handle(const char* cmd);
+
+    void setaliases();
+    void usage();
+    string desc() const;
+
+}; // EOF: qprofile_cmd_t
+
+
+EXIT_NAMESPACE(qpipe);
+
+#endif /** __QPIPE_QUERY_PROFILE_H */
@@ -25,6 +25,7 @@
 #define __QUERY_STATE_H
 
 #include "util.h"
+#include "qpipe/core/memory_manager.h"
 
 
 ENTER_NAMESPACE(qpipe);
@@ -36,11 +37,16 @@ struct query_state_t {
     /* We expect this class to be subclassed. */
 
 protected:
-    query_state_t() { }
-    virtual ~query_state_t() { }
+    query_state_t() : _memory(new query_memory_t()) { }
+    virtual ~query_state_t() { _memory->release_ref(); }
+
+    /* memory account shared by all packets of the query */
+    query_memory_t* _memory;
     
 public:
 
+    query_memory_t* memory() { return _memory; }
+
     /**
      * We could create a default implementation that does not
      * rebinding, but this is safer.
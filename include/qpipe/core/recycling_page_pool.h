@@ -0,0 +1,126 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   recycling_page_pool.h
+ *
+ *  @brief:  A page_pool that recycles QPipe pages instead of
+ *           returning them to the general-purpose allocator
+ */
+
+#ifndef __QPIPE_RECYCLING_PAGE_POOL_H
+#define __QPIPE_RECYCLING_PAGE_POOL_H
+
+#include "qpipe/core/tuple.h"
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+/**
+ *  @brief Page pool with a small per-thread cache of free pages and,
+ *  behind it, one global overflow list per NUMA node. Each list keeps
+ *  at most max_free_pages (0 = no limit); pages freed beyond that go
+ *  back to the system, so the pool does not keep the peak of a past
+ *  query for the rest of the run.
+ *
+ *  Every page carries a hidden header that remembers the node it was
+ *  allocated on, so that free() always returns it to the right
+ *  overflow list. alloc_on_node() lets a tuple_fifo ask for memory
+ *  close to the CPU of its consumer. Without libnuma (HAVE_LIBNUMA)
+ *  there is a single node and pages come from malloc.
+ */
+class recycling_page_pool : public page_pool
+{
+public:
+
+    enum { MAX_NODES = 16 };
+
+    struct block_hdr_t;
+
+private:
+
+    struct node_list_t {
+        pthread_mutex_t _lock;
+        block_hdr_t*    _head;
+        size_t          _count;
+    };
+
+    static recycling_page_pool _instance;
+
+    node_list_t   _nodes[MAX_NODES];
+    int           _num_nodes;
+    size_t        _thread_cache_pages;
+    size_t        _max_free_pages;
+    pthread_key_t _cache_key;
+
+    /* accounting, in pages */
+    volatile uint64_t _pages_allocated;
+    volatile uint64_t _pages_in_use;
+    volatile uint64_t _pages_high_water;
+
+public:
+
+    static recycling_page_pool* instance() {
+        return &_instance;
+    }
+
+    recycling_page_pool(size_t page_size = get_default_page_size(),
+                        size_t thread_cache_pages = 32,
+                        size_t max_free_pages = 8192);
+    virtual ~recycling_page_pool();
+
+    virtual void* alloc();
+    virtual void* alloc_on_node(int node);
+    virtual void  free(void* page);
+
+    int num_nodes() const { return (_num_nodes); }
+
+    /* the cap of each free list, in pages (0 = no limit) */
+    void set_max_free_pages(size_t pages) { _max_free_pages = pages; }
+
+    /* accounting */
+    size_t bytes_allocated() const;
+    size_t bytes_in_use() const;
+    size_t bytes_high_water() const;
+    void   reset_high_water();
+    void   trace_stats() const;
+
+    /* thread-cache maintenance, see the .cpp */
+    void   flush_thread_cache(void* cache);
+
+private:
+
+    void*  _pop_node(int node);
+    void   _push_node(block_hdr_t* hdr);
+    void   _release(block_hdr_t* hdr);
+    void   _account_alloc();
+
+    recycling_page_pool(recycling_page_pool const &);
+    recycling_page_pool &operator =(recycling_page_pool const &);
+
+}; // EOF: recycling_page_pool
+
+
+EXIT_NAMESPACE(qpipe);
+
+#endif /** __QPIPE_RECYCLING_PAGE_POOL_H */
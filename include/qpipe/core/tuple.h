@@ -54,6 +54,14 @@ static const int DEFAULT_BUFFER_PAGES = 100;
 extern void set_default_page_size(size_t page_size);
 extern size_t get_default_page_size();
 
+class page_pool;
+extern void set_default_page_pool(page_pool* pool);
+extern page_pool* get_default_page_pool();
+extern page_pool* select_default_page_pool(const char* name);
+
+// NUMA node of the CPU the caller currently runs on (0 without libnuma)
+extern int page_pool_current_node();
+
 
 
 /**
@@ -136,6 +144,14 @@ public:
      * @brief Allocates a new page.
      */
     virtual void* alloc()=0;
+
+    /**
+     * @brief Allocates a new page on the specified NUMA node, if the
+     * pool knows how to. By default the hint is ignored.
+     */
+    virtual void* alloc_on_node(int /* node */) {
+        return alloc();
+    }
     
     /**
      * @brief releases a page. After this method returns it is no
@@ -143,6 +159,12 @@ public:
      */
     virtual void free(void* page)=0;
 
+
+    /**
+     * @brief Dumps memory-usage accounting, if the pool keeps any.
+     */
+    virtual void trace_stats() const { }
+
     
     virtual ~page_pool() { }
 };
@@ -218,9 +240,17 @@ private:
         return (page_size - sizeof(page))/tuple_size;
     }
     
-    static page* alloc(size_t tuple_size, page_pool* pool=malloc_page_pool::instance()) {
+    static page* alloc(size_t tuple_size, page_pool* pool=NULL) {
+        if (pool == NULL)
+            pool = get_default_page_pool();
         return new (pool->alloc()) page(pool, tuple_size);
     }
+
+    static page* alloc_on_node(size_t tuple_size, int node, page_pool* pool=NULL) {
+        if (pool == NULL)
+            pool = get_default_page_pool();
+        return new (pool->alloc_on_node(node)) page(pool, tuple_size);
+    }
     
     void free() {
         /* Do not call the destructor before releasing the memory. */
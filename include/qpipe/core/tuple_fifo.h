@@ -25,6 +25,8 @@
 #define __QPIPE_TUPLE_FIFO_H
 
 #include "qpipe/core/tuple.h"
+#include "qpipe/core/page_ring.h"
+#include "qpipe/core/memory_manager.h"
 #include <cstdio>
 #include <vector>
 #include <list>
@@ -40,14 +42,23 @@ int tuple_fifo_generate_id();
 
 typedef std::list<page*> page_list;
 
+struct packet_profile_t;
+
 /**
  *  @brief Thread-safe tuple buffer. This class allows one thread to
  *  safely pass tuples to another. The producer will fill a page of
  *  tuples before handing it to the consumer.
  *
- *  This implementation currently uses an internal allocator to
- *  allocate a new page every time the current page is filled and
- *  handed to the consumer.
+ *  While the FIFO is in memory, full pages travel from the producer
+ *  to the consumer through a lock-free SPSC page_ring and consumed
+ *  pages travel back through a second ring for reuse. A side that
+ *  cannot proceed spins briefly and then sleeps on a condition
+ *  variable; the mutex is only taken to sleep, to wake a sleeper, on
+ *  state transitions and while the FIFO is spilled to disk.
+ *
+ *  Fresh pages are charged to the memory account of the query the
+ *  FIFO belongs to (see set_memory_account()). When the account
+ *  refuses another page the FIFO spills to disk rather than grow.
  */
 class tuple_fifo {
 
@@ -113,17 +124,19 @@ private:
     tuple_fifo_state_t _state;
 
     /* page list management */
-    page_list _pages;
-    page_list _free_pages;
-    size_t _pages_in_fifo; /* number of entries in _pages */
-    size_t _pages_in_memory;
+    page_ring _pages;       /* full pages, writer -> reader */
+    page_ring _free_pages;  /* consumed pages, reader -> writer */
     size_t _memory_capacity;
     size_t _threshold;
 
+    /* Pages published by the writer (in memory or on disk) and pages
+       consumed by the reader. Each is written by one side only. */
+    volatile size_t _pages_written;
+    volatile size_t _next_page;
+
     /* page file management */
     FILE*  _page_file;
-    size_t _next_page;
-    size_t _file_head_page;
+    volatile size_t _file_head_page; /* index of the first page on disk */
     
     /* useful fields to store */
     size_t _tuple_size;
@@ -134,9 +147,16 @@ private:
     size_t _num_removed;
     size_t _num_waits_on_insert;
     size_t _num_waits_on_remove;
+    size_t _num_spilled;
+    long long _insert_wait_us;
+    long long _remove_wait_us;
+
+    /* profile node of the packet writing to us, if any */
+    packet_profile_t* _profile;
 
     /* read and write page management */
     char*  _read_end;
+    bool   _read_page_recycle; /* _read_page came from _pages */
     guard<page> _read_page;
     page::iterator _read_iterator;
     guard<page> _write_page;
@@ -145,6 +165,14 @@ private:
     pthread_mutex_t _lock;
     pthread_cond_t _reader_notify;
     pthread_cond_t _writer_notify;
+    volatile bool _reader_sleeping;
+    volatile bool _writer_sleeping;
+
+    /* NUMA node of the reader; new pages are allocated there */
+    volatile int _consumer_node;
+
+    /* pages charged to the query's memory account (writer only) */
+    memory_grant_t _memory;
 
     /* debug vars */
     pthread_t _reader_tid;
@@ -162,7 +190,7 @@ public:
      *  @param capacity We would like to allocate a new page whenever
      *  we fill up the current page. If the buffer currently contains
      *  this many pages, our insert operations will block rather than
-     *  allocate new pages.
+     *  allocate new pages. Also sizes the in-memory page rings.
      *
      *  @param threshold If the writer sees a full tuple_fifo, it
      *  waits until this many free pages appear before writing
@@ -176,11 +204,13 @@ public:
                size_t threshold=64,
                size_t page_size=get_default_page_size())
         : _fifo_id(tuple_fifo_generate_id()),
-          _pages_in_fifo(0),
-          _pages_in_memory(0),
+          _pages(capacity),
+          _free_pages(capacity),
           _memory_capacity(capacity),
           _threshold(threshold),
+          _pages_written(0),
           _next_page(0),
+          _page_file(NULL),
           _file_head_page(0),
           _tuple_size(tuple_size),
           _page_size(page_size),
@@ -188,9 +218,18 @@ public:
           _num_removed(0),
           _num_waits_on_insert(0),
           _num_waits_on_remove(0),
+          _num_spilled(0),
+          _insert_wait_us(0),
+          _remove_wait_us(0),
+          _profile(NULL),
+          _read_end(NULL),
+          _read_page_recycle(false),
           _lock(thread_mutex_create()),
           _reader_notify(thread_cond_create()),
           _writer_notify(thread_cond_create()),
+          _reader_sleeping(false),
+          _writer_sleeping(false),
+          _consumer_node(0),
 	  _reader_tid(0),
           _writer_tid(0)
     {
@@ -218,6 +257,29 @@ public:
     }
 
 
+    /* the most memory this FIFO holds while it stays in memory */
+    size_t memory_capacity() const {
+        return _memory_capacity * _page_size;
+    }
+
+
+    /**
+     *  @brief Charge the pages of this FIFO to (memory). Must be
+     *  called before the writer starts.
+     */
+    void set_memory_account(query_memory_t* memory) {
+        assert(_memory.bytes() == 0);
+        _memory.attach(memory);
+    }
+
+
+    /**
+     *  @brief Report tuples, pages, spills and blocking to (profile)
+     *  when we are destroyed. Must be called before the writer starts.
+     */
+    void set_profile(packet_profile_t* profile);
+
+
     void writer_init();
 
 
@@ -340,17 +402,16 @@ public:
 private:
 
     size_t _available_in_memory_writes() {
-        assert(is_in_memory());
-        return _memory_capacity - _available_in_memory_reads();
+        size_t used = _available_in_memory_reads();
+        return (used < _memory_capacity)? _memory_capacity - used : 0;
     }
 
     size_t _available_in_memory_reads() {
-        assert(is_in_memory());
-        return _pages_in_memory;
+        return _pages.size();
     }
 
     size_t _available_fifo_reads() {
-        return _pages_in_fifo;
+        return *&_pages_written - *&_next_page;
     }
 
     void _termination_check() {
@@ -364,15 +425,18 @@ private:
 	_read_end = _read_page->end()->data;
     }
 
+    /* Only the writer may call this method. Returns NULL if the
+       query cannot afford another page. */
     page* _alloc_page() {
-        /* Allocate a new _write_page. */
-        if (_free_pages.empty())
-            /* Allocate using page::alloc. */
-            return page::alloc(tuple_size());
-
-        /* Allocate from free list. */
-        page* p = _free_pages.front();
-        _free_pages.pop_front();
+        /* Allocate from the pages the reader handed back. */
+        page* p = _free_pages.pop();
+        if (p == NULL) {
+            /* The first page is always granted so we make progress */
+            if (!_memory.grow(_page_size, _memory.bytes() == 0))
+                return NULL;
+            /* Allocate close to the consumer. */
+            return page::alloc_on_node(tuple_size(), _consumer_node);
+        }
         p->clear();
         return p;
     }
@@ -383,6 +447,9 @@ private:
     /* These methods control access and waiting. */
     int  _get_read_page(int timeout);
     void _flush_write_page(bool done_writing);
+    void _spill_to_disk(bool done_writing);
+    void _release_read_page();
+    void _read_page_from_disk();
 
 
     bool is_in_memory() {
@@ -0,0 +1,70 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   tuple_fifo_bench.h
+ *
+ *  @brief:  Microbenchmark of the page hand-off between two stages
+ *           through a tuple_fifo
+ */
+
+#ifndef __QPIPE_TUPLE_FIFO_BENCH_H
+#define __QPIPE_TUPLE_FIFO_BENCH_H
+
+#include "util/command/command_handler.h"
+#include "qpipe/core/tuple_fifo.h"
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+/**
+ *  @brief Pushes (num_pages) pages of (tuple_size)-byte tuples from a
+ *  writer thread to a reader thread through one tuple_fifo.
+ *
+ *  @return pages per second, as seen by the reader
+ */
+double tuple_fifo_bench(const size_t num_pages,
+                        const size_t tuple_size,
+                        const size_t capacity=DEFAULT_BUFFER_PAGES,
+                        const size_t threshold=64);
+
+
+class fifobench_cmd_t : public command_handler_t 
+{
+public:
+
+    fifobench_cmd_t() { }
+    ~fifobench_cmd_t() { }
+
+    int handle(const char* cmd);
+
+    void setaliases();
+    void usage();
+    string desc() const;
+
+}; // EOF: fifobench_cmd_t
+
+
+EXIT_NAMESPACE(qpipe);
+
+#endif /** __QPIPE_TUPLE_FIFO_BENCH_H */
@@ -36,6 +36,7 @@
 #include "qpipe/common/process_tuple.h"
 #include "qpipe/common/process_query.h"
 #include "qpipe/common/int_comparator.h"
+#include "qpipe/common/bloom_pushdown.h"
 
 
 
@@ -37,6 +37,7 @@
 #include "qpipe/stages/partial_aggregate.h"
 #include "qpipe/stages/hash_aggregate.h"
 #include "qpipe/stages/sort.h"
+#include "qpipe/stages/topn.h"
 #include "qpipe/stages/sorted_in.h"
 #include "qpipe/stages/tscan.h"
 #include "qpipe/stages/echo.h"
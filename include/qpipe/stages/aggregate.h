@@ -105,7 +105,7 @@ struct aggregate_packet_t : public packet_t
     }
 
     virtual void declare_worker_needs(resource_declare_t* declare) {
-        declare->declare(_packet_type, 1);
+        declare_self(declare);
         _input->declare_worker_needs(declare);
     }
 };
@@ -66,7 +66,7 @@ public:
     }
 
     virtual void declare_worker_needs(resource_declare_t* declare) {
-        declare->declare(_packet_type, 1);
+        declare_self(declare);
         /* no inputs */
     }
 };
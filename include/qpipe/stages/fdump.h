@@ -147,7 +147,7 @@ public:
 
     virtual void declare_worker_needs(resource_declare_t * declare) {
         if (_child) {
-            declare->declare(_packet_type, 1);
+            declare_self(declare);
             _child->declare_worker_needs(declare);
         } else {
             /* Do nothing. The stage the that creates us is responsible
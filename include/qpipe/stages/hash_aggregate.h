@@ -68,7 +68,7 @@ struct hash_aggregate_packet_t : public packet_t {
     }
     
     virtual void declare_worker_needs(resource_declare_t* declare) {
-        declare->declare(_packet_type, 1);
+        declare_self(declare);
         _input->declare_worker_needs(declare);
     }
 };
@@ -82,6 +82,9 @@ class hash_aggregate_stage_t : public stage_t {
     tuple_aggregate_t* _aggregate;
     qpipe::page* _agg_page;
     size_t _tuple_align;
+
+    /* aggregate pages charged to the query */
+    memory_grant_t _memory;
 public:
     static const c_str DEFAULT_STAGE_NAME;
     typedef hash_aggregate_packet_t stage_packet_t;
@@ -32,6 +32,7 @@
 #define __QPIPE_HASH_JOIN_STAGE_H
 
 #include "qpipe/core.h"
+#include "qpipe/common/bloom_pushdown.h"
 #include "util/hashtable.h"
 
 #if defined(linux) || defined(__linux)
@@ -62,6 +63,9 @@ class hash_join_packet_t : public packet_t {
 public:
     static const c_str PACKET_TYPE;
 
+    /* number of hash partitions, each needs at least one page */
+    static const int PARTITIONS = 512;
+
     guard<packet_t> _left;
     guard<packet_t> _right;
     guard<tuple_fifo> _left_buffer;
@@ -140,8 +144,12 @@ public:
         return new query_plan(action, filter->to_string(), children, 2);
     }
 
+    virtual size_t memory_needs() {
+        return packet_t::memory_needs() + PARTITIONS * get_default_page_size();
+    }
+
     virtual void declare_worker_needs(resource_declare_t* declare) {
-        declare->declare(_packet_type, 1);
+        declare_self(declare);
         _left->declare_worker_needs(declare);
         _right->declare_worker_needs(declare);
     }
@@ -237,29 +245,6 @@ private:
 
     
     typedef std::vector<partition_t> partition_list_t;
-
-
-    struct left_action_t {
-        void operator ()(partition_list_t::iterator it) {
-            it->file = NULL;
-        }
-    };
-
-
-    struct right_action_t {
-        size_t _left_tuple_size;
-        right_action_t(size_t left_tuple_size)
-            : _left_tuple_size(left_tuple_size)
-        {
-        }
-        void operator()(partition_list_t::iterator it) {
-            // open a new file for the left side partition
-            it->file = create_tmp_file(it->file_name2, "hash-join-left");
-            
-            // resize the page to match left-side tuples
-            it->_page = page::alloc(_left_tuple_size);
-        }
-    };
     
     
     
@@ -270,13 +255,21 @@ private:
     tuple_join_t *_join;
     partition_list_t partitions;
 
+    /* in-memory partition pages charged to the query */
+    memory_grant_t _memory;
+
 
 
     /* methods */
     void test_overflow(int partition);
-
-    template<class Action>
-    void close_file(partition_list_t::iterator it, Action a);
+    void spill_partition(int i);
+    void push_bloom_filter(hash_join_packet_t* packet,
+                           bloom_filter_t* bloom);
+
+    void close_file(partition_t &p);
+    void join_file_partition(partition_t &p, bool outer_join, bool distinct);
+    FILE* open_tmp_file(c_str const &name);
+    void remove_tmp_file(c_str const &name);
     
    
 
@@ -286,6 +279,9 @@ public:
 
     static const c_str DEFAULT_STAGE_NAME;
 
+    /* keys the pushed-down Bloom filter is first sized for */
+    static const size_t BLOOM_INITIAL_KEYS = 64 * 1024;
+
 
     virtual void process_packet();
     
@@ -294,7 +290,7 @@ public:
     hash_join_stage_t()
         : page_quota(10000)
         , page_count(0)
-        , partitions(512)
+        , partitions(hash_join_packet_t::PARTITIONS)
     {
     }
 
@@ -129,7 +129,7 @@ public:
     }
 
     virtual void declare_worker_needs(resource_declare_t* declare) {
-        declare->declare(_packet_type, 1);
+        declare_self(declare);
         _left->declare_worker_needs(declare);
         _right->declare_worker_needs(declare);
     }
@@ -116,10 +116,13 @@ public:
         return new query_plan(action, filter->to_string(), children, 1);
     }
     
+    /* output buffer plus one initial sorted run */
+    virtual size_t memory_needs();
+
     virtual void declare_worker_needs(resource_declare_t* declare) {
         
         /* need to reserve one SORT worker, ... */
-        declare->declare(_packet_type, 1);
+        declare_self(declare);
         
         _input->declare_worker_needs(declare);
     }
@@ -0,0 +1,129 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+#ifndef __QPIPE_TOPN_H
+#define __QPIPE_TOPN_H
+
+#include "qpipe/core.h"
+
+
+
+using namespace qpipe;
+
+
+
+/**
+ *@brief Packet definition for the top-N stage
+ */
+struct topn_packet_t : public packet_t {
+
+public:
+
+    static const c_str PACKET_TYPE;
+
+
+    guard<key_extractor_t> _extract;
+    guard<key_compare_t>   _compare;
+    guard<packet_t>        _input;
+    guard<tuple_fifo>      _input_buffer;
+    size_t                 _limit;
+
+
+    /**
+     *  @brief topn_packet_t constructor. Same as sort_packet_t, plus
+     *  the number of tuples to return.
+     *
+     *  @param limit The first (limit) tuples of the sort order are
+     *  sent to output_buffer, in that order. The limit is part of the
+     *  plan, so only packets with the same limit are merged.
+     */
+    topn_packet_t(const c_str        &packet_id,
+                  tuple_fifo*        output_buffer,
+                  tuple_filter_t*    output_filter,
+                  key_extractor_t*   extract,
+                  key_compare_t*     compare,
+                  size_t             limit,
+                  packet_t*          input)
+	: packet_t(packet_id, PACKET_TYPE, output_buffer, output_filter,
+                   create_plan(output_filter, extract, limit, input),
+                   true, /* merging allowed */
+                   true  /* unreserve worker on completion */
+                   ),
+          _extract(extract), _compare(compare),
+          _input(input),
+          _input_buffer(input->output_buffer()),
+          _limit(limit)
+    {
+        assert(_input != NULL);
+        assert(_input_buffer != NULL);
+        assert(_limit > 0);
+    }
+
+    static query_plan* create_plan(tuple_filter_t* filter,
+                                   key_extractor_t* key, size_t limit,
+                                   packet_t* input)
+    {
+        c_str action("%s:%zd:%s", PACKET_TYPE.data(), limit,
+                     key->to_string().data());
+
+        query_plan const** children = new query_plan const*[1];
+        children[0] = input->plan();
+        return new query_plan(action, filter->to_string(), children, 1);
+    }
+
+    /* output buffer plus the (limit) kept tuples */
+    virtual size_t memory_needs();
+
+    virtual void declare_worker_needs(resource_declare_t* declare) {
+        declare_self(declare);
+        _input->declare_worker_needs(declare);
+    }
+};
+
+
+
+/**
+ * @brief ORDER BY ... LIMIT stage. Keeps the best (limit) tuples seen
+ * so far in a bounded heap, instead of sorting the whole input, and
+ * outputs them in order once the input is exhausted. Nothing is
+ * output before that, so a packet can merge at any point before the
+ * end and still see the full result.
+ */
+class topn_stage_t : public stage_t {
+
+public:
+
+    static const c_str DEFAULT_STAGE_NAME;
+    typedef topn_packet_t stage_packet_t;
+
+    topn_stage_t() { }
+    ~topn_stage_t() { }
+
+protected:
+
+    virtual void process_packet();
+};
+
+
+
+#endif
@@ -54,6 +54,7 @@ struct tscan_packet_t : public packet_t
     table_desc_t* _table;
     xct_t*        _xct;
     lock_mode_t   _lm;
+    zone_range_t  _range;
 
     static const c_str PACKET_TYPE;
    
@@ -81,6 +82,11 @@ struct tscan_packet_t : public packet_t
      *
      *  @param: lock_mode_t
      *  The concurrency level which will be used by the scan.
+     *
+     *  @param: zone_range_t
+     *  If not empty, the zones of the table's zone map that cannot hold
+     *  records in this range are not read. The output filter still has
+     *  to apply the full predicate.
      */
 
     tscan_packet_t(const c_str&    packet_id,
@@ -89,9 +95,14 @@ struct tscan_packet_t : public packet_t
 		   ss_m*           db,
                    table_desc_t*   table,
                    xct_t*          pxct,
-                   lock_mode_t     lm=SH);
+                   lock_mode_t     lm=SH,
+                   const zone_range_t& range=zone_range_t());
+
+    static query_plan* create_plan(tuple_filter_t* filter, table_desc_t* file,
+                                   const zone_range_t& range);
 
-    static query_plan* create_plan(tuple_filter_t* filter, table_desc_t* file);
+    /* every scanned record goes through the output filter */
+    virtual bool accepts_pushdown() { return (true); }
     void declare_worker_needs(resource_declare_t* declare);
 
 }; // EOF: tscan_packet_t
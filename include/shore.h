@@ -43,6 +43,7 @@
 #include "sm/shore/shore_field.h"
 #include "sm/shore/shore_index.h"
 #include "sm/shore/shore_iter.h"
+#include "sm/shore/shore_parallel_scan.h"
 #include "sm/shore/shore_msg.h"
 #include "sm/shore/shore_row.h"
 #include "sm/shore/shore_row_cache.h"
@@ -37,6 +37,8 @@
 #include "sm/shore/shore_env.h"
 #include "sm/shore/shore_helper_loader.h"
 
+#include <vector>
+
 
 ENTER_NAMESPACE(shore);
 
@@ -111,6 +113,50 @@ const int DF_WARMUP_INTERVAL = 2; // 2 secs
 enum MeasurementType { MT_UNDEF, MT_NUM_OF_TRXS, MT_TIME_DUR };
 
 
+
+/******************************************************************** 
+ *
+ * @class: latency_recorder_t
+ *
+ * @brief: The response times (in secs) of the trxs a client completes
+ *         during the measurement. The client adds to it, the shell
+ *         takes what was recorded at the end of each measurement.
+ *
+ ********************************************************************/
+
+class latency_recorder_t
+{
+private:
+
+    pthread_mutex_t _lock;
+    std::vector<double> _secs;
+
+public:
+
+    latency_recorder_t() { pthread_mutex_init(&_lock, NULL); }
+    ~latency_recorder_t() { pthread_mutex_destroy(&_lock); }
+
+    void add(const double secs) {
+        CRITICAL_SECTION(cs, _lock);
+        _secs.push_back(secs);
+    }
+
+    // appends the recorded response times to (out) and starts over
+    void take(std::vector<double>& out) {
+        CRITICAL_SECTION(cs, _lock);
+        out.insert(out.end(), _secs.begin(), _secs.end());
+        _secs.clear();
+    }
+
+private:
+
+    // copying not allowed
+    latency_recorder_t(latency_recorder_t const &);
+    void operator=(latency_recorder_t const &);
+
+}; // EOF: latency_recorder_t
+
+
 /******************************************************************** 
  *
  * @enum:  base_client_t
@@ -140,6 +186,10 @@ protected:
 
     int _think_time; // in microseconds
 
+    // if set, the time-based runs keep a single trx outstanding
+    // and record the response time of each
+    latency_recorder_t* _latencies;
+
     // used for submitting batches
     guard<condex_pair> _cp;
 
@@ -154,7 +204,7 @@ public:
 
     base_client_t() 
         : thread_t("none"), _env(NULL), _measure_type(MT_UNDEF), 
-          _trxid(-1), _notrxs(-1), _think_time(0),
+          _trxid(-1), _notrxs(-1), _think_time(0), _latencies(NULL),
           _is_bound(false), _prs_id(PBIND_NONE),
           _rv(1)
     { }
@@ -165,6 +215,7 @@ public:
                   processorid_t aprsid = PBIND_NONE) 
 	: thread_t(tname), _env(env), _measure_type(aType), 
           _trxid(trxid), _notrxs(numOfTrxs), _think_time(0),
+          _latencies(NULL),
           _is_bound(false), _prs_id(aprsid), _id(id), _rv(0)
     {
         assert (_env);
@@ -200,6 +251,7 @@ public:
     int id() { return (_id); }
     bool is_bound() const { return (_is_bound); }
     inline int rv() { return (_rv); }
+    void set_latencies(latency_recorder_t* alr) { _latencies = alr; }
     
     // methods
     w_rc_t run_xcts(int xct_type, int num_xct);
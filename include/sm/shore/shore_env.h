@@ -40,6 +40,9 @@
 
 #include "shore_reqs.h"
 #include "shore_file_desc.h"
+#include "shore_skew_scenario.h"
+#include "shore_input_ring.h"
+#include "shore_trx_mix.h"
 
 
 ENTER_NAMESPACE(shore);
@@ -47,6 +50,9 @@ ENTER_NAMESPACE(shore);
 
 using std::map;
 
+class table_desc_t;
+class table_man_t;
+
 
 /******** Constants ********/
 
@@ -164,6 +170,7 @@ const int    SHORE_NUM_DB_OPTIONS  = 5;
         TRACE( TRACE_TRX_FLOW, "%d. %s ...\n", xct_id, #trximpl);       \
         _inc_##trxlid##_att();                                          \
         w_rc_t e = xct_##trximpl(xct_id, in);                           \
+        _release_input(prequest);                                       \
         if (!e.is_error()) {                                            \
             lsn_t xctLastLsn;                                           \
             e = _pssm->commit_xct(true,&xctLastLsn);                    \
@@ -192,6 +199,7 @@ const int    SHORE_NUM_DB_OPTIONS  = 5;
         TRACE( TRACE_TRX_FLOW, "%d. %s ...\n", xct_id, #trximpl);       \
         _inc_##trxlid##_att();                                          \
         w_rc_t e = xct_##trximpl(xct_id, in);                           \
+        _release_input(prequest);                                       \
         if (!e.is_error()) {                                            \
             if (isAsynchCommit()) e = _pssm->commit_xct(true);          \
             else e = _pssm->commit_xct(); }                             \
@@ -215,8 +223,14 @@ const int    SHORE_NUM_DB_OPTIONS  = 5;
 #endif // ***** EOF: CFG_FLUSHER ***** //
 
 
+// If the client generated the input ahead (see input_ring_t), it comes
+// with the request. The wrapper above gives it back to its ring as soon
+// as the trx body has run, before the client is notified: a notified
+// client may finish and delete the ring.
 #define DEFINE_RUN_WITHOUT_INPUT_TRX_WRAPPER(cname,trxlid,trximpl)      \
     w_rc_t cname::run_##trximpl(Request* prequest) {                    \
+        if (prepared_input_t* pin = prequest->input())                  \
+            return (run_##trximpl(prequest, pin->get<trxlid##_input_t>())); \
         trxlid##_input_t in = create_##trxlid##_input(_queried_factor, prequest->selectedID()); \
         return (run_##trximpl(prequest, in)); }
 
@@ -540,6 +554,16 @@ protected:
     tatas_lock _alarm_lock;
     int _start_imbalance;
     skew_type_t _skew_type;
+
+    // key distribution of the workload inputs
+    keydist_spec_t _keydist;
+
+    // changes the key distribution over time, if running
+    skew_scenario_t* _skew_scenario;
+
+    // the mixes, by trx id, and the ones each kit comes with
+    std::vector<trx_mix_t> _mixes;
+    std::vector<trx_mix_t> _default_mixes;
     
 public:
 
@@ -628,13 +652,51 @@ public:
     virtual w_rc_t update_partitioning() { return (RCOK); }
 
     // -- insert/delete/probe frequencies for microbenchmarks -- //
-    void set_freqs(int insert_freq = 0, int delete_freq = 0, int probe_freq = 0);
+    virtual void set_freqs(int insert_freq = 0, int delete_freq = 0, int probe_freq = 0);
+
+    // -- trx mixes -- //
+
+    // the kits register (mix) as the default of trx (id) 
+    void add_mix(const int id, const trx_mix_t& mix);
+    bool is_mix(const int id) const {
+        return ((id >= 0) && (id < (int)_mixes.size()) && !_mixes[id].empty());
+    }
+
+    // (spec) is "<trx id>:<weight> ..." or "default". False if (id) is
+    // not a mix or (spec) is invalid. Only between runs, the mixes are
+    // read without locks
+    bool set_mix(const int id, const char* spec);
+
+    // the trx to run for (xct_type), a pick of its mix if it is one
+    int pick_trx(const int xct_type) const {
+        return (is_mix(xct_type) ? _mixes[xct_type].pick() : xct_type);
+    }
+    virtual bool has_trx(const int /* xct_type */) const { return (true); }
+    void print_mixes() const;
+
+protected:
+    // makes (mix) the mix of trx (id); a kit can refuse a mix it
+    // cannot run, or derive its own state from it
+    virtual bool _install_mix(const int id, const trx_mix_t& mix);
+public:
 
     // load imbalance related
     virtual void set_skew(int area, int load, int start_imbalance);
     virtual void reset_skew();
     virtual void start_load_imbalance();
 
+    // key distribution of the inputs. The kits that support it
+    // override set_keydist() to set up their generators
+    virtual void set_keydist(const keydist_spec_t& spec);
+    const keydist_spec_t& get_keydist() const { return (_keydist); }
+
+    // time-varying key distribution. Starting a scenario stops the
+    // running one, if any. Stopping prints the throughput per phase
+    int start_skew_scenario(const std::vector<skew_phase_t>& phases, 
+                            const bool loop);
+    void stop_skew_scenario();
+    skew_scenario_t* get_skew_scenario() { return (_skew_scenario); }
+
     // print the current db to files
     virtual void db_print_init(int num_lines);
     virtual w_rc_t db_print(int num_lines) { return(RCOK); }
@@ -691,6 +753,17 @@ public:
     // Run one transaction
     virtual w_rc_t run_one_xct(Request* prequest)=0;
 
+protected:
+    // gives the input the client prepared for (prequest), if any, back
+    // to its ring
+    static void _release_input(Request* prequest) {
+        if (prepared_input_t* pin = prequest->input()) {
+            prequest->set_input(NULL);
+            pin->release();
+        }
+    }
+public:
+
 
 
     // Control whether asynchronous commit will be used
@@ -727,6 +800,29 @@ protected:
     void               to_base_flusher(Request* ar);
 
 
+    // ZONE MAPS
+protected:
+    // writes back (save) or marks stale on disk the zone maps of (tables)
+    w_rc_t _sync_zone_maps(table_desc_t* const* tables, const uint count,
+                           const bool save);
+
+    // PAX STORES
+protected:
+    // rebuilds the PAX copies of the tables of (managers) that are stale,
+    // outside a transaction
+    w_rc_t _build_pax_stores(table_man_t* const* managers, const uint count);
+
+    // BULK INDEX BUILD
+protected:
+    // with "db-bulk-index" set, makes the loaders write only the heaps
+    // of (managers), returns if it did so
+    bool   _defer_indexes(table_man_t* const* managers, const uint count);
+
+    // builds in key order the deferred indexes of (managers), outside
+    // a transaction, and turns the deferral off
+    w_rc_t _bulk_build_indexes(table_man_t* const* managers, const uint count);
+
+
 protected:
    
     // returns 0 on success
@@ -105,6 +105,7 @@ enum  sqltype_t
     SQL_FIXCHAR,    /* FIXCHAR */        // Fixed size string
     SQL_VARCHAR,    /* VARCHAR */        // Variable size string
     SQL_TIME,       /* TIMESTAMP */      // Deprecated, use SQL_FLOAT instead
+    SQL_DATE,       /* DATE */           // Calendar day, a date_t (days since 1970-01-01)
 
     SQL_NUMERIC,    /* NUMERIC */        /* Not tested */
     SQL_SNUMERIC    /* SIGNED NUMERIC */ /* Not tested */
@@ -228,10 +229,10 @@ struct field_value_t
 	bool         _bit;      /* BIT */
 	short        _smallint; /* SMALLINT */
 	char         _char;     /* CHAR */
-	int          _int;      /* INT */
+	int          _int;      /* INT, DATE */
 	double       _float;    /* FLOAT */
 	long long    _long;     /* LONG */
-	timestamp_t* _time;     /* TIME or DATE */
+	timestamp_t* _time;     /* TIME */
 	char*        _string;   /* FIXCHAR, VARCHAR, NUMERIC */
     }   _value;   
 
@@ -343,6 +344,7 @@ struct field_value_t
     void   set_long_value(const long long data);
     void   set_decimal_value(const decimal data);
     void   set_time_value(const time_t data);
+    void   set_date_value(const date_t data);
     void   set_tstamp_value(const timestamp_t& data);
     void   set_char_value(const char data);
     void   set_fixed_string_value(const char* string, const uint len);
@@ -359,6 +361,7 @@ struct field_value_t
     long long    get_long_value() const;
     decimal      get_decimal_value() const;
     time_t       get_time_value() const;
+    date_t       get_date_value() const;
     timestamp_t& get_tstamp_value() const;
 
     bool load_value_from_file(ifstream& is, const char delim);
@@ -415,6 +418,9 @@ inline void field_desc_t::setup(sqltype_t type,
     case SQL_INT:
         _size = sizeof(int);
         break;
+    case SQL_DATE:
+        _size = sizeof(date_t);
+        break;
     case SQL_FLOAT:
         _size = sizeof(double);
         break;
@@ -468,6 +474,7 @@ inline const char* field_desc_t::_set_keydesc()
     case SQL_SMALLINT:  
     case SQL_CHAR:  
     case SQL_INT:       
+    case SQL_DATE:
         sprintf(_keydesc, "i%d", _size); break;
 
     case SQL_FLOAT:     
@@ -527,6 +534,9 @@ inline void field_value_t::setup(field_desc_t* pfd)
     case SQL_INT:
         _max_size = sizeof(int);
         break;
+    case SQL_DATE:
+        _max_size = sizeof(date_t);
+        break;
     case SQL_FLOAT:
         _max_size = sizeof(double);
         break;    
@@ -604,6 +614,7 @@ inline void field_value_t::reset()
         _value._char = 0;
         break;
     case SQL_INT:
+    case SQL_DATE:
         _value._int = 0;
         break;
     case SQL_FLOAT:
@@ -680,6 +691,7 @@ inline void field_value_t::set_value(const void* data,
     case SQL_SMALLINT:
     case SQL_CHAR:
     case SQL_INT:
+    case SQL_DATE:
     case SQL_FLOAT:
     case SQL_LONG:
 	memcpy(&_value, data, _max_size); 
@@ -727,6 +739,7 @@ inline void field_value_t::set_min_value()
 	_value._char = MIN_SMALLINT;
 	break;
     case SQL_INT:
+    case SQL_DATE:
 	_value._int = MIN_INT;
 	break;
     case SQL_FLOAT:
@@ -765,6 +778,7 @@ inline void field_value_t::set_max_value()
 	_value._char = 'z';
 	break;
     case SQL_INT:
+    case SQL_DATE:
 	_value._int = MAX_INT;
 	break;
     case SQL_FLOAT:
@@ -814,6 +828,7 @@ inline bool field_value_t::copy_value(void* data) const
         memcpy(data, &_value._char, _max_size);
         break;
     case SQL_INT:
+    case SQL_DATE:
         memcpy(data, &_value._int, _max_size);
         break;
     case SQL_FLOAT:
@@ -913,6 +928,14 @@ inline void field_value_t::set_time_value(const time_t data)
     _value._float = data;
 }
 
+inline void field_value_t::set_date_value(const date_t data)
+{ 
+    assert (_pfield_desc);
+    assert (_pfield_desc->type() == SQL_DATE);
+    _null_flag = false;
+    _value._int = data;
+}
+
 inline void field_value_t::set_tstamp_value(const timestamp_t& data)
 {
     assert (_pfield_desc);
@@ -1049,6 +1072,13 @@ inline time_t field_value_t::get_time_value() const
     return ((time_t)_value._float);
 }
 
+inline date_t field_value_t::get_date_value() const
+{
+    assert (_pfield_desc);
+    assert (_pfield_desc->type() == SQL_DATE);
+    return (_value._int);
+}
+
 inline timestamp_t& field_value_t::get_tstamp_value() const
 {
     assert (_pfield_desc);
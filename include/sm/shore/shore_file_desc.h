@@ -103,6 +103,7 @@ enum file_type_t  { FT_HEAP         = 0x1,
  *                          to one leaf MRBTree index page
  *         PD_NOLOCK      - have indexes without CC
  *         PD_NOLATCH     - have indexes without even latching
+ *         PD_PAX         - keep a PAX copy of the scan-heavy tables
  *
  * --------------------------------------------------------------- */
 
@@ -112,7 +113,8 @@ enum physical_design_t { PD_NORMAL      = 0x1,
                          PD_MRBT_PART   = 0x8,
                          PD_MRBT_LEAF   = 0x10,
                          PD_NOLOCK      = 0x20,
-                         PD_NOLATCH     = 0x40
+                         PD_NOLATCH     = 0x40,
+                         PD_PAX         = 0x80
 };
 
 
@@ -350,6 +350,59 @@ public:
 
 
 
+/****************************************************************** 
+ *
+ *  @class: index_building_smt_t
+ *
+ *  @brief: An smthread inherited class that it is used for building
+ *          an index of a table loaded with deferred indexes, through
+ *          table_man_t::bulk_build_index(). Each index has its own 
+ *          thread, so the extraction and the sort of different indexes
+ *          run in parallel.
+ *
+ ******************************************************************/
+
+class index_building_smt_t : public thread_t 
+{
+private:
+
+    ss_m*          _pssm;
+    table_man_t*   _pmanager;    
+    index_desc_t*  _pindex;
+    int            _rv;
+
+public:
+    
+    index_building_smt_t(c_str tname, ss_m* assm, table_man_t* apmanager,
+                         index_desc_t* apindex) 
+	: thread_t(tname), _pssm(assm), _pmanager(apmanager), 
+          _pindex(apindex), _rv(0)
+    {
+        assert (_pssm);
+        assert (_pmanager);
+        assert (_pindex);
+    }
+
+    ~index_building_smt_t() { }
+
+    inline int rv() { return (_rv); }
+
+    // thread entrance
+    void work() {
+        w_rc_t e = _pmanager->bulk_build_index(_pssm, _pindex);
+        if (e.is_error()) {
+            TRACE( TRACE_ALWAYS, "Index (%s) building aborted [0x%x]\n", 
+                   _pindex->name(), e.err_num());
+            _rv = 1;
+            return;
+        }
+        _rv = 0;
+    }
+
+}; // EOF: index_building_smt_t
+
+
+
 /****************************************************************** 
  *
  *  @class table_checking_smt_t
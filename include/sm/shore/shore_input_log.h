@@ -0,0 +1,220 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_input_log.h
+ *
+ *  @brief:  Recording of the trx inputs a client submits, and their
+ *           replay, so that two runs execute the very same stream of
+ *           trxs (db-cl-record / db-cl-replay)
+ *
+ *  @note:   One file per client, <prefix>.<client id>. After a small
+ *           header, each record is
+ *
+ *           varint  usecs since the previous submission
+ *           varint  trx type (the mixes already picked)
+ *           varint  spec id (zigzag)
+ *           varint  input size
+ *           bytes   the input, as runs of [varint n][n bytes][varint zeros]
+ *
+ *           The inputs are written as they lay in memory, so a log is
+ *           only good for the build and the platform that wrote it.
+ */
+
+#ifndef __SHORE_INPUT_LOG_H
+#define __SHORE_INPUT_LOG_H
+
+#include "sm/shore/shore_input_ring.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+
+ENTER_NAMESPACE(shore);
+
+
+struct input_log_header_t
+{
+    char   _magic[4];
+    int    _version;
+    int    _xct_type;
+    int    _sel;
+    double _qf;
+
+}; // EOF: input_log_header_t
+
+
+
+/******************************************************************
+ *
+ *  @class: input_log_writer_t
+ *
+ *  @brief: Appends the inputs a client takes from its ring, in the
+ *          order it submits them. Used only by the client thread.
+ *
+ ******************************************************************/
+
+class input_log_writer_t
+{
+private:
+
+    FILE*      _f;
+    string     _fname;
+    long long  _last_usecs;
+    ulong_t    _records;
+
+    void _put_varint(ulong_t v);
+
+public:
+
+    input_log_writer_t();
+    ~input_log_writer_t();
+
+    // false if (fname) cannot be written
+    bool open(const string& fname, const int xct_type,
+              const double qf, const int sel);
+
+    // (usecs) since the first submission of the client
+    void write(const prepared_input_t* pin, const long long usecs);
+
+    ulong_t records() const { return (_records); }
+
+private:
+
+    input_log_writer_t(input_log_writer_t const &);
+    void operator=(input_log_writer_t const &);
+
+}; // EOF: input_log_writer_t
+
+
+
+/******************************************************************
+ *
+ *  @struct: replayed_input_t
+ *
+ *  @brief:  A slot of a replaying ring, holds the bytes of one
+ *           recorded input of any trx
+ *
+ ******************************************************************/
+
+struct replayed_input_t : public prepared_input_t
+{
+    char*  _buf;
+    size_t _cap;
+
+    replayed_input_t() : _buf(NULL), _cap(0) { }
+    ~replayed_input_t() { if (_buf) free(_buf); }
+
+}; // EOF: replayed_input_t
+
+
+
+/******************************************************************
+ *
+ *  @class: input_log_reader_t
+ *
+ *  @brief: Reads back the records of one client log. Used only by
+ *          the generator thread of the replaying ring.
+ *
+ ******************************************************************/
+
+class input_log_reader_t
+{
+private:
+
+    FILE*              _f;
+    string             _fname;
+    input_log_header_t _hdr;
+    long               _first;
+    long long          _last_usecs;
+
+    bool _get_varint(ulong_t& v);
+
+public:
+
+    input_log_reader_t();
+    ~input_log_reader_t();
+
+    // false if (fname) is missing or not an input log
+    bool open(const string& fname);
+
+    const input_log_header_t& header() const { return (_hdr); }
+
+    // the next record into (slot), false at the end of the log
+    bool next(replayed_input_t* slot);
+
+    // back to the first record
+    void rewind();
+
+private:
+
+    input_log_reader_t(input_log_reader_t const &);
+    void operator=(input_log_reader_t const &);
+
+}; // EOF: input_log_reader_t
+
+
+
+/******************************************************************
+ *
+ *  @class: input_replay_ring_t
+ *
+ *  @brief: A ring whose generator reads the inputs from a log instead
+ *          of generating them. At the end of the log it starts over,
+ *          keeping the submission times increasing.
+ *
+ ******************************************************************/
+
+class input_replay_ring_t : public input_ring_t
+{
+private:
+
+    input_log_reader_t _reader;
+    const int          _capacity;
+    replayed_input_t*  _slots;
+    long long          _base_usecs;
+    long long          _last_usecs;
+
+protected:
+
+    void _prepare(prepared_input_t* pin);
+
+public:
+
+    input_replay_ring_t(const int capacity, const int xct_type,
+                        const double qf, const int sel);
+    ~input_replay_ring_t();
+
+    // opens the log, false if it is not one of a client of (_xct_type),
+    // and starts reading it
+    bool start(const string& fname);
+
+}; // EOF: input_replay_ring_t
+
+
+// the log of client (id) under db-cl-record or db-cl-replay, "" if unset
+string input_log_name(const char* var, const int id);
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_INPUT_LOG_H */
@@ -0,0 +1,303 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_input_ring.h
+ *
+ *  @brief:  Per-client rings of trx inputs generated ahead of time, by
+ *           a thread of their own, so that the workers do not generate
+ *           the inputs of the trxs they run
+ */
+
+#ifndef __SHORE_INPUT_RING_H
+#define __SHORE_INPUT_RING_H
+
+#include "sm_vas.h"
+#include "util.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(shore);
+
+
+// default number of inputs per client ring (0 - generate in the workers)
+const int DF_INPUT_RING_SZ = 0;
+
+// the least number of inputs per ring when recording or replaying
+const int DF_LOGGED_RING_SZ = 128;
+
+
+class input_ring_t;
+class input_log_writer_t;
+
+
+/****************************************************************** 
+ *
+ *  @struct: prepared_input_t
+ *
+ *  @brief:  One slot of an input ring. The slots of a workload derive
+ *           from it, hold one input of each trx they support, and
+ *           point (_input) to the one they filled last. A request
+ *           carries its slot to the worker, which gives it back to
+ *           the ring once the trx body has run.
+ *
+ ******************************************************************/
+
+struct prepared_input_t
+{
+    int           _type;     // the trx to run, mixes already picked
+    int           _spec;     // the spec id the input was made for
+    long long     _usecs;    // when it was submitted, if replayed
+    void*         _input;
+    size_t        _input_sz;
+    input_ring_t* _ring;
+
+    prepared_input_t()
+        : _type(-1), _spec(0), _usecs(0),
+          _input(NULL), _input_sz(0), _ring(NULL)
+    { }
+
+    template <class T>
+    void set(T& in) { _input = &in; _input_sz = sizeof(T); }
+
+    template <class T>
+    T& get() {
+        assert (_input && (_input_sz == sizeof(T)));
+        return (*(T*)_input);
+    }
+
+    // back to the ring, to be generated again; a slot of no ring
+    // belongs to whoever attached it
+    void release();
+
+}; // EOF: prepared_input_t
+
+
+
+/****************************************************************** 
+ *
+ *  @class: input_ring_t
+ *
+ *  @brief: The inputs of the trxs of one client. The generator thread
+ *          takes free slots, fills them in and queues them as ready;
+ *          the client takes the ready ones in order and the workers
+ *          give them back. Both queues are lock-free and hold all the
+ *          slots, so neither side blocks the other: if nothing is
+ *          ready the client leaves the input to the worker (a miss),
+ *          and if nothing is free the generator sleeps a bit.
+ *
+ *          The counters of every ring are reported along with the
+ *          throughput (see print_stats()).
+ *
+ *          When the stream is recorded or replayed (shore_input_log.h)
+ *          there are no misses, the client waits for the next input.
+ *
+ ******************************************************************/
+
+class input_ring_t
+{
+public:
+
+    struct stats_t {
+        ulong_t generated;
+        double  gen_secs;
+        ulong_t taken;
+        ulong_t misses;
+
+        stats_t() : generated(0), gen_secs(0), taken(0), misses(0) { }
+
+        stats_t& operator+=(stats_t const& rhs) {
+            generated += rhs.generated;
+            gen_secs  += rhs.gen_secs;
+            taken     += rhs.taken;
+            misses    += rhs.misses;
+            return (*this);
+        }
+    };
+
+private:
+
+    class generator_t : public thread_t
+    {
+        input_ring_t* _ring;
+    public:
+        generator_t(c_str tname, input_ring_t* ring)
+            : thread_t(tname), _ring(ring) { }
+        void work() { _ring->_generate(); }
+    };
+
+    lockfree_queue_t<prepared_input_t*> _ready;
+    lockfree_queue_t<prepared_input_t*> _free;
+
+    guard<generator_t> _generator;
+    volatile bool      _stop;
+
+    // the generator writes the first two, the client the other two
+    volatile ulong_t   _generated;
+    volatile double    _gen_secs;
+    volatile ulong_t   _taken;
+    volatile ulong_t   _misses;
+    stats_t            _last;
+
+    // the log the inputs taken go to, if recording
+    guard<input_log_writer_t> _log;
+
+    // when the client took its first input, -1 before
+    stopwatch_t        _clock;
+    long long          _t0;
+
+    void _generate();
+
+protected:
+
+    const int    _xct_type;
+    const double _qf;
+    const int    _sel;
+
+    // a logged stream has no holes; a replayed one may keep its times
+    bool         _exact;
+    bool         _paced;
+
+    // fills (pin) with an input of (_xct_type) for (_qf,_sel)
+    virtual void _prepare(prepared_input_t* pin)=0;
+
+    // the slots are owned by the derived ring; starts generating
+    void _start(const std::vector<prepared_input_t*>& slots);
+
+    // waits for the generator to exit, before the slots go
+    void _stop_generator();
+
+public:
+
+    input_ring_t(const int capacity, const int xct_type,
+                 const double qf, const int sel);
+    virtual ~input_ring_t();
+
+    // the next ready input, NULL if there is none. Its _spec is the
+    // one it was generated for (or replayed with), which the request
+    // takes over
+    prepared_input_t* take(const int xct_type);
+
+    // records the inputs taken in the log of client (id), if
+    // db-cl-record is set
+    void record(const int id);
+
+    // called by prepared_input_t::release()
+    void give_back(prepared_input_t* pin);
+
+    // the counters of all the rings, deleted ones included, since
+    // the last reset
+    static void reset_stats();
+    static void print_stats(const double secs);
+
+    // the number of slots per ring, db-cl-input-ring, or at least
+    // DF_LOGGED_RING_SZ when recording or replaying
+    static int ring_size();
+
+private:
+
+    stats_t _get_stats() const;
+
+    input_ring_t(input_ring_t const &);
+    void operator=(input_ring_t const &);
+
+}; // EOF: input_ring_t
+
+
+
+/****************************************************************** 
+ *
+ *  @class: input_ring_impl
+ *
+ *  @brief: The ring of the slots of a workload. Slot derives from
+ *          prepared_input_t and provides:
+ *
+ *          static bool supports(const int xct_type);
+ *          void prepare(const int xct_type, const double qf, const int sel);
+ *
+ *          prepare() finds _spec set to (sel) and narrows it to the
+ *          spec it picked when (sel) is 0.
+ *
+ ******************************************************************/
+
+template <class Slot>
+class input_ring_impl : public input_ring_t
+{
+private:
+
+    Slot* _slots;
+
+protected:
+
+    void _prepare(prepared_input_t* pin) {
+        static_cast<Slot*>(pin)->prepare(_xct_type, _qf, _sel);
+    }
+
+public:
+
+    input_ring_impl(const int capacity, const int xct_type,
+                    const double qf, const int sel)
+        : input_ring_t(capacity, xct_type, qf, sel)
+    {
+        _slots = new Slot[capacity];
+        std::vector<prepared_input_t*> slots;
+        for (int i=0; i<capacity; i++) slots.push_back(&_slots[i]);
+        _start(slots);
+    }
+
+    ~input_ring_impl() {
+        _stop_generator();
+        delete [] _slots;
+    }
+
+}; // EOF: input_ring_impl
+
+
+// a ring replaying the log of client (id), NULL if db-cl-replay is
+// not set or the log is not there (see shore_input_log.cpp)
+input_ring_t* new_replay_ring(const int id, const int xct_type,
+                              const double qf, const int sel);
+
+
+// a ring for client (id) of (xct_type), NULL if the rings are off
+// (db-cl-input-ring = 0 and no db-cl-record/replay) or Slot does not
+// support (xct_type)
+template <class Slot>
+input_ring_t* new_input_ring(const int id, const int xct_type,
+                             const double qf, const int sel)
+{
+    if (!Slot::supports(xct_type)) return (NULL);
+    if (input_ring_t* replay = new_replay_ring(id, xct_type, qf, sel))
+        return (replay);
+
+    int sz = input_ring_t::ring_size();
+    if (sz <= 0) return (NULL);
+    input_ring_t* ring = new input_ring_impl<Slot>(sz, xct_type, qf, sel);
+    ring->record(id);
+    return (ring);
+}
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_INPUT_RING_H */
@@ -0,0 +1,294 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_parallel_scan.h
+ *
+ *  @brief:  Intra-query parallel file scans. The pages of a heap file
+ *           are cut into morsels which the scanning thread and a pool
+ *           of helper threads consume in parallel.
+ *
+ */
+
+#ifndef __SHORE_PARALLEL_SCAN_H
+#define __SHORE_PARALLEL_SCAN_H
+
+#include "sm_vas.h"
+#include "util.h"
+
+#include "sm/shore/shore_iter.h"
+#include "sm/shore/shore_zone_map.h"
+#include "sm/shore/shore_pax.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(shore);
+
+
+class scan_helper_pool_t;
+
+
+
+/******************************************************************
+ *
+ *  @struct: scan_morsel_t
+ *
+ *  @brief:  The records of a few consecutive heap pages, copied out
+ *           of the buffer pool
+ *
+ ******************************************************************/
+
+struct scan_morsel_t
+{
+    std::vector<char> _data;
+    std::vector<uint> _offsets;
+
+    void clear() { _data.clear(); _offsets.clear(); }
+    uint count() const { return (_offsets.size()); }
+    const char* record(uint i) const { return (&_data[_offsets[i]]); }
+    void add(const char* body, uint sz);
+
+}; // EOF: scan_morsel_t
+
+
+
+/******************************************************************
+ *
+ *  @class: scan_consumer_t
+ *
+ *  @brief: The per-thread side of a parallel scan. Each participating
+ *          thread gets its own consumer, which keeps its own row and
+ *          the thread-local partial result of the query. The caller
+ *          merges the partial results once the scan returns.
+ *
+ ******************************************************************/
+
+class scan_consumer_t
+{
+public:
+    virtual ~scan_consumer_t() { }
+
+    /* (record) is the tuple as stored in the heap file;
+       load it with the table manager */
+    virtual void consume(const char* record)=0;
+
+    /* a block of a PAX store, for the scans of PAX copies */
+    virtual void consume_block(const pax_block_t& /* block */) {
+        assert (0); // the consumer reads rows only
+    }
+
+}; // EOF: scan_consumer_t
+
+
+
+/******************************************************************
+ *
+ *  @class: scan_consumers_t
+ *
+ *  @brief: Owns the consumers of one parallel scan, one per thread
+ *          that may join it
+ *
+ ******************************************************************/
+
+template <class Consumer>
+class scan_consumers_t
+{
+    std::vector<Consumer*>        _partials;
+    std::vector<scan_consumer_t*> _consumers;
+
+public:
+
+    scan_consumers_t() { }
+    ~scan_consumers_t() {
+        for (uint i=0; i<_partials.size(); i++)
+            delete (_partials[i]);
+    }
+
+    void add(Consumer* consumer) {
+        assert (consumer);
+        _partials.push_back(consumer);
+        _consumers.push_back(consumer);
+    }
+
+    uint size() const { return (_partials.size()); }
+    Consumer* operator[](uint i) { return (_partials[i]); }
+
+    std::vector<scan_consumer_t*>& consumers() { return (_consumers); }
+
+private:
+
+    scan_consumers_t(scan_consumers_t const &);
+    scan_consumers_t &operator =(scan_consumers_t const &);
+
+}; // EOF: scan_consumers_t
+
+
+
+/******************************************************************
+ *
+ *  @class: parallel_scan_t
+ *
+ *  @brief: A scan over a heap file whose records are processed by
+ *          several threads.
+ *
+ *  @note:  Only the thread that calls run() touches the storage
+ *          manager. It reads MORSEL_PAGES pages at a time into a
+ *          morsel and queues it; helper threads and the caller itself
+ *          (whenever the queue is full) consume the queued morsels.
+ *          Helpers therefore need neither the transaction nor the
+ *          buffer pool.
+ *
+ ******************************************************************/
+
+class parallel_scan_t
+{
+public:
+
+    static const uint MORSEL_PAGES = 8;
+
+private:
+
+    ss_m*               _db;
+    file_desc_t*        _file;
+    lock_mode_t         _lm;
+    scan_helper_pool_t* _pool;
+
+    /* zones of the file that may be skipped */
+    zone_map_t*         _zones;
+    zone_range_t        _range;
+
+    /* set if the file is a PAX copy, whose records are blocks */
+    pax_store_t*        _pax;
+
+    pthread_mutex_t     _lock;
+    pthread_cond_t      _cond;
+
+    /* queued and recycled morsels */
+    std::vector<scan_morsel_t*> _full;
+    std::vector<scan_morsel_t*> _free;
+    bool                _done;
+    int                 _helpers;
+
+public:
+
+    /* (pool) may be NULL, then the caller scans alone */
+    parallel_scan_t(ss_m* db, file_desc_t* file, scan_helper_pool_t* pool,
+                    lock_mode_t alm = SH);
+
+    /* Reads only the zones of (table) that may hold records in (range) */
+    parallel_scan_t(ss_m* db, table_desc_t* table, const zone_range_t& range,
+                    scan_helper_pool_t* pool, lock_mode_t alm = SH);
+
+    /* Reads the blocks of a PAX copy, handed to consume_block() */
+    parallel_scan_t(ss_m* db, pax_store_t* pax,
+                    scan_helper_pool_t* pool, lock_mode_t alm = SH);
+    ~parallel_scan_t();
+
+    /* How many consumers run() can keep busy: the caller plus every
+       helper. Fewer threads may join if helpers are busy elsewhere. */
+    static int degree(scan_helper_pool_t* pool);
+
+    /* Scans the whole file. (consumers)[0] belongs to the caller. */
+    w_rc_t run(std::vector<scan_consumer_t*>& consumers);
+
+    /* Helper side, called by scan_helper_pool_t */
+    void help(scan_consumer_t* consumer);
+
+private:
+
+    void _consume(scan_morsel_t* morsel, scan_consumer_t* consumer);
+    scan_morsel_t* _get_free();
+    void _put_free(scan_morsel_t* morsel);
+
+    parallel_scan_t(parallel_scan_t const &);
+    parallel_scan_t &operator =(parallel_scan_t const &);
+
+}; // EOF: parallel_scan_t
+
+
+
+/******************************************************************
+ *
+ *  @class: scan_helper_pool_t
+ *
+ *  @brief: Helper smthreads that lend themselves to parallel scans.
+ *          A scan enlists the helpers that are idle when it starts,
+ *          so concurrent queries share the pool without waiting for
+ *          each other.
+ *
+ ******************************************************************/
+
+class scan_helper_t;
+
+class scan_helper_pool_t
+{
+    friend class scan_helper_t;
+
+    pthread_mutex_t _lock;
+    pthread_cond_t  _cond;
+
+    std::vector<scan_helper_t*> _helpers;
+    bool _stop;
+
+public:
+
+    scan_helper_pool_t(const int helpers);
+    ~scan_helper_pool_t();
+
+    int size() const { return (_helpers.size()); }
+
+    /* Hands (consumers)[1..] to idle helpers, which then call
+       scan->help(). Returns how many helpers were enlisted. */
+    int enlist(parallel_scan_t* scan, std::vector<scan_consumer_t*>& consumers);
+
+private:
+
+    scan_helper_pool_t(scan_helper_pool_t const &);
+    scan_helper_pool_t &operator =(scan_helper_pool_t const &);
+
+}; // EOF: scan_helper_pool_t
+
+
+
+class scan_helper_t : public thread_t
+{
+    scan_helper_pool_t* _pool;
+
+public:
+
+    parallel_scan_t* _scan;
+    scan_consumer_t* _consumer;
+
+    scan_helper_t(const c_str &name, scan_helper_pool_t* pool)
+        : thread_t(name), _pool(pool), _scan(NULL), _consumer(NULL)
+    { }
+    ~scan_helper_t() { }
+
+    void work();
+
+}; // EOF: scan_helper_t
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_PARALLEL_SCAN_H */
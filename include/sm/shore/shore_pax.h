@@ -0,0 +1,212 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_pax.h
+ *
+ *  @brief:  PAX column groups - a read-optimized copy of the fixed-width
+ *           columns of a table. Every block keeps the values of a run
+ *           of rows column by column, one mini-page per column, so a
+ *           scan only brings the columns it reads into the cache.
+ *
+ */
+
+#ifndef __SHORE_PAX_H
+#define __SHORE_PAX_H
+
+#include "sm_vas.h"
+#include "util.h"
+
+#include "sm/shore/shore_file_desc.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(shore);
+
+
+class table_desc_t;
+class table_man_t;
+class pax_store_t;
+
+
+
+/******************************************************************
+ *
+ *  @class: pax_block_t
+ *
+ *  @brief: A view of one block of a PAX store: (rows) values of every
+ *          column of the store. column<T>(pos) is the mini-page of the
+ *          (pos)-th column of the store, e.g. column<double>() for an
+ *          SQL_FLOAT and column<int>() for an SQL_INT or SQL_DATE.
+ *          SQL_FIXCHAR values are width() bytes apart and not
+ *          terminated.
+ *
+ ******************************************************************/
+
+class pax_block_t
+{
+public:
+
+    static const uint MAX_COLUMNS = 32;
+
+private:
+
+    const char* _data;
+    uint        _rows;
+    uint        _offsets[MAX_COLUMNS];
+
+public:
+
+    pax_block_t() : _data(NULL), _rows(0) { }
+
+    void set(const pax_store_t* store, const char* body);
+
+    uint rows() const { return (_rows); }
+
+    template <class T>
+    const T* column(const uint pos) const {
+        return ((const T*)(_data + _offsets[pos]));
+    }
+
+}; // EOF: pax_block_t
+
+
+
+/******************************************************************
+ *
+ *  @class: pax_store_t
+ *
+ *  @brief: The PAX copy of a table, kept in the "<table>_PAX" heap
+ *          file. Every record of the file is a block of up to
+ *          capacity() rows, sized to stay a small record.
+ *
+ *  @note:  The copy is built in bulk from the row heap by build(),
+ *          which the environments call once loading finishes, and at
+ *          start if the copy is missing or stale. Any insert, update
+ *          or delete on the table marks it stale, and the scans fall
+ *          back to the row heap until the next build().
+ *
+ ******************************************************************/
+
+class pax_store_t
+{
+public:
+
+    /* blocks written per transaction of build() */
+    static const uint BUILD_BLOCKS_PER_XCT = 256;
+
+private:
+
+    table_desc_t*     _table;
+    std::vector<uint> _fields;
+    std::vector<uint> _widths;
+    uint              _row_width;
+
+    pthread_mutex_t   _lock;
+    volatile bool     _current;
+
+    file_desc_t       _file;
+    rid_t             _header_rid;
+
+public:
+
+    pax_store_t(table_desc_t* table, const uint* fields, const uint count);
+    ~pax_store_t();
+
+    file_desc_t* file() { return (&_file); }
+
+    uint columns() const { return (_fields.size()); }
+    uint field(const uint pos) const { return (_fields[pos]); }
+    uint width(const uint pos) const { return (_widths[pos]); }
+
+    /* position of a field of the table in the store, -1 if not stored */
+    int  column_of(const uint field) const;
+
+    /* rows per block */
+    uint capacity() const;
+
+    /* whether the copy matches the row heap */
+    bool is_current() const { return (_current); }
+
+    /* tells blocks from the header of the file */
+    static bool is_block(const char* body);
+
+
+    /* --- inside a transaction --- */
+
+    w_rc_t create_physical(ss_m* db);
+    w_rc_t load(ss_m* db);
+    w_rc_t invalidate(ss_m* db);
+
+
+    /* --- outside a transaction, runs its own --- */
+
+    w_rc_t build(ss_m* db, table_man_t* pmanager);
+
+private:
+
+    w_rc_t _drop_blocks(ss_m* db);
+    w_rc_t _write_block(ss_m* db, std::vector<char>& buf,
+                        const std::vector<char>& values, const uint rows);
+    w_rc_t _write_header(const bool valid, const uint blocks, const uint rows);
+
+    pax_store_t(pax_store_t const &);
+    pax_store_t &operator =(pax_store_t const &);
+
+}; // EOF: pax_store_t
+
+
+
+/******************************************************************
+ *
+ *  @class: pax_scan_iter_t
+ *
+ *  @brief: Reads a PAX store a block at a time. The block returned
+ *          by next() is valid until the following call.
+ *
+ ******************************************************************/
+
+class pax_scan_iter_t
+{
+    pax_store_t*       _store;
+    lock_mode_t        _lm;
+    guard<scan_file_i> _scanner;
+
+public:
+
+    pax_scan_iter_t(pax_store_t* store, lock_mode_t alm = SH);
+    ~pax_scan_iter_t() { }
+
+    w_rc_t next(bool& eof, pax_block_t& block);
+
+private:
+
+    pax_scan_iter_t(pax_scan_iter_t const &);
+    pax_scan_iter_t &operator =(pax_scan_iter_t const &);
+
+}; // EOF: pax_scan_iter_t
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_PAX_H */
@@ -40,6 +40,8 @@
 ENTER_NAMESPACE(shore);
 
 
+struct prepared_input_t;
+
 const int NO_VALID_TRX_ID = -1;
 
 /******************************************************************** 
@@ -200,15 +202,18 @@ struct trx_request_t : public base_request_t
     int                 _xct_type;
     int                 _spec_id; 
 
+    // the input generated ahead by the client, if any (not the owner)
+    prepared_input_t*   _input;
+
     trx_request_t() 
-        : base_request_t(), _xct_type(-1),_spec_id(0)
+        : base_request_t(), _xct_type(-1),_spec_id(0),_input(NULL)
     { }
 
     trx_request_t(xct_t* pxct, const tid_t& atid, const int axctid,
                   const trx_result_tuple_t& aresult, 
                   const int axcttype, const int aspecid)
         : base_request_t(pxct,atid,axctid,aresult),
-          _xct_type(axcttype), _spec_id(aspecid)
+          _xct_type(axcttype), _spec_id(aspecid), _input(NULL)
     {
     }
 
@@ -221,11 +226,15 @@ struct trx_request_t : public base_request_t
         base_request_t::set(pxct,atid,axctid,aresult);
         _xct_type = axcttype;
         _spec_id = aspecid;
+        _input = NULL;
     }
 
     inline int type() const { return (_xct_type); }
     inline void set_type(const int atype) { _xct_type = atype; }
     inline int selectedID() { return (_spec_id); }
+    inline void set_selectedID(const int aspecid) { _spec_id = aspecid; }
+    inline prepared_input_t* input() { return (_input); }
+    inline void set_input(prepared_input_t* pin) { _input = pin; }
 
 }; // EOF: trx_request_t
 
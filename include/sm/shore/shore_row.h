@@ -333,7 +333,11 @@ inline void table_row_t::set_value(const uint idx, const int v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
-    _pvalues[idx].set_int_value(v);
+    // a date_t is an int
+    if (_pvalues[idx].field_desc()->type() == SQL_DATE)
+        _pvalues[idx].set_date_value(v);
+    else
+        _pvalues[idx].set_int_value(v);
 }
 
 inline void table_row_t::set_value(const uint idx, const bool v) 
@@ -399,7 +403,13 @@ inline void table_row_t::set_value(const uint idx, const char* string)
     assert (_pvalues[idx].is_setup());
 
     sqltype_t sqlt = _pvalues[idx].field_desc()->type();
-    assert (sqlt == SQL_VARCHAR || sqlt == SQL_FIXCHAR );
+    assert (sqlt == SQL_VARCHAR || sqlt == SQL_FIXCHAR || sqlt == SQL_DATE);
+
+    if ( sqlt == SQL_DATE ) {
+        // YYYY-MM-DD, as produced by the data generators
+        _pvalues[idx].set_date_value(str_to_date(string));
+        return;
+    }
 
     int len = strlen(string);
     if ( sqlt == SQL_VARCHAR ) { 
@@ -437,7 +447,11 @@ inline bool table_row_t::get_value(const uint idx,
         dest = 0;
         return false;
     }
-    dest = _pvalues[idx].get_int_value();
+    // a date_t is an int
+    if (_pvalues[idx].field_desc()->type() == SQL_DATE)
+        dest = _pvalues[idx].get_date_value();
+    else
+        dest = _pvalues[idx].get_int_value();
     return true;
 }
 
@@ -90,6 +90,8 @@ DECLARE_ENV_CMD(dump);
 DECLARE_ENV_CMD(fake_iodelay);
 DECLARE_ENV_CMD(freq);
 DECLARE_ENV_CMD(skew);
+DECLARE_ENV_CMD(mix);
+DECLARE_ENV_CMD(scenario);
 DECLARE_ENV_CMD(db_print);
 DECLARE_ENV_CMD(db_fetch);
 DECLARE_ENV_CMD(stats_verbose);
@@ -210,6 +212,8 @@ protected:
     guard<fake_iodelay_cmd_t>   _fakeioer;   
     guard<freq_cmd_t>           _freqer;
     guard<skew_cmd_t>           _skewer;
+    guard<mix_cmd_t>            _mixer;
+    guard<scenario_cmd_t>       _scenarioer;
     guard<stats_verbose_cmd_t>  _stats_verboser;
     guard<db_print_cmd_t>       _db_printer;
     guard<db_fetch_cmd_t>       _db_fetch;
@@ -288,6 +292,14 @@ public:
 
     virtual w_rc_t prepareNewRun() { return (RCOK); }
 
+    // creates a client of the kit, for commands that run their own
+    // client pools
+    virtual base_client_t* new_client(c_str tname, const int id,
+                                      const MeasurementType aType,
+                                      const int trxid, const int numOfTrxs,
+                                      processorid_t aprsid,
+                                      const int sWH, const double qf)=0;
+
     // for the client processor binding policy
     virtual processorid_t next_cpu(const eBindingType abt,
                                    const processorid_t aprd);
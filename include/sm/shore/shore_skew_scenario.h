@@ -0,0 +1,131 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_skew_scenario.h
+ *
+ *  @brief:  Thread that changes the key distribution of the inputs
+ *           over time, e.g. moving a hotspot or ramping up the skew
+ */
+
+#ifndef __SHORE_SKEW_SCENARIO_H
+#define __SHORE_SKEW_SCENARIO_H
+
+#include <vector>
+
+#include "sm_vas.h"
+#include "util.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+class ShoreEnv;
+
+
+/****************************************************************** 
+ *
+ *  @struct: skew_phase_t
+ *
+ *  @brief:  One step of a scenario: the inputs follow (_spec) for
+ *           (_secs) seconds
+ *
+ ******************************************************************/
+
+struct skew_phase_t
+{
+    int            _secs;
+    keydist_spec_t _spec;
+
+    skew_phase_t() : _secs(0) { }
+    skew_phase_t(const int secs, const keydist_spec_t& spec)
+        : _secs(secs), _spec(spec) { }
+};
+
+
+/****************************************************************** 
+ *
+ *  @class: skew_scenario_t
+ *
+ *  @brief: Walks through a list of phases, setting the key
+ *          distribution of the environment at the start of each, and
+ *          reports the throughput of every phase it completes.
+ *
+ *          If looping, it starts over after the last phase until
+ *          stopped; otherwise it keeps the distribution of the last
+ *          phase. The throughput is taken from the environment
+ *          counters, which only count while measuring.
+ *
+ ******************************************************************/
+
+class skew_scenario_t : public thread_t 
+{
+public:
+
+    struct result_t {
+        int            _phase;
+        keydist_spec_t _spec;
+        double         _secs;
+        uint_t         _commits;
+        uint_t         _attempts;
+    };
+
+private:
+
+    ShoreEnv*                 _env;
+    std::vector<skew_phase_t> _phases;
+    bool                      _loop;
+    volatile bool             _stop;
+
+    pthread_mutex_t           _results_mutex;
+    std::vector<result_t>     _results;
+    volatile int              _current;
+
+public:
+
+    skew_scenario_t(ShoreEnv* env, 
+                    const std::vector<skew_phase_t>& phases,
+                    const bool loop);
+    ~skew_scenario_t();
+
+    void work();
+
+    // asks the thread to finish; it returns from work() within ~100ms
+    void stop() { _stop = true; }
+
+    // the phase being run (-1 before the first and after the last)
+    int current() const { return (*&_current); }
+
+    void print_results();
+
+    // Parses a scenario description (see the "scenario" shell command).
+    // Returns false if it is malformed.
+    static bool parse(const char* desc,
+                      std::vector<skew_phase_t>& phases,
+                      bool& loop);
+
+}; // EOF: skew_scenario_t
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_SKEW_SCENARIO_H */
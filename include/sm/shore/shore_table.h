@@ -102,6 +102,8 @@
 #include "shore_field.h"
 #include "shore_index.h"
 #include "shore_row.h"
+#include "shore_zone_map.h"
+#include "shore_pax.h"
 
 
 ENTER_NAMESPACE(shore);
@@ -131,6 +133,11 @@ protected:
     
     index_desc_t*   _indexes;            // indexes on the table
     index_desc_t*   _primary_idx;        // pointer to primary idx
+
+    zone_map_t*     _zone_map;           // min/max synopsis, if any
+    pax_store_t*    _pax;                // column-group copy, if any
+
+    bool            _defer_indexes;      // loading writes only the heap
   
     volatile uint_t _maxsize;            // max tuple size for this table, shortcut
     
@@ -224,6 +231,12 @@ public:
     index_desc_t* primary_idx() { return (_primary_idx); }
     stid_t get_primary_stid();
 
+    // @note: While set, add_tuple() writes only the heap record and the
+    //        indexes stay empty until table_man_t::bulk_build_index()
+    //        fills them in key order. Only for loading.
+    void set_defer_indexes(const bool defer) { _defer_indexes = defer; }
+    bool defer_indexes() const { return (_defer_indexes); }
+
 
     /* sets primary index, the index itself should be already set to
      * primary and unique */
@@ -235,6 +248,29 @@ public:
     char* index_keydesc(index_desc_t* idx);
     int   index_maxkeysize(index_desc_t* index) const; /* max index key size */
 
+
+    /* ---------------- */
+    /* --- zone map --- */
+    /* ---------------- */
+
+    // @note: Like the indexes, it has to be set before create_physical_table()
+    //        or load_and_register_fid()
+    void create_zone_map(const uint* fields, const uint num,
+                         const uint zone_pages = zone_map_t::DEFAULT_ZONE_PAGES);
+
+    zone_map_t* zone_map() { return (_zone_map); }
+
+
+    /* ----------------- */
+    /* --- PAX store --- */
+    /* ----------------- */
+
+    // @note: Only with PD_PAX, and like the zone map before
+    //        create_physical_table() or load_and_register_fid()
+    void create_pax_store(const uint* fields, const uint num);
+
+    pax_store_t* pax_store() { return (_pax); }
+
     /* ---------------------------------------------------------------- */
     /* --- for the conversion between disk format and memory format --- */
     /* ---------------------------------------------------------------- */
@@ -407,6 +443,9 @@ public:
 			      const lock_mode_t lock_mode = EX,
 			      const lpid_t& primary_root = lpid_t::null);
     
+    // fills a (deferred) index from the heap, in key order
+    w_rc_t    bulk_build_index(ss_m* db, index_desc_t* pindex);
+    
     w_rc_t    add_plp_tuple(ss_m* db, 
                             table_tuple*  ptuple, 
                             const lock_mode_t lock_mode,
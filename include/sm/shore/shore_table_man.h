@@ -28,6 +28,7 @@
  *
  *  @note:   table_man_impl       - class for table-related operations
  *           table_scan_iter_impl - table scanner
+ *           zone_scan_iter_impl  - table scanner that skips zones
  *           index_scan_iter_impl - index scanner
  *
  *  @author: Ippokratis Pandis, January 2008
@@ -80,6 +81,9 @@ ENTER_NAMESPACE(shore);
 template <class TableDesc>
 class table_scan_iter_impl;
 
+template <class TableDesc>
+class zone_scan_iter_impl;
+
 template <class TableDesc>
 class index_scan_iter_impl;
 
@@ -98,6 +102,7 @@ class table_man_impl : public table_man_t
 {
 public:
     typedef table_scan_iter_impl<TableDesc> table_iter;
+    typedef zone_scan_iter_impl<TableDesc>  zone_iter;
     typedef index_scan_iter_impl<TableDesc> index_iter;
     typedef row_cache_t<TableDesc> row_cache;
 
@@ -149,6 +154,12 @@ public:
 				  table_iter* &iter,
                                   lock_mode_t alm = SH);
 
+    // file scan that skips the zones which cannot be in (range)
+    w_rc_t get_iter_for_zone_scan(ss_m* db,
+                                  zone_iter* &iter,
+                                  const zone_range_t& range,
+                                  lock_mode_t alm = SH);
+
     w_rc_t get_iter_for_index_scan(ss_m* db,
 				   index_desc_t* pindex,
 				   index_iter* &iter,
@@ -288,6 +299,67 @@ public:
 
 
 
+/* ---------------------------------------------------------------
+ *
+ * @class: zone_scan_iter_impl
+ *
+ * @brief: Table scan iterator that reads only the zones of the table
+ *         which may hold records in a range. The records it returns
+ *         still have to be checked against the predicate.
+ *
+ * --------------------------------------------------------------- */
+
+template <class TableDesc>
+class zone_scan_iter_impl : 
+    public tuple_iter_t<TableDesc, zone_scan_iter_t, table_row_t >
+{
+public:
+    typedef table_row_t table_tuple;
+    typedef table_man_impl<TableDesc> table_manager;
+    typedef tuple_iter_t<TableDesc, zone_scan_iter_t, table_row_t > table_iter;
+
+private:
+
+    table_manager* _pmanager;
+
+public:
+
+    zone_scan_iter_impl(ss_m* db, 
+                        TableDesc* ptable,
+                        table_manager* pmanager,
+                        const zone_range_t& range,
+                        lock_mode_t alm) 
+        : table_iter(db, ptable, alm, true), _pmanager(pmanager)
+    { 
+        assert (_pmanager);
+        table_iter::_scan = new zone_scan_iter_t(db, ptable, ptable->zone_map(),
+                                                 range, alm);
+        table_iter::_opened = true;
+    }
+        
+    ~zone_scan_iter_impl() { 
+        tuple_iter_t<TableDesc, zone_scan_iter_t, table_row_t >::close_scan(); 
+    }
+
+    w_rc_t next(ss_m* /* db */, bool& eof, table_tuple& tuple) {
+        assert (_pmanager);
+        assert (table_iter::_opened);
+        pin_i* handle;
+        W_DO(table_iter::_scan->next(eof, handle));
+        if (!eof) {
+            if (!_pmanager->load(&tuple, handle->body()))
+                return RC(se_WRONG_DISK_DATA);
+            tuple.set_rid(handle->rid());
+        }
+        return (RCOK);
+    }
+
+    uint skipped() const { return (table_iter::_scan->skipped()); }
+
+}; // EOF: zone_scan_iter_impl
+
+
+
 /* ---------------------------------------------------------------------
  *
  * @class: index_scan_iter_impl
@@ -438,6 +510,19 @@ w_rc_t table_man_impl<TableDesc>::get_iter_for_file_scan(ss_m* db,
 }
 
 
+template <class TableDesc>
+w_rc_t table_man_impl<TableDesc>::get_iter_for_zone_scan(ss_m* db,
+                                                         zone_iter* &iter,
+                                                         const zone_range_t& range,
+                                                         lock_mode_t alm)
+{
+    assert (_ptable);
+    iter = new zone_scan_iter_impl<TableDesc>(db, _pspecifictable, this, range, alm);
+    if (iter->opened()) return (RCOK);
+    return RC(se_OPEN_SCAN_ERROR);
+}
+
+
 template <class TableDesc>
 w_rc_t table_man_impl<TableDesc>::get_iter_for_index_scan(ss_m* db,
                                                           index_desc_t* index,
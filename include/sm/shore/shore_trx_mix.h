@@ -0,0 +1,150 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_trx_mix.h
+ *
+ *  @brief:  Transaction mixes as tables of weights, and the registry
+ *           of the trxs an environment runs, by trx id
+ *
+ *  @note:   A mix is written as <trx id>:<weight> pairs, e.g. the
+ *           TPC-C mix of the spec "1:45 2:43 3:4 4:4 5:4". The
+ *           weights need not add up to anything, only the ratios
+ *           count. A mix picks trxs, not other mixes.
+ */
+
+#ifndef __SHORE_TRX_MIX_H
+#define __SHORE_TRX_MIX_H
+
+#include "sm_vas.h"
+#include "util.h"
+
+#include "sm/shore/shore_reqs.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(shore);
+
+
+/****************************************************************** 
+ *
+ *  @class: trx_mix_t
+ *
+ *  @brief: The trxs of a mix and their weights, compiled into an
+ *          alias table so that picking one is O(1) whatever their
+ *          number. Once built it is only read, by any thread, each
+ *          drawing from its own random generator.
+ *
+ ******************************************************************/
+
+class trx_mix_t
+{
+private:
+
+    std::vector<int>    _trxs;
+    std::vector<double> _weights;
+    alias_table_t       _table;
+
+public:
+
+    trx_mix_t() { }
+
+    // adds (xct_type) with (weight), effective after build()
+    void add(const int xct_type, const double weight);
+
+    // false if no weight is positive
+    bool build();
+
+    // replaces the mix with the pairs of (spec), false if it does
+    // not parse or has no positive weight
+    bool parse(const char* spec);
+
+    bool empty() const { return (_table.size() == 0); }
+    const std::vector<int>& trxs() const { return (_trxs); }
+
+    // the mix without (xct_type), empty if nothing else has weight
+    trx_mix_t without(const int xct_type) const;
+
+    // one of the trxs, by weight
+    int pick() const {
+        assert (!empty());
+        int col = URand(0, _table.size()-1);
+        double coin = URand(0, 999999)/1000000.0;
+        return (_trxs[_table.pick(col, coin)]);
+    }
+
+    string to_string() const;
+
+}; // EOF: trx_mix_t
+
+
+
+/****************************************************************** 
+ *
+ *  @class: trx_registry_t
+ *
+ *  @brief: The run_* function of each trx id of an environment, so
+ *          that run_one_xct() is a lookup instead of a switch
+ *
+ ******************************************************************/
+
+template <class Env>
+class trx_registry_t
+{
+public:
+
+    typedef w_rc_t (Env::*run_fn)(trx_request_t*);
+
+private:
+
+    std::vector<run_fn> _run;
+
+public:
+
+    trx_registry_t() { }
+
+    void add(const int xct_type, run_fn fn) {
+        assert (xct_type >= 0 && fn);
+        if ((int)_run.size() <= xct_type) _run.resize(xct_type+1, (run_fn)NULL);
+        _run[xct_type] = fn;
+    }
+
+    bool has(const int xct_type) const {
+        return ((xct_type >= 0) && (xct_type < (int)_run.size()) && _run[xct_type]);
+    }
+
+    w_rc_t run(Env* env, trx_request_t* prequest) const {
+        int xct_type = prequest->type();
+        if (!has(xct_type)) {
+            TRACE( TRACE_ALWAYS, "Unknown trx (%d)\n", xct_type);
+            assert (0); // UNKNOWN TRX-ID
+        }
+        return ((env->*_run[xct_type])(prequest));
+    }
+
+}; // EOF: trx_registry_t
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_TRX_MIX_H */
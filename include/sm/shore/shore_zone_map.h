@@ -0,0 +1,244 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_zone_map.h
+ *
+ *  @brief:  Zone maps - per-block min/max synopses over a few numeric
+ *           columns of a table, and a file scan that skips the blocks
+ *           whose synopsis cannot match a range predicate.
+ *
+ */
+
+#ifndef __SHORE_ZONE_MAP_H
+#define __SHORE_ZONE_MAP_H
+
+#include "sm_vas.h"
+#include "util.h"
+#include "util/arena_hash.h"
+
+#include "sm/shore/shore_file_desc.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(shore);
+
+
+class table_desc_t;
+class table_man_t;
+struct table_row_t;
+
+
+
+/******************************************************************
+ *
+ *  @class: zone_range_t
+ *
+ *  @brief: A conjunction of closed ranges over zone-mapped fields.
+ *          The bounds only have to be conservative: for "x < hi" it
+ *          is enough to pass [.., hi]. Fields without a zone map are
+ *          ignored.
+ *
+ ******************************************************************/
+
+class zone_range_t
+{
+public:
+
+    struct bound_t {
+        uint   _field;
+        double _lo;
+        double _hi;
+    };
+
+private:
+
+    std::vector<bound_t> _bounds;
+
+public:
+
+    zone_range_t() { }
+
+    zone_range_t& add(const uint field, const double lo, const double hi);
+
+    bool is_empty() const { return (_bounds.empty()); }
+    uint count() const { return (_bounds.size()); }
+    const bound_t& operator[](const uint i) const { return (_bounds[i]); }
+
+    c_str to_string() const;
+
+}; // EOF: zone_range_t
+
+
+
+/******************************************************************
+ *
+ *  @class: zone_map_t
+ *
+ *  @brief: The synopsis of a table. The heap pages are grouped into
+ *          zones of (zone_pages) consecutive page ids; every zone
+ *          keeps the smallest rid seen in it and the [min,max] of
+ *          each tracked field.
+ *
+ *  @note:  A zone is at most one Shore extent (1, 2, 4 or 8 pages), so
+ *          its pages are consecutive in the file order too. That is
+ *          what lets a scan start at the first rid of any zone and
+ *          read the whole zone.
+ *
+ *  @note:  The synopsis is kept in memory. It is widened by every
+ *          add_tuple() and update_tuple() and never shrunk by deletes.
+ *          It is written to the "<table>_ZM" heap file when the
+ *          environment stops and read back by load_and_register_fid().
+ *          While the environment runs, the persistent copy is marked
+ *          invalid, so after a crash it is rebuilt with one scan.
+ *
+ ******************************************************************/
+
+class zone_map_t
+{
+public:
+
+    static const uint DEFAULT_ZONE_PAGES = 8;
+    static const uint MAX_FIELDS = 8;
+
+private:
+
+    table_desc_t*     _table;
+    std::vector<uint> _fields;
+    uint              _zone_pages;
+
+    /* per zone, in the order the zones were met */
+    std::vector<uint>   _blocks;
+    std::vector<rid_t>  _firsts;
+    std::vector<double> _bounds;   // [min,max] of each field
+    arena_hash_map_t<uint,uint> _zone_of;
+
+    pthread_mutex_t   _lock;
+    bool              _dirty;
+
+    /* the persistent copy */
+    file_desc_t       _file;
+    rid_t             _header_rid;
+
+public:
+
+    zone_map_t(table_desc_t* table, const uint* fields, const uint count,
+               const uint zone_pages = DEFAULT_ZONE_PAGES);
+    ~zone_map_t();
+
+    uint zone_pages() const { return (_zone_pages); }
+    uint zones();
+
+
+    /* --- maintenance --- */
+
+    void add(const table_row_t* ptuple);
+    void clear();
+
+
+    /* --- scans --- */
+
+    /* zone of a heap page, -1 if not known */
+    int  zone_of(const lpid_t& pid);
+
+    /* for every zone whether it may hold records in (range), and the
+       rid a scan of it starts from */
+    uint select(const zone_range_t& range,
+                std::vector<bool>& qualifies, std::vector<rid_t>& firsts);
+
+
+    /* --- persistence, inside a transaction --- */
+
+    w_rc_t create_physical(ss_m* db);
+    w_rc_t load(ss_m* db, table_man_t* pmanager);
+    w_rc_t rebuild(ss_m* db, table_man_t* pmanager);
+    w_rc_t save(ss_m* db);
+    w_rc_t invalidate(ss_m* db);
+
+private:
+
+    double _value(const table_row_t* ptuple, const uint field) const;
+    w_rc_t _write_header(const bool valid);
+
+    zone_map_t(zone_map_t const &);
+    zone_map_t &operator =(zone_map_t const &);
+
+}; // EOF: zone_map_t
+
+
+
+/******************************************************************
+ *
+ *  @class: zone_scan_iter_t
+ *
+ *  @brief: A file scan that reads only the zones which may hold
+ *          records in a range. It walks the qualifying zones in the
+ *          order of the synopsis; while it reads one it keeps going
+ *          into the next zone of the file if that one qualifies too,
+ *          and otherwise restarts at the first rid of the next
+ *          qualifying zone.
+ *
+ *  @note:  Without a zone map or with an empty range it is a plain
+ *          file scan. Pages that are not in the synopsis yet are
+ *          read, never skipped.
+ *
+ ******************************************************************/
+
+class zone_scan_iter_t
+{
+    ss_m*         _db;
+    file_desc_t*  _file;
+    zone_map_t*   _zones;
+    lock_mode_t   _lm;
+
+    guard<scan_file_i> _scanner;
+
+    std::vector<bool>  _pending;   // qualifying and not read yet
+    std::vector<rid_t> _firsts;
+    uint          _next;
+    int           _cur;
+    shpid_t       _cur_page;
+    uint          _skipped;
+
+public:
+
+    zone_scan_iter_t(ss_m* db, file_desc_t* file, zone_map_t* zones,
+                     const zone_range_t& range, lock_mode_t alm);
+    ~zone_scan_iter_t() { }
+
+    w_rc_t next(bool& eof, pin_i*& handle);
+
+    /* zones the scan does not need to read */
+    uint skipped() const { return (_skipped); }
+
+private:
+
+    zone_scan_iter_t(zone_scan_iter_t const &);
+    zone_scan_iter_t &operator =(zone_scan_iter_t const &);
+
+}; // EOF: zone_scan_iter_t
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_ZONE_MAP_H */
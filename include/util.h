@@ -56,6 +56,13 @@
 #include "util/w_strlcpy.h"
 #include "util/procstat.h"
 #include "util/skewer.h"
+#include "util/keydist.h"
+#include "util/arena.h"
+#include "util/arena_hash.h"
+#include "util/top_n.h"
+#include "util/lockfree_queue.h"
+#include "util/timer_wheel.h"
+#include "util/alias_table.h"
 
 #ifdef HAVE_CPUMON
 #ifdef HAVE_GLIBTOP
@@ -0,0 +1,105 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   alias_table.h
+ *
+ *  @brief:  Walker's alias method, to pick one of n outcomes of given
+ *           weights in O(1)
+ */
+
+#ifndef __UTIL_ALIAS_TABLE_H
+#define __UTIL_ALIAS_TABLE_H
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+
+/**
+ *  @brief Built once from the weights of n outcomes (Vose's variant,
+ *  O(n)), then each pick() is a column and a biased coin: the column
+ *  is kept with probability _prob[column], else its alias is taken.
+ *  The caller draws both numbers, so the table has no RNG and can be
+ *  shared by any number of threads once built.
+ */
+class alias_table_t
+{
+    std::vector<double> _prob;
+    std::vector<size_t> _alias;
+
+public:
+
+    alias_table_t() { }
+
+    size_t size() const { return _prob.size(); }
+
+    /* false if no weight is positive; negative weights count as 0 */
+    bool build(std::vector<double> const &weights) {
+        const size_t n = weights.size();
+        _prob.assign(n, 0);
+        _alias.assign(n, 0);
+
+        double total = 0;
+        for (size_t i=0; i < n; i++)
+            if (weights[i] > 0) total += weights[i];
+        if (total <= 0) {
+            _prob.clear();
+            _alias.clear();
+            return false;
+        }
+
+        // scaled so that the average column is 1
+        std::vector<double> p(n);
+        std::vector<size_t> small, large;
+        for (size_t i=0; i < n; i++) {
+            p[i] = (weights[i] > 0 ? weights[i] : 0)*n/total;
+            if (p[i] < 1) small.push_back(i);
+            else large.push_back(i);
+        }
+
+        // each short column is topped up from a tall one
+        while (!small.empty() && !large.empty()) {
+            size_t s = small.back(); small.pop_back();
+            size_t l = large.back(); large.pop_back();
+            _prob[s] = p[s];
+            _alias[s] = l;
+            p[l] -= (1 - p[s]);
+            if (p[l] < 1) small.push_back(l);
+            else large.push_back(l);
+        }
+
+        // what is left is full, up to rounding
+        for (size_t i=0; i < large.size(); i++) _prob[large[i]] = 1;
+        for (size_t i=0; i < small.size(); i++) _prob[small[i]] = 1;
+        return true;
+    }
+
+    /* (column) in [0,size()), (coin) in [0,1) */
+    size_t pick(size_t column, double coin) const {
+        assert (column < _prob.size());
+        return (coin < _prob[column] ? column : _alias[column]);
+    }
+};
+
+
+#endif
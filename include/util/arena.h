@@ -0,0 +1,89 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   arena.h
+ *
+ *  @brief:  Bump-pointer memory arena for short-lived query state
+ */
+
+#ifndef __UTIL_ARENA_H
+#define __UTIL_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+ *  @brief Hands out memory from large chunks by bumping a pointer.
+ *  Nothing is freed individually; everything goes away with the arena
+ *  (or with reset()). The owner runs the destructors of whatever it
+ *  built in the arena.
+ */
+class arena_t
+{
+public:
+
+    enum { DEFAULT_CHUNK = 64*1024,
+           ALIGN         = 8 };
+
+private:
+
+    std::vector<char*> _chunks;
+    size_t _chunk_size;
+    char*  _next;
+    size_t _left;
+    size_t _allocated;
+
+public:
+
+    arena_t(size_t chunk_size = DEFAULT_CHUNK);
+    ~arena_t();
+
+    void* allocate(size_t sz) {
+        sz = (sz + ALIGN - 1) & ~(size_t)(ALIGN - 1);
+        if (sz > _left)
+            _grow(sz);
+        void* ret = _next;
+        _next += sz;
+        _left -= sz;
+        _allocated += sz;
+        return (ret);
+    }
+
+    /* forgets every allocation, keeping one chunk for reuse */
+    void reset();
+
+    size_t allocated() const { return (_allocated); }
+    size_t reserved() const;
+
+private:
+
+    void _grow(size_t sz);
+
+    arena_t(arena_t const &);
+    arena_t &operator =(arena_t const &);
+
+}; // EOF: arena_t
+
+
+#endif /** __UTIL_ARENA_H */
@@ -0,0 +1,347 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   arena_hash.h
+ *
+ *  @brief:  Open-addressing hash map and hash set whose entries live
+ *           in an arena, for the joins and group-bys of query code
+ */
+
+#ifndef __UTIL_ARENA_HASH_H
+#define __UTIL_ARENA_HASH_H
+
+#include "util/arena.h"
+
+#include <stdint.h>
+#include <cassert>
+#include <new>
+#include <utility>
+#include <vector>
+#include <functional>
+
+
+/**
+ *  @brief Hash functors for the usual join keys. The table remixes the
+ *  value itself, so integer keys may hash to themselves.
+ */
+template <class Key> struct arena_hash_fn;
+
+template <> struct arena_hash_fn<int> {
+    uint32_t operator()(int k) const { return ((uint32_t)k); }
+};
+
+template <> struct arena_hash_fn<unsigned int> {
+    uint32_t operator()(unsigned int k) const { return (k); }
+};
+
+template <> struct arena_hash_fn<long> {
+    uint32_t operator()(long k) const {
+        return ((uint32_t)k ^ (uint32_t)((uint64_t)k >> 32));
+    }
+};
+
+template <class A, class B> struct arena_hash_fn< std::pair<A,B> > {
+    uint32_t operator()(const std::pair<A,B>& k) const {
+        return ((arena_hash_fn<A>()(k.first) * 0x01000193u) ^
+                arena_hash_fn<B>()(k.second));
+    }
+};
+
+
+
+/**
+ *  @brief Linear-probing hash map. The slot array holds only indexes;
+ *  the (key,value) entries are built in an arena and never move, so
+ *  references to values stay valid while the map grows and iteration
+ *  walks them in insertion order. Erased entries are only marked.
+ *
+ *  The interface is the subset of std::map the query code uses, so a
+ *  join or group-by that does not need ordered keys can switch by
+ *  changing the declaration. Pass the expected number of keys (e.g.
+ *  the table cardinality) to the constructor to avoid rehashing.
+ */
+template <class Key, class Value,
+          class Hash = arena_hash_fn<Key>, class Equal = std::equal_to<Key> >
+class arena_hash_map_t
+{
+public:
+
+    typedef Key                    key_type;
+    typedef Value                  mapped_type;
+    typedef std::pair<Key, Value>  value_type;
+
+private:
+
+    struct entry_t {
+        value_type _kv;
+        uint32_t   _hash;
+        bool       _erased;
+
+        entry_t(const value_type& kv, uint32_t hash)
+            : _kv(kv), _hash(hash), _erased(false) { }
+    };
+
+    enum { MIN_SLOTS = 16 };
+
+    /* 0 is an empty slot, otherwise an index into _entries plus one */
+    std::vector<uint32_t> _slots;
+    std::vector<entry_t*> _entries;
+    uint32_t _shift;
+    size_t   _size;
+    arena_t  _arena;
+    Hash     _hash;
+    Equal    _equal;
+
+public:
+
+    class iterator
+    {
+        friend class arena_hash_map_t;
+
+        std::vector<entry_t*>* _entries;
+        size_t _pos;
+
+        iterator(std::vector<entry_t*>* entries, size_t pos)
+            : _entries(entries), _pos(pos) { _skip(); }
+
+        void _skip() {
+            while ((_pos < _entries->size()) && (*_entries)[_pos]->_erased)
+                _pos++;
+        }
+
+    public:
+
+        iterator() : _entries(NULL), _pos(0) { }
+
+        value_type& operator*() const { return ((*_entries)[_pos]->_kv); }
+        value_type* operator->() const { return (&(*_entries)[_pos]->_kv); }
+
+        iterator& operator++() { _pos++; _skip(); return (*this); }
+        iterator operator++(int) { iterator it(*this); ++(*this); return (it); }
+
+        bool operator==(const iterator& rhs) const { return (_pos == rhs._pos); }
+        bool operator!=(const iterator& rhs) const { return (_pos != rhs._pos); }
+    };
+
+    arena_hash_map_t(size_t expected = 0)
+        : _shift(0), _size(0)
+    {
+        _resize(_slots_for(expected));
+        _entries.reserve(expected);
+    }
+
+    ~arena_hash_map_t() { _destroy(); }
+
+    size_t size() const { return (_size); }
+    bool empty() const { return (_size == 0); }
+
+    iterator begin() { return (iterator(&_entries, 0)); }
+    iterator end() { return (iterator(&_entries, _entries.size())); }
+
+    iterator find(const Key& key) {
+        uint32_t hash = _hash(key);
+        uint32_t idx = _slots[_probe(key, hash)];
+        if ((idx == 0) || _entries[idx-1]->_erased)
+            return (end());
+        return (iterator(&_entries, idx-1));
+    }
+
+    size_t count(const Key& key) { return (find(key) != end()); }
+
+    /* like std::map, does not overwrite the value of an existing key */
+    std::pair<iterator, bool> insert(const value_type& kv) {
+        _reserve(_entries.size() + 1);
+        uint32_t hash = _hash(kv.first);
+        size_t slot = _probe(kv.first, hash);
+        uint32_t idx = _slots[slot];
+        if (idx == 0) {
+            void* mem = _arena.allocate(sizeof(entry_t));
+            _entries.push_back(new (mem) entry_t(kv, hash));
+            _slots[slot] = idx = _entries.size();
+        }
+        else if (_entries[idx-1]->_erased) {
+            _entries[idx-1]->_kv.second = kv.second;
+            _entries[idx-1]->_erased = false;
+        }
+        else {
+            return (std::make_pair(iterator(&_entries, idx-1), false));
+        }
+        _size++;
+        return (std::make_pair(iterator(&_entries, idx-1), true));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    Value& operator[](const Key& key) {
+        return (insert(value_type(key, Value())).first->second);
+    }
+
+    void erase(iterator it) {
+        assert (!_entries[it._pos]->_erased);
+        _entries[it._pos]->_erased = true;
+        _size--;
+    }
+
+    size_t erase(const Key& key) {
+        iterator it = find(key);
+        if (it == end())
+            return (0);
+        erase(it);
+        return (1);
+    }
+
+    /* makes room for (n) keys without rehashing */
+    void reserve(size_t n) {
+        _reserve(n);
+        _entries.reserve(n);
+    }
+
+    void clear() {
+        _destroy();
+        _entries.clear();
+        _arena.reset();
+        _resize(MIN_SLOTS);
+        _size = 0;
+    }
+
+private:
+
+    /* at most 3/4 full */
+    static size_t _slots_for(size_t n) {
+        size_t slots = MIN_SLOTS;
+        while (slots * 3 < n * 4)
+            slots *= 2;
+        return (slots);
+    }
+
+    /* multiplicative remix; the top bits pick the home slot */
+    size_t _home(uint32_t hash) const {
+        return ((uint32_t)(hash * 0x9e3779b9u) >> _shift);
+    }
+
+    /* the slot of (key), or the empty slot where it belongs */
+    size_t _probe(const Key& key, uint32_t hash) const {
+        size_t mask = _slots.size() - 1;
+        for (size_t slot = _home(hash); ; slot = (slot + 1) & mask) {
+            uint32_t idx = _slots[slot];
+            if (idx == 0)
+                return (slot);
+            entry_t const* e = _entries[idx-1];
+            if ((e->_hash == hash) && _equal(e->_kv.first, key))
+                return (slot);
+        }
+    }
+
+    void _reserve(size_t n) {
+        if (_slots.size() * 3 < n * 4)
+            _resize(_slots_for(n));
+    }
+
+    /* erased entries keep their slots, so a key that comes back
+       reuses its old entry */
+    void _resize(size_t slots) {
+        _shift = 32;
+        for (size_t s = slots; s > 1; s >>= 1)
+            _shift--;
+        _slots.assign(slots, 0);
+        size_t mask = slots - 1;
+        for (size_t i = 0; i < _entries.size(); i++) {
+            size_t slot = _home(_entries[i]->_hash);
+            while (_slots[slot] != 0)
+                slot = (slot + 1) & mask;
+            _slots[slot] = i + 1;
+        }
+    }
+
+    void _destroy() {
+        for (size_t i = 0; i < _entries.size(); i++)
+            _entries[i]->~entry_t();
+    }
+
+    arena_hash_map_t(arena_hash_map_t const &);
+    arena_hash_map_t &operator =(arena_hash_map_t const &);
+
+}; // EOF: arena_hash_map_t
+
+
+
+/**
+ *  @brief The key-only counterpart of arena_hash_map_t, for semi-joins
+ *  and for filters that only ask whether a key qualified.
+ */
+template <class Key,
+          class Hash = arena_hash_fn<Key>, class Equal = std::equal_to<Key> >
+class arena_hash_set_t
+{
+    typedef arena_hash_map_t<Key, char, Hash, Equal> map_t;
+    map_t _map;
+
+public:
+
+    class iterator
+    {
+        friend class arena_hash_set_t;
+        typename map_t::iterator _it;
+        iterator(typename map_t::iterator it) : _it(it) { }
+
+    public:
+
+        iterator() { }
+
+        const Key& operator*() const { return (_it->first); }
+        const Key* operator->() const { return (&_it->first); }
+
+        iterator& operator++() { ++_it; return (*this); }
+        iterator operator++(int) { iterator it(*this); ++_it; return (it); }
+
+        bool operator==(const iterator& rhs) const { return (_it == rhs._it); }
+        bool operator!=(const iterator& rhs) const { return (_it != rhs._it); }
+    };
+
+    arena_hash_set_t(size_t expected = 0) : _map(expected) { }
+
+    size_t size() const { return (_map.size()); }
+    bool empty() const { return (_map.empty()); }
+
+    iterator begin() { return (iterator(_map.begin())); }
+    iterator end() { return (iterator(_map.end())); }
+
+    /* true if (key) was not in the set */
+    bool insert(const Key& key) {
+        return (_map.insert(std::make_pair(key, (char)0)).second);
+    }
+
+    bool contains(const Key& key) { return (_map.find(key) != _map.end()); }
+    size_t erase(const Key& key) { return (_map.erase(key)); }
+
+    void reserve(size_t n) { _map.reserve(n); }
+    void clear() { _map.clear(); }
+
+}; // EOF: arena_hash_set_t
+
+
+#endif /** __UTIL_ARENA_HASH_H */
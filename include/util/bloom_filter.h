@@ -0,0 +1,131 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   bloom_filter.h
+ *
+ *  @brief:  Cache-blocked Bloom filter over 32-bit hash values
+ */
+
+#ifndef __UTIL_BLOOM_FILTER_H
+#define __UTIL_BLOOM_FILTER_H
+
+#include <stdint.h>
+#include <cstddef>
+
+
+/**
+ *  @brief Blocked Bloom filter. Every key maps to one 64-byte block
+ *  (a single cache line) and sets PROBES bits inside it, so both
+ *  insert() and may_contain() touch exactly one cache line.
+ *
+ *  The filter works on hash values the caller has already computed
+ *  (for example with fnv_hash()), so the same value that picks a hash
+ *  join partition can be reused. The block comes from the high bits
+ *  of the hash and the bit positions from a remix of it.
+ *
+ *  The number of blocks is a power of two, so that a filter that
+ *  turns out too small can grow() while it is being built: doubling
+ *  the blocks splits each one in two on the next bit of the hash,
+ *  and both halves start as copies of it. The keys inserted before
+ *  keep the density they had, so a filter sized close to the real
+ *  number of keys stays the most accurate.
+ */
+class bloom_filter_t
+{
+public:
+
+    enum { BLOCK_WORDS = 8,                 /* 8 x 64 bits = 64 bytes */
+           BLOCK_BITS  = BLOCK_WORDS * 64,
+           PROBES      = 6 };
+
+private:
+
+    uint64_t* _blocks;
+    void*     _raw;        /* unaligned allocation behind _blocks */
+    size_t    _num_blocks; /* 1 << _log_blocks */
+    int       _log_blocks;
+    size_t    _capacity;   /* keys it was sized for */
+    size_t    _inserted;
+
+public:
+
+    /**
+     *  @brief Sizes the filter for (expected_keys) keys at
+     *  (bits_per_key) bits each. 10 bits per key give a false positive
+     *  rate of about 3%; blocking trades a little accuracy for speed.
+     */
+    bloom_filter_t(size_t expected_keys, size_t bits_per_key=10);
+    bloom_filter_t(bloom_filter_t const &other);
+    ~bloom_filter_t();
+
+    void insert(uint32_t hash) {
+        uint64_t* block = _block(hash);
+        uint64_t mix = _remix(hash);
+        for (int i = 0; i < PROBES; i++, mix >>= 9)
+            block[(mix >> 6) & (BLOCK_WORDS-1)] |= (uint64_t)1 << (mix & 63);
+        _inserted++;
+    }
+
+    /* false means the key was definitely never inserted */
+    bool may_contain(uint32_t hash) const {
+        uint64_t const* block = _block(hash);
+        uint64_t mix = _remix(hash);
+        for (int i = 0; i < PROBES; i++, mix >>= 9)
+            if (!(block[(mix >> 6) & (BLOCK_WORDS-1)] & ((uint64_t)1 << (mix & 63))))
+                return (false);
+        return (true);
+    }
+
+    size_t inserted() const { return (_inserted); }
+
+    /* true once it holds the keys it was sized for */
+    bool full() const { return (_inserted >= _capacity); }
+
+    /* doubles the blocks and the capacity, keeping every key */
+    void grow();
+
+    size_t size_bytes() const { return (_num_blocks * BLOCK_WORDS * sizeof(uint64_t)); }
+
+    /* content hash; equal filters have equal signatures */
+    uint32_t signature() const;
+
+private:
+
+    uint64_t* _block(uint32_t hash) const {
+        /* the top _log_blocks bits of the hash */
+        size_t b = (size_t)((uint64_t)hash >> (32 - _log_blocks));
+        return (_blocks + b * BLOCK_WORDS);
+    }
+
+    static uint64_t _remix(uint32_t hash) {
+        return ((uint64_t)hash * 0x9e3779b97f4a7c15ULL) >> 8;
+    }
+
+    void _allocate(size_t num_blocks);
+
+    bloom_filter_t &operator =(bloom_filter_t const &);
+
+}; // EOF: bloom_filter_t
+
+
+#endif /** __UTIL_BLOOM_FILTER_H */
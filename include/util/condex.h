@@ -69,6 +69,14 @@ struct condex
 	    pthread_cond_wait(&_cond,&_lock);
     }
 
+    // consumes a signal if one was fired, without waiting
+    bool try_wait() {
+	CRITICAL_SECTION(cs, _lock);
+	if (_waits >= _signals) return (false);
+	_waits++;
+	return (true);
+    }
+
 }; // EOF: condex
 
 
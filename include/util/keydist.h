@@ -0,0 +1,189 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file keydist.h
+ *
+ *  @brief Key distributions (uniform, zipfian, scrambled zipfian,
+ *         hotspot, latest, exponential) for the workload inputs
+ */
+
+#ifndef __UTIL_KEYDIST_H
+#define __UTIL_KEYDIST_H
+
+#include <string>
+#include <vector>
+
+using std::string;
+
+
+/* ---------------------------------------------------------------
+ *
+ * @enum:  keydist_type_t
+ *
+ * @brief: KD_UNIFORM    - every key is equally likely
+ *         KD_ZIPFIAN    - key i (from 0) is drawn with probability
+ *                         proportional to 1/(i+1)^theta (theta 0 is
+ *                         uniform)
+ *         KD_SCRAMBLED  - zipfian, with the popular keys scattered
+ *                         over the range instead of being the first
+ *         KD_HOTSPOT    - hot_ops% of the draws go to the first
+ *                         hot_keys% of the keys, uniformly
+ *         KD_LATEST     - zipfian from the last key backwards
+ *         KD_EXPONENTIAL- exp_ops% of the draws go to the first
+ *                         exp_keys% of the keys, with exponentially
+ *                         decreasing probability
+ *
+ * --------------------------------------------------------------- */
+
+enum keydist_type_t {
+    KD_UNIFORM     = 0,
+    KD_ZIPFIAN     = 1,
+    KD_SCRAMBLED   = 2,
+    KD_HOTSPOT     = 3,
+    KD_LATEST      = 4,
+    KD_EXPONENTIAL = 5
+};
+
+
+/* ---------------------------------------------------------------
+ *
+ * @struct: keydist_spec_t
+ *
+ * @brief:  The distribution and its parameters, as given in the
+ *          configuration or to the "skew" shell command:
+ *
+ *          uniform
+ *          zipfian     [<theta>=0.99]
+ *          scrambled   [<theta>=0.99]
+ *          hotspot     [<hot_keys%>=20] [<hot_ops%>=80]
+ *          latest      [<theta>=0.99]
+ *          exponential [<exp_ops%>=95] [<exp_keys%>=10]
+ *
+ * --------------------------------------------------------------- */
+
+struct keydist_spec_t
+{
+    keydist_type_t _type;
+    double _theta;      // zipfian, scrambled, latest. In [0,1)
+    double _hot_keys;   // hotspot. Percentage of keys
+    double _hot_ops;    // hotspot. Percentage of draws
+    double _exp_ops;    // exponential. Percentage of draws...
+    double _exp_keys;   // ...that fall in this percentage of keys
+
+    // all. Percentage of the keys by which the drawn keys are rotated,
+    // which moves the popular keys without changing the distribution.
+    // Set by the skew scenarios, not by parse().
+    double _shift;
+
+    keydist_spec_t()
+        : _type(KD_UNIFORM), _theta(0.99), _hot_keys(20), _hot_ops(80),
+          _exp_ops(95), _exp_keys(10), _shift(0)
+    { }
+
+    // parses a spec as above; returns false (and leaves this as it
+    // was) if the name is unknown or a parameter is out of range
+    bool parse(const char* spec);
+
+    string to_string() const;
+};
+
+
+
+/*********************************************************************
+ *
+ * @class keydist_t
+ *
+ * @brief Draws keys in [0,n) according to a keydist_spec_t.
+ *
+ *        The zipfian draws use the method of Gray et al. ("Quickly
+ *        generating billion-record synthetic databases", SIGMOD'94):
+ *        zeta(n,theta) is computed once in set(), in O(n), and every
+ *        draw is O(1) with no cutoff or approximation of the tail.
+ *        The scrambled zipfian hashes the zipfian rank (FNV-1a) so
+ *        the hot keys are not clustered at the start of the range.
+ *
+ *        The uniform numbers come from a per-thread generator, and
+ *        the constants of a distribution are never changed once
+ *        published: set() builds new ones and swaps a pointer. So any
+ *        number of threads may draw while another thread calls set(),
+ *        e.g. a skew scenario changing the distribution mid-run. The
+ *        replaced constants are kept until the keydist_t goes away,
+ *        since a draw may still be using them.
+ *
+ *********************************************************************/
+
+class keydist_t
+{
+    struct state_t {
+        keydist_spec_t _spec;
+        long   _n;
+
+        // zipfian constants
+        double _zetan;
+        double _alpha;
+        double _eta;
+        double _half_pow_theta;
+
+        // hotspot/exponential constants
+        long   _hot_n;
+        double _gamma;
+
+        long   _shift;
+    };
+
+    state_t* volatile      _state;
+    std::vector<state_t*>  _retired;
+
+    static const state_t   _uniform;
+
+public:
+
+    keydist_t() : _state(NULL) { }
+    ~keydist_t();
+
+    void set(const keydist_spec_t& spec, const long n);
+
+    // the spec of the last set()
+    keydist_spec_t spec() const;
+    long n() const;
+
+    // a key in [0,n)
+    long next();
+
+    // a key in [0,range). Draws over the n keys set up, folded into
+    // the range if it is not n (e.g. a different queried SF)
+    long next(const long range);
+
+    // seeds the per-thread generators. Thread i (in the order the
+    // threads make their first draw) starts from a seed derived
+    // from (seed,i), so runs with the same seed and threads draw
+    // the same keys. 0 (the default) seeds from the thread's own
+    // random generator.
+    static void seed(const unsigned long long seed);
+
+    // uniform in [0,1), from the per-thread generator
+    static double uniform();
+};
+
+
+#endif // __UTIL_KEYDIST_H
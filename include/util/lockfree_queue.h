@@ -0,0 +1,174 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   lockfree_queue.h
+ *
+ *  @brief:  Bounded lock-free multi-producer/multi-consumer queue
+ */
+
+#ifndef __UTIL_LOCKFREE_QUEUE_H
+#define __UTIL_LOCKFREE_QUEUE_H
+
+#include "util/atomic_ops.h"
+
+
+/**
+ *  @brief Bounded FIFO of values that any number of threads may
+ *  push() to and pop() from without taking a lock. push() fails when
+ *  the queue is full and pop() fails when it is empty; neither blocks.
+ *
+ *  Each slot carries a sequence number that tells whose turn it is:
+ *  a producer may fill slot (pos & mask) when its sequence is pos, a
+ *  consumer may empty it when its sequence is pos+1. The producers
+ *  (consumers) race for a position with one CAS on the tail (head),
+ *  so with a single producer or consumer that CAS never fails.
+ *
+ *  T is copied in and out, so it should be a small POD.
+ */
+template <class T>
+class lockfree_queue_t
+{
+    enum { PADDING = 64 };
+
+    struct cell_t {
+        volatile size_t _seq;
+        T               _value;
+    };
+
+    cell_t*         _cells;
+    size_t          _mask;
+
+    char            _pad0[PADDING];
+    volatile size_t _head; /* next position to pop */
+    char            _pad1[PADDING - sizeof(size_t)];
+    volatile size_t _tail; /* next position to push */
+    char            _pad2[PADDING - sizeof(size_t)];
+
+public:
+
+    /**
+     *  @brief Creates a queue that can hold at least (capacity)
+     *  values. The actual capacity is rounded up to a power of two.
+     */
+    lockfree_queue_t(size_t capacity)
+        : _cells(NULL), _mask(0), _head(0), _tail(0)
+    {
+        size_t cap = 2;
+        while (cap < capacity)
+            cap <<= 1;
+        _cells = new cell_t[cap];
+        for (size_t i=0; i < cap; i++)
+            _cells[i]._seq = i;
+        _mask = cap - 1;
+    }
+
+    ~lockfree_queue_t() {
+        delete [] _cells;
+    }
+
+    size_t capacity() const {
+        return _mask + 1;
+    }
+
+    /* A snapshot; may be stale by the time the caller looks at it */
+    size_t size() const {
+        size_t head = *&_head;
+        size_t tail = *&_tail;
+        return (tail > head)? tail - head : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     *  @brief Appends a copy of (value).
+     *
+     *  @return false if the queue is full
+     */
+    bool push(T const &value) {
+        size_t pos = _tail;
+        while (1) {
+            cell_t* cell = &_cells[pos & _mask];
+            size_t seq = cell->_seq;
+            if (seq == pos) {
+                size_t old = atomic_cas(&_tail, pos, pos+1);
+                if (old == pos) {
+                    cell->_value = value;
+                    /* the value must be visible before the sequence */
+                    membar_producer();
+                    cell->_seq = pos + 1;
+                    return true;
+                }
+                pos = old;
+            }
+            else if (seq < pos) {
+                /* the slot still holds the value of the previous lap */
+                return false;
+            }
+            else {
+                pos = _tail;
+            }
+        }
+    }
+
+    /**
+     *  @brief Removes the oldest value into (value).
+     *
+     *  @return false if the queue is empty
+     */
+    bool pop(T &value) {
+        size_t pos = _head;
+        while (1) {
+            cell_t* cell = &_cells[pos & _mask];
+            size_t seq = cell->_seq;
+            if (seq == pos + 1) {
+                size_t old = atomic_cas(&_head, pos, pos+1);
+                if (old == pos) {
+                    /* do not read the value before we have seen the sequence */
+                    membar_consumer();
+                    value = cell->_value;
+                    /* the value must be read before a producer may reuse the slot */
+                    membar_exit();
+                    cell->_seq = pos + _mask + 1;
+                    return true;
+                }
+                pos = old;
+            }
+            else if (seq < pos + 1) {
+                return false;
+            }
+            else {
+                pos = _head;
+            }
+        }
+    }
+
+private:
+
+    lockfree_queue_t(lockfree_queue_t const &);
+    lockfree_queue_t &operator =(lockfree_queue_t const &);
+};
+
+
+#endif
@@ -25,6 +25,7 @@
 #define __RESOURCE_DECLARE_H
 
 #include "util/c_str.h"
+#include <cstddef>
 
 
 /* exported datatypes */
@@ -33,13 +34,16 @@
 /**
  *  @brief Provide a way for packets to declare how many resources
  *  they need. Used to avoid deadlocks by imposing total ordering when
- *  we acquire the resources.
+ *  we acquire the resources. Packets also declare the memory they
+ *  expect to hold so that queries can be admitted against a global
+ *  memory budget; declarers that do not care simply ignore it.
  */
 
 class resource_declare_t
 {
 public:
     virtual void declare(const c_str& name, int count)=0;
+    virtual void declare_memory(size_t /* bytes */) { }
     virtual ~resource_declare_t() { }
 };
 
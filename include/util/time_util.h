@@ -64,5 +64,29 @@ time_t time_day_end(time_t t);
 
 
 
+/** Calendar dates (SQL_DATE)
+ *
+ *  @note A date_t counts days since 1970-01-01. It does not depend on
+ *        the timezone, fits in 4 bytes and orders like the date, so
+ *        dates compare, index and sort as plain integers.
+ */
+
+typedef int date_t;
+
+date_t make_date(int year, int month, int day);
+void   date_parts(date_t date, int* year, int* month, int* day);
+int    date_year(date_t date);
+
+// YYYY-MM-DD <-> date_t
+date_t str_to_date(char const* str);
+void   date_to_str(char* dst, date_t date);
+
+// The local calendar day of a time_t and the local midnight of a date_t,
+// consistent with str_to_timet()
+date_t timet_to_date(time_t time);
+time_t date_to_timet(date_t date);
+
+
+
 #endif // __TIME_UTIL_H
 
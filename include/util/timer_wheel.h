@@ -0,0 +1,120 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   timer_wheel.h
+ *
+ *  @brief:  Hashed timing wheel, for threads that keep many timers
+ */
+
+#ifndef __UTIL_TIMER_WHEEL_H
+#define __UTIL_TIMER_WHEEL_H
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+
+/**
+ *  @brief Keeps any number of timers, each an (item) due at some time
+ *  in usecs, in (buckets) lists of (tick_us) each. Scheduling is O(1)
+ *  and expire() looks only at the buckets of the ticks that went by,
+ *  so one thread can drive tens of thousands of timers. Timers further
+ *  than a turn of the wheel stay in their bucket for as many turns.
+ *
+ *  A timer fires no earlier than due, and up to a tick late. The
+ *  wheel is not thread-safe, it belongs to the thread that drives it.
+ */
+template <class T>
+class timer_wheel_t
+{
+    struct entry_t {
+        long long due;
+        T         item;
+    };
+
+    std::vector< std::vector<entry_t> > _buckets;
+    std::vector<entry_t>                _turn;
+    long long _tick_us;
+    long long _tick;     // the last tick expired, -1 before the first
+    long long _first;    // the earliest tick scheduled before that, or -1
+    size_t    _size;
+
+public:
+
+    timer_wheel_t(size_t buckets, long long tick_us)
+        : _buckets(buckets), _tick_us(tick_us), _tick(-1), _first(-1), _size(0)
+    {
+        assert (buckets && (tick_us > 0));
+    }
+
+    size_t size() const { return _size; }
+
+    /* (item) is due at (due_us) */
+    void schedule(T const &item, long long due_us) {
+        // the first tick that ends past (due_us), so that the bucket
+        // is looked at when the timer is due
+        long long t = (due_us + _tick_us - 1)/_tick_us;
+        if (t <= _tick) t = _tick + 1;
+        if (_tick < 0 && (_first < 0 || t < _first)) _first = t;
+        entry_t e = { due_us, item };
+        _buckets[t % _buckets.size()].push_back(e);
+        ++_size;
+    }
+
+    /**
+     *  @brief Appends to (fired) the items due by (now_us), in the
+     *  order of their ticks.
+     */
+    void expire(long long now_us, std::vector<T> &fired) {
+        long long now = now_us/_tick_us;
+        // the first call starts from the earliest timer, so the ones
+        // scheduled for ticks that already went by fire now
+        if (_tick < 0)
+            _tick = ((_first >= 0 && _first < now) ? _first : now) - 1;
+
+        // a whole turn went by, every bucket is looked at once
+        long long from = _tick + 1;
+        if (now - from >= (long long)_buckets.size())
+            from = now - _buckets.size() + 1;
+
+        for (long long t = from; t <= now; t++) {
+            std::vector<entry_t> &b = _buckets[t % _buckets.size()];
+            if (b.empty()) continue;
+            _turn.clear();
+            for (size_t i=0; i < b.size(); i++) {
+                if (b[i].due <= now_us) {
+                    fired.push_back(b[i].item);
+                    --_size;
+                }
+                else {
+                    _turn.push_back(b[i]);
+                }
+            }
+            b.swap(_turn);
+        }
+        _tick = now;
+    }
+};
+
+
+#endif
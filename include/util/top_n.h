@@ -0,0 +1,101 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   top_n.h
+ *
+ *  @brief:  Bounded heap that keeps the first N values of an ORDER BY
+ */
+
+#ifndef __UTIL_TOP_N_H
+#define __UTIL_TOP_N_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+
+/**
+ *  @brief Keeps the (limit) values that come first in the order of
+ *  (Less), out of any number of insert()s, in O(log limit) per value
+ *  and O(limit) memory. This is ORDER BY ... LIMIT without sorting
+ *  the whole input.
+ *
+ *  The kept values form a heap whose top is the last of them, so a
+ *  new value only has to be compared with the top to know whether it
+ *  gets in. Values that compare equal to the top do not replace it.
+ */
+template <class T, class Less = std::less<T> >
+class top_n_t
+{
+    std::vector<T> _heap;
+    size_t         _limit;
+    Less           _less;
+
+public:
+
+    top_n_t(size_t limit, Less const &less = Less())
+        : _limit(limit), _less(less)
+    {
+        _heap.reserve(limit);
+    }
+
+    size_t size() const { return _heap.size(); }
+    size_t limit() const { return _limit; }
+
+    /* whether insert(value) would keep it */
+    bool would_keep(T const &value) const {
+        return (_heap.size() < _limit) ||
+            (_limit && _less(value, _heap.front()));
+    }
+
+    void insert(T const &value) {
+        if (_heap.size() < _limit) {
+            _heap.push_back(value);
+            std::push_heap(_heap.begin(), _heap.end(), _less);
+        }
+        else if (_limit && _less(value, _heap.front())) {
+            std::pop_heap(_heap.begin(), _heap.end(), _less);
+            _heap.back() = value;
+            std::push_heap(_heap.begin(), _heap.end(), _less);
+        }
+    }
+
+    /* folds in the values kept by (other), e.g. by another scan thread */
+    void merge(top_n_t const &other) {
+        for (size_t i=0; i < other._heap.size(); i++)
+            insert(other._heap[i]);
+    }
+
+    /**
+     *  @brief Moves the kept values into (out), first to last in the
+     *  order of Less, and leaves this empty.
+     */
+    void sorted(std::vector<T> &out) {
+        std::sort_heap(_heap.begin(), _heap.end(), _less);
+        out.swap(_heap);
+        _heap.clear();
+    }
+};
+
+
+#endif
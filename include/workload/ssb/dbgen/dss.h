@@ -128,6 +128,7 @@ static char lnoise[4] = {'|', '/', '-', '\\' };
 ENTER_NAMESPACE(dbgenssb);
 
 extern int ssb_dbgen_init();
+extern void ssb_dbgen_scale(double sf);
 void free_asc_date();
 
 #ifdef SSBM
@@ -222,6 +223,7 @@ double	Exponential PROTO((double dMean, long nStream));
 void	dss_random(long *tgt, long min, long max, long seed);
 void	row_start(int t);
 void	row_stop(int t);
+void	row_seek(int t, long n);
 void	dump_seeds(int t);
 
 /* text.c */
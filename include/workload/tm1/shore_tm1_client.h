@@ -43,6 +43,35 @@ ENTER_NAMESPACE(tm1);
 
 
 
+/******************************************************************** 
+ *
+ * @struct: tm1_prepared_input_t
+ *
+ * @brief:  A slot of the input ring of a Baseline TM1 client. The
+ *          mixes are resolved when the input is generated.
+ *
+ ********************************************************************/
+
+struct tm1_prepared_input_t : public prepared_input_t
+{
+    get_sub_data_input_t       _gsd;
+    get_new_dest_input_t       _gnd;
+    get_acc_data_input_t       _gad;
+    upd_sub_data_input_t       _usd;
+    upd_loc_input_t            _ul;
+    ins_call_fwd_input_t       _icf;
+    del_call_fwd_input_t       _dcf;
+    get_sub_nbr_input_t        _gsn;
+    ins_call_fwd_bench_input_t _icfb;
+    del_call_fwd_bench_input_t _dcfb;
+
+    static bool supports(const int xct_type);
+    void prepare(const int xct_type, const double qf, const int sel);
+
+}; // EOF: tm1_prepared_input_t
+
+
+
 /******************************************************************** 
  *
  * @enum:  baseline_tm1_client_t
@@ -57,6 +86,9 @@ private:
     int _selid;
     trx_worker_t* _worker;
     double _qf;
+
+    // the inputs generated ahead, if db-cl-input-ring is set
+    guard<input_ring_t> _inputs;
     
 public:
 
@@ -215,6 +215,10 @@ public:
 
     w_rc_t run_one_xct(Request* prequest);
 
+    // the run_* of each trx id
+    trx_registry_t<ShoreTM1Env> _trxs;
+    virtual bool has_trx(const int xct_type) const { return (_trxs.has(xct_type)); }
+
     DECLARE_TRX(get_sub_data);
     DECLARE_TRX(get_new_dest);
     DECLARE_TRX(get_acc_data);
@@ -247,6 +251,9 @@ public:
     void set_skew(int area, int load, int start_imbalance);
     void start_load_imbalance();
     void reset_skew();
+
+    // set the key distribution of the subscribers
+    void set_keydist(const keydist_spec_t& spec);
     
     //print the current tables into files
     w_rc_t db_print(int lines);
@@ -44,6 +44,8 @@ ENTER_NAMESPACE(tm1);
 // related to dynamic skew 
 extern skewer_t s_skewer;
 extern bool _change_load;
+// key distribution
+extern keydist_t s_keydist;
 
 /** Exported data structures */
 
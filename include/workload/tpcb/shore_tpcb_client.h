@@ -41,6 +41,29 @@ using namespace shore;
 ENTER_NAMESPACE(tpcb);
 
 
+/******************************************************************** 
+ *
+ * @struct: tpcb_prepared_input_t
+ *
+ * @brief:  A slot of the input ring of a Baseline TPC-B client. The
+ *          mbench mixes are left to the env, which picks their trxs.
+ *
+ ********************************************************************/
+
+struct tpcb_prepared_input_t : public prepared_input_t
+{
+    acct_update_input_t        _au;
+    mbench_insert_only_input_t _mbio;
+    mbench_delete_only_input_t _mbdo;
+    mbench_probe_only_input_t  _mbpo;
+
+    static bool supports(const int xct_type);
+    void prepare(const int xct_type, const double qf, const int sel);
+
+}; // EOF: tpcb_prepared_input_t
+
+
+
 /******************************************************************** 
  *
  * @enum:  baseline_tpcb_client_t
@@ -56,6 +79,9 @@ private:
     trx_worker_t* _worker;
     double _qf;    
 
+    // the inputs generated ahead, if db-cl-input-ring is set
+    guard<input_ring_t> _inputs;
+
 public:
 
     baseline_tpcb_client_t() { }     
@@ -219,6 +219,10 @@ public:
 
     w_rc_t run_one_xct(Request* prequest);
 
+    // the run_* of each trx id
+    trx_registry_t<ShoreTPCBEnv> _trxs;
+    virtual bool has_trx(const int xct_type) const { return (_trxs.has(xct_type)); }
+
     // Transactions
     DECLARE_TRX(acct_update);
   
@@ -254,6 +258,12 @@ public:
     void start_load_imbalance();
     void reset_skew();
 
+    // set the key distribution of the branches, tellers and accounts
+    void set_keydist(const keydist_spec_t& spec);
+
+    // the mbench mixes follow the insert/delete/probe frequencies
+    void set_freqs(int insert_freq = 0, int delete_freq = 0, int probe_freq = 0);
+
     //print the current tables into files
     w_rc_t db_print(int lines);
 
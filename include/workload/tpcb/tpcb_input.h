@@ -63,6 +63,10 @@ extern skewer_t b_skewer;
 extern skewer_t t_skewer;
 extern skewer_t a_skewer;
 extern bool _change_load;
+// key distributions
+extern keydist_t b_keydist;
+extern keydist_t t_keydist;
+extern keydist_t a_keydist;
 
 
 /** Exported data structures */
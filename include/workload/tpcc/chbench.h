@@ -0,0 +1,161 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   chbench.h
+ *
+ *  @brief:  The CH-benCHmark, the TPC-C transactions and the analytical
+ *           CH queries run against the same database at the same time.
+ *           The OLTP clients run the TPC-C mix as the "measure" command
+ *           does, the OLAP clients run the CH queries one after the
+ *           other, each query a transaction of its own.
+ *
+ */
+
+#ifndef __TPCC_CHBENCH_H
+#define __TPCC_CHBENCH_H
+
+#include "sm/shore/shore_shell.h"
+#include "util/command/command_handler.h"
+
+#include "workload/tpcc/tpcc_const.h"
+#include "workload/tpcc/shore_tpcc_env.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(tpcc);
+
+using namespace shore;
+
+
+
+/********************************************************************
+ *
+ * @class: ch_olap_client_t
+ *
+ * @brief: Runs the CH queries of CH_TPCC_QUERY in turn, starting from
+ *         the one of its id, while the OLAP side is enabled and until
+ *         the measurement is done. The queries run on the thread of
+ *         the client, under any system, and every query completed
+ *         while measuring is counted and timed.
+ *
+ ********************************************************************/
+
+class ch_olap_client_t : public base_client_t
+{
+private:
+
+    ShoreTPCCEnv* _tpccenv;
+
+    // the queries run only while enabled
+    volatile bool _enabled;
+
+    // run under NL locks (ch-olap-nl)
+    bool _nl;
+
+    pthread_mutex_t _stats_lock;
+    int    _count[CH_QUERIES+1];
+    int    _failed[CH_QUERIES+1];
+    double _secs[CH_QUERIES+1];
+
+public:
+
+    ch_olap_client_t(c_str tname, const int id, ShoreTPCCEnv* env,
+                     processorid_t aprsid = PBIND_NONE);
+    ~ch_olap_client_t();
+
+    // thread entrance
+    void work();
+
+    void enable(const bool enabled) { _enabled = enabled; }
+
+    // adds what was measured to (count,failed,secs), by query number,
+    // and starts over
+    void take_stats(int* count, int* failed, double* secs);
+
+    // INTERFACE
+
+    w_rc_t submit_one(int xct_type, int xctid);
+
+}; // EOF: ch_olap_client_t
+
+
+
+/********************************************************************
+ *
+ * @class: chbench_cmd_t
+ *
+ * @brief: The "chbench" command. Forks the OLTP and the OLAP clients,
+ *         measures the OLTP clients alone for a reference interval
+ *         and then both of them for every iteration. Reports the
+ *         throughput and the response times of the TPC-C trxs, the
+ *         CH queries run, and how much the OLTP side degraded against
+ *         the reference.
+ *
+ ********************************************************************/
+
+class chbench_cmd_t : public command_handler_t
+{
+private:
+
+    ShoreTPCCEnv*  _env;
+    shore_shell_t* _shell;
+
+    // the OLTP figures of the last interval
+    struct oltp_result_t
+    {
+        double tps;
+        double avg_ms;
+        double p95_ms;
+    };
+
+public:
+
+    chbench_cmd_t(ShoreTPCCEnv* env, shore_shell_t* shell)
+        : _env(env), _shell(shell) { }
+    ~chbench_cmd_t() { }
+
+    int handle(const char* cmd);
+
+    void setaliases();
+    void usage();
+    string desc() const;
+
+private:
+
+    oltp_result_t _measure(const int duration, const int oltp_thrs,
+                           std::vector<latency_recorder_t*>& recorders,
+                           std::vector<ch_olap_client_t*>& olap);
+
+    oltp_result_t _print_oltp(const int oltp_thrs, const double secs,
+                              std::vector<latency_recorder_t*>& recorders);
+
+    void _print_olap(const double secs,
+                     std::vector<ch_olap_client_t*>& olap);
+
+}; // EOF: chbench_cmd_t
+
+
+EXIT_NAMESPACE(tpcc);
+
+#endif /* __TPCC_CHBENCH_H */
@@ -42,6 +42,32 @@ using namespace shore;
 ENTER_NAMESPACE(tpcc);
 
 
+/******************************************************************** 
+ *
+ * @struct: tpcc_prepared_input_t
+ *
+ * @brief:  A slot of the input ring of a Baseline TPC-C client. The
+ *          mixes are resolved when the input is generated.
+ *
+ ********************************************************************/
+
+struct tpcc_prepared_input_t : public prepared_input_t
+{
+    new_order_input_t    _no;
+    payment_input_t      _pay;
+    order_status_input_t _os;
+    delivery_input_t     _del;
+    stock_level_input_t  _sl;
+    mbench_wh_input_t    _mbwh;
+    mbench_cust_input_t  _mbcust;
+
+    static bool supports(const int xct_type);
+    void prepare(const int xct_type, const double qf, const int sel);
+
+}; // EOF: tpcc_prepared_input_t
+
+
+
 /******************************************************************** 
  *
  * @enum:  baseline_tpcc_client_t
@@ -57,6 +83,9 @@ private:
     int _wh;
     trx_worker_t* _worker;
     double _qf;
+
+    // the inputs generated ahead, if db-cl-input-ring is set
+    guard<input_ring_t> _inputs;
     
 
 public:
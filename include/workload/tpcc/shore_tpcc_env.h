@@ -224,6 +224,10 @@ public:
 
     w_rc_t run_one_xct(Request* prequest);
 
+    // the run_* of each trx id
+    trx_registry_t<ShoreTPCCEnv> _trxs;
+    virtual bool has_trx(const int xct_type) const { return (_trxs.has(xct_type)); }
+
     DECLARE_TRX(new_order);
     DECLARE_TRX(payment);
     DECLARE_TRX(order_status);
@@ -241,6 +245,21 @@ public:
     w_rc_t _xct_delivery_helper(const int xct_id, delivery_input_t& pdin,
 				std::vector<int>& dlist, int& d_id,
 				const bool SPLIT_TRX);
+
+    // CH-benCHmark analytical queries over the TPC-C tables. They run
+    // in the thread of the caller, which begins and commits the xct.
+    w_rc_t run_ch_query(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q1(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q3(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q4(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q6(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q12(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q13(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q14(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q17(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q18(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q19(const int xct_id, ch_query_input_t& in);
+    w_rc_t xct_ch_q22(const int xct_id, ch_query_input_t& in);
     
     // Update the partitioning info, if any needed
     virtual w_rc_t update_partitioning();
@@ -261,6 +280,9 @@ public:
     void set_skew(int area, int load, int start_imbalance);
     void start_load_imbalance();
     void reset_skew();
+
+    // set the key distribution of the home warehouses
+    void set_keydist(const keydist_spec_t& spec);
     
     //print the current tables into files
     w_rc_t db_print(int lines);
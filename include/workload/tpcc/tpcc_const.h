@@ -103,6 +103,44 @@ const int PROB_DELIVERY     = 4;
 const int PROB_STOCK_LEVEL  = 4;
 
 
+
+/* ------------------------------------ */
+/* --- REMOTE TERMINAL EMULATOR (RTE) --- */
+/* ------------------------------------ */
+
+const int RTE_TERMINALS_PER_WH = DISTRICTS_PER_WAREHOUSE;
+
+// The deck each terminal draws its trxs from, reshuffled once drawn.
+// By trx type (XCT_NEW_ORDER .. XCT_STOCK_LEVEL), 10/10/1/1/1 out of 23
+// meets the minimum mix of Clause 5.2.3.
+const int RTE_TRX_TYPES = 6;
+const int RTE_DECK_SZ   = 23;
+const int RTE_DECK_CARDS[RTE_TRX_TYPES] = { 0, 10, 10, 1, 1, 1 };
+
+// Clause 5.2.5: minimum keying times and mean think times, secs
+const double RTE_KEYING_SECS[RTE_TRX_TYPES] = { 0, 18, 3, 2, 2, 2 };
+const double RTE_THINK_SECS[RTE_TRX_TYPES]  = { 0, 12, 12, 10, 5, 5 };
+
+// Clause 5.2.5.4: 90th percentile response time limits, secs
+const double RTE_RT90_SECS[RTE_TRX_TYPES]   = { 0, 5, 5, 5, 5, 20 };
+
+// Clause 5.2.3: minimum share of the mix, percent
+const double RTE_MIN_MIX_PCT[RTE_TRX_TYPES] = { 0, 0, 43, 4, 4, 4 };
+
+
+
+/* ---------------------------------------- */
+/* --- CH-benCHmark ANALYTICAL QUERIES  --- */
+/* ---------------------------------------- */
+
+const int CH_QUERIES = 22;
+
+// The CH queries that read only the TPC-C tables. The rest also join
+// SUPPLIER, NATION and REGION, which the TPC-C schema does not have.
+const int CH_TPCC_QUERIES = 11;
+const int CH_TPCC_QUERY[CH_TPCC_QUERIES] = { 1, 3, 4, 6, 12, 13, 14, 17, 18, 19, 22 };
+
+
 // --- Helper functions --- //
 
 
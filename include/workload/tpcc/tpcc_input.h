@@ -42,6 +42,8 @@ ENTER_NAMESPACE(tpcc);
 // related to dynamic skew 
 extern skewer_t w_skewer;
 extern bool _change_load;
+// key distribution
+extern keydist_t w_keydist;
 
 /** Exported data structures */
 
@@ -398,6 +400,27 @@ struct populate_one_unit_input_t
 
 
 
+/*********************************************************************
+ * 
+ * ch_query_input_t
+ *
+ * Input for the CH-benCHmark analytical queries
+ *
+ *********************************************************************/
+
+struct ch_query_input_t
+{
+    int  _query;   /* the CH query, one of CH_TPCC_QUERY */
+    bool _nl;      /* scan and probe without locks */
+
+    ch_query_input_t() 
+        : _query(0), _nl(false)
+    { };
+
+}; // EOF ch_query_input_t
+
+
+
 
 
 
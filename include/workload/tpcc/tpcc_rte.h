@@ -0,0 +1,190 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   tpcc_rte.h
+ *
+ *  @brief:  A remote terminal emulator (RTE) for TPC-C. Every warehouse
+ *           has its 10 terminals, each of which draws its trxs from a
+ *           deck, keys the input, waits for the response and thinks,
+ *           as in Clause 5.2. A few driver threads emulate all the
+ *           terminals, each keeping the timers of its own on a wheel.
+ *
+ */
+
+#ifndef __TPCC_RTE_H
+#define __TPCC_RTE_H
+
+#include "sm/shore/shore_shell.h"
+#include "util/command/command_handler.h"
+
+#include "workload/tpcc/tpcc_const.h"
+#include "workload/tpcc/shore_tpcc_env.h"
+#include "workload/tpcc/shore_tpcc_client.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(tpcc);
+
+using namespace shore;
+
+
+
+/********************************************************************
+ *
+ * @struct: rte_terminal_t
+ *
+ * @brief:  One emulated terminal, bound to a warehouse, and to a
+ *          district for the STOCK_LEVEL trxs. It has at most one trx
+ *          outstanding, whose input it owns, and the worker signals
+ *          (_done) when the trx completes.
+ *
+ ********************************************************************/
+
+struct rte_terminal_t
+{
+    enum state_t { RTE_THINKING, RTE_KEYING, RTE_WAITING };
+
+    int       _wh;
+    int       _d;
+    state_t   _state;
+    int       _type;
+    long long _submitted;
+
+    int       _deck[RTE_DECK_SZ];
+    int       _next;
+
+    condex                _done;
+    tpcc_prepared_input_t _input;
+
+    rte_terminal_t() 
+        : _wh(0), _d(0), _state(RTE_THINKING), _type(-1), _submitted(0),
+          _next(RTE_DECK_SZ)
+    { }
+
+    // the next trx off the deck, reshuffled once drawn
+    int draw();
+
+}; // EOF: rte_terminal_t
+
+
+
+/********************************************************************
+ *
+ * @class: rte_driver_t
+ *
+ * @brief: Emulates the terminals [first,first+count) of the run. The
+ *         keying and think times are timers on a wheel, the trxs go
+ *         to the Baseline workers, and the driver polls the terminals
+ *         that wait for a response. The response time of every trx
+ *         completed while measuring is kept, by trx type.
+ *
+ ********************************************************************/
+
+class rte_driver_t : public base_client_t
+{
+private:
+
+    ShoreTPCCEnv*   _tpccenv;
+    rte_terminal_t* _terms;
+    const int       _first;
+    const int       _count;
+    const double    _qf;
+
+    // the keying and think times are scaled by it, 1 is the spec
+    const double    _scale;
+
+    timer_wheel_t<int> _wheel;
+    std::vector<int>   _waiting;
+    int                _xct_cnt;
+
+    pthread_mutex_t     _stats_lock;
+    std::vector<double> _rt[RTE_TRX_TYPES];
+
+    void _fire(const int idx, const long long now);
+    void _complete(const int idx, const long long now);
+
+public:
+
+    rte_driver_t(c_str tname, const int id, ShoreTPCCEnv* env,
+                 const int first, const int count, const double qf,
+                 const double scale, processorid_t aprsid = PBIND_NONE);
+    ~rte_driver_t();
+
+    // thread entrance
+    void work();
+
+    // appends the response times measured to (rt), by trx type, and
+    // starts over
+    void take_stats(std::vector<double>* rt);
+
+    // INTERFACE
+
+    // submits a trx of (xct_type) for terminal (xctid) of the driver
+    w_rc_t submit_one(int xct_type, int xctid);
+
+}; // EOF: rte_driver_t
+
+
+
+/********************************************************************
+ *
+ * @class: rte_cmd_t
+ *
+ * @brief: The "rte" command. Emulates the terminals of the warehouses
+ *         asked for, ramps up, measures, and reports the tpmC, the
+ *         mix and the 90th percentile response times of every trx
+ *         type against the limits of the spec.
+ *
+ ********************************************************************/
+
+class rte_cmd_t : public command_handler_t
+{
+private:
+
+    ShoreTPCCEnv*  _env;
+    shore_shell_t* _shell;
+
+public:
+
+    rte_cmd_t(ShoreTPCCEnv* env, shore_shell_t* shell)
+        : _env(env), _shell(shell) { }
+    ~rte_cmd_t() { }
+
+    int handle(const char* cmd);
+
+    void setaliases();
+    void usage();
+    string desc() const;
+
+private:
+
+    void _print(const int terminals, const double secs,
+                std::vector<rte_driver_t*>& drivers);
+
+}; // EOF: rte_cmd_t
+
+
+EXIT_NAMESPACE(tpcc);
+
+#endif /* __TPCC_RTE_H */
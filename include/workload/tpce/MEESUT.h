@@ -23,7 +23,8 @@
 
 /** @file:   MEESUT.h
  *
- *  @brief:  ??
+ *  @brief:  The SUT side of the Market Exchange Emulator (MEE) and the
+ *           queues between the two
  *
  *  @author: Djordje Jevdjic
  */
@@ -34,6 +35,7 @@
 
 #include "sm/shore/shore_env.h"
 #include "sm/shore/shore_trx_worker.h"
+#include "workload/tpce/tpce_const.h"
 #include "workload/tpce/egen/MEESUTInterface.h"
 
 using namespace TPCE;
@@ -41,62 +43,121 @@ using namespace TPCE;
 ENTER_NAMESPACE(tpce);
 const int max_buffer = 512000;
 
+
+/**
+ *  @brief Lock-free FIFO of inputs that the market emulator (MEE)
+ *  hands to the SUT, or the SUT hands to the MEE. The inputs are
+ *  copied in and out, so nothing is allocated per input.
+ *
+ *  Every input is stamped when it is put, and get() accounts how long
+ *  it waited in the queue, so the lag of the market-driven trxs
+ *  behind the trxs that caused them can be reported.
+ */
 template <typename T>
 class InputBuffer 
 {
-    mcs_lock a_lock;
-    T* buffer[max_buffer];
-    int size, first, last;
-    //    int flag;
+    struct entry_t {
+        T         input;
+        long long stamp; // usec, when put
+    };
+
+    lockfree_queue_t<entry_t> _queue;
+
+    // stats
+    uint64_t volatile _puts;
+    uint64_t volatile _gets;
+    uint64_t volatile _dropped;
+    uint64_t volatile _lag_sum; // usec
+    uint64_t volatile _lag_max; // usec
+
+    static long long _now() {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        return (tv.tv_usec + tv.tv_sec*1000000ll);
+    }
+
 public:
-    InputBuffer():size(0), first(0), last(0)//, flag(0)
-    {};	
-    bool isEmpty(){
-	{
-	    CRITICAL_SECTION(cs, a_lock);
-	    //	    if(flag==1) return true;    
-	    if(size==0) return true;
-	    else {
-		//flag=1;
-		return false;
-	    }              
-	}
+    InputBuffer(const int capacity = max_buffer)
+        : _queue(capacity), _puts(0), _gets(0), _dropped(0),
+          _lag_sum(0), _lag_max(0)
+    { }
+
+    bool isEmpty() { return (_queue.empty()); }
+    size_t size() { return (_queue.size()); }
+
+    // number of inputs ever put, and ever taken out
+    uint64_t puts() { return (*&_puts); }
+    uint64_t gets() { return (*&_gets); }
+
+    bool get(T& input) {
+        entry_t e;
+        if (!_queue.pop(e)) return (false);
+        input = e.input;
+
+        uint64_t lag = _now() - e.stamp;
+        atomic_inc_64(&_gets);
+        atomic_add_64(&_lag_sum, lag);
+        uint64_t old = _lag_max;
+        while (lag > old) {
+            uint64_t cur = atomic_cas(&_lag_max, old, lag);
+            if (cur == old) break;
+            old = cur;
+        }
+        return (true);
+    }
+
+    bool put(const T& input) {
+        entry_t e;
+        e.input = input;
+        e.stamp = _now();
+        if (!_queue.push(e)) {
+            atomic_inc_64(&_dropped);
+            return (false);
+        }
+        atomic_inc_64(&_puts);
+        return (true);
     }
-    T* get(){
-	{
-	    CRITICAL_SECTION(cs, a_lock);
-	    if (size==0) return NULL;
-	    T* tmp=buffer[first];
-	    size--;
-	    first=(first+1)%max_buffer;
-	    //	    flag=0; 
-	    return tmp;
-	}
+
+    void print_lag(const char* name) {
+        uint64_t gets = _gets;
+        TRACE( TRACE_STATISTICS, 
+               "%s queue. Put (%lld). Got (%lld). Dropped (%lld). Pending (%zd). Avg lag (%.2lf ms). Max lag (%.2lf ms)\n",
+               name, (long long)_puts, (long long)gets, (long long)_dropped,
+               _queue.size(),
+               (gets? (double)_lag_sum/gets/1000.0 : 0.0),
+               (double)_lag_max/1000.0);
     }
 
-    void put(T* tmp){
-	{
-	    CRITICAL_SECTION(cs, a_lock);
-	    //assert(size<max_buffer);
-	    if(size < max_buffer) {
-		buffer[last]=tmp;
-		last=(last+1)%max_buffer;
-		size++;
-	    }
-	}
+    void reset_lag() {
+        // only the lag, the put and got counters drive the submitters
+        _lag_sum = 0;
+        _lag_max = 0;
     }
 };
 
 class MFBuffer: public InputBuffer<TMarketFeedTxnInput>{
+public:
+    // one market feed per max_feed_len completed trades
+    MFBuffer() : InputBuffer<TMarketFeedTxnInput>(max_buffer/max_feed_len) { }
 };
 
 class TRBuffer: public InputBuffer<TTradeResultTxnInput>{
 };
 
+// trade orders on their way to the MEE
+class TReqBuffer: public InputBuffer<TTradeRequest>{
+};
+
 extern MFBuffer* MarketFeedInputBuffer;
 extern TRBuffer* TradeResultInputBuffer;
+extern TReqBuffer* TradeRequestBuffer;
 
 
+/**
+ *  @brief The SUT side of the MEE. It is called by the MEE driver
+ *  thread when a trade completes or a market feed is due, and queues
+ *  the input for the TRADE_RESULT and MARKET_FEED submitters.
+ */
 class CMEESUT: public CMEESUTInterface
 {
     MFBuffer* MFQueue;
@@ -107,17 +168,11 @@ public:
     void setTRQueue(TRBuffer* p){ TRQueue = p;}
 
     bool TradeResult( PTradeResultTxnInput pTxnInput ) {
-	PTradeResultTxnInput trInput= new TTradeResultTxnInput();
-	memcpy(trInput, pTxnInput, sizeof(TTradeResultTxnInput));
-	TRQueue->put(trInput);
-	return true;
+	return (TRQueue->put(*pTxnInput));
     }
 
     bool MarketFeed( PMarketFeedTxnInput pTxnInput ){
-	PMarketFeedTxnInput mfInput= new TMarketFeedTxnInput();
-	memcpy(mfInput, pTxnInput, sizeof(TMarketFeedTxnInput));
-	MFQueue->put(mfInput);
-	return true;
+	return (MFQueue->put(*pTxnInput));
     }
 
 };
@@ -140,6 +140,8 @@ public:
 
     bool    EnableTickerTape( void );
     bool    DisableTickerTape( void );
+
+    void    SetProcessingDelayMean( double fMean );
 };
 
 }   // namespace TPCE
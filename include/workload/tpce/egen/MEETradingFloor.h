@@ -90,6 +90,9 @@ public:
 
     RNGSEED GetRNGSeed( void );
     void    SetRNGSeed( RNGSEED RNGSeed );
+
+    // Mean of the simulated delay (in seconds) before a market order is traded
+    void    SetProcessingDelayMean( double fMean );
 };
 
 }   // namespace TPCE
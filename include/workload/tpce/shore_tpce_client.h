@@ -40,6 +40,37 @@ using namespace shore;
 ENTER_NAMESPACE(tpce);
 
 
+/******************************************************************** 
+ *
+ * @struct: tpce_prepared_input_t
+ *
+ * @brief:  A slot of the input ring of a Baseline TPC-E client. The
+ *          mix is resolved when the input is generated.
+ *
+ ********************************************************************/
+
+struct tpce_prepared_input_t : public prepared_input_t
+{
+    broker_volume_input_t     _bv;
+    customer_position_input_t _cp;
+    market_feed_input_t       _mf;
+    market_watch_input_t      _mw;
+    security_detail_input_t   _sd;
+    trade_lookup_input_t      _tl;
+    trade_order_input_t       _to;
+    trade_result_input_t      _tr;
+    trade_status_input_t      _ts;
+    trade_update_input_t      _tu;
+    data_maintenance_input_t  _dm;
+    trade_cleanup_input_t     _tc;
+
+    static bool supports(const int xct_type);
+    void prepare(const int xct_type, const double qf, const int sel);
+
+}; // EOF: tpce_prepared_input_t
+
+
+
 /******************************************************************** 
  *
  * @enum:  baseline_tpce_client_t
@@ -55,6 +86,9 @@ private:
     int _selid;
     trx_worker_t* _worker;
     double _qf;
+
+    // the inputs generated ahead, if db-cl-input-ring is set
+    guard<input_ring_t> _inputs;
     
 
 public:
@@ -63,6 +63,7 @@ public:
       moreToRead=true;
       cnt = 0;
     }
+    ~EgenTupleContainer() {delete [] buffer;}
     T* get(int i){cnt++; return &buffer[i]; }
     void append(T* row) {memcpy(&buffer[size++],row, sizeof(T)); }
     bool hasSpace(){return (size<capacity-2);}
@@ -216,6 +217,50 @@ class ZipCodeBuffer: public EgenTupleContainer<ZIP_CODE_ROW>{
 };
 
 
+/** 
+ *  @brief: What one loader needs to load the scaling and growing
+ *          tables for a range of customers, made of whole load units:
+ *          its own generator and its own buffers. The fixed tables
+ *          are loaded once, through the global generator and buffers.
+ */
+struct EgenLoadPartition
+{
+    CGenerateAndLoad* generator;
+    TIdent firstCustomer; // 1-based, like EGen
+    TIdent customers;
+
+    AccountPermissionBuffer accountPermissionBuffer;
+    CustomerBuffer customerBuffer;
+    CustomerAccountBuffer customerAccountBuffer;
+    CustomerTaxrateBuffer customerTaxrateBuffer;
+    HoldingBuffer holdingBuffer;
+    HoldingHistoryBuffer holdingHistoryBuffer;
+    HoldingSummaryBuffer holdingSummaryBuffer;
+    WatchItemBuffer watchItemBuffer;
+    WatchListBuffer watchListBuffer;
+
+    BrokerBuffer brokerBuffer;
+    CashTransactionBuffer cashTransactionBuffer;
+    SettlementBuffer settlementBuffer;
+    TradeBuffer tradeBuffer;
+    TradeHistoryBuffer tradeHistoryBuffer;
+
+    CompanyBuffer companyBuffer;
+    CompanyCompetitorBuffer companyCompetitorBuffer;
+    DailyMarketBuffer dailyMarketBuffer;
+    FinancialBuffer financialBuffer;
+    LastTradeBuffer lastTradeBuffer;
+    NewsItemBuffer newsItemBuffer;
+    NewsXRefBuffer newsXRefBuffer;
+    SecurityBuffer securityBuffer;
+
+    AddressBuffer addressBuffer;
+
+    EgenLoadPartition(TIdent first, TIdent count);
+    ~EgenLoadPartition();
+};
+
+
 EXIT_NAMESPACE(tpce);
 
 #endif
@@ -62,46 +62,20 @@ using namespace TPCE;
 
 int egen_init(int argc, char* argv[]);
 void egen_release();
+CGenerateAndLoad* egen_partition_init(TIdent iStart, TIdent iCount);
 extern CGenerateAndLoad*  pGenerateAndLoad;
 
 ENTER_NAMESPACE(tpce);
 
 using std::map;
 
-extern AccountPermissionBuffer accountPermissionBuffer;
-extern CustomerBuffer customerBuffer ;
-extern CustomerAccountBuffer customerAccountBuffer ;
-extern CustomerTaxrateBuffer  customerTaxrateBuffer ;
-extern HoldingBuffer holdingBuffer;
-extern HoldingHistoryBuffer holdingHistoryBuffer;
-extern HoldingSummaryBuffer holdingSummaryBuffer;
-extern WatchItemBuffer watchItemBuffer ;
-extern WatchListBuffer watchListBuffer;
-
-extern BrokerBuffer brokerBuffer;
-extern CashTransactionBuffer cashTransactionBuffer;
+// buffers for the fixed tables (the rest are in EgenLoadPartition)
 extern ChargeBuffer chargeBuffer;
 extern CommissionRateBuffer commissionRateBuffer;
-extern SettlementBuffer settlementBuffer;
-extern TradeBuffer tradeBuffer;
-extern TradeHistoryBuffer tradeHistoryBuffer;
 extern TradeTypeBuffer tradeTypeBuffer;
-
-
-extern CompanyBuffer companyBuffer ;
-extern CompanyCompetitorBuffer companyCompetitorBuffer;
-extern DailyMarketBuffer dailyMarketBuffer;
 extern ExchangeBuffer exchangeBuffer;
-extern FinancialBuffer financialBuffer;
 extern IndustryBuffer industryBuffer;
-extern LastTradeBuffer lastTradeBuffer;
-extern NewsItemBuffer newsItemBuffer;
-extern NewsXRefBuffer newsXRefBuffer;//big
 extern SectorBuffer sectorBuffer;
-extern SecurityBuffer securityBuffer;
-
-
-extern AddressBuffer addressBuffer;
 extern StatusTypeBuffer statusTypeBuffer;
 extern TaxrateBuffer taxrateBuffer ;
 extern ZipCodeBuffer zipCodeBuffer ;
@@ -222,6 +196,8 @@ public:
     class table_builder_t;
     class table_creator_t;
     struct checkpointer_t;
+    struct mee_driver_t;
+    struct mee_submitter_t;
 
 protected:       
     /*
@@ -239,6 +215,26 @@ protected:
 private:
     w_rc_t _post_init_impl();
 
+    // The MEE driver thread feeds the trade orders to the MEE and
+    // releases the trades when their simulated delay expires. The two
+    // submitters run a TRADE_RESULT (MARKET_FEED) for every input the
+    // MEE queues. They run from start() to stop().
+    mee_driver_t*    _mee_driver;
+    mee_submitter_t* _tr_submitter;
+    mee_submitter_t* _mf_submitter;
+    bool volatile    _mee_stop;
+
+    // the TPC-E mix without TRADE_RESULT and MARKET_FEED
+    trx_mix_t        _client_mix;
+
+    void _start_mee();
+    void _stop_mee();
+
+protected:
+    virtual bool _install_mix(const int id, const trx_mix_t& mix);
+
+private:
+
     //helper functions for loading
     w_rc_t _load_one_sector(rep_row_t& areprow, PSECTOR_ROW record);
     w_rc_t _load_one_charge( rep_row_t& areprow, PCHARGE_ROW record);   
@@ -353,6 +349,11 @@ public:
     // PIN: to count the aborts due to invalid input in TRADE_RESULT and MARKET_FEED
     //      will be reported in the output
     uint _num_invalid_input; 
+
+    // Whether the MEE drives TRADE_RESULT and MARKET_FEED, in which
+    // case the clients pick from _client_mix, the mix without them
+    inline bool mee_driven() const { return (_mee_driver != NULL); }
+
     virtual void print_throughput(const double iQueriedSF, 
                                   const int iSpread, 
                                   const int iNumOfThreads,
@@ -410,6 +411,7 @@ public:
     void populate_holding_summary();
     void populate_unit_trade();
     void populate_growing();
+    void populate_partition(EgenLoadPartition* part);
     void find_maxtrade_id();
     // Public methods //    
 
@@ -465,6 +467,13 @@ public:
 
     w_rc_t run_one_xct(Request* prequest);
 
+    // the run_* of each trx id
+    trx_registry_t<ShoreTPCEEnv> _trxs;
+    virtual bool has_trx(const int xct_type) const { return (_trxs.has(xct_type)); }
+
+    // as pick_trx(), leaving out the trxs the MEE submits when it runs
+    int pick_client_trx(const int xct_type) const;
+
     // TPCE Transactions
     DECLARE_TRX(broker_volume);
     DECLARE_TRX(customer_position);
@@ -96,6 +96,7 @@
 ENTER_NAMESPACE(dbgentpch);
 
 extern int dbgen_init();
+extern void dbgen_scale(double sf);
 
 
 #define  NONE		-1
@@ -243,6 +244,7 @@ DSS_HUGE	UnifInt PROTO((DSS_HUGE nLow, DSS_HUGE nHigh, long nStream));
 void	dss_random(DSS_HUGE *tgt, DSS_HUGE min, DSS_HUGE max, long seed);
 void	row_start(int t);
 void	row_stop(int t);
+void	row_seek(int t, DSS_HUGE n);
 void	dump_seeds(int t);
 
 /* text.c */
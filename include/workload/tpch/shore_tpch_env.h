@@ -38,6 +38,7 @@
 #include "sm/shore/shore_env.h"
 #include "sm/shore/shore_asc_sort_buf.h"
 #include "sm/shore/shore_trx_worker.h"
+#include "sm/shore/shore_parallel_scan.h"
 
 #include "workload/tpch/tpch_const.h"
 
@@ -127,6 +128,9 @@ struct ShoreTPCHTrxCount
 
     uint qNP;
 
+    uint rf1;
+    uint rf2;
+
 
     ShoreTPCHTrxCount& operator+=(ShoreTPCHTrxCount const& rhs) {
         q1 += rhs.q1; 
@@ -162,6 +166,9 @@ struct ShoreTPCHTrxCount
 
         qNP += rhs.qNP;
 
+        rf1 += rhs.rf1;
+        rf2 += rhs.rf2;
+
         return (*this);
     }
 
@@ -198,6 +205,9 @@ struct ShoreTPCHTrxCount
         qcustomer -= rhs.qcustomer;
         
         qNP -= rhs.qNP;
+
+        rf1 -= rhs.rf1;
+        rf2 -= rhs.rf2;
         
         return (*this);
     }
@@ -206,7 +216,7 @@ struct ShoreTPCHTrxCount
         return (q1+q2+q3+q4+q5+q6+q7+q8+q9+q10+
                 q11+q12+q13+q14+q15+q16+q17+q18+q19+q20+
                 q21+q22+qlineitem+qnation+qregion+qorders+qpart+qpartsupp+qsupplier+qcustomer+
-                qNP);
+                qNP+rf1+rf2);
     }
 
 }; // EOF: ShoreTPCHTrxCount
@@ -254,6 +264,9 @@ public:
 
 private:
 
+    // Helper threads for the parallel scans of the baseline queries
+    guard<scan_helper_pool_t> _scan_helpers;
+
     w_rc_t _post_init_impl();
 
     // Helper functions for the loading
@@ -262,6 +275,8 @@ private:
     w_rc_t _gen_one_supplier(const int id, rep_row_t& areprow);
     w_rc_t _gen_one_part_based(const int id, rep_row_t& areprow);
     w_rc_t _gen_one_cust_based(const int id, rep_row_t& areprow);
+    w_rc_t _gen_one_order(const int index, const long upd_num,
+                          table_row_t* pror, table_row_t* prli);
     
 public:    
     ShoreTPCHEnv();
@@ -353,6 +368,10 @@ public:
     // QUERIES for the non-partition aligned benchmark
     DECLARE_TRX(qNP);
 
+    // Refresh functions
+    DECLARE_TRX(rf1);
+    DECLARE_TRX(rf2);
+
     // Database population
     DECLARE_TRX(populate_baseline);
     DECLARE_TRX(populate_some_parts);
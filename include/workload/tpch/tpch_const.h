@@ -53,6 +53,12 @@ const int LINEITEMS_10  = 59986052;
 const int LINEITEMS_30  = 179998372;
 const int LINEITEMS_100 = 600037902;
 
+// --- refresh functions -- //
+
+// RF1 inserts and RF2 deletes ORDERS/1000 orders per SF, with their lineitems
+const int RF_ORDERS         = ORDERS/1000;
+const int RF_ORDERS_PER_XCT = 100;
+
 const int MAX_TABLENAM_LENGTH   = 8;
 const int MAX_RECORD_LENGTH     = 234;
 
@@ -100,6 +106,9 @@ const int XCT_TPCH_Q20      = 60;
 const int XCT_TPCH_Q21      = 61;
 const int XCT_TPCH_Q22      = 62;
 
+const int XCT_TPCH_RF1      = 63;
+const int XCT_TPCH_RF2      = 64;
+
 const int XCT_TPCH_QLINEITEM = 70;
 const int XCT_TPCH_QORDERS   = 71;
 const int XCT_TPCH_QREGION   = 72;
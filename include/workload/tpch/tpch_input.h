@@ -448,6 +448,41 @@ qNP_input_t    create_qNP_input(const double sf,
 
 
 
+/******************************************************************** 
+ *
+ *  RF1 - RF2
+ *
+ *  Both refresh functions work on the orders [_first,_first+_count)
+ *  of the refresh set, RF1 inserting and RF2 deleting them
+ *
+ ********************************************************************/
+
+struct rf1_input_t 
+{
+    int _first;
+    int _count;
+
+    rf1_input_t& operator=(const rf1_input_t& rhs);
+};
+
+rf1_input_t    create_rf1_input(const double sf, 
+                                const int specificWH = 0);
+
+
+struct rf2_input_t 
+{
+    int _first;
+    int _count;
+
+    rf2_input_t& operator=(const rf2_input_t& rhs);
+};
+
+rf2_input_t    create_rf2_input(const double sf, 
+                                const int specificWH = 0);
+
+
+
+
 /******************************************************************** 
  *
  *  Inputs for the TPC-H Database Population
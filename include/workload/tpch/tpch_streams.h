@@ -0,0 +1,160 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   tpch_streams.h
+ *
+ *  @brief:  The TPC-H power and throughput tests. A query stream runs
+ *           the 22 queries one after the other, in the order of its
+ *           row of the spec permutation, and a refresh stream runs
+ *           pairs of RF1/RF2. Every query is submitted to a worker and
+ *           timed until the worker notifies the stream.
+ *
+ */
+
+#ifndef __TPCH_STREAMS_H
+#define __TPCH_STREAMS_H
+
+#include "sm/shore/shore_client.h"
+#include "util/command/command_handler.h"
+
+#include "workload/tpch/tpch_const.h"
+#include "workload/tpch/shore_tpch_env.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(tpch);
+
+using namespace shore;
+
+
+// number of queries per stream
+const int TPCH_QUERIES = 22;
+
+// rows of the spec permutation, the power test uses the first
+const int TPCH_MAX_STREAMS = 41;
+
+
+
+/********************************************************************
+ *
+ * @class: tpch_stream_client_t
+ *
+ * @brief: Runs one stream of the power or throughput test: the query
+ *         stream (stream), if not negative, and (pairs) refresh
+ *         pairs of the refresh sets from (first_set) on. The query
+ *         stream runs between the RF1 and the RF2 of the first pair,
+ *         as the power test wants.
+ *
+ ********************************************************************/
+
+class tpch_stream_client_t : public base_client_t
+{
+private:
+
+    trx_worker_t* _worker;
+
+    int _stream;
+    int _xct_base;
+    int _first_set;
+    int _pairs;
+    int _xct_cnt;
+
+    // seconds per query, by query number-1, and per RF1/RF2
+    double              _qtime[TPCH_QUERIES];
+    std::vector<double> _rf1time;
+    std::vector<double> _rf2time;
+
+public:
+
+    tpch_stream_client_t(c_str tname, const int id, ShoreTPCHEnv* env,
+                         const int stream, const int xct_base,
+                         const int first_set, const int pairs,
+                         processorid_t aprsid = PBIND_NONE);
+    ~tpch_stream_client_t() { }
+
+    // thread entrance
+    void work();
+
+    int    stream() const { return (_stream); }
+    int    pairs() const { return (_pairs); }
+    double qtime(const int q) const { return (_qtime[q-1]); }
+    double rf1time(const int pair) const { return (_rf1time[pair]); }
+    double rf2time(const int pair) const { return (_rf2time[pair]); }
+
+    // INTERFACE
+
+    w_rc_t submit_one(int xct_type, int xctid);
+
+private:
+
+    double _run_one(const int xct_type, const int selid);
+    double _run_refresh(const int xct_type, const int set);
+    w_rc_t _submit(const int xct_type, const int xctid, const int selid);
+
+}; // EOF: tpch_stream_client_t
+
+
+
+/********************************************************************
+ *
+ * @class: tpch_streams_cmd_t
+ *
+ * @brief: The "qphh" command, runs the power test and then the
+ *         throughput test with the given number of query streams,
+ *         and reports the timings of every stream along with the
+ *         Power@Size, Throughput@Size and QphH@Size metrics
+ *
+ ********************************************************************/
+
+class tpch_streams_cmd_t : public command_handler_t
+{
+private:
+
+    ShoreTPCHEnv* _env;
+
+public:
+
+    tpch_streams_cmd_t(ShoreTPCHEnv* env) : _env(env) { }
+    ~tpch_streams_cmd_t() { }
+
+    int handle(const char* cmd);
+
+    void setaliases();
+    void usage();
+    string desc() const;
+
+private:
+
+    double _power_test(const int xct_base);
+    double _throughput_test(const int xct_base, const int streams);
+
+    void _print_streams(tpch_stream_client_t* const* clients,
+                        const int count) const;
+
+}; // EOF: tpch_streams_cmd_t
+
+
+EXIT_NAMESPACE(tpch);
+
+#endif /* __TPCH_STREAMS_H */
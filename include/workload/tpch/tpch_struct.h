@@ -446,8 +446,7 @@ struct tpch_orders_tuple
     char     O_ORDERSTATUS;
     decimal  O_TOTALPRICE;
 
-//     time_t   O_ORDERDATE;
-    char     O_ORDERDATE     [STRSIZE(15)];
+    date_t   O_ORDERDATE;
 
     char     O_ORDERPRIORITY [STRSIZE(15)];
     char     O_CLERK         [STRSIZE(15)];
@@ -468,8 +467,7 @@ struct tpch_orders_tuple_body
     char     O_ORDERSTATUS;
     decimal  O_TOTALPRICE;
 
-//     time_t   O_ORDERDATE;
-    char     O_ORDERDATE     [STRSIZE(15)];
+    date_t   O_ORDERDATE;
 
     char     O_ORDERPRIORITY [STRSIZE(15)];
     char     O_CLERK         [STRSIZE(15)];
@@ -494,12 +492,9 @@ struct tpch_lineitem_tuple
     char    L_RETURNFLAG;
     char    L_LINESTATUS;
 
-//     time_t  L_SHIPDATE;
-//     time_t  L_COMMITDATE;
-//     time_t  L_RECEIPTDATE;
-    char  L_SHIPDATE    [STRSIZE(15)];
-    char  L_COMMITDATE  [STRSIZE(15)];
-    char  L_RECEIPTDATE [STRSIZE(15)];
+    date_t  L_SHIPDATE;
+    date_t  L_COMMITDATE;
+    date_t  L_RECEIPTDATE;
 
     char    L_SHIPINSTRUCT  [STRSIZE(25)];
     char    L_SHIPMODE      [STRSIZE(10)];
@@ -536,12 +531,9 @@ struct tpch_lineitem_tuple_body
     char    L_RETURNFLAG;
     char    L_LINESTATUS;
 
-//     time_t  L_SHIPDATE;
-//     time_t  L_COMMITDATE;
-//     time_t  L_RECEIPTDATE;
-    char  L_SHIPDATE    [STRSIZE(15)];
-    char  L_COMMITDATE  [STRSIZE(15)];
-    char  L_RECEIPTDATE [STRSIZE(15)];
+    date_t  L_SHIPDATE;
+    date_t  L_COMMITDATE;
+    date_t  L_RECEIPTDATE;
 
     char    L_SHIPINSTRUCT  [STRSIZE(25)];
     char    L_SHIPMODE      [STRSIZE(10)];
@@ -0,0 +1,237 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_ycsb_env.h
+ *
+ *  @brief:  Definition of the Shore YCSB environment
+ */
+
+#ifndef __SHORE_YCSB_ENV_H
+#define __SHORE_YCSB_ENV_H
+
+
+#include "sm_vas.h"
+#include "util.h"
+
+#include "workload/ycsb/ycsb_const.h"
+#include "workload/ycsb/ycsb_input.h"
+
+#include "sm/shore/shore_env.h"
+#include "sm/shore/shore_trx_worker.h"
+
+#include "workload/ycsb/shore_ycsb_schema_man.h"
+
+#include <map>
+
+using std::map;
+using namespace shore;
+
+
+ENTER_NAMESPACE(ycsb);
+
+
+
+/********************************************************************
+ *
+ *  ShoreYCSBEnv Stats
+ *
+ *  Shore YCSB Database transaction statistics
+ *
+ ********************************************************************/
+
+struct ShoreYCSBTrxCount
+{
+    uint read_rec;
+    uint update_rec;
+    uint insert_rec;
+    uint scan_rec;
+    uint rmw_rec;
+
+    ShoreYCSBTrxCount& operator+=(ShoreYCSBTrxCount const& rhs) {
+        read_rec += rhs.read_rec;
+        update_rec += rhs.update_rec;
+        insert_rec += rhs.insert_rec;
+        scan_rec += rhs.scan_rec;
+        rmw_rec += rhs.rmw_rec;
+	return (*this);
+    }
+
+    ShoreYCSBTrxCount& operator-=(ShoreYCSBTrxCount const& rhs) {
+        read_rec -= rhs.read_rec;
+        update_rec -= rhs.update_rec;
+        insert_rec -= rhs.insert_rec;
+        scan_rec -= rhs.scan_rec;
+        rmw_rec -= rhs.rmw_rec;
+	return (*this);
+    }
+
+    uint total() const {
+        return (read_rec+update_rec+insert_rec+scan_rec+rmw_rec);
+    }
+
+}; // EOF: ShoreYCSBTrxCount
+
+
+struct ShoreYCSBTrxStats
+{
+    ShoreYCSBTrxCount attempted;
+    ShoreYCSBTrxCount failed;
+    ShoreYCSBTrxCount deadlocked;
+
+    ShoreYCSBTrxStats& operator+=(ShoreYCSBTrxStats const& other) {
+        attempted  += other.attempted;
+        failed     += other.failed;
+        deadlocked += other.deadlocked;
+        return (*this);
+    }
+
+    ShoreYCSBTrxStats& operator-=(ShoreYCSBTrxStats const& other) {
+        attempted  -= other.attempted;
+        failed     -= other.failed;
+        deadlocked -= other.deadlocked;
+        return (*this);
+    }
+
+}; // EOF: ShoreYCSBTrxStats
+
+
+
+
+/********************************************************************
+ *
+ *  ShoreYCSBEnv
+ *
+ *  Shore YCSB Database. A single key-value table (USERTABLE) and the
+ *  read/update/insert/scan/read-modify-write operations the YCSB core
+ *  workloads A-F are made of.
+ *
+ ********************************************************************/
+
+class ShoreYCSBEnv : public ShoreEnv
+{
+public:
+
+    typedef std::map<pthread_t, ShoreYCSBTrxStats*> statmap_t;
+
+    class table_builder_t;
+    class table_creator_t;
+
+private:
+    w_rc_t _post_init_impl();
+
+public:
+
+    ShoreYCSBEnv();
+    virtual ~ShoreYCSBEnv();
+
+    // DB INTERFACE
+
+    virtual int set(envVarMap* /* vars */) { return(0); /* do nothing */ };
+    virtual int open() { return(0); /* do nothing */ };
+    virtual int pause() { return(0); /* do nothing */ };
+    virtual int resume() { return(0); /* do nothing */ };
+    virtual w_rc_t newrun() { return(RCOK); /* do nothing */ };
+
+    virtual int post_init();
+    virtual w_rc_t load_schema();
+
+    virtual w_rc_t load_and_register_fids();
+
+    virtual int conf();
+    virtual int start();
+    virtual int stop();
+    virtual int info() const;
+    virtual int statistics();
+
+    virtual w_rc_t warmup() { return(RCOK); /* do nothing */ };
+    virtual w_rc_t check_consistency() { return(RCOK); /* do nothing */ };
+
+    virtual void print_throughput(const double iQueriedSF,
+                                  const int iSpread,
+                                  const int iNumOfThreads,
+                                  const double delay,
+                                  const ulong_t mioch,
+                                  const double avgcpuusage);
+
+    // Public methods //
+
+    // --- operations over tables --- //
+    virtual w_rc_t loaddata();
+    w_rc_t xct_populate_one(const int key);
+
+    // YCSB table
+    DECLARE_TABLE(usertable_t,ut_man_impl,ut);
+
+
+    // --- kit trxs --- //
+
+    w_rc_t run_one_xct(Request* prequest);
+
+    // the run_* of each trx id
+    trx_registry_t<ShoreYCSBEnv> _trxs;
+    virtual bool has_trx(const int xct_type) const { return (_trxs.has(xct_type)); }
+
+    // the mix of the operations of a core workload
+    static trx_mix_t workload_mix(const int workload);
+
+    DECLARE_TRX(read_rec);
+    DECLARE_TRX(update_rec);
+    DECLARE_TRX(insert_rec);
+    DECLARE_TRX(scan_rec);
+    DECLARE_TRX(rmw_rec);
+
+    // Update the partitioning info, if any needed
+    virtual w_rc_t update_partitioning();
+
+    // for thread-local stats
+    virtual void env_thread_init();
+    virtual void env_thread_fini();
+
+    // stat map
+    statmap_t _statmap;
+
+    // snapshot taken at the beginning of each experiment
+    ShoreYCSBTrxStats _last_stats;
+    virtual void reset_stats();
+    ShoreYCSBTrxStats _get_stats();
+
+    // set the key distribution of the records
+    void set_keydist(const keydist_spec_t& spec);
+
+    // the number of records loaded (SF * records per SF)
+    int get_loaded_records() const;
+
+    //print the current tables into files
+    w_rc_t db_print(int lines);
+
+    //fetch the pages of the current tables and their indexes into the buffer pool
+    w_rc_t db_fetch();
+
+}; // EOF ShoreYCSBEnv
+
+
+
+EXIT_NAMESPACE(ycsb);
+
+
+#endif /* __SHORE_YCSB_ENV_H */
@@ -0,0 +1,98 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_ycsb_schema_man.h
+ *
+ *  @brief:  Declaration of the YCSB table manager
+ */
+
+#ifndef __SHORE_YCSB_SCHEMA_MANAGER_H
+#define __SHORE_YCSB_SCHEMA_MANAGER_H
+
+
+#include "workload/ycsb/shore_ycsb_schema.h"
+
+using namespace shore;
+
+
+ENTER_NAMESPACE(ycsb);
+
+
+
+/* ---------------------------------------------------------------- */
+/* --- The manager of the table used in the YCSB benchmark      --- */
+/* ---------------------------------------------------------------- */
+
+
+class ut_man_impl : public table_man_impl<usertable_t>
+{
+    typedef table_row_t ut_tuple;
+    typedef index_scan_iter_impl<usertable_t> ut_idx_iter;
+
+public:
+
+    ut_man_impl(usertable_t* aUsertableDesc)
+        : table_man_impl<usertable_t>(aUsertableDesc)
+    { }
+    ~ut_man_impl() { }
+
+    /* --- access specific tuples  --- */
+    w_rc_t ut_idx_probe(ss_m* db,
+                        ut_tuple* ptuple,
+                        const int key);
+
+    w_rc_t ut_idx_upd(ss_m* db,
+                      ut_tuple* ptuple,
+                      const int key);
+
+    w_rc_t ut_idx_nl(ss_m* db,
+                     ut_tuple* ptuple,
+                     const int key);
+
+
+    /* --- access the records [key,key+range) with iter  --- */
+    w_rc_t ut_get_idx_iter(ss_m* db,
+                           ut_idx_iter* &iter,
+                           ut_tuple* ptuple,
+                           rep_row_t &replow,
+                           rep_row_t &rephigh,
+                           const int key,
+                           const int range,
+                           lock_mode_t alm = SH,
+                           bool need_tuple = true);
+
+    w_rc_t ut_get_idx_iter_nl(ss_m* db,
+                              ut_idx_iter* &iter,
+                              ut_tuple* ptuple,
+                              rep_row_t &replow,
+                              rep_row_t &rephigh,
+                              const int key,
+                              const int range,
+                              bool need_tuple = true);
+
+}; // EOF: ut_man_impl
+
+
+EXIT_NAMESPACE(ycsb);
+
+#endif /* __SHORE_YCSB_SCHEMA_MANAGER_H */
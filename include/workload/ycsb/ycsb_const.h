@@ -0,0 +1,115 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   ycsb_const.h
+ *
+ *  @brief:  Constants needed by the YCSB kit
+ */
+
+#ifndef __YCSB_CONST_H
+#define __YCSB_CONST_H
+
+
+#include "util/namespace.h"
+
+
+ENTER_NAMESPACE(ycsb);
+
+
+// the scaling factor unit
+// SF = 1   --> 10K records
+// SF = 100 --> 1M  records
+// (can be changed with "ycsb-records-per-sf" in shore.conf)
+const int YCSB_RECORDS_PER_SF = 10000;
+
+const int YCSB_DEF_SF = 10;
+const int YCSB_DEF_QF = 10;
+
+
+// commit every 1000 new records
+const int YCSB_LOADING_COMMIT_INTERVAL = 1000;
+const int YCSB_LOADING_TRACE_INTERVAL  = 10000;
+
+
+// loading-related defaults
+const int YCSB_LOADERS_TO_USE     = 1;
+const int YCSB_RECORDS_TO_PRELOAD = 2000;
+
+
+/* --- usertable --- */
+
+// YCSB_KEY + FIELD0..FIELD9
+const int YCSB_FIELD_COUNT = 10;
+const int YCSB_FIELD_LEN   = 100;
+const int YCSB_FCOUNT      = YCSB_FIELD_COUNT + 1;
+
+// the scans read between 1 and that many records
+const int YCSB_MAX_SCAN_LEN = 100;
+
+
+
+/* ---------------------------- */
+/* --- YCSB TRANSACTION MIX --- */
+/* ---------------------------- */
+
+// the mix of the workload in the configuration (<db-config>-workload)
+const int XCT_YCSB_MIX        = 500;
+
+// the core workloads
+const int XCT_YCSB_A          = 501;
+const int XCT_YCSB_B          = 502;
+const int XCT_YCSB_C          = 503;
+const int XCT_YCSB_D          = 504;
+const int XCT_YCSB_E          = 505;
+const int XCT_YCSB_F          = 506;
+
+// the single operations
+const int XCT_YCSB_READ       = 511;
+const int XCT_YCSB_UPDATE     = 512;
+const int XCT_YCSB_INSERT     = 513;
+const int XCT_YCSB_SCAN       = 514;
+const int XCT_YCSB_RMW        = 515;
+
+
+/* --- the core workloads --- */
+
+// A: update heavy   - read 50%  update 50%
+// B: read mostly    - read 95%  update 5%
+// C: read only      - read 100%
+// D: read latest    - read 95%  insert 5% (with the "latest" keydist)
+// E: short ranges   - scan 95%  insert 5%
+// F: read-mod-write - read 50%  rmw 50%
+
+const int YCSB_WORKLOAD_A = 0;
+const int YCSB_WORKLOAD_B = 1;
+const int YCSB_WORKLOAD_C = 2;
+const int YCSB_WORKLOAD_D = 3;
+const int YCSB_WORKLOAD_E = 4;
+const int YCSB_WORKLOAD_F = 5;
+
+const int YCSB_WORKLOADS  = 6;
+
+
+EXIT_NAMESPACE(ycsb);
+
+#endif /* __YCSB_CONST_H */
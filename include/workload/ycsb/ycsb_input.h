@@ -0,0 +1,158 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   ycsb_input.h
+ *
+ *  @brief:  Declaration of the (common) inputs for the YCSB trxs
+ */
+
+
+#ifndef __YCSB_INPUT_H
+#define __YCSB_INPUT_H
+
+#include "util/random_input.h"
+
+#include "workload/ycsb/ycsb_const.h"
+
+
+
+ENTER_NAMESPACE(ycsb);
+
+/** Exported variables */
+// key distribution of the records
+extern keydist_t y_keydist;
+// records per scaling factor unit
+extern int y_records_per_sf;
+// the key the next insert gets, unless an aborted one is reused
+extern volatile unsigned int y_next_key;
+// the records [0,y_committed_key) all exist; the inserts of the keys
+// above it may still run, or may have aborted
+extern volatile unsigned int y_committed_key;
+// the workload run by XCT_YCSB_MIX
+extern int y_workload;
+
+
+/** Exported data structures */
+
+struct ycsb_rec_t
+{
+    int   YCSB_KEY;
+    char  FIELD[YCSB_FIELD_COUNT][STRSIZE(YCSB_FIELD_LEN)];
+};
+
+
+/*********************************************************************
+ *
+ * The inputs of the YCSB operations. The keys start from 0.
+ *
+ *********************************************************************/
+
+struct read_rec_input_t
+{
+    int    _key;              /* input: keydist over the records */
+};
+
+
+struct update_rec_input_t
+{
+    int    _key;              /* input: keydist over the records */
+    short  _field;            /* input: URand(0,FIELD_COUNT-1) */
+};
+
+
+struct insert_rec_input_t
+{
+    int    _key;              /* input: the next unused key */
+};
+
+
+struct scan_rec_input_t
+{
+    int    _key;              /* input: keydist over the records */
+    int    _len;              /* input: URand(1,MAX_SCAN_LEN) */
+};
+
+
+struct rmw_rec_input_t
+{
+    int    _key;              /* input: keydist over the records */
+    short  _field;            /* input: URand(0,FIELD_COUNT-1) */
+};
+
+
+
+/////////////////////////////////////////////////////////////
+//
+// @brief: Declaration of functions that generate the inputs
+//         for the YCSB TRXs
+//
+// @note:  A specificSF>0 confines the keys to the records of
+//         that SF unit (1..SF)
+//
+/////////////////////////////////////////////////////////////
+
+
+read_rec_input_t create_read_rec_input(int SF,
+                                       int specificSF = 0);
+
+
+update_rec_input_t create_update_rec_input(int SF,
+                                           int specificSF = 0);
+
+
+insert_rec_input_t create_insert_rec_input(int SF,
+                                           int specificSF = 0);
+
+// called when the insert of (key) ended. A committed key advances
+// y_committed_key once all the keys below it committed; an aborted
+// one is given to the next insert
+void ycsb_insert_done(const int key, const bool committed);
+
+// restarts the keys at (next), with all the records below it in place
+void ycsb_reset_keys(const int next);
+
+
+scan_rec_input_t create_scan_rec_input(int SF,
+                                       int specificSF = 0);
+
+
+rmw_rec_input_t create_rmw_rec_input(int SF,
+                                     int specificSF = 0);
+
+
+/* --- picks a random operation of a workload, given its mix --- */
+
+
+int random_ycsb_xct_type(const int workload, const int selected);
+
+// the percentage of operation (xct_type) in (workload)
+int ycsb_op_pct(const int workload, const int xct_type);
+
+// "a".."f" (or "A".."F") to YCSB_WORKLOAD_A..F, -1 if unknown
+int ycsb_workload_from_name(const char* name);
+
+
+EXIT_NAMESPACE(ycsb);
+
+
+#endif
@@ -0,0 +1,312 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+/** @file:   dora_ycsb.cpp
+ *
+ *  @brief:  Implementation of the DORA YCSB class
+ */
+
+#include "tls.h"
+
+#include "dora/ycsb/dora_ycsb.h"
+#include "dora/ycsb/dora_ycsb_impl.h"
+
+using namespace shore;
+using namespace ycsb;
+
+
+ENTER_NAMESPACE(dora);
+
+
+
+// max field counts for (int) keys of the ycsb table
+const uint ut_IRP_KEY  = 1;
+
+// key estimations for each partition of the ycsb table
+const uint ut_KEY_EST  = 1000;
+
+
+
+
+/******************************************************************
+ *
+ * @fn:    construction/destruction
+ *
+ * @brief: If configured, it creates and starts the flusher
+ *
+ ******************************************************************/
+
+DoraYCSBEnv::DoraYCSBEnv()
+    : ShoreYCSBEnv()
+{
+    update_pd(this);
+}
+
+DoraYCSBEnv::~DoraYCSBEnv()
+{
+    stop();
+}
+
+
+/******************************************************************
+ *
+ * @fn:    start()
+ *
+ * @brief: Starts the DORA YCSB
+ *
+ * @note:  Creates a corresponding number of partitions per table.
+ *         The decision about the number of partitions per table may
+ *         be based among others on:
+ *         - _env->_sf : the database scaling factor
+ *         - _env->_{max,active}_cpu_count: {hard,soft} cpu counts
+ *
+ ******************************************************************/
+
+int DoraYCSBEnv::start()
+{
+    // 1. Creates partitioned tables
+    // 2. Adds them to the vector
+    // 3. Resets each table
+
+    conf(); // re-configure
+    processorid_t icpu(_starting_cpu);
+
+    // USERTABLE
+    GENERATE_DORA_PARTS(ut,ut);
+
+    // Call the post-start procedure of the dora environment
+    DoraEnv::_post_start(this);
+    return (0);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    update_partitioning()
+ *
+ *  @brief: Applies the baseline partitioning to the YCSB table
+ *
+ ********************************************************************/
+
+w_rc_t DoraYCSBEnv::update_partitioning()
+{
+    // *** Reminder: The YCSB keys start from 0 ***
+
+    // First configure
+    conf();
+
+    int minKeyVal = 0;
+    int maxKeyVal = get_loaded_records();
+
+    char* minKey = (char*)malloc(sizeof(int));
+    memset(minKey,0,sizeof(int));
+    memcpy(minKey,&minKeyVal,sizeof(int));
+
+    char* maxKey = (char*)malloc(sizeof(int));
+    memset(maxKey,0,sizeof(int));
+    memcpy(maxKey,&maxKeyVal,sizeof(int));
+
+    // Usertable: [ 0 .. #Records ). The inserted records go to the
+    // last partition.
+    _put_desc->set_partitioning(minKey,sizeof(int),maxKey,sizeof(int),_parts_ut);
+
+    free (minKey);
+    free (maxKey);
+
+    return (RCOK);
+}
+
+
+
+
+
+/******************************************************************
+ *
+ * @fn:    stop()
+ *
+ * @brief: Stops the DORA YCSB
+ *
+ ******************************************************************/
+
+int DoraYCSBEnv::stop()
+{
+    // Call the post-stop procedure of the dora environment
+    return (DoraEnv::_post_stop(this));
+}
+
+
+/******************************************************************
+ *
+ * @fn:    conf()
+ *
+ * @brief: Re-reads configuration
+ *
+ ******************************************************************/
+
+int DoraYCSBEnv::conf()
+{
+    ShoreYCSBEnv::conf();
+    _check_type();
+    envVar* ev = envVar::instance();
+
+    // Get CPU and binding configuration
+    _cpu_range = get_active_cpu_count();
+    _starting_cpu = ev->getVarInt("dora-cpu-starting",DF_CPU_STEP_PARTITIONS);
+    _cpu_table_step = ev->getVarInt("dora-cpu-table-step",DF_CPU_STEP_TABLES);
+
+    // The number of partitions depends on:
+    // (a) The number of CPUs available
+    // (b) The ratio of partitions per CPU in the configuration (shore.conf)
+    // (c) The number of records
+    uint recordEstimation = get_loaded_records();
+    double ut_PerCPU = ev->getVarDouble("dora-ratio-ycsb-ut",1);
+    _parts_ut = ( ut_PerCPU>0 ? ceil(_cpu_range * ut_PerCPU) : 1);
+    _parts_ut = std::min(recordEstimation,_parts_ut);
+
+    TRACE( TRACE_STATISTICS,"Total number of partitions (%d)\n",
+           _parts_ut);
+
+    return (0);
+}
+
+
+
+
+
+/******************************************************************
+ *
+ * @fn:    newrun()
+ *
+ * @brief: Prepares the DORA YCSB DB for a new run
+ *
+ ******************************************************************/
+
+w_rc_t DoraYCSBEnv::newrun()
+{
+    return (DoraEnv::_newrun(this));
+}
+
+
+/******************************************************************
+ *
+ * @fn:    dump()
+ *
+ * @brief: Dumps information about all the tables and partitions
+ *
+ ******************************************************************/
+
+int DoraYCSBEnv::dump()
+{
+    return (DoraEnv::_dump(this));
+}
+
+
+/******************************************************************
+ *
+ * @fn:    info()
+ *
+ * @brief: Information about the current state of DORA
+ *
+ ******************************************************************/
+
+int DoraYCSBEnv::info() const
+{
+    return (DoraEnv::_info(this));
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    statistics
+ *
+ *  @brief: Prints statistics for DORA-YCSB
+ *
+ ********************************************************************/
+
+int DoraYCSBEnv::statistics()
+{
+    DoraEnv::_statistics(this);
+
+    // YCSB STATS
+    TRACE( TRACE_STATISTICS, "----- YCSB  -----\n");
+    ShoreYCSBEnv::statistics();
+    return (0);
+}
+
+
+
+/********************************************************************
+ *
+ *  Thread-local action and rvp object caches
+ *
+ ********************************************************************/
+
+
+
+//////////
+// Read //
+//////////
+
+DEFINE_DORA_FINAL_RVP_GEN_FUNC(final_rd_rvp,DoraYCSBEnv);
+
+DEFINE_DORA_ACTION_GEN_FUNC(r_ut_rd_action,rvp_t,read_rec_input_t,int,DoraYCSBEnv);
+
+
+////////////
+// Update //
+////////////
+
+DEFINE_DORA_FINAL_RVP_GEN_FUNC(final_up_rvp,DoraYCSBEnv);
+
+DEFINE_DORA_ACTION_GEN_FUNC(upd_ut_up_action,rvp_t,update_rec_input_t,int,DoraYCSBEnv);
+
+
+////////////
+// Insert //
+////////////
+
+DEFINE_DORA_FINAL_RVP_GEN_FUNC(final_in_rvp,DoraYCSBEnv);
+
+DEFINE_DORA_ACTION_GEN_FUNC(ins_ut_in_action,rvp_t,insert_rec_input_t,int,DoraYCSBEnv);
+
+
+//////////
+// Scan //
+//////////
+
+DEFINE_DORA_FINAL_RVP_GEN_FUNC(final_sc_rvp,DoraYCSBEnv);
+
+DEFINE_DORA_ACTION_GEN_FUNC(r_ut_sc_action,rvp_t,scan_rec_input_t,int,DoraYCSBEnv);
+
+
+/////////////////////
+// ReadModifyWrite //
+/////////////////////
+
+DEFINE_DORA_FINAL_RVP_GEN_FUNC(final_rmw_rvp,DoraYCSBEnv);
+
+DEFINE_DORA_ACTION_GEN_FUNC(upd_ut_rmw_action,rvp_t,rmw_rec_input_t,int,DoraYCSBEnv);
+
+
+
+EXIT_NAMESPACE(dora);
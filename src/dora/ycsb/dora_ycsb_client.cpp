@@ -0,0 +1,138 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+/** @file:   dora_ycsb_client.cpp
+ *
+ *  @brief:  Implementation of the DORA client for the YCSB benchmark
+ */
+
+#include "dora/ycsb/dora_ycsb_client.h"
+
+
+ENTER_NAMESPACE(dora);
+
+
+// Look also at include/workload/ycsb/ycsb_const.h
+// @note: The DORA_XXX should be (DORA_MIX + REGULAR_TRX_ID - XCT_YCSB_MIX)
+const int XCT_YCSB_DORA_MIX     = 400;
+const int XCT_YCSB_DORA_A       = 401;
+const int XCT_YCSB_DORA_B       = 402;
+const int XCT_YCSB_DORA_C       = 403;
+const int XCT_YCSB_DORA_D       = 404;
+const int XCT_YCSB_DORA_E       = 405;
+const int XCT_YCSB_DORA_F       = 406;
+
+const int XCT_YCSB_DORA_READ    = 411;
+const int XCT_YCSB_DORA_UPDATE  = 412;
+const int XCT_YCSB_DORA_INSERT  = 413;
+const int XCT_YCSB_DORA_SCAN    = 414;
+const int XCT_YCSB_DORA_RMW     = 415;
+
+
+/*********************************************************************
+ *
+ *  dora_ycsb_client_t
+ *
+  *********************************************************************/
+
+int dora_ycsb_client_t::load_sup_xct(mapSupTrxs& stmap)
+{
+    // clears the supported trx map and loads its own
+    stmap.clear();
+
+    // DORA YCSB trxs
+    stmap[XCT_YCSB_DORA_MIX]      = "DORA-YCSB-Mix";
+    stmap[XCT_YCSB_DORA_A]        = "DORA-YCSB-A";
+    stmap[XCT_YCSB_DORA_B]        = "DORA-YCSB-B";
+    stmap[XCT_YCSB_DORA_C]        = "DORA-YCSB-C";
+    stmap[XCT_YCSB_DORA_D]        = "DORA-YCSB-D";
+    stmap[XCT_YCSB_DORA_E]        = "DORA-YCSB-E";
+    stmap[XCT_YCSB_DORA_F]        = "DORA-YCSB-F";
+
+    stmap[XCT_YCSB_DORA_READ]     = "DORA-YCSB-Read";
+    stmap[XCT_YCSB_DORA_UPDATE]   = "DORA-YCSB-Update";
+    stmap[XCT_YCSB_DORA_INSERT]   = "DORA-YCSB-Insert";
+    stmap[XCT_YCSB_DORA_SCAN]     = "DORA-YCSB-Scan";
+    stmap[XCT_YCSB_DORA_RMW]      = "DORA-YCSB-ReadModWrite";
+
+    return (stmap.size());
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    submit_one
+ *
+ *  @brief: Entry point for running one DORA YCSB xct
+ *
+ *  @note:  The execution of this trx will not be stopped even if the
+ *          measure internal has expired.
+ *
+ *********************************************************************/
+
+w_rc_t dora_ycsb_client_t::submit_one(int xct_type, int xctid)
+{
+    // if DORA YCSB MIX or one of the workloads, pick one of its operations
+    bool bWake = false;
+    if (xct_type == XCT_YCSB_DORA_MIX) {
+        xct_type = XCT_YCSB_DORA_MIX - XCT_YCSB_MIX +
+            random_ycsb_xct_type(y_workload, rand(100));
+        bWake = true;
+    }
+    else if ((xct_type >= XCT_YCSB_DORA_A) && (xct_type <= XCT_YCSB_DORA_F)) {
+        xct_type = XCT_YCSB_DORA_MIX - XCT_YCSB_MIX +
+            random_ycsb_xct_type(xct_type - XCT_YCSB_DORA_A, rand(100));
+        bWake = true;
+    }
+
+    // With spread the client sticks to the records of one SF unit,
+    // otherwise the keys are drawn over all the records (keydist)
+    int selid = _selid;
+
+    trx_result_tuple_t atrt;
+    if (condex* c = _cp->take_one()) {
+        atrt.set_notify(c);
+        bWake = true;
+    }
+
+    switch (xct_type) {
+
+        // YCSB DORA
+    case XCT_YCSB_DORA_READ:
+        return (_ycsbdb->dora_read_rec(xctid,atrt,selid,bWake));
+    case XCT_YCSB_DORA_UPDATE:
+        return (_ycsbdb->dora_update_rec(xctid,atrt,selid,bWake));
+    case XCT_YCSB_DORA_INSERT:
+        return (_ycsbdb->dora_insert_rec(xctid,atrt,selid,bWake));
+    case XCT_YCSB_DORA_SCAN:
+        return (_ycsbdb->dora_scan_rec(xctid,atrt,selid,bWake));
+    case XCT_YCSB_DORA_RMW:
+        return (_ycsbdb->dora_rmw_rec(xctid,atrt,selid,bWake));
+
+    default:
+        assert (0); // UNKNOWN TRX-ID
+    }
+    return (RCOK);
+}
+
+
+EXIT_NAMESPACE(dora);
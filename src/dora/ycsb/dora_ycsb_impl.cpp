@@ -0,0 +1,367 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+/** @file:   dora_ycsb_impl.cpp
+ *
+ *  @brief:  DORA YCSB TRXs
+ *
+ *  @note:   Implementation of RVPs and Actions that synthesize (according to DORA)
+ *           the YCSB trxs
+ */
+
+#include "dora/ycsb/dora_ycsb_impl.h"
+#include "dora/ycsb/dora_ycsb.h"
+
+using namespace shore;
+using namespace ycsb;
+
+
+ENTER_NAMESPACE(dora);
+
+
+/********************************************************************
+ *
+ * DORA YCSB READ
+ *
+ ********************************************************************/
+
+DEFINE_DORA_FINAL_RVP_CLASS(final_rd_rvp,read_rec);
+
+
+void r_ut_rd_action::calc_keys()
+{
+    set_read_only();
+    _down.push_back(_in._key);
+}
+
+
+w_rc_t r_ut_rd_action::trx_exec()
+{
+    assert (_penv);
+
+    // get table tuple from the cache
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_penv->ut_man());
+    rep_row_t areprow(_penv->ut_man()->ts());
+    areprow.set(_penv->ut_desc()->maxsize());
+    prut->_rep = &areprow;
+
+    /* SELECT *
+     * FROM   Usertable
+     * WHERE  ycsb_key = <key>
+     *
+     * plan: index probe on "YCSB_IDX"
+     */
+
+    // 1. Probe Usertable
+    TRACE( TRACE_TRX_FLOW, "App: %d RD:ut-idx-nl (%d)\n", _tid.get_lo(), _in._key);
+    W_DO(_penv->ut_man()->ut_idx_nl(_penv->db(), prut, _in._key));
+
+    ycsb_rec_t arec;
+    prut->get_value(0, arec.YCSB_KEY);
+    for (int i=0; i<YCSB_FIELD_COUNT; i++)
+        prut->get_value(i+1, arec.FIELD[i], STRSIZE(YCSB_FIELD_LEN));
+
+#ifdef PRINT_TRX_RESULTS
+    // dumps the status of all the table rows used
+    prut->print_tuple();
+#endif
+
+    return RCOK;
+}
+
+
+
+/********************************************************************
+ *
+ * DORA YCSB UPDATE
+ *
+ ********************************************************************/
+
+DEFINE_DORA_FINAL_RVP_CLASS(final_up_rvp,update_rec);
+
+
+void upd_ut_up_action::calc_keys()
+{
+    _down.push_back(_in._key);
+}
+
+
+w_rc_t upd_ut_up_action::trx_exec()
+{
+    assert (_penv);
+
+    // get table tuple from the cache
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_penv->ut_man());
+    rep_row_t areprow(_penv->ut_man()->ts());
+    areprow.set(_penv->ut_desc()->maxsize());
+    prut->_rep = &areprow;
+
+    /* UPDATE Usertable
+     * SET    field<field> = <value rnd>
+     * WHERE  ycsb_key = <key>
+     *
+     * plan: index probe on "YCSB_IDX"
+     */
+
+    // 1. Probe Usertable
+    TRACE( TRACE_TRX_FLOW, "App: %d UP:ut-idx-nl (%d)\n", _tid.get_lo(), _in._key);
+    W_DO(_penv->ut_man()->ut_idx_nl(_penv->db(), prut, _in._key));
+
+    char afield[STRSIZE(YCSB_FIELD_LEN)];
+    URandFillStrCaps(afield, YCSB_FIELD_LEN);
+    afield[YCSB_FIELD_LEN] = 0;
+    prut->set_value(_in._field+1, afield);
+
+    // 2. Update tuple
+    W_DO(_penv->ut_man()->update_tuple(_penv->db(), prut, NL));
+
+#ifdef PRINT_TRX_RESULTS
+    // dumps the status of all the table rows used
+    prut->print_tuple();
+#endif
+
+    return RCOK;
+}
+
+
+
+/********************************************************************
+ *
+ * DORA YCSB INSERT
+ *
+ ********************************************************************/
+
+void final_in_rvp::upd_committed_stats()
+{
+    _penv->_inc_insert_rec_att();
+    _penv->inc_trx_com();
+    ycsb_insert_done(_key, true);
+}
+
+void final_in_rvp::upd_aborted_stats()
+{
+    _penv->_inc_insert_rec_att();
+    _penv->_inc_insert_rec_failed();
+    _penv->inc_trx_att();
+    ycsb_insert_done(_key, false);
+}
+
+
+void ins_ut_in_action::calc_keys()
+{
+    _down.push_back(_in._key);
+}
+
+
+w_rc_t ins_ut_in_action::trx_exec()
+{
+    assert (_penv);
+
+    // get table tuple from the cache
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_penv->ut_man());
+    rep_row_t areprow(_penv->ut_man()->ts());
+    rep_row_t areprow_key(_penv->ut_man()->ts());
+    areprow.set(_penv->ut_desc()->maxsize());
+    areprow_key.set(_penv->ut_desc()->maxsize());
+    prut->_rep = &areprow;
+    prut->_rep_key = &areprow_key;
+
+    /* INSERT INTO Usertable
+     * VALUES (<key>, <field0 rnd>, ..., <field9 rnd>)
+     */
+
+    // 1. Insert tuple
+    prut->set_value(0, _in._key);
+
+    char afield[STRSIZE(YCSB_FIELD_LEN)];
+    afield[YCSB_FIELD_LEN] = 0;
+    for (int i=0; i<YCSB_FIELD_COUNT; i++) {
+        URandFillStrCaps(afield, YCSB_FIELD_LEN);
+        prut->set_value(i+1, afield);
+    }
+
+    TRACE( TRACE_TRX_FLOW, "App: %d IN:ut-add-tuple (%d)\n", _tid.get_lo(), _in._key);
+    W_DO(_penv->ut_man()->add_tuple(_penv->db(), prut, NL));
+
+#ifdef PRINT_TRX_RESULTS
+    // dumps the status of all the table rows used
+    prut->print_tuple();
+#endif
+
+    return RCOK;
+}
+
+
+
+/********************************************************************
+ *
+ * DORA YCSB SCAN
+ *
+ * @note: The whole range is locked in the partition of its start key,
+ *        as the TM1 GetSubNbr does. Ranges that straddle a partition
+ *        boundary are served by the partition of the first key.
+ *
+ ********************************************************************/
+
+DEFINE_DORA_FINAL_RVP_CLASS(final_sc_rvp,scan_rec);
+
+
+void r_ut_sc_action::calc_keys()
+{
+    // This is a read-only action
+    set_read_only();
+
+    // This action is not accessing a single key
+    set_is_range();
+
+    // Iterate the range of values and put an entry for each value
+    _key_list.reserve(_in._len);
+    int key;
+    for (int i=0; i<_in._len; i++) {
+        range_action_impl<int>::Key aKey;
+        key = _in._key + i;
+        aKey.push_back(key);
+        range_action_impl<int>::_key_list.push_back(aKey);
+    }
+}
+
+
+w_rc_t r_ut_sc_action::trx_exec()
+{
+    assert (_penv);
+
+    // get table tuple from the cache
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_penv->ut_man());
+    rep_row_t areprow(_penv->ut_man()->ts());
+    areprow.set(_penv->ut_desc()->maxsize());
+    prut->_rep = &areprow;
+    rep_row_t lowrep(_penv->ut_man()->ts());
+    rep_row_t highrep(_penv->ut_man()->ts());
+    lowrep.set(_penv->ut_desc()->maxsize());
+    highrep.set(_penv->ut_desc()->maxsize());
+
+    bool eof;
+    ycsb_rec_t arec;
+
+    /* SELECT *
+     * FROM   Usertable
+     * WHERE  ycsb_key >= <key>
+     * AND    ycsb_key <  <key> + <len>
+     *
+     * plan: iter on index "YCSB_IDX"
+     */
+
+    // 1. Index access to Usertable using key and len
+    guard<index_scan_iter_impl<usertable_t> > ut_iter;
+    {
+	index_scan_iter_impl<usertable_t>* tmp_ut_iter;
+	TRACE( TRACE_TRX_FLOW, "App: %d SC:ut-idx-iter (%d) (%d)\n",
+	       _tid.get_lo(), _in._key, _in._len);
+	W_DO(_penv->ut_man()->ut_get_idx_iter(_penv->db(), tmp_ut_iter, prut,
+                                              lowrep, highrep, _in._key,
+                                              _in._len, NL, true));
+	ut_iter = tmp_ut_iter;
+    }
+
+    // 2. Read all the returned records
+    W_DO(ut_iter->next(_penv->db(), eof, *prut));
+    while (!eof) {
+	prut->get_value(0, arec.YCSB_KEY);
+        for (int i=0; i<YCSB_FIELD_COUNT; i++)
+            prut->get_value(i+1, arec.FIELD[i], STRSIZE(YCSB_FIELD_LEN));
+	TRACE( TRACE_TRX_FLOW, "App: %d SC: read (%d)\n",
+	       _tid.get_lo(), arec.YCSB_KEY);
+	W_DO(ut_iter->next(_penv->db(), eof, *prut));
+    }
+
+    return RCOK;
+}
+
+
+
+/********************************************************************
+ *
+ * DORA YCSB READ-MODIFY-WRITE
+ *
+ ********************************************************************/
+
+DEFINE_DORA_FINAL_RVP_CLASS(final_rmw_rvp,rmw_rec);
+
+
+void upd_ut_rmw_action::calc_keys()
+{
+    _down.push_back(_in._key);
+}
+
+
+w_rc_t upd_ut_rmw_action::trx_exec()
+{
+    assert (_penv);
+
+    // get table tuple from the cache
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_penv->ut_man());
+    rep_row_t areprow(_penv->ut_man()->ts());
+    areprow.set(_penv->ut_desc()->maxsize());
+    prut->_rep = &areprow;
+
+    /* SELECT *
+     * FROM   Usertable
+     * WHERE  ycsb_key = <key>
+     *
+     * UPDATE Usertable
+     * SET    field<field> = <value rnd>
+     * WHERE  ycsb_key = <key>
+     *
+     * plan: index probe on "YCSB_IDX"
+     */
+
+    // 1. Probe Usertable
+    TRACE( TRACE_TRX_FLOW, "App: %d RMW:ut-idx-nl (%d)\n", _tid.get_lo(), _in._key);
+    W_DO(_penv->ut_man()->ut_idx_nl(_penv->db(), prut, _in._key));
+
+    ycsb_rec_t arec;
+    prut->get_value(0, arec.YCSB_KEY);
+    for (int i=0; i<YCSB_FIELD_COUNT; i++)
+        prut->get_value(i+1, arec.FIELD[i], STRSIZE(YCSB_FIELD_LEN));
+
+    // 2. Write back one of its fields
+    URandFillStrCaps(arec.FIELD[_in._field], YCSB_FIELD_LEN);
+    arec.FIELD[_in._field][YCSB_FIELD_LEN] = 0;
+    prut->set_value(_in._field+1, arec.FIELD[_in._field]);
+    W_DO(_penv->ut_man()->update_tuple(_penv->db(), prut, NL));
+
+#ifdef PRINT_TRX_RESULTS
+    // dumps the status of all the table rows used
+    prut->print_tuple();
+#endif
+
+    return RCOK;
+}
+
+
+
+EXIT_NAMESPACE(dora);
@@ -0,0 +1,378 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+/** @file:   dora_ycsb_xct.cpp
+ *
+ *  @brief:  Declaration of the DORA YCSB transactions
+ */
+
+#include "dora/ycsb/dora_ycsb_impl.h"
+#include "dora/ycsb/dora_ycsb.h"
+
+using namespace shore;
+using namespace ycsb;
+
+
+ENTER_NAMESPACE(dora);
+
+
+typedef partition_t<int>   irpImpl;
+
+
+/******** Exported functions  ********/
+
+
+/********
+ ******** Caution: The functions below should be invoked inside
+ ********          the context of a smthread
+ ********/
+
+
+/********************************************************************
+ *
+ * YCSB DORA TRXS
+ *
+ * (1) The dora_XXX functions are wrappers to the real transactions
+ * (2) The xct_dora_XXX functions are the implementation of the transactions
+ *
+ ********************************************************************/
+
+
+/********************************************************************
+ *
+ * YCSB DORA TRXs Wrappers
+ *
+ * @brief: They are wrappers to the functions that execute the transaction
+ *         body. Their responsibility is to:
+ *
+ *         1. Prepare the corresponding input
+ *         2. Check the return of the trx function and abort the trx,
+ *            if something went wrong
+ *         3. Update the ycsb db environment statistics
+ *
+ ********************************************************************/
+
+
+// --- without input specified --- //
+
+DEFINE_DORA_WITHOUT_INPUT_TRX_WRAPPER(DoraYCSBEnv,read_rec);
+DEFINE_DORA_WITHOUT_INPUT_TRX_WRAPPER(DoraYCSBEnv,update_rec);
+DEFINE_DORA_WITHOUT_INPUT_TRX_WRAPPER(DoraYCSBEnv,insert_rec);
+DEFINE_DORA_WITHOUT_INPUT_TRX_WRAPPER(DoraYCSBEnv,scan_rec);
+DEFINE_DORA_WITHOUT_INPUT_TRX_WRAPPER(DoraYCSBEnv,rmw_rec);
+
+
+
+// --- with input specified --- //
+
+/********************************************************************
+ *
+ * DORA YCSB READ
+ *
+ ********************************************************************/
+
+w_rc_t DoraYCSBEnv::dora_read_rec(const int xct_id,
+                                  trx_result_tuple_t& atrt,
+                                  read_rec_input_t& in,
+                                  const bool bWake)
+{
+    if(_start_imbalance > 0 && !_bAlarmSet) {
+	CRITICAL_SECTION(alarm_cs, _alarm_lock);
+	if(!_bAlarmSet) {
+	    alarm(_start_imbalance);
+	    _bAlarmSet = true;
+	}
+    }
+
+    // 1. Initiate transaction
+    tid_t atid;
+
+    W_DO(_pssm->begin_xct(atid));
+    TRACE( TRACE_TRX_FLOW, "Begin (%d)\n", atid.get_lo());
+
+    xct_t* pxct = smthread_t::me()->xct();
+
+    // 2. Detatch self from xct
+    assert (pxct);
+    smthread_t::me()->detach_xct(pxct);
+    TRACE( TRACE_TRX_FLOW, "Detached from (%d)\n", atid.get_lo());
+
+    // 3. Setup the final RVP
+    final_rd_rvp* frvp = new_final_rd_rvp(pxct,atid,xct_id,atrt);
+
+    // 4. Generate the action
+    r_ut_rd_action* r_ut = new_r_ut_rd_action(pxct,atid,frvp,in);
+
+    // 5a. Decide about partition
+    // 5b. Enqueue
+    {
+        irpImpl* my_ut_part = decide_part(ut(),in._key);
+        assert (my_ut_part);
+
+        // UT_PART_CS
+        CRITICAL_SECTION(ut_part_cs, my_ut_part->_enqueue_lock);
+        if (my_ut_part->enqueue(r_ut,bWake)) {
+            TRACE( TRACE_DEBUG, "Problem in enqueueing R_UT\n");
+            assert (0);
+            return (RC(de_PROBLEM_ENQUEUE));
+        }
+    }
+
+    return (RCOK);
+}
+
+
+/********************************************************************
+ *
+ * DORA YCSB UPDATE
+ *
+ ********************************************************************/
+
+w_rc_t DoraYCSBEnv::dora_update_rec(const int xct_id,
+                                    trx_result_tuple_t& atrt,
+                                    update_rec_input_t& in,
+                                    const bool bWake)
+{
+    if(_start_imbalance > 0 && !_bAlarmSet) {
+	CRITICAL_SECTION(alarm_cs, _alarm_lock);
+	if(!_bAlarmSet) {
+	    alarm(_start_imbalance);
+	    _bAlarmSet = true;
+	}
+    }
+
+    // 1. Initiate transaction
+    tid_t atid;
+
+    W_DO(_pssm->begin_xct(atid));
+    TRACE( TRACE_TRX_FLOW, "Begin (%d)\n", atid.get_lo());
+
+    xct_t* pxct = smthread_t::me()->xct();
+
+    // 2. Detatch self from xct
+    assert (pxct);
+    smthread_t::me()->detach_xct(pxct);
+    TRACE( TRACE_TRX_FLOW, "Detached from (%d)\n", atid.get_lo());
+
+    // 3. Setup the final RVP
+    final_up_rvp* frvp = new_final_up_rvp(pxct,atid,xct_id,atrt);
+
+    // 4. Generate the action
+    upd_ut_up_action* upd_ut = new_upd_ut_up_action(pxct,atid,frvp,in);
+
+    // 5a. Decide about partition
+    // 5b. Enqueue
+    {
+        irpImpl* my_ut_part = decide_part(ut(),in._key);
+        assert (my_ut_part);
+
+        // UT_PART_CS
+        CRITICAL_SECTION(ut_part_cs, my_ut_part->_enqueue_lock);
+        if (my_ut_part->enqueue(upd_ut,bWake)) {
+            TRACE( TRACE_DEBUG, "Problem in enqueueing UPD_UT\n");
+            assert (0);
+            return (RC(de_PROBLEM_ENQUEUE));
+        }
+    }
+
+    return (RCOK);
+}
+
+
+/********************************************************************
+ *
+ * DORA YCSB INSERT
+ *
+ ********************************************************************/
+
+w_rc_t DoraYCSBEnv::dora_insert_rec(const int xct_id,
+                                    trx_result_tuple_t& atrt,
+                                    insert_rec_input_t& in,
+                                    const bool bWake)
+{
+    if(_start_imbalance > 0 && !_bAlarmSet) {
+	CRITICAL_SECTION(alarm_cs, _alarm_lock);
+	if(!_bAlarmSet) {
+	    alarm(_start_imbalance);
+	    _bAlarmSet = true;
+	}
+    }
+
+    // 1. Initiate transaction
+    tid_t atid;
+
+    w_rc_t e = _pssm->begin_xct(atid);
+    if (e.is_error()) {
+        // the key goes to the next insert
+        ycsb_insert_done(in._key, false);
+        return (e);
+    }
+    TRACE( TRACE_TRX_FLOW, "Begin (%d)\n", atid.get_lo());
+
+    xct_t* pxct = smthread_t::me()->xct();
+
+    // 2. Detatch self from xct
+    assert (pxct);
+    smthread_t::me()->detach_xct(pxct);
+    TRACE( TRACE_TRX_FLOW, "Detached from (%d)\n", atid.get_lo());
+
+    // 3. Setup the final RVP
+    final_in_rvp* frvp = new_final_in_rvp(pxct,atid,xct_id,atrt);
+    frvp->set_key(in._key);
+
+    // 4. Generate the action
+    ins_ut_in_action* ins_ut = new_ins_ut_in_action(pxct,atid,frvp,in);
+
+    // 5a. Decide about partition
+    // 5b. Enqueue
+    {
+        irpImpl* my_ut_part = decide_part(ut(),in._key);
+        assert (my_ut_part);
+
+        // UT_PART_CS
+        CRITICAL_SECTION(ut_part_cs, my_ut_part->_enqueue_lock);
+        if (my_ut_part->enqueue(ins_ut,bWake)) {
+            TRACE( TRACE_DEBUG, "Problem in enqueueing INS_UT\n");
+            assert (0);
+            return (RC(de_PROBLEM_ENQUEUE));
+        }
+    }
+
+    return (RCOK);
+}
+
+
+/********************************************************************
+ *
+ * DORA YCSB SCAN
+ *
+ ********************************************************************/
+
+w_rc_t DoraYCSBEnv::dora_scan_rec(const int xct_id,
+                                  trx_result_tuple_t& atrt,
+                                  scan_rec_input_t& in,
+                                  const bool bWake)
+{
+    if(_start_imbalance > 0 && !_bAlarmSet) {
+	CRITICAL_SECTION(alarm_cs, _alarm_lock);
+	if(!_bAlarmSet) {
+	    alarm(_start_imbalance);
+	    _bAlarmSet = true;
+	}
+    }
+
+    // 1. Initiate transaction
+    tid_t atid;
+
+    W_DO(_pssm->begin_xct(atid));
+    TRACE( TRACE_TRX_FLOW, "Begin (%d)\n", atid.get_lo());
+
+    xct_t* pxct = smthread_t::me()->xct();
+
+    // 2. Detatch self from xct
+    assert (pxct);
+    smthread_t::me()->detach_xct(pxct);
+    TRACE( TRACE_TRX_FLOW, "Detached from (%d)\n", atid.get_lo());
+
+    // 3. Setup the final RVP
+    final_sc_rvp* frvp = new_final_sc_rvp(pxct,atid,xct_id,atrt);
+
+    // 4. Generate the action
+    r_ut_sc_action* r_ut = new_r_ut_sc_action(pxct,atid,frvp,in);
+
+    // 5a. Decide about partition
+    // 5b. Enqueue
+    {
+        irpImpl* my_ut_part = decide_part(ut(),in._key);
+        assert (my_ut_part);
+
+        // UT_PART_CS
+        CRITICAL_SECTION(ut_part_cs, my_ut_part->_enqueue_lock);
+        if (my_ut_part->enqueue(r_ut,bWake)) {
+            TRACE( TRACE_DEBUG, "Problem in enqueueing R_UT\n");
+            assert (0);
+            return (RC(de_PROBLEM_ENQUEUE));
+        }
+    }
+
+    return (RCOK);
+}
+
+
+/********************************************************************
+ *
+ * DORA YCSB READ-MODIFY-WRITE
+ *
+ ********************************************************************/
+
+w_rc_t DoraYCSBEnv::dora_rmw_rec(const int xct_id,
+                                 trx_result_tuple_t& atrt,
+                                 rmw_rec_input_t& in,
+                                 const bool bWake)
+{
+    if(_start_imbalance > 0 && !_bAlarmSet) {
+	CRITICAL_SECTION(alarm_cs, _alarm_lock);
+	if(!_bAlarmSet) {
+	    alarm(_start_imbalance);
+	    _bAlarmSet = true;
+	}
+    }
+
+    // 1. Initiate transaction
+    tid_t atid;
+
+    W_DO(_pssm->begin_xct(atid));
+    TRACE( TRACE_TRX_FLOW, "Begin (%d)\n", atid.get_lo());
+
+    xct_t* pxct = smthread_t::me()->xct();
+
+    // 2. Detatch self from xct
+    assert (pxct);
+    smthread_t::me()->detach_xct(pxct);
+    TRACE( TRACE_TRX_FLOW, "Detached from (%d)\n", atid.get_lo());
+
+    // 3. Setup the final RVP
+    final_rmw_rvp* frvp = new_final_rmw_rvp(pxct,atid,xct_id,atrt);
+
+    // 4. Generate the action
+    upd_ut_rmw_action* upd_ut = new_upd_ut_rmw_action(pxct,atid,frvp,in);
+
+    // 5a. Decide about partition
+    // 5b. Enqueue
+    {
+        irpImpl* my_ut_part = decide_part(ut(),in._key);
+        assert (my_ut_part);
+
+        // UT_PART_CS
+        CRITICAL_SECTION(ut_part_cs, my_ut_part->_enqueue_lock);
+        if (my_ut_part->enqueue(upd_ut,bWake)) {
+            TRACE( TRACE_DEBUG, "Problem in enqueueing UPD_UT\n");
+            assert (0);
+            return (RC(de_PROBLEM_ENQUEUE));
+        }
+    }
+
+    return (RCOK);
+}
+
+
+EXIT_NAMESPACE(dora);
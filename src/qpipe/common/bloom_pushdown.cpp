@@ -0,0 +1,98 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   bloom_pushdown.cpp
+ *
+ *  @brief:  Implementation of the Bloom filter pushdown
+ */
+
+#include "qpipe/common/bloom_pushdown.h"
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+static bool bloom_pushdown_switch = true;
+
+bool bloom_pushdown_enabled()
+{
+    return (bloom_pushdown_switch);
+}
+
+void set_bloom_pushdown(bool enabled)
+{
+    bloom_pushdown_switch = enabled;
+}
+
+
+
+bloom_pushdown_filter_t::bloom_pushdown_filter_t(tuple_filter_t* base,
+                                                 bloom_filter_t* bloom,
+                                                 size_t out_size,
+                                                 size_t key_offset,
+                                                 size_t key_size,
+                                                 query_memory_t* memory)
+    : tuple_filter_t(base->input_tuple_size()),
+      _base(base), _bloom(bloom), _memory(memory), _query(memory),
+      _out_size(out_size), _key_offset(key_offset), _key_size(key_size),
+      _scratch(new char[out_size]),
+      _checked(0), _dropped(0)
+{
+    assert(_key_offset + _key_size <= _out_size);
+    _memory.grow(_bloom->size_bytes(), true);
+}
+
+
+bloom_pushdown_filter_t::bloom_pushdown_filter_t(bloom_pushdown_filter_t const &other)
+    : tuple_filter_t(other),
+      _base(other._base), _bloom(new bloom_filter_t(*other._bloom)),
+      _memory(other._query), _query(other._query),
+      _out_size(other._out_size), _key_offset(other._key_offset),
+      _key_size(other._key_size),
+      _scratch(new char[other._out_size]),
+      _checked(0), _dropped(0)
+{
+    _memory.grow(_bloom->size_bytes(), true);
+}
+
+
+bloom_pushdown_filter_t::~bloom_pushdown_filter_t()
+{
+    TRACE(TRACE_STATISTICS,
+          "Bloom pushdown: %lu keys, %lu bytes, dropped %lu of %lu tuples\n",
+          (unsigned long)_bloom->inserted(), (unsigned long)_bloom->size_bytes(),
+          (unsigned long)_dropped, (unsigned long)_checked);
+    delete [] _scratch;
+    delete (_bloom);
+}
+
+
+c_str bloom_pushdown_filter_t::to_string() const
+{
+    return (c_str("BLOOM(%08x:%lu:%lu)&%s", _bloom->signature(),
+                  (unsigned long)_key_offset, (unsigned long)_key_size,
+                  _base->to_string().data()));
+}
+
+
+EXIT_NAMESPACE(qpipe);
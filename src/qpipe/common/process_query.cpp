@@ -23,6 +23,7 @@
 
 #include "qpipe/core/tuple_fifo.h"
 #include "qpipe/core/dispatcher.h"
+#include "qpipe/core/query_profile.h"
 #include "qpipe/common/process_query.h"
 #include "util.h"
 
@@ -33,9 +34,20 @@ void process_query(packet_t* root, process_tuple_t& pt)
 {
     guard<tuple_fifo> out = root->output_buffer();
     
-    dispatcher_t::worker_reserver_t* wr = dispatcher_t::reserver_acquire();
+    /* charge the query's memory account, if it has one */
+    query_state_t* qs = root->get_query_state();
+    dispatcher_t::worker_reserver_t* wr =
+        dispatcher_t::reserver_acquire(qs? qs->memory() : NULL);
 
-    /* reserve worker threads and dispatch... */
+    /* The stages report to the profile until they are done with the
+       query; the last one to let go prints it. */
+    query_profile_t* profile = NULL;
+    if (query_profiling_enabled()) {
+        profile = new query_profile_t(root->_packet_id, qs? qs->memory() : NULL);
+        profile->attach(root);
+    }
+
+    /* admit the query, reserve worker threads and dispatch... */
     root->declare_worker_needs(wr);
     wr->acquire_resources();
     dispatcher_t::dispatch_packet(root);
@@ -47,7 +59,16 @@ void process_query(packet_t* root, process_tuple_t& pt)
         pt.process(output);
     pt.end();
 
+    if (profile != NULL) {
+        profile->finish();
+        /* the root's output buffer reports when it goes away */
+        out.done();
+    }
+
     dispatcher_t::reserver_release(wr);
+
+    if (profile != NULL)
+        profile->release_ref();
 }
 
 
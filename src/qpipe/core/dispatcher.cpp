@@ -143,9 +143,9 @@ void dispatcher_t::_unreserve_workers(const c_str& type, int n)
 
 
 
-dispatcher_t::worker_reserver_t* dispatcher_t::reserver_acquire() 
+dispatcher_t::worker_reserver_t* dispatcher_t::reserver_acquire(query_memory_t* memory) 
 {
-  return new worker_reserver_t(instance());
+  return new worker_reserver_t(instance(), memory);
 }
 
 
@@ -170,8 +170,15 @@ void dispatcher_t::releaser_release(worker_releaser_t* wr)
 
 
 
+/**
+ *  @brief Admit the query against the global memory budget (this may
+ *  block until enough memory is free) and then reserve its workers.
+ */
 void dispatcher_t::worker_reserver_t::acquire_resources() 
 {  
+  if (_memory != NULL)
+      memory_manager_t::admit(_memory, _memory_needs);
+
   map<c_str, int>::iterator it;
   for (it = _worker_needs.begin(); it != _worker_needs.end(); ++it) {
     int n = it->second;
@@ -184,6 +191,20 @@ void dispatcher_t::worker_reserver_t::acquire_resources()
 
 
 
+/**
+ *  @brief Give the memory reservation of the query back once it is
+ *  done and report what it actually used.
+ */
+dispatcher_t::worker_reserver_t::~worker_reserver_t() 
+{
+  if (_memory != NULL) {
+      memory_manager_t::release(_memory);
+      _memory->trace_stats("Query");
+  }
+}
+
+
+
 /* wrapper which we can use inside packet.h */
 bool is_osp_enabled_for_type(const c_str& packet_type)
 {
@@ -0,0 +1,276 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   memory_manager.cpp
+ *
+ *  @brief:  Implementation of the QPipe memory budget
+ */
+
+#include "qpipe/core/memory_manager.h"
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+static const double MB = 1024.0 * 1024.0;
+
+
+
+/********************************************************************
+ *
+ *  @class: query_memory_t
+ *
+ ********************************************************************/
+
+query_memory_t::query_memory_t()
+    : _manager(&memory_manager_t::_instance), _refs(1),
+      _declared(0), _reserved(0), _used(0), _peak(0),
+      _grants(0), _denied(0), _spills(0), _admitted(false)
+{
+}
+
+
+void query_memory_t::acquire_ref()
+{
+    atomic_inc_uint(&_refs);
+}
+
+
+void query_memory_t::release_ref()
+{
+    if (atomic_dec_uint_nv(&_refs) == 0) {
+        /* nobody is left to give memory back */
+        assert(_used == 0);
+        assert(!_admitted);
+        delete (this);
+    }
+}
+
+
+bool query_memory_t::grant(size_t bytes, bool force)
+{
+    return (_manager->_grant(this, bytes, force));
+}
+
+
+void query_memory_t::release(size_t bytes)
+{
+    _manager->_release(this, bytes);
+}
+
+
+void query_memory_t::note_spill()
+{
+    critical_section_t cs(_manager->_lock);
+    _spills++;
+}
+
+
+void query_memory_t::trace_stats(const char* label) const
+{
+    TRACE(TRACE_STATISTICS,
+          "%s memory: declared %.2f MB, reserved %.2f MB, peak %.2f MB, "
+          "in use %.2f MB, grants %lu, denied %lu, spills %lu\n",
+          label, _declared/MB, _reserved/MB, _peak/MB, _used/MB,
+          (unsigned long)_grants, (unsigned long)_denied,
+          (unsigned long)_spills);
+}
+
+
+
+/********************************************************************
+ *
+ *  @class: memory_manager_t
+ *
+ ********************************************************************/
+
+memory_manager_t memory_manager_t::_instance;
+
+
+memory_manager_t::memory_manager_t()
+    : _lock(thread_mutex_create()), _admission(thread_cond_create()),
+      _budget(0), _reserved(0), _overflow(0), _peak(0),
+      _next_ticket(0), _now_serving(0), _queued(0)
+{
+}
+
+
+memory_manager_t::~memory_manager_t()
+{
+    thread_cond_destroy(_admission);
+    thread_mutex_destroy(_lock);
+}
+
+
+void memory_manager_t::set_budget(size_t bytes)
+{
+    critical_section_t cs(_instance._lock);
+    _instance._budget = bytes;
+    /* queued queries may fit now */
+    thread_cond_broadcast(_instance._admission);
+    TRACE(TRACE_ALWAYS, "QPipe memory budget: %.2f MB%s\n",
+          bytes/MB, (bytes? "" : " (unlimited)"));
+}
+
+
+size_t memory_manager_t::budget()
+{
+    return (_instance._budget);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    admit
+ *
+ *  @brief: Blocks until the query can reserve its declared needs.
+ *          Queries are admitted strictly in arrival order.
+ *
+ ********************************************************************/
+
+void memory_manager_t::admit(query_memory_t* memory, size_t declared)
+{
+    assert(memory);
+    memory_manager_t* mm = &_instance;
+    critical_section_t cs(mm->_lock);
+    assert(!memory->_admitted);
+
+    unsigned ticket = mm->_next_ticket++;
+    size_t need = declared;
+    bool waited = false;
+    while (true) {
+        if (mm->_budget && (need > mm->_budget))
+            need = mm->_budget;
+        if ((ticket == mm->_now_serving) && mm->_fits(need))
+            break;
+        if (!waited) {
+            mm->_queued++;
+            waited = true;
+            TRACE(TRACE_DEBUG, "Query queued for %.2f MB (%d waiting)\n",
+                  need/MB, mm->_queued);
+        }
+        thread_cond_wait(mm->_admission, mm->_lock);
+    }
+    if (waited)
+        mm->_queued--;
+    mm->_now_serving++;
+
+    /* usage that is now covered by the reservation is no longer
+       overflow */
+    size_t over = _over(memory->_used, 0);
+    mm->_overflow -= over - _over(memory->_used, need);
+    mm->_reserved += need;
+
+    memory->_declared = declared;
+    memory->_reserved = need;
+    memory->_admitted = true;
+
+    /* let the next query in line check whether it fits too */
+    thread_cond_broadcast(mm->_admission);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    release
+ *
+ *  @brief: Returns the reservation of a finished query. Memory that
+ *          its consumers still hold counts as overflow until they
+ *          give it back.
+ *
+ ********************************************************************/
+
+void memory_manager_t::release(query_memory_t* memory)
+{
+    assert(memory);
+    memory_manager_t* mm = &_instance;
+    critical_section_t cs(mm->_lock);
+    if (!memory->_admitted)
+        return;
+
+    size_t reserved = memory->_reserved;
+    mm->_overflow += _over(memory->_used, 0) - _over(memory->_used, reserved);
+    mm->_reserved -= reserved;
+    memory->_reserved = 0;
+    memory->_admitted = false;
+
+    thread_cond_broadcast(mm->_admission);
+}
+
+
+bool memory_manager_t::_grant(query_memory_t* memory, size_t bytes, bool force)
+{
+    critical_section_t cs(_lock);
+
+    size_t used = memory->_used + bytes;
+    size_t extra = _over(used, memory->_reserved)
+        - _over(memory->_used, memory->_reserved);
+    if (!force && extra && !_fits(extra)) {
+        memory->_denied++;
+        return (false);
+    }
+
+    memory->_used = used;
+    memory->_grants++;
+    if (used > memory->_peak)
+        memory->_peak = used;
+
+    _overflow += extra;
+    if (_reserved + _overflow > _peak)
+        _peak = _reserved + _overflow;
+    return (true);
+}
+
+
+void memory_manager_t::_release(query_memory_t* memory, size_t bytes)
+{
+    critical_section_t cs(_lock);
+
+    assert(bytes <= memory->_used);
+    size_t used = memory->_used - bytes;
+    size_t freed = _over(memory->_used, memory->_reserved)
+        - _over(used, memory->_reserved);
+    memory->_used = used;
+    _overflow -= freed;
+
+    /* borrowed memory came back, queued queries may fit now */
+    if (freed && _queued)
+        thread_cond_broadcast(_admission);
+}
+
+
+void memory_manager_t::trace_stats()
+{
+    memory_manager_t* mm = &_instance;
+    critical_section_t cs(mm->_lock);
+    TRACE(TRACE_ALWAYS,
+          "QPipe memory: budget %.2f MB, reserved %.2f MB, "
+          "overflow %.2f MB, peak %.2f MB, %d queries queued\n",
+          mm->_budget/MB, mm->_reserved/MB, mm->_overflow/MB,
+          mm->_peak/MB, mm->_queued);
+}
+
+
+EXIT_NAMESPACE(qpipe);
@@ -23,6 +23,7 @@
 
 #include "qpipe/core/packet.h"
 #include "qpipe/core/stage_container.h"
+#include "qpipe/core/query_profile.h"
 #include "util.h"
 #include "util/thread.h"
 
@@ -77,6 +78,7 @@ packet_t::packet_t(const c_str    &packet_id,
       _packet_type(packet_type),
       _output_buffer(output_buffer),
       _output_filter(output_filter),
+      _profile(NULL),
       _next_tuple_on_merge(stage_container_t::NEXT_TUPLE_UNINITIALIZED),
       _next_tuple_needed  (stage_container_t::NEXT_TUPLE_INITIAL_VALUE)
 {
@@ -92,6 +94,49 @@ packet_t::packet_t(const c_str    &packet_id,
 
 
 
+/**
+ *  @brief Make (filter) our output filter. The new filter must apply
+ *  the current output filter itself, and we take ownership of it.
+ *  Must be called before the packet is dispatched.
+ *
+ *  The pushed filter becomes part of our plan, so we only merge with
+ *  packets that had an identical filter pushed into them.
+ */
+void packet_t::push_down_filter(tuple_filter_t* filter) {
+    assert(accepts_pushdown());
+    assert(filter != NULL);
+
+    _pushed_filter = filter;
+    _output_filter = filter;
+    if (_plan != NULL) {
+        c_str desc = filter->to_string();
+        _plan->action = c_str("%s|%s", _plan->action.data(), desc.data());
+        _plan->filter = desc;
+    }
+    TRACE(TRACE_PACKET_FLOW, "Pushed filter into %s packet with ID %s\n",
+	  _packet_type.data(),
+	  _packet_id.data());
+}
+
+
+
+/**
+ *  @brief Record what this packet does in (profile). The output
+ *  buffer reports to the same node. Must be called before the packet
+ *  is dispatched.
+ */
+void packet_t::set_profile(packet_profile_t* profile) {
+    assert(_profile == NULL);
+    assert(profile != NULL);
+
+    _profile = profile;
+    _profile->_query->acquire_ref();
+    if (_output_buffer)
+        _output_buffer->set_profile(profile);
+}
+
+
+
 /**
  *  @brief packet_t destructor.
  */
@@ -101,6 +146,12 @@ packet_t::~packet_t(void) {
     TRACE(TRACE_PACKET_FLOW, "Destroying %s packet with ID %s\n",
 	  _packet_type.data(),
 	  _packet_id.data());
+
+    if (_profile != NULL) {
+        /* our plan may have changed (pushdown) since we were profiled */
+        query_profile_t::record_plan(_profile, _plan);
+        _profile->_query->release_ref();
+    }
 }
 
 
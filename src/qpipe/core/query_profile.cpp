@@ -0,0 +1,397 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   query_profile.cpp
+ *
+ *  @brief:  Implementation of the QPipe query profile
+ */
+
+#include "qpipe/core/query_profile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <time.h>
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+/* longest plan action we print before cutting it short */
+static const size_t MAX_ACTION = 60;
+
+static const double MB = 1024.0 * 1024.0;
+
+
+
+/********************************************************************
+ *
+ *  @struct: packet_profile_t
+ *
+ ********************************************************************/
+
+packet_profile_t::packet_profile_t(query_profile_t* query, packet_t* packet)
+    : _query(query),
+      _packet_id(packet->_packet_id), _packet_type(packet->_packet_type),
+      _action(packet->plan()? packet->plan()->action : c_str("")),
+      _plan(packet->plan()), _has_parent(false),
+      _runs(0), _wall_us(0), _cpu_us(0), _merged(false),
+      _tuples_out(0), _pages_out(0), _spill_bytes(0), _blocked_out_us(0),
+      _consumer_wait_us(0)
+{
+}
+
+
+
+/********************************************************************
+ *
+ *  @class: query_profile_t
+ *
+ ********************************************************************/
+
+query_profile_t::query_profile_t(const c_str &name, query_memory_t* memory)
+    : _lock(thread_mutex_create()), _refs(1),
+      _name(name), _memory(memory), _wall_us(0)
+{
+    if (_memory != NULL)
+        _memory->acquire_ref();
+}
+
+
+query_profile_t::~query_profile_t()
+{
+    for (size_t i = 0; i < _packets.size(); i++)
+        delete (_packets[i]);
+    if (_memory != NULL)
+        _memory->release_ref();
+    thread_mutex_destroy(_lock);
+}
+
+
+void query_profile_t::acquire_ref()
+{
+    atomic_inc_uint(&_refs);
+}
+
+
+/**
+ *  @brief The last reference belongs to whoever touched the query
+ *  last, so by now every stage has finished and every tuple_fifo of
+ *  the query is gone. Publish the profile and delete it.
+ */
+void query_profile_t::release_ref()
+{
+    if (atomic_dec_uint_nv(&_refs) > 0)
+        return;
+
+    std::string tree = render();
+    TRACE(TRACE_ALWAYS, "\n%s", tree.c_str());
+    set_last_query_profile(tree);
+    delete (this);
+}
+
+
+
+/**
+ *  @brief Collects the packets of a plan.
+ */
+struct profile_attacher_t : public packet_declare_t
+{
+    std::vector<packet_t*> _packets;
+
+    virtual void declare_packet(packet_t* packet) {
+        _packets.push_back(packet);
+    }
+};
+
+
+void query_profile_t::attach(packet_t* root)
+{
+    profile_attacher_t walker;
+    root->declare_worker_needs(&walker);
+
+    critical_section_t cs(_lock);
+    std::map<packet_t*, packet_profile_t*> by_packet;
+    std::map<query_plan const*, packet_profile_t*> by_plan;
+    for (size_t i = 0; i < walker._packets.size(); i++) {
+        packet_t* packet = walker._packets[i];
+        if ((packet->profile() != NULL) || by_packet.count(packet))
+            /* already profiled */
+            continue;
+        packet_profile_t* p = new packet_profile_t(this, packet);
+        _packets.push_back(p);
+        by_packet[packet] = p;
+        if (p->_plan != NULL)
+            by_plan[p->_plan] = p;
+    }
+
+    /* A packet's plan points at the plans of its inputs */
+    for (size_t i = 0; i < _packets.size(); i++) {
+        packet_profile_t* p = _packets[i];
+        if (p->_plan == NULL)
+            continue;
+        for (int c = 0; c < p->_plan->child_count; c++) {
+            std::map<query_plan const*, packet_profile_t*>::iterator it =
+                by_plan.find(p->_plan->child_plans[c]);
+            if ((it == by_plan.end()) || it->second->_has_parent)
+                continue;
+            p->_children.push_back(it->second);
+            it->second->_has_parent = true;
+        }
+    }
+
+    /* plans belong to the packets, which may be gone when we render */
+    for (size_t i = 0; i < _packets.size(); i++)
+        _packets[i]->_plan = NULL;
+    cs.exit();
+
+    /* takes references, so do it outside the lock */
+    std::map<packet_t*, packet_profile_t*>::iterator it;
+    for (it = by_packet.begin(); it != by_packet.end(); ++it)
+        it->first->set_profile(it->second);
+    _timer.reset();
+}
+
+
+void query_profile_t::finish()
+{
+    critical_section_t cs(_lock);
+    _wall_us = _timer.time_us();
+}
+
+
+
+/**
+ *  @brief Renders one line per packet, indented under its consumer:
+ *
+ *  TYPE [action] wall/cpu, tuples in/out, pages, blocked in/out, spills
+ *
+ *  Tuples in and time blocked on input are what the inputs' fifos saw
+ *  from the other side. Merged packets show their host instead of
+ *  stage times since the host did the work.
+ */
+std::string query_profile_t::render()
+{
+    critical_section_t cs(_lock);
+
+    std::string out;
+    out += c_str("Profile of %s: %.3f ms", _name.data(), _wall_us/1e3).data();
+    if (_memory != NULL)
+        out += c_str(", peak memory %.2f MB", _memory->peak()/MB).data();
+    out += "\n";
+
+    for (size_t i = 0; i < _packets.size(); i++)
+        if (!_packets[i]->_has_parent)
+            _render(out, _packets[i], 1);
+    return (out);
+}
+
+
+void query_profile_t::_render(std::string &out, packet_profile_t* p, int depth)
+{
+    size_t tuples_in = 0;
+    long long blocked_in_us = 0;
+    for (size_t i = 0; i < p->_children.size(); i++) {
+        tuples_in     += p->_children[i]->_tuples_out;
+        blocked_in_us += p->_children[i]->_consumer_wait_us;
+    }
+
+    std::string action(p->_action.data());
+    if (action.size() > MAX_ACTION)
+        action = action.substr(0, MAX_ACTION - 3) + "...";
+
+    out += std::string(2*depth, ' ');
+    out += c_str("%s [%s]", p->_packet_type.data(), action.c_str()).data();
+    if (p->_merged)
+        out += c_str(" merged into %s", p->_merged_into.data()).data();
+    else
+        out += c_str(" wall %.3f ms, cpu %.3f ms",
+                     p->_wall_us/1e3, p->_cpu_us/1e3).data();
+    out += c_str(", tuples in %lu out %lu, pages %lu, "
+                 "blocked in %.3f ms out %.3f ms",
+                 (unsigned long)tuples_in, (unsigned long)p->_tuples_out,
+                 (unsigned long)p->_pages_out,
+                 blocked_in_us/1e3, p->_blocked_out_us/1e3).data();
+    if (p->_spill_bytes > 0)
+        out += c_str(", spilled %.2f MB", p->_spill_bytes/MB).data();
+    out += "\n";
+
+    for (size_t i = 0; i < p->_children.size(); i++)
+        _render(out, p->_children[i], depth+1);
+}
+
+
+void query_profile_t::record_stage(packet_profile_t* p, long long wall_us,
+                                   long long cpu_us)
+{
+    critical_section_t cs(p->_query->_lock);
+    p->_runs++;
+    p->_wall_us += wall_us;
+    p->_cpu_us  += cpu_us;
+}
+
+
+void query_profile_t::record_merge(packet_profile_t* p, const c_str &host_id)
+{
+    critical_section_t cs(p->_query->_lock);
+    p->_merged = true;
+    p->_merged_into = host_id;
+}
+
+
+void query_profile_t::record_plan(packet_profile_t* p, query_plan const* plan)
+{
+    if (plan == NULL)
+        return;
+    critical_section_t cs(p->_query->_lock);
+    p->_action = plan->action;
+}
+
+
+void query_profile_t::record_output(packet_profile_t* p, size_t tuples,
+                                    size_t pages, size_t spill_bytes,
+                                    long long blocked_us)
+{
+    critical_section_t cs(p->_query->_lock);
+    p->_tuples_out     += tuples;
+    p->_pages_out      += pages;
+    p->_spill_bytes    += spill_bytes;
+    p->_blocked_out_us += blocked_us;
+}
+
+
+void query_profile_t::record_consumer_wait(packet_profile_t* p, long long wait_us)
+{
+    critical_section_t cs(p->_query->_lock);
+    p->_consumer_wait_us += wait_us;
+}
+
+
+long long query_profile_t::thread_cpu_us()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return (ts.tv_sec*1000000ll + ts.tv_nsec/1000);
+#endif
+    return (0);
+}
+
+
+
+/********************************************************************
+ *
+ *  Global switch and the last profile
+ *
+ ********************************************************************/
+
+static bool query_profiling_switch = false;
+static pthread_mutex_t last_profile_mutex = thread_mutex_create();
+static std::string last_profile;
+
+
+bool query_profiling_enabled()
+{
+    return (query_profiling_switch);
+}
+
+void set_query_profiling(bool enabled)
+{
+    query_profiling_switch = enabled;
+}
+
+
+std::string last_query_profile()
+{
+    critical_section_t cs(last_profile_mutex);
+    return (last_profile);
+}
+
+void set_last_query_profile(const std::string &profile)
+{
+    critical_section_t cs(last_profile_mutex);
+    last_profile = profile;
+}
+
+
+
+/*********************************************************************
+ *
+ *  "profile" command
+ *
+ *********************************************************************/
+
+void qprofile_cmd_t::setaliases()
+{
+    _name = string("profile");
+    _aliases.push_back("profile");
+}
+
+int qprofile_cmd_t::handle(const char* cmd)
+{
+    char cmd_tag[SERVER_COMMAND_BUFFER_SIZE];
+    char what[SERVER_COMMAND_BUFFER_SIZE] = "last";
+
+    if ( sscanf(cmd, "%s %s", cmd_tag, what) < 1) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    if (strcasecmp(what, "on") == 0) {
+        set_query_profiling(true);
+        TRACE( TRACE_ALWAYS, "Profiling QPipe queries\n");
+    }
+    else if (strcasecmp(what, "off") == 0) {
+        set_query_profiling(false);
+        TRACE( TRACE_ALWAYS, "Not profiling QPipe queries\n");
+    }
+    else if (strcasecmp(what, "last") == 0) {
+        std::string tree = last_query_profile();
+        if (tree.empty())
+            TRACE( TRACE_ALWAYS, "No query was profiled (try \"profile on\")\n");
+        else
+            TRACE( TRACE_ALWAYS, "\n%s", tree.c_str());
+    }
+    else
+        usage();
+
+    return (SHELL_NEXT_CONTINUE);
+}
+
+void qprofile_cmd_t::usage(void)
+{
+    TRACE( TRACE_ALWAYS, "PROFILE Usage:\n\n"                              \
+           "*** profile [on|off|last]\n"                                  \
+           "\nParameters:\n"                                              \
+           "on   - Profile every following QPipe query\n"                 \
+           "off  - Stop profiling\n"                                      \
+           "last - Print the plan of the last profiled query (default)\n\n");
+}
+
+string qprofile_cmd_t::desc() const
+{
+    return (string("Per-stage execution profile of QPipe queries"));
+}
+
+
+EXIT_NAMESPACE(qpipe);
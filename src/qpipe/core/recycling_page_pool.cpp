@@ -0,0 +1,330 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   recycling_page_pool.cpp
+ *
+ *  @brief:  Implementation of the recycling, NUMA-aware page pool
+ */
+
+#include "qpipe/core/recycling_page_pool.h"
+#include "util.h"
+
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#endif
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+/* The header sits in front of every page handed out by the pool. It
+   is a full cache line so that the page itself stays aligned. */
+static const size_t BLOCK_HDR_SIZE = 64;
+
+struct recycling_page_pool::block_hdr_t {
+    block_hdr_t* _next;
+    int          _node;
+};
+
+static inline recycling_page_pool::block_hdr_t* hdr_of(void* page) {
+    return ((recycling_page_pool::block_hdr_t*)((char*)page - BLOCK_HDR_SIZE));
+}
+
+static inline void* page_of(recycling_page_pool::block_hdr_t* hdr) {
+    return ((char*)hdr + BLOCK_HDR_SIZE);
+}
+
+
+
+/* Per-thread cache of free pages. Only pages from the node the
+   thread last ran on are kept, the rest go to the global lists. */
+struct thread_cache_t {
+    recycling_page_pool*              _pool;
+    recycling_page_pool::block_hdr_t* _head;
+    size_t                            _count;
+    int                               _node;
+};
+
+extern "C" void recycling_page_pool_thread_exit(void* cache) {
+    thread_cache_t* tc = (thread_cache_t*)cache;
+    tc->_pool->flush_thread_cache(tc);
+    delete (tc);
+}
+
+
+
+recycling_page_pool recycling_page_pool::_instance;
+
+
+
+recycling_page_pool::recycling_page_pool(size_t page_size,
+                                         size_t thread_cache_pages,
+                                         size_t max_free_pages)
+    : page_pool(page_size),
+      _num_nodes(1),
+      _thread_cache_pages(thread_cache_pages),
+      _max_free_pages(max_free_pages),
+      _pages_allocated(0),
+      _pages_in_use(0),
+      _pages_high_water(0)
+{
+#ifdef HAVE_LIBNUMA
+    if (numa_available() >= 0)
+        _num_nodes = numa_max_node() + 1;
+    if (_num_nodes > MAX_NODES)
+        _num_nodes = MAX_NODES;
+#endif
+    for (int i=0; i<MAX_NODES; i++) {
+        _nodes[i]._lock  = thread_mutex_create();
+        _nodes[i]._head  = NULL;
+        _nodes[i]._count = 0;
+    }
+    int err = pthread_key_create(&_cache_key, recycling_page_pool_thread_exit);
+    THROW_IF(ThreadException, err);
+}
+
+
+
+recycling_page_pool::~recycling_page_pool()
+{
+    /* Only the global lists can be released here; pages still cached
+       by live threads are returned when those threads exit. */
+    for (int i=0; i<_num_nodes; i++) {
+        block_hdr_t* hdr = _nodes[i]._head;
+        while (hdr) {
+            block_hdr_t* next = hdr->_next;
+            _release(hdr);
+            hdr = next;
+        }
+        _nodes[i]._head = NULL;
+        _nodes[i]._count = 0;
+    }
+}
+
+
+
+/******************************************************************** 
+ *
+ *  @fn:    alloc{_on_node}
+ *
+ *  @brief: Returns a page from (in this order) the thread cache, the
+ *          global list of the node, or freshly allocated memory on
+ *          the node.
+ *
+ ********************************************************************/
+
+void* recycling_page_pool::alloc()
+{
+    return (alloc_on_node(page_pool_current_node()));
+}
+
+void* recycling_page_pool::alloc_on_node(int node)
+{
+    if ((node < 0) || (node >= _num_nodes))
+        node = 0;
+
+    _account_alloc();
+
+    thread_cache_t* tc = (thread_cache_t*)pthread_getspecific(_cache_key);
+    if (tc && tc->_head && (tc->_node == node)) {
+        block_hdr_t* hdr = tc->_head;
+        tc->_head = hdr->_next;
+        tc->_count--;
+        return (page_of(hdr));
+    }
+
+    void* page = _pop_node(node);
+    if (page)
+        return (page);
+
+    /* Nothing to recycle; get new memory. With a single node (or
+       without libnuma) it comes from malloc, see _release(). */
+    size_t sz = BLOCK_HDR_SIZE + page_size();
+#ifdef HAVE_LIBNUMA
+    void* mem = (_num_nodes > 1)? numa_alloc_onnode(sz, node) : malloc(sz);
+#else
+    void* mem = malloc(sz);
+#endif
+    if (!mem)
+        throw std::bad_alloc();
+    atomic_inc_64(&_pages_allocated);
+
+    block_hdr_t* hdr = (block_hdr_t*)mem;
+    hdr->_next = NULL;
+    hdr->_node = node;
+    return (page_of(hdr));
+}
+
+
+
+/******************************************************************** 
+ *
+ *  @fn:    free
+ *
+ *  @brief: Keeps the page in the thread cache if it is local and
+ *          there is room, otherwise returns it to its node's list.
+ *
+ ********************************************************************/
+
+void recycling_page_pool::free(void* page)
+{
+    block_hdr_t* hdr = hdr_of(page);
+    atomic_dec_64(&_pages_in_use);
+
+    thread_cache_t* tc = (thread_cache_t*)pthread_getspecific(_cache_key);
+    if (!tc) {
+        tc = new thread_cache_t;
+        tc->_pool  = this;
+        tc->_head  = NULL;
+        tc->_count = 0;
+        tc->_node  = hdr->_node;
+        pthread_setspecific(_cache_key, tc);
+    }
+
+    /* The cache follows the node of the pages this thread frees */
+    if (tc->_count == 0)
+        tc->_node = hdr->_node;
+
+    if ((tc->_node == hdr->_node) && (tc->_count < _thread_cache_pages)) {
+        hdr->_next = tc->_head;
+        tc->_head = hdr;
+        tc->_count++;
+        return;
+    }
+
+    _push_node(hdr);
+}
+
+
+
+void recycling_page_pool::flush_thread_cache(void* cache)
+{
+    thread_cache_t* tc = (thread_cache_t*)cache;
+    while (tc->_head) {
+        block_hdr_t* hdr = tc->_head;
+        tc->_head = hdr->_next;
+        _push_node(hdr);
+    }
+    tc->_count = 0;
+}
+
+
+
+void* recycling_page_pool::_pop_node(int node)
+{
+    node_list_t& nl = _nodes[node];
+    if (*&nl._head == NULL)
+        return (NULL);
+
+    critical_section_t cs(nl._lock);
+    block_hdr_t* hdr = nl._head;
+    if (hdr == NULL)
+        return (NULL);
+    nl._head = hdr->_next;
+    nl._count--;
+    return (page_of(hdr));
+}
+
+void recycling_page_pool::_push_node(block_hdr_t* hdr)
+{
+    node_list_t& nl = _nodes[hdr->_node];
+    {
+        critical_section_t cs(nl._lock);
+        if ((_max_free_pages == 0) || (nl._count < _max_free_pages)) {
+            hdr->_next = nl._head;
+            nl._head = hdr;
+            nl._count++;
+            return;
+        }
+    }
+
+    /* The list is at its cap; give the page back to the system */
+    atomic_dec_64(&_pages_allocated);
+    _release(hdr);
+}
+
+void recycling_page_pool::_release(block_hdr_t* hdr)
+{
+#ifdef HAVE_LIBNUMA
+    if (_num_nodes > 1) {
+        numa_free(hdr, BLOCK_HDR_SIZE + page_size());
+        return;
+    }
+#endif
+    ::free(hdr);
+}
+
+
+
+/******************************************************************** 
+ *
+ *  Accounting
+ *
+ ********************************************************************/
+
+void recycling_page_pool::_account_alloc()
+{
+    uint64_t in_use = atomic_inc_64_nv(&_pages_in_use);
+    uint64_t hw = *&_pages_high_water;
+    while (in_use > hw) {
+        uint64_t cur = atomic_cas_64(&_pages_high_water, hw, in_use);
+        if (cur == hw)
+            break;
+        hw = cur;
+    }
+}
+
+size_t recycling_page_pool::bytes_allocated() const
+{
+    return (*&_pages_allocated * (BLOCK_HDR_SIZE + page_size()));
+}
+
+size_t recycling_page_pool::bytes_in_use() const
+{
+    return (*&_pages_in_use * page_size());
+}
+
+size_t recycling_page_pool::bytes_high_water() const
+{
+    return (*&_pages_high_water * page_size());
+}
+
+void recycling_page_pool::reset_high_water()
+{
+    atomic_swap(&_pages_high_water, *&_pages_in_use);
+}
+
+void recycling_page_pool::trace_stats() const
+{
+    TRACE( TRACE_ALWAYS, "Page pool: allocated (%.1fMB) in use (%.1fMB) high water (%.1fMB)\n",
+           (double)bytes_allocated()/(1024*1024),
+           (double)bytes_in_use()/(1024*1024),
+           (double)bytes_high_water()/(1024*1024));
+    for (int i=0; i<_num_nodes; i++) {
+        TRACE( TRACE_ALWAYS, "Page pool: node (%d) free pages (%lu)\n",
+               i, (unsigned long)*&_nodes[i]._count);
+    }
+}
+
+
+EXIT_NAMESPACE(qpipe);
@@ -23,6 +23,7 @@
 
 #include "qpipe/core/stage_container.h"
 #include "qpipe/core/dispatcher.h"
+#include "qpipe/core/query_profile.h"
 #include "util.h"
 
 #include <cstdio>
@@ -412,6 +413,10 @@ void stage_container_t::enqueue(packet_t* packet) {
 
                 // * * * END CRITICAL SECTION * * *
                 cs.exit();
+
+                if (packet->profile() != NULL)
+                    query_profile_t::record_merge(packet->profile(),
+                                                  cq_packet->_packet_id);
                 
                 /* need to exit critical section before we unreserve */
                 if (unreserve)
@@ -625,6 +630,9 @@ stage_container_t::merge_t stage_container_t::stage_adaptor_t::try_merge(packet_
 
     // * * * END CRITICAL SECTION * * *
     cs.exit();
+
+    if (packet->profile() != NULL)
+        query_profile_t::record_merge(packet->profile(), _packet->_packet_id);
     
     TRACE(TRACE_WORK_SHARING, "%s merged into %s. next_tuple_on_merge = %d\n",
 	  packet->_packet_id.data(),
@@ -798,6 +806,9 @@ void stage_container_t::stage_adaptor_t::run_stage(stage_t* stage) {
     
     // run stage-specific processing function
     bool error = false;
+    packet_profile_t* profile = _packet->profile();
+    stopwatch_t timer;
+    long long cpu_start = profile? query_profile_t::thread_cpu_us() : 0;
     try {
         stage->init(this);
         stage->process();
@@ -814,6 +825,11 @@ void stage_container_t::stage_adaptor_t::run_stage(stage_t* stage) {
         assert(false);
     }
 
+    /* cleanup() deletes the primary packet */
+    if (profile != NULL)
+        query_profile_t::record_stage(profile, timer.time_us(),
+                                      query_profile_t::thread_cpu_us() - cpu_start);
+
     // if we are still accepting packets, stop now
     stop_accepting_packets();
     if(error)
@@ -24,8 +24,14 @@
 #include <cstdio>
 
 #include "qpipe/core/tuple.h"
+#include "qpipe/core/recycling_page_pool.h"
 #include "util.h"
 
+#ifdef HAVE_LIBNUMA
+#include <sched.h>
+#include <numa.h>
+#endif
+
 
 
 ENTER_NAMESPACE(qpipe);
@@ -62,6 +68,55 @@ size_t get_default_page_size() { return default_page_size; }
 
 
 
+static page_pool* default_page_pool = NULL;
+
+void set_default_page_pool(page_pool* pool) {
+    assert(pool->page_size() == get_default_page_size());
+    default_page_pool = pool;
+}
+
+page_pool* get_default_page_pool() {
+    return (default_page_pool? default_page_pool : malloc_page_pool::instance());
+}
+
+
+/**
+ * @brief Sets the pool used by page::alloc() (and so by every
+ * tuple_fifo) by name. Known names are "malloc" and "recycling";
+ * anything else leaves the malloc pool in place.
+ */
+page_pool* select_default_page_pool(const char* name) {
+    if (name && !strcmp(name, "recycling")) {
+        TRACE( TRACE_ALWAYS, "Using the recycling page pool\n");
+        recycling_page_pool* pool = recycling_page_pool::instance();
+        int mb = envVar::instance()->getVarInt("qpipe-page-pool-free-mb",64);
+        pool->set_max_free_pages((mb > 0)? (size_t)mb*1024*1024/pool->page_size() : 0);
+        set_default_page_pool(pool);
+    }
+    else {
+        TRACE( TRACE_ALWAYS, "Using the malloc page pool\n");
+        set_default_page_pool(malloc_page_pool::instance());
+    }
+    return (get_default_page_pool());
+}
+
+
+int page_pool_current_node() {
+#ifdef HAVE_LIBNUMA
+    if (numa_available() < 0)
+        return (0);
+    int cpu = sched_getcpu();
+    if (cpu < 0)
+        return (0);
+    int node = numa_node_of_cpu(cpu);
+    return ((node < 0)? 0 : node);
+#else
+    return (0);
+#endif
+}
+
+
+
 bool page::read_full_page(int fd) {
     
     /* create an aligned array of bytes we can read into */
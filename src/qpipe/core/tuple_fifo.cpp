@@ -23,9 +23,9 @@
 
 #include "qpipe/core/tuple_fifo.h"
 #include "qpipe/core/tuple_fifo_directory.h"
+#include "qpipe/core/query_profile.h"
 #include "util/trace.h"
 #include "util/acounter.h"
-#include <algorithm>
 
 
 ENTER_NAMESPACE(qpipe);
@@ -37,6 +37,10 @@ static int TRACE_MASK_WAITS = TRACE_COMPONENT_MASK_NONE;
 static int TRACE_MASK_DISK  = TRACE_COMPONENT_MASK_NONE;
 static const bool FLUSH_TO_DISK_ON_FULL = false;
 
+/* How many times a blocked reader/writer polls the other side before
+   going to sleep on its condition variable */
+static const int SPIN_LOOPS = 1000;
+
 
 
 /* Global tuple_fifo statistics */
@@ -93,6 +97,8 @@ void tuple_fifo::trace_stats() {
     TRACE(TRACE_ALWAYS,
           "%lf experienced write waits\n",
           (double)total_fifos_experienced_write_wait/total_fifos_created);
+    get_default_page_pool()->trace_stats();
+    memory_manager_t::trace_stats();
 }
 
 
@@ -149,6 +155,7 @@ void tuple_fifo::init() {
     tuple_fifo_directory_t::open_once();
 
     _reader_tid = pthread_self();
+    _consumer_node = page_pool_current_node();
 
     /* Prepare for reading. */
     _set_read_page(SENTINEL_PAGE);
@@ -168,6 +175,14 @@ void tuple_fifo::init() {
 
 
 
+void tuple_fifo::set_profile(packet_profile_t* profile) {
+    assert(_profile == NULL);
+    _profile = profile;
+    _profile->_query->acquire_ref();
+}
+
+
+
 /**
  * @brief Should be invoked by the writer before writing tuples.
  */
@@ -178,26 +193,28 @@ void tuple_fifo::writer_init() {
 
 
 
-/**
- * @brief Function object. Wrapper around p->free() that can be passed
- * to std::for_each.
- */
-struct free_page {
-    void operator()(qpipe::page* p) {
-	p->free();
-    }
-};
-
-
-
 /**
  * @brief Deallocate the pags in this tuple_fifo and add our local
  * statistics to global ones.
  */
 void tuple_fifo::destroy() {
 
-    std::for_each(_pages.begin(), _pages.end(), free_page());
-    std::for_each(_free_pages.begin(), _free_pages.end(), free_page());
+    for (page* p = _pages.pop(); p != NULL; p = _pages.pop())
+        p->free();
+    for (page* p = _free_pages.pop(); p != NULL; p = _free_pages.pop())
+        p->free();
+
+    /* give the pages back to the query */
+    _memory.detach();
+
+    if (_profile != NULL) {
+        query_profile_t::record_output(_profile, _num_inserted, _pages_written,
+                                       _num_spilled * _page_size,
+                                       _insert_wait_us);
+        query_profile_t::record_consumer_wait(_profile, _remove_wait_us);
+        _profile->_query->release_ref();
+        _profile = NULL;
+    }
 	
     /* update stats */
     critical_section_t cs(tuple_fifo_stats_mutex);
@@ -325,200 +342,272 @@ bool tuple_fifo::terminate() {
 
 /* definitions of helper methods */
 
-inline void tuple_fifo::wait_for_reader() {
-    _num_waits_on_insert++;
-    thread_cond_wait(_writer_notify, _lock);
+/**
+ * @brief Only the writer may call this method. Spins for a while and
+ * then sleeps until the reader has freed at least '_threshold' pages
+ * (or the fifo is terminated).
+ */
+void tuple_fifo::wait_for_reader() {
+
+    for (int i = 0; i < SPIN_LOOPS; i++) {
+        if ((_available_in_memory_writes() > 0) || is_terminated())
+            return;
+    }
+
+    stopwatch_t timer;
+    critical_section_t cs(_lock);
+    _writer_sleeping = true;
+    /* publish the flag before re-checking, see ensure_writer_running() */
+    membar_enter();
+    for (size_t threshold=1;
+         (_available_in_memory_writes() < threshold) && !is_terminated();
+         threshold = _threshold) {
+        _num_waits_on_insert++;
+        thread_cond_wait(_writer_notify, _lock);
+    }
+    _writer_sleeping = false;
+    _insert_wait_us += timer.time_us();
 }
 
+/**
+ * @brief Only the writer may call this method, after publishing a
+ * page. Wakes a sleeping reader if enough pages are available.
+ */
 inline void tuple_fifo::ensure_reader_running() {
-    thread_cond_signal(_reader_notify);
+    membar_enter();
+    if (*&_reader_sleeping
+        && ((_available_fifo_reads() >= _threshold) || is_done_writing())) {
+        critical_section_t cs(_lock);
+        thread_cond_signal(_reader_notify);
+    }
 }
 
-inline bool tuple_fifo::wait_for_writer(int timeout_ms) {
-    _num_waits_on_remove++;
-    return thread_cond_wait(_reader_notify, _lock, timeout_ms);
+/**
+ * @brief Only the reader may call this method. Spins for a while and
+ * then sleeps until '_threshold' pages are available, the writer is
+ * done, or the fifo is terminated.
+ *
+ * @return false if 'timeout_ms' expired
+ */
+bool tuple_fifo::wait_for_writer(int timeout_ms) {
+
+    for (int i = 0; i < SPIN_LOOPS; i++) {
+        if ((_available_fifo_reads() > 0) || is_done_writing() || is_terminated())
+            return true;
+    }
+
+    stopwatch_t timer;
+    critical_section_t cs(_lock);
+    _reader_sleeping = true;
+    /* publish the flag before re-checking, see ensure_reader_running() */
+    membar_enter();
+    bool result = true;
+    for (size_t t=1;
+         (_available_fifo_reads() < t) && !is_done_writing() && !is_terminated();
+         t = _threshold) {
+        _num_waits_on_remove++;
+        if (!thread_cond_wait(_reader_notify, _lock, timeout_ms)) {
+            /* Timed out! */
+            result = false;
+            break;
+        }
+    }
+    _reader_sleeping = false;
+    _remove_wait_us += timer.time_us();
+    return result;
 }
 
+/**
+ * @brief Only the reader may call this method, after consuming a
+ * page. Wakes a sleeping writer if enough space is available.
+ */
 inline void tuple_fifo::ensure_writer_running() {
-    thread_cond_signal(_writer_notify);
+    membar_enter();
+    if (*&_writer_sleeping
+        && (_available_in_memory_writes() >= _threshold)) {
+        critical_section_t cs(_lock);
+        thread_cond_signal(_writer_notify);
+    }
 }
 
 
 
 /**
- * @brief Get a page from the tuple_fifo.
- *
- * @return NULL if the tuple_fifo has been closed. A page otherwise.
+ * @brief Hand the current write page to the reader and prepare a new
+ * one. While in memory this does not take the fifo lock.
  */
 void tuple_fifo::_flush_write_page(bool done_writing) {
 
     // after the call to send_eof() the write page is NULL
     assert(!is_done_writing());
-    
-    // * * * BEGIN CRITICAL SECTION * * *
-    critical_section_t cs(_lock);
     _termination_check();
 
 
-    switch(_state.current()) {
-    case tuple_fifo_state_t::IN_MEMORY: {
-        
-            
+    if (_state.current() == tuple_fifo_state_t::IN_MEMORY) {
+
         /* Wait for space to free up if we are using a "no flush"
            policy. */
-        if (!FLUSH_TO_DISK_ON_FULL) {
+        if (!FLUSH_TO_DISK_ON_FULL && (_available_in_memory_writes() < 1)) {
             /* tuple_fifo stays in memory */
             /* If the buffer is currently full, we must wait for space to
                open up. Once we start waiting we continue waiting until
                space for '_threshold' pages is available. */
-            for(size_t threshold=1;
-                _available_in_memory_writes() < threshold; threshold = _threshold) {
-                /* wait until something important changes */
-                wait_for_reader();
-                _termination_check();
-            }
+            wait_for_reader();
+            _termination_check();
         }
 
 
         /* At this point, we don't have to wait for space anymore. If
            we still don't have enough space, it must be because we are
-           using a disk flush policy. Check whether we can proceed
-           without flushing to disk. */
-        if (_available_in_memory_writes() >= 1) {
-            
-            /* Add _write_page to other tuple_fifo pages unless
-               empty. */
-            if(!_write_page->empty()) {
-                _pages.push_back(_write_page.release());
-                _pages_in_memory++;
-                _pages_in_fifo++;
-            }
-            
-            /* Allocate a new _write_page if necessary. */
-            if(done_writing) {
-                /* Allocation of a new _write_page is not necessary
-                   (because we are done writing). Just do state
-                   transition. */
-                _state.transition(tuple_fifo_state_t::IN_MEMORY_DONE_WRITING);
-                _write_page.done();
-            }
-            else
-                _write_page = _alloc_page();
-            
-            /* wake the reader if necessary */
-            if(_available_in_memory_reads() >= _threshold || is_done_writing())
-                ensure_reader_running();
-            
-            break;
+           using a disk flush policy. */
+        if (_available_in_memory_writes() < 1) {
+            _spill_to_disk(done_writing);
+            return;
         }
 
-
-        /* If we are here, we need to flush to disk. */
-        /* Create on disk file. */
-        c_str filepath = tuple_fifo_directory_t::generate_filepath(_fifo_id);
-        _page_file = fopen(filepath.data(), "w+");
-        assert(_page_file != NULL);
-        if (_page_file == NULL)
-            THROW2(FileException,
-                   "fopen(%s) failed", filepath.data());
-        TRACE(TRACE_ALWAYS, "Created tuple_fifo file %s\n",
-              filepath.data());
-        
-        /* Append this page to _pages and flush the entire
-           page_list to disk. */
-        if(!_write_page->empty()) {
-            _pages.push_back(_write_page.release());
-            _pages_in_memory++;
-            _pages_in_fifo++;
+        /* Get the next write page before publishing this one. If the
+           query is out of memory we go to disk instead. */
+        page* next_page = NULL;
+        if (!done_writing) {
+            next_page = _alloc_page();
+            if (next_page == NULL) {
+                _memory.note_spill();
+                _spill_to_disk(false);
+                return;
+            }
         }
-        for (page_list::iterator it = _pages.begin(); it != _pages.end(); ) {
-            qpipe::page* p = *it;
-            p->fwrite_full_page(_page_file);
-
-            /* done with page */
-            p->clear();
-            _free_pages.push_back(p);
-            it = _pages.erase(it);
 
-            assert(_pages_in_memory > 0);
-            _pages_in_memory--;
+        /* Add _write_page to other tuple_fifo pages unless empty. */
+        if (!_write_page->empty()) {
+            bool pushed = _pages.push(_write_page.release());
+            assert(pushed);
+            (void) pushed;
+            _pages_written = _pages_written + 1;
         }
-        fflush(_page_file);
-        
-        /* update _file_head_page */
-        assert(_file_head_page == 0);
-        _file_head_page = _next_page;
 
-        _state.transition(tuple_fifo_state_t::ON_DISK);
         if (done_writing) {
-            /* transition again! */
-            _state.transition(tuple_fifo_state_t::ON_DISK_DONE_WRITING);
+            /* Allocation of a new _write_page is not necessary
+               (because we are done writing). Just do state transition
+               and make sure the reader sees it. */
+            critical_section_t cs(_lock);
+            _termination_check();
+            _state.transition(tuple_fifo_state_t::IN_MEMORY_DONE_WRITING);
             _write_page.done();
+            thread_cond_signal(_reader_notify);
+            return;
         }
-        else {
-            /* allocate from free list */
-            assert(!_free_pages.empty());
-            _write_page = _alloc_page();
-
-            /* TODO It's clear whether we want to replace the
-               SENTINAL_PAGE here. On the one hand, if we can replace
-               it, we can free the rest of the pages in the free
-               list. On the other, we still need to check for the
-               SENTINAL_PAGE in _get_read_page since pages may be
-               removed using get_page (instead of tuples removed with
-               get_tuple). */
-            if (_read_page == SENTINEL_PAGE) {
-                _set_read_page(_alloc_page());
-                /* After this point, we should not release either of
-                   these pages. */
-            }
-        }
+
+        _write_page = next_page;
 
         /* wake the reader if necessary */
-        if(_available_fifo_reads() >= _threshold || is_done_writing())
-            ensure_reader_running();
+        ensure_reader_running();
+        return;
+    }
 
-        break;
 
-    } /* endof case: IN_MEMORY */
-        
-    case tuple_fifo_state_t::ON_DISK: {
+    // * * * BEGIN CRITICAL SECTION * * *
+    critical_section_t cs(_lock);
+    _termination_check();
+    assert(_state.current() == tuple_fifo_state_t::ON_DISK);
+
+    int fseek_ret = fseek(_page_file, 0, SEEK_END);
+    assert(!fseek_ret);
+    if (fseek_ret)
+        THROW1(FileException, "fseek to EOF");
+    _write_page->fwrite_full_page(_page_file);
+    fflush(_page_file);
+    _pages_written = _pages_written + 1;
+    _num_spilled++;
+
+    if (done_writing) {
+        _state.transition(tuple_fifo_state_t::ON_DISK_DONE_WRITING);
+        _write_page.done();
+    }
+    else {
+        /* simply reuse write page */
+        _write_page->clear();
+    }
 
-        int fseek_ret = fseek(_page_file, 0, SEEK_END);
-        assert(!fseek_ret);
-        if (fseek_ret)
-            THROW1(FileException, "fseek to EOF");
-        _write_page->fwrite_full_page(_page_file);
-        fflush(_page_file);
-        _pages_in_fifo++;
+    /* wake the reader if necessary */
+    if (_available_fifo_reads() >= _threshold || is_done_writing())
+        thread_cond_signal(_reader_notify);
 
-        if (done_writing) {
-            _state.transition(tuple_fifo_state_t::ON_DISK_DONE_WRITING);
-            _write_page.done();
-        }
-        else {
-            /* simply reuse write page */
-            _write_page->clear();
-        }
-        
-        /* wake the reader if necessary */
-        if(_available_fifo_reads() >= _threshold || is_done_writing())
-            ensure_reader_running();
+    // * * * END CRITICAL SECTION * * *
+}
 
-        break;
-    }
 
-    default:
-        unreachable();
 
-    } /* endof switch statement */
+/**
+ * @brief Only the writer may call this method. Switch the fifo to
+ * ON_DISK. Pages already in _pages stay there and are consumed first
+ * by the reader; every page from now on goes to the backing file.
+ */
+void tuple_fifo::_spill_to_disk(bool done_writing) {
 
+    // * * * BEGIN CRITICAL SECTION * * *
+    critical_section_t cs(_lock);
+    _termination_check();
+
+    /* Create on disk file. */
+    c_str filepath = tuple_fifo_directory_t::generate_filepath(_fifo_id);
+    _page_file = fopen(filepath.data(), "w+");
+    assert(_page_file != NULL);
+    if (_page_file == NULL)
+        THROW2(FileException,
+               "fopen(%s) failed", filepath.data());
+    TRACE(TRACE_ALWAYS, "Created tuple_fifo file %s\n",
+          filepath.data());
+
+    /* The reader compares against _file_head_page as soon as it sees
+       the new state, so it must be set first. */
+    assert(_file_head_page == 0);
+    _file_head_page = _pages_written;
+    membar_producer();
+    _state.transition(tuple_fifo_state_t::ON_DISK);
+    membar_producer();
+
+    _write_page->fwrite_full_page(_page_file);
+    fflush(_page_file);
+    _pages_written = _pages_written + 1;
+    _num_spilled++;
+
+    if (done_writing) {
+        /* transition again! */
+        _state.transition(tuple_fifo_state_t::ON_DISK_DONE_WRITING);
+        _write_page.done();
+    }
+    else {
+        /* From now on the write page is simply reused */
+        _write_page->clear();
+    }
+
+    /* wake the reader if necessary */
+    if (_available_fifo_reads() >= _threshold || is_done_writing())
+        thread_cond_signal(_reader_notify);
 
     // * * * END CRITICAL SECTION * * *
 }
 
 
 
+/**
+ * @brief Only the reader may call this method. Give the current read
+ * page back to the writer if it came from the in-memory ring.
+ */
+void tuple_fifo::_release_read_page() {
+    if (!_read_page_recycle)
+        return;
+
+    page* p = _read_page.release();
+    p->clear();
+    if (!_free_pages.push(p))
+        p->free();
+    _set_read_page(SENTINEL_PAGE);
+    _read_page_recycle = false;
+}
+
+
+
 /**
  * @brief Use a timeout_ms value of 0 to wait until a page appears or
  * the tuple_fifo is closed (normal behavior). Use a negative
@@ -533,148 +622,130 @@ void tuple_fifo::_flush_write_page(bool done_writing) {
  */
 int tuple_fifo::_get_read_page(int timeout_ms) {
 
-    // * * * BEGIN CRITICAL SECTION * * *
-    critical_section_t cs(_lock);
     _termination_check();
 
+    /* The reader may have been moved since the fifo was created */
+    _consumer_node = page_pool_current_node();
 
     /* Free the page so the writer can use it. */
-    if (is_in_memory() && (_read_page != SENTINEL_PAGE)) {
-        /* We are still maintaining an in-memory page list from which
-           we are pulling pages. We release them to _free_pages as we
-           are done with them. */
-        _read_page->clear();
-        _free_pages.push_back(_read_page.release());
-        _set_read_page(SENTINEL_PAGE);
-    }
+    _release_read_page();
 
 
-    /* If 'wait_on_empty' and the buffer is currently empty, we must
-       wait for space to open up. Once we start waiting we continue
-       waiting until either space for '_threshold' pages is available
-       OR the writer has invoked send_eof() or terminate(). */
-    for(size_t t=1;
-        (timeout_ms >= 0) && !is_done_writing() && (_available_fifo_reads() < t);
-        t = _threshold) {
-        /* We are to either wait for a page or wait for timeout_ms. */
-        if(!wait_for_writer(timeout_ms))
-            /* Timed out! */
-            break;
-        _termination_check();
-    }
+    /* If the buffer is currently empty, we must wait for pages to
+       appear. Once we start waiting we continue waiting until either
+       '_threshold' pages are available OR the writer has invoked
+       send_eof() or terminate(). */
+    if ((timeout_ms >= 0) && (_available_fifo_reads() == 0) && !is_done_writing())
+        wait_for_writer(timeout_ms);
+    _termination_check();
 
 
+    /* Check for EOF before counting pages: the writer publishes its
+       last page before it transitions to *_DONE_WRITING. */
+    bool done_writing = is_done_writing();
+    membar_consumer();
     TRACE(TRACE_ALWAYS&TRACE_MASK_DISK,
           "available reads = %d\n", (int)_available_fifo_reads());
-    if(_available_fifo_reads() == 0) {
-        /* If we are here, we exited the loop above because one of the
-           other conditions failed. We either noticed that the
-           tuple_fifo has been closed or we've timed out. */
-        if(is_done_writing()) {
+    if (_available_fifo_reads() == 0) {
+        /* We either noticed that the tuple_fifo has been closed or
+           we've timed out. */
+        if (done_writing) {
             /* notify caller that the tuple_fifo is closed */
             TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "Returning -1\n");
 	    return -1;
         }
-	if(timeout_ms != 0)
+	if (timeout_ms != 0)
             /* notify caller that we timed out */
 	    return 0;
 	unreachable();
     }
+    membar_consumer();
 
 
-    switch(_state.current()) {
-    case tuple_fifo_state_t::IN_MEMORY:
-    case tuple_fifo_state_t::IN_MEMORY_DONE_WRITING: {
-        /* pull the page from page_list */
-        assert(!_pages.empty());
-        _set_read_page(_pages.front());
-        _pages.pop_front();
-        assert(_pages_in_memory > 0);
-        _pages_in_memory--;
-        break;
+    /* Pages published before a spill are still in the ring */
+    if (is_in_memory() || (_next_page < _file_head_page)) {
+        page* p = _pages.pop();
+        assert(p != NULL);
+        _set_read_page(p);
+        _read_page_recycle = true;
     }
-    case tuple_fifo_state_t::ON_DISK:
-    case tuple_fifo_state_t::ON_DISK_DONE_WRITING: {
-
-        /* We are on disk. We should not be releasing _read_page after
-           iterating over its entries. However, we still need to be
-           prepared against code which extracts pages from the
-           tuple_fifo using get_page(). get_page() sets _read_page to
-           the SENTINEL_PAGE. */
-        if (_read_page == SENTINEL_PAGE)
-            _set_read_page(_alloc_page());
-        else {
-            /* We are reusing the same read page... do a reset */
-            _read_page->clear();
-            _set_read_page(_read_page.release());
-        }
-
-
-        /* Make sure that at this point, we are not dealing with the
-           SENTINAL_PAGE. */
-        assert(_read_page != SENTINEL_PAGE);
-        assert(_read_page->page_size() == malloc_page_pool::instance()->page_size());
-
-
-        /* read page from disk file */
-        _read_page->clear();
-        TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "_next_page = %d\n", (int)_next_page);
-        TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "_file_head_page = %d\n", (int)_file_head_page);
-        unsigned long seek_pos =
-            (_next_page - _file_head_page) * get_default_page_size();
-        TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "fseek to %lu\n", seek_pos);
-        int fseek_ret = fseek(_page_file, seek_pos, SEEK_SET);
-        assert(!fseek_ret);
-        if (fseek_ret)
-            THROW2(FileException, "fseek to %lu", seek_pos);
-        int fread_ret = _read_page->fread_full_page(_page_file);
-        assert(fread_ret);
-        _set_read_page(_read_page.release());
-
-
-        size_t page_size = _read_page->page_size();
-        if (TRACE_ALWAYS&TRACE_MASK_DISK) {
-            page* pg = _read_page.release();
-            unsigned char* pg_bytes = (unsigned char*)pg;
-            for (size_t i = 0; i < page_size; i++) {
-                printf("%02x", pg_bytes[i]);
-                if (i % 2 == 0)
-                    printf("\t");
-                if (i % 16 == 0)
-                    printf("\n");
-            } 
-            _set_read_page(pg);
-        }
-        
-        TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "Read %d %d-byte tuples\n",
-              (int)_read_page->tuple_count(),
-              (int)_read_page->tuple_size());
-        break;
+    else {
+        // * * * BEGIN CRITICAL SECTION * * *
+        critical_section_t cs(_lock);
+        _termination_check();
+        _read_page_from_disk();
+        // * * * END CRITICAL SECTION * * *
     }
 
-    default:
-        unreachable();
-    } /* endof switch statement */
+    _next_page = _next_page + 1;
+
 
-    
-    assert(_pages_in_fifo > 0);
-    _pages_in_fifo--;
-    _next_page++;
-    
-    
     /* wake the writer if necessary */
-    if(!FLUSH_TO_DISK_ON_FULL
-       && (_available_in_memory_writes() >= _threshold)
-       && !is_done_writing())
+    if (!FLUSH_TO_DISK_ON_FULL && is_in_memory() && !is_done_writing())
         ensure_writer_running();
 
-
-    // * * * END CRITICAL SECTION * * *
     return 1;
 }
 
 
 
+/**
+ * @brief Only the reader may call this method, holding _lock. Read
+ * page '_next_page' from the backing file into _read_page.
+ */
+void tuple_fifo::_read_page_from_disk() {
+
+    /* We are on disk. We should not be releasing _read_page after
+       iterating over its entries. Allocate a private read page the
+       first time we get here and reuse it afterwards. */
+    if (_read_page == SENTINEL_PAGE)
+        _set_read_page(page::alloc(tuple_size()));
+
+
+    /* Make sure that at this point, we are not dealing with the
+       SENTINAL_PAGE. */
+    assert(_read_page != SENTINEL_PAGE);
+    assert(_read_page->page_size() == get_default_page_pool()->page_size());
+
+
+    /* read page from disk file */
+    _read_page->clear();
+    TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "_next_page = %d\n", (int)_next_page);
+    TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "_file_head_page = %d\n", (int)_file_head_page);
+    unsigned long seek_pos =
+        (_next_page - _file_head_page) * get_default_page_size();
+    TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "fseek to %lu\n", seek_pos);
+    int fseek_ret = fseek(_page_file, seek_pos, SEEK_SET);
+    assert(!fseek_ret);
+    if (fseek_ret)
+        THROW2(FileException, "fseek to %lu", seek_pos);
+    int fread_ret = _read_page->fread_full_page(_page_file);
+    assert(fread_ret);
+    (void) fread_ret;
+    _set_read_page(_read_page.release());
+
+
+    size_t page_size = _read_page->page_size();
+    if (TRACE_ALWAYS&TRACE_MASK_DISK) {
+        page* pg = _read_page.release();
+        unsigned char* pg_bytes = (unsigned char*)pg;
+        for (size_t i = 0; i < page_size; i++) {
+            printf("%02x", pg_bytes[i]);
+            if (i % 2 == 0)
+                printf("\t");
+            if (i % 16 == 0)
+                printf("\n");
+        } 
+        _set_read_page(pg);
+    }
+
+    TRACE(TRACE_ALWAYS&TRACE_MASK_DISK, "Read %d %d-byte tuples\n",
+          (int)_read_page->tuple_count(),
+          (int)_read_page->tuple_size());
+}
+
+
+
 int tuple_fifo_generate_id() {
     static acounter_t next_fifo_id;
     return next_fifo_id.fetch_and_inc();
@@ -0,0 +1,152 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+#include "util/config.h"
+#include "qpipe/core/tuple_fifo_bench.h"
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+/**
+ *  @brief The upstream "stage" of the benchmark. Fills pages of
+ *  tuples as fast as it can and then sends EOF.
+ */
+class fifobench_writer_t : public thread_t
+{
+    tuple_fifo* _fifo;
+    size_t      _num_pages;
+
+public:
+
+    fifobench_writer_t(tuple_fifo* fifo, const size_t num_pages)
+        : thread_t("FIFOBENCH_WRITER"), _fifo(fifo), _num_pages(num_pages)
+    {
+    }
+
+    virtual void work() {
+        _fifo->writer_init();
+        size_t per_page = page::capacity(_fifo->page_size(), _fifo->tuple_size());
+        size_t num_tuples = _num_pages * per_page;
+        for (size_t i = 0; i < num_tuples; i++) {
+            tuple_t t = _fifo->allocate();
+            memset(t.data, (int)i, t.size);
+        }
+        _fifo->send_eof();
+    }
+};
+
+
+
+double tuple_fifo_bench(const size_t num_pages,
+                        const size_t tuple_size,
+                        const size_t capacity,
+                        const size_t threshold)
+{
+    tuple_fifo* fifo = new tuple_fifo(tuple_size, capacity, threshold);
+    fifobench_writer_t* writer = new fifobench_writer_t(fifo, num_pages);
+
+    stopwatch_t timer;
+    pthread_t tid = thread_create(writer);
+
+    /* we are the downstream "stage" */
+    size_t tuples = 0;
+    tuple_t t;
+    while (fifo->get_tuple(t))
+        tuples++;
+    double secs = timer.time();
+
+    thread_join<void>(tid);
+    delete (fifo);
+
+    size_t per_page = page::capacity(get_default_page_size(), tuple_size);
+    double pages = (double)tuples/per_page;
+    TRACE( TRACE_ALWAYS, "%.0f pages (%lu tuples) in %.3f secs. %.0f pages/sec\n",
+           pages, (unsigned long)tuples, secs, pages/secs);
+    return (pages/secs);
+}
+
+
+
+/*********************************************************************
+ *
+ *  "fifobench" command
+ *
+ *********************************************************************/
+
+void fifobench_cmd_t::setaliases() 
+{ 
+    _name = string("fifobench"); 
+    _aliases.push_back("fifobench"); 
+}
+
+int fifobench_cmd_t::handle(const char* cmd)
+{
+    char cmd_tag[SERVER_COMMAND_BUFFER_SIZE];
+    int num_pages  = 100000;
+    int tuple_size = 64;
+    int capacity   = DEFAULT_BUFFER_PAGES;
+    int threshold  = 64;
+    int iterations = 3;
+
+    if ( sscanf(cmd, "%s %d %d %d %d %d", cmd_tag, &num_pages, &tuple_size,
+                &capacity, &threshold, &iterations) < 1) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    if ((num_pages<1) || (tuple_size<1) || (capacity<1) || 
+        (threshold<1) || (threshold>capacity) || (iterations<1)) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    double total = 0;
+    for (int i=0; i<iterations; i++) {
+        TRACE( TRACE_ALWAYS, "Iteration %d\n", i);
+        total += tuple_fifo_bench(num_pages, tuple_size, capacity, threshold);
+    }
+    TRACE( TRACE_ALWAYS, "Average: %.0f pages/sec\n", total/iterations);
+    return (SHELL_NEXT_CONTINUE);
+}
+
+void fifobench_cmd_t::usage(void)
+{
+    TRACE( TRACE_ALWAYS, "FIFOBENCH Usage:\n\n"                              \
+           "*** fifobench [<PAGES> <TUPLE_SIZE> <CAPACITY> <THRESHOLD> <ITERATIONS>]\n" \
+           "\nParameters:\n"                                            \
+           "<PAGES>      - Pages to pass from writer to reader (default=100000)\n" \
+           "<TUPLE_SIZE> - Size of each tuple in bytes (default=64)\n" \
+           "<CAPACITY>   - In-memory pages of the tuple_fifo (default=%d)\n" \
+           "<THRESHOLD>  - Wake-up threshold of the tuple_fifo (default=64)\n" \
+           "<ITERATIONS> - Number of runs (default=3)\n\n",
+           DEFAULT_BUFFER_PAGES);
+}
+
+string fifobench_cmd_t::desc() const 
+{ 
+    return (string("Measures pages/sec between two stages through a tuple_fifo")); 
+}
+
+
+EXIT_NAMESPACE(qpipe);
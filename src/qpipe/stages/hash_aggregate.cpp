@@ -44,7 +44,7 @@ const c_str hash_aggregate_stage_t::DEFAULT_STAGE_NAME = "HASH_AGGREGATE_STAGE";
 
 
 
-// the maximum number of pages allowed in a single run
+// the maximum number of pages allowed in a single pass
 static const size_t MAX_RUN_PAGES = 10000;
 
 
@@ -108,6 +108,11 @@ int hash_aggregate_stage_t::alloc_agg(tuple_t &agg, const char* key) {
         if(_page_count >= MAX_RUN_PAGES)
             return 1;
 
+        // the first page of a pass is always granted, so every pass
+        // makes progress
+        if(!_memory.grow(get_default_page_size(), _page_count == 0))
+            return 1;
+
         _agg_page = qpipe::page::alloc(_aggregate->tuple_size());
         _page_list.add(_agg_page);
         _page_count++;
@@ -132,6 +137,7 @@ void hash_aggregate_stage_t::process_packet() {
     tuple_fifo* input_buffer = packet->_input_buffer;
     dispatcher_t::dispatch_packet(packet->_input);
     _aggregate = packet->_aggregate;
+    _memory.attach(packet->query_memory());
     key_extractor_t* agg_key = _aggregate->key_extractor();
     key_extractor_t* tup_key = packet->_extractor;
     //    key_compare_t* compare = packet->_compare;
@@ -144,56 +150,111 @@ void hash_aggregate_stage_t::process_packet() {
     equalbytes_t eql(key_size);
     extractkey_t ext(agg_key);
 
-    // start with 10001 buckets
-    tuple_hash_t run(10001, hf, eql, ext);
-
-    // read in the tuples and aggregate them in the set
-    while(!input_buffer->eof()) {
+    size_t in_size = input_buffer->tuple_size();
+    size_t out_size = packet->_output_filter->input_tuple_size();
+    array_guard_t<char> out_data = new char[out_size];
+    tuple_t out(out_data, out_size);
+
+    // Each pass aggregates as many groups as the query's memory
+    // allows. Once a page is refused, the tuples of groups that are
+    // not in the table yet overflow to a temp file, which becomes the
+    // input of the next pass. The groups in the table have seen all
+    // their tuples, so they go out at the end of the pass.
+    c_str in_name;
+    guard<FILE> in_file = NULL;
+    guard<qpipe::page> in_page = qpipe::page::alloc(in_size);
+    while(1) {
+        // start with 10001 buckets
+        tuple_hash_t run(10001, hf, eql, ext);
         _page_list.clear();
+        _memory.shrink(_memory.bytes());
         _page_count = 0;
         _agg_page = NULL;
-        while(_page_count < MAX_RUN_PAGES && !input_buffer->eof()) {
-            guard<qpipe::page> page = NULL;
+
+        c_str overflow_name;
+        guard<FILE> overflow = NULL;
+        guard<qpipe::page> overflow_page = NULL;
+
+        // read in the tuples and aggregate them in the set
+        qpipe::page::iterator in_it = in_page->end();
+        while(1) {
             tuple_t in;
-            while(1) {
-                // out of pages?
+            if(!in_file) {
                 if(!input_buffer->get_tuple(in))
-                   break;
-
-                // search for the key in the hash table
-		char const* key = tup_key->extract_key(in);
-		tuple_hash_t::iterator candidate = run.find(key);
-                if(candidate == run.end()) {
-                    // initialize a blank aggregate tuple
-		    tuple_t agg;
-                    if(alloc_agg(agg, key))
+                    break;
+            }
+            else {
+                if(in_it == in_page->end()) {
+                    if(!in_page->fread_full_page(in_file))
                         break;
-                    
-                    // insert the new aggregate tuple
-                    candidate = run.insert_unique(agg.data).first;
+                    in_it = in_page->begin();
+                    continue;
                 }
-                else {
-                    TRACE(TRACE_DEBUG, "Merging a tuple\n");
+                in = *in_it++;
+            }
+
+            // search for the key in the hash table
+            char const* key = tup_key->extract_key(in);
+            tuple_hash_t::iterator candidate = run.find(key);
+            if(candidate == run.end()) {
+                // initialize a blank aggregate tuple
+                tuple_t agg;
+                if(alloc_agg(agg, key)) {
+                    // no room for another group, leave it to the
+                    // next pass
+                    if(!overflow) {
+                        _memory.note_spill();
+                        overflow = create_tmp_file(overflow_name, "hash-agg-overflow");
+                        overflow_page = qpipe::page::alloc(in_size);
+                    }
+                    overflow_page->append_tuple(in);
+                    if(overflow_page->full()) {
+                        overflow_page->fwrite_full_page(overflow);
+                        overflow_page->clear();
+                    }
+                    continue;
                 }
 
-                // update an existing aggregate tuple (which may have
-                // just barely been inserted)
-                _aggregate->aggregate(*candidate, in);
+                // insert the new aggregate tuple
+                candidate = run.insert_unique(agg.data).first;
+            }
+            else {
+                TRACE(TRACE_DEBUG, "Merging a tuple\n");
             }
-        }
 
-        // TODO: handle cases where the run doesn't fit in memory
-        assert(input_buffer->eof());
+            // update an existing aggregate tuple (which may have
+            // just barely been inserted)
+            _aggregate->aggregate(*candidate, in);
+        }
 
         // write out the result
-        size_t out_size = packet->_output_filter->input_tuple_size();
-        array_guard_t<char> out_data = new char[out_size];
-        tuple_t out(out_data, out_size);
         for(tuple_hash_t::iterator it=run.begin(); it != run.end(); ++it) {
             // convert the aggregate tuple to an output tuple
             _aggregate->finish(out, *it);
             _adaptor->output(out);
         }
+
+        // this pass's input file is used up
+        if(in_file) {
+            in_file.done();
+            if(remove(in_name.data()))
+                TRACE(TRACE_ALWAYS, "Unable to remove temp file %s\n", in_name.data());
+            TRACE(TRACE_TEMP_FILE, "Removed finished temp file %s\n", in_name.data());
+        }
+
+        if(!overflow)
+            break;
+
+        // the overflow is the input of the next pass
+        if(!overflow_page->empty())
+            overflow_page->fwrite_full_page(overflow);
+        overflow.done();
+        in_name = overflow_name;
+        in_file = fopen(in_name.data(), "r");
+        if(in_file == NULL)
+            THROW3(FileException,
+                   "Caught %s opening '%s'",
+                   errno_to_str().data(), in_name.data());
     }
 }
 
@@ -51,6 +51,7 @@ void hash_join_stage_t::process_packet() {
     bool outer_join = packet->_outer;
     _join = packet->_join;
     bool distinct = packet->_distinct;
+    _memory.attach(packet->query_memory());
     
 
     /* TERMINOLOGY: The 'right' relation is the inner relation. The
@@ -62,7 +63,28 @@ void hash_join_stage_t::process_packet() {
     tuple_fifo *right_buffer = packet->_right_buffer;
     dispatcher_t::dispatch_packet(packet->_right);
     tuple_fifo *left_buffer = packet->_left_buffer;
-    dispatcher_t::dispatch_packet(packet->_left);
+
+    /* If the left side is a scan we build a Bloom filter over the
+       right keys and push it into the scan, which then drops
+       non-joining tuples before they reach left_buffer. The scan can
+       only start once the filter is complete. Outer joins need every
+       left tuple. The filter is filled while the right side is read
+       and its memory is charged to the query; if the query cannot
+       afford it we give up the pushdown and let the scan run. */
+    bool pushdown = bloom_pushdown_enabled() && !outer_join
+        && packet->_left->accepts_pushdown();
+    bloom_filter_t* bloom = NULL;
+    memory_grant_t bloom_memory(packet->query_memory());
+    if(pushdown) {
+        bloom = new bloom_filter_t(BLOOM_INITIAL_KEYS);
+        if(!bloom_memory.grow(bloom->size_bytes())) {
+            delete bloom;
+            bloom = NULL;
+            pushdown = false;
+        }
+    }
+    if(!pushdown)
+        dispatcher_t::dispatch_packet(packet->_left);
 
 
     /* Quick check for no-tuple case. */
@@ -71,6 +93,9 @@ void hash_join_stage_t::process_packet() {
            nothing. Outer join returns everything in left relation
            with appropriate null values. */
         /* TODO Handle outer join here. */
+        if(pushdown)
+            /* the empty filter makes the scan drop everything */
+            push_bloom_filter(packet, bloom);
         return;
     }
     
@@ -96,6 +121,22 @@ void hash_join_stage_t::process_packet() {
         size_t hash_code = hashfcn(extract_right(right.data));
         int    hash_int  = (int)hash_code;
         int    partition = hash_int % partitions.size();
+        if(pushdown) {
+            if(bloom->full()) {
+                /* growing copies the blocks, charge the new ones */
+                if(bloom_memory.grow(bloom->size_bytes())) {
+                    bloom->grow();
+                }
+                else {
+                    delete bloom;
+                    bloom = NULL;
+                    pushdown = false;
+                    dispatcher_t::dispatch_packet(packet->_left);
+                }
+            }
+            if(pushdown)
+                bloom->insert((uint32_t)hash_code);
+        }
 
         /* Simple optimization: Flush _before_ inserting into a full
            page, not after we fill a page. This can avoid one
@@ -114,7 +155,14 @@ void hash_join_stage_t::process_packet() {
        memory. */
 
     /* We now have the right relation sitting on disk in partition
-       files. */
+       files. The build side is complete, so the left scan may
+       start. */
+    if(pushdown) {
+        /* the pushdown filter keeps the charge for as long as it
+           holds the Bloom filter */
+        push_bloom_filter(packet, bloom);
+        bloom_memory.shrink(bloom_memory.bytes());
+    }
 
     /* Create and fill the in-memory hash table. */
     size_t page_capacity =
@@ -132,8 +180,9 @@ void hash_join_stage_t::process_packet() {
                        equal_rtup,
                        hasher);
     
-    /* Flush any partitions that went to disk */
-    right_action_t right_action(_join->left_tuple_size());
+    /* Build the table out of the in-memory partitions. The
+       partitions that went to disk close their right file and get
+       one for their left tuples; they are joined at the end. */
     for(partition_list_t::iterator it=partitions.begin(); it != partitions.end(); ++it) {
 
         qpipe::page* p = it->_page;
@@ -142,8 +191,14 @@ void hash_join_stage_t::process_packet() {
             continue;
 
         // file partition? (make sure the file gets closed)
-        if(it->file) 
-            close_file(it, right_action);
+        if(it->file) {
+            close_file(*it);
+            it->file = create_tmp_file(it->file_name2, "hash-join-left");
+
+            // resize the page to match left-side tuples
+            p->free();
+            it->_page = qpipe::page::alloc(_join->left_tuple_size());
+        }
         
         // build hash table out of in-memory partition
         else {
@@ -163,13 +218,8 @@ void hash_join_stage_t::process_packet() {
     }
 
 
-    // start building left side hash partitions
-    if(!left_buffer->ensure_read_ready())
-        // No left-side tuples... no join tuples.
-        return;
-
-    
-    // read in the left relation now
+    // read in the left relation now; the tuples of file partitions
+    // are written to their left files
     extractkey_t left_key_extractor(_join, false);
     tuple_t left(NULL, _join->left_tuple_size());
     array_guard_t<char> data = new char[_join->output_tuple_size()];
@@ -223,17 +273,134 @@ void hash_join_stage_t::process_packet() {
         }
     }
 
-    // close all the files and release in-memory pages
+    // release the in-memory pages, then join the file partitions
+    // one at a time
     table.clear();
     for(partition_list_t::iterator it=partitions.begin(); it != partitions.end(); ++it) {
+        if(it->file) {
+            close_file(*it);
+            join_file_partition(*it, outer_join, distinct);
+        }
+
         // delete the page list
         for(guard<qpipe::page> pg = it->_page; pg; pg = pg->next);
-        if(it->file) 
-            close_file(it, left_action_t());
+        *it = partition_t();
+    }
+    page_count = 0;
+    _memory.shrink(_memory.bytes());
+}
+
+
+
+/**
+ * @brief Second phase of a partition that went to disk: build a hash
+ * table out of its right file and stream its left file through it.
+ * Both files are removed.
+ *
+ * A file partition holds about 1/PARTITIONS of the right relation,
+ * so it is read back whole. Its pages are charged to the query, but
+ * they cannot be refused: there is nowhere left to spill them.
+ */
+void hash_join_stage_t::join_file_partition(partition_t &p, bool outer_join,
+                                            bool distinct) {
+
+    size_t page_bytes = get_default_page_size();
+
+    /* Read the right tuples back. */
+    qpipe::page* right_pages = NULL;
+    size_t pages = 0;
+    {
+        file_guard_t file = open_tmp_file(p.file_name1);
+        while(1) {
+            qpipe::page* pg = qpipe::page::alloc(_join->right_tuple_size());
+            if(!pg->fread_full_page(file)) {
+                pg->free();
+                break;
+            }
+            pg->next = right_pages;
+            right_pages = pg;
+            _memory.grow(page_bytes, true);
+            pages++;
+        }
+    }
+    remove_tmp_file(p.file_name1);
+
+    /* Build the hash table. */
+    size_t page_capacity =
+        qpipe::page::capacity(page_bytes, _join->right_tuple_size());
+    extractkey_t right_key_extractor(_join, true);
+    equalbytes_t equal_key (_join->key_size());
+    equalbytes_t equal_rtup(_join->right_tuple_size());
+    hashfcn_t    hasher(_join->key_size());
+
+    tuple_hash_t table(pages * page_capacity,
+                       right_key_extractor,
+                       equal_key,
+                       equal_rtup,
+                       hasher);
+
+    for(qpipe::page* pg = right_pages; pg; pg = pg->next) {
+        for(qpipe::page::iterator it=pg->begin(); it != pg->end(); ++it) {
+            if(distinct)
+                table.insert_unique_noresize(it->data);
+            else
+                table.insert_noresize(it->data);
+        }
+    }
+
+    /* Probe it with the left tuples of the partition. */
+    extractkey_t left_key_extractor(_join, false);
+    array_guard_t<char> data = new char[_join->output_tuple_size()];
+    tuple_t out(data, _join->output_tuple_size());
+    tuple_t right(NULL, _join->right_tuple_size());
+    {
+        file_guard_t file = open_tmp_file(p.file_name2);
+        guard<qpipe::page> left_page = qpipe::page::alloc(_join->left_tuple_size());
+        while(left_page->fread_full_page(file)) {
+            for(qpipe::page::iterator it=left_page->begin(); it != left_page->end(); ++it) {
+                tuple_t left = *it;
+                std::pair<tuple_hash_t::iterator, tuple_hash_t::iterator> range;
+                range = table.equal_range(left_key_extractor(left.data));
+
+                if(outer_join && range.first == range.second) {
+                    _join->left_outer_join(out, left);
+                    _adaptor->output(out);
+                }
+                else {
+                    for(tuple_hash_t::iterator rit = range.first; rit != range.second; ++rit) {
+                        right.data = *rit;
+                        _join->join(out, left, right);
+                        _adaptor->output(out);
+                    }
+                }
+            }
+        }
     }
+    remove_tmp_file(p.file_name2);
 
-    // TODO: handle the file partitions now...
+    /* Give the right pages back. */
+    table.clear();
+    for(guard<qpipe::page> pg = right_pages; pg; pg = pg->next);
+    _memory.shrink(pages * page_bytes);
+}
 
+
+
+/**
+ * @brief Push the Bloom filter over the right keys into the left
+ * packet and dispatch the left packet. The pushdown filter takes
+ * ownership of the Bloom filter.
+ */
+void hash_join_stage_t::push_bloom_filter(hash_join_packet_t* packet,
+                                          bloom_filter_t* bloom) {
+
+    packet_t* left = packet->_left;
+    left->push_down_filter(new bloom_pushdown_filter_t(left->_output_filter, bloom,
+                                                       packet->_left_buffer->tuple_size(),
+                                                       _join->left_key_offset(),
+                                                       _join->key_size(),
+                                                       packet->query_memory()));
+    dispatcher_t::dispatch_packet(packet->_left);
 }
 
 
@@ -246,6 +413,14 @@ void hash_join_stage_t::test_overflow(int partition) {
     if(p._page && !p._page->full())
         return ;
     
+    /* A file partition has a single page; send it to the file. */
+    if(p.file) {
+        p._page->fwrite_full_page(p.file);
+        p._page->clear();
+        p.size++;
+        return;
+    }
+    
     
     /* A partition is either a list of in-memory pages strung together
        or a file on disk with one in-memory page. 'page_count' is the
@@ -253,71 +428,117 @@ void hash_join_stage_t::test_overflow(int partition) {
 
        As long as 'page_count' is less than 'page_quota', we grow
        in-memory partitions by simply tacking other pages onto the end
-       their lists. When 'page_count' reaches 'page_quota', we pick
-       the largest in-memory partition and turn it into a disk
-       partition. */
-    if(page_count == page_quota) {
-        
-        /* We need to flush to disk. We will flush the biggest
-           partition. */
+       their lists. When 'page_count' reaches 'page_quota', or the
+       query's memory account refuses another page, we pick the
+       largest in-memory partition and turn it into a disk partition,
+       until the page fits. The first page of a partition is always
+       granted; memory_needs() declares one per partition. */
+    size_t page_bytes = get_default_page_size();
+    while(!((page_count < page_quota)
+            && _memory.grow(page_bytes, p._page == NULL))) {
+        if(page_count < page_quota)
+            _memory.note_spill();
         
         /* Find the biggest in-memory partition. */
         int max = -1;
         for(unsigned i=0; i < partitions.size(); i++) {
-            partition_t &p = partitions[i];
-            if(!p.file && (max < 0 || p.size > partitions[max].size))
+            partition_t &pi = partitions[i];
+            if(!pi.file && pi._page && (max < 0 || pi.size > partitions[max].size))
                 max = i;
         }
 
-        /* Create a file on disk. */
-        partition_t &p = partitions[max];
-        p.file = create_tmp_file(p.file_name1, "hash-join-right");
+        /* Nothing left to flush. Only a first page gets here, take
+           it over the quota. */
+        if(max < 0) {
+            _memory.grow(page_bytes, true);
+            break;
+        }
+
+        spill_partition(max);
 
-        /* Send the partition to the file. */
-        guard<qpipe::page> head;
-        for(head = p._page; head->next; head=head->next) {
-            head->fwrite_full_page(p.file);
-            page_count--;
+        /* Flushing ourselves leaves a cleared page to append to */
+        if(max == partition) {
+            p.size++;
+            return;
         }
+    }
         
-        /* Write the last page, but don't free it. */
+    /* Add a page to the in-memory partition. */
+    qpipe::page* pg =
+        qpipe::page::alloc(_join->right_tuple_size());
+    pg->next = p._page;
+    p._page = pg;
+    page_count++;
+
+    // done!
+    p.size++;
+}
+
+
+
+/**
+ * @brief Turn in-memory partition (i) into a file partition. All its
+ * pages go to the file; the last one is kept, cleared, as the page of
+ * the file partition.
+ */
+void hash_join_stage_t::spill_partition(int i) {
+
+    partition_t &p = partitions[i];
+    assert(!p.file && p._page);
+    size_t page_bytes = get_default_page_size();
+
+    /* Create a file on disk. */
+    p.file = create_tmp_file(p.file_name1, "hash-join-right");
+
+    /* Send the partition to the file. */
+    guard<qpipe::page> head;
+    for(head = p._page; head->next; head=head->next) {
         head->fwrite_full_page(p.file);
-        head->clear();
-        p._page = head.release();
+        page_count--;
+        _memory.shrink(page_bytes);
     }
-    else {
         
-        /* No need to flush to disk. Simply add a page to the full
-           in-memory partition. */
-        qpipe::page* pg =
-            qpipe::page::alloc(_join->right_tuple_size());
-        pg->next = p._page;
-        p._page = pg;
-        page_count++;
+    /* Write the last page, but don't free it. */
+    head->fwrite_full_page(p.file);
+    head->clear();
+    p._page = head.release();
+}
+
+
+
+/**
+ * @brief Write the tuples left on the page of file partition (p) to
+ * its file and close the file. The page stays with the partition.
+ */
+void hash_join_stage_t::close_file(partition_t &p) {
+
+    file_guard_t file = p.file;
+    p.file = NULL;
+    if(!p._page->empty()) {
+        p._page->fwrite_full_page(file);
+        p._page->clear();
     }
+}
 
-    // done!
-    p.size++;
+
+
+FILE* hash_join_stage_t::open_tmp_file(c_str const &name) {
+
+    FILE* file = fopen(name.data(), "r");
+    if(file == NULL)
+        THROW3(FileException,
+               "Caught %s opening '%s'",
+               errno_to_str().data(), name.data());
+    return file;
 }
 
 
 
-template <class Action>
-void hash_join_stage_t::close_file(partition_list_t::iterator it, Action action) {
+void hash_join_stage_t::remove_tmp_file(c_str const &name) {
 
-    /* I think this function is supposed to have no effect if called
-       on an in-memory partition. If it is called on a file partition,
-       it is supposed to flush the partition to disk. */
-    qpipe::page *p = it->_page;
-    
-    /* File partition? */
-    /* Write remaining tuples to disk and apply 'action' to it. */
-    file_guard_t file = it->file;
-    if(!p || p->empty())
-        return;
-    
-    p->fwrite_full_page(file);
-    action(it);
+    if(remove(name.data()))
+        TRACE(TRACE_ALWAYS, "Unable to remove temp file %s\n", name.data());
+    TRACE(TRACE_TEMP_FILE, "Removed finished temp file %s\n", name.data());
 }
 
 EXIT_NAMESPACE(qpipe);
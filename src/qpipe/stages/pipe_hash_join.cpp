@@ -29,6 +29,7 @@
 
 
 #include "qpipe/stages/pipe_hash_join.h"
+#include "qpipe/common/bloom_pushdown.h"
 #include <cstring>
 #include <algorithm>
 
@@ -130,7 +131,14 @@ void pipe_hash_join_stage_t::process_packet() {
     tuple_fifo *right_buffer = packet->_right_buffer;
     dispatcher_t::dispatch_packet(packet->_right);
     tuple_fifo *left_buffer = packet->_left_buffer;
-    dispatcher_t::dispatch_packet(packet->_left);
+
+    /* If the left side is a scan, we give up pipelining on the right
+       side: read it completely first, then push a Bloom filter over
+       its keys into the scan so non-joining left tuples never reach
+       left_buffer. */
+    bool pushdown = bloom_pushdown_enabled() && packet->_left->accepts_pushdown();
+    if(!pushdown)
+        dispatcher_t::dispatch_packet(packet->_left);
 
     _join = packet->_join;
     tuple_t left(NULL, left_buffer->tuple_size());
@@ -166,6 +174,32 @@ void pipe_hash_join_stage_t::process_packet() {
 
     typedef qpipe::page::iterator pit;
     typedef tuple_hash_t::iterator hit;
+
+    if(pushdown) {
+        /* left_hash is empty, there is nothing to probe yet. The
+           filter is filled as the pages arrive and grown when full. */
+        bloom_filter_t* bloom = new bloom_filter_t(64 * 1024);
+        while(right_buffer->ensure_read_ready()) {
+            qpipe::page* p = qpipe::page::alloc(right_buffer->tuple_size());
+            right_buffer->copy_page(p);
+            right_pages.add(p);
+            for(pit it = p->begin(); it != p->end(); ++it) {
+                right_hash.insert_equal(it->data);
+                if(bloom->full())
+                    bloom->grow();
+                bloom->insert(hf(right_ke(it->data)));
+            }
+        }
+
+        packet_t* lp = packet->_left;
+        lp->push_down_filter(new bloom_pushdown_filter_t(lp->_output_filter, bloom,
+                                                         left_buffer->tuple_size(),
+                                                         _join->left_key_offset(),
+                                                         _join->key_size()));
+        dispatcher_t::dispatch_packet(packet->_left);
+        left_ready = left_buffer->check_read_ready();
+        right_ready = -1;
+    }
  do_left:
     if(left_ready == 1) {
 	// process a left page
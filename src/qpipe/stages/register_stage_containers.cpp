@@ -42,6 +42,7 @@ ENTER_NAMESPACE(qpipe);
 #define MAX_NUM_SORT_MERGE_JOIN_THREADS   MAX_NUM_CLIENTS
 #define MAX_NUM_FUNC_CALL_THREADS         MAX_NUM_CLIENTS
 #define MAX_NUM_SORT_THREADS              MAX_NUM_CLIENTS * 2 // Q16 uses two sorts
+#define MAX_NUM_TOPN_THREADS              MAX_NUM_CLIENTS
 #define MAX_NUM_SORTED_IN_STAGE_THREADS   MAX_NUM_CLIENTS
 
 
@@ -58,6 +59,7 @@ void register_stage_containers()
     register_stage<pipe_hash_join_stage_t>(MAX_NUM_CLIENTS, true);
     register_stage<func_call_stage_t>(MAX_NUM_FUNC_CALL_THREADS, true);
     register_stage<sort_stage_t>(MAX_NUM_SORT_THREADS, true);
+    register_stage<topn_stage_t>(MAX_NUM_TOPN_THREADS, true);
     register_stage<fdump_stage_t> (MAX_NUM_CLIENTS, true);
     register_stage<sorted_in_stage_t>(MAX_NUM_SORTED_IN_STAGE_THREADS, true);
     register_stage<echo_stage_t>(MAX_NUM_CLIENTS, true);
@@ -53,6 +53,13 @@ const unsigned int sort_stage_t::PAGES_PER_INITIAL_SORTED_RUN = 8 * 1024;
 
 
 
+size_t sort_packet_t::memory_needs() {
+    return packet_t::memory_needs()
+        + sort_stage_t::PAGES_PER_INITIAL_SORTED_RUN * _input_buffer->page_size();
+}
+
+
+
 static void flush_page(qpipe::page* pg, FILE* file);
 
 
@@ -425,9 +432,17 @@ void sort_stage_t::process_packet() {
         // TODO: check for stage cancellation at regular intervals
         
         page_trash_stack pages;
+        memory_grant_t run_memory(packet->query_memory());
         array.clear();
         for(unsigned int i=0; i < PAGES_PER_INITIAL_SORTED_RUN; i++) {
 
+            // cut the run short if the query is out of memory (the
+            // first page is always granted)
+            if(!run_memory.grow(_input_buffer->page_size(), i == 0)) {
+                run_memory.note_spill();
+                break;
+            }
+
             // read in a run of pages
             qpipe::page* p = qpipe::page::alloc(_input_buffer->tuple_size());
             if (!_input_buffer->copy_page(p)) {
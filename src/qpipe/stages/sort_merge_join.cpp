@@ -119,7 +119,7 @@ void sort_merge_join_stage_t::process_packet() {
         // As such, we will copy these right tuples to new pages, so that in
         // the end we can iterate through them for every left tuple.
         
-        page_pool* pool = malloc_page_pool::instance();
+        page_pool* pool = get_default_page_pool();
         qpipe::page* right_head_page = qpipe::page::alloc(_join->right_tuple_size(), pool);
         qpipe::page* right_page = right_head_page;
         
@@ -0,0 +1,92 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+#include "qpipe/stages/topn.h"
+
+#include <algorithm>
+#include <vector>
+
+
+
+const c_str topn_packet_t::PACKET_TYPE = "TOPN";
+
+
+
+const c_str topn_stage_t::DEFAULT_STAGE_NAME = "TOPN_STAGE";
+
+
+
+size_t topn_packet_t::memory_needs() {
+    return packet_t::memory_needs() + _limit * _input_buffer->tuple_size();
+}
+
+
+
+void topn_stage_t::process_packet() {
+
+    adaptor_t* adaptor = _adaptor;
+    topn_packet_t* packet = (topn_packet_t*)adaptor->get_packet();
+
+    tuple_fifo* input_buffer = packet->_input_buffer;
+    key_extractor_t* extract = packet->_extract;
+    size_t limit = packet->_limit;
+    dispatcher_t::dispatch_packet(packet->_input);
+
+
+    // The kept tuples live in (limit) slots. The heap orders them so
+    // that the last of them in the sort order is on top, and a new
+    // tuple that comes before it takes over its slot.
+    size_t tuple_size = input_buffer->tuple_size();
+    array_guard_t<char> slots = new char[limit * tuple_size];
+    std::vector<hint_tuple_pair_t> heap;
+    heap.reserve(limit);
+    tuple_less_t less(extract, packet->_compare);
+
+    tuple_t src;
+    while (input_buffer->get_tuple(src)) {
+        hint_tuple_pair_t in(extract->extract_hint(src), src.data);
+
+        if (heap.size() < limit) {
+            in.data = slots + heap.size() * tuple_size;
+            memcpy(in.data, src.data, tuple_size);
+            heap.push_back(in);
+            std::push_heap(heap.begin(), heap.end(), less);
+        }
+        else if (less(in, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), less);
+            in.data = heap.back().data;
+            memcpy(in.data, src.data, tuple_size);
+            heap.back() = in;
+            std::push_heap(heap.begin(), heap.end(), less);
+        }
+    }
+
+    // output the kept tuples in order
+    std::sort_heap(heap.begin(), heap.end(), less);
+    tuple_t out(NULL, tuple_size);
+    for (std::vector<hint_tuple_pair_t>::iterator it=heap.begin();
+         it != heap.end(); ++it) {
+        out.data = it->data;
+        adaptor->output(out);
+    }
+}
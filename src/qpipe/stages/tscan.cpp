@@ -58,13 +58,14 @@ tscan_packet_t::tscan_packet_t(const c_str&    packet_id,
                                ss_m*           db,
                                table_desc_t*   table,
                                xct_t*          pxct,
-                               lock_mode_t     lm)
+                               lock_mode_t     lm,
+                               const zone_range_t& range)
     : packet_t(packet_id, PACKET_TYPE, output_buffer, output_filter,
-               create_plan(output_filter, table),
+               create_plan(output_filter, table, range),
                true, /* merging allowed */
                true  /* unreserve worker on completion */
                ),
-      _db(db), _table(table), _xct(pxct), _lm(lm)
+      _db(db), _table(table), _xct(pxct), _lm(lm), _range(range)
 {
     assert(_db);
     assert(_table);
@@ -73,15 +74,18 @@ tscan_packet_t::tscan_packet_t(const c_str&    packet_id,
 
 
 query_plan* tscan_packet_t::create_plan(tuple_filter_t* filter, 
-                                        table_desc_t* table) 
+                                        table_desc_t* table,
+                                        const zone_range_t& range) 
 {
-    c_str action("%s:%s", PACKET_TYPE.data(), table->name());
+    // only scans that skip the same zones can share their output
+    c_str action("%s:%s%s", PACKET_TYPE.data(), table->name(),
+                 range.to_string().data());
     return new query_plan(action, filter->to_string(), NULL, 0);
 }
     
 void tscan_packet_t::declare_worker_needs(resource_declare_t* declare) 
 {
-    declare->declare(_packet_type, 1);
+    declare_self(declare);
     /* no inputs */
 }
 
@@ -118,8 +122,10 @@ void tscan_stage_t::process_packet()
     tscan_packet_t* packet = (tscan_packet_t*)adaptor->get_packet();
     smthread_t::me()->attach_xct(packet->_xct);
     
-    // Create and open scan
-    simple_table_iter_t tscanner(packet->_db, packet->_table, packet->_lm);
+    // Create and open scan, reading only the zones that may qualify
+    zone_scan_iter_t tscanner(packet->_db, packet->_table,
+                              packet->_table->zone_map(),
+                              packet->_range, packet->_lm);
     bool eof(false);
     pin_i* handle(NULL);
     uint pcnt=0;
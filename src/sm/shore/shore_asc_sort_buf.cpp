@@ -245,6 +245,7 @@ void asc_sort_man_impl::sort()
         }
         break;
     case SQL_INT:
+    case SQL_DATE:
         for (int i=0; i<_tuple_count; i++) {
             cout << ((int*)(_sort_buf+i*_tuple_size))[0] << " ";
         }
@@ -271,6 +272,7 @@ void asc_sort_man_impl::sort()
     case SQL_SMALLINT:
         qsort(_sort_buf, _tuple_count, _tuple_size, compare_smallint_asc); break;
     case SQL_INT:
+    case SQL_DATE:
         qsort(_sort_buf, _tuple_count, _tuple_size, compare_int_asc); break;
     case SQL_LONG:
             qsort(_sort_buf, _tuple_count, _tuple_size, compare_long_asc); break;
@@ -298,6 +300,7 @@ void asc_sort_man_impl::sort()
         };
         break;
     case SQL_INT:
+    case SQL_DATE:
         for (int i=0; i<_tuple_count; i++) {
             cout << ((int*)(_sort_buf+i*_tuple_size))[0] << " ";
         };
@@ -146,6 +146,19 @@ w_rc_t base_client_t::run_xcts(int xct_type, int num_xct)
 
         // case of duration-based measurement
     case (MT_TIME_DUR):
+
+        // one trx at a time, timing each
+        if (_latencies) {
+            while (!_abort_test && _env->get_measure() != MST_DONE) {
+                stopwatch_t timer;
+                W_COERCE(submit_batch(xct_type, i, 1));
+                _cp->wait();
+                if (_env->get_measure() == MST_MEASURE) {
+                    _latencies->add(timer.time());
+                }
+            }
+            break;
+        }
 	
 	// submit the first two batches...
 	W_COERCE(submit_batch(xct_type, i, batchsz));
@@ -246,6 +246,7 @@ void desc_sort_man_impl::sort()
         }
         break;
     case SQL_INT:
+    case SQL_DATE:
         for (int i=0; i<_tuple_count; i++) {
             cout << ((int*)(_sort_buf+i*_tuple_size))[0] << " ";
         }
@@ -272,6 +273,7 @@ void desc_sort_man_impl::sort()
     case SQL_SMALLINT:
         qsort(_sort_buf, _tuple_count, _tuple_size, compare_smallint_desc); break;
     case SQL_INT:
+    case SQL_DATE:
         qsort(_sort_buf, _tuple_count, _tuple_size, compare_int_desc); break;
     case SQL_LONG:
             qsort(_sort_buf, _tuple_count, _tuple_size, compare_long_desc); break;
@@ -299,6 +301,7 @@ void desc_sort_man_impl::sort()
         };
         break;
     case SQL_INT:
+    case SQL_DATE:
         for (int i=0; i<_tuple_count; i++) {
             cout << ((int*)(_sort_buf+i*_tuple_size))[0] << " ";
         };
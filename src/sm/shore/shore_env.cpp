@@ -34,6 +34,11 @@
 #include "sm/shore/shore_trx_worker.h"
 #include "sm/shore/shore_flusher.h"
 #include "sm/shore/shore_helper_loader.h"
+#include "sm/shore/shore_table.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 
 ENTER_NAMESPACE(shore);
@@ -99,7 +104,8 @@ ShoreEnv::ShoreEnv()
       _insert_freq(0),_delete_freq(0),_probe_freq(100),
       _request_pool(sizeof(trx_request_t)),
       _bUseSLI(false),_bUseELR(false),_bUseFlusher(false),
-      _bAlarmSet(false), _start_imbalance(0), _skew_type(SKEW_NONE)
+      _bAlarmSet(false), _start_imbalance(0), _skew_type(SKEW_NONE),
+      _skew_scenario(NULL)
 {
     _popts = new option_group_t(1);
     _pvid = new vid_t(1);
@@ -131,6 +137,11 @@ ShoreEnv::ShoreEnv()
         _pd |= PD_PADDED;
     }
 
+    // Column-group copies of the wide analytical tables
+    if (ev->getVarInt("physical-pax",0)) {
+        _pd |= PD_PAX;
+    }
+
 
     _bUseSLI = ev->getVarInt("db-worker-sli",0);
     fprintf(stdout, "SLI= %s\n", (_bUseSLI ? "enabled" : "disabled"));
@@ -367,6 +378,133 @@ void ShoreEnv::reset_skew()
 }
 
 
+/******************************************************************** 
+ *
+ *  @fn:    set_keydist
+ *  @brief: Sets the key distribution of the inputs
+ *
+ ********************************************************************/
+void ShoreEnv::set_keydist(const keydist_spec_t& spec)
+{
+    _keydist = spec;
+    TRACE( TRACE_ALWAYS, "Key distribution (%s)\n", 
+           _keydist.to_string().c_str());
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:    add_mix
+ *  @brief: Registers the default mix of trx (id), in effect until
+ *          set_mix() changes it
+ *
+ ********************************************************************/
+void ShoreEnv::add_mix(const int id, const trx_mix_t& mix)
+{
+    assert ((id >= 0) && !mix.empty());
+    if ((int)_mixes.size() <= id) {
+        _mixes.resize(id+1);
+        _default_mixes.resize(id+1);
+    }
+    _mixes[id] = mix;
+    _default_mixes[id] = mix;
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:    set_mix
+ *  @brief: Replaces mix (id) with (spec), or its default
+ *
+ ********************************************************************/
+bool ShoreEnv::set_mix(const int id, const char* spec)
+{
+    if ((id < 0) || (id >= (int)_default_mixes.size()) || 
+        _default_mixes[id].empty()) {
+        TRACE( TRACE_ALWAYS, "(%d) is not a mix\n", id);
+        return (false);
+    }
+
+    trx_mix_t mix;
+    if (strcmp(spec, "default") == 0) {
+        mix = _default_mixes[id];
+    }
+    else if (!mix.parse(spec)) {
+        TRACE( TRACE_ALWAYS, "Invalid mix (%s)\n", spec);
+        return (false);
+    }
+
+    const std::vector<int>& trxs = mix.trxs();
+    for (uint i=0; i<trxs.size(); i++) {
+        if (is_mix(trxs[i]) || !has_trx(trxs[i])) {
+            TRACE( TRACE_ALWAYS, "Mix (%d) cannot run (%d)\n", id, trxs[i]);
+            return (false);
+        }
+    }
+
+    if (!_install_mix(id, mix))
+        return (false);
+    TRACE( TRACE_ALWAYS, "Mix (%d) = (%s)\n", id, mix.to_string().c_str());
+    return (true);
+}
+
+
+bool ShoreEnv::_install_mix(const int id, const trx_mix_t& mix)
+{
+    _mixes[id] = mix;
+    return (true);
+}
+
+
+void ShoreEnv::print_mixes() const
+{
+    for (uint i=0; i<_mixes.size(); i++) {
+        if (_mixes[i].empty()) continue;
+        TRACE( TRACE_ALWAYS, "Mix (%d) = (%s)\n", i, 
+               _mixes[i].to_string().c_str());
+    }
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:    start_skew_scenario
+ *  @brief: Starts a thread that sets the key distribution of each 
+ *          phase in turn
+ *
+ ********************************************************************/
+int ShoreEnv::start_skew_scenario(const std::vector<skew_phase_t>& phases, 
+                                  const bool loop)
+{
+    if (phases.empty()) return (1);
+    stop_skew_scenario();
+
+    TRACE( TRACE_ALWAYS, "Starting skew scenario. %d phases%s\n",
+           (int)phases.size(), (loop? ", looping" : ""));
+    _skew_scenario = new skew_scenario_t(this, phases, loop);
+    _skew_scenario->fork();
+    return (0);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:    stop_skew_scenario
+ *  @brief: Stops the running scenario, if any, and prints its results.
+ *          The key distribution stays as the scenario left it.
+ *
+ ********************************************************************/
+void ShoreEnv::stop_skew_scenario()
+{
+    if (!_skew_scenario) return;
+    _skew_scenario->stop();
+    _skew_scenario->join();
+    _skew_scenario->print_results();
+    delete (_skew_scenario);
+    _skew_scenario = NULL;
+}
+
+
 /******************************************************************** 
  *
  *  @fn:    Related to environment workers
@@ -500,6 +638,23 @@ int ShoreEnv::start()
     // read from env params the loopcnt
     int lc = envVar::instance()->getVarInt("db-worker-queueloops",0);    
 
+    // the key distribution of this configuration, if any
+    keydist_t::seed(envVar::instance()->getVarInt("keydist-seed",0));
+    string kd = envVar::instance()->getSysVar("keydist");
+    keydist_spec_t spec;
+    if ((kd != "invalid") && !spec.parse(kd.c_str()))
+        TRACE( TRACE_ALWAYS, "Invalid keydist (%s). Using uniform\n", kd.c_str());
+    set_keydist(spec);
+
+    // the mixes of this configuration, if any (<config>-mix-<id>)
+    for (uint i=0; i<_default_mixes.size(); i++) {
+        if (_default_mixes[i].empty()) continue;
+        string mix = envVar::instance()->getSysVar(c_str("mix-%d",i).data());
+        if ((mix != "invalid") && !set_mix(i, mix.c_str()))
+            TRACE( TRACE_ALWAYS, "Keeping mix (%d) = (%s)\n", i,
+                   _mixes[i].to_string().c_str());
+    }
+
 #ifdef CFG_FLUSHER
     _start_flusher();
 #endif
@@ -548,6 +703,8 @@ int ShoreEnv::stop()
         return (1);
     }
 
+    stop_skew_scenario();
+
     // Stop workers
     int i=0;
     for (WorkerIt it = _workers.begin(); it != _workers.end(); ++it) {
@@ -1268,6 +1425,149 @@ int ShoreEnv::_stop_flusher()
 }
 
 
+/****************************************************************** 
+ *
+ *  @fn:    _sync_zone_maps()
+ *
+ *  @brief: The zone maps are kept in memory. Their copy on disk is
+ *          written when the environment stops, and marked stale when
+ *          it starts again, so that a crash makes the next startup
+ *          rebuild them.
+ *
+ ******************************************************************/
+
+w_rc_t ShoreEnv::_sync_zone_maps(table_desc_t* const* tables, const uint count,
+                                 const bool save)
+{
+    bool any = false;
+    for (uint i=0; i<count; i++)
+        if (tables[i] && tables[i]->zone_map()) any = true;
+    if (!any || !_initialized)
+        return (RCOK);
+
+    W_DO(db()->begin_xct());
+    for (uint i=0; i<count; i++) {
+        if (!tables[i] || !tables[i]->zone_map()) continue;
+        zone_map_t* zmap = tables[i]->zone_map();
+        w_rc_t e = (save? zmap->save(db()) : zmap->invalidate(db()));
+        if (e.is_error()) {
+            W_DO(db()->abort_xct());
+            return (e);
+        }
+    }
+    W_DO(db()->commit_xct());
+    return (RCOK);
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    _build_pax_stores()
+ *
+ *  @brief: The PAX copies are not maintained by the writes, they are
+ *          rebuilt in bulk once loading finishes, or at start if the
+ *          tables changed since
+ *
+ ******************************************************************/
+
+w_rc_t ShoreEnv::_build_pax_stores(table_man_t* const* managers, const uint count)
+{
+    for (uint i=0; i<count; i++) {
+        if (!managers[i]) continue;
+        pax_store_t* pax = managers[i]->table()->pax_store();
+        if (pax && !pax->is_current()) {
+            W_DO(pax->build(db(), managers[i]));
+        }
+    }
+    return (RCOK);
+}
+
+
+
+/****************************************************************** 
+ *
+ *  @fn:    _defer_indexes()
+ *
+ *  @brief: If "db-bulk-index" is set, the tables of (managers) are
+ *          loaded heap first, and _bulk_build_indexes() fills their
+ *          indexes once the loaders are done. The PLP designs place
+ *          the records through the primary index, so they are left
+ *          as they are.
+ *
+ ******************************************************************/
+
+bool ShoreEnv::_defer_indexes(table_man_t* const* managers, const uint count)
+{
+    if (!envVar::instance()->getVarInt("db-bulk-index",0))
+        return (false);
+
+    for (uint i=0; i<count; i++) {
+        if (!managers[i]) continue;
+        table_desc_t* ptable = managers[i]->table();
+        if (ptable->get_pd() & (PD_MRBT_PART | PD_MRBT_LEAF)) continue;
+        ptable->set_defer_indexes(true);
+    }
+    return (true);
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    _bulk_build_indexes()
+ *
+ *  @brief: Builds every deferred index of (managers), each from its
+ *          own sorted scan of the heap. Up to "db-loaders" indexes 
+ *          are built at the same time.
+ *
+ ******************************************************************/
+
+w_rc_t ShoreEnv::_bulk_build_indexes(table_man_t* const* managers, const uint count)
+{
+    std::vector<table_man_t*>  owners;
+    std::vector<index_desc_t*> todo;
+    for (uint i=0; i<count; i++) {
+        if (!managers[i] || !managers[i]->table()->defer_indexes()) continue;
+        managers[i]->table()->set_defer_indexes(false);
+        for (index_desc_t* pindex = managers[i]->table()->indexes(); 
+             pindex; pindex = pindex->next()) {
+            owners.push_back(managers[i]);
+            todo.push_back(pindex);
+        }
+    }
+    if (todo.empty())
+        return (RCOK);
+
+    uint builders = envVar::instance()->getVarInt("db-loaders",10);
+    if (builders < 1) builders = 1;
+    TRACE( TRACE_ALWAYS, "Building %d indexes, %d at a time ..\n", 
+           (int)todo.size(), builders);
+
+    time_t tstart = time(NULL);
+    int failed = 0;
+    for (uint first=0; first<todo.size(); first+=builders) {
+        uint last = std::min((size_t)(first+builders), todo.size());
+        std::vector<index_building_smt_t*> threads;
+        for (uint i=first; i<last; i++) {
+            threads.push_back(new index_building_smt_t(c_str("ib-%d",i), db(),
+                                                       owners[i], todo[i]));
+            threads.back()->fork();
+        }
+        for (uint i=0; i<threads.size(); i++) {
+            threads[i]->join();
+            failed += threads[i]->rv();
+            delete (threads[i]);
+        }
+    }
+    if (failed)
+        return (RC(se_ERROR_IN_IDX_LOAD));
+
+    TRACE( TRACE_ALWAYS, "Indexes built in (%d) secs...\n", 
+           (time(NULL) - tstart));
+    return (RCOK);
+}
+
+
+
 /****************************************************************** 
  *
  *  @fn:    to_base_flusher()
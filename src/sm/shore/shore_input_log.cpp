@@ -0,0 +1,356 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_input_log.cpp
+ *
+ *  @brief:  Implementation of the recording and replay of the client
+ *           input streams
+ */
+
+#include "sm/shore/shore_input_log.h"
+
+#include <cstring>
+
+
+ENTER_NAMESPACE(shore);
+
+
+static const char INPUT_LOG_MAGIC[4] = { 'S', 'K', 'I', 'L' };
+static const int  INPUT_LOG_VERSION  = 1;
+
+// the stdio buffer of each log
+static const size_t INPUT_LOG_BUFSZ  = 1<<16;
+
+
+string input_log_name(const char* var, const int id)
+{
+    string prefix = envVar::instance()->getVar(var,"");
+    if (prefix.empty()) return (prefix);
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), ".%d", id);
+    return (prefix + suffix);
+}
+
+
+static inline ulong_t _zigzag(const int v)
+{
+    return ((ulong_t)((v << 1) ^ (v >> 31)) & 0xFFFFFFFFul);
+}
+
+static inline int _unzigzag(const ulong_t v)
+{
+    return ((int)(v >> 1) ^ -(int)(v & 1));
+}
+
+
+
+/******************************************************************
+ *
+ *  input_log_writer_t
+ *
+ ******************************************************************/
+
+input_log_writer_t::input_log_writer_t()
+    : _f(NULL), _last_usecs(0), _records(0)
+{ }
+
+input_log_writer_t::~input_log_writer_t()
+{
+    if (!_f) return;
+    fclose(_f);
+    TRACE( TRACE_STATISTICS, "Recorded (%lu) inputs to (%s)\n",
+           _records, _fname.c_str());
+}
+
+
+bool input_log_writer_t::open(const string& fname, const int xct_type,
+                              const double qf, const int sel)
+{
+    assert (!_f);
+    _f = fopen(fname.c_str(), "wb");
+    if (!_f) return (false);
+    _fname = fname;
+    setvbuf(_f, NULL, _IOFBF, INPUT_LOG_BUFSZ);
+
+    input_log_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr._magic, INPUT_LOG_MAGIC, sizeof(hdr._magic));
+    hdr._version  = INPUT_LOG_VERSION;
+    hdr._xct_type = xct_type;
+    hdr._sel      = sel;
+    hdr._qf       = qf;
+    return (fwrite(&hdr, sizeof(hdr), 1, _f) == 1);
+}
+
+
+void input_log_writer_t::_put_varint(ulong_t v)
+{
+    while (v >= 0x80) {
+        putc((int)(v & 0x7F) | 0x80, _f);
+        v >>= 7;
+    }
+    putc((int)v, _f);
+}
+
+
+/******************************************************************
+ *
+ *  @fn:    write
+ *
+ *  @brief: Appends one record. Most of an input is zeros (unused
+ *          string tails, placeholders), so its bytes go as runs of
+ *          literals, each followed by the zeros after it.
+ *
+ ******************************************************************/
+
+void input_log_writer_t::write(const prepared_input_t* pin,
+                               const long long usecs)
+{
+    assert (_f && pin && pin->_input);
+    assert (usecs >= _last_usecs);
+
+    _put_varint((ulong_t)(usecs - _last_usecs));
+    _last_usecs = usecs;
+    _put_varint((ulong_t)pin->_type);
+    _put_varint(_zigzag(pin->_spec));
+    _put_varint(pin->_input_sz);
+
+    const char* in = (const char*)pin->_input;
+    size_t i = 0;
+    while (i < pin->_input_sz) {
+        size_t lit = i;
+        while ((i < pin->_input_sz) && in[i]) ++i;
+        _put_varint(i - lit);
+        fwrite(in + lit, 1, i - lit, _f);
+
+        size_t zeros = i;
+        while ((i < pin->_input_sz) && !in[i]) ++i;
+        _put_varint(i - zeros);
+    }
+    ++_records;
+}
+
+
+
+/******************************************************************
+ *
+ *  input_log_reader_t
+ *
+ ******************************************************************/
+
+input_log_reader_t::input_log_reader_t()
+    : _f(NULL), _first(0), _last_usecs(0)
+{
+    memset(&_hdr, 0, sizeof(_hdr));
+}
+
+input_log_reader_t::~input_log_reader_t()
+{
+    if (_f) fclose(_f);
+}
+
+
+bool input_log_reader_t::open(const string& fname)
+{
+    assert (!_f);
+    _f = fopen(fname.c_str(), "rb");
+    if (!_f) return (false);
+    _fname = fname;
+    setvbuf(_f, NULL, _IOFBF, INPUT_LOG_BUFSZ);
+
+    if ((fread(&_hdr, sizeof(_hdr), 1, _f) != 1) ||
+        memcmp(_hdr._magic, INPUT_LOG_MAGIC, sizeof(_hdr._magic)) ||
+        (_hdr._version != INPUT_LOG_VERSION)) {
+        TRACE( TRACE_ALWAYS, "(%s) is not an input log\n", fname.c_str());
+        fclose(_f);
+        _f = NULL;
+        return (false);
+    }
+    _first = ftell(_f);
+    return (true);
+}
+
+
+bool input_log_reader_t::_get_varint(ulong_t& v)
+{
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = getc(_f);
+        if (c == EOF) return (false);
+        v |= (ulong_t)(c & 0x7F) << shift;
+        if (!(c & 0x80)) return (true);
+    }
+    return (false);
+}
+
+
+bool input_log_reader_t::next(replayed_input_t* slot)
+{
+    assert (_f && slot);
+    ulong_t delta, type, spec, sz;
+    if (!_get_varint(delta)) return (false);
+    if (!_get_varint(type) || !_get_varint(spec) || !_get_varint(sz)) {
+        TRACE( TRACE_ALWAYS, "(%s) is truncated\n", _fname.c_str());
+        return (false);
+    }
+
+    // malloc'ed, so aligned for any input
+    if (slot->_cap < sz) {
+        slot->_buf = (char*)realloc(slot->_buf, sz);
+        assert (slot->_buf);
+        slot->_cap = sz;
+    }
+
+    size_t i = 0;
+    while (i < sz) {
+        ulong_t lit, zeros;
+        if (!_get_varint(lit) || (i + lit > sz) ||
+            (fread(slot->_buf + i, 1, lit, _f) != lit)) {
+            TRACE( TRACE_ALWAYS, "(%s) is truncated\n", _fname.c_str());
+            return (false);
+        }
+        i += lit;
+        if (!_get_varint(zeros) || (i + zeros > sz)) {
+            TRACE( TRACE_ALWAYS, "(%s) is truncated\n", _fname.c_str());
+            return (false);
+        }
+        memset(slot->_buf + i, 0, zeros);
+        i += zeros;
+    }
+
+    _last_usecs += delta;
+    slot->_usecs    = _last_usecs;
+    slot->_type     = (int)type;
+    slot->_spec     = _unzigzag(spec);
+    slot->_input    = slot->_buf;
+    slot->_input_sz = sz;
+    return (true);
+}
+
+
+void input_log_reader_t::rewind()
+{
+    assert (_f);
+    clearerr(_f);
+    fseek(_f, _first, SEEK_SET);
+    _last_usecs = 0;
+}
+
+
+
+/******************************************************************
+ *
+ *  input_replay_ring_t
+ *
+ ******************************************************************/
+
+input_replay_ring_t::input_replay_ring_t(const int capacity, const int xct_type,
+                                         const double qf, const int sel)
+    : input_ring_t(capacity, xct_type, qf, sel),
+      _capacity(capacity), _base_usecs(0), _last_usecs(0)
+{
+    _slots = new replayed_input_t[capacity];
+    _exact = true;
+    _paced = (envVar::instance()->getVarInt("db-cl-replay-timing",0) != 0);
+}
+
+input_replay_ring_t::~input_replay_ring_t()
+{
+    _stop_generator();
+    delete [] _slots;
+}
+
+
+bool input_replay_ring_t::start(const string& fname)
+{
+    if (!_reader.open(fname)) return (false);
+
+    const input_log_header_t& hdr = _reader.header();
+    if (hdr._xct_type != _xct_type) {
+        TRACE( TRACE_ALWAYS, "(%s) was recorded for trx (%d), not (%d)\n",
+               fname.c_str(), hdr._xct_type, _xct_type);
+        return (false);
+    }
+    if ((hdr._qf != _qf) || (hdr._sel != _sel)) {
+        TRACE( TRACE_ALWAYS, "(%s) was recorded with QF (%.1f) Sel (%d)\n",
+               fname.c_str(), hdr._qf, hdr._sel);
+    }
+
+    // an empty log would have the generator spin
+    replayed_input_t probe;
+    if (!_reader.next(&probe)) {
+        TRACE( TRACE_ALWAYS, "(%s) has no inputs\n", fname.c_str());
+        return (false);
+    }
+    _reader.rewind();
+
+    std::vector<prepared_input_t*> slots;
+    for (int i=0; i<_capacity; i++) slots.push_back(&_slots[i]);
+    _start(slots);
+    return (true);
+}
+
+
+/******************************************************************
+ *
+ *  @fn:    _prepare
+ *
+ *  @brief: Reads the next input of the log, from the top once it is
+ *          over, as if the recording went on
+ *
+ ******************************************************************/
+
+void input_replay_ring_t::_prepare(prepared_input_t* pin)
+{
+    replayed_input_t* slot = static_cast<replayed_input_t*>(pin);
+    if (!_reader.next(slot)) {
+        TRACE( TRACE_DEBUG, "Replaying the log again\n");
+        _base_usecs = _last_usecs;
+        _reader.rewind();
+        bool ok = _reader.next(slot);
+        assert (ok);
+    }
+    slot->_usecs += _base_usecs;
+    _last_usecs = slot->_usecs;
+}
+
+
+input_ring_t* new_replay_ring(const int id, const int xct_type,
+                              const double qf, const int sel)
+{
+    string fname = input_log_name("db-cl-replay", id);
+    if (fname.empty()) return (NULL);
+
+    input_replay_ring_t* ring =
+        new input_replay_ring_t(input_ring_t::ring_size(), xct_type, qf, sel);
+    if (!ring->start(fname)) {
+        TRACE( TRACE_ALWAYS, "Cannot replay (%s), generating the inputs\n",
+               fname.c_str());
+        delete (ring);
+        return (NULL);
+    }
+    return (ring);
+}
+
+
+EXIT_NAMESPACE(shore);
@@ -0,0 +1,271 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_input_ring.cpp
+ *
+ *  @brief:  Implementation of the per-client input rings
+ */
+
+#include "sm/shore/shore_input_ring.h"
+#include "sm/shore/shore_input_log.h"
+
+#include <list>
+#include <unistd.h>
+
+
+ENTER_NAMESPACE(shore);
+
+
+// all the rings, for the stats, and what the deleted ones did since
+// the last reset
+static pthread_mutex_t   _rings_mutex = PTHREAD_MUTEX_INITIALIZER;
+static std::list<input_ring_t*> _rings;
+static input_ring_t::stats_t    _retired;
+
+
+void prepared_input_t::release()
+{
+    if (_ring) _ring->give_back(this);
+}
+
+
+
+/****************************************************************** 
+ *
+ *  input_ring_t
+ *
+ ******************************************************************/
+
+input_ring_t::input_ring_t(const int capacity, const int xct_type,
+                           const double qf, const int sel)
+    : _ready(capacity), _free(capacity), _stop(false),
+      _generated(0), _gen_secs(0), _taken(0), _misses(0), _t0(-1),
+      _xct_type(xct_type), _qf(qf), _sel(sel), _exact(false), _paced(false)
+{
+    assert (capacity > 0);
+    CRITICAL_SECTION(cs, _rings_mutex);
+    _rings.push_back(this);
+}
+
+input_ring_t::~input_ring_t()
+{
+    assert (!_generator);
+    CRITICAL_SECTION(cs, _rings_mutex);
+    _retired += _get_stats();
+    _rings.remove(this);
+}
+
+
+void input_ring_t::_start(const std::vector<prepared_input_t*>& slots)
+{
+    for (uint i=0; i<slots.size(); i++) {
+        slots[i]->_ring = this;
+        bool ok = _free.push(slots[i]);
+        assert (ok);
+    }
+
+    _generator = new generator_t(c_str("input-gen"), this);
+    _generator->fork();
+}
+
+void input_ring_t::_stop_generator()
+{
+    if (!_generator) return;
+    _stop = true;
+    _generator->join();
+    _generator.done();
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    _generate
+ *
+ *  @brief: The generator thread, fills in the free slots until
+ *          stopped
+ *
+ ******************************************************************/
+
+void input_ring_t::_generate()
+{
+    prepared_input_t* pin = NULL;
+    while (!_stop) {
+        if (!_free.pop(pin)) {
+            usleep(100);
+            continue;
+        }
+        stopwatch_t timer;
+        pin->_spec = _sel;
+        _prepare(pin);
+        _gen_secs += timer.time();
+        ++_generated;
+
+        // it holds all the slots, so there is room
+        bool ok = _ready.push(pin);
+        assert (ok);
+    }
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    take
+ *
+ *  @brief: The next ready input. When recording, it goes to the log
+ *          along with when it was taken; when replaying at the
+ *          recorded times, the client sleeps until it is due.
+ *
+ ******************************************************************/
+
+prepared_input_t* input_ring_t::take(const int xct_type)
+{
+    prepared_input_t* pin = NULL;
+    if (xct_type != _xct_type) {
+        ++_misses;
+        return (NULL);
+    }
+    if (!_ready.pop(pin)) {
+        if (!_exact) {
+            ++_misses;
+            return (NULL);
+        }
+        while (!_ready.pop(pin)) usleep(10);
+    }
+    ++_taken;
+
+    long long now = _clock.now();
+    if (_t0 < 0) _t0 = now;
+
+    if (_paced) {
+        long long due = _t0 + pin->_usecs;
+        if (due > now) usleep(due - now);
+    }
+    else if (_log) {
+        _log->write(pin, now - _t0);
+    }
+    return (pin);
+}
+
+void input_ring_t::give_back(prepared_input_t* pin)
+{
+    assert (pin && (pin->_ring == this));
+    bool ok = _free.push(pin);
+    assert (ok);
+}
+
+
+void input_ring_t::record(const int id)
+{
+    string fname = input_log_name("db-cl-record", id);
+    if (fname.empty()) return;
+
+    _log = new input_log_writer_t();
+    if (!_log->open(fname, _xct_type, _qf, _sel)) {
+        TRACE( TRACE_ALWAYS, "Cannot record to (%s)\n", fname.c_str());
+        _log.done();
+        return;
+    }
+    _exact = true;
+}
+
+
+int input_ring_t::ring_size()
+{
+    envVar* ev = envVar::instance();
+    int sz = ev->getVarInt("db-cl-input-ring",DF_INPUT_RING_SZ);
+    if ((sz < DF_LOGGED_RING_SZ) && 
+        (!ev->getVar("db-cl-record","").empty() ||
+         !ev->getVar("db-cl-replay","").empty())) {
+        sz = DF_LOGGED_RING_SZ;
+    }
+    return (sz);
+}
+
+
+
+/****************************************************************** 
+ *
+ *  Stats
+ *
+ ******************************************************************/
+
+input_ring_t::stats_t input_ring_t::_get_stats() const
+{
+    stats_t s;
+    s.generated = *&_generated - _last.generated;
+    s.gen_secs  = *&_gen_secs  - _last.gen_secs;
+    s.taken     = *&_taken     - _last.taken;
+    s.misses    = *&_misses    - _last.misses;
+    return (s);
+}
+
+void input_ring_t::reset_stats()
+{
+    CRITICAL_SECTION(cs, _rings_mutex);
+    _retired = stats_t();
+    for (std::list<input_ring_t*>::iterator it = _rings.begin();
+         it != _rings.end(); ++it) {
+        input_ring_t* r = *it;
+        r->_last.generated = *&r->_generated;
+        r->_last.gen_secs  = *&r->_gen_secs;
+        r->_last.taken     = *&r->_taken;
+        r->_last.misses    = *&r->_misses;
+    }
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    print_stats
+ *
+ *  @brief: Prints how many inputs the rings generated in (secs), how
+ *          long an input took to generate, and how many trxs found
+ *          no input ready and had it generated by their worker
+ *
+ ******************************************************************/
+
+void input_ring_t::print_stats(const double secs)
+{
+    CRITICAL_SECTION(cs, _rings_mutex);
+
+    stats_t total = _retired;
+    for (std::list<input_ring_t*>::iterator it = _rings.begin();
+         it != _rings.end(); ++it) {
+        total += (*it)->_get_stats();
+    }
+    if (total.generated == 0 && total.misses == 0) return;
+
+    TRACE( TRACE_ALWAYS, "*******\n"                \
+           "InpGen:    (%lu)\n"                     \
+           "InpGen/s:  (%.2f)\n"                    \
+           "InpUsecs:  (%.2f)\n"                    \
+           "InpTaken:  (%lu)\n"                     \
+           "InpMisses: (%lu)\n",
+           total.generated,
+           (secs > 0 ? total.generated/secs : 0),
+           (total.generated ? 1e6*total.gen_secs/total.generated : 0),
+           total.taken, total.misses);
+}
+
+
+EXIT_NAMESPACE(shore);
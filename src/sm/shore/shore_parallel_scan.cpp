@@ -0,0 +1,357 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_parallel_scan.cpp
+ *
+ *  @brief:  Implementation of the intra-query parallel file scans
+ *
+ */
+
+#include "sm/shore/shore_parallel_scan.h"
+#include "sm/shore/shore_table.h"
+
+#include <cstring>
+
+
+ENTER_NAMESPACE(shore);
+
+
+/******************************************************************
+ *
+ * @struct: scan_morsel_t
+ *
+ ******************************************************************/
+
+void scan_morsel_t::add(const char* body, uint sz)
+{
+    /* keep every record int-aligned for the field loads */
+    uint offset = (_data.size() + 7) & ~7u;
+    _data.resize(offset + sz);
+    memcpy(&_data[offset], body, sz);
+    _offsets.push_back(offset);
+}
+
+
+
+/******************************************************************
+ *
+ * @class: parallel_scan_t
+ *
+ ******************************************************************/
+
+parallel_scan_t::parallel_scan_t(ss_m* db, file_desc_t* file,
+                                 scan_helper_pool_t* pool, lock_mode_t alm)
+    : _db(db), _file(file), _lm(alm), _pool(pool), _zones(NULL), _pax(NULL),
+      _lock(thread_mutex_create()), _cond(thread_cond_create()),
+      _done(false), _helpers(0)
+{
+    assert (_db);
+    assert (_file);
+}
+
+
+parallel_scan_t::parallel_scan_t(ss_m* db, table_desc_t* table,
+                                 const zone_range_t& range,
+                                 scan_helper_pool_t* pool, lock_mode_t alm)
+    : _db(db), _file(table), _lm(alm), _pool(pool),
+      _zones(table->zone_map()), _range(range), _pax(NULL),
+      _lock(thread_mutex_create()), _cond(thread_cond_create()),
+      _done(false), _helpers(0)
+{
+    assert (_db);
+    assert (_file);
+}
+
+
+parallel_scan_t::parallel_scan_t(ss_m* db, pax_store_t* pax,
+                                 scan_helper_pool_t* pool, lock_mode_t alm)
+    : _db(db), _file(pax->file()), _lm(alm), _pool(pool),
+      _zones(NULL), _pax(pax),
+      _lock(thread_mutex_create()), _cond(thread_cond_create()),
+      _done(false), _helpers(0)
+{
+    assert (_db);
+    assert (_file);
+}
+
+
+parallel_scan_t::~parallel_scan_t()
+{
+    assert (_helpers == 0);
+    for (uint i=0; i<_full.size(); i++)
+        delete (_full[i]);
+    for (uint i=0; i<_free.size(); i++)
+        delete (_free[i]);
+    thread_cond_destroy(_cond);
+    thread_mutex_destroy(_lock);
+}
+
+
+int parallel_scan_t::degree(scan_helper_pool_t* pool)
+{
+    return (1 + (pool? pool->size() : 0));
+}
+
+
+/******************************************************************
+ *
+ * @fn:     run()
+ *
+ * @brief:  Reads the file a morsel at a time and queues the morsels
+ *          for the helpers. When every morsel buffer is queued the
+ *          caller consumes one itself instead of waiting, so the scan
+ *          never runs slower than the serial one.
+ *
+ ******************************************************************/
+
+w_rc_t parallel_scan_t::run(std::vector<scan_consumer_t*>& consumers)
+{
+    assert (!consumers.empty());
+    assert (_helpers == 0);
+
+    _done = false;
+    int helpers = 0;
+    if (_pool && (consumers.size() > 1)) {
+        critical_section_t cs(_lock);
+        _helpers = _pool->enlist(this, consumers);
+        helpers = _helpers;
+    }
+
+    /* enough buffers that nobody waits for the reader */
+    uint const max_morsels = 2*(helpers+1);
+    uint morsels = 0;
+
+    zone_scan_iter_t scanner(_db, _file, _zones, _range, _lm);
+    pin_i* handle(NULL);
+    bool eof(false);
+    w_rc_t e = scanner.next(eof, handle);
+
+    while (!e.is_error() && !eof) {
+
+        // 1. Get an empty morsel, or do some of the work while there is none
+        scan_morsel_t* morsel = _get_free();
+        if (!morsel && (morsels < max_morsels)) {
+            morsel = new scan_morsel_t();
+            morsels++;
+        }
+        if (!morsel) {
+            critical_section_t cs(_lock);
+            while (_full.empty() && _free.empty())
+                thread_cond_wait(_cond, _lock);
+            if (!_full.empty()) {
+                scan_morsel_t* work = _full.back();
+                _full.pop_back();
+                cs.exit();
+                _consume(work, consumers[0]);
+            }
+            continue;
+        }
+
+        // 2. Fill it with the next pages
+        uint pages = 0;
+        lpid_t last_pid = handle->rid().pid;
+        while (!e.is_error() && !eof) {
+            if (handle->rid().pid != last_pid) {
+                if (++pages == MORSEL_PAGES)
+                    break;
+                last_pid = handle->rid().pid;
+            }
+            morsel->add((const char*)handle->body(), handle->body_size());
+            e = scanner.next(eof, handle);
+        }
+
+        // 3. Queue it
+        critical_section_t cs(_lock);
+        _full.insert(_full.begin(), morsel);
+        thread_cond_broadcast(_cond);
+    }
+
+    // Nothing more to read, help draining the queue
+    {
+        critical_section_t cs(_lock);
+        _done = true;
+        thread_cond_broadcast(_cond);
+    }
+    while (true) {
+        critical_section_t cs(_lock);
+        if (_full.empty())
+            break;
+        scan_morsel_t* work = _full.back();
+        _full.pop_back();
+        cs.exit();
+        _consume(work, consumers[0]);
+    }
+
+    // Wait for the helpers to finish their last morsels
+    critical_section_t cs(_lock);
+    while (_helpers > 0)
+        thread_cond_wait(_cond, _lock);
+    cs.exit();
+
+    if (e.is_error()) {
+        TRACE( TRACE_ALWAYS, "Parallel scan of (%s) failed\n", _file->name());
+    }
+    else if (scanner.skipped()) {
+        TRACE( TRACE_STATISTICS, "Skipped (%d) zones of (%s)\n",
+               scanner.skipped(), _file->name());
+    }
+    return (e);
+}
+
+
+void parallel_scan_t::help(scan_consumer_t* consumer)
+{
+    assert (consumer);
+    while (true) {
+        critical_section_t cs(_lock);
+        while (_full.empty() && !_done)
+            thread_cond_wait(_cond, _lock);
+        if (_full.empty()) {
+            // done, let the caller know
+            _helpers--;
+            thread_cond_broadcast(_cond);
+            return;
+        }
+        scan_morsel_t* work = _full.back();
+        _full.pop_back();
+        cs.exit();
+        _consume(work, consumer);
+    }
+}
+
+
+void parallel_scan_t::_consume(scan_morsel_t* morsel, scan_consumer_t* consumer)
+{
+    if (_pax) {
+        // skip the header of the PAX file
+        pax_block_t block;
+        for (uint i=0; i<morsel->count(); i++) {
+            if (!pax_store_t::is_block(morsel->record(i))) continue;
+            block.set(_pax, morsel->record(i));
+            consumer->consume_block(block);
+        }
+    }
+    else {
+        for (uint i=0; i<morsel->count(); i++)
+            consumer->consume(morsel->record(i));
+    }
+    _put_free(morsel);
+}
+
+
+scan_morsel_t* parallel_scan_t::_get_free()
+{
+    critical_section_t cs(_lock);
+    if (_free.empty())
+        return (NULL);
+    scan_morsel_t* morsel = _free.back();
+    _free.pop_back();
+    morsel->clear();
+    return (morsel);
+}
+
+
+void parallel_scan_t::_put_free(scan_morsel_t* morsel)
+{
+    critical_section_t cs(_lock);
+    _free.push_back(morsel);
+    thread_cond_broadcast(_cond);
+}
+
+
+
+/******************************************************************
+ *
+ * @class: scan_helper_pool_t
+ *
+ ******************************************************************/
+
+scan_helper_pool_t::scan_helper_pool_t(const int helpers)
+    : _lock(thread_mutex_create()), _cond(thread_cond_create()),
+      _stop(false)
+{
+    for (int i=0; i<helpers; i++) {
+        scan_helper_t* helper = new scan_helper_t(c_str("scan-helper-%d", i), this);
+        _helpers.push_back(helper);
+        helper->fork();
+    }
+    TRACE( TRACE_ALWAYS, "Started (%d) scan helpers\n", helpers);
+}
+
+
+scan_helper_pool_t::~scan_helper_pool_t()
+{
+    {
+        critical_section_t cs(_lock);
+        _stop = true;
+        thread_cond_broadcast(_cond);
+    }
+    for (uint i=0; i<_helpers.size(); i++) {
+        _helpers[i]->join();
+        delete (_helpers[i]);
+    }
+    thread_cond_destroy(_cond);
+    thread_mutex_destroy(_lock);
+}
+
+
+int scan_helper_pool_t::enlist(parallel_scan_t* scan,
+                               std::vector<scan_consumer_t*>& consumers)
+{
+    assert (scan);
+    critical_section_t cs(_lock);
+    uint next = 1;
+    for (uint i=0; (i<_helpers.size()) && (next<consumers.size()); i++) {
+        if (_helpers[i]->_scan == NULL) {
+            _helpers[i]->_scan = scan;
+            _helpers[i]->_consumer = consumers[next++];
+        }
+    }
+    if (next > 1)
+        thread_cond_broadcast(_cond);
+    return (next-1);
+}
+
+
+void scan_helper_t::work()
+{
+    critical_section_t cs(_pool->_lock);
+    while (true) {
+        while (!_scan && !_pool->_stop)
+            thread_cond_wait(_pool->_cond, _pool->_lock);
+        if (!_scan)
+            break;
+
+        parallel_scan_t* scan = _scan;
+        scan_consumer_t* consumer = _consumer;
+        cs.exit();
+        scan->help(consumer);
+        cs.enter(_pool->_lock);
+
+        _scan = NULL;
+        _consumer = NULL;
+    }
+}
+
+
+EXIT_NAMESPACE(shore);
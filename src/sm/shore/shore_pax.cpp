@@ -0,0 +1,497 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_pax.cpp
+ *
+ *  @brief:  Implementation of the PAX column groups and their scan
+ *
+ */
+
+#include "sm/shore/shore_pax.h"
+#include "sm/shore/shore_table.h"
+#include "sm/shore/shore_env.h"
+
+#include <cstring>
+
+
+ENTER_NAMESPACE(shore);
+
+
+/* On-disk layout of the "<table>_PAX" file: one header record and
+   one record per block. A block is its header followed by one
+   mini-page per column, each starting 8-byte aligned. Both kinds of
+   record start with a magic number. */
+
+static const uint4_t PAX_HEADER_MAGIC = 0x50415848; // "PAXH"
+static const uint4_t PAX_BLOCK_MAGIC  = 0x50415842; // "PAXB"
+
+struct pax_header_t {
+    uint4_t _magic;
+    uint4_t _valid;
+    uint4_t _columns;
+    uint4_t _row_width;
+    uint4_t _blocks;
+    uint4_t _rows;
+};
+
+struct pax_block_header_t {
+    uint4_t _magic;
+    uint4_t _rows;
+};
+
+
+/* Offsets of the mini-pages of a block of (rows) rows, returns the
+   size of the block */
+static uint pax_layout(const std::vector<uint>& widths, const uint rows,
+                       uint* offsets)
+{
+    uint offset = sizeof(pax_block_header_t);
+    for (uint i=0; i<widths.size(); i++) {
+        offset = (offset + 7) & ~7u;
+        offsets[i] = offset;
+        offset += rows * widths[i];
+    }
+    return (offset);
+}
+
+
+
+/******************************************************************
+ *
+ * @class: pax_block_t
+ *
+ ******************************************************************/
+
+void pax_block_t::set(const pax_store_t* store, const char* body)
+{
+    assert (store);
+    assert (pax_store_t::is_block(body));
+
+    pax_block_header_t hdr;
+    memcpy(&hdr, body, sizeof(hdr));
+    _data = body;
+    _rows = hdr._rows;
+
+    uint offset = sizeof(pax_block_header_t);
+    for (uint i=0; i<store->columns(); i++) {
+        offset = (offset + 7) & ~7u;
+        _offsets[i] = offset;
+        offset += _rows * store->width(i);
+    }
+}
+
+
+
+/******************************************************************
+ *
+ * @class: pax_store_t
+ *
+ ******************************************************************/
+
+pax_store_t::pax_store_t(table_desc_t* table, const uint* fields, const uint count)
+    : _table(table), _fields(fields, fields+count), _row_width(0),
+      _lock(thread_mutex_create()), _current(false),
+      _file(c_str("%s_PAX", table->name()).data(), 1),
+      _header_rid(rid_t::null)
+{
+    assert (_table);
+    assert ((count > 0) && (count <= pax_block_t::MAX_COLUMNS));
+    for (uint i=0; i<count; i++) {
+        field_desc_t* fd = _table->desc(_fields[i]);
+        assert (!fd->is_variable_length() && (fd->type() != SQL_TIME));
+        _widths.push_back(fd->fieldmaxsize());
+        _row_width += fd->fieldmaxsize();
+    }
+}
+
+
+pax_store_t::~pax_store_t()
+{
+    thread_mutex_destroy(_lock);
+}
+
+
+int pax_store_t::column_of(const uint field) const
+{
+    for (uint i=0; i<_fields.size(); i++)
+        if (_fields[i] == field) return (i);
+    return (-1);
+}
+
+
+uint pax_store_t::capacity() const
+{
+    // the worst-case alignment padding of every mini-page included
+    uint const room = ssm_max_small_rec - sizeof(pax_block_header_t)
+        - 8*_fields.size();
+    return (room / _row_width);
+}
+
+
+bool pax_store_t::is_block(const char* body)
+{
+    uint4_t magic;
+    memcpy(&magic, body, sizeof(magic));
+    return (magic == PAX_BLOCK_MAGIC);
+}
+
+
+/******************************************************************
+ *
+ * @fn:     create_physical()
+ *
+ * @brief:  Creates the file of the copy, next to its table, with an
+ *          invalid header
+ *
+ ******************************************************************/
+
+w_rc_t pax_store_t::create_physical(ss_m* db)
+{
+    assert (db);
+    if (!_table->is_vid_valid() || !_table->is_root_valid())
+        W_DO(_table->find_root_iid(db));
+
+    W_DO(db->create_file(_table->vid(), _file.fid(), smlevel_3::t_regular));
+
+    file_info_t file;
+    file.set_ftype(FT_HEAP);
+    file.set_fid(_file.fid());
+    W_DO(ss_m::create_assoc(_table->root_iid(),
+                            vec_t(_file.name(), strlen(_file.name())),
+                            vec_t(&file, sizeof(file_info_t))));
+
+    pax_header_t hdr = { PAX_HEADER_MAGIC, 0, (uint4_t)_fields.size(),
+                         _row_width, 0, 0 };
+    W_DO(db->create_rec(_file.fid(), vec_t(), sizeof(hdr),
+                        vec_t(&hdr, sizeof(hdr)), _header_rid));
+    _current = false;
+    return (RCOK);
+}
+
+
+/******************************************************************
+ *
+ * @fn:     load()
+ *
+ * @brief:  Finds the copy at startup. It is current only if it was
+ *          built with the same columns and no row changed since.
+ *
+ ******************************************************************/
+
+w_rc_t pax_store_t::load(ss_m* db)
+{
+    assert (db);
+
+    w_rc_t e = _file.check_fid(db);
+    if (e.is_error()) {
+        if (e.err_num() != se_TABLE_NOT_FOUND) return (e);
+        _file.set_fid(stid_t::null);
+        TRACE( TRACE_ALWAYS, "Creating (%s)\n", _file.name());
+        return (create_physical(db));
+    }
+
+    // the header is the first record, read until it shows up
+    pax_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    {
+        scan_file_i scanner(_file.fid(), ss_m::t_cc_record, false, SH);
+        bool eof(false);
+        pin_i* handle(NULL);
+        W_DO(scanner.next(handle, 0, eof));
+        while (!eof) {
+            if (handle->body_size() == sizeof(hdr)) {
+                memcpy(&hdr, handle->body(), sizeof(hdr));
+                if (hdr._magic == PAX_HEADER_MAGIC) {
+                    _header_rid = handle->rid();
+                    break;
+                }
+            }
+            W_DO(scanner.next(handle, 0, eof));
+        }
+    }
+
+    if (_header_rid == rid_t::null) {
+        hdr._magic = PAX_HEADER_MAGIC;
+        hdr._valid = 0;
+        W_DO(db->create_rec(_file.fid(), vec_t(), sizeof(hdr),
+                            vec_t(&hdr, sizeof(hdr)), _header_rid));
+    }
+
+    _current = (hdr._valid && (hdr._columns == _fields.size()) &&
+                (hdr._row_width == _row_width));
+    if (_current) {
+        TRACE( TRACE_STATISTICS, "Found (%d) rows in (%d) blocks of (%s)\n",
+               hdr._rows, hdr._blocks, _file.name());
+    }
+    else {
+        TRACE( TRACE_ALWAYS, "No valid PAX copy of (%s)\n", _table->name());
+    }
+    return (RCOK);
+}
+
+
+/******************************************************************
+ *
+ * @fn:     invalidate()
+ *
+ * @brief:  Called for every change of the table, in the transaction
+ *          of the change. Only the first one writes the header, so
+ *          if it aborts the copy is merely rebuilt for nothing.
+ *
+ ******************************************************************/
+
+w_rc_t pax_store_t::invalidate(ss_m* /* db */)
+{
+    if (!_current)
+        return (RCOK);
+
+    critical_section_t cs(_lock);
+    if (!_current)
+        return (RCOK);
+    _current = false;
+    TRACE( TRACE_DEBUG, "PAX copy of (%s) is stale\n", _table->name());
+
+    if (_header_rid == rid_t::null)
+        return (RCOK);
+    return (_write_header(false, 0, 0));
+}
+
+
+/******************************************************************
+ *
+ * @fn:     build()
+ *
+ * @brief:  Copies the stored columns of every row of the table into
+ *          blocks. Commits every BUILD_BLOCKS_PER_XCT blocks, and
+ *          resumes the scan of the table at the row it stopped at.
+ *
+ * @note:   Nothing may change the table meanwhile
+ *
+ ******************************************************************/
+
+w_rc_t pax_store_t::build(ss_m* db, table_man_t* pmanager)
+{
+    assert (db);
+    assert (pmanager);
+    assert (_header_rid != rid_t::null);
+
+    TRACE( TRACE_ALWAYS, "Building the PAX copy of (%s)\n", _table->name());
+    _current = false;
+
+    // 1. drop the old blocks
+    W_DO(_drop_blocks(db));
+
+    // 2. stage capacity() rows column by column, write them as a block
+    uint const cap = capacity();
+    uint const ncols = _fields.size();
+    std::vector<uint> stage(ncols);
+    uint offset = 0;
+    for (uint i=0; i<ncols; i++) {
+        stage[i] = offset;
+        offset += cap * _widths[i];
+    }
+    std::vector<char> values(cap * _row_width, 0);
+    std::vector<char> buf;
+
+    table_row_t tuple(_table);
+    uint rows = 0;
+    uint blocks = 0;
+    uint total = 0;
+    rid_t start = rid_t::null;
+    bool eof(false);
+
+    while (!eof) {
+        W_DO(db->begin_xct());
+        w_rc_t e = RCOK;
+        uint written = 0;
+        {
+            guard<scan_file_i> scanner;
+            if (start == rid_t::null)
+                scanner = new scan_file_i(_table->fid(), ss_m::t_cc_record,
+                                          false, SH);
+            else
+                scanner = new scan_file_i(_table->fid(), start,
+                                          ss_m::t_cc_record, false, SH);
+            pin_i* handle(NULL);
+
+            while (true) {
+                e = scanner->next(handle, 0, eof);
+                if (e.is_error() || eof) break;
+
+                if (rows == cap) {
+                    if (written == BUILD_BLOCKS_PER_XCT) {
+                        // commit, and start the next batch at this row
+                        start = handle->rid();
+                        break;
+                    }
+                    e = _write_block(db, buf, values, rows);
+                    if (e.is_error()) break;
+                    written++;
+                    blocks++;
+                    rows = 0;
+                }
+
+                if (!pmanager->load(&tuple, handle->body())) {
+                    e = RC(se_WRONG_DISK_DATA);
+                    break;
+                }
+                for (uint i=0; i<ncols; i++) {
+                    char* slot = &values[stage[i] + rows*_widths[i]];
+                    memset(slot, 0, _widths[i]);
+                    if (!tuple._pvalues[_fields[i]].is_null())
+                        tuple._pvalues[_fields[i]].copy_value(slot);
+                }
+                rows++;
+                total++;
+            }
+        }
+
+        if (!e.is_error() && eof) {
+            if (rows > 0) {
+                e = _write_block(db, buf, values, rows);
+                blocks++;
+            }
+            if (!e.is_error())
+                e = _write_header(true, blocks, total);
+        }
+        if (e.is_error()) {
+            W_DO(db->abort_xct());
+            return (e);
+        }
+        W_DO(db->commit_xct());
+    }
+
+    _current = true;
+    TRACE( TRACE_ALWAYS, "Copied (%d) rows of (%s) into (%d) blocks\n",
+           total, _table->name(), blocks);
+    return (RCOK);
+}
+
+
+w_rc_t pax_store_t::_drop_blocks(ss_m* db)
+{
+    std::vector<rid_t> old;
+
+    W_DO(db->begin_xct());
+    w_rc_t e = _write_header(false, 0, 0);
+    if (!e.is_error()) {
+        scan_file_i scanner(_file.fid(), ss_m::t_cc_record, false, EX);
+        bool eof(false);
+        pin_i* handle(NULL);
+        e = scanner.next(handle, 0, eof);
+        while (!e.is_error() && !eof) {
+            if (is_block(handle->body()))
+                old.push_back(handle->rid());
+            e = scanner.next(handle, 0, eof);
+        }
+    }
+    if (e.is_error()) {
+        W_DO(db->abort_xct());
+        return (e);
+    }
+    W_DO(db->commit_xct());
+
+    for (uint i=0; i<old.size(); i+=BUILD_BLOCKS_PER_XCT) {
+        W_DO(db->begin_xct());
+        for (uint j=i; (j<old.size()) && (j<i+BUILD_BLOCKS_PER_XCT); j++) {
+            e = db->destroy_rec(old[j]);
+            if (e.is_error()) {
+                W_DO(db->abort_xct());
+                return (e);
+            }
+        }
+        W_DO(db->commit_xct());
+    }
+    return (RCOK);
+}
+
+
+/* (values) holds capacity() rows per column, the block only (rows) */
+w_rc_t pax_store_t::_write_block(ss_m* db, std::vector<char>& buf,
+                                 const std::vector<char>& values, const uint rows)
+{
+    uint offsets[pax_block_t::MAX_COLUMNS];
+    uint const sz = pax_layout(_widths, rows, offsets);
+    buf.assign(sz, 0);
+
+    pax_block_header_t hdr = { PAX_BLOCK_MAGIC, rows };
+    memcpy(&buf[0], &hdr, sizeof(hdr));
+
+    uint const cap = capacity();
+    uint stage = 0;
+    for (uint i=0; i<_widths.size(); i++) {
+        memcpy(&buf[offsets[i]], &values[stage], rows * _widths[i]);
+        stage += cap * _widths[i];
+    }
+
+    rid_t rid;
+    W_DO(db->create_rec(_file.fid(), vec_t(), sz, vec_t(&buf[0], sz), rid));
+    return (RCOK);
+}
+
+
+w_rc_t pax_store_t::_write_header(const bool valid, const uint blocks,
+                                  const uint rows)
+{
+    pax_header_t hdr = { PAX_HEADER_MAGIC, (uint4_t)(valid? 1 : 0),
+                         (uint4_t)_fields.size(), _row_width, blocks, rows };
+    pin_i pin;
+    W_DO(pin.pin(_header_rid, 0, EX));
+    w_rc_t e = pin.update_rec(0, vec_t(&hdr, sizeof(hdr)));
+    pin.unpin();
+    return (e);
+}
+
+
+
+/******************************************************************
+ *
+ * @class: pax_scan_iter_t
+ *
+ ******************************************************************/
+
+pax_scan_iter_t::pax_scan_iter_t(pax_store_t* store, lock_mode_t alm)
+    : _store(store), _lm(alm)
+{
+    assert (_store);
+}
+
+
+w_rc_t pax_scan_iter_t::next(bool& eof, pax_block_t& block)
+{
+    if (!_scanner)
+        _scanner = new scan_file_i(_store->file()->fid(), ss_m::t_cc_record,
+                                   false, _lm);
+
+    pin_i* handle(NULL);
+    W_DO(_scanner->next(handle, 0, eof));
+    while (!eof && !pax_store_t::is_block(handle->body()))
+        W_DO(_scanner->next(handle, 0, eof));
+
+    if (!eof)
+        block.set(_store, handle->body());
+    return (RCOK);
+}
+
+
+EXIT_NAMESPACE(shore);
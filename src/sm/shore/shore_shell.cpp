@@ -31,6 +31,8 @@
 #include "sm/shore/shore_shell.h"
 #include "k_defines.h"
 
+#include <cctype>
+
 
 ENTER_NAMESPACE(shore);
 
@@ -764,6 +766,8 @@ int shore_shell_t::register_commands()
     REGISTER_CMD_PARAM(fake_iodelay_cmd_t,_fakeioer,_env);
     REGISTER_CMD_PARAM(freq_cmd_t,_freqer,_env);
     REGISTER_CMD_PARAM(skew_cmd_t,_skewer,_env);
+    REGISTER_CMD_PARAM(mix_cmd_t,_mixer,_env);
+    REGISTER_CMD_PARAM(scenario_cmd_t,_scenarioer,_env);
     REGISTER_CMD_PARAM(stats_verbose_cmd_t,_stats_verboser,_env);
     REGISTER_CMD_PARAM(db_print_cmd_t,_db_printer,_env);
     REGISTER_CMD_PARAM(db_fetch_cmd_t,_db_fetch,_env);
@@ -1089,6 +1093,18 @@ int skew_cmd_t::handle(const char* cmd)
     char sLoad[SERVER_COMMAND_BUFFER_SIZE];
     char sTime[SERVER_COMMAND_BUFFER_SIZE];
 
+    // skew <dist> [<params>] sets the key distribution instead
+    if ( (sscanf(cmd, "%s %s", cmd_tag, sArea) == 2) && !isdigit(sArea[0]) ) {
+        assert (_env);
+        keydist_spec_t spec;
+        if (!spec.parse(cmd + strlen(cmd_tag))) {
+            usage();
+            return (SHELL_NEXT_CONTINUE);
+        }
+        _env->set_keydist(spec);
+        return (SHELL_NEXT_CONTINUE);
+    }
+
     if ( sscanf(cmd, "%s %s %s %s", cmd_tag, sArea, sLoad, sTime) < 4) {
         // prints all the env
         usage();
@@ -1123,6 +1139,14 @@ void skew_cmd_t::usage(void)
            "<AREA> - Percentage of the area that will be affected by the given load\n"          \
            "<LOAD> - Work load of the given area\n"         \
            "<START_TIME> - After this many seconds the above the load change will be applied\n\n" \
+           "*** skew <DIST> [<PARAMS>]\n"                               \
+           "\nSets the key distribution of the inputs (TM1, TPC-B, TPC-C):\n" \
+           "uniform\n"                                                  \
+           "zipfian     [<THETA>=0.99]\n"                               \
+           "scrambled   [<THETA>=0.99]  - zipfian, hot keys scattered\n" \
+           "hotspot     [<KEYS%%>=20] [<OPS%%>=80]\n"                     \
+           "latest      [<THETA>=0.99]  - zipfian, from the last key\n"  \
+           "exponential [<OPS%%>=95] [<KEYS%%>=10]\n\n"                   \
 	   "DISABLED\n\n");
 }
 
@@ -1132,6 +1156,136 @@ string skew_cmd_t::desc() const
 }
 
 
+
+/*********************************************************************
+ *
+ *  "mix" command
+ *
+ *  Prints or sets the weights of the trxs of a mix
+ *
+ *********************************************************************/
+
+void mix_cmd_t::setaliases() 
+{ 
+    _name = string("mix"); 
+    _aliases.push_back("mix"); 
+}
+
+int mix_cmd_t::handle(const char* cmd)
+{
+    char cmd_tag[SERVER_COMMAND_BUFFER_SIZE];
+    char sId[SERVER_COMMAND_BUFFER_SIZE];
+    int consumed = 0;
+    assert (_env);
+
+    if ( sscanf(cmd, "%s %s %n", cmd_tag, sId, &consumed) < 2) {
+        _env->print_mixes();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    if (!isdigit(sId[0]) || !cmd[consumed]) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    _env->set_mix(atoi(sId), cmd + consumed);
+    return (SHELL_NEXT_CONTINUE);
+}
+
+
+void mix_cmd_t::usage(void)
+{
+    TRACE( TRACE_ALWAYS, "MIX Usage:\n\n"                               \
+           "*** mix\n"                                                  \
+           "\nPrints the mixes of the kit\n\n"                          \
+           "*** mix <MIX_ID> <TRX_ID>:<WEIGHT> [<TRX_ID>:<WEIGHT> ...]\n" \
+           "*** mix <MIX_ID> default\n"                                 \
+           "\nParameters:\n"                                            \
+           "<MIX_ID> - The trx id of the mix, as in \"trxs\"\n"         \
+           "<TRX_ID> - A trx the mix runs, not another mix\n"           \
+           "<WEIGHT> - Its weight, only the ratios count\n\n"           \
+           "The mixes of a configuration can also be set in the config\n" \
+           "file, as <config>-mix-<MIX_ID>\n\n");
+}
+
+string mix_cmd_t::desc() const 
+{ 
+    return (string("Prints or sets the trx weights of the mixes")); 
+}
+
+
+
+/*********************************************************************
+ *
+ *  "scenario" command
+ *
+ *********************************************************************/
+
+void scenario_cmd_t::setaliases() 
+{ 
+    _name = string("scenario"); 
+    _aliases.push_back("scenario"); 
+}
+
+int scenario_cmd_t::handle(const char* cmd)
+{
+    char cmd_tag[SERVER_COMMAND_BUFFER_SIZE];
+    char sMode[SERVER_COMMAND_BUFFER_SIZE];
+    assert (_env);
+
+    if ( sscanf(cmd, "%s %s", cmd_tag, sMode) < 2) {
+        // prints the running scenario, if any
+        skew_scenario_t* sc = _env->get_skew_scenario();
+        if (!sc) {
+            usage();
+            return (SHELL_NEXT_CONTINUE);
+        }
+        TRACE( TRACE_ALWAYS, "Running phase (%d) (%s)\n", sc->current(),
+               _env->get_keydist().to_string().c_str());
+        sc->print_results();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    if (strcmp(sMode, "stop") == 0) {
+        _env->stop_skew_scenario();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    std::vector<skew_phase_t> phases;
+    bool loop = false;
+    if (!skew_scenario_t::parse(cmd + strlen(cmd_tag), phases, loop)) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+    _env->start_skew_scenario(phases, loop);
+    return (SHELL_NEXT_CONTINUE);
+}
+
+
+void scenario_cmd_t::usage(void)
+{
+    TRACE( TRACE_ALWAYS, "SCENARIO Usage:\n\n"                          \
+           "*** scenario move <SECS> <STEP%%> <DIST> [<PARAMS>]\n"      \
+           "    Rotates the keys of DIST by STEP%% every SECS (moving hotspot)\n" \
+           "*** scenario ramp <SECS> <STEPS> <FROM> <TO> [zipfian|scrambled|latest]\n" \
+           "    Goes from theta FROM to TO in STEPS phases of SECS, then stays at TO\n" \
+           "*** scenario phases <SECS> <DIST> [<PARAMS>] [, <SECS> <DIST> [<PARAMS>]]*\n" \
+           "    Runs the given phases once\n"                          \
+           "*** scenario cycle <SECS> <DIST> [<PARAMS>] [, <SECS> <DIST> [<PARAMS>]]*\n" \
+           "    Runs the given phases until stopped\n"                 \
+           "*** scenario stop\n"                                        \
+           "    Stops the scenario and prints the TPS of each phase\n"  \
+           "*** scenario\n"                                             \
+           "    Prints the running phase and the TPS of the phases so far\n\n" \
+           "<DIST> [<PARAMS>] as in \"skew\". The TPS counts only while measuring\n\n");
+}
+
+string scenario_cmd_t::desc() const 
+{ 
+    return (string("Changes the key distribution over time")); 
+}
+
+
 /*********************************************************************
  *
  *  "stats_verbose" command
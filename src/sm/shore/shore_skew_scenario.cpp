@@ -0,0 +1,229 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file shore_skew_scenario.cpp
+ *
+ *  @brief Implementation of the skew scenarios
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+#include "sm/shore/shore_skew_scenario.h"
+#include "sm/shore/shore_env.h"
+
+
+using namespace shore;
+
+
+// how often a running phase checks if it was stopped
+const int SKEW_SCENARIO_POLL_US = 100000;
+
+
+skew_scenario_t::skew_scenario_t(ShoreEnv* env, 
+                                 const std::vector<skew_phase_t>& phases,
+                                 const bool loop)
+    : thread_t("skew-scenario"), _env(env), _phases(phases), _loop(loop),
+      _stop(false), _current(-1)
+{
+    assert (_env);
+    assert (!_phases.empty());
+    pthread_mutex_init(&_results_mutex, NULL);
+}
+
+skew_scenario_t::~skew_scenario_t()
+{
+    pthread_mutex_destroy(&_results_mutex);
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    work()
+ *
+ *  @brief: Runs the phases, one after the other, and records the
+ *          commits and attempts of the environment during each
+ *
+ ******************************************************************/
+
+void skew_scenario_t::work()
+{
+    int i = 0;
+    while (!_stop) {
+        const skew_phase_t& phase = _phases[i];
+        _current = i;
+        _env->set_keydist(phase._spec);
+
+        uint_t com = _env->get_trx_com();
+        uint_t att = _env->get_trx_att();
+        stopwatch_t timer;
+        long long start = timer.now();
+        long long end = start + phase._secs*1000000ll;
+
+        // sleep in short steps, so that stop() does not wait for a
+        // whole phase
+        for (long long now = start; (now < end) && !_stop; now = timer.now()) {
+            long long left = end - now;
+            usleep((left < SKEW_SCENARIO_POLL_US)? left : SKEW_SCENARIO_POLL_US);
+        }
+
+        result_t r;
+        r._phase = i;
+        r._spec = phase._spec;
+        r._secs = timer.time();
+        r._commits = _env->get_trx_com() - com;
+        r._attempts = _env->get_trx_att() - att;
+
+        TRACE( TRACE_ALWAYS, "Phase (%d) (%s) %.1f secs. TPS (%.1f) Committed (%d) Attempted (%d)\n",
+               i, r._spec.to_string().c_str(), r._secs,
+               (r._secs > 0)? r._commits/r._secs : 0.0,
+               r._commits, r._attempts);
+
+        {
+            CRITICAL_SECTION(cs, _results_mutex);
+            _results.push_back(r);
+        }
+
+        if (++i == (int)_phases.size()) {
+            if (!_loop) break;
+            i = 0;
+        }
+    }
+    _current = -1;
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    print_results()
+ *
+ *  @brief: Prints the throughput of the phases run so far
+ *
+ ******************************************************************/
+
+void skew_scenario_t::print_results()
+{
+    CRITICAL_SECTION(cs, _results_mutex);
+
+    TRACE( TRACE_ALWAYS, "Skew scenario. %d phases run\n", (int)_results.size());
+    for (size_t i=0; i<_results.size(); i++) {
+        const result_t& r = _results[i];
+        TRACE( TRACE_ALWAYS, "(%d) %-40s %6.1f secs %10.1f TPS %10d/%d\n",
+               r._phase, r._spec.to_string().c_str(), r._secs,
+               (r._secs > 0)? r._commits/r._secs : 0.0,
+               r._commits, r._attempts);
+    }
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    parse()
+ *
+ *  @brief: Builds the phases of a scenario description:
+ *
+ *          move <SECS> <STEP%> <DIST> [<PARAMS>]
+ *               the keys of DIST are rotated by STEP% every SECS,
+ *               cycling through the whole range
+ *          ramp <SECS> <STEPS> <FROM> <TO> [zipfian|scrambled|latest]
+ *               theta goes from FROM to TO in STEPS phases of SECS,
+ *               and then stays at TO
+ *          phases <SECS> <DIST> [<PARAMS>] [, <SECS> <DIST> [<PARAMS>]]*
+ *               the given phases, once
+ *          cycle  <SECS> <DIST> [<PARAMS>] [, <SECS> <DIST> [<PARAMS>]]*
+ *               the given phases, until stopped
+ *
+ ******************************************************************/
+
+bool skew_scenario_t::parse(const char* desc,
+                            std::vector<skew_phase_t>& phases,
+                            bool& loop)
+{
+    char mode[64];
+    int secs = 0;
+    int off = 0;
+    if (sscanf(desc, "%63s %d %n", mode, &secs, &off) < 2) return (false);
+    if (secs <= 0) return (false);
+    const char* rest = desc + off;
+
+    std::vector<skew_phase_t> ps;
+
+    if (strcmp(mode, "move") == 0) {
+        double step = 0;
+        if (sscanf(rest, "%lf %n", &step, &off) < 1) return (false);
+        if ((step <= 0) || (step > 100)) return (false);
+        keydist_spec_t spec;
+        if (!spec.parse(rest + off)) return (false);
+        for (double shift = 0; shift < 100; shift += step) {
+            spec._shift = shift;
+            ps.push_back(skew_phase_t(secs, spec));
+        }
+        loop = true;
+    }
+    else if (strcmp(mode, "ramp") == 0) {
+        int steps = 0;
+        double from = 0, to = 0;
+        char dist[64] = "zipfian";
+        if (sscanf(rest, "%d %lf %lf %63s", &steps, &from, &to, dist) < 3) 
+            return (false);
+        if ((steps <= 0) || (from < 0) || (from >= 1) || (to < 0) || (to >= 1))
+            return (false);
+        keydist_spec_t spec;
+        if (!spec.parse(dist)) return (false);
+        if ((spec._type != KD_ZIPFIAN) && (spec._type != KD_SCRAMBLED) &&
+            (spec._type != KD_LATEST)) return (false);
+        for (int i=0; i<steps; i++) {
+            spec._theta = (steps > 1)? from + (to-from)*i/(steps-1) : to;
+            ps.push_back(skew_phase_t(secs, spec));
+        }
+        loop = false;
+    }
+    else if ((strcmp(mode, "phases") == 0) || (strcmp(mode, "cycle") == 0)) {
+        // <DIST> [<PARAMS>] up to the next ',', which is followed by
+        // the <SECS> of the next phase
+        string list(rest);
+        size_t pos = 0;
+        while (1) {
+            size_t comma = list.find(',', pos);
+            string one = list.substr(pos, (comma == string::npos)? 
+                                     string::npos : comma - pos);
+            keydist_spec_t spec;
+            if (!spec.parse(one.c_str())) return (false);
+            ps.push_back(skew_phase_t(secs, spec));
+            if (comma == string::npos) break;
+
+            if (sscanf(list.c_str() + comma + 1, "%d %n", &secs, &off) < 1) 
+                return (false);
+            if (secs <= 0) return (false);
+            pos = comma + 1 + off;
+        }
+        loop = (strcmp(mode, "cycle") == 0);
+    }
+    else {
+        return (false);
+    }
+
+    phases = ps;
+    return (true);
+}
@@ -31,6 +31,8 @@
 
 #include "sm/shore/shore_table.h"
 
+#include <algorithm>
+
 using namespace shore;
 
 
@@ -60,6 +62,8 @@ using namespace shore;
 table_desc_t::table_desc_t(const char* name, int fieldcnt, uint4_t pd)
     : file_desc_t(name, fieldcnt, pd), _db(NULL),
       _indexes(NULL), _primary_idx(NULL),
+      _zone_map(NULL), _pax(NULL),
+      _defer_indexes(false),
       _maxsize(0),
       _sMinKey(NULL),_sMinKeyLen(0),
       _sMaxKey(NULL),_sMaxKeyLen(0)
@@ -81,6 +85,16 @@ table_desc_t::~table_desc_t()
         _indexes = NULL;
     }
 
+    if (_zone_map) {
+        delete _zone_map;
+        _zone_map = NULL;
+    }
+
+    if (_pax) {
+        delete _pax;
+        _pax = NULL;
+    }
+
     if (_sMinKey!=NULL) {
         free(_sMinKey);
         _sMinKey=NULL;
@@ -146,6 +160,16 @@ w_rc_t table_desc_t::create_physical_table(ss_m* db)
         // Move to the next index of the table
 	index = index->next();
     }
+
+    // And the file of the zone map
+    if (_zone_map) {
+        W_DO(_zone_map->create_physical(db));
+    }
+
+    // And the file of the PAX copy
+    if (_pax) {
+        W_DO(_pax->create_physical(db));
+    }
     
     return (RCOK);
 }
@@ -416,6 +440,47 @@ stid_t table_desc_t::get_primary_stid()
 
 
 
+/******************************************************************
+ *
+ *  @fn:    create_zone_map
+ *
+ *  @brief: Keep a min/max synopsis of the given (numeric) fields for
+ *          every (zone_pages) pages of the table
+ *
+ ******************************************************************/
+
+void table_desc_t::create_zone_map(const uint* fields, const uint num,
+                                   const uint zone_pages)
+{
+    assert (!_zone_map);
+    for (uint i=0; i<num; i++) {
+        assert (fields[i] < _field_count);
+    }
+    _zone_map = new zone_map_t(this, fields, num, zone_pages);
+}
+
+
+/******************************************************************
+ *
+ *  @fn:    create_pax_store
+ *
+ *  @brief: Keep a PAX copy of the given (fixed-width) fields, for
+ *          the scans that read only a few columns of a wide table
+ *
+ ******************************************************************/
+
+void table_desc_t::create_pax_store(const uint* fields, const uint num)
+{
+    assert (!_pax);
+    assert (get_pd() & PD_PAX);
+    for (uint i=0; i<num; i++) {
+        assert (fields[i] < _field_count);
+    }
+    _pax = new pax_store_t(this, fields, num);
+}
+
+
+
 
 /* ---------------------------------------------------- */
 /* --- partitioning information, used with MRBTrees --- */
@@ -943,6 +1008,14 @@ w_rc_t table_man_t::load_and_register_fid(ss_m* db)
 	W_DO(index->check_fid(db));
 	index = index->next();
     }
+    // 3. read back (or rebuild) the zone map
+    if (_ptable->zone_map()) {
+        W_DO(_ptable->zone_map()->load(db, this));
+    }
+    // 4. find the PAX copy, the environment rebuilds it if stale
+    if (_ptable->pax_store()) {
+        W_DO(_ptable->pax_store()->load(db));
+    }
     return (RCOK);
 }
 
@@ -1081,6 +1154,15 @@ w_rc_t table_man_t::add_tuple(ss_m* db,
                         bIgnoreLocks
                         ));
 
+    // widen the zone of the new record
+    if (_ptable->zone_map()) _ptable->zone_map()->add(ptuple);
+
+    // the PAX copy no longer has every row
+    if (_ptable->pax_store()) W_DO(_ptable->pax_store()->invalidate(db));
+
+    // while loading in bulk the indexes are built afterwards
+    if (_ptable->defer_indexes()) return (RCOK);
+
     // update the indexes
     index_desc_t* index = _ptable->indexes();
     int ksz = 0;
@@ -1145,6 +1227,7 @@ w_rc_t table_man_t::add_index_entry(ss_m* db,
     assert (pindex);
 	    
     if (!ptuple->is_rid_valid()) return RC(se_NO_CURRENT_TUPLE);
+    if (_ptable->defer_indexes()) return (RCOK);
 
     uint4_t system_mode = _ptable->get_pd();
 
@@ -1185,6 +1268,245 @@ w_rc_t table_man_t::add_index_entry(ss_m* db,
 
 
 
+/********************************************************************* 
+ *
+ *  @fn:    bulk_build_index
+ *
+ *  @brief: Fills an index of a table that was loaded with deferred
+ *          indexes. It scans the heap once, extracts the (key, rid) 
+ *          pairs of the index and sorts them in the order of the index 
+ *          keydesc. The sorted pairs of each partition go to a 
+ *          temporary file, key in the header and rid in the body, and 
+ *          ss_m::bulkld_index() builds the B-tree bottom-up from it: 
+ *          packed leaves and no splits.
+ *
+ *  @note:  MRBTree indexes have no bulk loader; their entries are
+ *          inserted in key order, committing every 
+ *          BULK_ENTRIES_PER_XCT entries.
+ *
+ *  @note:  It runs its own transactions, so it should be called with 
+ *          the loading finished and no transaction attached. 
+ *          Different indexes can be built in parallel.
+ *
+ *********************************************************************/
+
+const uint BULK_ENTRIES_PER_XCT = 20000;
+
+// an entry is [pnum][rid][key], they are compared by pnum and then by 
+// each key field as its keydesc (i/f/b) tells the B-tree to compare it
+struct bulk_entry_cmp_t
+{
+    const char*     _buf;
+    size_t          _esz;
+    uint            _kofs;
+    vector<char>    _kinds;
+    vector<uint>    _widths;
+
+    template <typename T>
+    static inline int cmp(const char* a, const char* b) {
+        T va, vb;
+        memcpy(&va, a, sizeof(T));
+        memcpy(&vb, b, sizeof(T));
+        return ((va < vb) ? -1 : ((vb < va) ? 1 : 0));
+    }
+
+    bool operator()(const uint a, const uint b) const {
+        const char* pa = _buf + a*_esz;
+        const char* pb = _buf + b*_esz;
+        int c = cmp<int>(pa, pb);
+        if (c) return (c < 0);
+        pa += _kofs;
+        pb += _kofs;
+        for (uint i=0; i<_kinds.size(); i++) {
+            uint w = _widths[i];
+            if (_kinds[i] == 'i') {
+                switch (w) {
+                case 1: c = cmp<signed char>(pa, pb); break;
+                case 2: c = cmp<short>(pa, pb); break;
+                case 4: c = cmp<int>(pa, pb); break;
+                default: c = cmp<long long>(pa, pb); break;
+                }
+            }
+            else if (_kinds[i] == 'f') {
+                c = (w == sizeof(float)) ? 
+                    cmp<float>(pa, pb) : cmp<double>(pa, pb);
+            }
+            else {
+                c = memcmp(pa, pb, w);
+            }
+            if (c) return (c < 0);
+            pa += w;
+            pb += w;
+        }
+        return (a < b);
+    }
+};
+
+
+/* 4a. one bulk load per partition, from a temporary file of the 
+ *     partition's sorted (key, rid) pairs */
+static w_rc_t bulkld_sorted(ss_m* db, table_desc_t* ptable, index_desc_t* pindex,
+                            const bulk_entry_cmp_t& order,
+                            const vector<uint>& sorted, const uint ksz)
+{
+    stopwatch_t timer;
+    base_stat_t leaf_pages = 0;
+    base_stat_t int_pages = 0;
+
+    uint i = 0;
+    while (i < sorted.size()) {
+        int pnum;
+        memcpy(&pnum, order._buf + sorted[i]*order._esz, sizeof(int));
+
+        W_DO(db->begin_xct());
+        stid_t tmp_fid;
+        w_rc_t e = db->create_file(ptable->vid(), tmp_fid, smlevel_3::t_temporary);
+        for (; !e.is_error() && (i < sorted.size()); i++) {
+            const char* pentry = order._buf + sorted[i]*order._esz;
+            int epnum;
+            memcpy(&epnum, pentry, sizeof(int));
+            if (epnum != pnum) break;
+
+            rid_t tmp_rid;
+            e = db->create_rec(tmp_fid, vec_t(pentry + order._kofs, ksz),
+                               sizeof(rid_t),
+                               vec_t(pentry + sizeof(int), sizeof(rid_t)),
+                               tmp_rid);
+        }
+
+        sm_du_stats_t stats;
+        stats.clear();
+        if (!e.is_error())
+            e = db->bulkld_index(pindex->fid(pnum), tmp_fid, stats, true, true);
+        if (!e.is_error())
+            e = db->destroy_file(tmp_fid);
+        if (e.is_error()) {
+            W_DO(db->abort_xct());
+            return (e);
+        }
+        W_DO(db->commit_xct());
+
+        leaf_pages += stats.btree.leaf_pg_cnt;
+        int_pages += stats.btree.int_pg_cnt;
+    }
+
+    TRACE( TRACE_ALWAYS, "index(%s): bulk loaded in (%.2f) secs, "
+           "(%d) leaf and (%d) internal pages\n",
+           pindex->name(), timer.time(), (int)leaf_pages, (int)int_pages);
+    return (RCOK);
+}
+
+
+/* 4b. insert them in key order, without locks */
+static w_rc_t insert_sorted(ss_m* db, index_desc_t* pindex,
+                            const bulk_entry_cmp_t& order,
+                            const vector<uint>& sorted, const uint ksz)
+{
+    W_DO(db->begin_xct());
+    for (uint i=0; i<sorted.size(); i++) {
+        const char* pentry = order._buf + sorted[i]*order._esz;
+        int pnum;
+        memcpy(&pnum, pentry, sizeof(int));
+        vec_t key(pentry + order._kofs, ksz);
+        ss_m::RELOCATE_RECORD_CALLBACK_FUNC reloc_func = &relocate_records;
+        el_filler ef;
+        ef._el.put(vec_t(pentry + sizeof(int), sizeof(rid_t)));
+        w_rc_t e = db->create_mr_assoc(pindex->fid(pnum), key, ef, true,
+                                       pindex->is_latchless(), reloc_func);
+        if (e.is_error()) {
+            W_DO(db->abort_xct());
+            return (e);
+        }
+
+        if (((i+1) % BULK_ENTRIES_PER_XCT) == 0) {
+            W_DO(db->commit_xct());
+            if (((i+1) % 1000000) == 0) { // every 1M
+                TRACE( TRACE_ALWAYS, "index(%s): %d\n", pindex->name(), i+1);
+            }
+            W_DO(db->begin_xct());
+        }
+    }
+    W_DO(db->commit_xct());
+    return (RCOK);
+}
+
+
+w_rc_t table_man_t::bulk_build_index(ss_m* db, index_desc_t* pindex)
+{
+    assert (_ptable);
+    assert (pindex);
+
+    // 1. the layout of an entry, and the key order
+    bulk_entry_cmp_t order;
+    order._kofs = sizeof(int) + sizeof(rid_t);
+    uint ksz = 0;
+    for (uint_t i=0; i<pindex->field_count(); i++) {
+        field_desc_t* pfd = _ptable->desc(pindex->key_index(i));
+        order._kinds.push_back(pfd->keydesc()[0]);
+        order._widths.push_back(pfd->fieldmaxsize());
+        ksz += pfd->fieldmaxsize();
+    }
+    order._esz = order._kofs + ksz;
+
+    // 2. extract the (key, rid) pairs from a scan of the heap
+    vector<char> entries;
+    table_row_t tuple(_ptable);
+    rep_row_t arep(ts());
+    arep.set(_ptable->maxsize());
+
+    W_DO(db->begin_xct());
+    {
+        scan_file_i scanner(_ptable->fid(), ss_m::t_cc_file, false, SH);
+        pin_i* handle(NULL);
+        bool eof(false);
+        w_rc_t e = scanner.next(handle, 0, eof);
+        while (!e.is_error() && !eof) {
+            if (!load(&tuple, handle->body())) {
+                e = RC(se_WRONG_DISK_DATA);
+                break;
+            }
+            tuple.set_rid(handle->rid());
+
+            int sz = format_key(pindex, &tuple, arep);
+            assert (sz == (int)ksz);
+            int pnum = get_pnum(pindex, &tuple);
+
+            size_t at = entries.size();
+            entries.resize(at + order._esz);
+            memcpy(&entries[at], &pnum, sizeof(int));
+            memcpy(&entries[at+sizeof(int)], &tuple._rid, sizeof(rid_t));
+            memcpy(&entries[at+order._kofs], arep._dest, sz);
+
+            e = scanner.next(handle, 0, eof);
+        }
+        if (e.is_error()) {
+            W_DO(db->abort_xct());
+            return (e);
+        }
+    }
+    W_DO(db->commit_xct());
+
+    // 3. sort them
+    uint count = entries.size() / order._esz;
+    order._buf = (count ? &entries[0] : NULL);
+    vector<uint> sorted(count);
+    for (uint i=0; i<count; i++) sorted[i] = i;
+    std::sort(sorted.begin(), sorted.end(), order);
+
+    // 4. build the index from them
+    if (pindex->is_mr())
+        W_DO(insert_sorted(db, pindex, order, sorted, ksz));
+    else
+        W_DO(bulkld_sorted(db, _ptable, pindex, order, sorted, ksz));
+
+    TRACE( TRACE_ALWAYS, "Built index (%s) of (%s) from (%d) sorted entries\n",
+           pindex->name(), _ptable->name(), count);
+    return (RCOK);
+}
+
+
+
+
 /********************************************************************* 
  *
  *  @fn:    add_plp_tuple
@@ -1420,6 +1742,8 @@ w_rc_t table_man_t::delete_tuple(ss_m* db,
 
     if (!ptuple->is_rid_valid()) return RC(se_NO_CURRENT_TUPLE);
 
+    if (_ptable->pax_store()) W_DO(_ptable->pax_store()->invalidate(db));
+
     uint4_t system_mode = _ptable->get_pd();
     rid_t todelete = ptuple->rid();
 
@@ -1556,7 +1880,7 @@ w_rc_t table_man_t::delete_index_entry(ss_m* db,
  *
  *********************************************************************/
 
-w_rc_t table_man_t::update_tuple(ss_m* /* db */, 
+w_rc_t table_man_t::update_tuple(ss_m* db, 
                                  table_tuple* ptuple,
                                  const lock_mode_t  lock_mode) // physical_design_t
 {
@@ -1566,6 +1890,8 @@ w_rc_t table_man_t::update_tuple(ss_m* /* db */,
 
     if (!ptuple->is_rid_valid()) return RC(se_NO_CURRENT_TUPLE);
 
+    if (_ptable->pax_store()) W_DO(_ptable->pax_store()->invalidate(db));
+
     uint4_t system_mode = _ptable->get_pd();
     bool bIgnoreLocks = false;
     if (lock_mode==NL) bIgnoreLocks = true;
@@ -1617,6 +1943,7 @@ w_rc_t table_man_t::update_tuple(ss_m* /* db */,
     }
 
     if (rc.is_error()) TRACE( TRACE_DEBUG, "Error updating record\n");
+    else if (_ptable->zone_map()) _ptable->zone_map()->add(ptuple);
 
     // 3. unpin
     pin.unpin();
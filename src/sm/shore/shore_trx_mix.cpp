@@ -0,0 +1,112 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_trx_mix.cpp
+ *
+ *  @brief:  Implementation of the transaction mixes
+ */
+
+#include "sm/shore/shore_trx_mix.h"
+
+#include <cstdlib>
+
+
+ENTER_NAMESPACE(shore);
+
+
+void trx_mix_t::add(const int xct_type, const double weight)
+{
+    assert (xct_type >= 0);
+    _trxs.push_back(xct_type);
+    _weights.push_back(weight);
+}
+
+
+bool trx_mix_t::build()
+{
+    if (_table.build(_weights)) return (true);
+    _trxs.clear();
+    _weights.clear();
+    return (false);
+}
+
+
+/****************************************************************** 
+ *
+ *  @fn:    parse
+ *
+ *  @brief: Reads "<trx id>:<weight> ..." separated by spaces or
+ *          commas. On error the mix is left as it was.
+ *
+ ******************************************************************/
+
+bool trx_mix_t::parse(const char* spec)
+{
+    assert (spec);
+    trx_mix_t mix;
+    const char* p = spec;
+    for (;;) {
+        while ((*p == ' ') || (*p == ',') || (*p == '\t')) ++p;
+        if (!*p) break;
+
+        char* end;
+        long trx = strtol(p, &end, 10);
+        if ((end == p) || (*end != ':') || (trx < 0)) return (false);
+        p = end+1;
+        double weight = strtod(p, &end);
+        if ((end == p) || (weight < 0)) return (false);
+        p = end;
+        mix.add((int)trx, weight);
+    }
+
+    if (!mix.build()) return (false);
+    *this = mix;
+    return (true);
+}
+
+
+trx_mix_t trx_mix_t::without(const int xct_type) const
+{
+    trx_mix_t mix;
+    for (uint i=0; i<_trxs.size(); i++) {
+        if (_trxs[i] != xct_type) mix.add(_trxs[i], _weights[i]);
+    }
+    mix.build();
+    return (mix);
+}
+
+
+string trx_mix_t::to_string() const
+{
+    string s;
+    char pair[64];
+    for (uint i=0; i<_trxs.size(); i++) {
+        snprintf(pair, sizeof(pair), "%s%d:%g", (i ? " " : ""),
+                 _trxs[i], _weights[i]);
+        s += pair;
+    }
+    return (s);
+}
+
+
+EXIT_NAMESPACE(shore);
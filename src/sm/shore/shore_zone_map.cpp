@@ -0,0 +1,542 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_zone_map.cpp
+ *
+ *  @brief:  Implementation of the zone maps and the zone-skipping scan
+ *
+ */
+
+#include "sm/shore/shore_zone_map.h"
+#include "sm/shore/shore_table.h"
+#include "sm/shore/shore_iter.h"
+
+#include <cstring>
+
+
+ENTER_NAMESPACE(shore);
+
+
+/* On-disk layout of the "<table>_ZM" file: one header record, then
+   one record per zone (its first block, its first rid and the
+   [min,max] pairs). The header is told apart by its size. */
+
+struct zone_map_header_t {
+    uint4_t _valid;
+    uint4_t _fields;
+    uint4_t _zone_pages;
+    uint4_t _zones;
+};
+
+struct zone_rec_t {
+    uint4_t _block;
+    rid_t   _first;
+};
+
+
+
+/******************************************************************
+ *
+ * @class: zone_range_t
+ *
+ ******************************************************************/
+
+zone_range_t& zone_range_t::add(const uint field, const double lo, const double hi)
+{
+    bound_t b = { field, lo, hi };
+    _bounds.push_back(b);
+    return (*this);
+}
+
+
+c_str zone_range_t::to_string() const
+{
+    c_str s("");
+    for (uint i=0; i<_bounds.size(); i++)
+        s = c_str("%s[%d:%.2f,%.2f]", s.data(),
+                  _bounds[i]._field, _bounds[i]._lo, _bounds[i]._hi);
+    return (s);
+}
+
+
+
+/******************************************************************
+ *
+ * @class: zone_map_t
+ *
+ ******************************************************************/
+
+zone_map_t::zone_map_t(table_desc_t* table, const uint* fields, const uint count,
+                       const uint zone_pages)
+    : _table(table), _fields(fields, fields+count), _zone_pages(zone_pages),
+      _lock(thread_mutex_create()), _dirty(false),
+      _file(c_str("%s_ZM", table->name()).data(), 1),
+      _header_rid(rid_t::null)
+{
+    assert (_table);
+    assert ((count > 0) && (count <= MAX_FIELDS));
+    assert ((_zone_pages == 1) || (_zone_pages == 2) ||
+            (_zone_pages == 4) || (_zone_pages == 8));
+    for (uint i=0; i<count; i++) {
+        sqltype_t t = _table->desc(_fields[i])->type();
+        assert ((t == SQL_SMALLINT) || (t == SQL_INT) || (t == SQL_DATE) ||
+                (t == SQL_FLOAT) || (t == SQL_LONG));
+    }
+}
+
+
+zone_map_t::~zone_map_t()
+{
+    thread_mutex_destroy(_lock);
+}
+
+
+uint zone_map_t::zones()
+{
+    critical_section_t cs(_lock);
+    return (_blocks.size());
+}
+
+
+double zone_map_t::_value(const table_row_t* ptuple, const uint field) const
+{
+    switch (_table->desc(field)->type()) {
+    case SQL_SMALLINT: { short v;     ptuple->get_value(field, v); return (v); }
+    case SQL_LONG:     { long long v; ptuple->get_value(field, v); return (v); }
+    case SQL_FLOAT:    { double v;    ptuple->get_value(field, v); return (v); }
+    default:           { int v;       ptuple->get_value(field, v); return (v); }
+    }
+}
+
+
+/******************************************************************
+ *
+ * @fn:     add()
+ *
+ * @brief:  Widens the zone of a newly written record so that it
+ *          covers its values
+ *
+ ******************************************************************/
+
+void zone_map_t::add(const table_row_t* ptuple)
+{
+    assert (ptuple);
+    assert (ptuple->is_rid_valid());
+
+    uint const nf = _fields.size();
+    double values[MAX_FIELDS];
+    for (uint i=0; i<nf; i++)
+        values[i] = _value(ptuple, _fields[i]);
+
+    rid_t const rid = ptuple->rid();
+    uint const block = rid.pid.page / _zone_pages;
+
+    critical_section_t cs(_lock);
+    arena_hash_map_t<uint,uint>::iterator it = _zone_of.find(block);
+    if (it == _zone_of.end()) {
+        _zone_of[block] = _blocks.size();
+        _blocks.push_back(block);
+        _firsts.push_back(rid);
+        for (uint i=0; i<nf; i++) {
+            _bounds.push_back(values[i]);
+            _bounds.push_back(values[i]);
+        }
+        _dirty = true;
+        return;
+    }
+
+    uint const zone = it->second;
+    if (rid < _firsts[zone]) {
+        _firsts[zone] = rid;
+        _dirty = true;
+    }
+    double* bounds = &_bounds[2*nf*zone];
+    for (uint i=0; i<nf; i++) {
+        if (values[i] < bounds[2*i]) {
+            bounds[2*i] = values[i];
+            _dirty = true;
+        }
+        if (values[i] > bounds[2*i+1]) {
+            bounds[2*i+1] = values[i];
+            _dirty = true;
+        }
+    }
+}
+
+
+void zone_map_t::clear()
+{
+    critical_section_t cs(_lock);
+    _blocks.clear();
+    _firsts.clear();
+    _bounds.clear();
+    _zone_of.clear();
+    _dirty = true;
+}
+
+
+int zone_map_t::zone_of(const lpid_t& pid)
+{
+    critical_section_t cs(_lock);
+    arena_hash_map_t<uint,uint>::iterator it = _zone_of.find(pid.page / _zone_pages);
+    return ((it == _zone_of.end())? -1 : (int)it->second);
+}
+
+
+/******************************************************************
+ *
+ * @fn:     select()
+ *
+ * @brief:  Checks every zone against the range
+ *
+ * @return: The number of zones that can be skipped
+ *
+ ******************************************************************/
+
+uint zone_map_t::select(const zone_range_t& range,
+                        std::vector<bool>& qualifies, std::vector<rid_t>& firsts)
+{
+    // positions of the bounded fields in the synopsis
+    std::vector<int> pos(range.count(), -1);
+    for (uint r=0; r<range.count(); r++)
+        for (uint i=0; i<_fields.size(); i++)
+            if (_fields[i] == range[r]._field) pos[r] = i;
+
+    uint const nf = _fields.size();
+    uint skipped = 0;
+
+    critical_section_t cs(_lock);
+    qualifies.assign(_blocks.size(), true);
+    firsts = _firsts;
+    for (uint z=0; z<_blocks.size(); z++) {
+        double const* bounds = &_bounds[2*nf*z];
+        for (uint r=0; r<range.count(); r++) {
+            if (pos[r] < 0) continue;
+            if ((bounds[2*pos[r]+1] < range[r]._lo) ||
+                (bounds[2*pos[r]] > range[r]._hi)) {
+                qualifies[z] = false;
+                skipped++;
+                break;
+            }
+        }
+    }
+    return (skipped);
+}
+
+
+
+/******************************************************************
+ *
+ * @fn:     create_physical()
+ *
+ * @brief:  Creates the file of the synopsis, next to its table, with
+ *          an invalid header
+ *
+ ******************************************************************/
+
+w_rc_t zone_map_t::create_physical(ss_m* db)
+{
+    assert (db);
+    if (!_table->is_vid_valid() || !_table->is_root_valid())
+        W_DO(_table->find_root_iid(db));
+
+    W_DO(db->create_file(_table->vid(), _file.fid(), smlevel_3::t_regular));
+
+    file_info_t file;
+    file.set_ftype(FT_HEAP);
+    file.set_fid(_file.fid());
+    W_DO(ss_m::create_assoc(_table->root_iid(),
+                            vec_t(_file.name(), strlen(_file.name())),
+                            vec_t(&file, sizeof(file_info_t))));
+
+    zone_map_header_t hdr = { 0, (uint4_t)_fields.size(), _zone_pages, 0 };
+    W_DO(db->create_rec(_file.fid(), vec_t(), sizeof(hdr),
+                        vec_t(&hdr, sizeof(hdr)), _header_rid));
+    return (RCOK);
+}
+
+
+/******************************************************************
+ *
+ * @fn:     load()
+ *
+ * @brief:  Reads the synopsis back at startup. If there is no valid
+ *          copy (a crash, a database created without zone maps, or
+ *          a different configuration) it is rebuilt from the table.
+ *          The copy on disk is marked invalid until the next save().
+ *
+ ******************************************************************/
+
+w_rc_t zone_map_t::load(ss_m* db, table_man_t* pmanager)
+{
+    assert (db);
+    assert (pmanager);
+
+    w_rc_t e = _file.check_fid(db);
+    if (e.is_error()) {
+        if (e.err_num() != se_TABLE_NOT_FOUND) return (e);
+        _file.set_fid(stid_t::null);
+        TRACE( TRACE_ALWAYS, "Creating (%s)\n", _file.name());
+        W_DO(create_physical(db));
+        return (rebuild(db, pmanager));
+    }
+
+    uint const nf = _fields.size();
+    smsize_t const zsz = sizeof(zone_rec_t) + 2*nf*sizeof(double);
+    zone_map_header_t hdr = { 0, 0, 0, 0 };
+
+    clear();
+    {
+        critical_section_t cs(_lock);
+        simple_table_iter_t scanner(db, &_file, SH);
+        bool eof(false);
+        pin_i* handle(NULL);
+        W_DO(scanner.next(eof, handle));
+        while (!eof) {
+            if (handle->body_size() == sizeof(hdr)) {
+                memcpy(&hdr, handle->body(), sizeof(hdr));
+                _header_rid = handle->rid();
+            }
+            else if (handle->body_size() == zsz) {
+                zone_rec_t rec;
+                memcpy(&rec, handle->body(), sizeof(rec));
+                _zone_of[rec._block] = _blocks.size();
+                _blocks.push_back(rec._block);
+                _firsts.push_back(rec._first);
+                double const* bounds = (double const*)(handle->body() + sizeof(rec));
+                _bounds.insert(_bounds.end(), bounds, bounds + 2*nf);
+            }
+            W_DO(scanner.next(eof, handle));
+        }
+        _dirty = false;
+    }
+
+    if (!hdr._valid || (hdr._fields != nf) || (hdr._zone_pages != _zone_pages) ||
+        (hdr._zones != _blocks.size()) || (_header_rid == rid_t::null)) {
+        TRACE( TRACE_ALWAYS, "No valid zone map for (%s), rebuilding\n",
+               _table->name());
+        if (_header_rid == rid_t::null) {
+            zone_map_header_t nhdr = { 0, nf, _zone_pages, 0 };
+            W_DO(db->create_rec(_file.fid(), vec_t(), sizeof(nhdr),
+                                vec_t(&nhdr, sizeof(nhdr)), _header_rid));
+        }
+        return (rebuild(db, pmanager));
+    }
+
+    TRACE( TRACE_STATISTICS, "Loaded (%d) zones of (%s)\n",
+           _blocks.size(), _table->name());
+    return (invalidate(db));
+}
+
+
+w_rc_t zone_map_t::rebuild(ss_m* db, table_man_t* pmanager)
+{
+    clear();
+
+    table_row_t tuple(_table);
+    simple_table_iter_t scanner(db, _table, SH);
+    bool eof(false);
+    pin_i* handle(NULL);
+    W_DO(scanner.next(eof, handle));
+    while (!eof) {
+        if (!pmanager->load(&tuple, handle->body()))
+            return (RC(se_WRONG_DISK_DATA));
+        tuple.set_rid(handle->rid());
+        add(&tuple);
+        W_DO(scanner.next(eof, handle));
+    }
+
+    TRACE( TRACE_ALWAYS, "Built (%d) zones of (%s)\n", zones(), _table->name());
+    return (invalidate(db));
+}
+
+
+/******************************************************************
+ *
+ * @fn:     save()
+ *
+ * @brief:  Writes the synopsis if it changed since it was read, and
+ *          marks the copy on disk valid
+ *
+ ******************************************************************/
+
+w_rc_t zone_map_t::save(ss_m* db)
+{
+    assert (db);
+    if (_header_rid == rid_t::null)
+        return (RCOK); // not created yet
+
+    uint const nf = _fields.size();
+    std::vector<uint>   blocks;
+    std::vector<rid_t>  firsts;
+    std::vector<double> bounds;
+    bool dirty;
+    {
+        critical_section_t cs(_lock);
+        dirty = _dirty;
+        blocks = _blocks;
+        firsts = _firsts;
+        bounds = _bounds;
+        _dirty = false;
+    }
+
+    if (dirty) {
+        // 1. drop the old zones
+        std::vector<rid_t> old;
+        {
+            simple_table_iter_t scanner(db, &_file, EX);
+            bool eof(false);
+            pin_i* handle(NULL);
+            W_DO(scanner.next(eof, handle));
+            while (!eof) {
+                if (handle->rid() != _header_rid)
+                    old.push_back(handle->rid());
+                W_DO(scanner.next(eof, handle));
+            }
+        }
+        for (uint i=0; i<old.size(); i++)
+            W_DO(db->destroy_rec(old[i]));
+
+        // 2. write the new ones
+        smsize_t const zsz = sizeof(zone_rec_t) + 2*nf*sizeof(double);
+        std::vector<char> buf(zsz);
+        for (uint z=0; z<blocks.size(); z++) {
+            zone_rec_t rec;
+            rec._block = blocks[z];
+            rec._first = firsts[z];
+            memcpy(&buf[0], &rec, sizeof(rec));
+            memcpy(&buf[sizeof(rec)], &bounds[2*nf*z], 2*nf*sizeof(double));
+            rid_t rid;
+            W_DO(db->create_rec(_file.fid(), vec_t(), zsz,
+                                vec_t(&buf[0], zsz), rid));
+        }
+    }
+
+    zone_map_header_t hdr = { 1, nf, _zone_pages, (uint4_t)blocks.size() };
+    pin_i pin;
+    W_DO(pin.pin(_header_rid, 0, EX));
+    w_rc_t e = pin.update_rec(0, vec_t(&hdr, sizeof(hdr)));
+    pin.unpin();
+    W_DO(e);
+
+    TRACE( TRACE_STATISTICS, "Saved (%d) zones of (%s)\n",
+           blocks.size(), _table->name());
+    return (RCOK);
+}
+
+
+w_rc_t zone_map_t::invalidate(ss_m* /* db */)
+{
+    if (_header_rid == rid_t::null)
+        return (RCOK); // not created yet
+    return (_write_header(false));
+}
+
+
+w_rc_t zone_map_t::_write_header(const bool valid)
+{
+    pin_i pin;
+    W_DO(pin.pin(_header_rid, 0, EX));
+    zone_map_header_t hdr;
+    memcpy(&hdr, pin.body(), sizeof(hdr));
+    hdr._valid = (valid? 1 : 0);
+    w_rc_t e = pin.update_rec(0, vec_t(&hdr, sizeof(hdr)));
+    pin.unpin();
+    return (e);
+}
+
+
+
+/******************************************************************
+ *
+ * @class: zone_scan_iter_t
+ *
+ ******************************************************************/
+
+zone_scan_iter_t::zone_scan_iter_t(ss_m* db, file_desc_t* file, zone_map_t* zones,
+                                   const zone_range_t& range, lock_mode_t alm)
+    : _db(db), _file(file), _zones(zones), _lm(alm),
+      _next(0), _cur(-1), _cur_page(0), _skipped(0)
+{
+    assert (_db);
+    assert (_file);
+    if (_zones && !range.is_empty())
+        _skipped = _zones->select(range, _pending, _firsts);
+    else
+        _zones = NULL;
+}
+
+
+w_rc_t zone_scan_iter_t::next(bool& eof, pin_i*& handle)
+{
+    if (!_zones) {
+        // plain file scan
+        if (!_scanner)
+            _scanner = new scan_file_i(_file->fid(), ss_m::t_cc_record, false, _lm);
+        return (_scanner->next(handle, 0, eof));
+    }
+
+    while (true) {
+
+        // 1. Start reading the next qualifying zone
+        if (!_scanner) {
+            while ((_next < _pending.size()) && !_pending[_next])
+                _next++;
+            if (_next == _pending.size()) {
+                eof = true;
+                return (RCOK);
+            }
+            _pending[_next] = false;
+            _cur = _next;
+            _cur_page = _firsts[_next].pid.page;
+            _scanner = new scan_file_i(_file->fid(), _firsts[_next],
+                                       ss_m::t_cc_record, false, _lm);
+        }
+
+        W_DO(_scanner->next(handle, 0, eof));
+        if (eof) {
+            _scanner.done();
+            continue;
+        }
+
+        // 2. On a new page, keep going only into zones still to be read
+        if (handle->rid().pid.page != _cur_page) {
+            _cur_page = handle->rid().pid.page;
+            int zone = _zones->zone_of(handle->rid().pid);
+            if (zone != _cur) {
+                if ((zone >= 0) && ((uint)zone < _pending.size())) {
+                    if (!_pending[zone]) {
+                        _scanner.done();
+                        continue;
+                    }
+                    _pending[zone] = false;
+                }
+                _cur = zone;
+            }
+        }
+        return (RCOK);
+    }
+}
+
+
+EXIT_NAMESPACE(shore);
@@ -33,6 +33,8 @@
 
 #include "workload/tpcc/shore_tpcc_env.h"
 #include "workload/tpcc/shore_tpcc_client.h"
+#include "workload/tpcc/chbench.h"
+#include "workload/tpcc/tpcc_rte.h"
 
 #include "workload/tm1/shore_tm1_env.h"
 #include "workload/tm1/shore_tm1_client.h"
@@ -40,8 +42,12 @@
 #include "workload/tpcb/shore_tpcb_env.h"
 #include "workload/tpcb/shore_tpcb_client.h"
 
+#include "workload/ycsb/shore_ycsb_env.h"
+#include "workload/ycsb/shore_ycsb_client.h"
+
 #include "workload/tpch/shore_tpch_env.h"
 #include "workload/tpch/shore_tpch_client.h"
+#include "workload/tpch/tpch_streams.h"
 
 #include "workload/ssb/shore_ssb_env.h"
 #include "workload/ssb/shore_ssb_client.h"
@@ -51,6 +57,11 @@
 
 #include "k_defines.h"
 
+#ifdef CFG_QPIPE
+#include "qpipe/core/tuple_fifo_bench.h"
+#include "qpipe/core/query_profile.h"
+#endif
+
 #ifdef CFG_SIMICS
 #include "util/simics-magic-instruction.h"
 #endif
@@ -62,6 +73,8 @@
 #include "dora/tm1/dora_tm1_client.h"
 #include "dora/tpcb/dora_tpcb.h"
 #include "dora/tpcb/dora_tpcb_client.h"
+#include "dora/ycsb/dora_ycsb.h"
+#include "dora/ycsb/dora_ycsb_client.h"
 
 #ifdef CFG_VTUNE
 #include <ittnotify.h> // VTune API definitions
@@ -74,6 +87,7 @@ using namespace shore;
 using namespace tpcc;
 using namespace tm1;
 using namespace tpcb;
+using namespace ycsb;
 using namespace tpch;
 using namespace ssb;
 using namespace tpce;
@@ -134,7 +148,7 @@ void initsysnamemap()
 
 
 // Value-definitions of the different Benchmarks
-enum BenchmarkValue { bmTPCC, bmTM1, bmTPCB, bmTPCH , bmSSB, bmTPCE };
+enum BenchmarkValue { bmTPCC, bmTM1, bmTPCB, bmTPCH , bmSSB, bmTPCE, bmYCSB };
 
 // Map to associate string with then enum values
 
@@ -148,6 +162,7 @@ void initbenchmarkmap()
     mBenchmarkValue["tpch"]  = bmTPCH;
     mBenchmarkValue["ssb"]   = bmSSB;
     mBenchmarkValue["tpce"]  = bmTPCE;
+    mBenchmarkValue["ycsb"]  = bmYCSB;
 }
 
 
@@ -160,6 +175,15 @@ class kit_t : public shore_shell_t
 private:
     DB* _dbinst;
 
+#ifdef CFG_QPIPE
+    guard<qpipe::fifobench_cmd_t> _fifobencher;
+    guard<qpipe::qprofile_cmd_t>  _qprofiler;
+#endif
+
+    guard<tpch_streams_cmd_t>     _streamer;
+    guard<chbench_cmd_t>          _chbencher;
+    guard<rte_cmd_t>              _rter;
+
 public:
 
     kit_t(const char* prompt, 
@@ -177,6 +201,7 @@ public:
     virtual int inst_test_env(int argc, char* argv[]);
     virtual int load_trxs_map();
     virtual int load_bp_map();
+    virtual int register_commands();
 
 
     // impl of supported commands
@@ -191,6 +216,15 @@ public:
 
     virtual w_rc_t prepareNewRun() { assert(_dbinst); return(_dbinst->newrun()); }
 
+    virtual base_client_t* new_client(c_str tname, const int id,
+                                      const MeasurementType aType,
+                                      const int trxid, const int numOfTrxs,
+                                      processorid_t aprsid,
+                                      const int sWH, const double qf)
+    {
+        return (new Client(tname,id,_dbinst,aType,trxid,numOfTrxs,aprsid,sWH,qf));
+    }
+
 }; // EOF: kit_t
 
 
@@ -226,6 +260,43 @@ int kit_t<Client,DB>::load_bp_map(void)
 }
 
 
+/********************************************************************* 
+ *
+ *  @fn:      register_commands
+ *
+ *  @brief:   Adds the kit-specific commands to the basic shell ones
+ *
+ *********************************************************************/
+
+template<class Client,class DB>
+int kit_t<Client,DB>::register_commands()
+{
+    shore_shell_t::register_commands();
+#ifdef CFG_QPIPE
+    REGISTER_CMD(qpipe::fifobench_cmd_t,_fifobencher);
+    REGISTER_CMD(qpipe::qprofile_cmd_t,_qprofiler);
+#endif
+
+    // the TPC-H power and throughput tests
+    if (ShoreTPCHEnv* tpchenv = dynamic_cast<ShoreTPCHEnv*>(_env)) {
+        REGISTER_CMD_PARAM(tpch_streams_cmd_t,_streamer,tpchenv);
+    }
+
+    // the CH-benCHmark, it forks the clients of the kit
+    if (ShoreTPCCEnv* tpccenv = dynamic_cast<ShoreTPCCEnv*>(_env)) {
+        _chbencher = new chbench_cmd_t(tpccenv, this);
+        _chbencher->setaliases();
+        add_cmd(_chbencher.get());
+
+        // and the TPC-C terminal emulator, which drives the workers
+        _rter = new rte_cmd_t(tpccenv, this);
+        _rter->setaliases();
+        add_cmd(_rter.get());
+    }
+    return (0);
+}
+
+
 /********************************************************************* 
  *
  *  @fn:      inst_test_env
@@ -282,7 +353,7 @@ int kit_t<Client,DB>::inst_test_env(int argc, char* argv[])
     }
 
     // 5. Now that everything is set, register any additional commands
-    shore_shell_t::register_commands();
+    register_commands();
 
     // 6. Start the VAS
     return (_dbinst->start());
@@ -334,6 +405,7 @@ int kit_t<Client,DB>::_cmd_TEST_impl(const double iQueriedSF,
         int wh_id = 0;
 
         _env->reset_stats();
+        input_ring_t::reset_stats();
 
         // reset monitor stats
 #ifdef HAVE_CPUMON
@@ -384,6 +456,7 @@ int kit_t<Client,DB>::_cmd_TEST_impl(const double iQueriedSF,
 	TRACE(TRACE_ALWAYS, "end measurement\n");
         _env->print_throughput(iQueriedSF,iSpread,iNumOfThreads,delay,
                                miochs, usage);
+        input_ring_t::print_stats(delay);
         
 #ifdef HAVE_CPUMON
         _g_mon->print_load(delay);
@@ -479,6 +552,7 @@ int kit_t<Client,DB>::_cmd_MEASURE_impl(const double iQueriedSF,
 	    _env->set_measure(MST_MEASURE);
 
 	    _env->reset_stats();
+	    input_ring_t::reset_stats();
 	    delay = 0;
 	    remaining = iDuration;
 	}
@@ -501,6 +575,7 @@ int kit_t<Client,DB>::_cmd_MEASURE_impl(const double iQueriedSF,
 	TRACE(TRACE_ALWAYS, "end measurement\n");
         _env->print_throughput(iQueriedSF,iSpread,iNumOfThreads,delay,
                                miochs, usage);
+        input_ring_t::print_stats(delay);
 
 #ifdef HAVE_CPUMON
         _g_mon->print_load(delay);
@@ -554,6 +629,7 @@ int kit_t<Client,DB>::_cmd_MEASURE_impl(const double iQueriedSF,
 typedef kit_t<baseline_tpcc_client_t,ShoreTPCCEnv> baselineTPCCKit;
 typedef kit_t<baseline_tm1_client_t,ShoreTM1Env> baselineTM1Kit;
 typedef kit_t<baseline_tpcb_client_t,ShoreTPCBEnv> baselineTPCBKit;
+typedef kit_t<baseline_ycsb_client_t,ShoreYCSBEnv> baselineYCSBKit;
 typedef kit_t<baseline_tpch_client_t,ShoreTPCHEnv> baselineTPCHKit;
 
 #ifdef CFG_QPIPE
@@ -566,6 +642,7 @@ typedef kit_t<baseline_tpce_client_t,ShoreTPCEEnv> baselineTPCEKit;
 typedef kit_t<dora_tpcc_client_t,DoraTPCCEnv> doraTPCCKit;
 typedef kit_t<dora_tm1_client_t,DoraTM1Env> doraTM1Kit;
 typedef kit_t<dora_tpcb_client_t,DoraTPCBEnv> doraTPCBKit;
+typedef kit_t<dora_ycsb_client_t,DoraYCSBEnv> doraYCSBKit;
 
 ////////////////////////////////
 
@@ -798,6 +875,26 @@ int main(int argc, char* argv[])
         }
     }
 
+    // YCSB
+    if (benchmarkname.compare("ycsb")==0) {
+        dbname = "(ycsb-" + physical + "-";
+        switch (mSysnameValue[sysname]) {
+        case snBaseline:
+            dbname += "base) ";
+            kit = new baselineYCSBKit(dbname.c_str(),netmode,netport,inputfilemode,inputfile);
+            break;
+        case snDORA:
+            dbname += "dora) "; nameset=true;
+        case snPLP:
+            if (!nameset) dbname += "plp) ";
+            kit = new doraYCSBKit(dbname.c_str(),netmode,netport,inputfilemode,inputfile);
+            break;
+        default:
+            TRACE( TRACE_ALWAYS, "Not supported configuration. Exiting...\n");
+            return (5);
+        }
+    }
+
     // TPC-H
     if (benchmarkname.compare("tpch")==0) {
         switch (mSysnameValue[sysname]) {
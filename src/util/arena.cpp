@@ -0,0 +1,82 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   arena.cpp
+ *
+ *  @brief:  Implementation of the bump-pointer memory arena
+ */
+
+#include "util/arena.h"
+
+#include <cstdlib>
+#include <cassert>
+
+
+arena_t::arena_t(size_t chunk_size)
+    : _chunk_size(chunk_size), _next(NULL), _left(0), _allocated(0)
+{
+    assert (_chunk_size >= ALIGN);
+}
+
+
+arena_t::~arena_t()
+{
+    for (size_t i=0; i<_chunks.size(); i++)
+        free(_chunks[i]);
+}
+
+
+/* The newest chunk is the only one guaranteed to be _chunk_size
+   bytes, so that is the one kept */
+void arena_t::reset()
+{
+    if (_chunks.empty())
+        return;
+    char* last = _chunks.back();
+    for (size_t i=0; i+1<_chunks.size(); i++)
+        free(_chunks[i]);
+    _chunks.clear();
+    _chunks.push_back(last);
+    _next = last;
+    _left = _chunk_size;
+    _allocated = 0;
+}
+
+
+size_t arena_t::reserved() const
+{
+    return (_chunks.size() * _chunk_size);
+}
+
+
+/* Requests larger than a chunk double the chunk size until they fit */
+void arena_t::_grow(size_t sz)
+{
+    while (_chunk_size < sz)
+        _chunk_size *= 2;
+    char* chunk = (char*)malloc(_chunk_size);
+    assert (chunk);
+    _chunks.push_back(chunk);
+    _next = chunk;
+    _left = _chunk_size;
+}
@@ -0,0 +1,104 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   bloom_filter.cpp
+ *
+ *  @brief:  Implementation of the blocked Bloom filter
+ */
+
+#include "util/bloom_filter.h"
+#include "util/fnv.h"
+
+#include <cstdlib>
+#include <cstring>
+
+
+static const size_t CACHE_LINE = 64;
+
+
+bloom_filter_t::bloom_filter_t(size_t expected_keys, size_t bits_per_key)
+    : _blocks(NULL), _raw(NULL), _num_blocks(0), _log_blocks(0),
+      _capacity(expected_keys), _inserted(0)
+{
+    size_t bits = expected_keys * bits_per_key;
+    size_t blocks = (bits + BLOCK_BITS - 1) / BLOCK_BITS;
+    while (((size_t)1 << _log_blocks) < blocks && _log_blocks < 32)
+        _log_blocks++;
+    _allocate((size_t)1 << _log_blocks);
+}
+
+
+bloom_filter_t::bloom_filter_t(bloom_filter_t const &other)
+    : _blocks(NULL), _raw(NULL), _num_blocks(0),
+      _log_blocks(other._log_blocks), _capacity(other._capacity),
+      _inserted(other._inserted)
+{
+    _allocate(other._num_blocks);
+    memcpy(_blocks, other._blocks, size_bytes());
+}
+
+
+bloom_filter_t::~bloom_filter_t()
+{
+    free(_raw);
+}
+
+
+void bloom_filter_t::_allocate(size_t num_blocks)
+{
+    _num_blocks = (num_blocks > 0)? num_blocks : 1;
+    _raw = malloc(size_bytes() + CACHE_LINE);
+    /* align to a cache line so that no block straddles two */
+    size_t addr = ((size_t)_raw + CACHE_LINE - 1) & ~(CACHE_LINE - 1);
+    _blocks = (uint64_t*)addr;
+    memset(_blocks, 0, size_bytes());
+}
+
+
+void bloom_filter_t::grow()
+{
+    if (_log_blocks >= 32)
+        return;
+
+    void*     old_raw    = _raw;
+    uint64_t* old_blocks = _blocks;
+    size_t    old_num    = _num_blocks;
+
+    _allocate(2 * old_num);
+    _log_blocks++;
+    _capacity *= 2;
+
+    /* block i covers the hashes of the new blocks 2i and 2i+1 */
+    size_t block_bytes = BLOCK_WORDS * sizeof(uint64_t);
+    for (size_t i = 0; i < old_num; i++) {
+        memcpy(_blocks + (2*i)   * BLOCK_WORDS, old_blocks + i * BLOCK_WORDS, block_bytes);
+        memcpy(_blocks + (2*i+1) * BLOCK_WORDS, old_blocks + i * BLOCK_WORDS, block_bytes);
+    }
+    free(old_raw);
+}
+
+
+uint32_t bloom_filter_t::signature() const
+{
+    return (fnv_hash((char const*)_blocks, size_bytes()));
+}
@@ -0,0 +1,340 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file keydist.cpp
+ *
+ *  @brief Implementation of the key distributions
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "util.h"
+#include "util/keydist.h"
+
+
+/*********************************************************************
+ *
+ *  Per-thread uniform generator (xorshift64*)
+ *
+ *********************************************************************/
+
+static unsigned long long volatile _g_kd_seed = 0;
+static unsigned int volatile _g_kd_epoch = 1;
+static unsigned int volatile _g_kd_threads = 0;
+
+static __thread unsigned long long _t_kd_state = 0;
+static __thread unsigned int _t_kd_epoch = 0;
+
+
+// splitmix64, to spread (seed,thread) over the generator state
+static unsigned long long _kd_mix(unsigned long long x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return (x ^ (x >> 31));
+}
+
+static void _kd_seed_thread()
+{
+    unsigned long long seed = _g_kd_seed;
+    unsigned long long state;
+    if (seed) {
+        unsigned int i = atomic_inc_uint_nv(&_g_kd_threads);
+        state = _kd_mix(seed + _kd_mix(i));
+    }
+    else {
+        thread_t* self = thread_get_self();
+        assert (self);
+        randgen_t* randgenp = self->randgen();
+        assert (randgenp);
+        state = _kd_mix(((unsigned long long)randgenp->rand() << 31)
+                        ^ randgenp->rand());
+    }
+    _t_kd_state = (state? state : 1);
+    _t_kd_epoch = _g_kd_epoch;
+}
+
+void keydist_t::seed(const unsigned long long seed)
+{
+    _g_kd_seed = seed;
+    _g_kd_threads = 0;
+    membar_producer();
+    atomic_inc_uint(&_g_kd_epoch);
+}
+
+double keydist_t::uniform()
+{
+    if (_t_kd_epoch != *&_g_kd_epoch)
+        _kd_seed_thread();
+
+    unsigned long long x = _t_kd_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    _t_kd_state = x;
+
+    // the top 53 bits
+    return ((double)((x * 0x2545F4914F6CDD1Dull) >> 11) * (1.0/9007199254740992.0));
+}
+
+
+
+/*********************************************************************
+ *
+ *  keydist_spec_t
+ *
+ *********************************************************************/
+
+static const char* _kd_names[] = {
+    "uniform", "zipfian", "scrambled", "hotspot", "latest", "exponential"
+};
+
+bool keydist_spec_t::parse(const char* spec)
+{
+    char name[64];
+    double p1 = -1, p2 = -1;
+    int n = sscanf(spec, "%63s %lf %lf", name, &p1, &p2);
+    if (n < 1) return (false);
+
+    keydist_spec_t s = *this;
+    int type = -1;
+    for (int i=0; i < (int)(sizeof(_kd_names)/sizeof(_kd_names[0])); i++)
+        if (strcmp(name, _kd_names[i]) == 0) type = i;
+    if (type < 0) return (false);
+    s._type = (keydist_type_t)type;
+
+    switch (s._type) {
+    case KD_ZIPFIAN:
+    case KD_SCRAMBLED:
+    case KD_LATEST:
+        if (n > 1) s._theta = p1;
+        if ((s._theta < 0) || (s._theta >= 1)) return (false);
+        break;
+    case KD_HOTSPOT:
+        if (n > 1) s._hot_keys = p1;
+        if (n > 2) s._hot_ops = p2;
+        if ((s._hot_keys <= 0) || (s._hot_keys > 100) ||
+            (s._hot_ops < 0) || (s._hot_ops > 100)) return (false);
+        break;
+    case KD_EXPONENTIAL:
+        if (n > 1) s._exp_ops = p1;
+        if (n > 2) s._exp_keys = p2;
+        if ((s._exp_ops <= 0) || (s._exp_ops >= 100) ||
+            (s._exp_keys <= 0) || (s._exp_keys > 100)) return (false);
+        break;
+    default:
+        break;
+    }
+
+    *this = s;
+    return (true);
+}
+
+string keydist_spec_t::to_string() const
+{
+    char buf[128];
+    switch (_type) {
+    case KD_ZIPFIAN:
+    case KD_SCRAMBLED:
+    case KD_LATEST:
+        snprintf(buf, sizeof(buf), "%s %.3f", _kd_names[_type], _theta);
+        break;
+    case KD_HOTSPOT:
+        snprintf(buf, sizeof(buf), "%s %.1f%% keys %.1f%% ops",
+                 _kd_names[_type], _hot_keys, _hot_ops);
+        break;
+    case KD_EXPONENTIAL:
+        snprintf(buf, sizeof(buf), "%s %.1f%% ops in %.1f%% keys",
+                 _kd_names[_type], _exp_ops, _exp_keys);
+        break;
+    default:
+        snprintf(buf, sizeof(buf), "%s", _kd_names[_type]);
+    }
+    if (_shift > 0) {
+        size_t len = strlen(buf);
+        snprintf(buf + len, sizeof(buf) - len, " shifted %.1f%%", _shift);
+    }
+    return (string(buf));
+}
+
+
+
+/*********************************************************************
+ *
+ *  keydist_t
+ *
+ *********************************************************************/
+
+static double _zeta(const long n, const double theta)
+{
+    double sum = 0;
+    for (long i=1; i<=n; i++)
+        sum += 1.0 / pow((double)i, theta);
+    return (sum);
+}
+
+// FNV-1a over the 8 bytes of the key
+static unsigned long long _fnv64(unsigned long long key)
+{
+    unsigned long long h = 0xCBF29CE484222325ull;
+    for (int i=0; i<8; i++) {
+        h ^= (key & 0xff);
+        h *= 0x100000001B3ull;
+        key >>= 8;
+    }
+    return (h);
+}
+
+
+// set()s are rare, one lock for all of them
+static pthread_mutex_t keydist_set_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+const keydist_t::state_t keydist_t::_uniform = {
+    keydist_spec_t(), 1, 0, 0, 0, 0, 0, 0, 0
+};
+
+
+keydist_t::~keydist_t()
+{
+    delete (*&_state);
+    for (size_t i=0; i<_retired.size(); i++)
+        delete (_retired[i]);
+}
+
+keydist_spec_t keydist_t::spec() const
+{
+    state_t* s = *&_state;
+    return (s? s->_spec : keydist_spec_t());
+}
+
+long keydist_t::n() const
+{
+    state_t* s = *&_state;
+    return (s? s->_n : 0);
+}
+
+
+void keydist_t::set(const keydist_spec_t& spec, const long n)
+{
+    state_t* s = new state_t();
+    s->_spec = spec;
+    s->_n = (n > 0)? n : 1;
+    long sn = s->_n;
+
+    switch (spec._type) {
+    case KD_ZIPFIAN:
+    case KD_SCRAMBLED:
+    case KD_LATEST:
+        {
+            double theta = spec._theta;
+            s->_zetan = _zeta(sn, theta);
+            s->_alpha = 1.0 / (1.0 - theta);
+            s->_half_pow_theta = 1.0 + pow(0.5, theta);
+            // with one or two keys the first two cases cover all draws
+            s->_eta = (sn > 2)?
+                (1.0 - pow(2.0/sn, 1.0 - theta)) / (1.0 - _zeta(2, theta)/s->_zetan)
+                : 0;
+        }
+        break;
+    case KD_HOTSPOT:
+        s->_hot_n = (long)(sn * spec._hot_keys / 100.0);
+        if (s->_hot_n < 1) s->_hot_n = 1;
+        if (s->_hot_n > sn) s->_hot_n = sn;
+        break;
+    case KD_EXPONENTIAL:
+        s->_gamma = -log(1.0 - spec._exp_ops/100.0) / (sn * spec._exp_keys/100.0);
+        break;
+    default:
+        break;
+    }
+    s->_shift = ((long)(sn * spec._shift / 100.0)) % sn;
+
+    // the constants must be visible before the pointer
+    membar_producer();
+    critical_section_t cs(keydist_set_mutex);
+    state_t* old = _state;
+    if (old) _retired.push_back(old);
+    _state = s;
+}
+
+
+long keydist_t::next()
+{
+    const state_t* s = *&_state;
+    if (!s) s = &_uniform;
+    long n = s->_n;
+    long k;
+
+    switch (s->_spec._type) {
+
+    case KD_ZIPFIAN:
+    case KD_SCRAMBLED:
+    case KD_LATEST:
+        {
+            double u = uniform();
+            double uz = u * s->_zetan;
+            if (uz < 1.0) k = 0;
+            else if (uz < s->_half_pow_theta) k = 1;
+            else {
+                k = (long)(n * pow(s->_eta*u - s->_eta + 1.0, s->_alpha));
+                if (k >= n) k = n - 1;
+            }
+            if (s->_spec._type == KD_SCRAMBLED)
+                k = (long)(_fnv64(k) % (unsigned long long)n);
+            else if (s->_spec._type == KD_LATEST)
+                k = n - 1 - k;
+        }
+        break;
+
+    case KD_HOTSPOT:
+        if ((uniform() * 100.0 < s->_spec._hot_ops) || (s->_hot_n == n))
+            k = (long)(uniform() * s->_hot_n);
+        else
+            k = s->_hot_n + (long)(uniform() * (n - s->_hot_n));
+        break;
+
+    case KD_EXPONENTIAL:
+        k = ((long)(-log(1.0 - uniform()) / s->_gamma)) % n;
+        break;
+
+    default:
+        k = (long)(uniform() * n);
+    }
+
+    k += s->_shift;
+    return ((k < n)? k : k - n);
+}
+
+
+long keydist_t::next(const long range)
+{
+    assert (range > 0);
+    const state_t* s = *&_state;
+    if (!s || ((s->_spec._type == KD_UNIFORM) && (s->_shift == 0)))
+        return ((long)(uniform() * range));
+    long k = next();
+    return ((range == s->_n)? k : k % range);
+}
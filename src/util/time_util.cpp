@@ -288,3 +288,138 @@ time_day_end (time_t t)
   
   return mktime (&tm);
 }
+
+
+
+/******************************************************************** 
+ *
+ *  date_t functions
+ *
+ *  @note Proleptic Gregorian calendar, computed with integer
+ *        arithmetic on 400-year eras that start on March 1st, so that
+ *        the leap day is the last day of the (shifted) year.
+ *
+ ********************************************************************/
+
+
+/******************************************************************** 
+ *
+ *  @fn:     make_date
+ *
+ *  @brief:  Returns the date_t of the given year, month (1-12) and day
+ *
+ ********************************************************************/
+
+date_t make_date(int year, int month, int day)
+{
+    year -= (month <= 2);
+    int era = (year >= 0 ? year : year-399) / 400;
+    int yoe = year - era*400;                                   // [0, 399]
+    int doy = (153*(month + (month > 2 ? -3 : 9)) + 2)/5 + day-1; // [0, 365]
+    int doe = yoe*365 + yoe/4 - yoe/100 + doy;                  // [0, 146096]
+    return (era*146097 + doe - 719468);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     date_parts
+ *
+ *  @brief:  The inverse of make_date()
+ *
+ ********************************************************************/
+
+void date_parts(date_t date, int* year, int* month, int* day)
+{
+    int z = date + 719468;
+    int era = (z >= 0 ? z : z-146096) / 146097;
+    int doe = z - era*146097;                                   // [0, 146096]
+    int yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;  // [0, 399]
+    int doy = doe - (365*yoe + yoe/4 - yoe/100);                // [0, 365]
+    int mp  = (5*doy + 2)/153;                                  // [0, 11]
+    int d   = doy - (153*mp + 2)/5 + 1;                         // [1, 31]
+    int m   = mp + (mp < 10 ? 3 : -9);                          // [1, 12]
+
+    if (year)  *year  = yoe + era*400 + (m <= 2);
+    if (month) *month = m;
+    if (day)   *day   = d;
+}
+
+
+int date_year(date_t date)
+{
+    int year;
+    date_parts(date, &year, NULL, NULL);
+    return (year);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     str_to_date
+ *
+ *  @brief:  Converts a string in format YYYY-MM-DD to a date_t
+ *
+ ********************************************************************/
+
+date_t str_to_date(char const* str)
+{
+    int year, month, day;
+    int count = sscanf(str, "%d-%d-%d", &year, &month, &day);
+    assert(count == 3);
+    (void) count;
+    return (make_date(year, month, day));
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     date_to_str
+ *
+ *  @brief:  Converts a date_t to a string with format YYYY-MM-DD. The
+ *           destination must hold at least 11 chars.
+ *
+ ********************************************************************/
+
+void date_to_str(char* dst, date_t date)
+{
+    int year, month, day;
+    date_parts(date, &year, &month, &day);
+    sprintf(dst, "%04d-%02d-%02d", year, month, day);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     timet_to_date
+ *
+ *  @brief:  Returns the local calendar day of a time_t
+ *
+ ********************************************************************/
+
+date_t timet_to_date(time_t time)
+{
+    struct tm atm;
+    localtime_r(&time, &atm);
+    return (make_date(atm.tm_year+1900, atm.tm_mon+1, atm.tm_mday));
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     date_to_timet
+ *
+ *  @brief:  Returns the local midnight of a date_t, like str_to_timet()
+ *
+ ********************************************************************/
+
+time_t date_to_timet(date_t date)
+{
+    tm time_str;
+    memset(&time_str, 0, sizeof(time_str));
+    date_parts(date, &time_str.tm_year, &time_str.tm_mon, &time_str.tm_mday);
+    time_str.tm_year -= 1900;
+    time_str.tm_mon--;
+    time_str.tm_isdst = -1;
+    return mktime(&time_str);
+}
@@ -104,7 +104,7 @@ ENTER_NAMESPACE(dbgenssb)
 
 void usage();
 long *permute_dist(distribution *d, long stream);
-extern long Seed[];
+extern __thread seed_t Seed[];
 
 
 
@@ -978,6 +978,30 @@ int ssb_dbgen_init()
 }
 
 
+/*
+ * ssb_dbgen_scale() -- size the population for scale factor sf, as the
+ * -s option of dbgen does.
+ */
+void ssb_dbgen_scale(double sf)
+{
+	flt_scale = sf;
+	if (flt_scale < MIN_SCALE)
+	{
+		int i;
+
+		scale = 1;
+		for (i = PART; i < NATION; i++)
+		{
+			tdefs[i].base *= flt_scale;
+			if (tdefs[i].base < 1)
+				tdefs[i].base = 1;
+		}
+	}
+	else
+		scale = (long) flt_scale;
+}
+
+
 
 EXIT_NAMESPACE(dbgenssb)
 
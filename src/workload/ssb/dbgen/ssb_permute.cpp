@@ -59,7 +59,7 @@ long *permute(long *set, int cnt, long stream);
 long *permute_dist(distribution *d, long stream);
 long seed;
 char *eol[2] = {" ", "},"};
-extern seed_t Seed[];
+extern __thread seed_t Seed[];
 #ifdef TEST
 tdef tdefs = { NULL };
 #endif
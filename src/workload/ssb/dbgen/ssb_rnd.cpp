@@ -70,6 +70,36 @@ row_stop(int t)	\
 		return;
 	}
 
+/*
+ * row_seek() -- position the streams of table t as if the rows before
+ * row n (numbered from 1, as in gen_tbl) had been generated by this
+ * thread. Every row of t moves each of its streams by the boundary of
+ * the stream, so the streams are reset to their initial seeds and
+ * skipped by (n-1) boundaries. The seed functions of speed_seed are
+ * not used, as they do not skip the variable length strings exactly.
+ * The lineorder rows also draw one number per row from each of the
+ * order streams, which row_stop() does not align.
+ */
+void
+row_seek(int t, long n)
+{
+	int i;
+
+	for (i=0; i <= MAX_STREAM; i++)
+		if ((Seed[i].table == t) ||
+			((tdefs[t].child != NONE) && (Seed[i].table == tdefs[t].child))
+#ifdef SSBM
+			|| ((t == LINE) && (Seed[i].table == ORDER))
+#endif
+			)
+			{
+			Seed[i] = InitialSeed[i];
+			if (n > 1)
+				NthElement((n - 1) * Seed[i].boundary, &Seed[i].value);
+			}
+	return;
+}
+
 void
 dump_seeds(int tbl)
 {
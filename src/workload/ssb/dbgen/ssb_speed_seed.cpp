@@ -15,7 +15,7 @@ ENTER_NAMESPACE(dbgenssb);
 
 #define MAX_COLOR 92
 long name_bits[MAX_COLOR / BITS_PER_LONG];
-extern seed_t Seed[];
+extern __thread seed_t Seed[];
 
 /* WARNING!  This routine assumes the existence of 64-bit                 */
 /* integers.  The notation used here- "HUGE" is *not* ANSI standard. */
@@ -289,6 +289,18 @@ ShoreSSBEnv::ShoreSSBEnv()
 
     // Register stage containers
     register_stage_containers();
+
+    // Pick the page pool used by all tuple_fifos
+    select_default_page_pool(envVar::instance()->getVar("qpipe-page-pool","malloc").c_str());
+
+    // Global memory budget for concurrent queries (in MB, 0 = unlimited)
+    memory_manager_t::set_budget((size_t)envVar::instance()->getVarInt("qpipe-memory-budget",0) << 20);
+
+    // Push Bloom filters from hash join build sides into probe-side scans
+    set_bloom_pushdown(envVar::instance()->getVarInt("qpipe-bloom-pushdown",1));
+
+    // Print a per-stage profile after every query
+    set_query_profiling(envVar::instance()->getVarInt("qpipe-profile",0));
 #endif
 }
 
@@ -308,6 +320,14 @@ w_rc_t ShoreSSBEnv::load_schema()
     _pcustomer_desc  = new customer_t(get_pd());
     _plineorder_desc = new lineorder_t(get_pd());
 
+    // min/max synopses for the date- and quantity-filtered scans
+    if (envVar::instance()->getVarInt("zone-maps",0)) {
+        int zpages = envVar::instance()->getVarInt("zone-map-pages",
+                                                   zone_map_t::DEFAULT_ZONE_PAGES);
+        uint const lo_fields[] = { 5, 8, 11 }; // orderdate quantity discount
+        _plineorder_desc->create_zone_map(lo_fields, 3, zpages);
+    }
+
     // initiate the table managers
     _ppart_man      = new part_man_impl(_ppart_desc.get());
     _psupplier_man  = new supplier_man_impl(_psupplier_desc.get());
@@ -415,17 +435,28 @@ int ShoreSSBEnv::statistics()
  *
  *  @fn:    start/stop
  *
- *  @brief: Simply call the corresponding functions of shore_env 
+ *  @brief: Call the corresponding functions of shore_env. The zone
+ *          maps on disk are stale while the environment runs, and a
+ *          stale PAX copy of a loaded database is rebuilt at start.
  *
  ********************************************************************/
 
 int ShoreSSBEnv::start()
 {
+    table_desc_t* zoned[] = { _plineorder_desc.get() };
+    W_COERCE(_sync_zone_maps(zoned, 1, false));
+
+    if (_loaded) {
+        table_man_t* paxed[] = { _plineorder_man };
+        W_COERCE(_build_pax_stores(paxed, 1));
+    }
     return (ShoreEnv::start());
 }
 
 int ShoreSSBEnv::stop()
 {
+    table_desc_t* zoned[] = { _plineorder_desc.get() };
+    W_COERCE(_sync_zone_maps(zoned, 1, true));
     return (ShoreEnv::stop());
 }
 
@@ -460,6 +491,7 @@ w_rc_t ShoreSSBEnv::loaddata()
 
     // 1. Call the function that initializes the dbgen
     ssb_dbgen_init();
+    ssb_dbgen_scale(_scaling_factor);
 
 
     time_t tstart = time(NULL);
@@ -496,11 +528,14 @@ w_rc_t ShoreSSBEnv::loaddata()
     // 4. Fire up the parallel loaders
     TRACE( TRACE_ALWAYS, "Firing up %d loaders ..\n", loaders_to_use);
     array_guard_t< guard<table_builder_t> > loaders(new guard<table_builder_t>[loaders_to_use]);
+    // Each loader generates the rows [start,end) of its slice of the
+    // Lineorder table, after the first DIVISOR rows that the creator 
+    // loaded. The rows are numbered from 1, as in dbgen.
     for(int i=0; i < loaders_to_use; i++) {
-        	long lineorder_start = (i*lineorders_per_thread) + DIVISOR + 1;
-        	long lineorder_end = ((i+1)*lineorders_per_thread > total_lineorders) ? 
-                    total_lineorders : (i+1)*lineorders_per_thread;
-        assert (lineorder_start <= lineorder_end);
+        long lineorder_end = (i == loaders_to_use-1) ? 
+            total_lineorders+1 : (i+1)*lineorders_per_thread+1;
+        long lineorder_start = std::min((i*lineorders_per_thread) + DIVISOR + 1,
+                                        lineorder_end);
 
         //	long cust_start = (i*custs_per_thread) + DIVISOR;
         //	long cust_end = ((i+1)*custs_per_thread > total_custs - 1) ? 
@@ -517,6 +552,10 @@ w_rc_t ShoreSSBEnv::loaddata()
 	loaders[i]->join();
     }
 
+    // Copy the fact table into its PAX store, if there is one
+    table_man_t* paxed[] = { _plineorder_man };
+    W_DO(_build_pax_stores(paxed, 1));
+
     time_t tstop = time(NULL);
 
     // 5. Print stats
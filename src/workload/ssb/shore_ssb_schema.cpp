@@ -215,6 +215,12 @@ lineorder_t::lineorder_t(const uint4_t& pd) :
 
         create_index_desc("LO_IDX_ORDERKEY", 0, fkeys1, 1, false);
     }
+
+    // PAX copy of every column but the two strings
+    if (pd & PD_PAX) {
+        uint pax[15] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+        create_pax_store(pax, 15);
+    }
 }
 
 
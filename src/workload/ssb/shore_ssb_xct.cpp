@@ -33,8 +33,11 @@
 
 #include <vector>
 #include <map>
+#include <string>
 #include <numeric>
 #include <algorithm>
+#include <climits>
+#include <cmath>
 
 #include "workload/ssb/dbgen/dss.h"
 #include "workload/ssb/dbgen/dsstypes.h"
@@ -281,7 +284,9 @@ w_rc_t ShoreSSBEnv::_gen_one_supplier(const int id,
     prsu->_rep = &areprow;
 
     dbgenssb::supplier_t as;
+    row_start(SUPP);
     mk_supp(id, &as);
+    row_stop(SUPP);
 
 #ifdef DO_PRINT_SSB_RECS
     if (id%100==0) {
@@ -314,7 +319,9 @@ w_rc_t ShoreSSBEnv::_gen_one_customer(const int id,
     prcu->_rep = &areprow;
 
     dbgenssb::customer_t ac;
+    row_start(CUST);
     mk_cust(id, &ac);
+    row_stop(CUST);
     
 #ifdef DO_PRINT_SSB_RECS
     if (id%100==0) {
@@ -351,7 +358,9 @@ w_rc_t ShoreSSBEnv::_gen_one_part(const int id,
     prpa->_rep = &areprow;
     
     dbgenssb::part_t ap;
+    row_start(PART);
     mk_part(id, &ap);
+    row_stop(PART);
 
 #ifdef DO_PRINT_SSB_RECS
     if (id%100==0) {
@@ -388,7 +397,9 @@ w_rc_t ShoreSSBEnv::_gen_one_lineorder(const int id,
     for (int i=0; i < O_LCNT_MAX; i++) {
 	INIT_HUGE(o.lineorders[i].okey);	
     }
+    row_start(LINE);
     mk_order(id, &o, 0);
+    row_stop(LINE);
     
 #ifdef DO_PRINT_SSB_RECS
     if (id%100==0) {
@@ -470,6 +481,11 @@ w_rc_t ShoreSSBEnv::xct_populate_baseline(const int /* xct_id */,
     TRACE( TRACE_ALWAYS, "SU MAX SIZE:%d \n",_psupplier_desc->maxsize());
     TRACE( TRACE_ALWAYS, "DA MAX SIZE:%d \n",_pdate_desc->maxsize());
 
+    // 1. Start the streams from the first rows, also when retrying
+    row_seek(SUPP, 1);
+    row_seek(CUST, 1);
+    row_seek(PART, 1);
+
     // 2. Build the small tables
     TRACE( TRACE_ALWAYS, "Building DATE !!!\n");
     for(int i=1; i<=NO_DATE; ++i) {
@@ -499,13 +515,15 @@ w_rc_t ShoreSSBEnv::xct_populate_baseline(const int /* xct_id */,
     TRACE( TRACE_ALWAYS, "Starting LINEORDERS SF=%d*%d=%d!!!\n",
 	   (int)in._sf, (int)LINEORDER_PER_SF, (int)(in._sf*LINEORDER_PER_SF));
     
+    long total_lineorders = (long)(in._sf*LINEORDER_PER_SF);
     for (int i=0; i < in._loader_count; ++i) {
         long start = i * in._lineorder_per_thread + 1;
-        long end = start + in._divisor - 1;
-        TRACE( TRACE_ALWAYS, "Lineorder %d .. %d\n", start, end);
+        long end = std::min(start + in._divisor, total_lineorders + 1);
+        TRACE( TRACE_ALWAYS, "Lineorder %ld .. %ld\n", start, end-1);
         
+        row_seek(LINE, start);
         for (int j=start; j<end; ++j) {
-            W_DO(e = _gen_one_lineorder(j,areprow));
+            W_DO(_gen_one_lineorder(j,areprow));
         }    
     }
 
@@ -528,7 +546,10 @@ w_rc_t ShoreSSBEnv::xct_populate_some_lineorders(const int xct_id,
 
     int id = in._orderid;
 
-    // Generate (xct_id) parts
+    // Position the streams at the first order, also when retrying
+    row_seek(LINE, in._orderid);
+
+    // Generate (xct_id) orders
     for (id=in._orderid; id<in._orderid+xct_id; id++) {
         W_DO(_gen_one_lineorder(id, areprow));
     }
@@ -840,6 +861,474 @@ w_rc_t ShoreSSBEnv::xct_qtest(const int /* xct_id */,
 }
 
 
+/******************************************************************** 
+ *
+ * SSB star-join helpers
+ *
+ * The baseline SSB queries load the dimensions they filter on into
+ * lookup tables and then make a single pass over lineorder, probing
+ * the lookups and aggregating the survivors into a hash table.
+ *
+ ********************************************************************/
+
+/* A dimension whose surrogate keys are 1..N, as a dense array from key
+   to the code of the key's group-by value, or -1 if the key does not
+   qualify */
+class ssb_dim_t
+{
+    vector<int>     _codes;
+    vector<string>  _values;
+    map<string,int> _dict;
+
+public:
+
+    ssb_dim_t(const int keys) : _codes(keys+1, -1) { }
+
+    void add(const int key, const char* value) {
+        int code;
+        map<string,int>::iterator it = _dict.find(value);
+        if (it == _dict.end()) {
+            code = _values.size();
+            _dict[value] = code;
+            _values.push_back(value);
+        }
+        else {
+            code = it->second;
+        }
+        assert (code < 0x10000); // packed into 16 bits of a group key
+        if (key >= (int)_codes.size())
+            _codes.resize(key+1, -1);
+        _codes[key] = code;
+    }
+
+    int code(const int key) const {
+        return (((key >= 0) && (key < (int)_codes.size())) ? _codes[key] : -1);
+    }
+
+    const char* value(const int code) const { return (_values[code].c_str()); }
+};
+
+
+/* The rows of a dimension whose (col) string is within [lo,hi] or
+   equal to (alt). The group-by value is the (group_col) string, or
+   none if (group_col) is negative. */
+struct ssb_dim_pred_t
+{
+    int         col;
+    const char* lo;
+    const char* hi;
+    const char* alt;
+    int         group_col;
+
+    ssb_dim_pred_t(int c, const char* l, const char* h, const char* a, int g)
+        : col(c), lo(l), hi(h), alt(a), group_col(g) { }
+
+    bool accepts(const char* v) const {
+        return ((strcmp(v, lo) >= 0 && strcmp(v, hi) <= 0) ||
+                (alt && strcmp(v, alt) == 0));
+    }
+};
+
+template <class TableDesc, class TableMan>
+static w_rc_t ssb_load_dim(ss_m* db, TableMan* pman, TableDesc* pdesc,
+                           const ssb_dim_pred_t& pred, ssb_dim_t& dim)
+{
+    tuple_guard<TableMan> prow(pman);
+
+    rep_row_t areprow(pman->ts());
+    areprow.set(pdesc->maxsize());
+
+    prow->_rep = &areprow;
+
+    guard<table_scan_iter_impl<TableDesc> > iter;
+    {
+	table_scan_iter_impl<TableDesc>* tmp_iter;
+	W_DO(pman->get_iter_for_file_scan(db, tmp_iter));
+	iter = tmp_iter;
+    }
+
+    bool eof;
+    int key;
+    char value[STRSIZE(25)];
+    char group[STRSIZE(25)];
+
+    W_DO(iter->next(db, eof, *prow));
+
+    while (!eof) {
+	prow->get_value(pred.col, value, sizeof(value));
+	if (pred.accepts(value)) {
+	    prow->get_value(0, key);
+	    group[0] = '\0';
+	    if (pred.group_col >= 0)
+		prow->get_value(pred.group_col, group, sizeof(group));
+	    dim.add(key, group);
+	}
+	W_DO(iter->next(db, eof, *prow));
+    }
+    return (RCOK);
+}
+
+
+/* The dates in [year_lo,year_hi] or in year_alt, optionally also
+   restricted to one month or week. Loaded as datekey -> d_year. */
+struct ssb_date_pred_t
+{
+    int         year_lo;
+    int         year_hi;
+    int         year_alt;
+    int         yearmonthnum;    // 0 = any
+    int         weeknuminyear;   // 0 = any
+    const char* yearmonth;       // NULL = any
+
+    ssb_date_pred_t(int lo, int hi)
+        : year_lo(lo), year_hi(hi), year_alt(-1),
+          yearmonthnum(0), weeknuminyear(0), yearmonth(NULL) { }
+};
+
+static w_rc_t ssb_load_dates(ss_m* db, ShoreSSBEnv* env,
+                             const ssb_date_pred_t& pred,
+                             arena_hash_map_t<int,int>& dates)
+{
+    tuple_guard<date_man_impl> prdate(env->date_man());
+
+    rep_row_t areprow(env->date_man()->ts());
+    areprow.set(env->date_desc()->maxsize());
+
+    prdate->_rep = &areprow;
+
+    guard<table_scan_iter_impl<date_t> > d_iter;
+    {
+	table_scan_iter_impl<date_t>* tmp_d_iter;
+	W_DO(env->date_man()->get_iter_for_file_scan(db, tmp_d_iter));
+	d_iter = tmp_d_iter;
+    }
+
+    bool eof;
+    ssb_date_tuple adate;
+
+    W_DO(d_iter->next(db, eof, *prdate));
+
+    while (!eof) {
+	prdate->get_value(4, adate.D_YEAR);
+	prdate->get_value(5, adate.D_YEARMONTHNUM);
+	prdate->get_value(6, adate.D_YEARMONTH, STRSIZE(7));
+	prdate->get_value(11, adate.D_WEEKNUMINYEAR);
+	if (((adate.D_YEAR >= pred.year_lo && adate.D_YEAR <= pred.year_hi) ||
+	     adate.D_YEAR == pred.year_alt) &&
+	    (!pred.yearmonthnum || adate.D_YEARMONTHNUM == pred.yearmonthnum) &&
+	    (!pred.weeknuminyear || adate.D_WEEKNUMINYEAR == pred.weeknuminyear) &&
+	    (!pred.yearmonth || strcmp(adate.D_YEARMONTH, pred.yearmonth) == 0)) {
+	    prdate->get_value(0, adate.D_DATEKEY);
+	    dates[adate.D_DATEKEY] = adate.D_YEAR;
+	}
+	W_DO(d_iter->next(db, eof, *prdate));
+    }
+    return (RCOK);
+}
+
+
+/* The range of lo_orderdate that can join with the loaded dates */
+static zone_range_t ssb_date_range(arena_hash_map_t<int,int>& dates)
+{
+    zone_range_t range;
+    if (dates.empty()) return (range);
+
+    int lo = INT_MAX;
+    int hi = INT_MIN;
+    for (arena_hash_map_t<int,int>::iterator it = dates.begin();
+         it != dates.end(); ++it) {
+        if (it->first < lo) lo = it->first;
+        if (it->first > hi) hi = it->first;
+    }
+    return (range.add(5, lo, hi));
+}
+
+
+/* The single pass over lineorder every query makes */
+class ssb_lineorder_scan_t
+{
+    ss_m*                                     _db;
+    ShoreSSBEnv*                              _env;
+    tuple_guard<lineorder_man_impl>           _prow;
+    rep_row_t                                 _rep;
+    guard<zone_scan_iter_impl<lineorder_t> > _iter;
+
+public:
+
+    ssb_lineorder_scan_t(ss_m* db, ShoreSSBEnv* env)
+        : _db(db), _env(env), _prow(env->lineorder_man()),
+          _rep(env->lineorder_man()->ts())
+    {
+        _rep.set(env->lineorder_desc()->maxsize());
+        _prow->_rep = &_rep;
+    }
+
+    /* (range) lets the scan skip lineorder zones, if there is a zone map */
+    w_rc_t open(const zone_range_t& range = zone_range_t()) {
+        zone_scan_iter_impl<lineorder_t>* tmp_iter;
+        W_DO(_env->lineorder_man()->get_iter_for_zone_scan(_db, tmp_iter, range));
+        _iter = tmp_iter;
+        return (RCOK);
+    }
+
+    w_rc_t next(bool& eof) { return (_iter->next(_db, eof, *_prow)); }
+
+    table_row_t* operator->() { return (_prow); }
+};
+
+
+/* The flight of Q1: sum(lo_extendedprice*lo_discount) of the lineorders
+   of (dates) with lo_discount and lo_quantity in the closed ranges.
+   Reads the PAX copy of lineorder if it is current. */
+static w_rc_t ssb_q1_revenue(ss_m* db, ShoreSSBEnv* env,
+                             arena_hash_map_t<int,int>& dates,
+                             const int discount_lo, const int discount_hi,
+                             const int quantity_lo, const int quantity_hi,
+                             long& revenue)
+{
+    revenue = 0;
+
+    pax_store_t* pax = env->lineorder_desc()->pax_store();
+    if (pax && pax->is_current()) {
+        int const c_date     = pax->column_of(5);
+        int const c_quantity = pax->column_of(8);
+        int const c_price    = pax->column_of(9);
+        int const c_discount = pax->column_of(11);
+        assert ((c_date >= 0) && (c_quantity >= 0) &&
+                (c_price >= 0) && (c_discount >= 0));
+
+        pax_scan_iter_t scanner(pax);
+        pax_block_t block;
+        bool eof;
+        W_DO(scanner.next(eof, block));
+        while (!eof) {
+            const int* orderdate = block.column<int>(c_date);
+            const int* quantity  = block.column<int>(c_quantity);
+            const int* price     = block.column<int>(c_price);
+            const int* discount  = block.column<int>(c_discount);
+            for (uint i=0; i<block.rows(); i++) {
+                if ((discount[i] >= discount_lo) && (discount[i] <= discount_hi) &&
+                    (quantity[i] >= quantity_lo) && (quantity[i] <= quantity_hi) &&
+                    dates.count(orderdate[i])) {
+                    revenue += (long)price[i] * discount[i];
+                }
+            }
+            W_DO(scanner.next(eof, block));
+        }
+        return (RCOK);
+    }
+
+    zone_range_t range = ssb_date_range(dates);
+    range.add(11, discount_lo, discount_hi);
+    range.add(8, quantity_lo, quantity_hi);
+
+    ssb_lineorder_scan_t lo_scan(db, env);
+    W_DO(lo_scan.open(range));
+
+    bool eof;
+    ssb_lineorder_tuple alo;
+
+    W_DO(lo_scan.next(eof));
+
+    while (!eof) {
+	lo_scan->get_value(8, alo.LO_QUANTITY);
+	lo_scan->get_value(11, alo.LO_DISCOUNT);
+	if ((alo.LO_DISCOUNT >= discount_lo) &&
+	    (alo.LO_DISCOUNT <= discount_hi) &&
+	    (alo.LO_QUANTITY >= quantity_lo) &&
+	    (alo.LO_QUANTITY <= quantity_hi)) {
+	    lo_scan->get_value(5, alo.LO_ORDERDATE);
+	    if (dates.count(alo.LO_ORDERDATE)) {
+		lo_scan->get_value(9, alo.LO_EXTENDEDPRICE);
+		revenue += (long)alo.LO_EXTENDEDPRICE * alo.LO_DISCOUNT;
+	    }
+	}
+	W_DO(lo_scan.next(eof));
+    }
+    return (RCOK);
+}
+
+
+/* One row of a star-join result: d_year, up to two dimension values
+   and the aggregate */
+struct ssb_group_row_t
+{
+    int         year;
+    const char* a;
+    const char* b;
+    long        value;
+};
+
+/* ORDER BY d_year, a, b */
+struct ssb_group_by_year_cmp {
+    bool operator()(const ssb_group_row_t& l, const ssb_group_row_t& r) const {
+        if (l.year != r.year) return (l.year < r.year);
+        int c = strcmp(l.a, r.a);
+        if (c) return (c < 0);
+        return (strcmp(l.b, r.b) < 0);
+    }
+};
+
+/* ORDER BY d_year asc, value desc */
+struct ssb_group_by_value_cmp {
+    bool operator()(const ssb_group_row_t& l, const ssb_group_row_t& r) const {
+        if (l.year != r.year) return (l.year < r.year);
+        return (l.value > r.value);
+    }
+};
+
+
+/* The shape shared by the Q2, Q3 and Q4 flights: lineorder joined
+   with date and up to three filtered dimensions, grouped by d_year and
+   up to two dimension values, summing lo_revenue (or the profit). */
+class ssb_star_join_t
+{
+public:
+
+    enum dim_e { NONE = -1, CUST = 0, SUPP = 1, PART = 2, DIMS = 3 };
+
+private:
+
+    ss_m*                     _db;
+    ShoreSSBEnv*              _env;
+    ssb_date_pred_t           _date_pred;
+    const ssb_dim_pred_t*     _preds[DIMS];
+    guard<ssb_dim_t>          _dims[DIMS];
+    dim_e                     _group_a;
+    dim_e                     _group_b;
+    bool                      _profit;
+    arena_hash_map_t<int,int> _dates;
+    arena_hash_map_t<long,long> _groups;
+
+public:
+
+    vector<ssb_group_row_t> rows;
+
+    ssb_star_join_t(ss_m* db, ShoreSSBEnv* env, const ssb_date_pred_t& date_pred)
+        : _db(db), _env(env), _date_pred(date_pred),
+          _group_a(NONE), _group_b(NONE), _profit(false), _dates(NO_DATE)
+    {
+        for (int i=0; i<DIMS; i++)
+            _preds[i] = NULL;
+    }
+
+    void join(const dim_e dim, const ssb_dim_pred_t& pred) { _preds[dim] = &pred; }
+    void group_by(const dim_e a, const dim_e b) { _group_a = a; _group_b = b; }
+    void sum_profit() { _profit = true; }
+
+    template <class Cmp>
+    w_rc_t run();
+
+private:
+
+    /* lineorder column of each dimension's key */
+    static int _lo_column(const int dim) {
+        static const int cols[DIMS] = { 2, 4, 3 };
+        return (cols[dim]);
+    }
+
+    w_rc_t _load_dims();
+};
+
+
+w_rc_t ssb_star_join_t::_load_dims()
+{
+    double sf = _env->get_sf();
+    W_DO(ssb_load_dates(_db, _env, _date_pred, _dates));
+    if (_preds[CUST]) {
+        _dims[CUST] = new ssb_dim_t((int)(CUSTOMER_PER_SF * sf));
+        W_DO(ssb_load_dim(_db, _env->customer_man(), _env->customer_desc(),
+                          *_preds[CUST], *_dims[CUST]));
+    }
+    if (_preds[SUPP]) {
+        _dims[SUPP] = new ssb_dim_t((int)(SUPPLIER_PER_SF * sf));
+        W_DO(ssb_load_dim(_db, _env->supplier_man(), _env->supplier_desc(),
+                          *_preds[SUPP], *_dims[SUPP]));
+    }
+    if (_preds[PART]) {
+        _dims[PART] = new ssb_dim_t((int)(PART_PER_SF * (1 + log2(sf > 1 ? sf : 1))));
+        W_DO(ssb_load_dim(_db, _env->part_man(), _env->part_desc(),
+                          *_preds[PART], *_dims[PART]));
+    }
+    return (RCOK);
+}
+
+
+template <class Cmp>
+w_rc_t ssb_star_join_t::run()
+{
+    W_DO(_load_dims());
+
+    ssb_lineorder_scan_t lo_scan(_db, _env);
+    W_DO(lo_scan.open(ssb_date_range(_dates)));
+
+    bool eof;
+    ssb_lineorder_tuple alo;
+    int key;
+    int codes[DIMS] = { 0, 0, 0 };
+
+    W_DO(lo_scan.next(eof));
+
+    while (!eof) {
+	// probe the joined dimensions, the first miss rejects the row
+	bool qualifies = true;
+	for (int i=0; i<DIMS && qualifies; i++) {
+	    if (_dims[i]) {
+		lo_scan->get_value(_lo_column(i), key);
+		codes[i] = _dims[i]->code(key);
+		qualifies = (codes[i] >= 0);
+	    }
+	}
+	if (qualifies) {
+	    lo_scan->get_value(5, alo.LO_ORDERDATE);
+	    arena_hash_map_t<int,int>::iterator d = _dates.find(alo.LO_ORDERDATE);
+	    if (d != _dates.end()) {
+		lo_scan->get_value(12, alo.LO_REVENUE);
+		long value = alo.LO_REVENUE;
+		if (_profit) {
+		    lo_scan->get_value(13, alo.LO_SUPPLYCOST);
+		    value -= alo.LO_SUPPLYCOST;
+		}
+		long group = ((long)d->second << 32) |
+		    ((long)(_group_a == NONE ? 0 : codes[_group_a]) << 16) |
+		    (long)(_group_b == NONE ? 0 : codes[_group_b]);
+		_groups[group] += value;
+	    }
+	}
+	W_DO(lo_scan.next(eof));
+    }
+
+    // decode and sort the groups
+    rows.clear();
+    rows.reserve(_groups.size());
+    for (arena_hash_map_t<long,long>::iterator it = _groups.begin();
+         it != _groups.end(); ++it) {
+        ssb_group_row_t row;
+        row.year  = (int)(it->first >> 32);
+        row.a     = (_group_a == NONE) ? "" :
+            _dims[_group_a]->value((int)((it->first >> 16) & 0xffff));
+        row.b     = (_group_b == NONE) ? "" :
+            _dims[_group_b]->value((int)(it->first & 0xffff));
+        row.value = it->second;
+        rows.push_back(row);
+    }
+    std::sort(rows.begin(), rows.end(), Cmp());
+    return (RCOK);
+}
+
+
+static void ssb_print_rows(const char* query, vector<ssb_group_row_t>& rows)
+{
+#ifdef PRINT_TRX_RESULTS
+    TRACE( TRACE_ALWAYS, "%s: %d groups\n", query, rows.size());
+    for (uint i=0; i<rows.size(); i++) {
+        TRACE( TRACE_ALWAYS, "%d|%s|%s|%ld\n",
+               rows[i].year, rows[i].a, rows[i].b, rows[i].value);
+    }
+#endif
+}
+
+
 /******************************************************************** 
  *
  * SSB Q1_1
@@ -847,13 +1336,34 @@ w_rc_t ShoreSSBEnv::xct_qtest(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q1_1(const int /* xct_id */, 
-                            q1_1_input_t& /* in */)
+                            q1_1_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select sum(lo_extendedprice*lo_discount) as revenue
+    // from lineorder, date
+    // where lo_orderdate = d_datekey
+    // and d_year = [YEAR]
+    // and lo_discount between [DISCOUNT_LO] and [DISCOUNT_HI]
+    // and lo_quantity < [QUANTITY]
+
+    ssb_date_pred_t dpred(in.d_year, in.d_year);
+
+    arena_hash_map_t<int,int> dates(NO_DATE);
+    W_DO(ssb_load_dates(_pssm, this, dpred, dates));
+
+    long revenue = 0;
+    W_DO(ssb_q1_revenue(_pssm, this, dates,
+                        in.lo_discount_lo, in.lo_discount_hi,
+                        INT_MIN, in.lo_quantity - 1, revenue));
+
+#ifdef PRINT_TRX_RESULTS
+    TRACE( TRACE_ALWAYS, "Q1_1: revenue (%ld)\n", revenue);
+#endif
+    return (RCOK);
 }
 
 
@@ -864,13 +1374,35 @@ w_rc_t ShoreSSBEnv::xct_q1_1(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q1_2(const int /* xct_id */, 
-                            q1_2_input_t& /* in */)
+                            q1_2_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select sum(lo_extendedprice*lo_discount) as revenue
+    // from lineorder, date
+    // where lo_orderdate = d_datekey
+    // and d_yearmonthnum = [YEARMONTHNUM]
+    // and lo_discount between [DISCOUNT_LO] and [DISCOUNT_HI]
+    // and lo_quantity between [QUANTITY_LO] and [QUANTITY_HI]
+
+    ssb_date_pred_t dpred(0, INT_MAX);
+    dpred.yearmonthnum = in.d_yearmonthnum;
+
+    arena_hash_map_t<int,int> dates(NO_DATE);
+    W_DO(ssb_load_dates(_pssm, this, dpred, dates));
+
+    long revenue = 0;
+    W_DO(ssb_q1_revenue(_pssm, this, dates,
+                        in.lo_discount_lo, in.lo_discount_hi,
+                        in.lo_quantity_lo, in.lo_quantity_hi, revenue));
+
+#ifdef PRINT_TRX_RESULTS
+    TRACE( TRACE_ALWAYS, "Q1_2: revenue (%ld)\n", revenue);
+#endif
+    return (RCOK);
 }
 
 
@@ -881,13 +1413,36 @@ w_rc_t ShoreSSBEnv::xct_q1_2(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q1_3(const int /* xct_id */, 
-                            q1_3_input_t& /* in */)
+                            q1_3_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select sum(lo_extendedprice*lo_discount) as revenue
+    // from lineorder, date
+    // where lo_orderdate = d_datekey
+    // and d_weeknuminyear = [WEEK]
+    // and d_year = [YEAR]
+    // and lo_discount between [DISCOUNT_LO] and [DISCOUNT_HI]
+    // and lo_quantity between [QUANTITY_LO] and [QUANTITY_HI]
+
+    ssb_date_pred_t dpred(in.d_year, in.d_year);
+    dpred.weeknuminyear = in.d_weeknuminyear;
+
+    arena_hash_map_t<int,int> dates(NO_DATE);
+    W_DO(ssb_load_dates(_pssm, this, dpred, dates));
+
+    long revenue = 0;
+    W_DO(ssb_q1_revenue(_pssm, this, dates,
+                        in.lo_discount_lo, in.lo_discount_hi,
+                        in.lo_quantity_lo, in.lo_quantity_hi, revenue));
+
+#ifdef PRINT_TRX_RESULTS
+    TRACE( TRACE_ALWAYS, "Q1_3: revenue (%ld)\n", revenue);
+#endif
+    return (RCOK);
 }
 
 
@@ -899,13 +1454,34 @@ w_rc_t ShoreSSBEnv::xct_q1_3(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q2_1(const int /* xct_id */, 
-                            q2_1_input_t& /* in */)
+                            q2_1_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select sum(lo_revenue), d_year, p_brand
+    // from lineorder, date, part, supplier
+    // where lo_orderdate = d_datekey
+    // and lo_partkey = p_partkey
+    // and lo_suppkey = s_suppkey
+    // and p_category = [CATEGORY]
+    // and s_region = [REGION]
+    // group by d_year, p_brand
+    // order by d_year, p_brand
+
+    ssb_dim_pred_t ppred(3, in.p_category, in.p_category, NULL, 4);
+    ssb_dim_pred_t spred(5, in.s_region, in.s_region, NULL, -1);
+
+    ssb_star_join_t star(_pssm, this, ssb_date_pred_t(0, INT_MAX));
+    star.join(ssb_star_join_t::PART, ppred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.group_by(ssb_star_join_t::PART, ssb_star_join_t::NONE);
+
+    W_DO(star.run<ssb_group_by_year_cmp>());
+    ssb_print_rows("Q2_1", star.rows);
+    return (RCOK);
 }
 
 
@@ -916,13 +1492,34 @@ w_rc_t ShoreSSBEnv::xct_q2_1(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q2_2(const int /* xct_id */, 
-                            q2_2_input_t& /* in */)
+                            q2_2_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select sum(lo_revenue), d_year, p_brand
+    // from lineorder, date, part, supplier
+    // where lo_orderdate = d_datekey
+    // and lo_partkey = p_partkey
+    // and lo_suppkey = s_suppkey
+    // and p_brand between [BRAND_1] and [BRAND_2]
+    // and s_region = [REGION]
+    // group by d_year, p_brand
+    // order by d_year, p_brand
+
+    ssb_dim_pred_t ppred(4, in.p_brand_1, in.p_brand_2, NULL, 4);
+    ssb_dim_pred_t spred(5, in.s_region, in.s_region, NULL, -1);
+
+    ssb_star_join_t star(_pssm, this, ssb_date_pred_t(0, INT_MAX));
+    star.join(ssb_star_join_t::PART, ppred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.group_by(ssb_star_join_t::PART, ssb_star_join_t::NONE);
+
+    W_DO(star.run<ssb_group_by_year_cmp>());
+    ssb_print_rows("Q2_2", star.rows);
+    return (RCOK);
 }
 
 
@@ -933,13 +1530,34 @@ w_rc_t ShoreSSBEnv::xct_q2_2(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q2_3(const int /* xct_id */, 
-                            q2_3_input_t& /* in */)
+                            q2_3_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select sum(lo_revenue), d_year, p_brand
+    // from lineorder, date, part, supplier
+    // where lo_orderdate = d_datekey
+    // and lo_partkey = p_partkey
+    // and lo_suppkey = s_suppkey
+    // and p_brand = [BRAND]
+    // and s_region = [REGION]
+    // group by d_year, p_brand
+    // order by d_year, p_brand
+
+    ssb_dim_pred_t ppred(4, in.p_brand, in.p_brand, NULL, 4);
+    ssb_dim_pred_t spred(5, in.s_region, in.s_region, NULL, -1);
+
+    ssb_star_join_t star(_pssm, this, ssb_date_pred_t(0, INT_MAX));
+    star.join(ssb_star_join_t::PART, ppred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.group_by(ssb_star_join_t::PART, ssb_star_join_t::NONE);
+
+    W_DO(star.run<ssb_group_by_year_cmp>());
+    ssb_print_rows("Q2_3", star.rows);
+    return (RCOK);
 }
 
 
@@ -951,13 +1569,35 @@ w_rc_t ShoreSSBEnv::xct_q2_3(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q3_1(const int /* xct_id */, 
-                            q3_1_input_t& /* in */)
+                            q3_1_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select c_nation, s_nation, d_year, sum(lo_revenue) as revenue
+    // from customer, lineorder, supplier, date
+    // where lo_custkey = c_custkey
+    // and lo_suppkey = s_suppkey
+    // and lo_orderdate = d_datekey
+    // and c_region = [REGION] and s_region = [REGION]
+    // and d_year >= [YEAR_LO] and d_year <= [YEAR_HI]
+    // group by c_nation, s_nation, d_year
+    // order by d_year asc, revenue desc
+
+    ssb_dim_pred_t cpred(5, in.c_region, in.c_region, NULL, 4);
+    ssb_dim_pred_t spred(5, in.s_region, in.s_region, NULL, 4);
+    ssb_date_pred_t dpred(in._year_lo, in._year_hi);
+
+    ssb_star_join_t star(_pssm, this, dpred);
+    star.join(ssb_star_join_t::CUST, cpred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.group_by(ssb_star_join_t::CUST, ssb_star_join_t::SUPP);
+
+    W_DO(star.run<ssb_group_by_value_cmp>());
+    ssb_print_rows("Q3_1", star.rows);
+    return (RCOK);
 }
 
 
@@ -968,13 +1608,35 @@ w_rc_t ShoreSSBEnv::xct_q3_1(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q3_2(const int /* xct_id */, 
-                            q3_2_input_t& /* in */)
+                            q3_2_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select c_city, s_city, d_year, sum(lo_revenue) as revenue
+    // from customer, lineorder, supplier, date
+    // where lo_custkey = c_custkey
+    // and lo_suppkey = s_suppkey
+    // and lo_orderdate = d_datekey
+    // and c_nation = [NATION] and s_nation = [NATION]
+    // and d_year >= [YEAR_LO] and d_year <= [YEAR_HI]
+    // group by c_city, s_city, d_year
+    // order by d_year asc, revenue desc
+
+    ssb_dim_pred_t cpred(4, in._nation, in._nation, NULL, 3);
+    ssb_dim_pred_t spred(4, in._nation, in._nation, NULL, 3);
+    ssb_date_pred_t dpred(in._year_lo, in._year_hi);
+
+    ssb_star_join_t star(_pssm, this, dpred);
+    star.join(ssb_star_join_t::CUST, cpred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.group_by(ssb_star_join_t::CUST, ssb_star_join_t::SUPP);
+
+    W_DO(star.run<ssb_group_by_value_cmp>());
+    ssb_print_rows("Q3_2", star.rows);
+    return (RCOK);
 }
 
 
@@ -985,15 +1647,39 @@ w_rc_t ShoreSSBEnv::xct_q3_2(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q3_3(const int /* xct_id */, 
-                            q3_3_input_t& /* in */)
+                            q3_3_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select c_city, s_city, d_year, sum(lo_revenue) as revenue
+    // from customer, lineorder, supplier, date
+    // where lo_custkey = c_custkey
+    // and lo_suppkey = s_suppkey
+    // and lo_orderdate = d_datekey
+    // and (c_city = [CITY_1] or c_city = [CITY_2])
+    // and (s_city = [CITY_1] or s_city = [CITY_2])
+    // and d_year >= [YEAR_LO] and d_year <= [YEAR_HI]
+    // group by c_city, s_city, d_year
+    // order by d_year asc, revenue desc
+
+    ssb_dim_pred_t cpred(3, in.c_city_1, in.c_city_1, in.c_city_2, 3);
+    ssb_dim_pred_t spred(3, in.s_city_1, in.s_city_1, in.s_city_2, 3);
+    ssb_date_pred_t dpred(in._year_lo, in._year_hi);
+
+    ssb_star_join_t star(_pssm, this, dpred);
+    star.join(ssb_star_join_t::CUST, cpred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.group_by(ssb_star_join_t::CUST, ssb_star_join_t::SUPP);
+
+    W_DO(star.run<ssb_group_by_value_cmp>());
+    ssb_print_rows("Q3_3", star.rows);
+    return (RCOK);
 }
 
+
 /******************************************************************** 
  *
  * SSB Q3_4
@@ -1001,13 +1687,37 @@ w_rc_t ShoreSSBEnv::xct_q3_3(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q3_4(const int /* xct_id */, 
-                            q3_4_input_t& /* in */)
+                            q3_4_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select c_city, s_city, d_year, sum(lo_revenue) as revenue
+    // from customer, lineorder, supplier, date
+    // where lo_custkey = c_custkey
+    // and lo_suppkey = s_suppkey
+    // and lo_orderdate = d_datekey
+    // and (c_city = [CITY_1] or c_city = [CITY_2])
+    // and (s_city = [CITY_1] or s_city = [CITY_2])
+    // and d_yearmonth = [YEARMONTH]
+    // group by c_city, s_city, d_year
+    // order by d_year asc, revenue desc
+
+    ssb_dim_pred_t cpred(3, in.c_city_1, in.c_city_1, in.c_city_2, 3);
+    ssb_dim_pred_t spred(3, in.s_city_1, in.s_city_1, in.s_city_2, 3);
+    ssb_date_pred_t dpred(0, INT_MAX);
+    dpred.yearmonth = in.d_yearmonth;
+
+    ssb_star_join_t star(_pssm, this, dpred);
+    star.join(ssb_star_join_t::CUST, cpred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.group_by(ssb_star_join_t::CUST, ssb_star_join_t::SUPP);
+
+    W_DO(star.run<ssb_group_by_value_cmp>());
+    ssb_print_rows("Q3_4", star.rows);
+    return (RCOK);
 }
 
 
@@ -1019,13 +1729,38 @@ w_rc_t ShoreSSBEnv::xct_q3_4(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q4_1(const int /* xct_id */, 
-                            q4_1_input_t& /* in */)
+                            q4_1_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select d_year, c_nation, sum(lo_revenue - lo_supplycost) as profit
+    // from date, customer, supplier, part, lineorder
+    // where lo_custkey = c_custkey
+    // and lo_suppkey = s_suppkey
+    // and lo_partkey = p_partkey
+    // and lo_orderdate = d_datekey
+    // and c_region = [REGION] and s_region = [REGION]
+    // and (p_mfgr = [MFGR_1] or p_mfgr = [MFGR_2])
+    // group by d_year, c_nation
+    // order by d_year, c_nation
+
+    ssb_dim_pred_t cpred(5, in.c_region, in.c_region, NULL, 4);
+    ssb_dim_pred_t spred(5, in.s_region, in.s_region, NULL, -1);
+    ssb_dim_pred_t ppred(2, in.p_mfgr_1, in.p_mfgr_1, in.p_mfgr_2, -1);
+
+    ssb_star_join_t star(_pssm, this, ssb_date_pred_t(0, INT_MAX));
+    star.join(ssb_star_join_t::CUST, cpred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.join(ssb_star_join_t::PART, ppred);
+    star.group_by(ssb_star_join_t::CUST, ssb_star_join_t::NONE);
+    star.sum_profit();
+
+    W_DO(star.run<ssb_group_by_year_cmp>());
+    ssb_print_rows("Q4_1", star.rows);
+    return (RCOK);
 }
 
 
@@ -1036,13 +1771,42 @@ w_rc_t ShoreSSBEnv::xct_q4_1(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q4_2(const int /* xct_id */, 
-                            q4_2_input_t& /* in */)
+                            q4_2_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
+
+    // select d_year, s_nation, p_category,
+    //        sum(lo_revenue - lo_supplycost) as profit
+    // from date, customer, supplier, part, lineorder
+    // where lo_custkey = c_custkey
+    // and lo_suppkey = s_suppkey
+    // and lo_partkey = p_partkey
+    // and lo_orderdate = d_datekey
+    // and c_region = [REGION] and s_region = [REGION]
+    // and (d_year = [YEAR_1] or d_year = [YEAR_2])
+    // and (p_mfgr = [MFGR_1] or p_mfgr = [MFGR_2])
+    // group by d_year, s_nation, p_category
+    // order by d_year, s_nation, p_category
+
+    ssb_dim_pred_t cpred(5, in.c_region, in.c_region, NULL, -1);
+    ssb_dim_pred_t spred(5, in.s_region, in.s_region, NULL, 4);
+    ssb_dim_pred_t ppred(2, in.p_mfgr_1, in.p_mfgr_1, in.p_mfgr_2, 3);
+    ssb_date_pred_t dpred(in.d_year_1, in.d_year_1);
+    dpred.year_alt = in.d_year_2;
+
+    ssb_star_join_t star(_pssm, this, dpred);
+    star.join(ssb_star_join_t::CUST, cpred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.join(ssb_star_join_t::PART, ppred);
+    star.group_by(ssb_star_join_t::SUPP, ssb_star_join_t::PART);
+    star.sum_profit();
+
+    W_DO(star.run<ssb_group_by_year_cmp>());
+    ssb_print_rows("Q4_2", star.rows);
+    return (RCOK);
 }
 
 
@@ -1053,15 +1817,44 @@ w_rc_t ShoreSSBEnv::xct_q4_2(const int /* xct_id */,
  ********************************************************************/
 
 w_rc_t ShoreSSBEnv::xct_q4_3(const int /* xct_id */, 
-                            q4_3_input_t& /* in */)
+                            q4_3_input_t& in)
 {
     // ensure a valid environment
     assert (_pssm);
     assert (_initialized);
     assert (_loaded);
-    return (RC(smlevel_0::eNOTIMPLEMENTED));
-}
 
+    // select d_year, s_city, p_brand,
+    //        sum(lo_revenue - lo_supplycost) as profit
+    // from date, customer, supplier, part, lineorder
+    // where lo_custkey = c_custkey
+    // and lo_suppkey = s_suppkey
+    // and lo_partkey = p_partkey
+    // and lo_orderdate = d_datekey
+    // and s_nation = [NATION]
+    // and (d_year = [YEAR_1] or d_year = [YEAR_2])
+    // and p_category = [CATEGORY]
+    // group by d_year, s_city, p_brand
+    // order by d_year, s_city, p_brand
+    //
+    // Like the QPipe plan, the input carries no customer predicate,
+    // so customer is not joined.
+
+    ssb_dim_pred_t spred(4, in.s_nation, in.s_nation, NULL, 3);
+    ssb_dim_pred_t ppred(3, in.p_category, in.p_category, NULL, 4);
+    ssb_date_pred_t dpred(in.d_year_1, in.d_year_1);
+    dpred.year_alt = in.d_year_2;
+
+    ssb_star_join_t star(_pssm, this, dpred);
+    star.join(ssb_star_join_t::SUPP, spred);
+    star.join(ssb_star_join_t::PART, ppred);
+    star.group_by(ssb_star_join_t::SUPP, ssb_star_join_t::PART);
+    star.sum_profit();
+
+    W_DO(star.run<ssb_group_by_year_cmp>());
+    ssb_print_rows("Q4_3", star.rows);
+    return (RCOK);
+}
 
 
 
@@ -33,6 +33,60 @@
 ENTER_NAMESPACE(tm1);
 
 
+/********************************************************************* 
+ *
+ *  tm1_prepared_input_t
+ *
+ *********************************************************************/
+
+bool tm1_prepared_input_t::supports(const int xct_type)
+{
+    return ((xct_type >= XCT_TM1_MIX) && 
+            (xct_type <= XCT_TM1_DEL_CALL_FWD_BENCH));
+}
+
+void tm1_prepared_input_t::prepare(const int xct_type, const double qf,
+                                   const int sel)
+{
+    // the trx, as ShoreTM1Env::run_one_xct() would pick it
+    int type = _g_shore_env->pick_trx(xct_type);
+
+    // the subscriber, as submit_one() would pick it
+    int selsf = sel;
+    if (sel==0)
+        selsf = URand(1,qf);
+    int selid = (selsf-1)*TM1_SUBS_PER_SF + URand(1,TM1_SUBS_PER_SF);
+    _spec = selid;
+
+    switch (type) {
+    case XCT_TM1_GET_SUB_DATA:
+        _gsd = create_get_sub_data_input(qf, selid);        set(_gsd);  break;
+    case XCT_TM1_GET_NEW_DEST:
+        _gnd = create_get_new_dest_input(qf, selid);        set(_gnd);  break;
+    case XCT_TM1_GET_ACC_DATA:
+        _gad = create_get_acc_data_input(qf, selid);        set(_gad);  break;
+    case XCT_TM1_UPD_SUB_DATA:
+        _usd = create_upd_sub_data_input(qf, selid);        set(_usd);  break;
+    case XCT_TM1_UPD_LOCATION:
+        _ul = create_upd_loc_input(qf, selid);              set(_ul);   break;
+    case XCT_TM1_INS_CALL_FWD:
+        _icf = create_ins_call_fwd_input(qf, selid);        set(_icf);  break;
+    case XCT_TM1_DEL_CALL_FWD:
+        _dcf = create_del_call_fwd_input(qf, selid);        set(_dcf);  break;
+    case XCT_TM1_GET_SUB_NBR:
+        _gsn = create_get_sub_nbr_input(qf, selid);         set(_gsn);  break;
+    case XCT_TM1_INS_CALL_FWD_BENCH:
+        _icfb = create_ins_call_fwd_bench_input(qf, selid); set(_icfb); break;
+    case XCT_TM1_DEL_CALL_FWD_BENCH:
+        _dcfb = create_del_call_fwd_bench_input(qf, selid); set(_dcfb); break;
+    default:
+        assert (0); // UNSUPPORTED TRX
+    }
+    _type = type;
+}
+
+
+
 /********************************************************************* 
  *
  *  baseline_tm1_client_t
@@ -55,6 +109,8 @@ baseline_tm1_client_t::baseline_tm1_client_t(c_str tname, const int id,
     // pick worker thread
     _worker = _env->worker(_id);
     assert (_worker);
+
+    _inputs = new_input_ring<tm1_prepared_input_t>(_id, trxid, _qf, _selid);
 }
 
 
@@ -119,6 +175,15 @@ w_rc_t baseline_tm1_client_t::submit_one(int xct_type, int xctid)
     tid_t atid;
     arequest->set(NULL,atid,xctid,atrt,xct_type,selid);
 
+    // Attach the input generated ahead (or replayed), if any
+    if (_inputs) {
+        if (prepared_input_t* pin = _inputs->take(xct_type)) {
+            arequest->set_type(pin->_type);
+            arequest->set_selectedID(pin->_spec);
+            arequest->set_input(pin);
+        }
+    }
+
     // Enqueue to the worker thread
     assert (_worker);
     _worker->enqueue(arequest,bWake);
@@ -56,6 +56,41 @@ ShoreTM1Env::ShoreTM1Env()
 { 
     _scaling_factor = TM1_DEF_SF;
     _queried_factor = TM1_DEF_QF;
+
+    _trxs.add(XCT_TM1_GET_SUB_DATA,       &ShoreTM1Env::run_get_sub_data);
+    _trxs.add(XCT_TM1_GET_NEW_DEST,       &ShoreTM1Env::run_get_new_dest);
+    _trxs.add(XCT_TM1_GET_ACC_DATA,       &ShoreTM1Env::run_get_acc_data);
+    _trxs.add(XCT_TM1_UPD_SUB_DATA,       &ShoreTM1Env::run_upd_sub_data);
+    _trxs.add(XCT_TM1_UPD_LOCATION,       &ShoreTM1Env::run_upd_loc);
+    _trxs.add(XCT_TM1_INS_CALL_FWD,       &ShoreTM1Env::run_ins_call_fwd);
+    _trxs.add(XCT_TM1_DEL_CALL_FWD,       &ShoreTM1Env::run_del_call_fwd);
+    _trxs.add(XCT_TM1_GET_SUB_NBR,        &ShoreTM1Env::run_get_sub_nbr);
+    _trxs.add(XCT_TM1_INS_CALL_FWD_BENCH, &ShoreTM1Env::run_ins_call_fwd_bench);
+    _trxs.add(XCT_TM1_DEL_CALL_FWD_BENCH, &ShoreTM1Env::run_del_call_fwd_bench);
+
+    trx_mix_t mix;
+    mix.add(XCT_TM1_GET_SUB_DATA, PROB_TM1_GET_SUB_DATA);
+    mix.add(XCT_TM1_GET_NEW_DEST, PROB_TM1_GET_NEW_DEST);
+    mix.add(XCT_TM1_GET_ACC_DATA, PROB_TM1_GET_ACC_DATA);
+    mix.add(XCT_TM1_UPD_SUB_DATA, PROB_TM1_UPD_SUB_DATA);
+    mix.add(XCT_TM1_UPD_LOCATION, PROB_TM1_UPD_LOCATION);
+    mix.add(XCT_TM1_INS_CALL_FWD, PROB_TM1_INS_CALL_FWD);
+    mix.add(XCT_TM1_DEL_CALL_FWD, PROB_TM1_DEL_CALL_FWD);
+    mix.build();
+    add_mix(XCT_TM1_MIX, mix);
+
+    // evenly one of the {Ins/Del}CallFwd{Bench}
+    trx_mix_t cf;
+    cf.add(XCT_TM1_INS_CALL_FWD, 50);
+    cf.add(XCT_TM1_DEL_CALL_FWD, 50);
+    cf.build();
+    add_mix(XCT_TM1_CALL_FWD_MIX, cf);
+
+    trx_mix_t cfb;
+    cfb.add(XCT_TM1_INS_CALL_FWD_BENCH, 50);
+    cfb.add(XCT_TM1_DEL_CALL_FWD_BENCH, 50);
+    cfb.build();
+    add_mix(XCT_TM1_CALL_FWD_MIX_BENCH, cfb);
 }
 
 ShoreTM1Env::~ShoreTM1Env()
@@ -225,6 +260,20 @@ void ShoreTM1Env::reset_skew()
 }
 
 
+/******************************************************************** 
+ *
+ *  @fn:    set_keydist()
+ *
+ *  @brief: sets the key distribution of the subscribers for TM1
+ *
+ ********************************************************************/
+void ShoreTM1Env::set_keydist(const keydist_spec_t& spec) 
+{
+    ShoreEnv::set_keydist(spec);
+    s_keydist.set(spec, (long)(_scaling_factor * TM1_SUBS_PER_SF));
+}
+
+
 /******************************************************************** 
  *
  *  @fn:    info()
@@ -183,53 +183,9 @@ w_rc_t ShoreTM1Env::run_one_xct(Request* prequest)
 	}
     }
 
-    // if BASELINE TM1 MIX
-    if (prequest->type() == XCT_TM1_MIX) {        
-        prequest->set_type(random_tm1_xct_type(smthread_t::rand()%100));
-    }
-    
-    switch (prequest->type()) {
-        
-        // TM1 BASELINE
-    case XCT_TM1_GET_SUB_DATA:
-        return (run_get_sub_data(prequest));
-    case XCT_TM1_GET_NEW_DEST:
-        return (run_get_new_dest(prequest));
-    case XCT_TM1_GET_ACC_DATA:
-        return (run_get_acc_data(prequest));
-    case XCT_TM1_UPD_SUB_DATA:
-        return (run_upd_sub_data(prequest));
-    case XCT_TM1_UPD_LOCATION:
-        return (run_upd_loc(prequest));
-    case XCT_TM1_INS_CALL_FWD:
-        return (run_ins_call_fwd(prequest));
-    case XCT_TM1_DEL_CALL_FWD:
-        return (run_del_call_fwd(prequest));
-    case XCT_TM1_CALL_FWD_MIX:
-        // evenly pick one of the {Ins/Del}CallFwd
-        if (URand(1,100)>50)
-            return (run_ins_call_fwd(prequest));
-        else
-            return (run_del_call_fwd(prequest));
-
-    case XCT_TM1_GET_SUB_NBR:
-        return (run_get_sub_nbr(prequest));
-
-    case XCT_TM1_INS_CALL_FWD_BENCH:
-        return (run_ins_call_fwd_bench(prequest));
-    case XCT_TM1_DEL_CALL_FWD_BENCH:
-        return (run_del_call_fwd_bench(prequest));
-    case XCT_TM1_CALL_FWD_MIX_BENCH:
-        // evenly pick one of the {Ins/Del}CallFwdBench
-        if (URand(1,100)>50)
-            return (run_ins_call_fwd_bench(prequest));
-        else
-            return (run_del_call_fwd_bench(prequest));
-	
-    default:
-        assert (0); // UNKNOWN TRX-ID
-    }
-    return (RCOK);
+    // if a mix (XCT_TM1_MIX, the CallFwd mixes), pick one of its trxs
+    prequest->set_type(pick_trx(prequest->type()));
+    return (_trxs.run(this, prequest));
 }
 
 
@@ -30,14 +30,15 @@
 
 #include "workload/tm1/tm1_input.h"
 
-#warning TM1: Using UZRand for generating skewed Zipfian inputs. Skewness can be controlled by the 'zipf' shell command.
-
 ENTER_NAMESPACE(tm1);	
 
 // related to dynamic skew for load imbalance
 skewer_t s_skewer;
 bool _change_load = false;
 
+// key distribution of the subscribers, set by ShoreTM1Env::set_keydist()
+keydist_t s_keydist;
+
 /* -------------------- */
 /* --- GET_SUB_DATA --- */
 /* -------------------- */
@@ -64,7 +65,7 @@ get_sub_data_input_t create_get_sub_data_input(int sf,
 	if (specificSub>0)
 	    gsdin._s_id = specificSub;
 	else
-	    gsdin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+	    gsdin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
     }
     
     return (gsdin);
@@ -101,7 +102,7 @@ get_new_dest_input_t create_get_new_dest_input(int sf,
 	if (specificSub>0)
 	    gndin._s_id = specificSub;
 	else
-	    gndin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+	    gndin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
     }
     
     gndin._sf_type = URand(1,4);
@@ -137,7 +138,7 @@ get_acc_data_input_t create_get_acc_data_input(int sf,
 	if (specificSub>0)
 	    gadin._s_id = specificSub;
 	else
-	    gadin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+	    gadin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
     }
     
     gadin._ai_type = URand(1,4);
@@ -172,7 +173,7 @@ upd_sub_data_input_t create_upd_sub_data_input(int sf,
 	if (specificSub>0)
 	    usdin._s_id = specificSub;
 	else
-	    usdin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+	    usdin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
     }
     
     usdin._sf_type = URand(1,4);
@@ -209,7 +210,7 @@ upd_loc_input_t create_upd_loc_input(int sf,
 	if (specificSub>0)
 	    ulin._s_id = specificSub;
 	else
-	    ulin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+	    ulin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
     }
     
     sprintf(ulin._sub_nbr,"%015.15d",ulin._s_id);
@@ -248,7 +249,7 @@ ins_call_fwd_input_t create_ins_call_fwd_input(int sf,
 	if (specificSub>0)
 	    icfin._s_id = specificSub;
 	else
-	    icfin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+	    icfin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
     }
     
     sprintf(icfin._sub_nbr,"%015.15d",icfin._s_id);
@@ -287,7 +288,7 @@ del_call_fwd_input_t create_del_call_fwd_input(int sf,
 	if (specificSub>0)
 	    dcfin._s_id = specificSub;
 	else
-	    dcfin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+	    dcfin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
     }
     
     sprintf(dcfin._sub_nbr,"%015.15d",dcfin._s_id);
@@ -329,7 +330,7 @@ get_sub_nbr_input_t create_get_sub_nbr_input(int sf,
 	if (specificSub>0)
 	    gsnin._s_id = specificSub;
 	else
-	    gsnin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+	    gsnin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
     }
     
     return (gsnin);
@@ -364,7 +365,7 @@ ins_call_fwd_bench_input_t create_ins_call_fwd_bench_input(int sf,
     if (specificSub>0)
         icfbin._s_id = specificSub;
     else
-        icfbin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+        icfbin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
 
     sprintf(icfbin._sub_nbr,"%015.15d",icfbin._s_id);
     icfbin._sf_type = URand(1,4);
@@ -399,7 +400,7 @@ del_call_fwd_bench_input_t create_del_call_fwd_bench_input(int sf,
     if (specificSub>0)
         dcfbin._s_id = specificSub;
     else
-        dcfbin._s_id = UZRand(1,sf*TM1_SUBS_PER_SF);
+        dcfbin._s_id = 1 + s_keydist.next(sf*TM1_SUBS_PER_SF);
 
     sprintf(dcfbin._sub_nbr,"%015.15d",dcfbin._s_id);
     dcfbin._sf_type = URand(1,4);
@@ -34,6 +34,51 @@ ENTER_NAMESPACE(tpcb);
 
 
 
+/********************************************************************* 
+ *
+ *  tpcb_prepared_input_t
+ *
+ *********************************************************************/
+
+bool tpcb_prepared_input_t::supports(const int xct_type)
+{
+    switch (xct_type) {
+    case XCT_TPCB_ACCT_UPDATE:
+    case XCT_TPCB_MBENCH_INSERT_ONLY:
+    case XCT_TPCB_MBENCH_DELETE_ONLY:
+    case XCT_TPCB_MBENCH_PROBE_ONLY:
+    case XCT_TPCB_MBENCH_INSERT_DELETE:
+    case XCT_TPCB_MBENCH_INSERT_PROBE:
+    case XCT_TPCB_MBENCH_DELETE_PROBE:
+    case XCT_TPCB_MBENCH_MIX:
+        return (true);
+    }
+    return (false);
+}
+
+void tpcb_prepared_input_t::prepare(const int xct_type, const double qf,
+                                    const int sel)
+{
+    // the trx, as ShoreTPCBEnv::run_one_xct() would pick it
+    int type = _g_shore_env->pick_trx(xct_type);
+
+    switch (type) {
+    case XCT_TPCB_ACCT_UPDATE:
+        _au = create_acct_update_input(qf, sel);          set(_au);   break;
+    case XCT_TPCB_MBENCH_INSERT_ONLY:
+        _mbio = create_mbench_insert_only_input(qf, sel); set(_mbio); break;
+    case XCT_TPCB_MBENCH_DELETE_ONLY:
+        _mbdo = create_mbench_delete_only_input(qf, sel); set(_mbdo); break;
+    case XCT_TPCB_MBENCH_PROBE_ONLY:
+        _mbpo = create_mbench_probe_only_input(qf, sel);  set(_mbpo); break;
+    default:
+        assert (0); // UNSUPPORTED TRX
+    }
+    _type = type;
+}
+
+
+
 /********************************************************************* 
  *
  *  baseline_tpcb_client_t
@@ -56,6 +101,8 @@ baseline_tpcb_client_t::baseline_tpcb_client_t(c_str tname, const int id,
     // pick worker thread
     _worker = _env->worker(_id);
     assert (_worker);
+
+    _inputs = new_input_ring<tpcb_prepared_input_t>(_id, trxid, _qf, _selid);
 }
 
 
@@ -111,6 +158,15 @@ w_rc_t baseline_tpcb_client_t::submit_one(int xct_type, int xctid)
     tid_t atid;
     arequest->set(NULL,atid,xctid,atrt,xct_type,selid);
 
+    // Attach the input generated ahead (or replayed), if any
+    if (_inputs) {
+        if (prepared_input_t* pin = _inputs->take(xct_type)) {
+            arequest->set_type(pin->_type);
+            arequest->set_selectedID(pin->_spec);
+            arequest->set_input(pin);
+        }
+    }
+
     // Enqueue to worker thread
     assert (_worker);
     _worker->enqueue(arequest,bWake);
@@ -56,6 +56,12 @@ ENTER_NAMESPACE(tpcb);
 ShoreTPCBEnv::ShoreTPCBEnv()
     : ShoreEnv()
 {
+    _trxs.add(XCT_TPCB_ACCT_UPDATE,        &ShoreTPCBEnv::run_acct_update);
+    _trxs.add(XCT_TPCB_MBENCH_INSERT_ONLY, &ShoreTPCBEnv::run_mbench_insert_only);
+    _trxs.add(XCT_TPCB_MBENCH_DELETE_ONLY, &ShoreTPCBEnv::run_mbench_delete_only);
+    _trxs.add(XCT_TPCB_MBENCH_PROBE_ONLY,  &ShoreTPCBEnv::run_mbench_probe_only);
+
+    set_freqs(_insert_freq, _delete_freq, _probe_freq);
 }
 
 ShoreTPCBEnv::~ShoreTPCBEnv()
@@ -230,6 +236,63 @@ void ShoreTPCBEnv::reset_skew()
 }
 
 
+/******************************************************************** 
+ *
+ *  @fn:    set_freqs()
+ *
+ *  @brief: Sets the frequencies and the mbench mixes made of them,
+ *          which become their defaults
+ *
+ ********************************************************************/
+void ShoreTPCBEnv::set_freqs(int insert_freq, int delete_freq, int probe_freq) 
+{
+    ShoreEnv::set_freqs(insert_freq, delete_freq, probe_freq);
+
+    trx_mix_t insdel;
+    insdel.add(XCT_TPCB_MBENCH_INSERT_ONLY, 100 - _delete_freq);
+    insdel.add(XCT_TPCB_MBENCH_DELETE_ONLY, _delete_freq);
+    insdel.build();
+    add_mix(XCT_TPCB_MBENCH_INSERT_DELETE, insdel);
+
+    trx_mix_t ip;
+    ip.add(XCT_TPCB_MBENCH_INSERT_ONLY, 100 - _probe_freq);
+    ip.add(XCT_TPCB_MBENCH_PROBE_ONLY,  _probe_freq);
+    ip.build();
+    add_mix(XCT_TPCB_MBENCH_INSERT_PROBE, ip);
+
+    trx_mix_t dp;
+    dp.add(XCT_TPCB_MBENCH_PROBE_ONLY,  100 - _delete_freq);
+    dp.add(XCT_TPCB_MBENCH_DELETE_ONLY, _delete_freq);
+    dp.build();
+    add_mix(XCT_TPCB_MBENCH_DELETE_PROBE, dp);
+
+    // deletes take what is left, if anything
+    trx_mix_t mix;
+    mix.add(XCT_TPCB_MBENCH_INSERT_ONLY, _insert_freq);
+    mix.add(XCT_TPCB_MBENCH_PROBE_ONLY,  _probe_freq);
+    mix.add(XCT_TPCB_MBENCH_DELETE_ONLY, 100 - _insert_freq - _probe_freq);
+    mix.build();
+    add_mix(XCT_TPCB_MBENCH_MIX, mix);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:    set_keydist()
+ *
+ *  @brief: sets the key distribution for TPC-B. The tellers and the
+ *          accounts are drawn within their branch.
+ *
+ ********************************************************************/
+void ShoreTPCBEnv::set_keydist(const keydist_spec_t& spec) 
+{
+    ShoreEnv::set_keydist(spec);
+    b_keydist.set(spec, (long)_scaling_factor);
+    t_keydist.set(spec, TPCB_TELLERS_PER_BRANCH);
+    a_keydist.set(spec, TPCB_ACCOUNTS_PER_BRANCH);
+}
+
+
 /******************************************************************** 
  *
  *  @fn:    info()
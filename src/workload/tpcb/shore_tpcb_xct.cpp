@@ -182,53 +182,9 @@ w_rc_t ShoreTPCBEnv::run_one_xct(Request* prequest)
 	}
     }
 
-    int rand;
-
-    switch (prequest->type()) {
-
-	// TPC-B BASELINE
-     case XCT_TPCB_ACCT_UPDATE:
-	 return (run_acct_update(prequest));
-
-	 // MBENCH BASELINE
-     case XCT_TPCB_MBENCH_INSERT_ONLY:
-	 return (run_mbench_insert_only(prequest));
-     case XCT_TPCB_MBENCH_DELETE_ONLY:
-	 return (run_mbench_delete_only(prequest));
-     case XCT_TPCB_MBENCH_PROBE_ONLY:
-	 return (run_mbench_probe_only(prequest));
-     case XCT_TPCB_MBENCH_INSERT_DELETE:
-        if (URand(1,100)>_delete_freq)
-            return (run_mbench_insert_only(prequest));
-        else
-            return (run_mbench_delete_only(prequest));
-	//return (run_mbench_insert_delete(prequest));
-     case XCT_TPCB_MBENCH_INSERT_PROBE:
-        if (URand(1,100)>_probe_freq)
-            return (run_mbench_insert_only(prequest));
-        else
-            return (run_mbench_probe_only(prequest));
-	// return (run_mbench_insert_probe(prequest));
-     case XCT_TPCB_MBENCH_DELETE_PROBE:
-        if (URand(1,100)>_delete_freq)
-            return (run_mbench_probe_only(prequest));
-        else
-            return (run_mbench_delete_only(prequest));
-	// return (run_mbench_delete_probe(prequest));
-     case XCT_TPCB_MBENCH_MIX:
-	 rand = URand(1,100); 
-        if (rand<=_insert_freq)
-            return (run_mbench_insert_only(prequest));
-        else if(rand<=_insert_freq+_probe_freq)
-            return (run_mbench_probe_only(prequest));	 
-	else 
-	    return (run_mbench_delete_only(prequest));
-	// return (run_mbench_mix(prequest));
-
-     default:
-	 assert (0); // UNKNOWN TRX-ID
-     }
-    return (RCOK);
+    // if an mbench mix, pick one of its trxs
+    prequest->set_type(pick_trx(prequest->type()));
+    return (_trxs.run(this, prequest));
 }
 
 
@@ -46,14 +46,17 @@ const int LOCAL_TPCB = 100;
 const int LOCAL_TPCB = 85;
 #endif
 
-#warning TPCB uses UZRand for generating skewed Zipfian inputs. Skewness can be controlled by the 'zipf' shell command.
-
 // related to dynamic skew for load imbalance
 skewer_t b_skewer;
 skewer_t t_skewer;
 skewer_t a_skewer;
 bool _change_load = false;
 
+// key distributions, set by ShoreTPCBEnv::set_keydist()
+keydist_t b_keydist;
+keydist_t t_keydist;
+keydist_t a_keydist;
+
 /* ------------------- */
 /* --- ACCT_UPDATE --- */
 /* ------------------- */
@@ -86,19 +89,19 @@ acct_update_input_t create_acct_update_input(int sf,
 	    auin.b_id = specificBr-1;
 	}
 	else {
-	    auin.b_id = UZRand(0,sf-1);
+	    auin.b_id = b_keydist.next(sf);
 	}
 	
-	auin.t_id = (auin.b_id * TPCB_TELLERS_PER_BRANCH) + UZRand(0,TPCB_TELLERS_PER_BRANCH-1);
+	auin.t_id = (auin.b_id * TPCB_TELLERS_PER_BRANCH) + t_keydist.next(TPCB_TELLERS_PER_BRANCH);
 
 	// 85 - 15 local Branch
 	if (URand(0,100)>LOCAL_TPCB) {
 	    // remote branch
-	    auin.a_id = (URand(0,sf)*TPCB_ACCOUNTS_PER_BRANCH) + UZRand(0,TPCB_ACCOUNTS_PER_BRANCH-1);
+	    auin.a_id = (URand(0,sf)*TPCB_ACCOUNTS_PER_BRANCH) + a_keydist.next(TPCB_ACCOUNTS_PER_BRANCH);
 	}
 	else {
 	    // local branch
-	    auin.a_id = (auin.b_id*TPCB_ACCOUNTS_PER_BRANCH) + UZRand(0,TPCB_ACCOUNTS_PER_BRANCH-1);
+	    auin.a_id = (auin.b_id*TPCB_ACCOUNTS_PER_BRANCH) + a_keydist.next(TPCB_ACCOUNTS_PER_BRANCH);
 	}
     }
     
@@ -146,11 +149,11 @@ mbench_insert_only_input_t create_mbench_insert_only_input(int sf,
         mioin.b_id = specificBr-1;
     }
     else {
-        mioin.b_id = UZRand(0,sf-1);
+        mioin.b_id = b_keydist.next(sf);
     }
         
     // local branch
-    mioin.a_id = (mioin.b_id*TPCB_ACCOUNTS_PER_BRANCH) + UZRand(0,TPCB_ACCOUNTS_PER_BRANCH-1);
+    mioin.a_id = (mioin.b_id*TPCB_ACCOUNTS_PER_BRANCH) + a_keydist.next(TPCB_ACCOUNTS_PER_BRANCH);
             
     mioin.balance = URand(0,200000000) - 100000000;
         
@@ -181,11 +184,11 @@ mbench_delete_only_input_t create_mbench_delete_only_input(int sf,
         mdoin.b_id = specificBr-1;
     }
     else {
-        mdoin.b_id = UZRand(0,sf-1);
+        mdoin.b_id = b_keydist.next(sf);
     }
         
     // local branch
-    mdoin.a_id = (mdoin.b_id*TPCB_ACCOUNTS_PER_BRANCH) + UZRand(0,TPCB_ACCOUNTS_PER_BRANCH-1);
+    mdoin.a_id = (mdoin.b_id*TPCB_ACCOUNTS_PER_BRANCH) + a_keydist.next(TPCB_ACCOUNTS_PER_BRANCH);
             
     mdoin.balance = URand(0,2000000) - 1000000;
 
@@ -217,11 +220,11 @@ mbench_probe_only_input_t create_mbench_probe_only_input(int sf,
         mpoin.b_id = specificBr-1;
     }
     else {
-        mpoin.b_id = UZRand(0,sf-1);
+        mpoin.b_id = b_keydist.next(sf);
     }
         
     // local branch
-    mpoin.a_id = (mpoin.b_id*TPCB_ACCOUNTS_PER_BRANCH) + UZRand(0,TPCB_ACCOUNTS_PER_BRANCH-1);
+    mpoin.a_id = (mpoin.b_id*TPCB_ACCOUNTS_PER_BRANCH) + a_keydist.next(TPCB_ACCOUNTS_PER_BRANCH);
             
     mpoin.balance = URand(0,200000000) - 100000000;
 
@@ -0,0 +1,431 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   chbench.cpp
+ *
+ *  @brief:  Implementation of the CH-benCHmark runs
+ *
+ */
+
+#include "workload/tpcc/chbench.h"
+
+#include "util/config.h"
+#include "util/stopwatch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+
+using namespace std;
+
+
+ENTER_NAMESPACE(tpcc);
+
+
+/*********************************************************************
+ *
+ *  ch_olap_client_t
+ *
+ *********************************************************************/
+
+ch_olap_client_t::ch_olap_client_t(c_str tname, const int id,
+                                   ShoreTPCCEnv* env,
+                                   processorid_t aprsid)
+    : base_client_t(tname,id,env,MT_TIME_DUR,-1,0,aprsid),
+      _tpccenv(env), _enabled(false)
+{
+    assert (env);
+    _nl = (envVar::instance()->getVarInt("ch-olap-nl",0) != 0);
+
+    pthread_mutex_init(&_stats_lock, NULL);
+    memset(_count, 0, sizeof(_count));
+    memset(_failed, 0, sizeof(_failed));
+    for (int q=0; q<=CH_QUERIES; q++) _secs[q] = 0;
+}
+
+ch_olap_client_t::~ch_olap_client_t()
+{
+    pthread_mutex_destroy(&_stats_lock);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    work
+ *
+ *  @brief: Runs the CH queries in turn until the measurement is done
+ *
+ *********************************************************************/
+
+void ch_olap_client_t::work()
+{
+    TRY_TO_BIND(_prs_id,_is_bound);
+
+    if (!_env->is_initialized() || !_env->is_loaded()) {
+        TRACE( TRACE_ALWAYS, "The database is not loaded...\n");
+        _rv = 1;
+        return;
+    }
+
+    int next = _id % CH_TPCC_QUERIES;
+    int xct_cnt = 0;
+    while (!is_test_aborted() && _env->get_measure() != MST_DONE) {
+        if (!_enabled) {
+            usleep(10000);
+            continue;
+        }
+        W_COERCE(submit_one(CH_TPCC_QUERY[next], xct_cnt++));
+        next = (next+1) % CH_TPCC_QUERIES;
+    }
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    submit_one
+ *
+ *  @brief: Runs one CH query, (xct_type) is the query number. The
+ *          query is not handed to a worker, it runs here.
+ *
+ *********************************************************************/
+
+w_rc_t ch_olap_client_t::submit_one(int xct_type, int xctid)
+{
+    assert ((xct_type>0) && (xct_type<=CH_QUERIES));
+
+    ch_query_input_t in;
+    in._query = xct_type;
+    in._nl = _nl;
+
+    stopwatch_t timer;
+    w_rc_t e = _tpccenv->run_ch_query(xctid, in);
+    double secs = timer.time();
+
+    if (e.is_error()) {
+        TRACE( TRACE_TRX_FLOW, "CH-Q%d failed (%d)\n",
+               xct_type, e.err_num());
+    }
+
+    if (_env->get_measure() == MST_MEASURE) {
+        CRITICAL_SECTION(cs, _stats_lock);
+        if (e.is_error()) {
+            _failed[xct_type]++;
+        }
+        else {
+            _count[xct_type]++;
+            _secs[xct_type] += secs;
+        }
+    }
+    return (RCOK);
+}
+
+
+void ch_olap_client_t::take_stats(int* count, int* failed, double* secs)
+{
+    CRITICAL_SECTION(cs, _stats_lock);
+    for (int q=0; q<=CH_QUERIES; q++) {
+        count[q] += _count[q];
+        failed[q] += _failed[q];
+        secs[q] += _secs[q];
+        _count[q] = 0;
+        _failed[q] = 0;
+        _secs[q] = 0;
+    }
+}
+
+
+
+/*********************************************************************
+ *
+ *  "chbench" command
+ *
+ *********************************************************************/
+
+void chbench_cmd_t::setaliases()
+{
+    _name = string("chbench");
+    _aliases.push_back("chbench");
+    _aliases.push_back("ch");
+}
+
+int chbench_cmd_t::handle(const char* cmd)
+{
+    char cmd_tag[SERVER_COMMAND_BUFFER_SIZE];
+    int oltp_thrs = 0;
+    int olap_thrs = 0;
+    int duration = 0;
+    int trxid = 0;
+    int iterations = 1;
+
+    if ( sscanf(cmd, "%s %d %d %d %d %d", cmd_tag, &oltp_thrs, &olap_thrs,
+                &duration, &trxid, &iterations) < 5) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+    assert (_env);
+    assert (_shell);
+
+    if ((oltp_thrs < 1) || (olap_thrs < 0) || (duration < 1) ||
+        (iterations < 1) || (oltp_thrs+olap_thrs > MAX_NUM_OF_THR)) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+    if (!_env->is_loaded()) {
+        TRACE( TRACE_ALWAYS, "The database is not loaded...\n");
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    // every OLTP client on a warehouse of its own, over the whole db
+    _env->upd_sf();
+    double qf = _env->get_sf();
+    _env->set_qf(qf);
+
+    TRACE( TRACE_ALWAYS, "CH-benCHmark: OLTP (%d) trx (%d) OLAP (%d) " \
+           "Duration (%d) Iterations (%d)\n",
+           oltp_thrs, trxid, olap_thrs, duration, iterations);
+
+    // 1. fork the clients
+    _env->set_measure(MST_WARMUP);
+    shell_expect_clients(oltp_thrs);
+
+    vector<latency_recorder_t*> recorders;
+    vector<base_client_t*> oltp;
+    for (int i=0; i<oltp_thrs; i++) {
+        recorders.push_back(new latency_recorder_t());
+        base_client_t* client =
+            _shell->new_client(c_str("CL-%d",i), i, MT_TIME_DUR, trxid, 0,
+                               PBIND_NONE, (i%(int)qf)+1, qf);
+        assert (client);
+        client->set_latencies(recorders[i]);
+        client->fork();
+        oltp.push_back(client);
+    }
+
+    vector<ch_olap_client_t*> olap;
+    for (int i=0; i<olap_thrs; i++) {
+        olap.push_back(new ch_olap_client_t(c_str("CH-%d",i), i, _env));
+        olap.back()->fork();
+    }
+
+    shell_await_clients();
+
+    // 2. the OLTP side alone, for reference
+    TRACE( TRACE_ALWAYS, "Reference (OLTP only)\n");
+    oltp_result_t ref = _measure(duration, oltp_thrs, recorders, olap);
+
+    // 3. both sides
+    for (int j=0; j<iterations && olap_thrs && !base_client_t::is_test_aborted(); j++) {
+        TRACE( TRACE_ALWAYS, "Iteration [%d of %d] (OLTP+OLAP)\n",
+               (j+1), iterations);
+        for (uint i=0; i<olap.size(); i++) olap[i]->enable(true);
+        oltp_result_t res = _measure(duration, oltp_thrs, recorders, olap);
+        for (uint i=0; i<olap.size(); i++) olap[i]->enable(false);
+
+        if ((ref.tps > 0) && (ref.p95_ms > 0)) {
+            TRACE( TRACE_ALWAYS, "OLTP degradation: tps (%.1f%%) " \
+                   "avg (x%.2f) p95 (x%.2f)\n",
+                   100.0*(1.0 - res.tps/ref.tps),
+                   res.avg_ms/ref.avg_ms, res.p95_ms/ref.p95_ms);
+        }
+    }
+
+    // 4. join the clients
+    _env->set_measure(MST_DONE);
+    for (uint i=0; i<olap.size(); i++) {
+        olap[i]->join();
+        if (olap[i]->rv()) {
+            TRACE( TRACE_ALWAYS, "Error in OLAP client (%d)...\n", i);
+        }
+        delete (olap[i]);
+    }
+    for (uint i=0; i<oltp.size(); i++) {
+        oltp[i]->join();
+        if (oltp[i]->rv()) {
+            TRACE( TRACE_ALWAYS, "Error in OLTP client (%d)...\n", i);
+        }
+        delete (oltp[i]);
+        delete (recorders[i]);
+    }
+
+    TRACE( TRACE_ALWAYS, "Preparing for the next run\n");
+    w_rc_t e = _shell->prepareNewRun();
+    if (e.is_error()) {
+        TRACE( TRACE_ALWAYS, "!!! Problem preparing for the next run\n");
+    }
+    return (SHELL_NEXT_CONTINUE);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _measure
+ *
+ *  @brief: Measures for (duration) secs, prints what both sides did,
+ *          and checkpoints
+ *
+ *  @returns: The OLTP figures of the interval
+ *
+ *********************************************************************/
+
+chbench_cmd_t::oltp_result_t
+chbench_cmd_t::_measure(const int duration, const int oltp_thrs,
+                        vector<latency_recorder_t*>& recorders,
+                        vector<ch_olap_client_t*>& olap)
+{
+    sleep(1);
+
+    // drop whatever was recorded outside the interval
+    vector<double> dropped;
+    for (uint i=0; i<recorders.size(); i++) recorders[i]->take(dropped);
+    int count[CH_QUERIES+1], failed[CH_QUERIES+1];
+    double secs[CH_QUERIES+1];
+    memset(count, 0, sizeof(count));
+    memset(failed, 0, sizeof(failed));
+    for (int q=0; q<=CH_QUERIES; q++) secs[q] = 0;
+    for (uint i=0; i<olap.size(); i++) olap[i]->take_stats(count, failed, secs);
+
+    TRACE( TRACE_ALWAYS, "begin measurement\n");
+    _env->reset_stats();
+    input_ring_t::reset_stats();
+    _env->set_measure(MST_MEASURE);
+
+    stopwatch_t timer;
+    int remaining = duration;
+    while ((remaining = sleep(remaining)) != 0 &&
+           !base_client_t::is_test_aborted()) { }
+    double delay = timer.time();
+
+    _env->set_measure(MST_PAUSE);
+    TRACE( TRACE_ALWAYS, "end measurement\n");
+
+    _env->print_throughput(_env->get_qf(), 1, oltp_thrs, delay, 0, 0);
+    input_ring_t::print_stats(delay);
+    oltp_result_t res = _print_oltp(oltp_thrs, delay, recorders);
+    _print_olap(delay, olap);
+
+    TRACE( TRACE_DEBUG, "db checkpoint - start\n");
+    _env->checkpoint();
+    TRACE( TRACE_ALWAYS, "Checkpoint\n");
+    return (res);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _print_oltp
+ *
+ *  @brief: Prints the TPC-C trxs completed in the interval and the
+ *          distribution of their response times
+ *
+ *********************************************************************/
+
+chbench_cmd_t::oltp_result_t
+chbench_cmd_t::_print_oltp(const int oltp_thrs, const double secs,
+                           vector<latency_recorder_t*>& recorders)
+{
+    vector<double> lat;
+    for (uint i=0; i<recorders.size(); i++) recorders[i]->take(lat);
+    sort(lat.begin(), lat.end());
+
+    oltp_result_t res;
+    res.tps = 0;
+    res.avg_ms = 0;
+    res.p95_ms = 0;
+    if (lat.empty() || secs <= 0) {
+        TRACE( TRACE_ALWAYS, "OLTP: no trxs completed\n");
+        return (res);
+    }
+
+    double sum = 0;
+    for (uint i=0; i<lat.size(); i++) sum += lat[i];
+
+    const uint n = lat.size();
+    res.tps = n/secs;
+    res.avg_ms = 1000*sum/n;
+    res.p95_ms = 1000*lat[min(n-1, (uint)(0.95*n))];
+
+    TRACE( TRACE_ALWAYS, "OLTP: clients (%d) trxs (%d) tps (%.2f)\n" \
+           "      avg (%.2f ms) p50 (%.2f ms) p95 (%.2f ms) " \
+           "p99 (%.2f ms) max (%.2f ms)\n",
+           oltp_thrs, n, res.tps, res.avg_ms,
+           1000*lat[min(n-1, (uint)(0.50*n))], res.p95_ms,
+           1000*lat[min(n-1, (uint)(0.99*n))], 1000*lat[n-1]);
+    return (res);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _print_olap
+ *
+ *  @brief: Prints the CH queries completed in the interval, by query
+ *
+ *********************************************************************/
+
+void chbench_cmd_t::_print_olap(const double secs,
+                                vector<ch_olap_client_t*>& olap)
+{
+    if (olap.empty()) return;
+
+    int count[CH_QUERIES+1], failed[CH_QUERIES+1];
+    double qsecs[CH_QUERIES+1];
+    memset(count, 0, sizeof(count));
+    memset(failed, 0, sizeof(failed));
+    for (int q=0; q<=CH_QUERIES; q++) qsecs[q] = 0;
+    for (uint i=0; i<olap.size(); i++) olap[i]->take_stats(count, failed, qsecs);
+
+    int total = 0;
+    for (int i=0; i<CH_TPCC_QUERIES; i++) {
+        int q = CH_TPCC_QUERY[i];
+        total += count[q];
+        if (count[q] == 0 && failed[q] == 0) continue;
+        TRACE( TRACE_ALWAYS, "CH-Q%-2d: done (%d) failed (%d) avg (%.3f secs)\n",
+               q, count[q], failed[q], (count[q] ? qsecs[q]/count[q] : 0));
+    }
+
+    TRACE( TRACE_ALWAYS, "OLAP: clients (%d) queries (%d) QphH (%.2f)\n",
+           (int)olap.size(), total, (secs > 0 ? total*3600/secs : 0));
+}
+
+
+void chbench_cmd_t::usage(void)
+{
+    TRACE( TRACE_ALWAYS, "CHBENCH Usage:\n\n"                                  \
+           "*** chbench <OLTP_THRS> <OLAP_THRS> <DURATION> <TRX_ID> [<ITERATIONS>]\n" \
+           "\nParameters:\n"                                                   \
+           "<OLTP_THRS>  - The TPC-C clients, one trx outstanding each\n"      \
+           "<OLAP_THRS>  - The clients that run the CH queries\n"              \
+           "<DURATION>   - Seconds of every measurement\n"                     \
+           "<TRX_ID>     - The TPC-C trx of the OLTP clients (e.g. the mix)\n" \
+           "<ITERATIONS> - Measurements with OLAP (default 1), after one\n"    \
+           "               with OLTP only for reference\n\n"                   \
+           "The CH queries run under SH locks, or NL if ch-olap-nl is set\n\n");
+}
+
+string chbench_cmd_t::desc() const
+{
+    return (string("Runs the CH-benCHmark, TPC-C next to the CH queries"));
+}
+
+
+EXIT_NAMESPACE(tpcc);
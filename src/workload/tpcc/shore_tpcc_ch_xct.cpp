@@ -0,0 +1,1367 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+/** @file:   shore_tpcc_ch_xct.cpp
+ *
+ *  @brief:  The CH-benCHmark analytical queries over the TPC-C tables
+ *
+ *  @note:   Only the queries that read the TPC-C tables alone, see
+ *           CH_TPCC_QUERY. The joins are hash joins on the TPC-C keys,
+ *           except for the few rows of NEW_ORDER (Q3) and the orders of
+ *           a customer (Q22), which are index nested loops.
+ */
+
+#include "workload/tpcc/shore_tpcc_env.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+using namespace shore;
+
+
+ENTER_NAMESPACE(tpcc);
+
+
+/* The date literals of the CH queries, as the timestamps the TPC-C
+ * tables store. The kit dates the rows at the time they are loaded or
+ * inserted, which is past the upper bounds of the CH date ranges, so
+ * only the lower bounds are kept; the ranges select (nearly) all the
+ * rows of the CH data as well. Undelivered order lines are dated 0.
+ */
+static const double CH_DATE_1999_01_01 = 915148800.0;
+static const double CH_DATE_2007_01_02 = 1167696000.0;
+
+// HAVING sum(ol_amount) > 200 of Q18, the amounts are in cents
+static const int CH_Q18_MIN_AMOUNT = 20000;
+
+
+// the key of an order (and of its lines)
+static inline long _ch_okey(const int w_id, const int d_id, const int o_id)
+{
+    return ((((long)w_id * DISTRICTS_PER_WAREHOUSE + d_id) << 32) | o_id);
+}
+
+// the key of a customer
+static inline long _ch_ckey(const int w_id, const int d_id, const int c_id)
+{
+    return (_ch_okey(w_id, d_id, c_id));
+}
+
+// the last character of a CHAR field, e.g. for (like '%b')
+static inline char _ch_last_char(const char* str)
+{
+    int len = strlen(str);
+    while ((len>0) && (str[len-1]==' ')) len--;
+    return (len>0 ? str[len-1] : '\0');
+}
+
+
+
+/******************************************************************** 
+ *
+ * @fn:    run_ch_query
+ *
+ * @brief: Runs one CH query as a transaction of its own
+ *
+ ********************************************************************/
+
+w_rc_t ShoreTPCCEnv::run_ch_query(const int xct_id, ch_query_input_t& in)
+{
+    W_DO(_pssm->begin_xct());
+
+    w_rc_t e;
+    switch (in._query) {
+    case 1:  e = xct_ch_q1(xct_id, in);  break;
+    case 3:  e = xct_ch_q3(xct_id, in);  break;
+    case 4:  e = xct_ch_q4(xct_id, in);  break;
+    case 6:  e = xct_ch_q6(xct_id, in);  break;
+    case 12: e = xct_ch_q12(xct_id, in); break;
+    case 13: e = xct_ch_q13(xct_id, in); break;
+    case 14: e = xct_ch_q14(xct_id, in); break;
+    case 17: e = xct_ch_q17(xct_id, in); break;
+    case 18: e = xct_ch_q18(xct_id, in); break;
+    case 19: e = xct_ch_q19(xct_id, in); break;
+    case 22: e = xct_ch_q22(xct_id, in); break;
+    default:
+        TRACE( TRACE_ALWAYS, "CH query (%d) is not supported\n", in._query);
+        e = RC(se_INVALID_INPUT);
+    }
+
+    if (e.is_error()) {
+        W_COERCE(_pssm->abort_xct());
+        return (e);
+    }
+    return (_pssm->commit_xct());
+}
+
+
+
+/******************************************************************** 
+ *
+ * CH Q1
+ *
+ ********************************************************************/
+
+struct ch_q1_group_t
+{
+    long   sum_qty;
+    long   sum_amount;
+    int    count;
+
+    ch_q1_group_t() : sum_qty(0), sum_amount(0), count(0) { }
+};
+
+w_rc_t ShoreTPCCEnv::xct_ch_q1(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select   ol_number,
+               sum(ol_quantity) as sum_qty,
+               sum(ol_amount) as sum_amount,
+               avg(ol_quantity) as avg_qty,
+               avg(ol_amount) as avg_amount,
+               count(*) as count_order
+      from     order_line
+      where    ol_delivery_d > '2007-01-02 00:00:00.000000'
+      group by ol_number
+      order by ol_number
+    */
+
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+    rep_row_t areprow(_porder_line_man->ts());
+    areprow.set(_porder_line_desc->maxsize());
+    prol->_rep = &areprow;
+
+    guard<table_scan_iter_impl<order_line_t> > ol_iter;
+    {
+	table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	TRACE( TRACE_TRX_FLOW, "App: %d CH-Q1:ol-scan\n", xct_id);
+	W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter,
+                                                      (in._nl ? NL : SH)));
+	ol_iter = tmp_ol_iter;
+    }
+
+    // ol_number is 1..MAX_OL_PER_ORDER
+    ch_q1_group_t groups[MAX_OL_PER_ORDER+1];
+    int ol_number, quantity, amount;
+    double delivery_d;
+
+    bool eof;
+    W_DO(ol_iter->next(_pssm, eof, *prol));
+    while (!eof) {
+	prol->get_value(6, delivery_d);
+	if (delivery_d > CH_DATE_2007_01_02) {
+	    prol->get_value(3, ol_number);
+	    prol->get_value(7, quantity);
+	    prol->get_value(8, amount);
+	    assert ((ol_number>0) && (ol_number<=MAX_OL_PER_ORDER));
+	    groups[ol_number].sum_qty += quantity;
+	    groups[ol_number].sum_amount += amount;
+	    groups[ol_number].count++;
+	}
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+    }
+
+    for (int i=1; i<=MAX_OL_PER_ORDER; i++) {
+	if (groups[i].count == 0) continue;
+	TRACE( TRACE_QUERY_RESULTS, "%d|%ld|%ld|%.2f|%.2f|%d\n",
+	       i, groups[i].sum_qty, groups[i].sum_amount,
+	       (double)groups[i].sum_qty/groups[i].count,
+	       (double)groups[i].sum_amount/groups[i].count,
+	       groups[i].count);
+    }
+
+    return (RCOK);
+
+} // EOF: CH-Q1
+
+
+
+/******************************************************************** 
+ *
+ * CH Q3
+ *
+ ********************************************************************/
+
+struct ch_q3_row_t
+{
+    int    o_id;
+    int    w_id;
+    int    d_id;
+    long   revenue;
+    double entry_d;
+};
+
+// order by revenue desc, o_entry_d
+static bool _ch_q3_before(const ch_q3_row_t& a, const ch_q3_row_t& b)
+{
+    if (a.revenue != b.revenue) return (a.revenue > b.revenue);
+    return (a.entry_d < b.entry_d);
+}
+
+w_rc_t ShoreTPCCEnv::xct_ch_q3(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select   ol_o_id, ol_w_id, ol_d_id,
+               sum(ol_amount) as revenue, o_entry_d
+      from     customer, new_order, orders, order_line
+      where    c_state like 'A%'
+           and c_id = o_c_id and c_w_id = o_w_id and c_d_id = o_d_id
+           and no_w_id = o_w_id and no_d_id = o_d_id and no_o_id = o_id
+           and ol_w_id = o_w_id and ol_d_id = o_d_id and ol_o_id = o_id
+           and o_entry_d > '2007-01-02 00:00:00.000000'
+      group by ol_o_id, ol_w_id, ol_d_id, o_entry_d
+      order by revenue desc, o_entry_d
+
+      plan: scan NEW_ORDER, probe "O_IDX" and "C_IDX", and iter on
+            "OL_IDX" for the lines of each order
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<new_order_man_impl> prno(_pnew_order_man);
+    tuple_guard<order_man_impl> prord(_porder_man);
+    tuple_guard<customer_man_impl> prcust(_pcustomer_man);
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+
+    rep_row_t areprow(_pcustomer_man->ts());
+    areprow.set(_pcustomer_desc->maxsize());
+    prno->_rep = &areprow;
+    prord->_rep = &areprow;
+    prcust->_rep = &areprow;
+    prol->_rep = &areprow;
+
+    rep_row_t lowrep(_porder_line_man->ts());
+    rep_row_t highrep(_porder_line_man->ts());
+    lowrep.set(_porder_line_desc->maxsize());
+    highrep.set(_porder_line_desc->maxsize());
+
+    guard<table_scan_iter_impl<new_order_t> > no_iter;
+    {
+	table_scan_iter_impl<new_order_t>* tmp_no_iter;
+	TRACE( TRACE_TRX_FLOW, "App: %d CH-Q3:no-scan\n", xct_id);
+	W_DO(_pnew_order_man->get_iter_for_file_scan(_pssm, tmp_no_iter, alm));
+	no_iter = tmp_no_iter;
+    }
+
+    std::vector<ch_q3_row_t> rows;
+    ch_q3_row_t arow;
+    int c_id, amount;
+    char c_state[3];
+
+    bool eof;
+    W_DO(no_iter->next(_pssm, eof, *prno));
+    while (!eof) {
+	prno->get_value(0, arow.o_id);
+	prno->get_value(1, arow.d_id);
+	prno->get_value(2, arow.w_id);
+
+	// the order
+	prord->set_value(0, arow.o_id);
+	prord->set_value(2, arow.d_id);
+	prord->set_value(3, arow.w_id);
+	W_DO(_porder_man->index_probe_by_name(_pssm, "O_IDX", prord, alm));
+	prord->get_value(1, c_id);
+	prord->get_value(4, arow.entry_d);
+
+	if (arow.entry_d > CH_DATE_2007_01_02) {
+
+	    // its customer
+	    prcust->set_value(0, c_id);
+	    prcust->set_value(1, arow.d_id);
+	    prcust->set_value(2, arow.w_id);
+	    W_DO(_pcustomer_man->index_probe_by_name(_pssm, "C_IDX", prcust, alm));
+	    prcust->get_value(9, c_state, 3);
+
+	    if (c_state[0] == 'A') {
+
+		// and its lines
+		guard<index_scan_iter_impl<order_line_t> > ol_iter;
+		{
+		    index_scan_iter_impl<order_line_t>* tmp_ol_iter;
+		    W_DO(_porder_line_man->ol_get_probe_iter_by_index(_pssm, tmp_ol_iter, prol,
+								      lowrep, highrep,
+								      arow.w_id, arow.d_id,
+								      arow.o_id, alm));
+		    ol_iter = tmp_ol_iter;
+		}
+
+		arow.revenue = 0;
+		bool ol_eof;
+		W_DO(ol_iter->next(_pssm, ol_eof, *prol));
+		while (!ol_eof) {
+		    prol->get_value(8, amount);
+		    arow.revenue += amount;
+		    W_DO(ol_iter->next(_pssm, ol_eof, *prol));
+		}
+		rows.push_back(arow);
+	    }
+	}
+	W_DO(no_iter->next(_pssm, eof, *prno));
+    }
+
+    std::sort(rows.begin(), rows.end(), _ch_q3_before);
+    for (uint i=0; i<rows.size(); i++) {
+	TRACE( TRACE_QUERY_RESULTS, "%d|%d|%d|%ld|%.0f\n",
+	       rows[i].o_id, rows[i].w_id, rows[i].d_id,
+	       rows[i].revenue, rows[i].entry_d);
+    }
+
+    return (RCOK);
+
+} // EOF: CH-Q3
+
+
+
+/******************************************************************** 
+ *
+ * CH Q4
+ *
+ ********************************************************************/
+
+w_rc_t ShoreTPCCEnv::xct_ch_q4(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select   o_ol_cnt, count(*) as order_count
+      from     orders
+      where    o_entry_d >= '2007-01-02 00:00:00.000000'
+           and o_entry_d < '2012-01-02 00:00:00.000000'
+           and exists (select *
+                       from   order_line
+                       where  o_id = ol_o_id and o_w_id = ol_w_id
+                          and o_d_id = ol_d_id
+                          and ol_delivery_d >= o_entry_d)
+      group by o_ol_cnt
+      order by o_ol_cnt
+
+      plan: the latest delivery of every order from a scan of
+            ORDER_LINE, then a scan of ORDERS that probes it
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+    tuple_guard<order_man_impl> prord(_porder_man);
+
+    rep_row_t areprow(_porder_line_man->ts());
+    areprow.set(_porder_line_desc->maxsize());
+    prol->_rep = &areprow;
+    prord->_rep = &areprow;
+
+    // 1. the latest delivery of every order
+    arena_hash_map_t<long, double> delivered;
+    {
+	guard<table_scan_iter_impl<order_line_t> > ol_iter;
+	{
+	    table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q4:ol-scan\n", xct_id);
+	    W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter, alm));
+	    ol_iter = tmp_ol_iter;
+	}
+
+	int o_id, d_id, w_id;
+	double delivery_d;
+	bool eof;
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+	while (!eof) {
+	    prol->get_value(0, o_id);
+	    prol->get_value(1, d_id);
+	    prol->get_value(2, w_id);
+	    prol->get_value(6, delivery_d);
+	    double& latest = delivered[_ch_okey(w_id, d_id, o_id)];
+	    if (delivery_d > latest) latest = delivery_d;
+	    W_DO(ol_iter->next(_pssm, eof, *prol));
+	}
+    }
+
+    // 2. the orders with a line delivered after their entry
+    int counts[MAX_OL_PER_ORDER+1];
+    memset(counts, 0, sizeof(counts));
+    {
+	guard<table_scan_iter_impl<order_t> > o_iter;
+	{
+	    table_scan_iter_impl<order_t>* tmp_o_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q4:o-scan\n", xct_id);
+	    W_DO(_porder_man->get_iter_for_file_scan(_pssm, tmp_o_iter, alm));
+	    o_iter = tmp_o_iter;
+	}
+
+	int o_id, d_id, w_id, ol_cnt;
+	double entry_d;
+	bool eof;
+	W_DO(o_iter->next(_pssm, eof, *prord));
+	while (!eof) {
+	    prord->get_value(4, entry_d);
+	    if (entry_d >= CH_DATE_2007_01_02) {
+		prord->get_value(0, o_id);
+		prord->get_value(2, d_id);
+		prord->get_value(3, w_id);
+		arena_hash_map_t<long, double>::iterator it =
+		    delivered.find(_ch_okey(w_id, d_id, o_id));
+		if ((it != delivered.end()) && ((*it).second >= entry_d)) {
+		    prord->get_value(6, ol_cnt);
+		    assert ((ol_cnt>0) && (ol_cnt<=MAX_OL_PER_ORDER));
+		    counts[ol_cnt]++;
+		}
+	    }
+	    W_DO(o_iter->next(_pssm, eof, *prord));
+	}
+    }
+
+    for (int i=1; i<=MAX_OL_PER_ORDER; i++) {
+	if (counts[i] == 0) continue;
+	TRACE( TRACE_QUERY_RESULTS, "%d|%d\n", i, counts[i]);
+    }
+
+    return (RCOK);
+
+} // EOF: CH-Q4
+
+
+
+/******************************************************************** 
+ *
+ * CH Q6
+ *
+ ********************************************************************/
+
+w_rc_t ShoreTPCCEnv::xct_ch_q6(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select sum(ol_amount) as revenue
+      from   order_line
+      where  ol_delivery_d >= '1999-01-01 00:00:00.000000'
+         and ol_delivery_d < '2020-01-01 00:00:00.000000'
+         and ol_quantity between 1 and 100000
+    */
+
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+    rep_row_t areprow(_porder_line_man->ts());
+    areprow.set(_porder_line_desc->maxsize());
+    prol->_rep = &areprow;
+
+    guard<table_scan_iter_impl<order_line_t> > ol_iter;
+    {
+	table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	TRACE( TRACE_TRX_FLOW, "App: %d CH-Q6:ol-scan\n", xct_id);
+	W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter,
+                                                      (in._nl ? NL : SH)));
+	ol_iter = tmp_ol_iter;
+    }
+
+    long revenue = 0;
+    int quantity, amount;
+    double delivery_d;
+
+    bool eof;
+    W_DO(ol_iter->next(_pssm, eof, *prol));
+    while (!eof) {
+	prol->get_value(6, delivery_d);
+	prol->get_value(7, quantity);
+	if ((delivery_d >= CH_DATE_1999_01_01) &&
+	    (quantity >= 1) && (quantity <= 100000)) {
+	    prol->get_value(8, amount);
+	    revenue += amount;
+	}
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+    }
+
+    TRACE( TRACE_QUERY_RESULTS, "%ld\n", revenue);
+
+    return (RCOK);
+
+} // EOF: CH-Q6
+
+
+
+/******************************************************************** 
+ *
+ * CH Q12
+ *
+ ********************************************************************/
+
+struct ch_q12_order_t
+{
+    double entry_d;
+    int    carrier_id;
+    int    ol_cnt;
+
+    ch_q12_order_t() : entry_d(0), carrier_id(0), ol_cnt(0) { }
+};
+
+w_rc_t ShoreTPCCEnv::xct_ch_q12(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select   o_ol_cnt,
+               sum(case when o_carrier_id = 1 or o_carrier_id = 2
+                        then 1 else 0 end) as high_line_count,
+               sum(case when o_carrier_id <> 1 and o_carrier_id <> 2
+                        then 1 else 0 end) as low_line_count
+      from     orders, order_line
+      where    ol_w_id = o_w_id and ol_d_id = o_d_id and ol_o_id = o_id
+           and o_entry_d <= ol_delivery_d
+           and ol_delivery_d < '2020-01-01 00:00:00.000000'
+      group by o_ol_cnt
+      order by o_ol_cnt
+
+      plan: hash ORDERS, then probe it with a scan of ORDER_LINE
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<order_man_impl> prord(_porder_man);
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+
+    rep_row_t areprow(_porder_line_man->ts());
+    areprow.set(_porder_line_desc->maxsize());
+    prord->_rep = &areprow;
+    prol->_rep = &areprow;
+
+    int o_id, d_id, w_id;
+    bool eof;
+
+    // 1. build on ORDERS
+    arena_hash_map_t<long, ch_q12_order_t> orders;
+    {
+	guard<table_scan_iter_impl<order_t> > o_iter;
+	{
+	    table_scan_iter_impl<order_t>* tmp_o_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q12:o-scan\n", xct_id);
+	    W_DO(_porder_man->get_iter_for_file_scan(_pssm, tmp_o_iter, alm));
+	    o_iter = tmp_o_iter;
+	}
+
+	W_DO(o_iter->next(_pssm, eof, *prord));
+	while (!eof) {
+	    prord->get_value(0, o_id);
+	    prord->get_value(2, d_id);
+	    prord->get_value(3, w_id);
+	    ch_q12_order_t& aorder = orders[_ch_okey(w_id, d_id, o_id)];
+	    prord->get_value(4, aorder.entry_d);
+	    prord->get_value(5, aorder.carrier_id);
+	    prord->get_value(6, aorder.ol_cnt);
+	    W_DO(o_iter->next(_pssm, eof, *prord));
+	}
+    }
+
+    // 2. probe with ORDER_LINE
+    int high[MAX_OL_PER_ORDER+1];
+    int low[MAX_OL_PER_ORDER+1];
+    memset(high, 0, sizeof(high));
+    memset(low, 0, sizeof(low));
+    {
+	guard<table_scan_iter_impl<order_line_t> > ol_iter;
+	{
+	    table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q12:ol-scan\n", xct_id);
+	    W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter, alm));
+	    ol_iter = tmp_ol_iter;
+	}
+
+	double delivery_d;
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+	while (!eof) {
+	    prol->get_value(0, o_id);
+	    prol->get_value(1, d_id);
+	    prol->get_value(2, w_id);
+	    prol->get_value(6, delivery_d);
+	    arena_hash_map_t<long, ch_q12_order_t>::iterator it =
+		orders.find(_ch_okey(w_id, d_id, o_id));
+	    if ((it != orders.end()) && ((*it).second.entry_d <= delivery_d)) {
+		const ch_q12_order_t& aorder = (*it).second;
+		assert ((aorder.ol_cnt>0) && (aorder.ol_cnt<=MAX_OL_PER_ORDER));
+		if ((aorder.carrier_id == 1) || (aorder.carrier_id == 2)) {
+		    high[aorder.ol_cnt]++;
+		}
+		else {
+		    low[aorder.ol_cnt]++;
+		}
+	    }
+	    W_DO(ol_iter->next(_pssm, eof, *prol));
+	}
+    }
+
+    for (int i=1; i<=MAX_OL_PER_ORDER; i++) {
+	if ((high[i] == 0) && (low[i] == 0)) continue;
+	TRACE( TRACE_QUERY_RESULTS, "%d|%d|%d\n", i, high[i], low[i]);
+    }
+
+    return (RCOK);
+
+} // EOF: CH-Q12
+
+
+
+/******************************************************************** 
+ *
+ * CH Q13
+ *
+ ********************************************************************/
+
+// order by custdist desc, c_count desc
+static bool _ch_q13_before(const std::pair<int,int>& a,
+                           const std::pair<int,int>& b)
+{
+    if (a.second != b.second) return (a.second > b.second);
+    return (a.first > b.first);
+}
+
+w_rc_t ShoreTPCCEnv::xct_ch_q13(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select   c_count, count(*) as custdist
+      from     (select   c_id, count(o_id) as c_count
+                from     customer left outer join orders on (
+                             c_w_id = o_w_id and c_d_id = o_d_id
+                         and c_id = o_c_id and o_carrier_id > 8)
+                group by c_id) as c_orders
+      group by c_count
+      order by custdist desc, c_count desc
+
+      plan: hash CUSTOMER, then probe it with a scan of ORDERS. As in
+            the CH spec, the inner group-by is on c_id alone.
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<customer_man_impl> prcust(_pcustomer_man);
+    tuple_guard<order_man_impl> prord(_porder_man);
+
+    rep_row_t areprow(_pcustomer_man->ts());
+    areprow.set(_pcustomer_desc->maxsize());
+    prcust->_rep = &areprow;
+    prord->_rep = &areprow;
+
+    int c_id, d_id, w_id;
+    bool eof;
+
+    // 1. build on CUSTOMER, and the c_ids with no orders yet
+    arena_hash_set_t<long> customers;
+    arena_hash_map_t<int, int> c_orders;
+    {
+	guard<table_scan_iter_impl<customer_t> > c_iter;
+	{
+	    table_scan_iter_impl<customer_t>* tmp_c_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q13:c-scan\n", xct_id);
+	    W_DO(_pcustomer_man->get_iter_for_file_scan(_pssm, tmp_c_iter, alm));
+	    c_iter = tmp_c_iter;
+	}
+
+	W_DO(c_iter->next(_pssm, eof, *prcust));
+	while (!eof) {
+	    prcust->get_value(0, c_id);
+	    prcust->get_value(1, d_id);
+	    prcust->get_value(2, w_id);
+	    customers.insert(_ch_ckey(w_id, d_id, c_id));
+	    c_orders.insert(std::make_pair(c_id, 0));
+	    W_DO(c_iter->next(_pssm, eof, *prcust));
+	}
+    }
+
+    // 2. count the orders of each c_id
+    {
+	guard<table_scan_iter_impl<order_t> > o_iter;
+	{
+	    table_scan_iter_impl<order_t>* tmp_o_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q13:o-scan\n", xct_id);
+	    W_DO(_porder_man->get_iter_for_file_scan(_pssm, tmp_o_iter, alm));
+	    o_iter = tmp_o_iter;
+	}
+
+	int carrier_id;
+	W_DO(o_iter->next(_pssm, eof, *prord));
+	while (!eof) {
+	    prord->get_value(5, carrier_id);
+	    if (carrier_id > 8) {
+		prord->get_value(1, c_id);
+		prord->get_value(2, d_id);
+		prord->get_value(3, w_id);
+		if (customers.contains(_ch_ckey(w_id, d_id, c_id))) {
+		    c_orders[c_id]++;
+		}
+	    }
+	    W_DO(o_iter->next(_pssm, eof, *prord));
+	}
+    }
+
+    // 3. the distribution of the counts
+    arena_hash_map_t<int, int> custdist;
+    arena_hash_map_t<int, int>::iterator it;
+    for (it = c_orders.begin(); it != c_orders.end(); ++it) {
+	custdist[(*it).second]++;
+    }
+
+    std::vector< std::pair<int,int> > rows(custdist.begin(), custdist.end());
+    std::sort(rows.begin(), rows.end(), _ch_q13_before);
+    for (uint i=0; i<rows.size(); i++) {
+	TRACE( TRACE_QUERY_RESULTS, "%d|%d\n", rows[i].first, rows[i].second);
+    }
+
+    return (RCOK);
+
+} // EOF: CH-Q13
+
+
+
+/******************************************************************** 
+ *
+ * CH Q14
+ *
+ ********************************************************************/
+
+w_rc_t ShoreTPCCEnv::xct_ch_q14(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select 100.00 * sum(case when i_data like 'PR%' then ol_amount
+                               else 0 end) / (1+sum(ol_amount))
+             as promo_revenue
+      from   order_line, item
+      where  ol_i_id = i_id
+         and ol_delivery_d >= '2007-01-02 00:00:00.000000'
+         and ol_delivery_d < '2020-01-02 00:00:00.000000'
+
+      plan: ITEM by i_id, then probe it with a scan of ORDER_LINE
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<item_man_impl> pritem(_pitem_man);
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+
+    rep_row_t areprow(_porder_line_man->ts());
+    areprow.set(_porder_line_desc->maxsize());
+    pritem->_rep = &areprow;
+    prol->_rep = &areprow;
+
+    int i_id;
+    bool eof;
+
+    // 1. build on ITEM, the i_ids are 1..ITEMS: 0 not there, 1 promo, 2 not promo
+    std::vector<char> items(ITEMS+1, 0);
+    {
+	guard<table_scan_iter_impl<item_t> > i_iter;
+	{
+	    table_scan_iter_impl<item_t>* tmp_i_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q14:i-scan\n", xct_id);
+	    W_DO(_pitem_man->get_iter_for_file_scan(_pssm, tmp_i_iter, alm));
+	    i_iter = tmp_i_iter;
+	}
+
+	char i_data[51];
+	W_DO(i_iter->next(_pssm, eof, *pritem));
+	while (!eof) {
+	    pritem->get_value(0, i_id);
+	    pritem->get_value(4, i_data, 51);
+	    assert ((i_id>0) && (i_id<=ITEMS));
+	    items[i_id] = (strncmp(i_data, "PR", 2) == 0 ? 1 : 2);
+	    W_DO(i_iter->next(_pssm, eof, *pritem));
+	}
+    }
+
+    // 2. probe with ORDER_LINE
+    long promo = 0;
+    long total = 0;
+    {
+	guard<table_scan_iter_impl<order_line_t> > ol_iter;
+	{
+	    table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q14:ol-scan\n", xct_id);
+	    W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter, alm));
+	    ol_iter = tmp_ol_iter;
+	}
+
+	int amount;
+	double delivery_d;
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+	while (!eof) {
+	    prol->get_value(6, delivery_d);
+	    if (delivery_d >= CH_DATE_2007_01_02) {
+		prol->get_value(4, i_id);
+		if ((i_id>0) && (i_id<=ITEMS) && items[i_id]) {
+		    prol->get_value(8, amount);
+		    total += amount;
+		    if (items[i_id] == 1) promo += amount;
+		}
+	    }
+	    W_DO(ol_iter->next(_pssm, eof, *prol));
+	}
+    }
+
+    TRACE( TRACE_QUERY_RESULTS, "%.2f\n", 100.00*promo/(1+total));
+
+    return (RCOK);
+
+} // EOF: CH-Q14
+
+
+
+/******************************************************************** 
+ *
+ * CH Q17
+ *
+ ********************************************************************/
+
+w_rc_t ShoreTPCCEnv::xct_ch_q17(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select sum(ol_amount) / 2.0 as avg_yearly
+      from   order_line,
+             (select   i_id, avg(ol_quantity) as a
+              from     item, order_line
+              where    i_data like '%b' and ol_i_id = i_id
+              group by i_id) t
+      where  ol_i_id = t.i_id
+         and ol_quantity < t.a
+
+      plan: the '%b' items by i_id, then two scans of ORDER_LINE, for
+            the average quantity of every such item and for the sum
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<item_man_impl> pritem(_pitem_man);
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+
+    rep_row_t areprow(_porder_line_man->ts());
+    areprow.set(_porder_line_desc->maxsize());
+    pritem->_rep = &areprow;
+    prol->_rep = &areprow;
+
+    int i_id, quantity, amount;
+    bool eof;
+
+    // 1. the items like '%b'
+    std::vector<char> items(ITEMS+1, 0);
+    {
+	guard<table_scan_iter_impl<item_t> > i_iter;
+	{
+	    table_scan_iter_impl<item_t>* tmp_i_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q17:i-scan\n", xct_id);
+	    W_DO(_pitem_man->get_iter_for_file_scan(_pssm, tmp_i_iter, alm));
+	    i_iter = tmp_i_iter;
+	}
+
+	char i_data[51];
+	W_DO(i_iter->next(_pssm, eof, *pritem));
+	while (!eof) {
+	    pritem->get_value(0, i_id);
+	    pritem->get_value(4, i_data, 51);
+	    assert ((i_id>0) && (i_id<=ITEMS));
+	    items[i_id] = (_ch_last_char(i_data) == 'b');
+	    W_DO(i_iter->next(_pssm, eof, *pritem));
+	}
+    }
+
+    // 2. their average ordered quantity
+    std::vector<long> qty_sum(ITEMS+1, 0);
+    std::vector<int> qty_cnt(ITEMS+1, 0);
+    {
+	guard<table_scan_iter_impl<order_line_t> > ol_iter;
+	{
+	    table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q17:ol-scan-1\n", xct_id);
+	    W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter, alm));
+	    ol_iter = tmp_ol_iter;
+	}
+
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+	while (!eof) {
+	    prol->get_value(4, i_id);
+	    if ((i_id>0) && (i_id<=ITEMS) && items[i_id]) {
+		prol->get_value(7, quantity);
+		qty_sum[i_id] += quantity;
+		qty_cnt[i_id]++;
+	    }
+	    W_DO(ol_iter->next(_pssm, eof, *prol));
+	}
+    }
+
+    // 3. the amount of their lines below the average quantity
+    long sum = 0;
+    {
+	guard<table_scan_iter_impl<order_line_t> > ol_iter;
+	{
+	    table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q17:ol-scan-2\n", xct_id);
+	    W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter, alm));
+	    ol_iter = tmp_ol_iter;
+	}
+
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+	while (!eof) {
+	    prol->get_value(4, i_id);
+	    if ((i_id>0) && (i_id<=ITEMS) && qty_cnt[i_id]) {
+		prol->get_value(7, quantity);
+		// quantity < sum/cnt
+		if ((long)quantity*qty_cnt[i_id] < qty_sum[i_id]) {
+		    prol->get_value(8, amount);
+		    sum += amount;
+		}
+	    }
+	    W_DO(ol_iter->next(_pssm, eof, *prol));
+	}
+    }
+
+    TRACE( TRACE_QUERY_RESULTS, "%.2f\n", sum/2.0);
+
+    return (RCOK);
+
+} // EOF: CH-Q17
+
+
+
+/******************************************************************** 
+ *
+ * CH Q18
+ *
+ ********************************************************************/
+
+struct ch_q18_row_t
+{
+    int    o_id;
+    int    w_id;
+    int    d_id;
+    int    c_id;
+    char   c_last[17];
+    double entry_d;
+    int    ol_cnt;
+    long   amount;
+};
+
+// order by amount_sum desc, o_entry_d
+static bool _ch_q18_before(const ch_q18_row_t& a, const ch_q18_row_t& b)
+{
+    if (a.amount != b.amount) return (a.amount > b.amount);
+    return (a.entry_d < b.entry_d);
+}
+
+w_rc_t ShoreTPCCEnv::xct_ch_q18(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select   c_last, c_id, o_id, o_entry_d, o_ol_cnt,
+               sum(ol_amount) as amount_sum
+      from     customer, orders, order_line
+      where    c_id = o_c_id and c_w_id = o_w_id and c_d_id = o_d_id
+           and ol_w_id = o_w_id and ol_d_id = o_d_id and ol_o_id = o_id
+      group by o_id, o_w_id, o_d_id, c_id, c_last, o_entry_d, o_ol_cnt
+      having   sum(ol_amount) > 200
+      order by amount_sum desc, o_entry_d
+
+      plan: the amount of every order from a scan of ORDER_LINE, a scan
+            of ORDERS for the orders above 200, and a probe of "C_IDX"
+            for their customers
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+    tuple_guard<order_man_impl> prord(_porder_man);
+    tuple_guard<customer_man_impl> prcust(_pcustomer_man);
+
+    rep_row_t areprow(_pcustomer_man->ts());
+    areprow.set(_pcustomer_desc->maxsize());
+    prol->_rep = &areprow;
+    prord->_rep = &areprow;
+    prcust->_rep = &areprow;
+
+    int o_id, d_id, w_id, amount;
+    bool eof;
+
+    // 1. the amount of every order
+    arena_hash_map_t<long, long> amounts;
+    {
+	guard<table_scan_iter_impl<order_line_t> > ol_iter;
+	{
+	    table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q18:ol-scan\n", xct_id);
+	    W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter, alm));
+	    ol_iter = tmp_ol_iter;
+	}
+
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+	while (!eof) {
+	    prol->get_value(0, o_id);
+	    prol->get_value(1, d_id);
+	    prol->get_value(2, w_id);
+	    prol->get_value(8, amount);
+	    amounts[_ch_okey(w_id, d_id, o_id)] += amount;
+	    W_DO(ol_iter->next(_pssm, eof, *prol));
+	}
+    }
+
+    // 2. the orders above the amount
+    std::vector<ch_q18_row_t> rows;
+    {
+	guard<table_scan_iter_impl<order_t> > o_iter;
+	{
+	    table_scan_iter_impl<order_t>* tmp_o_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q18:o-scan\n", xct_id);
+	    W_DO(_porder_man->get_iter_for_file_scan(_pssm, tmp_o_iter, alm));
+	    o_iter = tmp_o_iter;
+	}
+
+	ch_q18_row_t arow;
+	W_DO(o_iter->next(_pssm, eof, *prord));
+	while (!eof) {
+	    prord->get_value(0, arow.o_id);
+	    prord->get_value(2, arow.d_id);
+	    prord->get_value(3, arow.w_id);
+	    arena_hash_map_t<long, long>::iterator it =
+		amounts.find(_ch_okey(arow.w_id, arow.d_id, arow.o_id));
+	    if ((it != amounts.end()) && ((*it).second > CH_Q18_MIN_AMOUNT)) {
+		arow.amount = (*it).second;
+		prord->get_value(1, arow.c_id);
+		prord->get_value(4, arow.entry_d);
+		prord->get_value(6, arow.ol_cnt);
+		rows.push_back(arow);
+	    }
+	    W_DO(o_iter->next(_pssm, eof, *prord));
+	}
+    }
+
+    // 3. their customers
+    for (uint i=0; i<rows.size(); i++) {
+	prcust->set_value(0, rows[i].c_id);
+	prcust->set_value(1, rows[i].d_id);
+	prcust->set_value(2, rows[i].w_id);
+	W_DO(_pcustomer_man->index_probe_by_name(_pssm, "C_IDX", prcust, alm));
+	prcust->get_value(5, rows[i].c_last, 17);
+    }
+
+    std::sort(rows.begin(), rows.end(), _ch_q18_before);
+    for (uint i=0; i<rows.size(); i++) {
+	TRACE( TRACE_QUERY_RESULTS, "%s|%d|%d|%.0f|%d|%ld\n",
+	       rows[i].c_last, rows[i].c_id, rows[i].o_id,
+	       rows[i].entry_d, rows[i].ol_cnt, rows[i].amount);
+    }
+
+    return (RCOK);
+
+} // EOF: CH-Q18
+
+
+
+/******************************************************************** 
+ *
+ * CH Q19
+ *
+ ********************************************************************/
+
+w_rc_t ShoreTPCCEnv::xct_ch_q19(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select sum(ol_amount) as revenue
+      from   order_line, item
+      where  (ol_i_id = i_id and i_data like '%a'
+              and ol_quantity >= 1 and ol_quantity <= 10
+              and i_price between 1 and 400000 and ol_w_id in (1,2,3))
+          or (ol_i_id = i_id and i_data like '%b'
+              and ol_quantity >= 1 and ol_quantity <= 10
+              and i_price between 1 and 400000 and ol_w_id in (1,2,4))
+          or (ol_i_id = i_id and i_data like '%c'
+              and ol_quantity >= 1 and ol_quantity <= 10
+              and i_price between 1 and 400000 and ol_w_id in (1,5,3))
+
+      plan: the last character of the qualifying items by i_id, then
+            probe it with a scan of ORDER_LINE
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<item_man_impl> pritem(_pitem_man);
+    tuple_guard<order_line_man_impl> prol(_porder_line_man);
+
+    rep_row_t areprow(_porder_line_man->ts());
+    areprow.set(_porder_line_desc->maxsize());
+    pritem->_rep = &areprow;
+    prol->_rep = &areprow;
+
+    int i_id;
+    bool eof;
+
+    // 1. the items like '%a', '%b' or '%c' and in the price range
+    std::vector<char> items(ITEMS+1, 0);
+    {
+	guard<table_scan_iter_impl<item_t> > i_iter;
+	{
+	    table_scan_iter_impl<item_t>* tmp_i_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q19:i-scan\n", xct_id);
+	    W_DO(_pitem_man->get_iter_for_file_scan(_pssm, tmp_i_iter, alm));
+	    i_iter = tmp_i_iter;
+	}
+
+	int price;
+	char i_data[51];
+	W_DO(i_iter->next(_pssm, eof, *pritem));
+	while (!eof) {
+	    pritem->get_value(0, i_id);
+	    pritem->get_value(3, price);
+	    pritem->get_value(4, i_data, 51);
+	    assert ((i_id>0) && (i_id<=ITEMS));
+	    char last = _ch_last_char(i_data);
+	    if ((price >= 1) && (price <= 400000) &&
+		((last == 'a') || (last == 'b') || (last == 'c'))) {
+		items[i_id] = last;
+	    }
+	    W_DO(i_iter->next(_pssm, eof, *pritem));
+	}
+    }
+
+    // 2. probe with ORDER_LINE
+    long revenue = 0;
+    {
+	guard<table_scan_iter_impl<order_line_t> > ol_iter;
+	{
+	    table_scan_iter_impl<order_line_t>* tmp_ol_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q19:ol-scan\n", xct_id);
+	    W_DO(_porder_line_man->get_iter_for_file_scan(_pssm, tmp_ol_iter, alm));
+	    ol_iter = tmp_ol_iter;
+	}
+
+	int w_id, quantity, amount;
+	W_DO(ol_iter->next(_pssm, eof, *prol));
+	while (!eof) {
+	    prol->get_value(4, i_id);
+	    prol->get_value(7, quantity);
+	    if ((i_id>0) && (i_id<=ITEMS) && items[i_id] &&
+		(quantity >= 1) && (quantity <= 10)) {
+		prol->get_value(2, w_id);
+		bool match = false;
+		switch (items[i_id]) {
+		case 'a': match = ((w_id==1) || (w_id==2) || (w_id==3)); break;
+		case 'b': match = ((w_id==1) || (w_id==2) || (w_id==4)); break;
+		case 'c': match = ((w_id==1) || (w_id==5) || (w_id==3)); break;
+		}
+		if (match) {
+		    prol->get_value(8, amount);
+		    revenue += amount;
+		}
+	    }
+	    W_DO(ol_iter->next(_pssm, eof, *prol));
+	}
+    }
+
+    TRACE( TRACE_QUERY_RESULTS, "%ld\n", revenue);
+
+    return (RCOK);
+
+} // EOF: CH-Q19
+
+
+
+/******************************************************************** 
+ *
+ * CH Q22
+ *
+ ********************************************************************/
+
+struct ch_q22_group_t
+{
+    int    numcust;
+    double totacctbal;
+
+    ch_q22_group_t() : numcust(0), totacctbal(0) { }
+};
+
+w_rc_t ShoreTPCCEnv::xct_ch_q22(const int xct_id, ch_query_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /*
+      select   substr(c_state,1,1) as country,
+               count(*) as numcust,
+               sum(c_balance) as totacctbal
+      from     customer
+      where    substr(c_phone,1,1) in ('1','2','3','4','5','6','7')
+           and c_balance > (select avg(c_balance)
+                            from   customer
+                            where  c_balance > 0.00
+                               and substr(c_phone,1,1) in
+                                   ('1','2','3','4','5','6','7'))
+           and not exists (select *
+                           from   orders
+                           where  o_c_id = c_id and o_w_id = c_w_id
+                              and o_d_id = c_d_id)
+      group by substr(c_state,1,1)
+      order by substr(c_state,1,1)
+
+      plan: two scans of CUSTOMER, the second iters on "O_CUST_IDX"
+            for the orders of each qualifying customer
+    */
+
+    lock_mode_t alm = (in._nl ? NL : SH);
+
+    tuple_guard<customer_man_impl> prcust(_pcustomer_man);
+    tuple_guard<order_man_impl> prord(_porder_man);
+
+    rep_row_t areprow(_pcustomer_man->ts());
+    areprow.set(_pcustomer_desc->maxsize());
+    prcust->_rep = &areprow;
+    rep_row_t areprow_ord(_porder_man->ts());
+    areprow_ord.set(_porder_desc->maxsize());
+    prord->_rep = &areprow_ord;
+
+    rep_row_t lowrep(_porder_man->ts());
+    rep_row_t highrep(_porder_man->ts());
+    lowrep.set(_porder_desc->maxsize());
+    highrep.set(_porder_desc->maxsize());
+
+    char c_phone[17];
+    double balance;
+    bool eof;
+
+    // 1. the average positive balance
+    double sum = 0;
+    int count = 0;
+    {
+	guard<table_scan_iter_impl<customer_t> > c_iter;
+	{
+	    table_scan_iter_impl<customer_t>* tmp_c_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q22:c-scan-1\n", xct_id);
+	    W_DO(_pcustomer_man->get_iter_for_file_scan(_pssm, tmp_c_iter, alm));
+	    c_iter = tmp_c_iter;
+	}
+
+	W_DO(c_iter->next(_pssm, eof, *prcust));
+	while (!eof) {
+	    prcust->get_value(11, c_phone, 17);
+	    prcust->get_value(16, balance);
+	    if ((balance > 0) && (c_phone[0] >= '1') && (c_phone[0] <= '7')) {
+		sum += balance;
+		count++;
+	    }
+	    W_DO(c_iter->next(_pssm, eof, *prcust));
+	}
+    }
+    double avg_balance = (count ? sum/count : 0);
+
+    // 2. the customers above it with no orders, by country
+    ch_q22_group_t groups[256];
+    {
+	guard<table_scan_iter_impl<customer_t> > c_iter;
+	{
+	    table_scan_iter_impl<customer_t>* tmp_c_iter;
+	    TRACE( TRACE_TRX_FLOW, "App: %d CH-Q22:c-scan-2\n", xct_id);
+	    W_DO(_pcustomer_man->get_iter_for_file_scan(_pssm, tmp_c_iter, alm));
+	    c_iter = tmp_c_iter;
+	}
+
+	int c_id, d_id, w_id;
+	char c_state[3];
+	W_DO(c_iter->next(_pssm, eof, *prcust));
+	while (!eof) {
+	    prcust->get_value(11, c_phone, 17);
+	    prcust->get_value(16, balance);
+	    if ((balance > avg_balance) &&
+		(c_phone[0] >= '1') && (c_phone[0] <= '7')) {
+		prcust->get_value(0, c_id);
+		prcust->get_value(1, d_id);
+		prcust->get_value(2, w_id);
+
+		guard<index_scan_iter_impl<order_t> > o_iter;
+		{
+		    index_scan_iter_impl<order_t>* tmp_o_iter;
+		    W_DO(_porder_man->ord_get_iter_by_index(_pssm, tmp_o_iter, prord,
+							    lowrep, highrep,
+							    w_id, d_id, c_id,
+							    alm, false));
+		    o_iter = tmp_o_iter;
+		}
+
+		bool o_eof;
+		W_DO(o_iter->next(_pssm, o_eof, *prord));
+		if (o_eof) {
+		    prcust->get_value(9, c_state, 3);
+		    ch_q22_group_t& agroup = groups[(unsigned char)c_state[0]];
+		    agroup.numcust++;
+		    agroup.totacctbal += balance;
+		}
+	    }
+	    W_DO(c_iter->next(_pssm, eof, *prcust));
+	}
+    }
+
+    for (int i=0; i<256; i++) {
+	if (groups[i].numcust == 0) continue;
+	TRACE( TRACE_QUERY_RESULTS, "%c|%d|%.2f\n",
+	       (char)i, groups[i].numcust, groups[i].totacctbal);
+    }
+
+    return (RCOK);
+
+} // EOF: CH-Q22
+
+
+EXIT_NAMESPACE(tpcc);
@@ -33,6 +33,64 @@
 ENTER_NAMESPACE(tpcc);
 
 
+/********************************************************************* 
+ *
+ *  tpcc_prepared_input_t
+ *
+ *********************************************************************/
+
+bool tpcc_prepared_input_t::supports(const int xct_type)
+{
+    switch (xct_type) {
+    case XCT_MIX:
+    case XCT_NEW_ORDER:
+    case XCT_PAYMENT:
+    case XCT_ORDER_STATUS:
+    case XCT_DELIVERY:
+    case XCT_STOCK_LEVEL:
+    case XCT_LITTLE_MIX:
+    case XCT_MBENCH_WH:
+    case XCT_MBENCH_CUST:
+        return (true);
+    }
+    return (false);
+}
+
+void tpcc_prepared_input_t::prepare(const int xct_type, const double qf,
+                                    const int sel)
+{
+    // the trx, as ShoreTPCCEnv::run_one_xct() would pick it
+    int type = _g_shore_env->pick_trx(xct_type);
+
+    // the WH, as submit_one() would pick it
+    int whid = sel;
+    if (sel==0)
+        whid = URand(1,qf);
+    _spec = whid;
+
+    switch (type) {
+    case XCT_NEW_ORDER:
+        _no = create_new_order_input(qf, whid);       set(_no);     break;
+    case XCT_PAYMENT:
+        _pay = create_payment_input(qf, whid);        set(_pay);    break;
+    case XCT_ORDER_STATUS:
+        _os = create_order_status_input(qf, whid);    set(_os);     break;
+    case XCT_DELIVERY:
+        _del = create_delivery_input(qf, whid);       set(_del);    break;
+    case XCT_STOCK_LEVEL:
+        _sl = create_stock_level_input(qf, whid);     set(_sl);     break;
+    case XCT_MBENCH_WH:
+        _mbwh = create_mbench_wh_input(qf, whid);     set(_mbwh);   break;
+    case XCT_MBENCH_CUST:
+        _mbcust = create_mbench_cust_input(qf, whid); set(_mbcust); break;
+    default:
+        assert (0); // UNSUPPORTED TRX
+    }
+    _type = type;
+}
+
+
+
 /********************************************************************* 
  *
  *  baseline_tpcc_client_t
@@ -56,6 +114,8 @@ baseline_tpcc_client_t::baseline_tpcc_client_t(c_str tname, const int id,
     // pick worker thread
     _worker = _env->worker(_id);
     assert (_worker);
+
+    _inputs = new_input_ring<tpcc_prepared_input_t>(_id, trxid, _qf, _wh);
 }
 
 
@@ -114,6 +174,15 @@ w_rc_t baseline_tpcc_client_t::submit_one(int xct_type, int xctid)
     tid_t atid;
     arequest->set(NULL,atid,xctid,atrt,xct_type,whid);    
 
+    // Attach the input generated ahead (or replayed), if any
+    if (_inputs) {
+        if (prepared_input_t* pin = _inputs->take(xct_type)) {
+            arequest->set_type(pin->_type);
+            arequest->set_selectedID(pin->_spec);
+            arequest->set_input(pin);
+        }
+    }
+
     // Enqueue to worker thread
     assert (_worker);
     _worker->enqueue(arequest,bWake);
@@ -234,6 +234,29 @@ void ShoreTPCCEnv::table_builder_t::work()
 ShoreTPCCEnv::ShoreTPCCEnv()
     : ShoreEnv()
 {
+    _trxs.add(XCT_NEW_ORDER,    &ShoreTPCCEnv::run_new_order);
+    _trxs.add(XCT_PAYMENT,      &ShoreTPCCEnv::run_payment);
+    _trxs.add(XCT_ORDER_STATUS, &ShoreTPCCEnv::run_order_status);
+    _trxs.add(XCT_DELIVERY,     &ShoreTPCCEnv::run_delivery);
+    _trxs.add(XCT_STOCK_LEVEL,  &ShoreTPCCEnv::run_stock_level);
+    _trxs.add(XCT_MBENCH_WH,    &ShoreTPCCEnv::run_mbench_wh);
+    _trxs.add(XCT_MBENCH_CUST,  &ShoreTPCCEnv::run_mbench_cust);
+
+    // Delivery is left out of the mix, its share runs Payment
+    trx_mix_t mix;
+    mix.add(XCT_NEW_ORDER,    PROB_NEWORDER);
+    mix.add(XCT_PAYMENT,      PROB_PAYMENT + PROB_DELIVERY);
+    mix.add(XCT_ORDER_STATUS, PROB_ORDER_STATUS);
+    mix.add(XCT_STOCK_LEVEL,  PROB_STOCK_LEVEL);
+    mix.build();
+    add_mix(XCT_MIX, mix);
+
+    // Little Mix (NewOrder/Payment 50%-50%)
+    trx_mix_t little;
+    little.add(XCT_NEW_ORDER, 50);
+    little.add(XCT_PAYMENT,   50);
+    little.build();
+    add_mix(XCT_LITTLE_MIX, little);
 }
 
 ShoreTPCCEnv::~ShoreTPCCEnv() 
@@ -413,6 +436,21 @@ void ShoreTPCCEnv::reset_skew()
 }
 
 
+/******************************************************************** 
+ *
+ *  @fn:    set_keydist()
+ *
+ *  @brief: sets the key distribution of the home warehouses for TPC-C.
+ *          The remote warehouses stay uniform.
+ *
+ ********************************************************************/
+void ShoreTPCCEnv::set_keydist(const keydist_spec_t& spec) 
+{
+    ShoreEnv::set_keydist(spec);
+    w_keydist.set(spec, (long)_scaling_factor);
+}
+
+
 /******************************************************************** 
  *
  *  @fn:    info()
@@ -541,6 +579,13 @@ w_rc_t ShoreTPCCEnv::loaddata()
     int cid_array[ORDERS_PER_DIST];
     gen_cid_array(cid_array);
 
+    // With "db-bulk-index" the loaders write only the heaps
+    table_man_t* managers[] = { _pwarehouse_man, _pdistrict_man, 
+                                _pcustomer_man, _phistory_man, 
+                                _pnew_order_man, _porder_man, 
+                                _porder_line_man, _pitem_man, _pstock_man };
+    bool bulk_index = _defer_indexes(managers, SHORE_TPCC_TABLES);
+
     // 1. The table creator creates the tables and loads the first records per table
     {
 	guard<table_creator_t> tc;
@@ -574,6 +619,11 @@ w_rc_t ShoreTPCCEnv::loaddata()
 	loaders[i]->join();
     }
 
+    // and then the indexes are built in key order
+    if (bulk_index) {
+        W_DO(_bulk_build_indexes(managers, SHORE_TPCC_TABLES));
+    }
+
     time_t tstop = time(NULL);
 
     // 4. Print stats
@@ -643,42 +643,9 @@ w_rc_t ShoreTPCCEnv::run_one_xct(Request* prequest)
 	}
     }
 
-    // if BASELINE TPC-C MIX
-    if (prequest->type() == XCT_MIX) {
-        prequest->set_type(random_xct_type(smthread_t::rand()%100));
-    }
-    
-    switch (prequest->type()) {
-        
-        // TPC-C BASELINE
-    case XCT_NEW_ORDER:
-        return (run_new_order(prequest));
-    case XCT_PAYMENT:
-        return (run_payment(prequest));;
-    case XCT_ORDER_STATUS:
-        return (run_order_status(prequest));
-    case XCT_DELIVERY:
-        return (run_delivery(prequest));
-    case XCT_STOCK_LEVEL:
-        return (run_stock_level(prequest));
-
-        // Little Mix (NewOrder/Payment 50%-50%)
-    case XCT_LITTLE_MIX:
-        if (URand(1,100)>50)
-            return (run_new_order(prequest));
-        else
-            return (run_payment(prequest));
-
-
-        // MBENCH BASELINE
-    case XCT_MBENCH_WH:
-        return (run_mbench_wh(prequest));
-    case XCT_MBENCH_CUST:
-        return (run_mbench_cust(prequest)); 
-    default:
-        assert (0); // UNKNOWN TRX-ID
-    }
-    return (RCOK);
+    // if a mix (XCT_MIX, XCT_LITTLE_MIX), pick one of its trxs
+    prequest->set_type(pick_trx(prequest->type()));
+    return (_trxs.run(this, prequest));
 }
 
 
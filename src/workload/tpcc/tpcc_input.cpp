@@ -77,6 +77,9 @@ ENTER_NAMESPACE(tpcc);
 skewer_t w_skewer;
 bool _change_load = false;
 
+// key distribution of the home warehouses, set by ShoreTPCCEnv::set_keydist()
+keydist_t w_keydist;
+
 /* ----------------------- */
 /* --- NEW_ORDER_INPUT --- */
 /* ----------------------- */
@@ -220,7 +223,7 @@ new_order_input_t create_new_order_input(int sf, int specificWH)
 	if (specificWH>0)
 	    noin._wh_id = specificWH;
 	else
-	    noin._wh_id = URand(1, sf);
+	    noin._wh_id = 1 + w_keydist.next(sf);
     }
     
     noin._d_id   = URand(1, 10);
@@ -336,7 +339,7 @@ payment_input_t create_payment_input(int sf, int specificWH)
 	if (specificWH>0)
 	    pin._home_wh_id = specificWH;
 	else
-	    pin._home_wh_id = URand(1, sf);
+	    pin._home_wh_id = 1 + w_keydist.next(sf);
     }
     
     pin._home_d_id = URand(1, 10);    
@@ -453,7 +456,7 @@ order_status_input_t create_order_status_input(int sf, int specificWH)
 	if (specificWH>0)
 	    osin._wh_id = specificWH;
 	else
-	    osin._wh_id    = URand(1, sf);
+	    osin._wh_id    = 1 + w_keydist.next(sf);
     }
     
     osin._d_id     = URand(1, 10);
@@ -527,7 +530,7 @@ delivery_input_t create_delivery_input(int sf, int specificWH)
 	if (specificWH>0)
 	    din._wh_id = specificWH;
 	else
-	    din._wh_id = URand(1, sf);
+	    din._wh_id = 1 + w_keydist.next(sf);
     }
     
     din._carrier_id = URand(1, 10);
@@ -588,7 +591,7 @@ stock_level_input_t create_stock_level_input(int sf, int specificWH)
 	if (specificWH>0)
 	    slin._wh_id = specificWH;
 	else
-	    slin._wh_id = URand(1, sf);
+	    slin._wh_id = 1 + w_keydist.next(sf);
     }
     
     slin._d_id      = URand(1, 10);
@@ -0,0 +1,444 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   tpcc_rte.cpp
+ *
+ *  @brief:  Implementation of the TPC-C remote terminal emulator
+ *
+ */
+
+#include "workload/tpcc/tpcc_rte.h"
+
+#include "util/config.h"
+#include "util/stopwatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unistd.h>
+
+using namespace std;
+
+
+ENTER_NAMESPACE(tpcc);
+
+
+// the timers of a driver, in ticks of a msec
+static const int       RTE_WHEEL_BUCKETS = 8192;
+static const long long RTE_TICK_USECS    = 1000;
+
+// how long an idle driver sleeps
+static const int       RTE_POLL_USECS    = 200;
+
+static const char* RTE_TRX_NAME[RTE_TRX_TYPES] = {
+    "", "NewOrder", "Payment", "OrderStatus", "Delivery", "StockLevel" };
+
+
+
+/*********************************************************************
+ *
+ *  rte_terminal_t
+ *
+ *********************************************************************/
+
+int rte_terminal_t::draw()
+{
+    if (_next == RTE_DECK_SZ) {
+        int c = 0;
+        for (int t=1; t<RTE_TRX_TYPES; t++)
+            for (int i=0; i<RTE_DECK_CARDS[t]; i++)
+                _deck[c++] = t;
+        assert (c == RTE_DECK_SZ);
+
+        for (int i=RTE_DECK_SZ-1; i>0; i--)
+            swap(_deck[i], _deck[URand(0,i)]);
+        _next = 0;
+    }
+    return (_deck[_next++]);
+}
+
+
+
+/*********************************************************************
+ *
+ *  rte_driver_t
+ *
+ *********************************************************************/
+
+rte_driver_t::rte_driver_t(c_str tname, const int id, ShoreTPCCEnv* env,
+                           const int first, const int count, const double qf,
+                           const double scale, processorid_t aprsid)
+    : base_client_t(tname,id,env,MT_TIME_DUR,-1,0,aprsid),
+      _tpccenv(env), _first(first), _count(count), _qf(qf), _scale(scale),
+      _wheel(RTE_WHEEL_BUCKETS, RTE_TICK_USECS), _xct_cnt(0)
+{
+    assert (env);
+    assert ((_first >= 0) && (_count > 0));
+
+    // terminal i of the run is on district i%10 of WH i/10
+    _terms = new rte_terminal_t[_count];
+    for (int i=0; i<_count; i++) {
+        _terms[i]._wh = (_first+i)/RTE_TERMINALS_PER_WH + 1;
+        _terms[i]._d  = (_first+i)%RTE_TERMINALS_PER_WH + 1;
+    }
+    _waiting.reserve(_count);
+
+    pthread_mutex_init(&_stats_lock, NULL);
+}
+
+rte_driver_t::~rte_driver_t()
+{
+    assert (_waiting.empty());
+    delete [] _terms;
+    pthread_mutex_destroy(&_stats_lock);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    work
+ *
+ *  @brief: Drives the terminals until the measurement is done. The
+ *          terminals start at random within the mean think time of a
+ *          NewOrder, so that they do not all key at once.
+ *
+ *********************************************************************/
+
+void rte_driver_t::work()
+{
+    TRY_TO_BIND(_prs_id,_is_bound);
+
+    if (!_env->is_initialized() || !_env->is_loaded()) {
+        TRACE( TRACE_ALWAYS, "The database is not loaded...\n");
+        _rv = 1;
+        return;
+    }
+
+    stopwatch_t clock;
+    long long now = clock.now();
+    int stagger_ms = (int)(1000*RTE_THINK_SECS[XCT_NEW_ORDER]*_scale);
+    for (int i=0; i<_count; i++) {
+        _wheel.schedule(i, now + 1000ll*URand(0,stagger_ms));
+    }
+
+    vector<int> fired;
+    while (!is_test_aborted() && _env->get_measure() != MST_DONE) {
+        now = clock.now();
+        bool idle = true;
+
+        for (uint i=0; i<_waiting.size(); ) {
+            if (!_terms[_waiting[i]]._done.try_wait()) {
+                ++i;
+                continue;
+            }
+            _complete(_waiting[i], now);
+            _waiting[i] = _waiting.back();
+            _waiting.pop_back();
+            idle = false;
+        }
+
+        fired.clear();
+        _wheel.expire(now, fired);
+        for (uint i=0; i<fired.size(); i++) {
+            _fire(fired[i], now);
+        }
+
+        if (idle && fired.empty()) usleep(RTE_POLL_USECS);
+    }
+
+    // the trxs in flight refer to the terminals
+    while (!_waiting.empty()) {
+        if (_terms[_waiting.back()]._done.try_wait()) _waiting.pop_back();
+        else usleep(RTE_POLL_USECS);
+    }
+}
+
+
+// a timer of terminal (idx) went off
+void rte_driver_t::_fire(const int idx, const long long now)
+{
+    rte_terminal_t& t = _terms[idx];
+    switch (t._state) {
+    case rte_terminal_t::RTE_THINKING:
+        // the menu, and the keying of the next trx
+        t._type = t.draw();
+        t._state = rte_terminal_t::RTE_KEYING;
+        _wheel.schedule(idx, now + (long long)(1e6*RTE_KEYING_SECS[t._type]*_scale));
+        break;
+    case rte_terminal_t::RTE_KEYING:
+        t._state = rte_terminal_t::RTE_WAITING;
+        t._submitted = now;
+        W_COERCE(submit_one(t._type, idx));
+        _waiting.push_back(idx);
+        break;
+    default:
+        assert (0); // NO TIMER WHILE WAITING
+    }
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _complete
+ *
+ *  @brief: The trx of terminal (idx) completed. Keeps its response
+ *          time, if measuring, and thinks for a negative exponential
+ *          time truncated at 10 times the mean (Clause 5.2.5.4).
+ *
+ *********************************************************************/
+
+void rte_driver_t::_complete(const int idx, const long long now)
+{
+    rte_terminal_t& t = _terms[idx];
+    assert (t._state == rte_terminal_t::RTE_WAITING);
+
+    if (_env->get_measure() == MST_MEASURE) {
+        CRITICAL_SECTION(cs, _stats_lock);
+        _rt[t._type].push_back((now - t._submitted)/1e6);
+    }
+
+    double mean = RTE_THINK_SECS[t._type];
+    double think = min(-log(URand(1,1000000)/1e6)*mean, 10*mean);
+    t._state = rte_terminal_t::RTE_THINKING;
+    _wheel.schedule(idx, now + (long long)(1e6*think*_scale));
+}
+
+
+w_rc_t rte_driver_t::submit_one(int xct_type, int xctid)
+{
+    assert ((xctid >= 0) && (xctid < _count));
+    rte_terminal_t& t = _terms[xctid];
+
+    trx_result_tuple_t atrt;
+    atrt.set_notify(&t._done);
+
+    // the home WH of the terminal; its district for the STOCK_LEVEL
+    t._input.prepare(xct_type, _qf, t._wh);
+    if (xct_type == XCT_STOCK_LEVEL) t._input._sl._d_id = t._d;
+
+    trx_request_t* arequest = new (_env->_request_pool) trx_request_t;
+    tid_t atid;
+    arequest->set(NULL,atid,_xct_cnt++,atrt,xct_type,t._wh);
+    arequest->set_input(&t._input);
+
+    trx_worker_t* worker = _env->worker(_first+xctid);
+    assert (worker);
+    worker->enqueue(arequest,true);
+    return (RCOK);
+}
+
+
+void rte_driver_t::take_stats(vector<double>* rt)
+{
+    CRITICAL_SECTION(cs, _stats_lock);
+    for (int t=1; t<RTE_TRX_TYPES; t++) {
+        rt[t].insert(rt[t].end(), _rt[t].begin(), _rt[t].end());
+        _rt[t].clear();
+    }
+}
+
+
+
+/*********************************************************************
+ *
+ *  "rte" command
+ *
+ *********************************************************************/
+
+void rte_cmd_t::setaliases()
+{
+    _name = string("rte");
+    _aliases.push_back("rte");
+}
+
+int rte_cmd_t::handle(const char* cmd)
+{
+    char cmd_tag[SERVER_COMMAND_BUFFER_SIZE];
+    int whs = 0;
+    int drivers = 0;
+    int duration = 0;
+    int rampup = 10;
+    int scale_pct = 100;
+
+    if ( sscanf(cmd, "%s %d %d %d %d %d", cmd_tag, &whs, &drivers,
+                &duration, &rampup, &scale_pct) < 4) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+    assert (_env);
+    assert (_shell);
+
+    if ((whs < 0) || (drivers < 1) || (duration < 1) || (rampup < 0) ||
+        (scale_pct < 0) || (drivers > MAX_NUM_OF_THR)) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+    if (!_env->is_loaded()) {
+        TRACE( TRACE_ALWAYS, "The database is not loaded...\n");
+        return (SHELL_NEXT_CONTINUE);
+    }
+    if (envVar::instance()->getSysName().compare("baseline") != 0) {
+        TRACE( TRACE_ALWAYS, "The RTE runs on the Baseline workers only\n");
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    // the terminals of the first (whs) warehouses, all of them if 0
+    _env->upd_sf();
+    int sf = (int)_env->get_sf();
+    if ((whs == 0) || (whs > sf)) whs = sf;
+    _env->set_qf(whs);
+
+    const int terminals = whs*RTE_TERMINALS_PER_WH;
+    if (drivers > terminals) drivers = terminals;
+    const double scale = scale_pct/100.0;
+
+    TRACE( TRACE_ALWAYS, "RTE: WHs (%d) terminals (%d) drivers (%d) " \
+           "Duration (%d) Rampup (%d) Times (%d%%)\n",
+           whs, terminals, drivers, duration, rampup, scale_pct);
+
+    // 1. fork the drivers
+    _env->set_measure(MST_WARMUP);
+    vector<rte_driver_t*> rtes;
+    for (int i=0; i<drivers; i++) {
+        int first = (long)terminals*i/drivers;
+        int next = (long)terminals*(i+1)/drivers;
+        rtes.push_back(new rte_driver_t(c_str("RTE-%d",i), i, _env,
+                                        first, next-first, whs, scale));
+        rtes.back()->fork();
+    }
+
+    // 2. ramp up, and measure
+    int remaining = rampup;
+    while ((remaining = sleep(remaining)) != 0 &&
+           !base_client_t::is_test_aborted()) { }
+
+    TRACE( TRACE_ALWAYS, "begin measurement\n");
+    _env->reset_stats();
+    _env->set_measure(MST_MEASURE);
+
+    stopwatch_t timer;
+    remaining = duration;
+    while ((remaining = sleep(remaining)) != 0 &&
+           !base_client_t::is_test_aborted()) { }
+    double delay = timer.time();
+
+    _env->set_measure(MST_PAUSE);
+    TRACE( TRACE_ALWAYS, "end measurement\n");
+
+    _env->print_throughput(whs, 1, terminals, delay, 0, 0);
+    _print(terminals, delay, rtes);
+
+    // 3. join the drivers
+    _env->set_measure(MST_DONE);
+    for (uint i=0; i<rtes.size(); i++) {
+        rtes[i]->join();
+        if (rtes[i]->rv()) {
+            TRACE( TRACE_ALWAYS, "Error in RTE driver (%d)...\n", i);
+        }
+        delete (rtes[i]);
+    }
+
+    TRACE( TRACE_ALWAYS, "Preparing for the next run\n");
+    w_rc_t e = _shell->prepareNewRun();
+    if (e.is_error()) {
+        TRACE( TRACE_ALWAYS, "!!! Problem preparing for the next run\n");
+    }
+    return (SHELL_NEXT_CONTINUE);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _print
+ *
+ *  @brief: Prints the trxs completed in the interval by type, their
+ *          share of the mix and response times, the tpmC, and
+ *          whether the mix and the 90th percentiles are within the
+ *          limits of the spec
+ *
+ *********************************************************************/
+
+void rte_cmd_t::_print(const int terminals, const double secs,
+                       vector<rte_driver_t*>& drivers)
+{
+    vector<double> rt[RTE_TRX_TYPES];
+    for (uint i=0; i<drivers.size(); i++) drivers[i]->take_stats(rt);
+
+    uint total = 0;
+    for (int t=1; t<RTE_TRX_TYPES; t++) total += rt[t].size();
+    if ((total == 0) || (secs <= 0)) {
+        TRACE( TRACE_ALWAYS, "RTE: no trxs completed\n");
+        return;
+    }
+
+    bool compliant = true;
+    TRACE( TRACE_ALWAYS, "RTE: terminals (%d) trxs (%d) secs (%.1f)\n",
+           terminals, total, secs);
+    for (int t=1; t<RTE_TRX_TYPES; t++) {
+        vector<double>& lat = rt[t];
+        const uint n = lat.size();
+        double mix = 100.0*n/total;
+        if (n == 0) {
+            TRACE( TRACE_ALWAYS, "%-11s: none\n", RTE_TRX_NAME[t]);
+            compliant = false;
+            continue;
+        }
+        sort(lat.begin(), lat.end());
+        double sum = 0;
+        for (uint i=0; i<n; i++) sum += lat[i];
+        double p90 = lat[min(n-1, (uint)(0.90*n))];
+
+        bool ok = (mix >= RTE_MIN_MIX_PCT[t]) && (p90 <= RTE_RT90_SECS[t]);
+        compliant = compliant && ok;
+        TRACE( TRACE_ALWAYS, "%-11s: trxs (%d) mix (%.2f%%) avg (%.3f s) " \
+               "p90 (%.3f s) max (%.3f s) limit (%.0f s) %s\n",
+               RTE_TRX_NAME[t], n, mix, sum/n, p90, lat[n-1],
+               RTE_RT90_SECS[t], (ok ? "" : "!!!"));
+    }
+
+    TRACE( TRACE_ALWAYS, "tpmC (%.2f) %s\n",
+           60*rt[XCT_NEW_ORDER].size()/secs,
+           (compliant ? "" : "(mix or response times out of the spec)"));
+}
+
+
+void rte_cmd_t::usage(void)
+{
+    TRACE( TRACE_ALWAYS, "RTE Usage:\n\n"                                      \
+           "*** rte <WHS> <DRIVERS> <DURATION> [<RAMPUP>] [<TIMES%%>]\n"       \
+           "\nParameters:\n"                                                   \
+           "<WHS>      - The warehouses, 10 terminals each (0: all)\n"         \
+           "<DRIVERS>  - The threads that emulate the terminals\n"             \
+           "<DURATION> - Seconds of the measurement\n"                         \
+           "<RAMPUP>   - Seconds before the measurement (default 10)\n"        \
+           "<TIMES%%>   - The keying and think times, percent of those of\n"   \
+           "             the spec (default 100, 0 for none)\n\n"               \
+           "At the times of the spec a warehouse does at most ~12.86 tpmC\n\n");
+}
+
+string rte_cmd_t::desc() const
+{
+    return (string("Emulates the TPC-C terminals, reports tpmC"));
+}
+
+
+EXIT_NAMESPACE(tpcc);
@@ -611,6 +611,26 @@ char argv[20][100];
 	    return 0;
 	}
 
+	// Generator of the scaling and growing tables for the customers
+	// [iStart, iStart+iCount), for one of several loaders. EGen
+	// generates the same rows for a customer whichever instance does
+	// it, so the partitions together load the same database.
+	CGenerateAndLoad* egen_partition_init(TIdent iStart, TIdent iCount)
+	{
+	    assert(inputFiles!=NULL);
+	    char szLogFileName[64];
+	    snprintf(&szLogFileName[0], sizeof(szLogFileName),
+		     "EGenLoaderFrom%lldTo%lld.log",
+		     iStart, (iStart + iCount)-1);
+	    CLogFormatTab * fmt= new CLogFormatTab();
+	    CEGenLogger* log = new CEGenLogger(eDriverEGenLoader, 0, szLogFileName, fmt);
+	    return new CGenerateAndLoad(*inputFiles, iCount, iStart,
+					iTotalCustomerCount, iLoadUnitSize,
+					iScaleFactor, iDaysOfInitialTrades,
+					pLoaderFactory, log, Output, szInDir,
+					bGenerateUsingCache);
+	}
+
 	CCETxnInputGenerator*  transactions_input_init(int customers, int sf, int wdays) 
 	{	
 	//	TDriverCETxnSettings		m_DriverCETxnSettings;
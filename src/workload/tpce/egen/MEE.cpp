@@ -172,6 +172,13 @@ bool CMEE::EnableTickerTape( void )
     return( Result );
 }
 
+void CMEE::SetProcessingDelayMean( double fMean )
+{
+    m_MEELock.lock();
+    m_TradingFloor.SetProcessingDelayMean( fMean );
+    m_MEELock.unlock();
+}
+
 INT32 CMEE::GenerateTradeResult( void )
 {
     INT32   NextTime;
@@ -122,6 +122,11 @@ INT32 CMEETradingFloor::GenerateTradeResult( void )
     return( m_OrderTimers.ProcessExpiredTimers() );
 }
 
+void CMEETradingFloor::SetProcessingDelayMean( double fMean )
+{
+    m_OrderProcessingDelayMean = fMean;
+}
+
 //this code is thread-safe
 void CMEETradingFloor::SendTradeResult( PTradeRequest pTradeRequest )
 {
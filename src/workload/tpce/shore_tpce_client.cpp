@@ -30,11 +30,74 @@
 
 #include "workload/tpce/shore_tpce_client.h"
 
+#include <new>
+
 
 ENTER_NAMESPACE(tpce);
 
 
 
+/********************************************************************* 
+ *
+ *  tpce_prepared_input_t
+ *
+ *********************************************************************/
+
+// the TPC-E inputs declare an operator= they do not define, so the
+// slot copy-constructs them in place
+template <class T>
+static inline T& _renew(T& slot, const T& in)
+{
+    slot.~T();
+    return (*new (&slot) T(in));
+}
+
+
+bool tpce_prepared_input_t::supports(const int xct_type)
+{
+    return ((xct_type >= XCT_TPCE_MIX) && 
+            (xct_type <= XCT_TPCE_TRADE_CLEANUP));
+}
+
+void tpce_prepared_input_t::prepare(const int xct_type, const double qf,
+                                    const int sel)
+{
+    // the trx, as ShoreTPCEEnv::run_one_xct() would pick it
+    int type = static_cast<ShoreTPCEEnv*>(_g_shore_env)->pick_client_trx(xct_type);
+
+    switch (type) {
+    case XCT_TPCE_BROKER_VOLUME:
+        set(_renew(_bv, create_broker_volume_input(qf, sel)));      break;
+    case XCT_TPCE_CUSTOMER_POSITION:
+        set(_renew(_cp, create_customer_position_input(qf, sel)));  break;
+    case XCT_TPCE_MARKET_FEED:
+        set(_renew(_mf, create_market_feed_input(qf, sel)));        break;
+    case XCT_TPCE_MARKET_WATCH:
+        set(_renew(_mw, create_market_watch_input(qf, sel)));       break;
+    case XCT_TPCE_SECURITY_DETAIL:
+        set(_renew(_sd, create_security_detail_input(qf, sel)));    break;
+    case XCT_TPCE_TRADE_LOOKUP:
+        set(_renew(_tl, create_trade_lookup_input(qf, sel)));       break;
+    case XCT_TPCE_TRADE_ORDER:
+        set(_renew(_to, create_trade_order_input(qf, sel)));        break;
+    case XCT_TPCE_TRADE_RESULT:
+        set(_renew(_tr, create_trade_result_input(qf, sel)));       break;
+    case XCT_TPCE_TRADE_STATUS:
+        set(_renew(_ts, create_trade_status_input(qf, sel)));       break;
+    case XCT_TPCE_TRADE_UPDATE:
+        set(_renew(_tu, create_trade_update_input(qf, sel)));       break;
+    case XCT_TPCE_DATA_MAINTENANCE:
+        set(_renew(_dm, create_data_maintenance_input(qf, sel)));   break;
+    case XCT_TPCE_TRADE_CLEANUP:
+        set(_renew(_tc, create_trade_cleanup_input(qf, sel)));      break;
+    default:
+        assert (0); // UNSUPPORTED TRX
+    }
+    _type = type;
+}
+
+
+
 /********************************************************************* 
  *
  *  baseline_tpce_client_t
@@ -58,6 +121,8 @@ baseline_tpce_client_t::baseline_tpce_client_t(c_str tname, const int id,
     // pick worker thread
     _worker = _env->worker(_id);
     assert (_worker);
+
+    _inputs = new_input_ring<tpce_prepared_input_t>(_id, trxid, _qf, _selid);
 }
 
 
@@ -115,6 +180,15 @@ w_rc_t baseline_tpce_client_t::submit_one(int xct_type, int xctid)
     tid_t atid;
     arequest->set(NULL,atid,xctid,atrt,xct_type,selid);    
 
+    // Attach the input generated ahead (or replayed), if any
+    if (_inputs) {
+        if (prepared_input_t* pin = _inputs->take(xct_type)) {
+            arequest->set_type(pin->_type);
+            arequest->set_selectedID(pin->_spec);
+            arequest->set_input(pin);
+        }
+    }
+
     // Enqueue to worker thread
     assert (_worker);
     _worker->enqueue(arequest,bWake);
@@ -89,6 +89,7 @@ CMEESUT*		meesut;
 CMEE* 			mee; 
 MFBuffer* MarketFeedInputBuffer;
 TRBuffer* TradeResultInputBuffer;
+TReqBuffer* TradeRequestBuffer;
 
 #ifdef COMPILE_FLAT_FILE_LOAD 
 FILE *fssec, *fshs;
@@ -155,44 +156,47 @@ void setRNGSeeds(CCETxnInputGenerator* gen, unsigned int UniqueId )
 //check the cardinality of all tables to see if it is correctly generated
 void printCardinality()
 {
-   printf("accountPermissionBuffer.getCnt()  %d\n",accountPermissionBuffer.getCnt() );
-   printf("customerAccountBuffer.getCnt()  %d\n",customerAccountBuffer.getCnt() );
-   printf("customerTaxrateBuffer.getCnt()  %d\n",customerTaxrateBuffer.getCnt() );
-   printf("customerBuffer.getCnt()  %d\n",customerBuffer.getCnt() );
-   printf("holdingBuffer.getCnt()  %d\n",holdingBuffer.getCnt() );
-   printf("watchItemBuffer.getCnt()  %d\n",watchItemBuffer.getCnt() );
-   printf("watchListBuffer.getCnt()  %d\n",watchListBuffer.getCnt() );
-   printf("brokerBuffer.getCnt()  %d\n",brokerBuffer.getCnt() );
-   printf("cashTransactionBuffer.getCnt()  %d\n",cashTransactionBuffer.getCnt() );
    printf("chargeBuffer.getCnt()  %d\n",chargeBuffer.getCnt() );
-   printf("holdingHistoryBuffer.getCnt()  %d\n",holdingHistoryBuffer.getCnt() );
-   printf("holdingSummaryBuffer.getCnt()  %d\n",holdingSummaryBuffer.getCnt() );
    printf("commissionRateBuffer.getCnt()  %d\n",commissionRateBuffer.getCnt() );
-   printf("companyBuffer.getCnt()  %d\n",companyBuffer.getCnt() );
-   printf("companyCompetitorBuffer.getCnt()  %d\n",companyCompetitorBuffer.getCnt() );
-   printf("dailyMarketBuffer.getCnt()  %d\n",dailyMarketBuffer.getCnt() );
-  
-
-   printf("settlementBuffer.getCnt()  %d\n",settlementBuffer.getCnt() );
-   printf("tradeBuffer.getCnt()  %d\n",tradeBuffer.getCnt() );
-   printf("tradeHistoryBuffer.getCnt()  %d\n",tradeHistoryBuffer.getCnt() );
    printf("tradeTypeBuffer.getCnt()  %d\n",tradeTypeBuffer.getCnt() );
-
-
    printf("exchangeBuffer.getCnt()  %d\n",exchangeBuffer.getCnt() );
-   printf("financialBuffer.getCnt()  %d\n",financialBuffer.getCnt() );
    printf("industryBuffer.getCnt()  %d\n",industryBuffer.getCnt() );
-   printf("newsItemBuffer.getCnt()  %d\n",newsItemBuffer.getCnt() );
-   printf("lastTradeBuffer.getCnt()  %d\n",lastTradeBuffer.getCnt() );
-   printf("newsXRefBuffer.getCnt()  %d\n",newsXRefBuffer.getCnt() );
    printf("sectorBuffer.getCnt()  %d\n",sectorBuffer.getCnt() );
-   printf("securityBuffer.getCnt()  %d\n",securityBuffer.getCnt() );
-   printf("addressBuffer.getCnt()  %d\n",addressBuffer.getCnt() );
    printf("statusTypeBuffer.getCnt()  %d\n",statusTypeBuffer.getCnt() );
    printf("taxrateBuffer.getCnt()  %d\n",taxrateBuffer.getCnt() );
    printf("zipCodeBuffer.getCnt()  %d\n",zipCodeBuffer.getCnt() );
 }
 
+//and of the part of the others a loader generated
+void printCardinality(EgenLoadPartition* part)
+{
+   TRACE( TRACE_STATISTICS, "customers %lld..%lld\n",
+          part->firstCustomer, part->firstCustomer + part->customers - 1);
+   TRACE( TRACE_STATISTICS, "accountPermissionBuffer.getCnt()  %d\n", part->accountPermissionBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "customerAccountBuffer.getCnt()  %d\n", part->customerAccountBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "customerTaxrateBuffer.getCnt()  %d\n", part->customerTaxrateBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "customerBuffer.getCnt()  %d\n", part->customerBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "holdingBuffer.getCnt()  %d\n", part->holdingBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "watchItemBuffer.getCnt()  %d\n", part->watchItemBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "watchListBuffer.getCnt()  %d\n", part->watchListBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "brokerBuffer.getCnt()  %d\n", part->brokerBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "cashTransactionBuffer.getCnt()  %d\n", part->cashTransactionBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "holdingHistoryBuffer.getCnt()  %d\n", part->holdingHistoryBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "holdingSummaryBuffer.getCnt()  %d\n", part->holdingSummaryBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "companyBuffer.getCnt()  %d\n", part->companyBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "companyCompetitorBuffer.getCnt()  %d\n", part->companyCompetitorBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "dailyMarketBuffer.getCnt()  %d\n", part->dailyMarketBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "settlementBuffer.getCnt()  %d\n", part->settlementBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "tradeBuffer.getCnt()  %d\n", part->tradeBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "tradeHistoryBuffer.getCnt()  %d\n", part->tradeHistoryBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "financialBuffer.getCnt()  %d\n", part->financialBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "newsItemBuffer.getCnt()  %d\n", part->newsItemBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "lastTradeBuffer.getCnt()  %d\n", part->lastTradeBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "newsXRefBuffer.getCnt()  %d\n", part->newsXRefBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "securityBuffer.getCnt()  %d\n", part->securityBuffer.getCnt());
+   TRACE( TRACE_STATISTICS, "addressBuffer.getCnt()  %d\n", part->addressBuffer.getCnt());
+}
+
 
 void testInputs()
 {
@@ -244,7 +248,9 @@ void testInputs()
 
 /** Construction  */
 ShoreTPCEEnv::ShoreTPCEEnv():
-    ShoreEnv(), _num_invalid_input(0)
+    ShoreEnv(), 
+    _mee_driver(NULL), _tr_submitter(NULL), _mf_submitter(NULL),
+    _mee_stop(false), _num_invalid_input(0)
 {
     // read the scaling factor from the configuration file
     
@@ -286,17 +292,47 @@ ShoreTPCEEnv::ShoreTPCEEnv():
      //Initialize Market side
      MarketFeedInputBuffer = new MFBuffer();
      TradeResultInputBuffer = new TRBuffer();
+     TradeRequestBuffer = new TReqBuffer();
     
      meesut = new CMEESUT();
      meesut->setMFQueue(MarketFeedInputBuffer);
      meesut->setTRQueue(TradeResultInputBuffer);
      mee = market_init( _working_days*8, meesut, AutoRand()); 		
+     mee->SetProcessingDelayMean(envVar::instance()->getVarDouble("tpce-mee-delay",1.0));
 
 #ifdef TESTING_TPCE
     for(int i=0; i<10; i++) trxs_cnt_executed[i]= trxs_cnt_failed[i]=0;
 #endif
         TradeOrderCnt = 0;
 
+    _trxs.add(XCT_TPCE_BROKER_VOLUME,     &ShoreTPCEEnv::run_broker_volume);
+    _trxs.add(XCT_TPCE_CUSTOMER_POSITION, &ShoreTPCEEnv::run_customer_position);
+    _trxs.add(XCT_TPCE_MARKET_FEED,       &ShoreTPCEEnv::run_market_feed);
+    _trxs.add(XCT_TPCE_MARKET_WATCH,      &ShoreTPCEEnv::run_market_watch);
+    _trxs.add(XCT_TPCE_SECURITY_DETAIL,   &ShoreTPCEEnv::run_security_detail);
+    _trxs.add(XCT_TPCE_TRADE_LOOKUP,      &ShoreTPCEEnv::run_trade_lookup);
+    _trxs.add(XCT_TPCE_TRADE_ORDER,       &ShoreTPCEEnv::run_trade_order);
+    _trxs.add(XCT_TPCE_TRADE_RESULT,      &ShoreTPCEEnv::run_trade_result);
+    _trxs.add(XCT_TPCE_TRADE_STATUS,      &ShoreTPCEEnv::run_trade_status);
+    _trxs.add(XCT_TPCE_TRADE_UPDATE,      &ShoreTPCEEnv::run_trade_update);
+    _trxs.add(XCT_TPCE_DATA_MAINTENANCE,  &ShoreTPCEEnv::run_data_maintenance);
+    _trxs.add(XCT_TPCE_TRADE_CLEANUP,     &ShoreTPCEEnv::run_trade_cleanup);
+
+    // DataMaintenance and TradeCleanup are not part of the mix
+    trx_mix_t mix;
+    mix.add(XCT_TPCE_MARKET_FEED,       PROB_TPCE_MARKET_FEED);
+    mix.add(XCT_TPCE_TRADE_UPDATE,      PROB_TPCE_TRADE_UPDATE);
+    mix.add(XCT_TPCE_BROKER_VOLUME,     PROB_TPCE_BROKER_VOLUME);
+    mix.add(XCT_TPCE_TRADE_LOOKUP,      PROB_TPCE_TRADE_LOOKUP);
+    mix.add(XCT_TPCE_TRADE_RESULT,      PROB_TPCE_TRADE_RESULT);
+    mix.add(XCT_TPCE_TRADE_ORDER,       PROB_TPCE_TRADE_ORDER);
+    mix.add(XCT_TPCE_CUSTOMER_POSITION, PROB_TPCE_CUSTOMER_POSITION);
+    mix.add(XCT_TPCE_SECURITY_DETAIL,   PROB_TPCE_SECURITY_DETAIL);
+    mix.add(XCT_TPCE_MARKET_WATCH,      PROB_TPCE_MARKET_WATCH);
+    mix.add(XCT_TPCE_TRADE_STATUS,      PROB_TPCE_TRADE_STATUS);
+    mix.build();
+    add_mix(XCT_TPCE_MIX, mix);
+    _client_mix = mix.without(XCT_TPCE_TRADE_RESULT).without(XCT_TPCE_MARKET_FEED);
 }
 
 ShoreTPCEEnv::~ShoreTPCEEnv() 
@@ -305,6 +341,7 @@ ShoreTPCEEnv::~ShoreTPCEEnv()
     if (m_TxnInputGenerator) delete m_TxnInputGenerator;
     if (MarketFeedInputBuffer) delete MarketFeedInputBuffer;
     if (TradeResultInputBuffer) delete TradeResultInputBuffer;
+    if (TradeRequestBuffer) delete TradeRequestBuffer;
     if (meesut) delete meesut;
 }
 
@@ -520,6 +557,10 @@ int ShoreTPCEEnv::statistics()
 	  rval.attempted.trade_cleanup,
 	  rval.failed.trade_cleanup,
 	  rval.deadlocked.trade_cleanup);
+
+   TradeRequestBuffer->print_lag("MEE TradeRequest");
+   TradeResultInputBuffer->print_lag("MEE TradeResult");
+   MarketFeedInputBuffer->print_lag("MEE MarketFeed");
    
    ShoreEnv::statistics();
    
@@ -531,21 +572,173 @@ int ShoreTPCEEnv::statistics()
  *
  *  @fn:    start()
  *
- *  @brief: Starts the tpce env
+ *  @brief: Starts the tpce env, and the MEE driver and submitters
+ *
+ ********************************************************************/
+
+/******************************************************************** 
+ *
+ *  @fn:    _install_mix()
+ *
+ *  @brief: The clients pick the TPC-E mix without the trxs the MEE
+ *          submits, so a mix needs something else with weight
  *
  ********************************************************************/
 
+bool ShoreTPCEEnv::_install_mix(const int id, const trx_mix_t& mix)
+{
+    if (id != XCT_TPCE_MIX)
+        return (ShoreEnv::_install_mix(id, mix));
+
+    trx_mix_t client_mix = 
+        mix.without(XCT_TPCE_TRADE_RESULT).without(XCT_TPCE_MARKET_FEED);
+    if (client_mix.empty()) {
+        TRACE( TRACE_ALWAYS, 
+               "Mix (%d) has only trxs the MEE submits\n", id);
+        return (false);
+    }
+    _client_mix = client_mix;
+    return (ShoreEnv::_install_mix(id, mix));
+}
+
+
+
 int ShoreTPCEEnv::start()
 {
-    return (ShoreEnv::start());
+    int r = ShoreEnv::start();
+    if (r == 0) _start_mee();
+    return (r);
 }
 
 int ShoreTPCEEnv::stop()
 {
+    // the submitters enqueue to the workers, so they stop first
+    _stop_mee();
     return (ShoreEnv::stop());
 }
 
 
+
+/****************************************************************** 
+ *
+ * @struct: mee_driver_t
+ *
+ * @brief:  Hands the trade orders queued by TRADE_ORDER to the MEE,
+ *          and lets the MEE trade them once their simulated delay
+ *          expires. The MEE queues the TRADE_RESULT and MARKET_FEED
+ *          inputs from this thread only.
+ *
+ ******************************************************************/
+
+// the driver checks for new trade orders at least this often (msec)
+const int MEE_TICK_MS = 1;
+
+struct ShoreTPCEEnv::mee_driver_t : public thread_t {
+    ShoreTPCEEnv* _env;
+    mee_driver_t(ShoreTPCEEnv* env) 
+        : thread_t("TPC-E MEE driver"), _env(env) { }
+    virtual void work();
+};
+
+void ShoreTPCEEnv::mee_driver_t::work()
+{
+    TTradeRequest req;
+    while (!*&_env->_mee_stop) {
+        bool submitted = false;
+        while (TradeRequestBuffer->get(req)) {
+            mee->SubmitTradeRequest(&req);
+            submitted = true;
+        }
+
+        // trades whose delay expired
+        INT32 next = mee->GenerateTradeResult();
+        if (submitted) continue;
+
+        // sleep until the next trade is due, but no longer than a tick
+        if ((next == CMEE::NO_OUTSTANDING_TRADES) || (next > MEE_TICK_MS))
+            next = MEE_TICK_MS;
+        if (next > 0) 
+            ::usleep(next*1000);
+    }
+}
+
+
+
+/****************************************************************** 
+ *
+ * @struct: mee_submitter_t
+ *
+ * @brief:  Enqueues one TRADE_RESULT (or MARKET_FEED) to the workers,
+ *          round-robin, for every input the MEE queues. The trx takes
+ *          its input from the queue when it runs.
+ *
+ ******************************************************************/
+
+struct ShoreTPCEEnv::mee_submitter_t : public thread_t {
+    ShoreTPCEEnv* _env;
+    int _xct_type;
+    mee_submitter_t(ShoreTPCEEnv* env, const int xct_type) 
+        : thread_t(c_str("TPC-E MEE submitter-%d", xct_type)), 
+          _env(env), _xct_type(xct_type) { }
+    virtual void work();
+
+    // inputs the MEE queued so far
+    uint64_t _queued() {
+        if (_xct_type == XCT_TPCE_TRADE_RESULT) 
+            return (TradeResultInputBuffer->puts());
+        return (MarketFeedInputBuffer->puts());
+    }
+};
+
+void ShoreTPCEEnv::mee_submitter_t::work()
+{
+    uint64_t submitted = _queued();
+    uint next_worker = 0;
+    while (!*&_env->_mee_stop) {
+        uint64_t queued = _queued();
+        if (submitted == queued) {
+            ::usleep(MEE_TICK_MS*1000);
+            continue;
+        }
+
+        for (; submitted < queued; submitted++) {
+            trx_result_tuple_t atrt;
+            trx_request_t* arequest = new (_env->_request_pool) trx_request_t;
+            tid_t atid;
+            arequest->set(NULL,atid,(int)submitted,atrt,_xct_type,0);
+            _env->worker(next_worker++)->enqueue(arequest);
+        }
+    }
+}
+
+
+void ShoreTPCEEnv::_start_mee()
+{
+    assert (!_mee_driver);
+    _mee_stop = false;
+    _mee_driver = new mee_driver_t(this);
+    _tr_submitter = new mee_submitter_t(this, XCT_TPCE_TRADE_RESULT);
+    _mf_submitter = new mee_submitter_t(this, XCT_TPCE_MARKET_FEED);
+    _mee_driver->fork();
+    _tr_submitter->fork();
+    _mf_submitter->fork();
+}
+
+void ShoreTPCEEnv::_stop_mee()
+{
+    if (!_mee_driver) return;
+    _mee_stop = true;
+    _tr_submitter->join();
+    _mf_submitter->join();
+    _mee_driver->join();
+    delete (_tr_submitter);
+    delete (_mf_submitter);
+    delete (_mee_driver);
+    _tr_submitter = _mf_submitter = NULL;
+    _mee_driver = NULL;
+}
+
+
 /******************************************************************** 
  *
  *  @fn:    set_sf/qf
@@ -602,19 +795,23 @@ struct ShoreTPCEEnv::checkpointer_t : public thread_t {
 
 /****************************************************************** 
  *
- * @struct: table_creator_t
+ * @class: table_builder_t
  *
- * @brief:  Helper class for creating the environment tables and
- *          loading a number of records in a single-threaded fashion
+ * @brief:  Helper class for loading the scaling and growing tables
+ *          for a range of customers, made of whole EGen load
+ *          units. The first loader also loads the fixed tables.
  *
  ******************************************************************/
 
 class ShoreTPCEEnv::table_builder_t : public thread_t {
     ShoreTPCEEnv* _env;
-    int my_load_unit;
+    int _loader_id;
+    TIdent _start;
+    TIdent _count;
 public:
-    table_builder_t(ShoreTPCEEnv* env)
-	: thread_t("TPC-E loader"), _env(env) { }
+    table_builder_t(ShoreTPCEEnv* env, int id, TIdent start, TIdent count)
+	: thread_t(c_str("TPC-E loader-%d", id)), _env(env), 
+          _loader_id(id), _start(start), _count(count) { }
     virtual void work();
 };
 
@@ -623,58 +820,39 @@ void ShoreTPCEEnv::table_builder_t::work()
     w_rc_t e = RCOK;
 
     //populating fixed
-    populate_small_input_t in;
-    long log_space_needed = 0;
-    _env->read_small();
- retry:
-    W_COERCE(_env->db()->begin_xct());
-
-    if(log_space_needed > 0) {
-        W_COERCE(_env->db()->xct_reserve_log_space(log_space_needed));
-    }
+    if (_loader_id == 0) {
+        populate_small_input_t in;
+        long log_space_needed = 0;
+        _env->read_small();
+    retry:
+        W_COERCE(_env->db()->begin_xct());
+
+        if(log_space_needed > 0) {
+            W_COERCE(_env->db()->xct_reserve_log_space(log_space_needed));
+        }
 
-    e = _env->xct_populate_small(1, in);    
-    CHECK_XCT_RETURN(e,log_space_needed,retry,_env);
-    _env->release_small();
-
-    //populating scaling tables
-    _env->populate_address(); 
-    _env->populate_customer();
-    _env->populate_ca_and_ap();
-    _env->populate_customer_taxrate();
-    _env->populate_wl_and_wi(); 
-
-    _env->populate_company(); 
-    _env->populate_company_competitor();
-    _env->populate_daily_market();
-    _env->populate_financial();
-    _env->populate_last_trade();
-    _env-> populate_ni_and_nx();
-    _env->populate_security();
-
-    //populate growing tables
-    _env-> populate_growing();
-    printCardinality();
-#ifdef COMPILE_FLAT_FILE_LOAD 
-    fclose(fshs);
-    fclose(fssec);
-#endif
-    //  testInputs();
-    _env->find_maxtrade_id();
+        e = _env->xct_populate_small(1, in);    
+        CHECK_XCT_RETURN(e,log_space_needed,retry,_env);
+        _env->release_small();
+        printCardinality();
+    }
 
+    //populating scaling and growing tables
+    EgenLoadPartition part(_start, _count);
+    _env->populate_partition(&part);
+    printCardinality(&part);
 }
 
 
 
 /****************************************************************** 
  *
- * @class: table_builder_t
+ * @struct: table_creator_t
  *
- * @brief:  Helper class for loading the environment tables
+ * @brief:  Helper class for creating the environment tables
  *
  ******************************************************************/
 
-
 struct ShoreTPCEEnv::table_creator_t : public thread_t {
     ShoreTPCEEnv* _env;
      table_creator_t(ShoreTPCEEnv* env)
@@ -785,6 +963,22 @@ w_rc_t ShoreTPCEEnv::loaddata()
     CRITICAL_SECTION(scale_cs, _scaling_mutex);
     time_t tstart = time(NULL); 
 
+    // 1. With "db-bulk-index" the loaders write only the heaps
+    table_man_t* managers[] = { 
+        _psector_man, _pcharge_man, _pcommission_rate_man, _pexchange_man,
+        _pindustry_man, _pstatus_type_man, _ptaxrate_man, _ptrade_type_man,
+        _pzip_code_man, 
+        _pcash_transaction_man, _psettlement_man, _ptrade_man, 
+        _ptrade_history_man, _ptrade_request_man, 
+        _paccount_permission_man, _pbroker_man, _pcompany_man, 
+        _pcustomer_man, _pcompany_competitor_man, _psecurity_man, 
+        _pcustomer_account_man, _pdaily_market_man, _pcustomer_taxrate_man,
+        _pholding_man, _pfinancial_man, _pholding_history_man, 
+        _paddress_man, _pholding_summary_man, _plast_trade_man, 
+        _pwatch_list_man, _pwatch_item_man, _pnews_item_man, 
+        _pnews_xref_man };
+    bool bulk_index = _defer_indexes(managers, SHORE_TPCE_TABLES);
+
     // 2. Fire up the table creator and baseline loader
     {
 	guard<table_creator_t> tc;
@@ -797,14 +991,44 @@ w_rc_t ShoreTPCEEnv::loaddata()
     chk->fork();
  
 
-    // 4. Fire up the loaders
-    TRACE( TRACE_ALWAYS, "Firing up %d loaders ..\n", 1);
+    // 4. Fire up the loaders, each with a range of whole load units
+    int loaders_to_use = envVar::instance()->getVarInt("db-loaders",10);
+#ifdef COMPILE_FLAT_FILE_LOAD 
+    // they would all write to the same flat files
+    loaders_to_use = 1;
+#endif
+    int total_units = _customers / TPCE_CUSTS_PER_LU;
+    if (loaders_to_use > total_units) loaders_to_use = total_units;
+    if (loaders_to_use < 1) loaders_to_use = 1;
+    int units_per_thread = (total_units + loaders_to_use-1)/loaders_to_use;
+    loaders_to_use = (total_units + units_per_thread-1)/units_per_thread;
+
+    TRACE( TRACE_ALWAYS, "Firing up %d loaders ..\n", loaders_to_use);
     {
-      guard<table_builder_t>loader = new table_builder_t(this);
-      // array_guard_t< guard<table_builder_t> > loaders(new guard<table_builder_t>[loaders_to_use]);
-      loader->fork();
-      loader->join();
-    }  
+        array_guard_t< guard<table_builder_t> > loaders(new guard<table_builder_t>[loaders_to_use]);
+        for(int i=0; i < loaders_to_use; i++) {
+            int start = i*units_per_thread;
+            int count = (start+units_per_thread > total_units)? 
+                total_units-start : units_per_thread;
+            loaders[i] = new table_builder_t(this, i,
+                                             (TIdent)start*TPCE_CUSTS_PER_LU + 1,
+                                             (TIdent)count*TPCE_CUSTS_PER_LU);
+            loaders[i]->fork();
+        }
+        for(int i=0; i < loaders_to_use; i++) {
+            loaders[i]->join();
+        }
+    }
+#ifdef COMPILE_FLAT_FILE_LOAD 
+    fclose(fshs);
+    fclose(fssec);
+#endif
+
+    // and then the indexes are built in key order
+    if (bulk_index) {
+        W_DO(_bulk_build_indexes(managers, SHORE_TPCE_TABLES));
+    }
+    find_maxtrade_id();
 
     // 5. Print stats
     time_t tstop = time(NULL);
@@ -71,45 +71,55 @@ int TradeOrderCnt;
 
 unsigned long lastTradeId = 0;
 
-//buffers for Egen data
-AccountPermissionBuffer accountPermissionBuffer (3015);
-CustomerBuffer customerBuffer (1005);
-CustomerAccountBuffer customerAccountBuffer (1005);
-CustomerTaxrateBuffer  customerTaxrateBuffer (2010);
-HoldingBuffer holdingBuffer(10000);
-HoldingHistoryBuffer holdingHistoryBuffer(2*loadUnit);
-HoldingSummaryBuffer holdingSummaryBuffer(6000);
-WatchItemBuffer watchItemBuffer (iMaxItemsInWL*1020+5000);
-WatchListBuffer watchListBuffer (1020);
-
-BrokerBuffer brokerBuffer(100);
-CashTransactionBuffer cashTransactionBuffer(loadUnit);
+//buffers for the fixed tables, which are loaded once
 ChargeBuffer chargeBuffer(20);
 CommissionRateBuffer commissionRateBuffer (245);
-SettlementBuffer settlementBuffer(loadUnit);
-TradeBuffer tradeBuffer(loadUnit);
-TradeHistoryBuffer tradeHistoryBuffer(3*loadUnit);
 TradeTypeBuffer tradeTypeBuffer (10);
-
-
-CompanyBuffer companyBuffer (1000);
-CompanyCompetitorBuffer companyCompetitorBuffer(3000);
-DailyMarketBuffer dailyMarketBuffer(3000);
 ExchangeBuffer exchangeBuffer(9);
-FinancialBuffer financialBuffer (1500);
 IndustryBuffer industryBuffer(107);
-LastTradeBuffer lastTradeBuffer (1005);
-NewsItemBuffer newsItemBuffer(200); 
-NewsXRefBuffer newsXRefBuffer(200);//big
 SectorBuffer sectorBuffer(17);
-SecurityBuffer securityBuffer(1005);
-
-
-AddressBuffer addressBuffer(1005);
 StatusTypeBuffer statusTypeBuffer (10);
 TaxrateBuffer taxrateBuffer (325);
 ZipCodeBuffer zipCodeBuffer (14850);
 
+//buffers for the rest, one set per loader
+EgenLoadPartition::EgenLoadPartition(TIdent first, TIdent count)
+    : generator(egen_partition_init(first, count)),
+      firstCustomer(first), customers(count),
+      accountPermissionBuffer (3015),
+      customerBuffer (1005),
+      customerAccountBuffer (1005),
+      customerTaxrateBuffer (2010),
+      holdingBuffer(10000),
+      holdingHistoryBuffer(2*loadUnit),
+      holdingSummaryBuffer(6000),
+      watchItemBuffer (iMaxItemsInWL*1020+5000),
+      watchListBuffer (1020),
+      brokerBuffer(100),
+      cashTransactionBuffer(loadUnit),
+      settlementBuffer(loadUnit),
+      tradeBuffer(loadUnit),
+      tradeHistoryBuffer(3*loadUnit),
+      companyBuffer (1000),
+      companyCompetitorBuffer(3000),
+      dailyMarketBuffer(3000),
+      financialBuffer (1500),
+      lastTradeBuffer (1005),
+      newsItemBuffer(200),
+      newsXRefBuffer(200),//big
+      securityBuffer(1005),
+      addressBuffer(1005)
+{
+}
+
+EgenLoadPartition::~EgenLoadPartition()
+{
+    delete generator;
+}
+
+// the partition the calling loader thread works on
+static __thread EgenLoadPartition* my_part;
+
 /******************************************************************** 
  *
  * Thread-local TPC-E TRXS Stats
@@ -163,6 +173,9 @@ void ShoreTPCEEnv::reset_stats()
     CRITICAL_SECTION(last_stats_cs, _last_stats_mutex);
     _last_stats = _get_stats();
     _num_invalid_input = 0;
+    TradeRequestBuffer->reset_lag();
+    TradeResultInputBuffer->reset_lag();
+    MarketFeedInputBuffer->reset_lag();
 }
 
 
@@ -209,6 +222,10 @@ void ShoreTPCEEnv::print_throughput(const double iQueriedSF,
 	   delay, mioch/delay, avgcpuusage, 100*avgcpuusage/64,
 	   (trxs_att-trxs_abt-trxs_dld)/delay,
 	   _num_invalid_input);
+
+    TradeRequestBuffer->print_lag("MEE TradeRequest");
+    TradeResultInputBuffer->print_lag("MEE TradeResult");
+    MarketFeedInputBuffer->print_lag("MEE MarketFeed");
 }
 
 /******************************************************************** 
@@ -234,56 +251,19 @@ void ShoreTPCEEnv::print_throughput(const double iQueriedSF,
 
 w_rc_t ShoreTPCEEnv::run_one_xct(Request* prequest)
 {
-    // check if there is ready transaction initiated by market 
-    if(prequest->type()==XCT_TPCE_MIX) {
-	double rand =  (1.0*(smthread_t::me()->rand()%10000))/100.0;
-	if (rand<0) rand*=-1.0;
-	prequest->set_type(random_xct_type(rand));
-    }
- 
-    switch (prequest->type()) {
-
-    case XCT_TPCE_BROKER_VOLUME:
-	return run_broker_volume(prequest);
-
-    case XCT_TPCE_CUSTOMER_POSITION:
-	return run_customer_position(prequest);
-
-    case XCT_TPCE_MARKET_FEED:
-	return run_market_feed(prequest);
-
-    case XCT_TPCE_MARKET_WATCH:
-	return run_market_watch(prequest);
-
-    case XCT_TPCE_SECURITY_DETAIL:
-	return run_security_detail(prequest);
-
-    case XCT_TPCE_TRADE_LOOKUP:
-	return run_trade_lookup(prequest);
-
-    case XCT_TPCE_TRADE_ORDER:
-	return run_trade_order(prequest);
-
-    case XCT_TPCE_TRADE_RESULT:
-	return run_trade_result(prequest);
-
-    case XCT_TPCE_TRADE_STATUS:
-	return run_trade_status(prequest);
-
-    case XCT_TPCE_TRADE_UPDATE:
-	return run_trade_update(prequest);
-
-    case XCT_TPCE_DATA_MAINTENANCE:
-	return run_data_maintenance(prequest);
+    prequest->set_type(pick_client_trx(prequest->type()));
+    return (_trxs.run(this, prequest));
+}
 
-    case XCT_TPCE_TRADE_CLEANUP:
-	return run_trade_cleanup(prequest);
 
-    default:
-	printf("************type %d**********\n ", prequest->type());
-	assert (0); // UNKNOWN TRX-ID
-    }
-    return (RCOK);
+// the trxs initiated by the market are submitted by the MEE
+// submitters when it is running, so the clients pick from the mix
+// without them
+int ShoreTPCEEnv::pick_client_trx(const int xct_type) const
+{
+    if (mee_driven() && (xct_type == XCT_TPCE_MIX))
+        return (_client_mix.pick());
+    return (pick_trx(xct_type));
 }
 
 
@@ -626,11 +606,11 @@ void ShoreTPCEEnv::_read_customer()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextCustomer();
-	PCUSTOMER_ROW record = pGenerateAndLoad->getCustomerRow();
-	customerBuffer.append(record);
-    } while((hasNext && customerBuffer.hasSpace()));
-    customerBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextCustomer();
+	PCUSTOMER_ROW record = my_part->generator->getCustomerRow();
+	my_part->customerBuffer.append(record);
+    } while((hasNext && my_part->customerBuffer.hasSpace()));
+    my_part->customerBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one CUSTOMER_TAXRATE
@@ -650,16 +630,16 @@ w_rc_t ShoreTPCEEnv::_load_one_customer_taxrate(rep_row_t& areprow,
 void ShoreTPCEEnv::_read_customer_taxrate()
 {
     bool hasNext;
-    int taxrates=pGenerateAndLoad->getTaxratesCount();
+    int taxrates=my_part->generator->getTaxratesCount();
     do {
-	hasNext= pGenerateAndLoad->hasNextCustomerTaxrate();
+	hasNext= my_part->generator->hasNextCustomerTaxrate();
 	for(int i=0; i<taxrates; i++) {
 	    PCUSTOMER_TAXRATE_ROW record =
-		pGenerateAndLoad->getCustomerTaxrateRow(i);
-	    customerTaxrateBuffer.append(record);
+		my_part->generator->getCustomerTaxrateRow(i);
+	    my_part->customerTaxrateBuffer.append(record);
 	}
-    } while((hasNext && customerTaxrateBuffer.hasSpace()));    
-    customerTaxrateBuffer.setMoreToRead(hasNext);
+    } while((hasNext && my_part->customerTaxrateBuffer.hasSpace()));    
+    my_part->customerTaxrateBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one CUSTOMER_ACCOUNT
@@ -701,17 +681,17 @@ void ShoreTPCEEnv::_read_ca_and_ap()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextCustomerAccount();
-	PCUSTOMER_ACCOUNT_ROW record = pGenerateAndLoad->getCustomerAccountRow();
-	customerAccountBuffer.append(record);
-	int perms = pGenerateAndLoad->PermissionsPerCustomer();
+	hasNext= my_part->generator->hasNextCustomerAccount();
+	PCUSTOMER_ACCOUNT_ROW record = my_part->generator->getCustomerAccountRow();
+	my_part->customerAccountBuffer.append(record);
+	int perms = my_part->generator->PermissionsPerCustomer();
 	for(int i=0; i<perms; i++) {
 	    PACCOUNT_PERMISSION_ROW row =
-		pGenerateAndLoad->getAccountPermissionRow(i);
-	    accountPermissionBuffer.append(row);
+		my_part->generator->getAccountPermissionRow(i);
+	    my_part->accountPermissionBuffer.append(row);
 	}
-    } while((hasNext && customerAccountBuffer.hasSpace()));
-    customerAccountBuffer.setMoreToRead(hasNext);
+    } while((hasNext && my_part->customerAccountBuffer.hasSpace()));
+    my_part->customerAccountBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one ADDRESS
@@ -734,11 +714,11 @@ void ShoreTPCEEnv::_read_address()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextAddress();
-	PADDRESS_ROW record = pGenerateAndLoad->getAddressRow();
-	addressBuffer.append(record);
-    } while((hasNext && addressBuffer.hasSpace()));
-    addressBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextAddress();
+	PADDRESS_ROW record = my_part->generator->getAddressRow();
+	my_part->addressBuffer.append(record);
+    } while((hasNext && my_part->addressBuffer.hasSpace()));
+    my_part->addressBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one WATCH_LIST
@@ -773,16 +753,16 @@ void ShoreTPCEEnv::_read_wl_and_wi()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextWatchList();
-	PWATCH_LIST_ROW record = pGenerateAndLoad->getWatchListRow();
-	watchListBuffer.append(record);
-	int items = pGenerateAndLoad->ItemsPerWatchList();
+	hasNext= my_part->generator->hasNextWatchList();
+	PWATCH_LIST_ROW record = my_part->generator->getWatchListRow();
+	my_part->watchListBuffer.append(record);
+	int items = my_part->generator->ItemsPerWatchList();
 	for(int i=0; i<items; ++i) {
-	    PWATCH_ITEM_ROW row = pGenerateAndLoad->getWatchItemRow(i);
-	    watchItemBuffer.append(row);
+	    PWATCH_ITEM_ROW row = my_part->generator->getWatchItemRow(i);
+	    my_part->watchItemBuffer.append(row);
 	}
-    } while(hasNext && watchListBuffer.hasSpace());
-    watchListBuffer.setMoreToRead(hasNext);
+    } while(hasNext && my_part->watchListBuffer.hasSpace());
+    my_part->watchListBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one COMPANY
@@ -809,11 +789,11 @@ void ShoreTPCEEnv::_read_company()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextCompany();
-	PCOMPANY_ROW record = pGenerateAndLoad->getCompanyRow();
-	companyBuffer.append(record);
-    } while((hasNext && companyBuffer.hasSpace()));
-    companyBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextCompany();
+	PCOMPANY_ROW record = my_part->generator->getCompanyRow();
+	my_part->companyBuffer.append(record);
+    } while((hasNext && my_part->companyBuffer.hasSpace()));
+    my_part->companyBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one COMPANY_COMPETITOR
@@ -835,12 +815,12 @@ void ShoreTPCEEnv::_read_company_competitor()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextCompanyCompetitor();
+	hasNext= my_part->generator->hasNextCompanyCompetitor();
 	PCOMPANY_COMPETITOR_ROW record =
-	    pGenerateAndLoad->getCompanyCompetitorRow();
-	companyCompetitorBuffer.append(record);
-    } while((hasNext && companyCompetitorBuffer.hasSpace()));
-    companyCompetitorBuffer.setMoreToRead(hasNext);
+	    my_part->generator->getCompanyCompetitorRow();
+	my_part->companyCompetitorBuffer.append(record);
+    } while((hasNext && my_part->companyCompetitorBuffer.hasSpace()));
+    my_part->companyCompetitorBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one DAILY_MARKET
@@ -865,11 +845,11 @@ void ShoreTPCEEnv::_read_daily_market()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextDailyMarket();
-	PDAILY_MARKET_ROW record = pGenerateAndLoad->getDailyMarketRow();
-	dailyMarketBuffer.append(record);
-    } while((hasNext && dailyMarketBuffer.hasSpace()));
-    dailyMarketBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextDailyMarket();
+	PDAILY_MARKET_ROW record = my_part->generator->getDailyMarketRow();
+	my_part->dailyMarketBuffer.append(record);
+    } while((hasNext && my_part->dailyMarketBuffer.hasSpace()));
+    my_part->dailyMarketBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one FINANCIAL
@@ -901,11 +881,11 @@ void ShoreTPCEEnv::_read_financial()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextFinancial();
-	PFINANCIAL_ROW record = pGenerateAndLoad->getFinancialRow();
-	financialBuffer.append(record);
-    } while((hasNext && financialBuffer.hasSpace()));
-    financialBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextFinancial();
+	PFINANCIAL_ROW record = my_part->generator->getFinancialRow();
+	my_part->financialBuffer.append(record);
+    } while((hasNext && my_part->financialBuffer.hasSpace()));
+    my_part->financialBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one LAST_TRADE
@@ -929,11 +909,11 @@ void ShoreTPCEEnv::_read_last_trade()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextLastTrade();
-	PLAST_TRADE_ROW record = pGenerateAndLoad->getLastTradeRow();
-	lastTradeBuffer.append(record);
-    } while((hasNext && lastTradeBuffer.hasSpace()));
-    lastTradeBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextLastTrade();
+	PLAST_TRADE_ROW record = my_part->generator->getLastTradeRow();
+	my_part->lastTradeBuffer.append(record);
+    } while((hasNext && my_part->lastTradeBuffer.hasSpace()));
+    my_part->lastTradeBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one NEWS_ITEM
@@ -973,14 +953,14 @@ void ShoreTPCEEnv::_read_ni_and_nx()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextNewsItemAndNewsXRef();
-	PNEWS_ITEM_ROW record1 = pGenerateAndLoad->getNewsItemRow();
-	PNEWS_XREF_ROW record2 = pGenerateAndLoad->getNewsXRefRow();
-	newsItemBuffer.append(record1);
-	newsXRefBuffer.append(record2);
-    } while((hasNext && newsItemBuffer.hasSpace()));
-    newsItemBuffer.setMoreToRead(hasNext);
-    newsXRefBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextNewsItemAndNewsXRef();
+	PNEWS_ITEM_ROW record1 = my_part->generator->getNewsItemRow();
+	PNEWS_XREF_ROW record2 = my_part->generator->getNewsXRefRow();
+	my_part->newsItemBuffer.append(record1);
+	my_part->newsXRefBuffer.append(record2);
+    } while((hasNext && my_part->newsItemBuffer.hasSpace()));
+    my_part->newsItemBuffer.setMoreToRead(hasNext);
+    my_part->newsXRefBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one SECURITY
@@ -1018,11 +998,11 @@ void ShoreTPCEEnv::_read_security()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextSecurity();
-	PSECURITY_ROW record = pGenerateAndLoad->getSecurityRow();
-	securityBuffer.append(record);
-    } while((hasNext && securityBuffer.hasSpace()));
-    securityBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextSecurity();
+	PSECURITY_ROW record = my_part->generator->getSecurityRow();
+	my_part->securityBuffer.append(record);
+    } while((hasNext && my_part->securityBuffer.hasSpace()));
+    my_part->securityBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one TRADE
@@ -1118,29 +1098,29 @@ void ShoreTPCEEnv::_read_trade_unit()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextTrade();
-	PTRADE_ROW row = pGenerateAndLoad->getTradeRow();
-	tradeBuffer.append(row);
-	int hist = pGenerateAndLoad->getTradeHistoryRowCount();
+	hasNext= my_part->generator->hasNextTrade();
+	PTRADE_ROW row = my_part->generator->getTradeRow();
+	my_part->tradeBuffer.append(row);
+	int hist = my_part->generator->getTradeHistoryRowCount();
 	for(int i=0; i<hist; i++) {
-	    PTRADE_HISTORY_ROW record = pGenerateAndLoad->getTradeHistoryRow(i);
-	    tradeHistoryBuffer.append(record);
+	    PTRADE_HISTORY_ROW record = my_part->generator->getTradeHistoryRow(i);
+	    my_part->tradeHistoryBuffer.append(record);
 	}
-	if(pGenerateAndLoad->shouldProcessSettlementRow()) {
-	    PSETTLEMENT_ROW record = pGenerateAndLoad->getSettlementRow();
-	    settlementBuffer.append(record);
+	if(my_part->generator->shouldProcessSettlementRow()) {
+	    PSETTLEMENT_ROW record = my_part->generator->getSettlementRow();
+	    my_part->settlementBuffer.append(record);
 	}
-	if(pGenerateAndLoad->shouldProcessCashTransactionRow()) {
-	    PCASH_TRANSACTION_ROW record=pGenerateAndLoad->getCashTransactionRow();
-	    cashTransactionBuffer.append(record);
+	if(my_part->generator->shouldProcessCashTransactionRow()) {
+	    PCASH_TRANSACTION_ROW record=my_part->generator->getCashTransactionRow();
+	    my_part->cashTransactionBuffer.append(record);
 	}
-	hist = pGenerateAndLoad->getHoldingHistoryRowCount();
+	hist = my_part->generator->getHoldingHistoryRowCount();
 	for(int i=0; i<hist; i++) {
-	    PHOLDING_HISTORY_ROW record=pGenerateAndLoad->getHoldingHistoryRow(i);
-	    holdingHistoryBuffer.append(record);
+	    PHOLDING_HISTORY_ROW record=my_part->generator->getHoldingHistoryRow(i);
+	    my_part->holdingHistoryBuffer.append(record);
 	}
-    } while((hasNext && tradeBuffer.hasSpace()));
-    tradeBuffer.setMoreToRead(hasNext);
+    } while((hasNext && my_part->tradeBuffer.hasSpace()));
+    my_part->tradeBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one BROKER
@@ -1163,11 +1143,11 @@ void ShoreTPCEEnv::_read_broker()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextBroker();
-	PBROKER_ROW record = pGenerateAndLoad->getBrokerRow();
-	brokerBuffer.append(record);
-    } while((hasNext && brokerBuffer.hasSpace()));
-    brokerBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextBroker();
+	PBROKER_ROW record = my_part->generator->getBrokerRow();
+	my_part->brokerBuffer.append(record);
+    } while((hasNext && my_part->brokerBuffer.hasSpace()));
+    my_part->brokerBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one HOLDING
@@ -1191,11 +1171,11 @@ void ShoreTPCEEnv::_read_holding()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextHolding();
-	PHOLDING_ROW record = pGenerateAndLoad->getHoldingRow();
-	holdingBuffer.append(record);
-    } while((hasNext && holdingBuffer.hasSpace()));
-    holdingBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextHolding();
+	PHOLDING_ROW record = my_part->generator->getHoldingRow();
+	my_part->holdingBuffer.append(record);
+    } while((hasNext && my_part->holdingBuffer.hasSpace()));
+    my_part->holdingBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one HOLDING_SUMMARY
@@ -1221,11 +1201,11 @@ void ShoreTPCEEnv::_read_holding_summary()
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextHoldingSummary();
-	PHOLDING_SUMMARY_ROW record = pGenerateAndLoad->getHoldingSummaryRow();
-	holdingSummaryBuffer.append(record);
-    } while((hasNext && holdingSummaryBuffer.hasSpace()));
-    holdingSummaryBuffer.setMoreToRead(hasNext);
+	hasNext= my_part->generator->hasNextHoldingSummary();
+	PHOLDING_SUMMARY_ROW record = my_part->generator->getHoldingSummaryRow();
+	my_part->holdingSummaryBuffer.append(record);
+    } while((hasNext && my_part->holdingSummaryBuffer.hasSpace()));
+    my_part->holdingSummaryBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one TRADE_REQUEST
@@ -1336,9 +1316,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_customer(const int xct_id,
     rep_row_t areprow(_pcustomer_man->ts());
     areprow.set(_pcustomer_desc->maxsize());
 
-    int rows=customerBuffer.getSize();
+    int rows=my_part->customerBuffer.getSize();
     for(int i=0; i<rows; i++) {
-	PCUSTOMER_ROW record = customerBuffer.get(i);
+	PCUSTOMER_ROW record = my_part->customerBuffer.get(i);
 	W_DO(_load_one_customer(areprow, record));
     }
 
@@ -1347,11 +1327,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_customer(const int xct_id,
 
 void ShoreTPCEEnv::populate_customer()
 {	
-    pGenerateAndLoad->InitCustomer();
+    my_part->generator->InitCustomer();
     TRACE( TRACE_ALWAYS, "Building CUSTOMER !!!\n");
-    while(customerBuffer.hasMoreToRead()){
+    while(my_part->customerBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	customerBuffer.reset();
+	my_part->customerBuffer.reset();
 	_read_customer();
 	populate_customer_input_t in;
     retry:
@@ -1359,8 +1339,8 @@ void ShoreTPCEEnv::populate_customer()
 	CHECK_XCT_RETURN(this->xct_populate_customer(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCustomer();
-    customerBuffer.release();
+    my_part->generator->ReleaseCustomer();
+    my_part->customerBuffer.release();
 }
 
 //address
@@ -1373,9 +1353,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_address(const int xct_id,
     rep_row_t areprow(_paddress_man->ts());
     areprow.set(_paddress_desc->maxsize());
 
-    int rows=addressBuffer.getSize();
+    int rows=my_part->addressBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PADDRESS_ROW record = addressBuffer.get(i);
+	PADDRESS_ROW record = my_part->addressBuffer.get(i);
 	W_DO(_load_one_address(areprow, record));
     }
 
@@ -1384,11 +1364,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_address(const int xct_id,
 
 void ShoreTPCEEnv::populate_address()
 {	
-    pGenerateAndLoad->InitAddress();
+    my_part->generator->InitAddress();
     TRACE( TRACE_ALWAYS, "Building ADDRESS !!!\n");
-    while(addressBuffer.hasMoreToRead()){
+    while(my_part->addressBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	addressBuffer.reset();
+	my_part->addressBuffer.reset();
 	_read_address();
 	populate_address_input_t in;
     retry:
@@ -1396,8 +1376,8 @@ void ShoreTPCEEnv::populate_address()
 	CHECK_XCT_RETURN(this->xct_populate_address(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseAddress();
-    addressBuffer.release();
+    my_part->generator->ReleaseAddress();
+    my_part->addressBuffer.release();
 }
 
 //CustomerAccount and AccountPermission
@@ -1410,14 +1390,14 @@ w_rc_t ShoreTPCEEnv::xct_populate_ca_and_ap(const int xct_id,
     rep_row_t areprow(_pcustomer_account_man->ts());
     areprow.set(_pcustomer_account_desc->maxsize());
 
-    int rows=customerAccountBuffer.getSize();
+    int rows=my_part->customerAccountBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCUSTOMER_ACCOUNT_ROW record = customerAccountBuffer.get(i);
+	PCUSTOMER_ACCOUNT_ROW record = my_part->customerAccountBuffer.get(i);
 	W_DO(_load_one_customer_account(areprow, record));
     }
-    rows=accountPermissionBuffer.getSize();
+    rows=my_part->accountPermissionBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PACCOUNT_PERMISSION_ROW record = accountPermissionBuffer.get(i);
+	PACCOUNT_PERMISSION_ROW record = my_part->accountPermissionBuffer.get(i);
 	W_DO(_load_one_account_permission(areprow, record));
     }
     
@@ -1426,12 +1406,12 @@ w_rc_t ShoreTPCEEnv::xct_populate_ca_and_ap(const int xct_id,
 
 void ShoreTPCEEnv::populate_ca_and_ap()
 {
-    pGenerateAndLoad->InitCustomerAccountAndAccountPermission();
+    my_part->generator->InitCustomerAccountAndAccountPermission();
     TRACE( TRACE_ALWAYS, "Building CustomerAccount and AccountPermission !!!\n");
-    while(customerAccountBuffer.hasMoreToRead()){
+    while(my_part->customerAccountBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	customerAccountBuffer.reset();
-	accountPermissionBuffer.reset();
+	my_part->customerAccountBuffer.reset();
+	my_part->accountPermissionBuffer.reset();
 	_read_ca_and_ap();
 	populate_ca_and_ap_input_t in;
     retry:
@@ -1439,9 +1419,9 @@ void ShoreTPCEEnv::populate_ca_and_ap()
 	CHECK_XCT_RETURN(this->xct_populate_ca_and_ap(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCustomerAccountAndAccountPermission();
-    customerAccountBuffer.release();
-    accountPermissionBuffer.release();
+    my_part->generator->ReleaseCustomerAccountAndAccountPermission();
+    my_part->customerAccountBuffer.release();
+    my_part->accountPermissionBuffer.release();
 }
 
 //Watch List and Watch Item
@@ -1454,14 +1434,14 @@ w_rc_t ShoreTPCEEnv::xct_populate_wl_and_wi(const int xct_id,
     rep_row_t areprow(_pwatch_item_man->ts());
     areprow.set(_pwatch_item_desc->maxsize());
 
-    int rows=watchListBuffer.getSize();
+    int rows=my_part->watchListBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PWATCH_LIST_ROW record = watchListBuffer.get(i);
+	PWATCH_LIST_ROW record = my_part->watchListBuffer.get(i);
 	W_DO(_load_one_watch_list(areprow, record));
     }
-    rows=watchItemBuffer.getSize();
+    rows=my_part->watchItemBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PWATCH_ITEM_ROW record = watchItemBuffer.get(i);
+	PWATCH_ITEM_ROW record = my_part->watchItemBuffer.get(i);
 	W_DO(_load_one_watch_item(areprow, record));
     }
 
@@ -1470,12 +1450,12 @@ w_rc_t ShoreTPCEEnv::xct_populate_wl_and_wi(const int xct_id,
 
 void ShoreTPCEEnv::populate_wl_and_wi()
 {	
-    pGenerateAndLoad->InitWatchListAndWatchItem();
+    my_part->generator->InitWatchListAndWatchItem();
     TRACE( TRACE_ALWAYS, "Building WATCH_LIST table and WATCH_ITEM !!!\n");
-    while(watchListBuffer.hasMoreToRead()){
+    while(my_part->watchListBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	watchItemBuffer.reset();
-	watchListBuffer.reset();
+	my_part->watchItemBuffer.reset();
+	my_part->watchListBuffer.reset();
 	_read_wl_and_wi();
 	populate_wl_and_wi_input_t in;
     retry:
@@ -1483,9 +1463,9 @@ void ShoreTPCEEnv::populate_wl_and_wi()
 	CHECK_XCT_RETURN(this->xct_populate_wl_and_wi(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseWatchListAndWatchItem();
-    watchItemBuffer.release();
-    watchListBuffer.release();
+    my_part->generator->ReleaseWatchListAndWatchItem();
+    my_part->watchItemBuffer.release();
+    my_part->watchListBuffer.release();
 }
 
 //CUSTOMER_TAXRATE
@@ -1498,9 +1478,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_customer_taxrate(const int xct_id,
     rep_row_t areprow(_pcustomer_taxrate_man->ts());
     areprow.set(_pcustomer_taxrate_desc->maxsize());
 
-    int rows=customerTaxrateBuffer.getSize();
+    int rows=my_part->customerTaxrateBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCUSTOMER_TAXRATE_ROW record = customerTaxrateBuffer.get(i);
+	PCUSTOMER_TAXRATE_ROW record = my_part->customerTaxrateBuffer.get(i);
 	W_DO(_load_one_customer_taxrate(areprow, record));
     }
 
@@ -1509,11 +1489,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_customer_taxrate(const int xct_id,
 
 void ShoreTPCEEnv::populate_customer_taxrate()
 {	
-    pGenerateAndLoad->InitCustomerTaxrate();
+    my_part->generator->InitCustomerTaxrate();
     TRACE( TRACE_ALWAYS, "Building CUSTOMER_TAXRATE !!!\n");
-    while(customerTaxrateBuffer.hasMoreToRead()){
+    while(my_part->customerTaxrateBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	customerTaxrateBuffer.reset();
+	my_part->customerTaxrateBuffer.reset();
 	_read_customer_taxrate();
 	populate_customer_taxrate_input_t in;
     retry:
@@ -1521,8 +1501,8 @@ void ShoreTPCEEnv::populate_customer_taxrate()
 	CHECK_XCT_RETURN(this->xct_populate_customer_taxrate(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCustomerTaxrate();
-    customerTaxrateBuffer.release();
+    my_part->generator->ReleaseCustomerTaxrate();
+    my_part->customerTaxrateBuffer.release();
 }
 
 //COMPANY
@@ -1535,9 +1515,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_company(const int xct_id,
     rep_row_t areprow(_pcompany_man->ts());
     areprow.set(_pcompany_desc->maxsize());
 
-    int rows=companyBuffer.getSize();
+    int rows=my_part->companyBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCOMPANY_ROW record = companyBuffer.get(i);
+	PCOMPANY_ROW record = my_part->companyBuffer.get(i);
 	W_DO(_load_one_company(areprow, record));
     }
 
@@ -1546,11 +1526,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_company(const int xct_id,
 
 void ShoreTPCEEnv::populate_company()
 {	
-    pGenerateAndLoad->InitCompany();
+    my_part->generator->InitCompany();
     TRACE( TRACE_ALWAYS, "Building COMPANY  !!!\n");
-    while(companyBuffer.hasMoreToRead()){
+    while(my_part->companyBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	companyBuffer.reset();
+	my_part->companyBuffer.reset();
 	_read_company();
 	populate_company_input_t in;
     retry:
@@ -1558,8 +1538,8 @@ void ShoreTPCEEnv::populate_company()
 	CHECK_XCT_RETURN(this->xct_populate_company(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCompany();
-    companyBuffer.release();
+    my_part->generator->ReleaseCompany();
+    my_part->companyBuffer.release();
 }
 
 //COMPANY COMPETITOR
@@ -1572,9 +1552,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_company_competitor(const int xct_id,
     rep_row_t areprow(_pcompany_competitor_man->ts());
     areprow.set(_pcompany_competitor_desc->maxsize());
 
-    int rows=companyCompetitorBuffer.getSize();
+    int rows=my_part->companyCompetitorBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCOMPANY_COMPETITOR_ROW record = companyCompetitorBuffer.get(i);
+	PCOMPANY_COMPETITOR_ROW record = my_part->companyCompetitorBuffer.get(i);
 	W_DO(_load_one_company_competitor(areprow, record));
     }
 
@@ -1583,11 +1563,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_company_competitor(const int xct_id,
 
 void ShoreTPCEEnv::populate_company_competitor()
 {	
-    pGenerateAndLoad->InitCompanyCompetitor();
+    my_part->generator->InitCompanyCompetitor();
     TRACE( TRACE_ALWAYS, "Building COMPANY COMPETITOR !!!\n");
-    while(companyCompetitorBuffer.hasMoreToRead()){
+    while(my_part->companyCompetitorBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	companyCompetitorBuffer.reset();
+	my_part->companyCompetitorBuffer.reset();
 	_read_company_competitor();
 	populate_company_competitor_input_t in;
     retry:
@@ -1595,8 +1575,8 @@ void ShoreTPCEEnv::populate_company_competitor()
 	CHECK_XCT_RETURN(this->xct_populate_company_competitor(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCompanyCompetitor();
-    companyCompetitorBuffer.release();
+    my_part->generator->ReleaseCompanyCompetitor();
+    my_part->companyCompetitorBuffer.release();
 }
 
 //COMPANY
@@ -1609,9 +1589,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_daily_market(const int xct_id,
     rep_row_t areprow(_pdaily_market_man->ts());
     areprow.set(_pdaily_market_desc->maxsize());
 
-    int rows=dailyMarketBuffer.getSize();
+    int rows=my_part->dailyMarketBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PDAILY_MARKET_ROW record = dailyMarketBuffer.get(i);
+	PDAILY_MARKET_ROW record = my_part->dailyMarketBuffer.get(i);
 	W_DO(_load_one_daily_market(areprow, record));
     }
 
@@ -1620,11 +1600,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_daily_market(const int xct_id,
 
 void ShoreTPCEEnv::populate_daily_market()
 {	
-    pGenerateAndLoad->InitDailyMarket();
+    my_part->generator->InitDailyMarket();
     TRACE( TRACE_ALWAYS, "DAILY_MARKET   !!!\n");
-    while(dailyMarketBuffer.hasMoreToRead()){
+    while(my_part->dailyMarketBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	dailyMarketBuffer.reset();
+	my_part->dailyMarketBuffer.reset();
 	_read_daily_market();
 	populate_daily_market_input_t in;
     retry:
@@ -1632,8 +1612,8 @@ void ShoreTPCEEnv::populate_daily_market()
 	CHECK_XCT_RETURN(this->xct_populate_daily_market(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseDailyMarket();
-    dailyMarketBuffer.release();
+    my_part->generator->ReleaseDailyMarket();
+    my_part->dailyMarketBuffer.release();
 }
 
 //FINANCIAL
@@ -1646,9 +1626,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_financial(const int xct_id,
     rep_row_t areprow(_pfinancial_man->ts());
     areprow.set(_pfinancial_desc->maxsize());
 
-    int rows=financialBuffer.getSize();
+    int rows=my_part->financialBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PFINANCIAL_ROW record = financialBuffer.get(i);
+	PFINANCIAL_ROW record = my_part->financialBuffer.get(i);
 	W_DO(_load_one_financial(areprow, record));
     }
 
@@ -1657,11 +1637,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_financial(const int xct_id,
 
 void ShoreTPCEEnv::populate_financial()
 {	
-    pGenerateAndLoad->InitFinancial();
+    my_part->generator->InitFinancial();
     TRACE( TRACE_ALWAYS, "Building FINANCIAL  !!!\n");
-    while(financialBuffer.hasMoreToRead()){
+    while(my_part->financialBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	financialBuffer.reset();
+	my_part->financialBuffer.reset();
 	_read_financial();
 	populate_financial_input_t in;
     retry:
@@ -1669,8 +1649,8 @@ void ShoreTPCEEnv::populate_financial()
 	CHECK_XCT_RETURN(this->xct_populate_financial(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseFinancial();
-    financialBuffer.release();
+    my_part->generator->ReleaseFinancial();
+    my_part->financialBuffer.release();
 }
 
 //SECURITY
@@ -1683,9 +1663,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_security(const int xct_id,
     rep_row_t areprow(_psecurity_man->ts());
     areprow.set(_psecurity_desc->maxsize());
 
-    int rows=securityBuffer.getSize();
+    int rows=my_part->securityBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PSECURITY_ROW record = securityBuffer.get(i);
+	PSECURITY_ROW record = my_part->securityBuffer.get(i);
 	W_DO(_load_one_security(areprow, record));
     }
 
@@ -1694,11 +1674,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_security(const int xct_id,
 
 void ShoreTPCEEnv::populate_security()
 {	
-    pGenerateAndLoad->InitSecurity();
+    my_part->generator->InitSecurity();
     TRACE( TRACE_ALWAYS, "Building SECURITY  !!!\n");
-    while(securityBuffer.hasMoreToRead()){
+    while(my_part->securityBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	securityBuffer.reset();
+	my_part->securityBuffer.reset();
 	_read_security();
 	populate_security_input_t in;
     retry:
@@ -1706,8 +1686,8 @@ void ShoreTPCEEnv::populate_security()
 	CHECK_XCT_RETURN(this->xct_populate_security(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseSecurity();
-    securityBuffer.release();
+    my_part->generator->ReleaseSecurity();
+    my_part->securityBuffer.release();
 }
 
 //LAST_TRADE
@@ -1720,9 +1700,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_last_trade(const int xct_id,
     rep_row_t areprow(_plast_trade_man->ts());
     areprow.set(_plast_trade_desc->maxsize());
 
-    int rows=lastTradeBuffer.getSize();
+    int rows=my_part->lastTradeBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PLAST_TRADE_ROW record = lastTradeBuffer.get(i);
+	PLAST_TRADE_ROW record = my_part->lastTradeBuffer.get(i);
 	W_DO(_load_one_last_trade(areprow, record));
     }
 
@@ -1731,11 +1711,11 @@ w_rc_t ShoreTPCEEnv::xct_populate_last_trade(const int xct_id,
 
 void ShoreTPCEEnv::populate_last_trade()
 {	
-    pGenerateAndLoad->InitLastTrade();
+    my_part->generator->InitLastTrade();
     TRACE( TRACE_ALWAYS, "Building LAST_TRADE  !!!\n");
-    while(lastTradeBuffer.hasMoreToRead()){
+    while(my_part->lastTradeBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	lastTradeBuffer.reset();
+	my_part->lastTradeBuffer.reset();
 	_read_last_trade();
 	populate_last_trade_input_t in;
     retry:
@@ -1743,8 +1723,8 @@ void ShoreTPCEEnv::populate_last_trade()
 	CHECK_XCT_RETURN(this->xct_populate_last_trade(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseLastTrade();
-    lastTradeBuffer.release();
+    my_part->generator->ReleaseLastTrade();
+    my_part->lastTradeBuffer.release();
 }
 
 //Watch List and Watch Item
@@ -1757,14 +1737,14 @@ w_rc_t ShoreTPCEEnv::xct_populate_ni_and_nx(const int xct_id,
     rep_row_t areprow(_pnews_item_man->ts());
     areprow.set(_pnews_item_desc->maxsize());
 
-    int rows=newsXRefBuffer.getSize();
+    int rows=my_part->newsXRefBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PNEWS_XREF_ROW record = newsXRefBuffer.get(i);
+	PNEWS_XREF_ROW record = my_part->newsXRefBuffer.get(i);
 	W_DO(_load_one_news_xref(areprow, record));
     }
-    rows=newsItemBuffer.getSize();
+    rows=my_part->newsItemBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PNEWS_ITEM_ROW record = newsItemBuffer.get(i);
+	PNEWS_ITEM_ROW record = my_part->newsItemBuffer.get(i);
 	W_DO(_load_one_news_item(areprow, record));
     }
 
@@ -1773,12 +1753,12 @@ w_rc_t ShoreTPCEEnv::xct_populate_ni_and_nx(const int xct_id,
 
 void ShoreTPCEEnv::populate_ni_and_nx()
 {	
-    pGenerateAndLoad->InitNewsItemAndNewsXRef();
+    my_part->generator->InitNewsItemAndNewsXRef();
     TRACE( TRACE_ALWAYS, "Building NEWS_ITEM and NEWS_XREF !!!\n");
-    while(newsItemBuffer.hasMoreToRead()){
+    while(my_part->newsItemBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	newsItemBuffer.reset();
-	newsXRefBuffer.reset();
+	my_part->newsItemBuffer.reset();
+	my_part->newsXRefBuffer.reset();
 	_read_ni_and_nx();
 	populate_ni_and_nx_input_t in;
     retry:
@@ -1786,9 +1766,9 @@ void ShoreTPCEEnv::populate_ni_and_nx()
 	CHECK_XCT_RETURN(this->xct_populate_ni_and_nx(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseNewsItemAndNewsXRef();
-    newsItemBuffer.release();
-    newsXRefBuffer.release();
+    my_part->generator->ReleaseNewsItemAndNewsXRef();
+    my_part->newsItemBuffer.release();
+    my_part->newsXRefBuffer.release();
 }
 
 //populating growing tables
@@ -1801,29 +1781,29 @@ w_rc_t ShoreTPCEEnv::xct_populate_unit_trade(const int xct_id,
     rep_row_t areprow(_pnews_item_man->ts());
     areprow.set(_pnews_item_desc->maxsize());
 
-    int rows=tradeBuffer.getSize();
+    int rows=my_part->tradeBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PTRADE_ROW record = tradeBuffer.get(i);
+	PTRADE_ROW record = my_part->tradeBuffer.get(i);
 	W_DO(_load_one_trade(areprow, record));
     }
-    rows=tradeHistoryBuffer.getSize();
+    rows=my_part->tradeHistoryBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PTRADE_HISTORY_ROW record = tradeHistoryBuffer.get(i);
+	PTRADE_HISTORY_ROW record = my_part->tradeHistoryBuffer.get(i);
 	W_DO(_load_one_trade_history(areprow, record));
     }
-    rows=settlementBuffer.getSize();
+    rows=my_part->settlementBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PSETTLEMENT_ROW record = settlementBuffer.get(i);
+	PSETTLEMENT_ROW record = my_part->settlementBuffer.get(i);
 	W_DO(_load_one_settlement(areprow, record));
     }
-    rows=cashTransactionBuffer.getSize();
+    rows=my_part->cashTransactionBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCASH_TRANSACTION_ROW record = cashTransactionBuffer.get(i);
+	PCASH_TRANSACTION_ROW record = my_part->cashTransactionBuffer.get(i);
 	W_DO(_load_one_cash_transaction(areprow, record));
     }
-    rows=holdingHistoryBuffer.getSize();
+    rows=my_part->holdingHistoryBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PHOLDING_HISTORY_ROW record = holdingHistoryBuffer.get(i);
+	PHOLDING_HISTORY_ROW record = my_part->holdingHistoryBuffer.get(i);
 	W_DO(_load_one_holding_history(areprow, record));
     }
 
@@ -1840,9 +1820,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_broker(const int xct_id,
     rep_row_t areprow(_pbroker_man->ts());
     areprow.set(_pbroker_desc->maxsize());
 
-    int rows=brokerBuffer.getSize();
+    int rows=my_part->brokerBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PBROKER_ROW record = brokerBuffer.get(i);
+	PBROKER_ROW record = my_part->brokerBuffer.get(i);
 	W_DO(_load_one_broker(areprow, record));
     }
 
@@ -1851,9 +1831,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_broker(const int xct_id,
 
 void ShoreTPCEEnv::populate_broker()
 {	
-    while(brokerBuffer.hasMoreToRead()) {
+    while(my_part->brokerBuffer.hasMoreToRead()) {
 	long log_space_needed = 0;
-	brokerBuffer.reset();
+	my_part->brokerBuffer.reset();
 	_read_broker();
 	populate_broker_input_t in;
     retry:
@@ -1873,9 +1853,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_holding_summary(const int xct_id,
     rep_row_t areprow(_pholding_summary_man->ts());
     areprow.set(_pholding_summary_desc->maxsize());
 
-    int rows=holdingSummaryBuffer.getSize();
+    int rows=my_part->holdingSummaryBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PHOLDING_SUMMARY_ROW record = holdingSummaryBuffer.get(i);
+	PHOLDING_SUMMARY_ROW record = my_part->holdingSummaryBuffer.get(i);
 	W_DO(_load_one_holding_summary(areprow, record));
     }
 
@@ -1884,9 +1864,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_holding_summary(const int xct_id,
 
 void ShoreTPCEEnv::populate_holding_summary()
 {	
-    while(holdingSummaryBuffer.hasMoreToRead()){
+    while(my_part->holdingSummaryBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	holdingSummaryBuffer.reset();
+	my_part->holdingSummaryBuffer.reset();
 	_read_holding_summary();
 	populate_holding_summary_input_t in;
     retry:
@@ -1906,9 +1886,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_holding(const int xct_id,
     rep_row_t areprow(_pholding_man->ts());
     areprow.set(_pholding_desc->maxsize());
 
-    int rows=holdingBuffer.getSize();
+    int rows=my_part->holdingBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PHOLDING_ROW record = holdingBuffer.get(i);
+	PHOLDING_ROW record = my_part->holdingBuffer.get(i);
 	W_DO(_load_one_holding(areprow, record));
     }
 
@@ -1917,9 +1897,9 @@ w_rc_t ShoreTPCEEnv::xct_populate_holding(const int xct_id,
 
 void ShoreTPCEEnv::populate_holding()
 {	
-    while(holdingBuffer.hasMoreToRead()){
+    while(my_part->holdingBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	holdingBuffer.reset();
+	my_part->holdingBuffer.reset();
 	_read_holding();
 	populate_holding_input_t in;
     retry:
@@ -1931,13 +1911,13 @@ void ShoreTPCEEnv::populate_holding()
 
 void ShoreTPCEEnv::populate_unit_trade()
 {
-     while(tradeBuffer.hasMoreToRead()){
+     while(my_part->tradeBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	tradeBuffer.reset();
-	tradeHistoryBuffer.reset();
-	settlementBuffer.reset();
-	cashTransactionBuffer.reset();
-	holdingHistoryBuffer.reset();
+	my_part->tradeBuffer.reset();
+	my_part->tradeHistoryBuffer.reset();
+	my_part->settlementBuffer.reset();
+	my_part->cashTransactionBuffer.reset();
+	my_part->holdingHistoryBuffer.reset();
 	_read_trade_unit();
 	printf("\n\n Populating trade unit\n\n" );
 	populate_unit_trade_input_t in;
@@ -1950,7 +1930,7 @@ void ShoreTPCEEnv::populate_unit_trade()
 
 void ShoreTPCEEnv::populate_growing()
 {	
-    pGenerateAndLoad->InitHoldingAndTrade();
+    my_part->generator->InitHoldingAndTrade();
     TRACE( TRACE_ALWAYS, "Building growing tables  !!!\n");
     int cnt =0;
     do {
@@ -1959,24 +1939,52 @@ void ShoreTPCEEnv::populate_growing()
 	populate_holding_summary();
 	populate_holding();
 	printf("\nload unit %d\n",++cnt);
-	tradeBuffer.newLoadUnit();
-	tradeHistoryBuffer.newLoadUnit();
-	settlementBuffer.newLoadUnit();
-	cashTransactionBuffer.newLoadUnit();
-	holdingHistoryBuffer.newLoadUnit();
-	brokerBuffer.newLoadUnit();
-	holdingSummaryBuffer.newLoadUnit();
-	holdingBuffer.newLoadUnit();	
-    } while(pGenerateAndLoad->hasNextLoadUnit());
-    pGenerateAndLoad->ReleaseHoldingAndTrade();
-    tradeBuffer.release();
-    tradeHistoryBuffer.release();
-    settlementBuffer.release();
-    cashTransactionBuffer.release();
-    holdingHistoryBuffer.release();
-    brokerBuffer.release();
-    holdingSummaryBuffer.release();
-    holdingBuffer.release();
+	my_part->tradeBuffer.newLoadUnit();
+	my_part->tradeHistoryBuffer.newLoadUnit();
+	my_part->settlementBuffer.newLoadUnit();
+	my_part->cashTransactionBuffer.newLoadUnit();
+	my_part->holdingHistoryBuffer.newLoadUnit();
+	my_part->brokerBuffer.newLoadUnit();
+	my_part->holdingSummaryBuffer.newLoadUnit();
+	my_part->holdingBuffer.newLoadUnit();	
+    } while(my_part->generator->hasNextLoadUnit());
+    my_part->generator->ReleaseHoldingAndTrade();
+    my_part->tradeBuffer.release();
+    my_part->tradeHistoryBuffer.release();
+    my_part->settlementBuffer.release();
+    my_part->cashTransactionBuffer.release();
+    my_part->holdingHistoryBuffer.release();
+    my_part->brokerBuffer.release();
+    my_part->holdingSummaryBuffer.release();
+    my_part->holdingBuffer.release();
+}
+
+// Loads the scaling and growing tables for the customers of (part).
+// Loaders with disjoint partitions may run at the same time.
+void ShoreTPCEEnv::populate_partition(EgenLoadPartition* part)
+{
+    my_part = part;
+    TRACE( TRACE_ALWAYS, "Loading customers %lld..%lld\n",
+	   part->firstCustomer, part->firstCustomer + part->customers - 1);
+
+    //populating scaling tables
+    populate_address(); 
+    populate_customer();
+    populate_ca_and_ap();
+    populate_customer_taxrate();
+    populate_wl_and_wi(); 
+
+    populate_company(); 
+    populate_company_competitor();
+    populate_daily_market();
+    populate_financial();
+    populate_last_trade();
+    populate_ni_and_nx();
+    populate_security();
+
+    //populate growing tables
+    populate_growing();
+    my_part = NULL;
 }
 
 w_rc_t ShoreTPCEEnv::xct_find_maxtrade_id(const int xct_id,
@@ -767,19 +767,21 @@ w_rc_t ShoreTPCEEnv::xct_trade_order(const int xct_id, trade_order_input_t& ptoi
     
     //BEGIN FRAME6
     //send TradeRequest to Market
-    PTradeRequest req = new TTradeRequest();
-    req->trade_id = trade_id;
-    req->trade_qty = ptoin._trade_qty;
-    strcpy(req->symbol, symbol);
-    strcpy(req->trade_type_id, ptoin._trade_type_id);
-    req->price_quote = requested_price;
+    //it is queued for the MEE driver thread, which submits it to the MEE
+    TTradeRequest req;
+    req.trade_id = trade_id;
+    req.trade_qty = ptoin._trade_qty;
+    strcpy(req.symbol, symbol);
+    strcpy(req.trade_type_id, ptoin._trade_type_id);
+    req.price_quote = requested_price;
     if(type_is_market) {
-	req->eAction=eMEEProcessOrder;
+	req.eAction=eMEEProcessOrder;
     } else {
-	req->eAction=eMEESetLimitOrderTrigger;
+	req.eAction=eMEESetLimitOrderTrigger;
+    }
+    if(!TradeRequestBuffer->put(req)) {
+	TRACE( TRACE_ALWAYS, "App: %d TO: MEE request queue full, trade (%lld) dropped\n", xct_id, (long long)trade_id);
     }
-    mee->SubmitTradeRequest(req);
-    delete req;
     // END FRAME6
     
 #ifdef PRINT_TRX_RESULTS
@@ -268,13 +268,13 @@ void trade_lookup_input_t::print()
 trade_result_input_t      create_trade_result_input(int sf, int specificIdx) 
 { 
     trade_result_input_t atri;
-    TTradeResultTxnInput* input = TradeResultInputBuffer->get();
-    if(input==NULL) {   
+    TTradeResultTxnInput input;
+    if(!TradeResultInputBuffer->get(input)) {   
 	atri._trade_id=-1;
 	atri._trade_price=-1;
     } else {
-	atri._trade_id=input->trade_id;
-	atri._trade_price=input->trade_price;
+	atri._trade_id=input.trade_id;
+	atri._trade_price=input.trade_price;
     }
     return (atri);
 };
@@ -405,18 +405,17 @@ void trade_update_input_t::print()
 market_feed_input_t create_market_feed_input(int sf, int specificIdx) 
 { 
     market_feed_input_t amfi;
-    TMarketFeedTxnInput* input= MarketFeedInputBuffer->get();    
-    if(input!=NULL) {
-	memcpy(amfi._status_submitted,input->StatusAndTradeType.status_submitted,5);
-	memcpy(amfi._type_limit_buy,input->StatusAndTradeType.type_limit_buy,4);
-	memcpy(amfi._type_limit_sell,input->StatusAndTradeType.type_limit_sell,4);
-	memcpy(amfi._type_stop_loss,input->StatusAndTradeType.type_stop_loss,4);
+    TMarketFeedTxnInput input;
+    if(MarketFeedInputBuffer->get(input)) {
+	memcpy(amfi._status_submitted,input.StatusAndTradeType.status_submitted,5);
+	memcpy(amfi._type_limit_buy,input.StatusAndTradeType.type_limit_buy,4);
+	memcpy(amfi._type_limit_sell,input.StatusAndTradeType.type_limit_sell,4);
+	memcpy(amfi._type_stop_loss,input.StatusAndTradeType.type_stop_loss,4);
 	for(int i=0; i<max_feed_len; i++) {
-	    amfi._trade_qty[i] = input->Entries[i].trade_qty;
-	    memcpy(amfi._symbol[i], input->Entries[i].symbol, 16);
-	    amfi._price_quote[i] = input->Entries[i].price_quote;
+	    amfi._trade_qty[i] = input.Entries[i].trade_qty;
+	    memcpy(amfi._symbol[i], input.Entries[i].symbol, 16);
+	    amfi._price_quote[i] = input.Entries[i].price_quote;
 	}
-	delete input;
     }
     return (amfi);
 }
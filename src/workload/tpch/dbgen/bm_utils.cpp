@@ -95,7 +95,7 @@ static char alpha_num[65] =
 char     *getenv PROTO((const char *name));
 void usage();
 long *permute_dist(distribution *d, long stream, DSS_HUGE& source, distribution* cd);
-extern seed_t Seed[];
+extern __thread seed_t Seed[];
 
 /*
  * env_config: look for a environmental variable setting and return its
@@ -105,7 +105,7 @@ double flt_scale;
 char *spawn_args[25];
 #endif
 #ifdef RNG_TEST
-extern seed_t Seed[];
+extern __thread seed_t Seed[];
 #endif
 
 
@@ -586,5 +586,28 @@ int dbgen_init ()
 }
 
 
+/*
+ * dbgen_scale() -- size the population for scale factor sf, as the -s
+ * option of dbgen does: whole scale factors multiply the row counts of
+ * the scaled tables, smaller ones shrink their base row counts.
+ */
+void dbgen_scale(double sf)
+{
+  flt_scale = sf;
+  if (flt_scale < MIN_SCALE) {
+    int int_scale = (int)(1000 * flt_scale);
+    scale = 1;
+    for (int i = PART; i < NATION; i++) {
+      tdefs[i].base = (DSS_HUGE)(int_scale * tdefs[i].base)/1000;
+      if (tdefs[i].base < 1)
+        tdefs[i].base = 1;
+    }
+  }
+  else {
+    scale = (long)flt_scale;
+  }
+}
+
+
 EXIT_NAMESPACE(dbgentpch);
 
@@ -63,7 +63,7 @@ long *permute(long *set, int cnt, long stream, DSS_HUGE& source, long* cs);
 long *permute_dist(distribution *d, long stream, DSS_HUGE& source, distribution* cd);
 long seed;
 const char *eol[2] = {" ", "},"};
-extern seed_t Seed[];
+extern __thread seed_t Seed[];
 #ifdef TEST
 tdef tdefs = { NULL };
 #endif
@@ -109,15 +109,19 @@ permute(long *a, int c, long s, DSS_HUGE& source, long* cset)
 
 long *
 permute_dist(distribution *d, long stream, 
-             DSS_HUGE& source, distribution* cd)
+             DSS_HUGE& source, distribution* /* cd */)
 {
   static bool bInit = false;
   static distribution *dist = NULL;
+
+  // The permutation is kept per thread, so that parallel loaders do
+  // not shuffle each other's part names
+  static __thread long *perm = NULL;
 	
   if (d != NULL) {
-    if (d->permute == (long *)NULL) {
-      d->permute = (long *)malloc(sizeof(long) * DIST_SIZE(d));
-      MALLOC_CHECK(d->permute);
+    if (perm == (long *)NULL) {
+      perm = (long *)malloc(sizeof(long) * DIST_SIZE(d));
+      MALLOC_CHECK(perm);
       //IP: permute does the same 
       //for (int i=0; i < DIST_SIZE(d); i++) {
       //   *(d->permute + i) = i;
@@ -134,12 +138,11 @@ permute_dist(distribution *d, long stream,
     //     This assertion ensures that 'dist' will have a single 
     //     value.    
     assert (dist == d);
-    return (permute(dist->permute, DIST_SIZE(dist), stream, 
-                    source, cd->permute));
+    return (permute(perm, DIST_SIZE(dist), stream, source, perm));
   }
 		
   if (dist != NULL) {
-    return (permute(NULL, DIST_SIZE(dist), stream, source, cd->permute));
+    return (permute(NULL, DIST_SIZE(dist), stream, source, perm));
   }
   else {
     INTERNAL_ERROR("Bad call to permute_dist");	
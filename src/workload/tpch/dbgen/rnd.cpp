@@ -152,6 +152,39 @@ row_stop(int t)	\
   return;
 }
 
+/*
+ * row_seek() -- position the streams of table t, and of its child, as
+ * if the rows before row n (numbered from 1, as in gen_tbl) had been
+ * generated by this thread. The streams are reset to their initial
+ * seeds and skipped with the seed functions of the table, the way
+ * set_state() positions a child of a parallel dbgen.
+ */
+void
+row_seek(int t, DSS_HUGE n)
+{
+  int i;
+  int m = t;
+
+  if (m == ORDER_LINE)
+    m = ORDER;
+  if (m == PART_PSUPP)
+    m = PART;
+
+  for (i=0; i <= MAX_STREAM; i++)
+    if ((Seed[i].table == m) || 
+        ((tdefs[m].child != NONE) && (Seed[i].table == tdefs[m].child)))
+      Seed[i] = InitialSeed[i];
+
+  if (n <= 1)
+    return;
+
+  tdefs[t].gen_seed((t == LINE) ? 1 : 0, n - 1);
+  if (tdefs[t].child != NONE)
+    tdefs[tdefs[t].child].gen_seed(0, n - 1);
+
+  return;
+}
+
 void
 dump_seeds(int tbl)
 {
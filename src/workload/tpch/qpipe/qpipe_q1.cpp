@@ -82,7 +82,8 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _shipdate;
+	date_t _shipdate;
+	date_t _last_shipdate;
 
 	/* Random Predicates */
 	/* TPC-H Specification 2.3.0 */
@@ -106,6 +107,7 @@ public:
 	   L_SHIPDATE <= 1998-12-01 - DELTA DAYS
 		 */
 		q1_input=&in;
+		_last_shipdate = timet_to_date(q1_input->l_shipdate);
 
 		char date[15];
 		timet_to_str(date,q1_input->l_shipdate);
@@ -128,11 +130,11 @@ public:
 		}
 
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
+		_shipdate = _lineitem.L_SHIPDATE;
 
 		// Return true if it passes the filter
-		if  ( _shipdate <= q1_input->l_shipdate ) {
+		if  ( _shipdate <= _last_shipdate ) {
 			//TRACE(TRACE_RECORD_FLOW, "+ %s\n", _lineitem.L_SHIPDATE);
 			return (true);
 		}
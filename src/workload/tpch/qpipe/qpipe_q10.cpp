@@ -204,10 +204,10 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
+	date_t _orderdate;
 
-	time_t _first_orderdate;
-	time_t _last_orderdate;
+	date_t _first_orderdate;
+	date_t _last_orderdate;
 
 public:
 	q10_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q10_input_t &in)
@@ -218,15 +218,16 @@ public:
 				_tpchdb->orders_desc()->maxsize());
 		_prorders->_rep = &_rr;
 
-		_first_orderdate = (&in)->o_orderdate;
-		struct tm *tm = gmtime(&_first_orderdate);
+		time_t first_orderdate = (&in)->o_orderdate;
+		struct tm *tm = gmtime(&first_orderdate);
 		tm->tm_mon += 3;
-		_last_orderdate = mktime(tm);
+		_first_orderdate = timet_to_date(first_orderdate);
+		_last_orderdate = timet_to_date(mktime(tm));
 
 		char f_orderdate[STRSIZE(10)];
 		char l_orderdate[STRSIZE(10)];
-		timet_to_str(f_orderdate, _first_orderdate);
-		timet_to_str(l_orderdate, _last_orderdate);
+		date_to_str(f_orderdate, _first_orderdate);
+		date_to_str(l_orderdate, _last_orderdate);
 
 		TRACE(TRACE_ALWAYS, "Random predicate:\nO_ORDERDATE between [%s, %s[\n", f_orderdate, l_orderdate);
 	}
@@ -243,8 +244,8 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
+		_orderdate = _orders.O_ORDERDATE;
 
 		return _orderdate >= _first_orderdate && _orderdate < _last_orderdate;
 	}
@@ -269,8 +270,8 @@ public:
 	c_str to_string() const {
 		char f_orderdate[STRSIZE(10)];
 		char l_orderdate[STRSIZE(10)];
-		timet_to_str(f_orderdate, _first_orderdate);
-		timet_to_str(l_orderdate, _last_orderdate);
+		date_to_str(f_orderdate, _first_orderdate);
+		date_to_str(l_orderdate, _last_orderdate);
 		return c_str("q10_orders_tscan_filter_t(O_ORDERDATE between [%s, %s[)", f_orderdate, l_orderdate);
 	}
 };
@@ -513,29 +514,6 @@ struct q10_final_join_t : public tuple_join_t {
 	}
 };
 
-struct q10_top20_filter_t : public tuple_filter_t
-{
-	int _count;
-
-	q10_top20_filter_t()
-	: tuple_filter_t(sizeof(q10_final_tuple)), _count(0)
-	{
-	}
-
-	bool select(const tuple_t &input) {
-		return ++_count <= 20;
-	}
-
-	virtual q10_top20_filter_t* clone() const {
-		return new q10_top20_filter_t(*this);
-	}
-
-	virtual c_str to_string() const {
-		return c_str("q10_top20_filter_t");
-	}
-};
-
-
 struct q10_aggregate_t : public tuple_aggregate_t {
 
 	default_key_extractor_t _extractor;
@@ -719,14 +697,15 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q10(const int xct_id,
 					new default_key_extractor_t(sizeof(int), offsetof(q10_final_tuple, C_CUSTKEY)),
 					new int_key_compare_t());
 
-	//SORT
+	//ORDER BY REVENUE DESC LIMIT 20
 	tuple_fifo* q10_sort_buffer = new tuple_fifo(sizeof(q10_final_tuple));
 	packet_t* q10_sort_packet =
-			new sort_packet_t("SORT",
+			new topn_packet_t("TOP 20",
 					q10_sort_buffer,
-					new q10_top20_filter_t(),
+					new trivial_filter_t(sizeof(q10_final_tuple)),
 					new q10_sort_key_extractor_t(),
 					new q10_sort_key_compare_t(),
+					20,
 					q10_agg_packet);
 
 
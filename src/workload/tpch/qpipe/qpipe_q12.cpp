@@ -114,9 +114,9 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _commitdate;
-	time_t _receiptdate;
-	time_t _shipdate;
+	date_t _commitdate;
+	date_t _receiptdate;
+	date_t _shipdate;
 	int _shipmode;
 
 	/* Random Predicates */
@@ -126,7 +126,8 @@ private:
 	 * SHIPMODE2 random within [0, 6] and different than SHIPMODE1
 	 */
 	q12_input_t* q12_input;
-	time_t _last_l_receiptdate;
+	date_t _first_l_receiptdate;
+	date_t _last_l_receiptdate;
 public:
 
 	q12_lineitem_tscan_filter_t(ShoreTPCHEnv* tpchdb, q12_input_t &in)
@@ -146,7 +147,9 @@ public:
 		struct tm date;
 		gmtime_r(&(q12_input->l_receiptdate), &date);
 		date.tm_year ++;
-		_last_l_receiptdate=mktime(&date);
+		time_t last_receiptdate=mktime(&date);
+		_first_l_receiptdate=timet_to_date(q12_input->l_receiptdate);
+		_last_l_receiptdate=timet_to_date(last_receiptdate);
 
 		char shipmode1[11];
 		char shipmode2[11];
@@ -156,7 +159,7 @@ public:
 		shipmode_to_str(shipmode1, (tpch_l_shipmode)(q12_input->l_shipmode1));
 		shipmode_to_str(shipmode2, (tpch_l_shipmode)(q12_input->l_shipmode2));
 		timet_to_str(fshipdate, q12_input->l_receiptdate);
-		timet_to_str(lshipdate, _last_l_receiptdate);
+		timet_to_str(lshipdate, last_receiptdate);
 
 		TRACE(TRACE_ALWAYS, "Random Predicates:\nL_SHIPMODE in (%s, %s); %s <= L_RECEIPTDATE < %s\n", shipmode1, shipmode2, fshipdate, lshipdate);
 	}
@@ -176,19 +179,19 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
-		_prline->get_value(11, _lineitem.L_COMMITDATE, 15);
-		_commitdate = str_to_timet(_lineitem.L_COMMITDATE);
-		_prline->get_value(12, _lineitem.L_RECEIPTDATE, 15);
-		_receiptdate = str_to_timet(_lineitem.L_RECEIPTDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
+		_shipdate = _lineitem.L_SHIPDATE;
+		_prline->get_value(11, _lineitem.L_COMMITDATE);
+		_commitdate = _lineitem.L_COMMITDATE;
+		_prline->get_value(12, _lineitem.L_RECEIPTDATE);
+		_receiptdate = _lineitem.L_RECEIPTDATE;
 		_prline->get_value(14, _lineitem.L_SHIPMODE, 15);
 		_shipmode=str_to_shipmode(_lineitem.L_SHIPMODE);
 
 		//TODO implement it with _and_predicate
 
 		// Return true if it passes the filter
-		if  ( (_shipmode==q12_input->l_shipmode1 || _shipmode==q12_input->l_shipmode2) && _commitdate<_receiptdate && _shipdate<_commitdate && _receiptdate >= q12_input->l_receiptdate && _receiptdate < _last_l_receiptdate ) {
+		if  ( (_shipmode==q12_input->l_shipmode1 || _shipmode==q12_input->l_shipmode2) && _commitdate<_receiptdate && _shipdate<_commitdate && _receiptdate >= _first_l_receiptdate && _receiptdate < _last_l_receiptdate ) {
 			//TRACE(TRACE_RECORD_FLOW, "+ %d %s\n", _lineitem.L_ORDERKEY, _lineitem.L_SHIPMODE);
 			return (true);
 		}
@@ -99,13 +99,14 @@ private:
     /*One lineitem tuple*/
     tpch_lineitem_tuple _lineitem;
     /*The columns needed for the selection*/
-    time_t _shipdate;
+    date_t _shipdate;
 
   //and_predicate_t _filter;
 
     /* Random Predicates */
     q14_input_t* q14_input;
     time_t date1, date2;
+    date_t _first_shipdate, _last_shipdate;
 public:
     q14_lineitem_tscan_filter_t(ShoreTPCHEnv* tpchdb, q14_input_t &in)
         : tuple_filter_t(tpchdb->lineitem_desc()->maxsize()), _tpchdb(tpchdb)
@@ -125,6 +126,8 @@ public:
         date1 = q14_input->l_shipdate;
 	// L_SHIPDATE < [date] + 1 month
         date2 = time_add_month(date1, 1);
+        _first_shipdate = timet_to_date(date1);
+        _last_shipdate = timet_to_date(date2);
 
         char shdate1[15];
         char shdate2[15];
@@ -174,10 +177,10 @@ public:
             assert(false); // RC(se_WRONG_DISK_DATA)
         }
 
-	_prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-	_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+	_prline->get_value(10, _lineitem.L_SHIPDATE);
+	_shipdate = _lineitem.L_SHIPDATE;
 
-	if (_shipdate>=date1 && _shipdate<date2)
+	if (_shipdate>=_first_shipdate && _shipdate<_last_shipdate)
 	  {
 	    return (true);
 	  }
@@ -113,10 +113,10 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _shipdate;
+	date_t _shipdate;
 
-	time_t _firstdate;
-	time_t _lastdate;
+	date_t _firstdate;
+	date_t _lastdate;
 
 public:
 	q15_lineitem_tscan_filter_t(ShoreTPCHEnv* tpchdb, q15_input_t &in)
@@ -127,15 +127,17 @@ public:
 				_tpchdb->lineitem_desc()->maxsize());
 		_prline->_rep = &_rr;
 
-		_firstdate = (&in)->l_shipdate;
-		struct tm *tm = gmtime(&_firstdate);
+		time_t firstdate = (&in)->l_shipdate;
+		struct tm *tm = gmtime(&firstdate);
 		tm->tm_mon += 3;
-		_lastdate = mktime(tm);
+		time_t lastdate = mktime(tm);
+		_firstdate = timet_to_date(firstdate);
+		_lastdate = timet_to_date(lastdate);
 
 		char f_shipdate[STRSIZE(10)];
 		char l_shipdate[STRSIZE(10)];
-		timet_to_str(f_shipdate, _firstdate);
-		timet_to_str(l_shipdate, _lastdate);
+		date_to_str(f_shipdate, _firstdate);
+		date_to_str(l_shipdate, _lastdate);
 
 		TRACE(TRACE_ALWAYS, "Random predicate:\nLINEITEM.L_SHIPDATE between [%s, %s[\n", f_shipdate, l_shipdate);
 	}
@@ -152,8 +154,8 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, sizeof(_lineitem.L_SHIPDATE));
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
+		_shipdate = _lineitem.L_SHIPDATE;
 
 		return _shipdate >= _firstdate && _shipdate < _lastdate;
 	}
@@ -180,8 +182,8 @@ public:
 	c_str to_string() const {
 		char f_shipdate[STRSIZE(10)];
 		char l_shipdate[STRSIZE(10)];
-		timet_to_str(f_shipdate, _firstdate);
-		timet_to_str(l_shipdate, _lastdate);
+		date_to_str(f_shipdate, _firstdate);
+		date_to_str(l_shipdate, _lastdate);
 		return c_str("q15_lineitem_tscan_filter_t(l_shipdate between [%s, %s[)", f_shipdate, l_shipdate);
 	}
 };
@@ -865,13 +865,14 @@ struct q2_sort_key_extractor_t : public key_extractor_t
 {
 
 	q2_sort_key_extractor_t()
-	: key_extractor_t(sizeof(q2_sort_key), offsetof(q2_sort_key, S_ACCTBAL))
+	: key_extractor_t(sizeof(q2_sort_key), offsetof(q2_aggregate_tuple, S_ACCTBAL))
 	{
 	}
 
+	// S_ACCTBAL sorts descending
 	virtual int extract_hint(const char *key) const {
 		q2_sort_key *sort_key = aligned_cast<q2_sort_key>(key);
-		return sort_key->S_ACCTBAL.to_int();
+		return -sort_key->S_ACCTBAL.to_int();
 	}
 
 	virtual q2_sort_key_extractor_t* clone() const {
@@ -1085,28 +1086,6 @@ struct q2_final_join_t : public tuple_join_t
 	}
 };
 
-struct q2_top100_filter_t : public tuple_filter_t
-{
-	int _count;
-
-	q2_top100_filter_t()
-	: tuple_filter_t(sizeof(q2_aggregate_tuple)), _count(0)
-	{
-	}
-
-	bool select(const tuple_t &input) {
-		return ++_count <= 100;
-	}
-
-	virtual q2_top100_filter_t* clone() const {
-		return new q2_top100_filter_t(*this);
-	}
-
-	virtual c_str to_string() const {
-		return c_str("q2_top100_filter_t");
-	}
-};
-
 class tpch_q2_process_tuple_t : public process_tuple_t
 {
 public:
@@ -1236,16 +1215,6 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 					q2_region_tscan_packet,
 					new q2_s_ps_p_n_join_r_t());
 
-	//SORT
-	tuple_fifo* q2_sort_buffer = new tuple_fifo(sizeof(q2_s_ps_p_n_join_r_tuple));
-	packet_t* q2_sort_packet =
-			new sort_packet_t("SORT",
-					q2_sort_buffer,
-					new trivial_filter_t(sizeof(q2_s_ps_p_n_join_r_tuple)),
-					new q2_sort_key_extractor_t(),
-					new q2_sort_key_compare_t(),
-					q2_s_ps_p_n_join_r_packet);
-
 	//---SUBQUERY---
 
 	//TSCAN NATION
@@ -1331,16 +1300,27 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 
 	//---------------
 
-	//FINAL JOIN + TOP100-Filter
-	tuple_fifo* q2_final_buffer = new tuple_fifo(sizeof(q2_aggregate_tuple));
-	packet_t* q2_final_packet =
+	//FINAL JOIN
+	tuple_fifo* q2_join_buffer = new tuple_fifo(sizeof(q2_aggregate_tuple));
+	packet_t* q2_join_packet =
 			new hash_join_packet_t("subquery join main_query",
-					q2_final_buffer,
-					new q2_top100_filter_t(),
-					q2_sort_packet,
+					q2_join_buffer,
+					new trivial_filter_t(sizeof(q2_aggregate_tuple)),
+					q2_s_ps_p_n_join_r_packet,
 					q2_subquery_aggregate_packet,
 					new q2_final_join_t());
 
+	//ORDER BY S_ACCTBAL DESC, N_NAME, S_NAME, P_PARTKEY LIMIT 100
+	tuple_fifo* q2_final_buffer = new tuple_fifo(sizeof(q2_aggregate_tuple));
+	packet_t* q2_final_packet =
+			new topn_packet_t("TOP 100",
+					q2_final_buffer,
+					new trivial_filter_t(sizeof(q2_aggregate_tuple)),
+					new q2_sort_key_extractor_t(),
+					new q2_sort_key_compare_t(),
+					100,
+					q2_join_packet);
+
 	qpipe::query_state_t* qs = dp->query_state_create();
 	q2_part_tscan_packet->assign_query_state(qs);
 	q2_partsupp_tscan_packet->assign_query_state(qs);
@@ -1351,7 +1331,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	q2_s_ps_p_join_n_packet->assign_query_state(qs);
 	q2_region_tscan_packet->assign_query_state(qs);
 	q2_s_ps_p_n_join_r_packet->assign_query_state(qs);
-	q2_sort_packet->assign_query_state(qs);
+	q2_join_packet->assign_query_state(qs);
 	//---subquery
 	q2_nation_tscan_subquery_packet->assign_query_state(qs);
 	q2_region_tscan_subquery_packet->assign_query_state(qs);
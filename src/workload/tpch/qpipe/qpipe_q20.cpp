@@ -418,10 +418,10 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _shipdate;
+	date_t _shipdate;
 
-	time_t _first_shipdate;
-	time_t _last_shipdate;
+	date_t _first_shipdate;
+	date_t _last_shipdate;
 
 	q20_input_t *q20_input;
 
@@ -435,16 +435,17 @@ public:
 		_prline->_rep = &_rr;
 
 		q20_input = &in;
-		_first_shipdate = q20_input->l_shipdate;
+		time_t first_shipdate = q20_input->l_shipdate;
 
-		struct tm *tm = gmtime(&_first_shipdate);
+		struct tm *tm = gmtime(&first_shipdate);
 		tm->tm_year++;
-		_last_shipdate = mktime(tm);
+		_first_shipdate = timet_to_date(first_shipdate);
+		_last_shipdate = timet_to_date(mktime(tm));
 
-		char f_shipdate[10];
-		char l_shipdate[10];
-		timet_to_str(f_shipdate, _first_shipdate);
-		timet_to_str(l_shipdate, _last_shipdate);
+		char f_shipdate[STRSIZE(10)];
+		char l_shipdate[STRSIZE(10)];
+		date_to_str(f_shipdate, _first_shipdate);
+		date_to_str(l_shipdate, _last_shipdate);
 
 		TRACE(TRACE_ALWAYS, "Random predicates:\n%s <= L_SHIPDATE < %s\n", f_shipdate, l_shipdate);
 	}
@@ -461,8 +462,8 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, sizeof(_lineitem.L_SHIPDATE));
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
+		_shipdate = _lineitem.L_SHIPDATE;
 
 		return _shipdate >= _first_shipdate && _shipdate < _last_shipdate;
 	}
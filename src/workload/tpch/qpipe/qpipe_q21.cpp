@@ -311,10 +311,10 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(11, _lineitem.L_COMMITDATE, sizeof(_lineitem.L_COMMITDATE));
-		_prline->get_value(12, _lineitem.L_RECEIPTDATE, sizeof(_lineitem.L_RECEIPTDATE));
+		_prline->get_value(11, _lineitem.L_COMMITDATE);
+		_prline->get_value(12, _lineitem.L_RECEIPTDATE);
 
-		return str_to_timet(_lineitem.L_RECEIPTDATE) > str_to_timet(_lineitem.L_COMMITDATE);
+		return _lineitem.L_RECEIPTDATE > _lineitem.L_COMMITDATE;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -856,14 +856,15 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q21(const int xct_id,
     				new default_key_extractor_t(STRSIZE(25) * sizeof(char), offsetof(q21_all_joins_tuple, S_NAME)),
     				new int_key_compare_t());
 
-    //SORT
+    //ORDER BY NUMWAIT DESC, S_NAME LIMIT 100
     tuple_fifo* q21_final_buffer = new tuple_fifo(sizeof(q21_final_tuple));
     packet_t* q21_final_packet =
-    		new sort_packet_t("ORDER BY NUMWAIT desc, S_NAME",
+    		new topn_packet_t("ORDER BY NUMWAIT desc, S_NAME LIMIT 100",
     				q21_final_buffer,
     				new trivial_filter_t(sizeof(q21_final_tuple)),
     				new q21_sort_key_extractor_t(),
     				new q21_sort_key_compare_t(),
+    				100,
     				q21_aggregate_packet);
 
 
@@ -81,7 +81,7 @@ struct q3_projected_customer_tuple {
 struct q3_projected_orders_tuple {
 	int O_ORDERKEY;
 	int O_CUSTKEY;
-	time_t O_ORDERDATE;
+	date_t O_ORDERDATE;
 	int O_SHIPPRIORITY;
 };
 
@@ -94,7 +94,7 @@ struct q3_projected_lineitem_tuple {
 
 struct q3_o_join_c_tuple {
 	int O_ORDERKEY;
-	time_t O_ORDERDATE;
+	date_t O_ORDERDATE;
 	int O_SHIPPRIORITY;
 };
 
@@ -105,14 +105,14 @@ struct q3_aggregated_lineitem_tuple {
 
 struct q3_aggregated_tuple {
 	int L_ORDERKEY;
-	time_t O_ORDERDATE;
+	date_t O_ORDERDATE;
 	int O_SHIPPRIORITY;
 	decimal REVENUE;
 };
 
 struct q3_agg_key {
 	int L_ORDERKEY;
-	time_t O_ORDERDATE;
+	date_t O_ORDERDATE;
 	int O_SHIPPRIORITY;
 };
 
@@ -192,9 +192,10 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
+	date_t _orderdate;
 
 	q3_input_t* q3_input;
+	date_t _current_date;
 
 public:
 	q3_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q3_input_t &in)
@@ -207,6 +208,7 @@ public:
 
 		// Generate the random predicates
 		q3_input = &in;
+		_current_date = timet_to_date(q3_input->current_date);
 
 		char time[15];
 		timet_to_str(time, q3_input->current_date);
@@ -225,10 +227,10 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prorders->get_value(4, _orders.O_ORDERDATE, 15);
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
+		_orderdate = _orders.O_ORDERDATE;
 
-		return _orderdate < q3_input->current_date;
+		return _orderdate < _current_date;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -237,14 +239,14 @@ public:
 
 		_prorders->get_value(0, _orders.O_ORDERKEY);
 		_prorders->get_value(1, _orders.O_CUSTKEY);
-		_prorders->get_value(4, _orders.O_ORDERDATE, 15);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 		_prorders->get_value(7, _orders.O_SHIPPRIORITY);
 
 		//TRACE(TRACE_RECORD_FLOW, "%d|%d|%s|%d\n", _orders.O_ORDERKEY, _orders.O_CUSTKEY, _orders.O_ORDERDATE, _orders.O_SHIPPRIORITY);
 
 		dest->O_ORDERKEY = _orders.O_ORDERKEY;
 		dest->O_CUSTKEY = _orders.O_CUSTKEY;
-		dest->O_ORDERDATE = str_to_timet(_orders.O_ORDERDATE);
+		dest->O_ORDERDATE = _orders.O_ORDERDATE;
 		dest->O_SHIPPRIORITY = _orders.O_SHIPPRIORITY;
 
 	}
@@ -266,9 +268,10 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _shipdate;
+	date_t _shipdate;
 
 	q3_input_t* q3_input;
+	date_t _current_date;
 
 public:
 	q3_lineitem_tscan_filter_t(ShoreTPCHEnv* tpchdb, q3_input_t &in)
@@ -281,6 +284,7 @@ public:
 
 		// Generate the random predicates
 		q3_input = &in;
+		_current_date = timet_to_date(q3_input->current_date);
 
 		char time[15];
 		timet_to_str(time, q3_input->current_date);
@@ -299,10 +303,10 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
+		_shipdate = _lineitem.L_SHIPDATE;
 
-		return _shipdate > q3_input->current_date;
+		return _shipdate > _current_date;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -351,7 +355,7 @@ struct q3_o_join_c_t : public tuple_join_t {
 		dest->O_SHIPPRIORITY = left->O_SHIPPRIORITY;
 
 		char date[STRSIZE(10)];
-		timet_to_str(date, left->O_ORDERDATE);
+		date_to_str(date, left->O_ORDERDATE);
 		//TRACE(TRACE_RECORD_FLOW, "JOIN: %d=%d: %d %s %d\n", left->O_CUSTKEY, right->C_CUSTKEY, left->O_ORDERKEY, date, left->O_SHIPPRIORITY);
 	}
 
@@ -415,7 +419,7 @@ struct q3_l_join_oc_t : public tuple_join_t {
 		dest->O_SHIPPRIORITY = right->O_SHIPPRIORITY;
 
 		char date[STRSIZE(10)];
-		timet_to_str(date, right->O_ORDERDATE);
+		date_to_str(date, right->O_ORDERDATE);
 		//TRACE(TRACE_RECORD_FLOW, "JOIN: %d=%d: %d %.2f %s %d\n", left->L_ORDERKEY, right->O_ORDERKEY, right->O_ORDERKEY, left->REVENUE.to_double(), date, right->O_SHIPPRIORITY);
 	}
 
@@ -484,36 +488,6 @@ struct q3_aggregate_t : tuple_aggregate_t {
 	}
 };
 
-struct q3_top10_t : tuple_aggregate_t {
-	default_key_extractor_t _extractor;
-
-	q3_top10_t()
-	: tuple_aggregate_t(sizeof(q3_aggregated_tuple)),
-	  _extractor(0,0)
-	{
-	}
-
-	virtual key_extractor_t* key_extractor() {
-		return &_extractor;
-	}
-
-	virtual void aggregate(char* agg_data, const tuple_t &t) {
-		memcpy(agg_data, t.data, tuple_size());
-	}
-
-	virtual q3_top10_t* clone() const {
-		return new q3_top10_t(*this);
-	}
-
-	virtual void finish(tuple_t& d, const char* agg_data) {
-		memcpy(d.data, agg_data, tuple_size());
-	}
-
-	virtual c_str to_string() const {
-		return c_str("q3_top10_t");
-	}
-};
-
 struct q3_sort_key_extractor_t : public key_extractor_t {
 
 	q3_sort_key_extractor_t() : key_extractor_t(sizeof(q3_aggregated_tuple))
@@ -546,37 +520,6 @@ struct q3_sort_key_compare_t : public key_compare_t {
 	}
 };
 
-class q3_top10_filter_t : public tuple_filter_t {
-
-private:
-	int _count;
-
-public:
-
-	q3_top10_filter_t() : tuple_filter_t(sizeof(q3_aggregated_tuple)), _count(0)
-	{
-	}
-
-	virtual bool select(const tuple_t &tuple) {
-		if(++_count <= 10) {
-			return true;
-		}
-		else {
-			return false;
-		}
-	}
-
-	virtual q3_top10_filter_t* clone() const {
-		return new q3_top10_filter_t(*this);
-	}
-
-	virtual c_str to_string() const {
-		return c_str("q3_top10_filter_t");
-	}
-};
-
-
-
 class tpch_q3_process_tuple_t : public process_tuple_t {
 
 public:
@@ -590,7 +533,7 @@ public:
 		q3_aggregated_tuple* r = aligned_cast<q3_aggregated_tuple>(output.data);
 
 		char date[STRSIZE(10)];
-		timet_to_str(date, r->O_ORDERDATE);
+		date_to_str(date, r->O_ORDERDATE);
 		TRACE(TRACE_QUERY_RESULTS, "*** Q3 %14d %14.4f %14s %14d\n",
 				r->L_ORDERKEY, r->REVENUE.to_double(), date, r->O_SHIPPRIORITY);
 	}
@@ -684,26 +627,17 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q3(const int xct_id,
 					new default_key_extractor_t(sizeof(q3_agg_key)),
 					new q3_agg_key_compare_t());
 
-	//SORT + TOP10 FILTER
+	//ORDER BY REVENUE DESC, O_ORDERDATE LIMIT 10
 	tuple_fifo* q3_final_buffer = new tuple_fifo(sizeof(q3_aggregated_tuple));
 	packet_t* q3_final_packet =
-			new sort_packet_t("SORT",
+			new topn_packet_t("TOP 10",
 					q3_final_buffer,
-					new q3_top10_filter_t(),
+					new trivial_filter_t(sizeof(q3_aggregated_tuple)),
 					new q3_sort_key_extractor_t(),
 					new q3_sort_key_compare_t(),
+					10,
 					q3_agg_packet);
 
-	tuple_fifo* q3_ffinal_buffer = new tuple_fifo(sizeof(q3_aggregated_tuple));
-	packet_t* q3_ffinal_packet =
-			new partial_aggregate_packet_t("Top10 Agg",
-					q3_ffinal_buffer,
-					new q3_top10_filter_t(),
-					q3_final_packet,
-					new q3_top10_t(),
-					new default_key_extractor_t(sizeof(q3_aggregated_tuple)),
-					new int_key_compare_t());
-
 
 
 	qpipe::query_state_t* qs = dp->query_state_create();
@@ -715,7 +649,6 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q3(const int xct_id,
 	q3_l_join_oc_packet->assign_query_state(qs);
 	q3_agg_packet->assign_query_state(qs);
 	q3_final_packet->assign_query_state(qs);
-	q3_ffinal_packet->assign_query_state(qs);
 
 	// Dispatch packet
 	tpch_q3_process_tuple_t pt;
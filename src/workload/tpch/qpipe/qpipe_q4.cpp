@@ -114,8 +114,8 @@ private:
     /*One lineitem tuple*/
     tpch_lineitem_tuple _lineitem;
     /*The columns needed for the selection*/
-    time_t _commitdate;
-    time_t _receiptdate;
+    date_t _commitdate;
+    date_t _receiptdate;
     /* No Random Predicates */
 public:
 
@@ -145,11 +145,11 @@ public:
             assert(false); // RC(se_WRONG_DISK_DATA)
         }
 
-        _prline->get_value(12, _lineitem.L_RECEIPTDATE, 15);
-        _receiptdate = str_to_timet(_lineitem.L_RECEIPTDATE);
+        _prline->get_value(12, _lineitem.L_RECEIPTDATE);
+        _receiptdate = _lineitem.L_RECEIPTDATE;
 
-        _prline->get_value(11, _lineitem.L_COMMITDATE, 15);
-        _commitdate = str_to_timet(_lineitem.L_COMMITDATE);
+        _prline->get_value(11, _lineitem.L_COMMITDATE);
+        _commitdate = _lineitem.L_COMMITDATE;
 
 
         // Return true if it passes the filter
@@ -262,13 +262,15 @@ private:
     /*One lineitem tuple*/
     tpch_orders_tuple _orders;
     /*The columns needed for the selection*/
-    time_t _orderdate;
+    date_t _orderdate;
 
     /* Random Predicates */
     /* TPC-H Specification 2.7.3 */
     /* MONTH randomly selected within [1-1993, 10-1997]*/
     q4_input_t* q4_input;
     time_t _last_o_orderdate;
+    date_t _first_date;
+    date_t _last_date;
 public:
 
     q4_tscan_orders_filter_t(ShoreTPCHEnv* tpchdb, q4_input_t &in)
@@ -291,6 +293,8 @@ public:
 	gmtime_r(&(q4_input->o_orderdate), &date);
 	date.tm_mon += 3;
 	_last_o_orderdate=mktime(&date);
+	_first_date=timet_to_date(q4_input->o_orderdate);
+	_last_date=timet_to_date(_last_o_orderdate);
 
 	char date1[15];
 	char date2[15];
@@ -314,12 +318,12 @@ public:
             assert(false); // RC(se_WRONG_DISK_DATA)
         }
 
-        _prorder->get_value(4, _orders.O_ORDERDATE, 15);
-        _orderdate = str_to_timet(_orders.O_ORDERDATE);
+        _prorder->get_value(4, _orders.O_ORDERDATE);
+        _orderdate = _orders.O_ORDERDATE;
 
 
         // Return true if it passes the filter
-		if  ( _orderdate >= q4_input->o_orderdate && _orderdate < _last_o_orderdate ) {
+		if  ( _orderdate >= _first_date && _orderdate < _last_date ) {
 			//TRACE(TRACE_RECORD_FLOW, "+ %s (between %s and %s)\n", _orders.O_ORDERDATE, q4_input->o_orderdate, _last_o_orderdate);
 			return (true);
 		}
@@ -339,10 +339,12 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
+	date_t _orderdate;
 
 	q5_input_t* q5_input;
 	time_t _last_orderdate;
+	date_t _first_date;
+	date_t _last_date;
 
 public:
 	q5_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q5_input_t &in)
@@ -359,6 +361,8 @@ public:
 		gmtime_r(&(q5_input->o_orderdate), &date);
 		date.tm_year++;
 		_last_orderdate = mktime(&date);
+		_first_date = timet_to_date(q5_input->o_orderdate);
+		_last_date = timet_to_date(_last_orderdate);
 
 		char t1[15];
 		char t2[15];
@@ -380,10 +384,10 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prorders->get_value(4, _orders.O_ORDERDATE, 15);
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
+		_orderdate = _orders.O_ORDERDATE;
 
-		return _orderdate >= q5_input->o_orderdate && _orderdate < _last_orderdate;
+		return _orderdate >= _first_date && _orderdate < _last_date;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -88,14 +88,15 @@ private:
     /*One lineitem tuple*/
     tpch_lineitem_tuple _lineitem;
     /*The columns needed for the selection*/
-    time_t _shipdate;
+    date_t _shipdate;
     double _discount;
     double _quantity;
 
     /* Random Predicates */
     /* TPC-H Specification 2.9.3 */
     q6_input_t* q6_input;
-    time_t _last_l_shipdate;
+    date_t _first_l_shipdate;
+    date_t _last_l_shipdate;
 public:
 
     q6_tscan_filter_t(ShoreTPCHEnv* tpchdb, q6_input_t &in)
@@ -120,12 +121,14 @@ public:
       	struct tm date;
 	gmtime_r(&(q6_input->l_shipdate), &date);
 	date.tm_year ++;
-	_last_l_shipdate=mktime(&date);
+	time_t last_shipdate=mktime(&date);
+	_first_l_shipdate=timet_to_date(q6_input->l_shipdate);
+	_last_l_shipdate=timet_to_date(last_shipdate);
 
 	char date1[15];
 	char date2[15];
 	timet_to_str(date1,q6_input->l_shipdate);
-	timet_to_str(date2,_last_l_shipdate);
+	timet_to_str(date2,last_shipdate);
 	TRACE(TRACE_ALWAYS, "Random predicates: Date: %s-%s, Discount: %lf, Quantity: %lf\n", date1, date2, q6_input->l_discount, q6_input->l_quantity);
     }
 
@@ -144,8 +147,8 @@ public:
             assert(false); // RC(se_WRONG_DISK_DATA)
         }
 
-        _prline->get_value(10, _lineitem.L_SHIPDATE, 15); //get column 10 (15 characters)
-        _shipdate = str_to_timet(_lineitem.L_SHIPDATE);        
+        _prline->get_value(10, _lineitem.L_SHIPDATE); //get column 10 (date)
+        _shipdate = _lineitem.L_SHIPDATE;        
         _prline->get_value(6, _lineitem.L_DISCOUNT); //get column 6 (float)
         _discount=_lineitem.L_DISCOUNT/100.0;
 #warning MA: Discount from TPCH dbgen is created between 0 and 100 instead between 0 and 1.
@@ -155,7 +158,7 @@ public:
 
 
         // Return true if it passes the filter
-		if  ( _shipdate >= q6_input->l_shipdate && _shipdate < _last_l_shipdate && _discount>=(q6_input->l_discount-0.01) &&
+		if  ( _shipdate >= _first_l_shipdate && _shipdate < _last_l_shipdate && _discount>=(q6_input->l_discount-0.01) &&
 				_discount<=(q6_input->l_discount+0.01) && _quantity<q6_input->l_quantity) {
 
 			//TRACE(TRACE_RECORD_FLOW, "+ %s, %lf, %lf\n", _lineitem.L_SHIPDATE, _lineitem.L_DISCOUNT, _lineitem.L_QUANTITY);
@@ -357,10 +357,10 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
         rep_row_t _rr;
 
         tpch_lineitem_tuple _lineitem;
-        time_t _shipdate;
+        date_t _shipdate;
 
-        time_t _firstdate;
-        time_t _lastdate;
+        date_t _firstdate;
+        date_t _lastdate;
 
     public:
         q7_lineitem_tscan_filter_t(ShoreTPCHEnv* tpchdb, q7_input_t &in)
@@ -371,8 +371,8 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
                        _tpchdb->lineitem_desc()->maxsize());
             _prline->_rep = &_rr;
 
-            _firstdate = str_to_timet("1995-01-01");
-            _lastdate = str_to_timet("1996-12-31");
+            _firstdate = str_to_date("1995-01-01");
+            _lastdate = str_to_date("1996-12-31");
         }
 
         virtual ~q7_lineitem_tscan_filter_t()
@@ -387,8 +387,8 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
                 assert(false); // RC(se_WRONG_DISK_DATA)
             }
 
-            _prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-            _shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+            _prline->get_value(10, _lineitem.L_SHIPDATE);
+            _shipdate = _lineitem.L_SHIPDATE;
 
             return (_shipdate >= _firstdate && _shipdate <= _lastdate);
         }
@@ -401,19 +401,18 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
             _prline->get_value(2, _lineitem.L_SUPPKEY);
             _prline->get_value(5, _lineitem.L_EXTENDEDPRICE);
             _prline->get_value(6, _lineitem.L_DISCOUNT);
-            _prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-            _shipdate = str_to_timet(_lineitem.L_SHIPDATE);
-            struct tm *tm_shipdate = gmtime(&_shipdate);
+            _prline->get_value(10, _lineitem.L_SHIPDATE);
+            _shipdate = _lineitem.L_SHIPDATE;
 
             //TRACE(TRACE_RECORD_FLOW, "%d|%d|%.2f|%.2f|%d\n", _lineitem.L_ORDERKEY, _lineitem.L_SUPPKEY, _lineitem.L_EXTENDEDPRICE / 100.0, _lineitem.L_DISCOUNT / 100.0,
-            //													tm_shipdate->tm_year + 1900);
+            //													date_year(_shipdate));
 
             dest->L_ORDERKEY = _lineitem.L_ORDERKEY;
             dest->L_SUPPKEY = _lineitem.L_SUPPKEY;
             dest->L_EXTENDEDPRICE = _lineitem.L_EXTENDEDPRICE / 100.0;
 #warning MA: Discount from TPCH dbgen is created between 0 and 100 instead between 0 and 1.
             dest->L_DISCOUNT = _lineitem.L_DISCOUNT / 100.0;
-            dest->L_YEAR = tm_shipdate->tm_year + 1900;
+            dest->L_YEAR = date_year(_shipdate);
             /*char ryear[5];
             strncpy(ryear, _lineitem.L_SHIPDATE, 4);
             ryear[4] = '\0';
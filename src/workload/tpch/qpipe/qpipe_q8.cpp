@@ -326,10 +326,10 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
+	date_t _orderdate;
 
-	time_t _first_orderdate;
-	time_t _last_orderdate;
+	date_t _first_orderdate;
+	date_t _last_orderdate;
 
 public:
 	q8_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q8_input_t &in)
@@ -340,8 +340,8 @@ public:
 				_tpchdb->orders_desc()->maxsize());
 		_prorders->_rep = &_rr;
 
-		_first_orderdate = str_to_timet("1995-01-01");
-		_last_orderdate = str_to_timet("1996-12-31");
+		_first_orderdate = str_to_date("1995-01-01");
+		_last_orderdate = str_to_date("1996-12-31");
 	}
 
 	virtual ~q8_orders_tscan_filter_t()
@@ -356,8 +356,8 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
+		_orderdate = _orders.O_ORDERDATE;
 
 		return _orderdate >= _first_orderdate && _orderdate <= _last_orderdate;
 	}
@@ -368,15 +368,14 @@ public:
 
 		_prorders->get_value(0, _orders.O_ORDERKEY);
 		_prorders->get_value(1, _orders.O_CUSTKEY);
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
-		struct tm *tm_orderdate = gmtime(&_orderdate);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
+		_orderdate = _orders.O_ORDERDATE;
 
-		//TRACE(TRACE_RECORD_FLOW, "%d|%d|%d\n", _orders.O_ORDERKEY, _orders.O_CUSTKEY, tm_orderdate->tm_year + 1900);
+		//TRACE(TRACE_RECORD_FLOW, "%d|%d|%d\n", _orders.O_ORDERKEY, _orders.O_CUSTKEY, date_year(_orderdate));
 
 		dest->O_ORDERKEY = _orders.O_ORDERKEY;
 		dest->O_CUSTKEY = _orders.O_CUSTKEY;
-		dest->O_YEAR = tm_orderdate->tm_year + 1900;
+		dest->O_YEAR = date_year(_orderdate);
 	}
 
 	q8_orders_tscan_filter_t* clone() const {
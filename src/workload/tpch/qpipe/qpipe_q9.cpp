@@ -438,7 +438,7 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
+	date_t _orderdate;
 
 public:
 	q9_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q9_input_t &in)
@@ -470,14 +470,13 @@ public:
 		q9_projected_orders_tuple *dest = aligned_cast<q9_projected_orders_tuple>(d.data);
 
 		_prorders->get_value(0, _orders.O_ORDERKEY);
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
-		struct tm *tm_orderdate = gmtime(&_orderdate);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
+		_orderdate = _orders.O_ORDERDATE;
 
-		//TRACE(TRACE_RECORD_FLOW, "%d|%d\n", _orders.O_ORDERKEY, tm_orderdate->tm_year + 1900);
+		//TRACE(TRACE_RECORD_FLOW, "%d|%d\n", _orders.O_ORDERKEY, date_year(_orderdate));
 
 		dest->O_ORDERKEY = _orders.O_ORDERKEY;
-		dest->O_YEAR = tm_orderdate->tm_year + 1900;
+		dest->O_YEAR = date_year(_orderdate);
 	}
 
 	q9_orders_tscan_filter_t* clone() const {
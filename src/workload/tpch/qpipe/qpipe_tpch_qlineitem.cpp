@@ -117,9 +117,9 @@ public:
         _prline->get_value(7,  _lineitem.L_TAX);
         _prline->get_value(8,  _lineitem.L_RETURNFLAG);
         _prline->get_value(9,  _lineitem.L_LINESTATUS);
-        _prline->get_value(10, _lineitem.L_SHIPDATE,15);
-        _prline->get_value(11, _lineitem.L_COMMITDATE,15);
-        _prline->get_value(12, _lineitem.L_RECEIPTDATE,15);
+        _prline->get_value(10, _lineitem.L_SHIPDATE);
+        _prline->get_value(11, _lineitem.L_COMMITDATE);
+        _prline->get_value(12, _lineitem.L_RECEIPTDATE);
         _prline->get_value(13, _lineitem.L_SHIPINSTRUCT,25);
         _prline->get_value(14, _lineitem.L_SHIPMODE,10);
         _prline->get_value(15, _lineitem.L_COMMENT,44);
@@ -219,7 +219,7 @@ public:
     static const c_str* dump_tuple(tuple_t* tup) {
         tpch_lineitem_tuple *dest;
         dest = aligned_cast<tpch_lineitem_tuple> (tup->data);
-        return new c_str("%d|%d|%d|%d|%lf|%lf|%lf|%lf|%c|%c|%s|%s|%s|%s|%s|%s|\n",
+        return new c_str("%d|%d|%d|%d|%lf|%lf|%lf|%lf|%c|%c|%d|%d|%d|%s|%s|%s|\n",
 	  dest->L_ORDERKEY,
 	  dest->L_PARTKEY,
 	  dest->L_SUPPKEY,
@@ -95,6 +95,8 @@ int baseline_tpch_client_t::load_sup_xct(mapSupTrxs& stmap)
     stmap[XCT_TPCH_QSUPPLIER]      = "TPCH-QSUPPLIER";
     stmap[XCT_TPCH_QPART]          = "TPCH-QPART";
     stmap[XCT_TPCH_QPARTSUPP]      = "TPCH-QPARTSUPP";
+    stmap[XCT_TPCH_RF1]            = "TPCH-RF1";
+    stmap[XCT_TPCH_RF2]            = "TPCH-RF2";
 
 
 
@@ -303,6 +303,18 @@ ShoreTPCHEnv::ShoreTPCHEnv()
 
     // Register stage containers
     register_stage_containers();
+
+    // Pick the page pool used by all tuple_fifos
+    select_default_page_pool(envVar::instance()->getVar("qpipe-page-pool","malloc").c_str());
+
+    // Global memory budget for concurrent queries (in MB, 0 = unlimited)
+    memory_manager_t::set_budget((size_t)envVar::instance()->getVarInt("qpipe-memory-budget",0) << 20);
+
+    // Push Bloom filters from hash join build sides into probe-side scans
+    set_bloom_pushdown(envVar::instance()->getVarInt("qpipe-bloom-pushdown",1));
+
+    // Print a per-stage profile after every query
+    set_query_profiling(envVar::instance()->getVarInt("qpipe-profile",0));
 #endif
 }
 
@@ -325,6 +337,16 @@ w_rc_t ShoreTPCHEnv::load_schema()
     _porders_desc   = new orders_t(get_pd());
     _plineitem_desc = new lineitem_t(get_pd());
 
+    // min/max synopses for the date- and quantity-filtered scans
+    if (envVar::instance()->getVarInt("zone-maps",0)) {
+        int zpages = envVar::instance()->getVarInt("zone-map-pages",
+                                                   zone_map_t::DEFAULT_ZONE_PAGES);
+        uint const l_fields[] = { 4, 6, 10, 12 }; // quantity discount shipdate receiptdate
+        uint const o_fields[] = { 4 };            // orderdate
+        _plineitem_desc->create_zone_map(l_fields, 4, zpages);
+        _porders_desc->create_zone_map(o_fields, 1, zpages);
+    }
+
     // initiate the table managers
     _pnation_man   = new nation_man_impl(_pnation_desc.get());
     _pregion_man   = new region_man_impl(_pregion_desc.get());
@@ -440,17 +462,37 @@ int ShoreTPCHEnv::statistics()
  *
  *  @fn:    start/stop
  *
- *  @brief: Simply call the corresponding functions of shore_env 
+ *  @brief: Call the corresponding functions of shore_env. The zone
+ *          maps on disk are stale while the environment runs, and a
+ *          stale PAX copy of a loaded database is rebuilt at start.
  *
  ********************************************************************/
 
 int ShoreTPCHEnv::start()
 {
+    // Helper threads for the parallel scans (0 = scan serially)
+    int helpers = envVar::instance()->getVarInt("scan-helpers",0);
+    if ((helpers > 0) && !_scan_helpers)
+        _scan_helpers = new scan_helper_pool_t(helpers);
+
+    table_desc_t* zoned[] = { _porders_desc.get(), _plineitem_desc.get() };
+    W_COERCE(_sync_zone_maps(zoned, 2, false));
+
+    if (_loaded) {
+        table_man_t* paxed[] = { _plineitem_man };
+        W_COERCE(_build_pax_stores(paxed, 1));
+    }
+
     return (ShoreEnv::start());
 }
 
 int ShoreTPCHEnv::stop()
 {
+    _scan_helpers.done();
+
+    table_desc_t* zoned[] = { _porders_desc.get(), _plineitem_desc.get() };
+    W_COERCE(_sync_zone_maps(zoned, 2, true));
+
     return (ShoreEnv::stop());
 }
 
@@ -485,6 +527,7 @@ w_rc_t ShoreTPCHEnv::loaddata()
 
     // 1. Call the function that initializes the dbgen
     dbgen_init();
+    dbgen_scale(_scaling_factor);
 
 
     time_t tstart = time(NULL);
@@ -503,6 +546,13 @@ w_rc_t ShoreTPCHEnv::loaddata()
     long parts_per_thread = total_parts/loaders_to_use;
     long custs_per_thread = total_custs/loaders_to_use;
 
+    // With "db-bulk-index" the loaders write only the heaps
+    table_man_t* managers[] = { _pnation_man, _pregion_man, _ppart_man,
+                                _psupplier_man, _ppartsupp_man, 
+                                _pcustomer_man, _porders_man, 
+                                _plineitem_man };
+    bool bulk_index = _defer_indexes(managers, SHORE_TPCH_TABLES);
+
     // 2. Fire up the table creator and baseline loader
     {
 	guard<table_creator_t> tc;
@@ -519,16 +569,19 @@ w_rc_t ShoreTPCHEnv::loaddata()
     // 4. Fire up the parallel loaders
     TRACE( TRACE_ALWAYS, "Firing up %d loaders ..\n", loaders_to_use);
     array_guard_t< guard<table_builder_t> > loaders(new guard<table_builder_t>[loaders_to_use]);
+    // Each loader generates the rows [start,end) of its slice of the
+    // Part and the Customer tables, after the first DIVISOR rows that
+    // the creator loaded. The rows are numbered from 1, as in dbgen.
     for(int i=0; i < loaders_to_use; i++) {
-	long part_start = (i*parts_per_thread) + DIVISOR;
-	long part_end = ((i+1)*parts_per_thread > total_parts - 1) ? 
-            total_parts : (i+1)*parts_per_thread - 1;
-        assert (part_start <= part_end);
+	long part_end = (i == loaders_to_use-1) ? 
+            total_parts+1 : (i+1)*parts_per_thread+1;
+	long part_start = std::min((i*parts_per_thread) + 1 + DIVISOR,
+                                   part_end);
 
-	long cust_start = (i*custs_per_thread) + DIVISOR;
-	long cust_end = ((i+1)*custs_per_thread > total_custs - 1) ? 
-            total_custs : (i+1)*custs_per_thread - 1;
-        assert (cust_start <= cust_end);
+	long cust_end = (i == loaders_to_use-1) ? 
+            total_custs+1 : (i+1)*custs_per_thread+1;
+	long cust_start = std::min((i*custs_per_thread) + 1 + DIVISOR,
+                                   cust_end);
 
 	loaders[i] = new table_builder_t(this, i, 
                                          part_start, part_end, 
@@ -541,6 +594,15 @@ w_rc_t ShoreTPCHEnv::loaddata()
 	loaders[i]->join();
     }
 
+    // and then the indexes are built in key order
+    if (bulk_index) {
+        W_DO(_bulk_build_indexes(managers, SHORE_TPCH_TABLES));
+    }
+
+    // Copy the fact table into its PAX store, if there is one
+    table_man_t* paxed[] = { _plineitem_man };
+    W_DO(_build_pax_stores(paxed, 1));
+
     time_t tstop = time(NULL);
 
     // 5. Print stats
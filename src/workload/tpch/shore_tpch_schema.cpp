@@ -251,7 +251,7 @@ orders_t::orders_t(const uint4_t& pd) :
     _desc[1].setup(SQL_INT,   "O_CUSTKEY");       
     _desc[2].setup(SQL_CHAR,   "O_ORDERSTATUS");       
     _desc[3].setup(SQL_FLOAT, "O_TOTALPRICE");       
-    _desc[4].setup(SQL_FIXCHAR,  "O_ORDERDATE", 15);
+    _desc[4].setup(SQL_DATE,     "O_ORDERDATE");
     _desc[5].setup(SQL_FIXCHAR,  "O_ORDERPRIORITY", 15); 
     _desc[6].setup(SQL_FIXCHAR,  "O_CLERK", 15);
     _desc[7].setup(SQL_INT,   "O_SHIPPRIORITY");
@@ -291,9 +291,9 @@ lineitem_t::lineitem_t(const uint4_t& pd) :
     _desc[7].setup(SQL_FLOAT,  "L_TAX");
     _desc[8].setup(SQL_CHAR,   "L_RETURNFLAG");
     _desc[9].setup(SQL_CHAR,   "L_LINESTATUS");
-    _desc[10].setup(SQL_FIXCHAR,  "L_SHIPDATE", 15);
-    _desc[11].setup(SQL_FIXCHAR,  "L_COMMITDATE", 15);
-    _desc[12].setup(SQL_FIXCHAR,  "L_RECEIPTDATE", 15);
+    _desc[10].setup(SQL_DATE,     "L_SHIPDATE");
+    _desc[11].setup(SQL_DATE,     "L_COMMITDATE");
+    _desc[12].setup(SQL_DATE,     "L_RECEIPTDATE");
     _desc[13].setup(SQL_FIXCHAR,  "L_SHIPINSTRUCT", 25);
     _desc[14].setup(SQL_FIXCHAR,  "L_SHIPMODE", 10);
     _desc[15].setup(SQL_FIXCHAR,  "L_COMMENT", 44);
@@ -322,6 +322,13 @@ lineitem_t::lineitem_t(const uint4_t& pd) :
         create_index_desc("L_IDX_SHIPDATE", 0, keys2, 1, false);
 	create_index_desc("L_IDX_RECEIPTDATE", 0, keys3, 1, false);
     }
+
+    // PAX copy of the numeric, flag and date columns, without the
+    // three strings that make up a third of the row
+    if (pd & PD_PAX) {
+        uint pax[13] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+        create_pax_store(pax, 13);
+    }
 }
 
 
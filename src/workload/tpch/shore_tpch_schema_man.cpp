@@ -285,17 +285,13 @@ w_rc_t orders_man_impl::o_get_range_iter_by_index(ss_m* db,
 	assert (pindex);
 
 	/* get the lowest key value */
-	char low_date[15];
-	timet_to_str(low_date, low_o_orderdate);
-	ptuple->set_value(4, low_date);
+	ptuple->set_value(4, timet_to_date(low_o_orderdate));
 
 	int lowsz = format_key(pindex, ptuple, replow);
 	assert (replow._dest);
 
-	/* get the highest key value */
-	char high_date[15];
-	timet_to_str(high_date, high_o_orderdate+1);
-	ptuple->set_value(4, high_date);
+	/* get the highest key value, the day after the last one */
+	ptuple->set_value(4, timet_to_date(high_o_orderdate)+1);
 
 	int highsz = format_key(pindex, ptuple, rephigh);
 	assert (rephigh._dest);
@@ -331,17 +327,13 @@ w_rc_t lineitem_man_impl::l_get_range_iter_by_receiptdate_index(ss_m* db,
     assert (pindex);
 
     /* get the lowest key value */
-    char lowdate[15];
-    timet_to_str(lowdate, low_l_receiptdate);
-    ptuple->set_value(12, lowdate);
+    ptuple->set_value(12, timet_to_date(low_l_receiptdate));
 
     int lowsz = format_key(pindex, ptuple, replow);
     assert (replow._dest);
 
-    /* get the highest key value */
-    char highdate[15];
-    timet_to_str(highdate, high_l_receiptdate+1);
-    ptuple->set_value(12,highdate );
+    /* get the highest key value, the day after the last one */
+    ptuple->set_value(12, timet_to_date(high_l_receiptdate)+1);
 
     int highsz = format_key(pindex, ptuple, rephigh);
     assert (rephigh._dest);
@@ -372,17 +364,13 @@ w_rc_t lineitem_man_impl::l_get_range_iter_by_index(ss_m* db,
     assert (pindex);
  
     /* get the lowest key value */
-    char lowdate[15];
-    timet_to_str(lowdate, low_l_shipdate);
-    ptuple->set_value(10, lowdate);
+    ptuple->set_value(10, timet_to_date(low_l_shipdate));
 
     int lowsz = format_key(pindex, ptuple, replow);
     assert (replow._dest);
 
-    /* get the highest key value */
-    char highdate[15];
-    timet_to_str(highdate, high_l_shipdate+1);
-    ptuple->set_value(10, highdate);
+    /* get the highest key value, the day after the last one */
+    ptuple->set_value(10, timet_to_date(high_l_shipdate)+1);
 
     int highsz = format_key(pindex, ptuple, rephigh);
     assert (rephigh._dest);
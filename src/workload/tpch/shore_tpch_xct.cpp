@@ -39,6 +39,7 @@
 #include <set>
 #include <numeric>
 #include <algorithm>
+#include <cfloat>
 #include <stdio.h>
 #include <fstream>
 #include "workload/tpch/dbgen/dss.h"
@@ -219,6 +220,12 @@ void ShoreTPCHEnv::print_throughput(const double iQueriedSF,
  * commit thought. So, they need to be invoked inside a transaction
  * and the caller needs to commit at the end. 
  *
+ * Every row is generated between a row_start() and a row_stop(), so
+ * that it consumes the fixed number of random numbers per row that
+ * dbgen does. Then a loader can row_seek() to any row of a table and
+ * produce the same rows as a serial dbgen run, whatever the slice of
+ * the table it generates.
+ *
  ********************************************************************/
 
 #undef  DO_PRINT_TPCH_RECS
@@ -231,7 +238,9 @@ w_rc_t ShoreTPCHEnv::_gen_one_nation(const int id, rep_row_t& areprow)
     prna->_rep = &areprow;
 
     code_t ac;
+    row_start(NATION);
     mk_nation(id, &ac);
+    row_stop(NATION);
     
 #ifdef DO_PRINT_TPCH_RECS
     TRACE( TRACE_ALWAYS, "%ld,%s,%ld,%s,%d\n",
@@ -254,7 +263,9 @@ w_rc_t ShoreTPCHEnv::_gen_one_region(const int id, rep_row_t& areprow)
     prre->_rep = &areprow;
 
     code_t ac;
+    row_start(REGION);
     mk_region(id, &ac);
+    row_stop(REGION);
 
 #ifdef DO_PRINT_TPCH_RECS
     TRACE( TRACE_ALWAYS, "%ld,%s,%s,%d\n", 
@@ -276,7 +287,9 @@ w_rc_t ShoreTPCHEnv::_gen_one_supplier(const int id, rep_row_t& areprow)
     prsu->_rep = &areprow;
 
     dbgentpch::supplier_t as;
+    row_start(SUPP);
     mk_supp(id, &as);
+    row_stop(SUPP);
     
 #ifdef DO_PRINT_TPCH_RECS
     if (id%100==0) {
@@ -309,7 +322,9 @@ w_rc_t ShoreTPCHEnv::_gen_one_part_based(const int id, rep_row_t& areprow)
 
     // 1. Part
     dbgentpch::part_t ap;
+    row_start(PART_PSUPP);
     mk_part(id, &ap);
+    row_stop(PART_PSUPP);
     
 #ifdef DO_PRINT_TPCH_RECS
     if (id%100==0) {
@@ -366,7 +381,9 @@ w_rc_t ShoreTPCHEnv::_gen_one_cust_based(const int id, rep_row_t& areprow)
 
     // 1. Customer
     dbgentpch::customer_t ac;
+    row_start(CUST);
     mk_cust(id, &ac);
+    row_stop(CUST);
     
 #ifdef DO_PRINT_TPCH_RECS        
     if (id%100==0) {
@@ -386,62 +403,77 @@ w_rc_t ShoreTPCHEnv::_gen_one_cust_based(const int id, rep_row_t& areprow)
     prcu->set_value(7, ac.comment);
     W_DO( _pcustomer_man->add_tuple(_pssm, prcu));
 
+    // The orders of customer (id) are rows (id-1)*10+1 .. id*10 of the
+    // orders table
     for (int i=0; i<ORDERS_PER_CUSTOMER; ++i) {
-	// 2. Orders            
-	dbgentpch::order_t ao;
-	mk_order(id*10+i, &ao, 0);
-	
+	// 2. Orders and 3. LineItems
+	W_DO(_gen_one_order((id-1)*ORDERS_PER_CUSTOMER+i+1, 0, pror, prli));
+    }
+
+    return RCOK;
+}
+
+
+// Populates one order, generated by dbgen for the (index) of the
+// (upd_num) update set, and its lineitems
+w_rc_t ShoreTPCHEnv::_gen_one_order(const int index, const long upd_num,
+                                    table_row_t* pror, table_row_t* prli)
+{
+    dbgentpch::order_t ao;
+    row_start(ORDER_LINE);
+    mk_order(index, &ao, upd_num);
+    row_stop(ORDER_LINE);
+    
 #ifdef DO_PRINT_TPCH_RECS
-	if (id%100==0) {
-	    TRACE( TRACE_ALWAYS, "%ld,%ld,%s,%ld,%s,%s,%s,%ld,%s\n",
-		   ao.okey,ao.custkey,ao.orderstatus,ao.totalprice,
-		   ao.odate,ao.opriority,ao.clerk,ao.spriority,ao.comment); 
-	}
+    if ((index/ORDERS_PER_CUSTOMER)%100==0) {
+	TRACE( TRACE_ALWAYS, "%ld,%ld,%s,%ld,%s,%s,%s,%ld,%s\n",
+	       ao.okey,ao.custkey,ao.orderstatus,ao.totalprice,
+	       ao.odate,ao.opriority,ao.clerk,ao.spriority,ao.comment); 
+    }
 #endif
-	
-	pror->set_value(0, (int)ao.okey);            
-	pror->set_value(1, (int)ao.custkey);
-	pror->set_value(2, ao.orderstatus);
-	pror->set_value(3, (double)ao.totalprice);
-	pror->set_value(4, ao.odate);
-	pror->set_value(5, ao.opriority);
-	pror->set_value(6, ao.clerk);
-	pror->set_value(7, (int)ao.spriority);
-	pror->set_value(8, ao.comment);
-	W_DO(_porders_man->add_tuple(_pssm, pror));
-
-	for (int j=0; j<ao.lines; ++j) {
-	    // 3. LineItem	    
+    
+    pror->set_value(0, (int)ao.okey);            
+    pror->set_value(1, (int)ao.custkey);
+    pror->set_value(2, ao.orderstatus);
+    pror->set_value(3, (double)ao.totalprice);
+    pror->set_value(4, ao.odate);
+    pror->set_value(5, ao.opriority);
+    pror->set_value(6, ao.clerk);
+    pror->set_value(7, (int)ao.spriority);
+    pror->set_value(8, ao.comment);
+    W_DO(_porders_man->add_tuple(_pssm, pror));
+
+    for (int j=0; j<ao.lines; ++j) {
+        // 3. LineItem
 #ifdef DO_PRINT_TPCH_RECS
-	    if (id%100==0) {
-		TRACE(TRACE_ALWAYS,"%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%s,%s,%s,%s,%s,%s,%s,%s\n",
-		      ao.l[j].okey,ao.l[j].partkey,ao.l[j].suppkey,
-		      ao.l[j].lcnt,ao.l[j].quantity,ao.l[j].eprice,
-		      ao.l[j].discount,ao.l[j].tax,
-		      ao.l[j].rflag,ao.l[j].lstatus,
-		      ao.l[j].cdate,ao.l[j].sdate,ao.l[j].rdate,
-		      ao.l[j].shipinstruct,ao.l[j].shipmode,ao.l[j].comment); 
-	    }
+        if ((index/ORDERS_PER_CUSTOMER)%100==0) {
+	    TRACE(TRACE_ALWAYS,"%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%s,%s,%s,%s,%s,%s,%s,%s\n",
+		  ao.l[j].okey,ao.l[j].partkey,ao.l[j].suppkey,
+		  ao.l[j].lcnt,ao.l[j].quantity,ao.l[j].eprice,
+		  ao.l[j].discount,ao.l[j].tax,
+		  ao.l[j].rflag,ao.l[j].lstatus,
+		  ao.l[j].cdate,ao.l[j].sdate,ao.l[j].rdate,
+		  ao.l[j].shipinstruct,ao.l[j].shipmode,ao.l[j].comment); 
+        }
 #endif
-	    
-	    prli->set_value(0, (int)ao.l[j].okey);
-	    prli->set_value(1, (int)ao.l[j].partkey);
-	    prli->set_value(2, (int)ao.l[j].suppkey);
-	    prli->set_value(3, (int)ao.l[j].lcnt);
-	    prli->set_value(4, (double)ao.l[j].quantity);
-	    prli->set_value(5, (double)ao.l[j].eprice);
-	    prli->set_value(6, (double)ao.l[j].discount);
-	    prli->set_value(7, (double)ao.l[j].tax);
-	    prli->set_value(8, ao.l[j].rflag);
-	    prli->set_value(9, ao.l[j].lstatus);
-	    prli->set_value(10, ao.l[j].cdate);
-	    prli->set_value(11, ao.l[j].sdate);
-	    prli->set_value(12, ao.l[j].rdate);
-	    prli->set_value(13, ao.l[j].shipinstruct);
-	    prli->set_value(14, ao.l[j].shipmode);
-	    prli->set_value(15, ao.l[j].comment);
-	    W_DO(_plineitem_man->add_tuple(_pssm, prli));
-	}
+        
+        prli->set_value(0, (int)ao.l[j].okey);
+        prli->set_value(1, (int)ao.l[j].partkey);
+        prli->set_value(2, (int)ao.l[j].suppkey);
+        prli->set_value(3, (int)ao.l[j].lcnt);
+        prli->set_value(4, (double)ao.l[j].quantity);
+        prli->set_value(5, (double)ao.l[j].eprice);
+        prli->set_value(6, (double)ao.l[j].discount);
+        prli->set_value(7, (double)ao.l[j].tax);
+        prli->set_value(8, ao.l[j].rflag);
+        prli->set_value(9, ao.l[j].lstatus);
+        prli->set_value(10, ao.l[j].sdate);
+        prli->set_value(11, ao.l[j].cdate);
+        prli->set_value(12, ao.l[j].rdate);
+        prli->set_value(13, ao.l[j].shipinstruct);
+        prli->set_value(14, ao.l[j].shipmode);
+        prli->set_value(15, ao.l[j].comment);
+        W_DO(_plineitem_man->add_tuple(_pssm, prli));
     }
 
     return RCOK;
@@ -465,6 +497,14 @@ w_rc_t ShoreTPCHEnv::xct_populate_baseline(const int /* xct_id */,
     rep_row_t areprow(_pcustomer_man->ts());
     areprow.set(_pcustomer_desc->maxsize());
 
+    // 1. Start the streams from the first rows, also when retrying
+    row_seek(NATION, 1);
+    row_seek(REGION, 1);
+    row_seek(SUPP, 1);
+    row_seek(PART_PSUPP, 1);
+    row_seek(CUST, 1);
+    row_seek(ORDER_LINE, 1);
+
     // 2. Build the small tables
     TRACE( TRACE_ALWAYS, "Building NATION !!!\n");    
     for (int i=0; i<NO_NATIONS; ++i) {
@@ -477,23 +517,25 @@ w_rc_t ShoreTPCHEnv::xct_populate_baseline(const int /* xct_id */,
     }
 
     TRACE( TRACE_ALWAYS, "Building SUPPLIER !!!\n");
-    for (int i=0; i<in._sf*SUPPLIER_PER_SF; ++i) {
+    for (int i=1; i<=in._sf*SUPPLIER_PER_SF; ++i) {
         W_DO(_gen_one_supplier(i, areprow));
     }
 
     W_COERCE(_pssm->commit_xct());
     W_COERCE(_pssm->begin_xct());
 
+    long total_parts = (long)(in._sf*PART_PER_SF);
+    long total_custs = (long)(in._sf*CUSTOMER_PER_SF);
+
     // 3. Insert first rows in the Part-based tables
     if (in._loader_count == 1) {
-        int sf=in._sf;
-        int ppsf=PART_PER_SF;
-        TRACE( TRACE_ALWAYS, "Building PARTS and PARTSUPP (%d)!!!\n",sf*ppsf);
+        TRACE( TRACE_ALWAYS, "Building PARTS and PARTSUPP (%ld)!!!\n",
+               total_parts);
         //MA: A simplified version of single threaded build for correctness.
-        int step=in._sf*PART_PER_SF/10;
-        for (int i=0; i<in._sf*PART_PER_SF; ++i) {
+        int step=total_parts/10;
+        for (int i=1; i<=total_parts; ++i) {
             W_DO(_gen_one_part_based(i, areprow));
-            if (i>0 && i%step==0) {
+            if (i%step==0) {
                 TRACE( TRACE_ALWAYS, "PARTS-PARTSUPP(%d\%)!!!\n", 10*i/step);
                 W_COERCE(_pssm->commit_xct());
                 W_COERCE(_pssm->begin_xct());
@@ -502,9 +544,10 @@ w_rc_t ShoreTPCHEnv::xct_populate_baseline(const int /* xct_id */,
     } else {
         TRACE( TRACE_ALWAYS, "Starting PARTS !!!\n");
         for (int i = 0; i < in._loader_count; ++i) {
-            long start = i * in._parts_per_thread;
-            long end = start + in._divisor - 1;
-            TRACE(TRACE_ALWAYS, "Parts %d .. %d\n", start, end);
+            long start = i * in._parts_per_thread + 1;
+            long end = min(start + in._divisor, total_parts + 1);
+            TRACE(TRACE_ALWAYS, "Parts %ld .. %ld\n", start, end-1);
+            row_seek(PART_PSUPP, start);
 	    for (int j = start; j < end; ++j) {
                 W_DO(_gen_one_part_based(j, areprow));
             }
@@ -513,19 +556,18 @@ w_rc_t ShoreTPCHEnv::xct_populate_baseline(const int /* xct_id */,
     
     // 4. Insert first rows in the Customer-based tables
     if (in._loader_count == 1) {
-        int sf=in._sf;
-        int cpsf=CUSTOMER_PER_SF;
-        TRACE( TRACE_ALWAYS,"Building CUSTS, ORDERS, LINEITEM (%d)!!!\n",sf*cpsf);
+        TRACE( TRACE_ALWAYS,"Building CUSTS, ORDERS, LINEITEM (%ld)!!!\n",
+               total_custs);
         //MA: A simplified version of single threaded build for correctness.
-        int step=in._sf*CUSTOMER_PER_SF/10;
-        int step100=in._sf*CUSTOMER_PER_SF/100;
+        int step=total_custs/10;
+        int step100=total_custs/100;
         int current=0;
-        for (int i=0; i<in._sf*CUSTOMER_PER_SF; ++i) {
+        for (int i=1; i<=total_custs; ++i) {
             W_DO(_gen_one_cust_based(i,areprow));
-            if (i>0 && i%step==0) {
-                TRACE(TRACE_ALWAYS,"\nCUSTS-ORDERS-LINEITEM(%d\%)!\n",100*i/step);
+            if (i%step==0) {
+                TRACE(TRACE_ALWAYS,"\nCUSTS-ORDERS-LINEITEM(%d\%)!\n",10*i/step);
             }
-            if (i>0 && i%step100==0) {
+            if (i%step100==0) {
                 W_COERCE(_pssm->commit_xct());
                 W_COERCE(_pssm->begin_xct());
             }
@@ -539,10 +581,12 @@ w_rc_t ShoreTPCHEnv::xct_populate_baseline(const int /* xct_id */,
     } else {
         TRACE( TRACE_ALWAYS, "Starting CUSTS !!!\n");
         for (int i=0; i < in._loader_count; ++i) {
-            long start = i*in._custs_per_thread;
-            long end = start + in._divisor - 1;
-            TRACE( TRACE_ALWAYS, "[%d/%d] Custs %d .. %d\n",
-		   i, in._loader_count, start, end);
+            long start = i*in._custs_per_thread + 1;
+            long end = min(start + in._divisor, total_custs + 1);
+            TRACE( TRACE_ALWAYS, "[%d/%d] Custs %ld .. %ld\n",
+		   i, in._loader_count, start, end-1);
+            row_seek(CUST, start);
+            row_seek(ORDER_LINE, (start-1)*ORDERS_PER_CUSTOMER + 1);
             for (int j=start; j<end; ++j) {
                 W_DO(_gen_one_cust_based(j,areprow));
             }
@@ -567,6 +611,9 @@ w_rc_t ShoreTPCHEnv::xct_populate_some_parts(const int xct_id,
 
     int id = in._partid;
 
+    // Position the streams at the first part, also when retrying
+    row_seek(PART_PSUPP, in._partid);
+
     // Generate (xct_id) parts
     for (id=in._partid; id<in._partid+xct_id; id++) {
         W_DO(_gen_one_part_based(id, areprow));
@@ -590,6 +637,11 @@ w_rc_t ShoreTPCHEnv::xct_populate_some_custs(const int xct_id,
 
     int id = in._custid;
 
+    // Position the streams at the first customer and its first order,
+    // also when retrying
+    row_seek(CUST, in._custid);
+    row_seek(ORDER_LINE, (in._custid-1)*ORDERS_PER_CUSTOMER + 1);
+
     // Generate (xct_id) customers
     for (id=in._custid; id<in._custid+xct_id; id++) {
         W_DO(_gen_one_cust_based(id, areprow));
@@ -600,6 +652,93 @@ w_rc_t ShoreTPCHEnv::xct_populate_some_custs(const int xct_id,
 
 
 
+/******************************************************************** 
+ *
+ * TPC-H Refresh functions
+ *
+ * RF1 inserts new orders, and their lineitems, in the holes that the 
+ * sparse order keys of the population leave (dbgen's first update 
+ * set), and RF2 deletes the same orders again. That way a refresh 
+ * stream leaves the database as it found it and can be repeated.
+ *
+ ********************************************************************/
+
+// dbgen update set of the refresh functions
+static const long RF_UPDATE_SET = 1;
+
+w_rc_t ShoreTPCHEnv::xct_rf1(const int /* xct_id */, rf1_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    tuple_guard<orders_man_impl> pror(_porders_man);
+    tuple_guard<lineitem_man_impl> prli(_plineitem_man);
+
+    rep_row_t areprow(_porders_man->ts());
+    areprow.set(max(_porders_desc->maxsize(), _plineitem_desc->maxsize()));
+    pror->_rep = &areprow;
+    prli->_rep = &areprow;
+
+    // The update sets continue the streams of the orders past the
+    // population, as in dbgen
+    row_seek(ORDER_LINE, tdefs[ORDER_LINE].base*scale + in._first);
+
+    for (int i=in._first; i<in._first+in._count; i++) {
+        W_DO(_gen_one_order(i, RF_UPDATE_SET, pror, prli));
+    }
+    return (RCOK);
+}
+
+
+w_rc_t ShoreTPCHEnv::xct_rf2(const int /* xct_id */, rf2_input_t& in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    tuple_guard<orders_man_impl> pror(_porders_man);
+    tuple_guard<lineitem_man_impl> prli(_plineitem_man);
+
+    rep_row_t areprow(_porders_man->ts());
+    areprow.set(max(_porders_desc->maxsize(), _plineitem_desc->maxsize()));
+    pror->_rep = &areprow;
+    prli->_rep = &areprow;
+
+    for (int i=in._first; i<in._first+in._count; i++) {
+
+        // the key RF1 gave to the order, as mk_order() does
+        DSS_HUGE okey;
+        mk_sparse(i, &okey, 1 + RF_UPDATE_SET/(10000/arefresh));
+
+        // 1. the lineitems, numbered from 1 
+        for (int line=1; ; line++) {
+            prli->set_value(0, (int)okey);
+            prli->set_value(3, line);
+            w_rc_t e = _plineitem_man->index_probe_forupdate_by_name(_pssm, "L_IDX", prli);
+            if (e.is_error()) {
+                if (e.err_num() == se_TUPLE_NOT_FOUND) break;
+                return (e);
+            }
+            W_DO(_plineitem_man->delete_tuple(_pssm, prli));
+        }
+
+        // 2. the order, unless RF1 never inserted it
+        pror->set_value(0, (int)okey);
+        w_rc_t e = _porders_man->index_probe_forupdate_by_name(_pssm, "O_IDX", pror);
+        if (e.is_error()) {
+            if (e.err_num() == se_TUPLE_NOT_FOUND) continue;
+            return (e);
+        }
+        W_DO(_porders_man->delete_tuple(_pssm, pror));
+    }
+    return (RCOK);
+}
+
+
+
 /******************************************************************** 
  *
  * TPC-H QUERIES (TRXS)
@@ -727,6 +866,12 @@ w_rc_t ShoreTPCHEnv::run_one_xct(Request* prequest)
     case XCT_TPCH_QPARTSUPP:
 	return (run_qpartsupp(prequest));
 
+    case XCT_TPCH_RF1:
+	return (run_rf1(prequest));
+
+    case XCT_TPCH_RF2:
+	return (run_rf2(prequest));
+
     default:
         //assert (0); // UNKNOWN TRX-ID
         TRACE( TRACE_ALWAYS, "Unknown transaction\n");
@@ -783,6 +928,8 @@ DEFINE_TRX(ShoreTPCHEnv,qsupplier);
 DEFINE_TRX(ShoreTPCHEnv,qnation);
 DEFINE_TRX(ShoreTPCHEnv,qregion);
 DEFINE_TRX(ShoreTPCHEnv,qcustomer);
+DEFINE_TRX(ShoreTPCHEnv,rf1);
+DEFINE_TRX(ShoreTPCHEnv,rf2);
 
 
 // uncomment the line below if want to dump (part of) the trx results
@@ -839,6 +986,41 @@ w_rc_t ShoreTPCHEnv::xct_qpartsupp(const int /* xct_id */, qpartsupp_input_t&)
 
 
 
+/******************************************************************** 
+ *
+ * Parallel scans
+ *
+ * Every thread that joins a parallel scan gets its own consumer,
+ * with its own row and its own partial result. The query merges
+ * the partial results after the scan.
+ *
+ ********************************************************************/
+
+template <class TableMan>
+class tpch_scan_consumer_t : public scan_consumer_t
+{
+protected:
+    TableMan*             _pmanager;
+    tuple_guard<TableMan> _prow;
+    rep_row_t             _rep;
+
+    void load(const char* record) {
+        if (!_pmanager->load(_prow, record)) {
+            assert(false); // RC(se_WRONG_DISK_DATA)
+        }
+    }
+
+public:
+    tpch_scan_consumer_t(TableMan* pmanager, table_desc_t* ptable)
+        : _pmanager(pmanager), _prow(pmanager), _rep(pmanager->ts())
+    {
+        _rep.set(ptable->maxsize());
+        _prow->_rep = &_rep;
+    }
+};
+
+
+
 /******************************************************************** 
  *
  * TPC-H Q1
@@ -947,6 +1129,86 @@ struct q1_output_ele_t
 };
 
 
+typedef map<q1_group_by_key_t, q1_group_by_value_t, q1_group_by_comp> q1_result_t;
+
+
+/* Filters lineitem on the shipdate and groups into its own q1_result */
+class q1_lineitem_scan_t : public tpch_scan_consumer_t<lineitem_man_impl>
+{
+    date_t _last_shipdate;
+    tpch_lineitem_tuple _aline;
+
+public:
+    q1_result_t _result;
+
+    q1_lineitem_scan_t(lineitem_man_impl* pmanager, table_desc_t* ptable,
+                       date_t last_shipdate)
+        : tpch_scan_consumer_t<lineitem_man_impl>(pmanager, ptable),
+          _last_shipdate(last_shipdate)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(10, _aline.L_SHIPDATE);
+	if (_aline.L_SHIPDATE > _last_shipdate)
+	    return;
+
+	_prow->get_value(4, _aline.L_QUANTITY);
+	_prow->get_value(5, _aline.L_EXTENDEDPRICE);
+	_prow->get_value(6, _aline.L_DISCOUNT);
+	_prow->get_value(7, _aline.L_TAX);
+	_prow->get_value(8, _aline.L_RETURNFLAG);
+	_prow->get_value(9, _aline.L_LINESTATUS);
+	group();
+    }
+
+    /* the PAX copy of lineitem keeps fields 0..12 in place */
+    void consume_block(const pax_block_t& block) {
+	const date_t* shipdate = block.column<date_t>(10);
+	const double* quantity = block.column<double>(4);
+	const double* price    = block.column<double>(5);
+	const double* discount = block.column<double>(6);
+	const double* tax      = block.column<double>(7);
+	const char*   flag     = block.column<char>(8);
+	const char*   status   = block.column<char>(9);
+	for (uint i=0; i<block.rows(); i++) {
+	    if (shipdate[i] > _last_shipdate)
+		continue;
+	    _aline.L_QUANTITY      = quantity[i];
+	    _aline.L_EXTENDEDPRICE = price[i];
+	    _aline.L_DISCOUNT      = discount[i];
+	    _aline.L_TAX           = tax[i];
+	    _aline.L_RETURNFLAG    = flag[i];
+	    _aline.L_LINESTATUS    = status[i];
+	    group();
+	}
+    }
+
+private:
+
+    void group() {
+	q1_group_by_value_t value;
+	value.sum_qty = _aline.L_QUANTITY;
+	value.sum_base_price = _aline.L_EXTENDEDPRICE;
+	value.sum_disc_price = (_aline.L_EXTENDEDPRICE * (1-_aline.L_DISCOUNT));
+	value.sum_charge = (_aline.L_EXTENDEDPRICE * (1-_aline.L_DISCOUNT) * 
+			    (1+_aline.L_TAX));
+	value.sum_discount = (_aline.L_DISCOUNT);
+	value.count = 1;
+
+	q1_group_by_key_t key(_aline.L_RETURNFLAG, _aline.L_LINESTATUS);
+	q1_result_t::iterator it = _result.find(key);
+	if (it != _result.end()) {
+	    // exists, update 
+	    (*it).second += value;
+	} else {
+	    _result.insert(pair<q1_group_by_key_t,
+			   q1_group_by_value_t>(key, value));
+	}
+    }
+};
+
+
 w_rc_t ShoreTPCHEnv::xct_q1(const int /* xct_id */, q1_input_t& pq1in)
 {
     // ensure a valid environment
@@ -954,16 +1216,6 @@ w_rc_t ShoreTPCHEnv::xct_q1(const int /* xct_id */, q1_input_t& pq1in)
     assert (_initialized);
     assert (_loaded);
 
-    // q1 trx touches 1 tables:
-    // lineitem
-    tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
-
-    // allocate space for lineitem representation
-    rep_row_t areprow(_plineitem_man->ts());
-    areprow.set(_plineitem_desc->maxsize()); 
-
-    prlineitem->_rep = &areprow;
-
     /*
       select
       l_returnflag,
@@ -988,70 +1240,46 @@ w_rc_t ShoreTPCHEnv::xct_q1(const int /* xct_id */, q1_input_t& pq1in)
       l_linestatus;
     */
 
-    /* table scan lineitem */
-    guard< table_scan_iter_impl<lineitem_t> > l_iter;
-    {
-	table_scan_iter_impl<lineitem_t>* tmp_l_iter;
-	W_DO(_plineitem_man->get_iter_for_file_scan(_pssm, tmp_l_iter));
-	l_iter = tmp_l_iter;
-    }
-    
-    bool eof;
-    tpch_lineitem_tuple aline;
-    map<q1_group_by_key_t, q1_group_by_value_t, q1_group_by_comp> q1_result;
-    map<q1_group_by_key_t, q1_group_by_value_t>::iterator it;
-    vector<q1_output_ele_t> q1_output;
-    
     /*
       l_returnflag = 8 l_linestatus = 9 l_quantity = 4
       l_extendedprice = 5 l_discount = 6 l_tax = 7
       l_shipdate = 10
     */
 
-    /*
-      int sum_qty;
-      int sum_base_price;
-      decimal sum_disc_price;
-      decimal sum_charge;
-      decimal sum_discount;
-      int count;
-    */    
-    W_DO(l_iter->next(_pssm, eof, *prlineitem));
-    q1_group_by_value_t value;
-    while (!eof) {
-	prlineitem->get_value(4, aline.L_QUANTITY);
-	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
-	prlineitem->get_value(6, aline.L_DISCOUNT);
-	prlineitem->get_value(7, aline.L_TAX);
-	prlineitem->get_value(8, aline.L_RETURNFLAG);
-	prlineitem->get_value(9, aline.L_LINESTATUS);
-	prlineitem->get_value(10, aline.L_SHIPDATE, 15);
-	
-	time_t the_shipdate = str_to_timet(aline.L_SHIPDATE);
-	
-	if (the_shipdate <= pq1in.l_shipdate) {
-	    q1_group_by_key_t key(aline.L_RETURNFLAG, aline.L_LINESTATUS);
-	    
-	    value.sum_qty = aline.L_QUANTITY;
-	    value.sum_base_price = aline.L_EXTENDEDPRICE;
-	    value.sum_disc_price = (aline.L_EXTENDEDPRICE * (1-aline.L_DISCOUNT));
-	    value.sum_charge = (aline.L_EXTENDEDPRICE * (1-aline.L_DISCOUNT) * 
-				(1+aline.L_TAX));
-	    value.sum_discount = (aline.L_DISCOUNT);
-	    value.count = 1;
-	    
-	    it = q1_result.find(key);
-	    if (it != q1_result.end()) {
-		// exists, update 
-		(*it).second += value;
+    /* parallel table scan lineitem, one partial group-by per thread */
+    date_t last_shipdate = timet_to_date(pq1in.l_shipdate);
+    scan_consumers_t<q1_lineitem_scan_t> partials;
+    for (int i=0; i<parallel_scan_t::degree(_scan_helpers.get()); i++) {
+	partials.add(new q1_lineitem_scan_t(_plineitem_man, _plineitem_desc.get(),
+					    last_shipdate));
+    }
+    pax_store_t* pax = _plineitem_desc->pax_store();
+    if (pax && pax->is_current()) {
+	parallel_scan_t l_scan(_pssm, pax, _scan_helpers.get());
+	W_DO(l_scan.run(partials.consumers()));
+    }
+    else {
+	zone_range_t range;
+	range.add(10, -DBL_MAX, last_shipdate);
+	parallel_scan_t l_scan(_pssm, _plineitem_desc.get(), range, _scan_helpers.get());
+	W_DO(l_scan.run(partials.consumers()));
+    }
+
+    /* merge */
+    q1_result_t& q1_result = partials[0]->_result;
+    q1_result_t::iterator it;
+    for (uint i=1; i<partials.size(); i++) {
+	for (it = partials[i]->_result.begin(); it != partials[i]->_result.end(); it++) {
+	    q1_result_t::iterator mine = q1_result.find((*it).first);
+	    if (mine != q1_result.end()) {
+		(*mine).second += (*it).second;
 	    } else {
-		q1_result.insert(pair<q1_group_by_key_t,
-				 q1_group_by_value_t>(key, value));
+		q1_result.insert(*it);
 	    }
 	}
-	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
     
+    vector<q1_output_ele_t> q1_output;
     q1_output_ele_t q1_output_ele;
     for (it = q1_result.begin(); it != q1_result.end(); it ++) {
 	q1_output_ele.l_returnflag = (*it).first.return_flag;
@@ -1099,7 +1327,7 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
     assert (_loaded);
 
     //table scan part    
-    map<int, pair< decimal, vector<int>* > > minlist;
+    arena_hash_map_t<int, pair< decimal, vector<int>* > > minlist;
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
     
@@ -1140,7 +1368,7 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
     }
 
     // table scan nation
-    map<int,bool> nationK;
+    arena_hash_set_t<int> nationK;
 
     tuple_guard<nation_man_impl> prnation(_pnation_man);
 
@@ -1164,13 +1392,13 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
 	prnation->get_value(0, anation.N_NATIONKEY);
 	prnation->get_value(2, anation.N_REGIONKEY);
 	if( anation.N_REGIONKEY == q2in.r_name ) {
-	    nationK.insert(pair<int,bool> (anation.N_NATIONKEY,0));
+	    nationK.insert(anation.N_NATIONKEY);
 	}
 	W_DO(n_iter->next(_pssm, eof, *prnation));
     }
     
     //table scan supplier
-    map<int, bool> suppK;
+    arena_hash_set_t<int> suppK;
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -1193,8 +1421,8 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
     while(!eof){
 	prsupp->get_value(0, asupplier.S_SUPPKEY);
 	prsupp->get_value(3, asupplier.S_NATIONKEY);	
-	if( nationK.find(asupplier.S_NATIONKEY) != nationK.end()){
-	    suppK.insert(pair<int,bool>(asupplier.S_SUPPKEY, true));
+	if( nationK.contains(asupplier.S_NATIONKEY)){
+	    suppK.insert(asupplier.S_SUPPKEY);
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
@@ -1223,11 +1451,10 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
 	prpartsupp->get_value(1, apartsupp.PS_SUPPKEY);
 	prpartsupp->get_value(3, apartsupp.PS_SUPPLYCOST);
 	
-	map<int, pair< decimal, vector<int>* > >::iterator pit =  minlist.find
+	arena_hash_map_t<int, pair< decimal, vector<int>* > >::iterator pit =  minlist.find
 	    (apartsupp.PS_PARTKEY);	
-	map<int,bool>::iterator sit = suppK.find(apartsupp.PS_SUPPKEY);
 	
-	if( pit != minlist.end() && sit != suppK.end() ){		
+	if( pit != minlist.end() && suppK.contains(apartsupp.PS_SUPPKEY) ){		
 	    if( pit->second.first > apartsupp.PS_SUPPLYCOST ||
 		pit->second.first == -1){
 		minlist.insert(pair<int, pair< decimal, vector<int>* > >
@@ -1256,10 +1483,10 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
 struct q3_group_by_key_t 
 {
     int l_orderkey;
-    time_t o_orderdate;
+    date_t o_orderdate;
     int o_shippriority;
   
-    q3_group_by_key_t(int okey, time_t date, int shpprrty)
+    q3_group_by_key_t(int okey, date_t date, int shpprrty)
     {
 	l_orderkey = okey;
 	o_orderdate = date;
@@ -1303,10 +1530,10 @@ public:
 
 class q3_order_needed_data{
 public:
-    time_t o_orderdate;
+    date_t o_orderdate;
     int o_shippriority;
 
-    q3_order_needed_data(time_t date, int shpprrty)
+    q3_order_needed_data(date_t date, int shpprrty)
     {
 	o_orderdate = date;
 	o_shippriority = shpprrty;
@@ -1315,6 +1542,88 @@ public:
 
 };
 
+typedef arena_hash_map_t<int, q3_order_needed_data> q3_orders_t;
+typedef map<q3_group_by_key_t, double, q3_group_by_comp> q3_result_t;
+
+/* ORDER BY revenue DESC, o_orderdate */
+struct q3_top_less {
+    typedef pair<q3_group_by_key_t, double> row_t;
+    bool operator() (const row_t& lhs, const row_t& rhs) const
+    {
+        if (lhs.second != rhs.second) return (lhs.second > rhs.second);
+        return (lhs.first.o_orderdate < rhs.first.o_orderdate);
+    }
+};
+
+
+/* Keeps the orders of the selected customers placed before the date */
+class q3_orders_scan_t : public tpch_scan_consumer_t<orders_man_impl>
+{
+    arena_hash_set_t<int>& _custkeys;
+    date_t _current_date;
+    tpch_orders_tuple _anorder;
+
+public:
+    q3_orders_t _ordersdt;
+
+    q3_orders_scan_t(orders_man_impl* pmanager, table_desc_t* ptable,
+                     arena_hash_set_t<int>& custkeys, date_t current_date)
+        : tpch_scan_consumer_t<orders_man_impl>(pmanager, ptable),
+          _custkeys(custkeys), _current_date(current_date)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(0, _anorder.O_ORDERKEY);
+	_prow->get_value(1, _anorder.O_CUSTKEY);
+	_prow->get_value(4, _anorder.O_ORDERDATE);
+	_prow->get_value(7, _anorder.O_SHIPPRIORITY);	
+	date_t the_date = _anorder.O_ORDERDATE;
+	if(_custkeys.contains(_anorder.O_CUSTKEY)
+	    && the_date < _current_date) {		
+	    _ordersdt.insert(pair<int,q3_order_needed_data>
+			     (_anorder.O_ORDERKEY, q3_order_needed_data
+			      (the_date, _anorder.O_SHIPPRIORITY)));
+	}
+    }
+};
+
+
+/* Sums the revenue of the lineitems shipped after the date per order */
+class q3_lineitem_scan_t : public tpch_scan_consumer_t<lineitem_man_impl>
+{
+    q3_orders_t& _ordersdt;
+    date_t _current_date;
+    tpch_lineitem_tuple _aline;
+
+public:
+    q3_result_t _shippingQ;
+
+    q3_lineitem_scan_t(lineitem_man_impl* pmanager, table_desc_t* ptable,
+                       q3_orders_t& ordersdt, date_t current_date)
+        : tpch_scan_consumer_t<lineitem_man_impl>(pmanager, ptable),
+          _ordersdt(ordersdt), _current_date(current_date)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(0, _aline.L_ORDERKEY);
+	_prow->get_value(10, _aline.L_SHIPDATE);
+	if (_aline.L_SHIPDATE <= _current_date)
+	    return;
+	q3_orders_t::iterator tmp = _ordersdt.find(_aline.L_ORDERKEY);
+	if (tmp == _ordersdt.end())
+	    return;
+
+	_prow->get_value(5, _aline.L_EXTENDEDPRICE);
+	_prow->get_value(6, _aline.L_DISCOUNT);	
+	_shippingQ[q3_group_by_key_t(_aline.L_ORDERKEY,
+				     tmp->second.o_orderdate,
+				     tmp->second.o_shippriority)]
+	    += _aline.L_EXTENDEDPRICE * (1-_aline.L_DISCOUNT);
+    }
+};
+
 w_rc_t ShoreTPCHEnv::xct_q3(const int /* xct_id */, q3_input_t&  q3in)
 {
     // ensure a valid environment
@@ -1323,7 +1632,7 @@ w_rc_t ShoreTPCHEnv::xct_q3(const int /* xct_id */, q3_input_t&  q3in)
     assert (_loaded);
 
     //table scan customer
-    map<int,bool> custkeys;
+    arena_hash_set_t<int> custkeys;
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -1349,94 +1658,57 @@ w_rc_t ShoreTPCHEnv::xct_q3(const int /* xct_id */, q3_input_t&  q3in)
 	prcustomer->get_value(6, acust.C_MKTSEGMENT, 10);
 	int seg = str_to_segment(acust.C_MKTSEGMENT);
 	if( seg == q3in.c_segment) {
-	    custkeys.insert(pair<int,bool> (acust.C_CUSTKEY, true));
+	    custkeys.insert(acust.C_CUSTKEY);
 	}
 	W_DO(c_iter->next(_pssm, eof, *prcustomer));
     }
 
-    //table scan orders
-    int c =0 ;
-    map<int, q3_order_needed_data> ordersdt;
-
-    tuple_guard<orders_man_impl> prorder(_porders_man);
-    
-    rep_row_t o_areprow(_porders_man->ts());
-    o_areprow.set(_porders_desc->maxsize());
-    
-    prorder->_rep = &o_areprow;
+    //parallel table scan orders
+    date_t current_date = timet_to_date(q3in.current_date);
+    int const degree = parallel_scan_t::degree(_scan_helpers.get());
 
-    guard< table_scan_iter_impl<orders_t> > o_iter;
+    scan_consumers_t<q3_orders_scan_t> o_partials;
+    for (int i=0; i<degree; i++) {
+	o_partials.add(new q3_orders_scan_t(_porders_man, _porders_desc.get(),
+					    custkeys, current_date));
+    }
     {
-	table_scan_iter_impl<orders_t>* tmp_o_iter;
-	W_DO(_porders_man->get_iter_for_file_scan(_pssm, tmp_o_iter));
-	o_iter = tmp_o_iter;
+	parallel_scan_t o_scan(_pssm, _porders_desc.get(), _scan_helpers.get());
+	W_DO(o_scan.run(o_partials.consumers()));
     }
 
-    tpch_orders_tuple anorder;
-    
-    W_DO(o_iter->next(_pssm, eof, *prorder));
-	
-    while(!eof){
-	c++;
-	prorder->get_value(0, anorder.O_ORDERKEY);
-	prorder->get_value(1, anorder.O_CUSTKEY);
-	prorder->get_value(4, anorder.O_ORDERDATE, 15);
-	prorder->get_value(7, anorder.O_SHIPPRIORITY);	
-	time_t the_date = str_to_timet(anorder.O_ORDERDATE);
-	if(custkeys.find(anorder.O_CUSTKEY) != custkeys.end()
-	    && the_date < q3in.current_date) {		
-	    ordersdt.insert(pair<int,q3_order_needed_data>
-			    (anorder.O_ORDERKEY, q3_order_needed_data
-			     (the_date, anorder.O_SHIPPRIORITY)));
-	}
-	W_DO(o_iter->next(_pssm, eof, *prorder));
+    q3_orders_t& ordersdt = o_partials[0]->_ordersdt;
+    for (uint i=1; i<o_partials.size(); i++) {
+	ordersdt.insert(o_partials[i]->_ordersdt.begin(),
+			o_partials[i]->_ordersdt.end());
     }
     
-    //table scan lineitem
-    map<q3_group_by_key_t, double, q3_group_by_comp> shippingQ;
-
-    tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
-
-    rep_row_t alreprow(_plineitem_man->ts());
-    alreprow.set(_plineitem_desc->maxsize()); 
-
-    prlineitem->_rep = &alreprow;
-    
-    guard< table_scan_iter_impl<lineitem_t> > l_iter;
+    //parallel table scan lineitem
+    scan_consumers_t<q3_lineitem_scan_t> l_partials;
+    for (int i=0; i<degree; i++) {
+	l_partials.add(new q3_lineitem_scan_t(_plineitem_man, _plineitem_desc.get(),
+					      ordersdt, current_date));
+    }
     {
-	table_scan_iter_impl<lineitem_t>* tmp_l_iter;
-	W_DO(_plineitem_man->get_iter_for_file_scan(_pssm, tmp_l_iter));
-	l_iter = tmp_l_iter;
+	parallel_scan_t l_scan(_pssm, _plineitem_desc.get(), _scan_helpers.get());
+	W_DO(l_scan.run(l_partials.consumers()));
     }
-    
-    tpch_lineitem_tuple aline;
 
-    W_DO(l_iter->next(_pssm, eof, *prlineitem));
-    
-    while (!eof) {
-	prlineitem->get_value(0, aline.L_ORDERKEY);
-	prlineitem->get_value(10, aline.L_SHIPDATE, 15);
-	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
-	prlineitem->get_value(6, aline.L_DISCOUNT);	
-	time_t the_shipdate = str_to_timet(aline.L_SHIPDATE);	
-	map<int, q3_order_needed_data>::iterator tmp =
-	    ordersdt.find(aline.L_ORDERKEY);
-	if(tmp != ordersdt.end() && the_shipdate > q3in.current_date ){
-	    map<q3_group_by_key_t, double, q3_group_by_comp>::iterator tmp2 = 
-		shippingQ.find(q3_group_by_key_t(aline.L_ORDERKEY,
-						 tmp->second.o_orderdate,
-						 tmp->second.o_shippriority));
-	    double  sum = aline.L_EXTENDEDPRICE * (1-aline.L_DISCOUNT);
-	    if(tmp2 != shippingQ.end()){
-		sum += tmp2->second; 
-	    }
-	    shippingQ.insert(pair<q3_group_by_key_t, double >
-			     (q3_group_by_key_t(aline.L_ORDERKEY,
-						tmp->second.o_orderdate,
-						tmp->second.o_shippriority),sum));
+    q3_result_t& shippingQ = l_partials[0]->_shippingQ;
+    for (uint i=1; i<l_partials.size(); i++) {
+	for (q3_result_t::iterator it = l_partials[i]->_shippingQ.begin();
+	     it != l_partials[i]->_shippingQ.end(); it++) {
+	    shippingQ[(*it).first] += (*it).second;
 	}
-	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
+
+    // LIMIT 10
+    top_n_t<q3_top_less::row_t, q3_top_less> top10(10);
+    for (q3_result_t::iterator it = shippingQ.begin(); it != shippingQ.end(); it++) {
+	top10.insert(*it);
+    }
+    vector<q3_top_less::row_t> result;
+    top10.sorted(result);
     
     return RCOK;
 }
@@ -1463,7 +1735,7 @@ w_rc_t ShoreTPCHEnv::xct_q4(const int /* xct_id */, q4_input_t&  in)
     assert (_loaded);
 
     //phase one: Index Seek Orders(OrderDate)
-    map<int, int> forder_prio; //filtered order + priority
+    arena_hash_map_t<int, int> forder_prio; //filtered order + priority
     
     //we need to touch table orders
     tuple_guard<orders_man_impl> prorders(_porders_man);
@@ -1511,7 +1783,7 @@ w_rc_t ShoreTPCHEnv::xct_q4(const int /* xct_id */, q4_input_t&  in)
     }
     
     //phase two: file Scan Lineitem
-    map<int,int> priority_count;
+    arena_hash_map_t<int,int> priority_count;
     for( int i = 0; i < 5; i++) {
 	priority_count.insert(pair<int,int>(i,0));
     }
@@ -1537,11 +1809,11 @@ w_rc_t ShoreTPCHEnv::xct_q4(const int /* xct_id */, q4_input_t&  in)
     
     while (!eof) {
 	prlineitem->get_value(0, aline.L_ORDERKEY);
-	prlineitem->get_value(11, aline.L_COMMITDATE, 15);
-	prlineitem->get_value(12, aline.L_RECEIPTDATE, 15);	
-	time_t the_commitdate = str_to_timet(aline.L_COMMITDATE);
-	time_t the_receiptdate = str_to_timet(aline.L_RECEIPTDATE);	
-	map<int,int>::iterator tmp;	
+	prlineitem->get_value(11, aline.L_COMMITDATE);
+	prlineitem->get_value(12, aline.L_RECEIPTDATE);	
+	date_t the_commitdate = aline.L_COMMITDATE;
+	date_t the_receiptdate = aline.L_RECEIPTDATE;	
+	arena_hash_map_t<int,int>::iterator tmp;	
 	if((tmp = forder_prio.find(aline.L_ORDERKEY)) != forder_prio.end() &&
 	   the_commitdate < the_receiptdate){
 	    int c =priority_count.find(tmp->second)->second;
@@ -1563,6 +1835,80 @@ w_rc_t ShoreTPCHEnv::xct_q4(const int /* xct_id */, q4_input_t&  in)
  *
  ********************************************************************/
 
+/* Keeps the orders of the year placed by customers of the region */
+class q5_orders_scan_t : public tpch_scan_consumer_t<orders_man_impl>
+{
+    arena_hash_map_t<int,int>& _customer_nation;
+    date_t _first_date;
+    date_t _last_date;
+    tpch_orders_tuple _anorder;
+
+public:
+    arena_hash_map_t<int,int> _ordersK_cust;
+
+    q5_orders_scan_t(orders_man_impl* pmanager, table_desc_t* ptable,
+                     arena_hash_map_t<int,int>& customer_nation,
+                     date_t first_date, date_t last_date)
+        : tpch_scan_consumer_t<orders_man_impl>(pmanager, ptable),
+          _customer_nation(customer_nation),
+          _first_date(first_date), _last_date(last_date)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(0, _anorder.O_ORDERKEY);
+	_prow->get_value(1, _anorder.O_CUSTKEY);
+	_prow->get_value(4, _anorder.O_ORDERDATE);
+	date_t orderT = _anorder.O_ORDERDATE;
+	if( _customer_nation.find(_anorder.O_CUSTKEY) != _customer_nation.end() &&
+	    (orderT >= _first_date && orderT < _last_date)) {
+	    _ordersK_cust.insert(pair<int,int> (_anorder.O_ORDERKEY,
+						_anorder.O_CUSTKEY));
+	}
+    }
+};
+
+
+/* Sums the revenue per nation of the lineitems whose customer and
+   supplier are from the same nation */
+class q5_lineitem_scan_t : public tpch_scan_consumer_t<lineitem_man_impl>
+{
+    arena_hash_map_t<int,int>& _supp_nation;
+    arena_hash_map_t<int,int>& _ordersK_cust;
+    arena_hash_map_t<int,int>& _customer_nation;
+    tpch_lineitem_tuple _aline;
+
+public:
+    arena_hash_map_t<int,double> _nation_rev;
+
+    q5_lineitem_scan_t(lineitem_man_impl* pmanager, table_desc_t* ptable,
+                       arena_hash_map_t<int,int>& supp_nation, arena_hash_map_t<int,int>& ordersK_cust,
+                       arena_hash_map_t<int,int>& customer_nation)
+        : tpch_scan_consumer_t<lineitem_man_impl>(pmanager, ptable),
+          _supp_nation(supp_nation), _ordersK_cust(ordersK_cust),
+          _customer_nation(customer_nation)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(0, _aline.L_ORDERKEY);
+	_prow->get_value(2, _aline.L_SUPPKEY);
+	arena_hash_map_t<int,int>::iterator suppiter = _supp_nation.find(_aline.L_SUPPKEY);
+	arena_hash_map_t<int,int>::iterator orderiter = _ordersK_cust.find(_aline.L_ORDERKEY);
+	if(orderiter != _ordersK_cust.end() && suppiter != _supp_nation.end()){
+	    arena_hash_map_t<int,int>::iterator custiter =
+		_customer_nation.find(orderiter->second);
+	    if(custiter != _customer_nation.end()
+	       && custiter->second == suppiter->second){
+		_prow->get_value(5, _aline.L_EXTENDEDPRICE);
+		_prow->get_value(6, _aline.L_DISCOUNT);
+		double price = ( 1 - _aline.L_DISCOUNT)*_aline.L_EXTENDEDPRICE;
+		_nation_rev[custiter->second] += price;
+	    }
+	}
+    }
+};
+
 w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
 {
     // ensure a valid environment
@@ -1570,7 +1916,7 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
     assert (_initialized);
     assert (_loaded);
 
-    map<int, double> nation_rev;
+    arena_hash_map_t<int, double> nation_rev;
 
     tuple_guard<nation_man_impl> prnation(_pnation_man);
 
@@ -1601,7 +1947,7 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
     }
 
     //table scan customer : c_nationkey in nation_rev    
-    map<int, int> customer_nation;
+    arena_hash_map_t<int, int> customer_nation;
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -1631,53 +1977,35 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
 	W_DO(c_iter->next(_pssm, eof, *prcustomer));
     }
 
-    //index scan on orderdate
-    map<int, int> ordersK_cust;
-
-    tuple_guard<orders_man_impl> prorders(_porders_man);
-
-    rep_row_t aoreprow(_porders_man->ts());
-    aoreprow.set(_porders_desc->maxsize());
-
-    prorders->_rep = & aoreprow;
-
-    rep_row_t lowrep(_porders_man->ts());
-    rep_row_t highrep(_porders_man->ts());
-
-    lowrep.set(_porders_desc->maxsize());
-    highrep.set(_porders_desc->maxsize());
-
+    //parallel table scan orders
     struct tm date = (*localtime(&q5in.o_orderdate));
     
     date.tm_year += 1;
 	
     time_t last_orderdate = mktime(&date);
-    
-    tpch_orders_tuple anorder;
-    
-    guard< table_scan_iter_impl<orders_t> > o_iter;
+    date_t first_date = timet_to_date(q5in.o_orderdate);
+    date_t last_date  = timet_to_date(last_orderdate);
+    int const degree = parallel_scan_t::degree(_scan_helpers.get());
+
+    scan_consumers_t<q5_orders_scan_t> o_partials;
+    for (int i=0; i<degree; i++) {
+	o_partials.add(new q5_orders_scan_t(_porders_man, _porders_desc.get(),
+					    customer_nation,
+					    first_date, last_date));
+    }
     {
-	table_scan_iter_impl<orders_t>* tmp_o_iter;
-	W_DO(_porders_man->get_iter_for_file_scan(_pssm, tmp_o_iter));
-	o_iter = tmp_o_iter;
+	parallel_scan_t o_scan(_pssm, _porders_desc.get(), _scan_helpers.get());
+	W_DO(o_scan.run(o_partials.consumers()));
     }
 
-    W_DO(o_iter->next(_pssm, eof, *prorders));
-    while(!eof){
-	prorders->get_value(0, anorder.O_ORDERKEY);
-	prorders->get_value(1, anorder.O_CUSTKEY);
-	prorders->get_value(4, anorder.O_ORDERDATE, 15);
-	time_t orderT = str_to_timet(anorder.O_ORDERDATE);
-	if( customer_nation.find(anorder.O_CUSTKEY) != customer_nation.end() &&
-	    (orderT >= q5in.o_orderdate && orderT < last_orderdate)) {
-	    ordersK_cust.insert(pair<int,int> (anorder.O_ORDERKEY,
-					       anorder.O_CUSTKEY));
-	}
-	W_DO(o_iter->next(_pssm, eof, *prorders));
+    arena_hash_map_t<int, int>& ordersK_cust = o_partials[0]->_ordersK_cust;
+    for (uint i=1; i<o_partials.size(); i++) {
+	ordersK_cust.insert(o_partials[i]->_ordersK_cust.begin(),
+			    o_partials[i]->_ordersK_cust.end());
     }
     
     //supplier
-    map<int,int> supp_nation;
+    arena_hash_map_t<int,int> supp_nation;
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -1707,45 +2035,23 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
 
-    // table scan lineitem 
-    tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
-
-    rep_row_t alreprow(_plineitem_man->ts());
-    alreprow.set(_plineitem_desc->maxsize()); 
-
-    prlineitem->_rep = &alreprow;
-
-    guard< table_scan_iter_impl<lineitem_t> > l_iter;
+    // parallel table scan lineitem 
+    scan_consumers_t<q5_lineitem_scan_t> l_partials;
+    for (int i=0; i<degree; i++) {
+	l_partials.add(new q5_lineitem_scan_t(_plineitem_man, _plineitem_desc.get(),
+					      supp_nation, ordersK_cust,
+					      customer_nation));
+    }
     {
-	table_scan_iter_impl<lineitem_t>* tmp_l_iter;
-	W_DO(_plineitem_man->get_iter_for_file_scan(_pssm, tmp_l_iter));
-	l_iter = tmp_l_iter;
+	parallel_scan_t l_scan(_pssm, _plineitem_desc.get(), _scan_helpers.get());
+	W_DO(l_scan.run(l_partials.consumers()));
     }
-            
-    tpch_lineitem_tuple aline;
-    
-    W_DO(l_iter->next(_pssm, eof, *prlineitem));
-	
-    while (!eof) {
-	prlineitem->get_value(0, aline.L_ORDERKEY);
-	prlineitem->get_value(2, aline.L_SUPPKEY);
-	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
-	prlineitem->get_value(6, aline.L_DISCOUNT);
-	double price = ( 1 - aline.L_DISCOUNT)*aline.L_EXTENDEDPRICE;
-	map<int,int>::iterator suppiter = supp_nation.find(aline.L_SUPPKEY);
-	map<int,int>::iterator orderiter = ordersK_cust.find(aline.L_ORDERKEY);
-	if(orderiter != ordersK_cust.end() && suppiter != supp_nation.end()){
-	    map<int,int>::iterator custiter =
-		customer_nation.find(orderiter->second);
-	    if(custiter != customer_nation.end()
-	       && custiter->second == suppiter->second){
-		int nationKey = custiter->second;
-		double c =nation_rev.find(nationKey)->second;
-		c += price;
-		nation_rev[nationKey] = c;
-	    }
+
+    for (uint i=0; i<l_partials.size(); i++) {
+	for (arena_hash_map_t<int,double>::iterator it = l_partials[i]->_nation_rev.begin();
+	     it != l_partials[i]->_nation_rev.end(); it++) {
+	    nation_rev[(*it).first] += (*it).second;
 	}
-	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
 
     return RCOK;
@@ -1761,6 +2067,59 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
 
 // l_extendedprice l_discount l_shipdate l_quantity
 
+/* Sums the discounted revenue of the lineitems of the year */
+class q6_lineitem_scan_t : public tpch_scan_consumer_t<lineitem_man_impl>
+{
+    date_t _first_date;
+    date_t _last_date;
+    double _discount;
+    double _quantity;
+    tpch_lineitem_tuple _aline;
+
+public:
+    double _revenue;
+
+    q6_lineitem_scan_t(lineitem_man_impl* pmanager, table_desc_t* ptable,
+                       date_t first_date, date_t last_date,
+                       double discount, double quantity)
+        : tpch_scan_consumer_t<lineitem_man_impl>(pmanager, ptable),
+          _first_date(first_date), _last_date(last_date),
+          _discount(discount), _quantity(quantity), _revenue(0)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(10, _aline.L_SHIPDATE);
+	if ((_aline.L_SHIPDATE < _first_date) || (_aline.L_SHIPDATE >= _last_date))
+	    return;
+	_prow->get_value(4, _aline.L_QUANTITY);
+	_prow->get_value(5, _aline.L_EXTENDEDPRICE);
+	_prow->get_value(6, _aline.L_DISCOUNT);
+	if ((_aline.L_DISCOUNT > _discount - 0.01) &&
+	    (_aline.L_DISCOUNT < _discount + 0.01) &&
+	    (_aline.L_QUANTITY < _quantity)) {
+	    _revenue += (_aline.L_EXTENDEDPRICE * _aline.L_DISCOUNT);
+	}
+    }
+
+    /* the PAX copy of lineitem keeps fields 0..12 in place */
+    void consume_block(const pax_block_t& block) {
+	const date_t* shipdate = block.column<date_t>(10);
+	const double* quantity = block.column<double>(4);
+	const double* price    = block.column<double>(5);
+	const double* discount = block.column<double>(6);
+	double const disc_lo = _discount - 0.01;
+	double const disc_hi = _discount + 0.01;
+	for (uint i=0; i<block.rows(); i++) {
+	    if ((shipdate[i] >= _first_date) && (shipdate[i] < _last_date) &&
+		(discount[i] > disc_lo) && (discount[i] < disc_hi) &&
+		(quantity[i] < _quantity)) {
+		_revenue += (price[i] * discount[i]);
+	    }
+	}
+    }
+};
+
 w_rc_t ShoreTPCHEnv::xct_q6(const int /* xct_id */, q6_input_t& pq6in)
 {
     // ensure a valid environment
@@ -1769,12 +2128,6 @@ w_rc_t ShoreTPCHEnv::xct_q6(const int /* xct_id */, q6_input_t& pq6in)
     assert (_loaded);
 
     // q6 trx touches 1 tables: lineitem
-    tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
-
-    rep_row_t areprow(_plineitem_man->ts());
-    areprow.set(_plineitem_desc->maxsize()); 
-
-    prlineitem->_rep = &areprow;
     
     //       select
     //       sum(l_extendedprice*l_discount) as revenue
@@ -1786,47 +2139,40 @@ w_rc_t ShoreTPCHEnv::xct_q6(const int /* xct_id */, q6_input_t& pq6in)
     //       and l_discount between [DISCOUNT] - 0.01 and [DISCOUNT] + 0.01
     //       and l_quantity < [QUANTITY]
 	
-    // index scan on shipdate
-    rep_row_t lowrep(_plineitem_man->ts());
-    rep_row_t highrep(_plineitem_man->ts());
-
-    lowrep.set(_plineitem_desc->maxsize());
-    highrep.set(_plineitem_desc->maxsize());
-
+    // parallel table scan lineitem
     struct tm date;    
     if (gmtime_r(&(pq6in.l_shipdate), &date) == NULL) {
 	return RCOK;
     }
     date.tm_year ++;
     time_t last_shipdate = mktime(&date);
-    
-    guard< index_scan_iter_impl<lineitem_t> > l_iter;
-    {
-	index_scan_iter_impl<lineitem_t>* tmp_l_iter;
-	W_DO(_plineitem_man->l_get_range_iter_by_index(_pssm, tmp_l_iter,
-						       prlineitem, lowrep,
-						       highrep, pq6in.l_shipdate,
-						       last_shipdate));
-	l_iter = tmp_l_iter;
+    date_t first_date = timet_to_date(pq6in.l_shipdate);
+    date_t last_date  = timet_to_date(last_shipdate);
+
+    scan_consumers_t<q6_lineitem_scan_t> partials;
+    int const degree = parallel_scan_t::degree(_scan_helpers.get());
+    for (int i=0; i<degree; i++) {
+	partials.add(new q6_lineitem_scan_t(_plineitem_man, _plineitem_desc.get(),
+					    first_date, last_date,
+					    pq6in.l_discount, pq6in.l_quantity));
+    }
+    pax_store_t* pax = _plineitem_desc->pax_store();
+    if (pax && pax->is_current()) {
+	parallel_scan_t l_scan(_pssm, pax, _scan_helpers.get());
+	W_DO(l_scan.run(partials.consumers()));
+    }
+    else {
+	zone_range_t range;
+	range.add(10, first_date, last_date - 1)
+	    .add(6, pq6in.l_discount - 0.01, pq6in.l_discount + 0.01)
+	    .add(4, -DBL_MAX, pq6in.l_quantity);
+	parallel_scan_t l_scan(_pssm, _plineitem_desc.get(), range, _scan_helpers.get());
+	W_DO(l_scan.run(partials.consumers()));
     }
 
-    bool eof;
-    tpch_lineitem_tuple aline;
     double q6_result = 0;
-
-    W_DO(l_iter->next(_pssm, eof, *prlineitem));
-
-    while (!eof) {
-	prlineitem->get_value(4, aline.L_QUANTITY);
-	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
-	prlineitem->get_value(6, aline.L_DISCOUNT);
-	prlineitem->get_value(10, aline.L_SHIPDATE, 15);	
-	if ((aline.L_DISCOUNT > pq6in.l_discount - 0.01) &&
-	    (aline.L_DISCOUNT < pq6in.l_discount + 0.01) &&
-	    (aline.L_QUANTITY < pq6in.l_quantity)) {
-	    q6_result += (aline.L_EXTENDEDPRICE * aline.L_DISCOUNT);
-	}
-	W_DO(l_iter->next(_pssm, eof, *prlineitem));
+    for (uint i=0; i<partials.size(); i++) {
+	q6_result += partials[i]->_revenue;
     }
 
     return RCOK;
@@ -1896,7 +2242,7 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
     assert (_loaded);
 
     // table scan customer c_nationkey = n_name1, n_name2
-    map<int,int> cust_nationK;
+    arena_hash_map_t<int,int> cust_nationK;
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -1927,7 +2273,7 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
     }
 
     //table scan order o_customerkey in customer_nationK
-    map<int,int> orderk_custk;
+    arena_hash_map_t<int,int> orderk_custk;
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
     
@@ -1958,7 +2304,7 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
     }
 
     //table scan supplier : s_nationkey = n_name1 s_nationkey = n_name2
-    map<int,int> supp_nationk;
+    arena_hash_map_t<int,int> supp_nationk;
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -2027,18 +2373,18 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
 	prlineitem->get_value(2, aline.L_SUPPKEY);
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
-	prlineitem->get_value(10, aline.L_SHIPDATE, 15);
+	prlineitem->get_value(10, aline.L_SHIPDATE);
 	    
-	time_t shipdate = str_to_timet(aline.L_SHIPDATE);
-	struct tm date = (*localtime(&shipdate));
+	/* years since 1900, like struct tm */
+	int ship_year = date_year(aline.L_SHIPDATE) - 1900;
 	double price = aline.L_EXTENDEDPRICE*(1- aline.L_DISCOUNT);
 
-	map<int,int>:: iterator order = orderk_custk.find(aline.L_ORDERKEY);
-	map<int,int>:: iterator supp = supp_nationk.find(aline.L_SUPPKEY);
-	map<int,int>:: iterator cust;
+	arena_hash_map_t<int,int>:: iterator order = orderk_custk.find(aline.L_ORDERKEY);
+	arena_hash_map_t<int,int>:: iterator supp = supp_nationk.find(aline.L_SUPPKEY);
+	arena_hash_map_t<int,int>:: iterator cust;
 	
 	if(order != orderk_custk.end() && supp != supp_nationk.end() &&
-	   date.tm_year <= 96 && date.tm_year >= 95){
+	   ship_year <= 96 && ship_year >= 95){
 	    
 	    cust = cust_nationK.find(order->second);
 
@@ -2047,7 +2393,7 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
 		    map<q7_group_by_key_t, double, q7_group_by_comp>::iterator it=
 			vol_shipping.find(q7_group_by_key_t(supp->second,
 							    cust->second,
-							    date.tm_year));
+							    ship_year));
 		    if( it != vol_shipping.end()){
 			double c = it->second;
 			c +=  price;
@@ -2055,12 +2401,12 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
 					    double>
 					    (q7_group_by_key_t(supp->second,
 							       cust->second,
-							       date.tm_year), c));
+							       ship_year), c));
 		    } else {
 			vol_shipping.insert(pair<q7_group_by_key_t, double>
 					    (q7_group_by_key_t(supp->second,
 							       cust->second,
-							       date.tm_year),
+							       ship_year),
 					     price));
 		    }
 		} 
@@ -2115,7 +2461,7 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
 
     //retrive r_key of q8in.n_name
     int r_key;
-    map<int, bool> nation_k;
+    arena_hash_set_t<int> nation_k;
 
     tuple_guard<nation_man_impl> prnation(_pnation_man);
    
@@ -2145,13 +2491,13 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
 	prnation->get_value(2, anation.N_REGIONKEY);
 	prnation->get_value(0, anation.N_NATIONKEY);
 	if(anation.N_REGIONKEY == r_key) {
-	    nation_k.insert(pair<int,bool>(anation.N_NATIONKEY, true));
+	    nation_k.insert(anation.N_NATIONKEY);
 	}
 	W_DO(n_iter->next(_pssm, eof, *prnation));
     }
 
     //file scan part
-    map<int, bool> p_keys;
+    arena_hash_set_t<int> p_keys;
     char p_type[26];    
     type_to_str(q8in.p_type, p_type);
 
@@ -2177,13 +2523,13 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
 	prpart->get_value(4, apart.P_TYPE, 25);
 	prpart->get_value(0, apart.P_PARTKEY);
 	if( strcmp(apart.P_TYPE, p_type ) == 0  ){
-	    p_keys.insert(pair<int,bool> (apart.P_PARTKEY, true));
+	    p_keys.insert(apart.P_PARTKEY);
 	}
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
 
     //table scan customer
-    map<int, bool> cust_k;
+    arena_hash_set_t<int> cust_k;
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -2206,15 +2552,15 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
     while(!eof){
 	prcustomer->get_value(0, acust.C_CUSTKEY);
 	prcustomer->get_value(3, acust.C_NATIONKEY);
-	if( nation_k.find(acust.C_NATIONKEY) != nation_k.end()){
-	    cust_k.insert(pair<int,bool>(acust.C_CUSTKEY,true));
+	if( nation_k.contains(acust.C_NATIONKEY)){
+	    cust_k.insert(acust.C_CUSTKEY);
 	}
 	W_DO(c_iter->next(_pssm, eof, *prcustomer));
     }
 
     //index scan order
     //we need to touch table orders
-    map<int,int> orders_ky; //orders key and date
+    arena_hash_map_t<int,int> orders_ky; //orders key and date
 
     tuple_guard<orders_man_impl> prorders(_porders_man);
 
@@ -2249,17 +2595,17 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
     while(!eof){
 	prorders->get_value(0, anorder.O_ORDERKEY);
 	prorders->get_value(1, anorder.O_CUSTKEY);
-	prorders->get_value(4, anorder.O_ORDERDATE, 15);
-	time_t t = str_to_timet(anorder.O_ORDERDATE);
-	struct tm date = *(localtime(&t));
-	if( cust_k.find(anorder.O_CUSTKEY) != cust_k.end()) {
-	    orders_ky.insert(pair<int,int>(anorder.O_ORDERKEY, date.tm_year));
+	prorders->get_value(4, anorder.O_ORDERDATE);
+	if( cust_k.contains(anorder.O_CUSTKEY)) {
+	    /* years since 1900, like struct tm */
+	    orders_ky.insert(pair<int,int>(anorder.O_ORDERKEY,
+					   date_year(anorder.O_ORDERDATE) - 1900));
 	}
 	W_DO(o_iter->next(_pssm, eof, *prorders));
     }
 
     //supplier
-    map<int,int> supp_nation;
+    arena_hash_map_t<int,int> supp_nation;
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -2315,9 +2661,8 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	double price = (1-aline.L_DISCOUNT)*aline.L_EXTENDEDPRICE;
-	map<int,bool>:: iterator pit = p_keys.find(aline.L_PARTKEY);
-	map<int,int>::iterator oit = orders_ky.find(aline.L_ORDERKEY);
-	if(pit != p_keys.end() && oit != orders_ky.end()) {
+	arena_hash_map_t<int,int>::iterator oit = orders_ky.find(aline.L_ORDERKEY);
+	if(p_keys.contains(aline.L_PARTKEY) && oit != orders_ky.end()) {
 	    all_nation.push_back(q8_inner_table(aline.L_SUPPKEY,
 						oit->second, price));
 	}
@@ -2390,7 +2735,7 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
     assert (_loaded);
 
     //table scan part_t : p_name contains '%color%'
-    map<int, bool> p_keys;
+    arena_hash_set_t<int> p_keys;
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
 
@@ -2417,13 +2762,13 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
 	    char part_name[55];
 	    pname_to_str(q9in.p_name, part_name);
 	    if(strstr(apart.P_NAME,part_name) != NULL){
-		p_keys.insert(pair<int,bool> ( apart.P_PARTKEY, 0));
+		p_keys.insert(apart.P_PARTKEY);
 	    } 
 	    W_DO(p_iter->next(_pssm, eof, *prpart));
     }
 
     //table scan supplier
-    map<int,int> suppK_nK;
+    arena_hash_map_t<int,int> suppK_nK;
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -2451,7 +2796,7 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
     }
 
     //table scan order
-    map<int,int> orderK_y;
+    arena_hash_map_t<int,int> orderK_y;
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
 
@@ -2473,10 +2818,10 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
 
     while(!eof){
 	prorder->get_value(1, anorder.O_ORDERKEY);
-	prorder->get_value(4, anorder.O_ORDERDATE,15);
-	time_t t = str_to_timet(anorder.O_ORDERDATE);
-	struct tm date = *localtime(&t);
-	orderK_y.insert( pair<int,int> (anorder.O_ORDERKEY, date.tm_year));
+	prorder->get_value(4, anorder.O_ORDERDATE);
+	/* years since 1900, like struct tm */
+	orderK_y.insert( pair<int,int> (anorder.O_ORDERKEY,
+					date_year(anorder.O_ORDERDATE) - 1900));
 	W_DO(o_iter->next(_pssm, eof, *prorder));
     }
         
@@ -2526,9 +2871,9 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
 	decimal price = aline.L_EXTENDEDPRICE * (1 - aline.L_DISCOUNT) -
 	    apartsupp.PS_SUPPLYCOST* aline.L_QUANTITY;
 	
-	if( p_keys.find(aline.L_PARTKEY) != p_keys.end() ){		
-	    map<int,int>::iterator oit = orderK_y.find( aline.L_ORDERKEY);
-	    map<int,int>::iterator sit = suppK_nK.find( aline.L_SUPPKEY);
+	if( p_keys.contains(aline.L_PARTKEY) ){		
+	    arena_hash_map_t<int,int>::iterator oit = orderK_y.find( aline.L_ORDERKEY);
+	    arena_hash_map_t<int,int>::iterator sit = suppK_nK.find( aline.L_SUPPKEY);
 	    
 	    if(oit == orderK_y.end() || sit == suppK_nK.end()){
 		W_DO(l_iter->next(_pssm, eof, *prlineitem));
@@ -2596,6 +2941,16 @@ public:
     }
 };
 
+/* ORDER BY revenue DESC, of (revenue, c_custkey) pairs */
+struct q10_top_less {
+    bool operator() (const pair<double,int>& lhs, 
+                     const pair<double,int>& rhs) const
+    {
+        if (lhs.first != rhs.first) return (lhs.first > rhs.first);
+        return (lhs.second < rhs.second);
+    }
+};
+
 
 
 w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
@@ -2612,12 +2967,12 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 	date2.tm_year++;
     }
 
-    time_t t2 = mktime(&date2);
-    time_t t1 = q10in.o_orderdate;
+    date_t t2 = timet_to_date(mktime(&date2));
+    date_t t1 = timet_to_date(q10in.o_orderdate);
     
     // table scan order
-    map<int, vector<int>* > cust_ordersK;
-    map<int, double> orders_price;
+    arena_hash_map_t<int, vector<int>* > cust_ordersK;
+    arena_hash_map_t<int, double> orders_price;
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
     
@@ -2641,11 +2996,11 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
     while(!eof){
 	prorder->get_value(0, anorder.O_ORDERKEY);
 	prorder->get_value(1, anorder.O_CUSTKEY);
-	prorder->get_value(4, anorder.O_ORDERDATE, 15);
-	time_t orderdate = str_to_timet(anorder.O_ORDERDATE);
+	prorder->get_value(4, anorder.O_ORDERDATE);
+	date_t orderdate = anorder.O_ORDERDATE;
 	if(orderdate >= t1 && orderdate < t2){
 	    orders_price.insert(pair<int,double>(anorder.O_ORDERKEY, 0.0));
-	    map<int, vector<int>* >::iterator it =
+	    arena_hash_map_t<int, vector<int>* >::iterator it =
 		cust_ordersK.find(anorder.O_CUSTKEY);
 	    if( it != cust_ordersK.end() ){
 		it->second->push_back(anorder.O_ORDERKEY);
@@ -2683,7 +3038,7 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	double price =  (1 - aline.L_DISCOUNT) * aline.L_EXTENDEDPRICE;
-	map<int,double>::iterator it = orders_price.find(aline.L_ORDERKEY);
+	arena_hash_map_t<int,double>::iterator it = orders_price.find(aline.L_ORDERKEY);
 	if(aline.L_RETURNFLAG == 'R' && it != orders_price.end() ){
 	    double c = it->second;
 	    c += price;
@@ -2700,9 +3055,9 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 
     prcustomer->_rep = &acreprow;
 
-    tpch_customer_tuple acust;
-    map<q10_group_by_key_t, double, q10_group_by_key_comp> customer_rev;
-    map<int, vector<int>* > :: iterator cit = cust_ordersK.begin();
+    // LIMIT 20: only the customers that make it are probed
+    top_n_t<pair<double,int>, q10_top_less> top20(20);
+    arena_hash_map_t<int, vector<int>* > :: iterator cit = cust_ordersK.begin();
 
     while( cit != cust_ordersK.end()){
 	vector<int>::iterator oit = cit->second->begin();
@@ -2711,9 +3066,17 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 	    rev += orders_price.find(*oit)->second;
 	    oit++;
 	}
+	top20.insert(pair<double,int>(rev, cit->first));
+	cit++;
+    }
+    vector<pair<double,int> > top;
+    top20.sorted(top);
+
+    tpch_customer_tuple acust;
+    vector<pair<q10_group_by_key_t, double> > customer_rev;
+    for (uint i=0; i<top.size(); i++) {
 	if((_pcustomer_man->c_index_probe(_pssm, prcustomer,
-					  cit->first)).is_error()) {
-	    cit++;
+					  top[i].second)).is_error()) {
 	    continue;
 	}
 	prcustomer->get_value(1, acust.C_NAME, 25);
@@ -2722,10 +3085,12 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 	prcustomer->get_value(4, acust.C_PHONE, 15);
 	prcustomer->get_value(5, acust.C_ACCTBAL);
 	prcustomer->get_value(2, acust.C_COMMENT, 117);
-	customer_rev[q10_group_by_key_t(cit->first, acust.C_NAME, acust.C_ACCTBAL,
-					acust.C_PHONE, acust.C_NATIONKEY,
-					acust.C_ADDRESS, acust.C_COMMENT)] = rev;
-	cit++;
+	customer_rev.push_back(pair<q10_group_by_key_t, double>
+			       (q10_group_by_key_t(top[i].second, acust.C_NAME,
+						   acust.C_ACCTBAL, acust.C_PHONE,
+						   acust.C_NATIONKEY, acust.C_ADDRESS,
+						   acust.C_COMMENT),
+				top[i].first));
     }
 
     return RCOK;
@@ -2747,7 +3112,7 @@ w_rc_t ShoreTPCHEnv::xct_q11(const int /* xct_id */, q11_input_t& q11in)
     assert (_loaded);
 
     //table scan supplier
-    map<int,bool> suppK;
+    arena_hash_set_t<int> suppK;
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -2772,13 +3137,13 @@ w_rc_t ShoreTPCHEnv::xct_q11(const int /* xct_id */, q11_input_t& q11in)
 	prsupp->get_value(0, asupplier.S_SUPPKEY);
 	prsupp->get_value(3, asupplier.S_NATIONKEY);
 	if( asupplier.S_NATIONKEY == q11in.n_name ) {
-	    suppK.insert(pair<int,bool>(asupplier.S_SUPPKEY,true));
+	    suppK.insert(asupplier.S_SUPPKEY);
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
     
     //table scan partsupp
-    map<int, decimal> partK_val;
+    arena_hash_map_t<int, decimal> partK_val;
     decimal totalval = 0;
 
     tuple_guard<partsupp_man_impl> prpartsupp(_ppartsupp_man);
@@ -2804,8 +3169,8 @@ w_rc_t ShoreTPCHEnv::xct_q11(const int /* xct_id */, q11_input_t& q11in)
 	prpartsupp->get_value(1, apartsupp.PS_SUPPKEY);
 	prpartsupp->get_value(2, apartsupp.PS_AVAILQTY);
 	prpartsupp->get_value(3, apartsupp.PS_SUPPLYCOST);
-	if( suppK.find(apartsupp.PS_SUPPKEY) != suppK.end() ){
-	    map<int,decimal>::iterator pit =partK_val.find(apartsupp.PS_PARTKEY);
+	if( suppK.contains(apartsupp.PS_SUPPKEY) ){
+	    arena_hash_map_t<int,decimal>::iterator pit =partK_val.find(apartsupp.PS_PARTKEY);
 	    decimal c = apartsupp.PS_AVAILQTY * apartsupp.PS_SUPPLYCOST;
 	    totalval += c;
 	    if( pit != partK_val.end()){
@@ -2850,6 +3215,49 @@ w_rc_t ShoreTPCHEnv::xct_q11(const int /* xct_id */, q11_input_t& q11in)
 
 
 
+/* Collects the late lineitems of the two shipmodes received in the year */
+class q12_lineitem_scan_t : public tpch_scan_consumer_t<lineitem_man_impl>
+{
+    date_t _first_date;
+    date_t _last_date;
+    int _shipmode1;
+    int _shipmode2;
+    tpch_lineitem_tuple _aline;
+
+public:
+    vector<pair<int, int> > _orderK_shipmode;
+
+    q12_lineitem_scan_t(lineitem_man_impl* pmanager, table_desc_t* ptable,
+                        date_t first_date, date_t last_date,
+                        int shipmode1, int shipmode2)
+        : tpch_scan_consumer_t<lineitem_man_impl>(pmanager, ptable),
+          _first_date(first_date), _last_date(last_date),
+          _shipmode1(shipmode1), _shipmode2(shipmode2)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(12, _aline.L_RECEIPTDATE);
+	date_t receiptdate = _aline.L_RECEIPTDATE;
+	if ((receiptdate < _first_date) || (receiptdate >= _last_date))
+	    return;
+	_prow->get_value(0, _aline.L_ORDERKEY);
+	_prow->get_value(10, _aline.L_SHIPDATE);
+	_prow->get_value(11, _aline.L_COMMITDATE);
+	_prow->get_value(14, _aline.L_SHIPMODE, 10);
+	date_t shipdate = _aline.L_SHIPDATE;
+	date_t commitdate = _aline.L_COMMITDATE;	
+	int shipmode = str_to_shipmode(_aline.L_SHIPMODE);
+	if(shipmode == _shipmode1 || shipmode == _shipmode2) {
+	    if(commitdate < receiptdate && shipdate < commitdate) {
+		_orderK_shipmode.push_back(pair<int,int>(_aline.L_ORDERKEY,
+							 shipmode));
+	    }
+	}
+    }
+};
+
+
 w_rc_t ShoreTPCHEnv::xct_q12(const int /* xct_id */, q12_input_t& q12in)
 {
     // ensure a valid environment
@@ -2857,67 +3265,41 @@ w_rc_t ShoreTPCHEnv::xct_q12(const int /* xct_id */, q12_input_t& q12in)
     assert (_initialized);
     assert (_loaded);
 
-    //phase one: indexscan lineitem
-   vector<pair<int, int> > orderK_shipmode;
-   map<int, pair<int,int> > shpmd_HLC_LLC; 
+    //phase one: parallel table scan lineitem
+   arena_hash_map_t<int, pair<int,int> > shpmd_HLC_LLC; 
    shpmd_HLC_LLC.insert(pair<int, pair<int,int> >
 			(q12in.l_shipmode1, pair<int,int>(0,0)));
    shpmd_HLC_LLC.insert(pair<int, pair<int,int> >
 			(q12in.l_shipmode2, pair<int,int>(0,0)));
 
-   tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
-
-   rep_row_t areprow(_plineitem_man->ts());
-   areprow.set(_plineitem_desc->maxsize());
-   
-   prlineitem->_rep = &areprow;
-   
-   rep_row_t lowrep(_plineitem_man->ts());
-   rep_row_t highrep(_plineitem_man->ts());
-   
-   lowrep.set(_plineitem_desc->maxsize());
-   highrep.set(_plineitem_desc->maxsize());
-    
    struct tm date;
    if(gmtime_r(&(q12in.l_receiptdate), &date) == NULL){
        return RCOK;
    }
    date.tm_year++;
    time_t last_receiptdate = mktime(&date);
-   
-   guard <index_scan_iter_impl<lineitem_t> >l_iter;
+   date_t first_date = timet_to_date(q12in.l_receiptdate);
+   date_t last_date  = timet_to_date(last_receiptdate);
+
+   scan_consumers_t<q12_lineitem_scan_t> partials;
+   int const degree = parallel_scan_t::degree(_scan_helpers.get());
+   for (int i=0; i<degree; i++) {
+       partials.add(new q12_lineitem_scan_t(_plineitem_man, _plineitem_desc.get(),
+					    first_date, last_date,
+					    q12in.l_shipmode1, q12in.l_shipmode2));
+   }
    {
-       index_scan_iter_impl<lineitem_t>* tmp_l_iter;
-       W_DO(_plineitem_man->
-	    l_get_range_iter_by_receiptdate_index(_pssm, tmp_l_iter, prlineitem,
-						  lowrep, highrep,
-						  q12in.l_receiptdate,
-						  last_receiptdate));
-       l_iter = tmp_l_iter;
+       zone_range_t range;
+       range.add(12, first_date, last_date - 1);
+       parallel_scan_t l_scan(_pssm, _plineitem_desc.get(), range, _scan_helpers.get());
+       W_DO(l_scan.run(partials.consumers()));
    }
 
-   bool eof;
-   tpch_lineitem_tuple aline;
-   
-   W_DO(l_iter->next(_pssm, eof, *prlineitem));
-
-   while(!eof){
-       prlineitem->get_value(0, aline.L_ORDERKEY);
-       prlineitem->get_value(10, aline.L_SHIPDATE, 15);
-       prlineitem->get_value(11, aline.L_COMMITDATE, 15);
-       prlineitem->get_value(12, aline.L_RECEIPTDATE, 15);
-       prlineitem->get_value(14, aline.L_SHIPMODE, 10);
-       time_t shipdate = str_to_timet(aline.L_SHIPDATE);
-       time_t commitdate = str_to_timet(aline.L_COMMITDATE);	
-       time_t receiptdate = str_to_timet(aline.L_RECEIPTDATE);
-       int shipmode = str_to_shipmode(aline.L_SHIPMODE);
-       if(shipmode == q12in.l_shipmode1 || shipmode == q12in.l_shipmode2) {
-	   if(commitdate < receiptdate && shipdate < commitdate) {
-	       orderK_shipmode.push_back(pair<int,int>(aline.L_ORDERKEY,
-						       shipmode));
-	   }
-       }
-       W_DO(l_iter->next(_pssm, eof, *prlineitem));
+   vector<pair<int, int> >& orderK_shipmode = partials[0]->_orderK_shipmode;
+   for (uint i=1; i<partials.size(); i++) {
+       orderK_shipmode.insert(orderK_shipmode.end(),
+			      partials[i]->_orderK_shipmode.begin(),
+			      partials[i]->_orderK_shipmode.end());
    }
 
    //phase2 joining order-lineitem
@@ -3001,7 +3383,7 @@ w_rc_t ShoreTPCHEnv::xct_q13(const int /* xct_id */, q13_input_t& /* in */)
 	c_count desc;*/
     
     //phase 1: list of c_custkey
-    map<int,int> c_orders;
+    arena_hash_map_t<int,int> c_orders((size_t)(CUSTOMERS * get_sf()));
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -3057,12 +3439,12 @@ w_rc_t ShoreTPCHEnv::xct_q13(const int /* xct_id */, q13_input_t& /* in */)
     }
     
     //phase 3: compute scalar
-    map<int, int> o_count_cust;
+    arena_hash_map_t<int, int> o_count_cust;
 
-    for(map<int,int>::iterator iter = c_orders.begin();
+    for(arena_hash_map_t<int,int>::iterator iter = c_orders.begin();
 	iter != c_orders.end();
 	iter++){
-	map<int,int>::iterator tmp = o_count_cust.find(iter->second);
+	arena_hash_map_t<int,int>::iterator tmp = o_count_cust.find(iter->second);
 	if(tmp != o_count_cust.end()){
 	    int c = tmp->second;
 	    c++;
@@ -3083,6 +3465,39 @@ w_rc_t ShoreTPCHEnv::xct_q13(const int /* xct_id */, q13_input_t& /* in */)
  *
  ********************************************************************/
 
+/* Collects the discounted prices per part of the lineitems shipped
+   in the month */
+class q14_lineitem_scan_t : public tpch_scan_consumer_t<lineitem_man_impl>
+{
+    date_t _first_date;
+    date_t _last_date;
+    tpch_lineitem_tuple _aline;
+
+public:
+    arena_hash_map_t<int, vector<float> > _pKey_prices;
+    double _totalrevenue;
+
+    q14_lineitem_scan_t(lineitem_man_impl* pmanager, table_desc_t* ptable,
+                        date_t first_date, date_t last_date)
+        : tpch_scan_consumer_t<lineitem_man_impl>(pmanager, ptable),
+          _first_date(first_date), _last_date(last_date), _totalrevenue(0)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(10, _aline.L_SHIPDATE);
+	if ((_aline.L_SHIPDATE < _first_date) || (_aline.L_SHIPDATE >= _last_date))
+	    return;
+	_prow->get_value(1, _aline.L_PARTKEY);
+	_prow->get_value(5, _aline.L_EXTENDEDPRICE);
+	_prow->get_value(6, _aline.L_DISCOUNT);
+	float theprice = _aline.L_EXTENDEDPRICE *(1 - _aline.L_DISCOUNT);
+	_pKey_prices[_aline.L_PARTKEY].push_back( theprice );
+	_totalrevenue += theprice;
+    }
+};
+
+
 w_rc_t ShoreTPCHEnv::xct_q14(const int /* xct_id */, q14_input_t& q14in)
 {
     // ensure a valid environment
@@ -3090,23 +3505,7 @@ w_rc_t ShoreTPCHEnv::xct_q14(const int /* xct_id */, q14_input_t& q14in)
     assert (_initialized);
     assert (_loaded);
 
-    map<int, vector<float>* > pKey_prices;
-    double totalrevenue = 0;    
-
-    //phase 1: index seek: lineitem
-    tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
-
-    rep_row_t areprow(_plineitem_man->ts());
-    areprow.set(_plineitem_desc->maxsize());
-
-    prlineitem->_rep = &areprow;
-
-    rep_row_t lowrep(_plineitem_man->ts());
-    rep_row_t highrep(_plineitem_man->ts());
-
-    lowrep.set(_plineitem_desc->maxsize());
-    highrep.set(_plineitem_desc->maxsize());
-    
+    //phase 1: parallel table scan lineitem
     struct tm date;
     if(gmtime_r(&(q14in.l_shipdate), &date) == NULL){
 	return RCOK;
@@ -3117,38 +3516,32 @@ w_rc_t ShoreTPCHEnv::xct_q14(const int /* xct_id */, q14_input_t& q14in)
 	date.tm_year ++;
     }	
     time_t last_shipdate = mktime(&date);
+    date_t first_date = timet_to_date(q14in.l_shipdate);
+    date_t last_date  = timet_to_date(last_shipdate);
 
-    guard<index_scan_iter_impl<lineitem_t> > l_iter;
-    {
-	index_scan_iter_impl<lineitem_t>* tmp_l_iter;
-	W_DO(_plineitem_man->l_get_range_iter_by_index(_pssm, tmp_l_iter,
-						       prlineitem, lowrep,
-						       highrep, q14in.l_shipdate,
-						       last_shipdate));
-	l_iter = tmp_l_iter;
+    scan_consumers_t<q14_lineitem_scan_t> partials;
+    int const degree = parallel_scan_t::degree(_scan_helpers.get());
+    for (int i=0; i<degree; i++) {
+	partials.add(new q14_lineitem_scan_t(_plineitem_man, _plineitem_desc.get(),
+					     first_date, last_date));
     }
-
-    bool eof;
-    tpch_lineitem_tuple aline;
-    
-    W_DO(l_iter->next(_pssm, eof, *prlineitem));
-
-    while(!eof){
-	prlineitem->get_value(1, aline.L_PARTKEY);
-	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
-	prlineitem->get_value(6, aline.L_DISCOUNT);
-	float theprice = aline.L_EXTENDEDPRICE *(1 - aline.L_DISCOUNT);
-	map<int, vector<float>*>::iterator pvector =
-	    pKey_prices.find(aline.L_PARTKEY);
-	if( pvector != pKey_prices.end() ){
-	    pvector->second->push_back( theprice );
-	} else {
-	    vector<float>* v = new vector<float>();
-	    v->push_back( theprice );
-	    pKey_prices.insert(pair<int, vector<float>* > (aline.L_PARTKEY, v));
+    {
+	zone_range_t range;
+	range.add(10, first_date, last_date - 1);
+	parallel_scan_t l_scan(_pssm, _plineitem_desc.get(), range, _scan_helpers.get());
+	W_DO(l_scan.run(partials.consumers()));
+    }
+
+    arena_hash_map_t<int, vector<float> >& pKey_prices = partials[0]->_pKey_prices;
+    double totalrevenue = partials[0]->_totalrevenue;
+    for (uint i=1; i<partials.size(); i++) {
+	for (arena_hash_map_t<int, vector<float> >::iterator it =
+		 partials[i]->_pKey_prices.begin();
+	     it != partials[i]->_pKey_prices.end(); it++) {
+	    vector<float>& prices = pKey_prices[(*it).first];
+	    prices.insert(prices.end(), (*it).second.begin(), (*it).second.end());
 	}
-	totalrevenue += theprice;
-	W_DO(l_iter->next(_pssm, eof, *prlineitem));
+	totalrevenue += partials[i]->_totalrevenue;
     }
 	
     //phase 2 :joining part and lineitem tables
@@ -3171,15 +3564,16 @@ w_rc_t ShoreTPCHEnv::xct_q14(const int /* xct_id */, q14_input_t& q14in)
     
     tpch_part_tuple apart;
     
+    bool eof;
     W_DO(p_iter->next(_pssm, eof, *prpart));
 
     while(!eof){
 	prpart->get_value(4, apart.P_TYPE, 25);
 	prpart->get_value(0, apart.P_PARTKEY);
-	map<int,vector<float>* >::iterator temp=pKey_prices.find(apart.P_PARTKEY);
+	arena_hash_map_t<int,vector<float> >::iterator temp=pKey_prices.find(apart.P_PARTKEY);
 	if( strstr(apart.P_TYPE, "PROMO") != NULL && temp != pKey_prices.end() ){
-	    for(int i = 0; i < temp->second->size(); i++ ){
-		promorevenue += ( *( temp->second ) )[i];
+	    for(uint i = 0; i < temp->second.size(); i++ ){
+		promorevenue += temp->second[i];
 	    }
 	}
 	W_DO(p_iter->next(_pssm, eof, *prpart));
@@ -3210,7 +3604,7 @@ w_rc_t ShoreTPCHEnv::xct_q15(const int /* xct_id */, q15_input_t& q15in)
     assert (_initialized);
     assert (_loaded);
 
-    map<int,float> stream_id;
+    arena_hash_map_t<int,float> stream_id((size_t)(SUPPLIERS * get_sf()));
 
     //phase 1 :create the view
     tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
@@ -3258,7 +3652,7 @@ w_rc_t ShoreTPCHEnv::xct_q15(const int /* xct_id */, q15_input_t& q15in)
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	float theprice = aline.L_EXTENDEDPRICE *(1 - aline.L_DISCOUNT);
-	map<int, float>::iterator tmp =  stream_id.find(aline.L_SUPPKEY);
+	arena_hash_map_t<int, float>::iterator tmp =  stream_id.find(aline.L_SUPPKEY);
 	if(tmp != stream_id.end()){
 	    float s = tmp->second;
 	    s += theprice;
@@ -3270,14 +3664,14 @@ w_rc_t ShoreTPCHEnv::xct_q15(const int /* xct_id */, q15_input_t& q15in)
     }
 
     float maxrev = stream_id.begin()->second;
-    for(map<int,float>::iterator iter = stream_id.begin();
+    for(arena_hash_map_t<int,float>::iterator iter = stream_id.begin();
 	iter != stream_id.end();
 	iter++) {
 	if( maxrev < iter->second ) {
 	    maxrev = iter->second;
 	}
     }
-    for(map<int,float>::iterator iter = stream_id.begin();
+    for(arena_hash_map_t<int,float>::iterator iter = stream_id.begin();
 	iter != stream_id.end();
 	iter++) {
 	if(iter->second != maxrev) {
@@ -3295,7 +3689,7 @@ w_rc_t ShoreTPCHEnv::xct_q15(const int /* xct_id */, q15_input_t& q15in)
     
     prsupp->_rep = &sreprow;
     
-    for(map<int,float>::iterator iter = stream_id.begin();
+    for(arena_hash_map_t<int,float>::iterator iter = stream_id.begin();
 	iter != stream_id.end();
 	iter++){
 	_psupplier_man->s_index_probe(_pssm, prsupp, iter->first);
@@ -3351,7 +3745,7 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
     assert (_loaded);
 
     //phase#1 table_scan part
-    map<int, required_type> pKeys_type;
+    arena_hash_map_t<int, required_type> pKeys_type;
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
 
@@ -3395,7 +3789,7 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
     }
 
     //phase#2 table scan supplier
-    map<int,bool> suppkeybl; //supplier's key black list
+    arena_hash_set_t<int> suppkeybl; //supplier's key black list
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -3422,7 +3816,7 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
 	char* p2 = strstr(asupplier.S_COMMENT, "Complaints");
 	if( p1!= NULL && p2 != NULL){
 	    if( p2 - p1 > 0 ) {
-		suppkeybl[asupplier.S_SUPPKEY] = true;
+		suppkeybl.insert(asupplier.S_SUPPKEY);
 	    }
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
@@ -3452,9 +3846,9 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
     while(!eof){
 	prpartsupp->get_value(0, apartsupp.PS_PARTKEY);
 	prpartsupp->get_value(1, apartsupp.PS_SUPPKEY);
-	map<int, required_type>::iterator tmpiter;
+	arena_hash_map_t<int, required_type>::iterator tmpiter;
 	if((tmpiter = pKeys_type.find(apartsupp.PS_PARTKEY))!=pKeys_type.end() &&
-	   suppkeybl.find(apartsupp.PS_SUPPKEY) == suppkeybl.end()){
+	   !suppkeybl.contains(apartsupp.PS_SUPPKEY)){
 	    map<required_type, int, required_type_cmp>::iterator tmpiter2;
 	    if((tmpiter2 = suppcount.find(tmpiter->second))!= suppcount.end()){
 		int c = tmpiter2->second;
@@ -3486,7 +3880,7 @@ w_rc_t ShoreTPCHEnv::xct_q17(const int /* xct_id */, q17_input_t& q17in )
     assert (_loaded);
 
     //phase#1 table scan part
-    map<int, vector<pair<int,int> >* > pKey_lineitems;
+    arena_hash_map_t<int, vector<pair<int,int> >* > pKey_lineitems;
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
 
@@ -3545,7 +3939,7 @@ w_rc_t ShoreTPCHEnv::xct_q17(const int /* xct_id */, q17_input_t& q17in )
 	prlineitem->get_value(1, aline.L_PARTKEY);
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(4, aline.L_QUANTITY);
-	map<int, vector<pair<int,int> >* >::iterator tmpiter;
+	arena_hash_map_t<int, vector<pair<int,int> >* >::iterator tmpiter;
 	tmpiter = pKey_lineitems.find(aline.L_PARTKEY);
 	if(tmpiter != pKey_lineitems.end()){
 	    tmpiter->second->push_back(pair<int,int>
@@ -3556,7 +3950,7 @@ w_rc_t ShoreTPCHEnv::xct_q17(const int /* xct_id */, q17_input_t& q17in )
 
     //phase#3 compute the scalar
     double sum = 0;
-    for(map<int, vector<pair<int,int> >* >::iterator iter=pKey_lineitems.begin();
+    for(arena_hash_map_t<int, vector<pair<int,int> >* >::iterator iter=pKey_lineitems.begin();
 	iter != pKey_lineitems.end();
 	iter++){
 	if(iter->second->size() == 0){
@@ -3590,12 +3984,12 @@ w_rc_t ShoreTPCHEnv::xct_q17(const int /* xct_id */, q17_input_t& q17in )
 struct Q18_row{
     char c_name [25];
     int c_key;
-    time_t o_orderdate;
+    date_t o_orderdate;
     decimal o_totalprice;
 
     Q18_row(){}
     
-    Q18_row(char* name, int key, time_t date, decimal price){
+    Q18_row(char* name, int key, date_t date, decimal price){
 
 	strcpy(c_name, name);
 	c_key = key;
@@ -3604,6 +3998,17 @@ struct Q18_row{
     }
 };
 
+/* ORDER BY o_totalprice DESC, o_orderdate, of (o_orderkey, row) pairs */
+struct q18_top_less {
+    bool operator() (const pair<int,Q18_row>& lhs, 
+                     const pair<int,Q18_row>& rhs) const
+    {
+        if (lhs.second.o_totalprice != rhs.second.o_totalprice)
+            return (lhs.second.o_totalprice > rhs.second.o_totalprice);
+        return (lhs.second.o_orderdate < rhs.second.o_orderdate);
+    }
+};
+
 w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
 {
     // ensure a valid environment
@@ -3619,8 +4024,8 @@ w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
 
     prlineitem->_rep = &lreprow;
     
-    map<int, int> order_Squant;
-    map<int, Q18_row> result;
+    arena_hash_map_t<int, int> order_Squant((size_t)(ORDERS * get_sf()));
+    top_n_t<pair<int,Q18_row>, q18_top_less> top100(100);
 
     guard< table_scan_iter_impl<lineitem_t> > l_iter;
     {
@@ -3637,7 +4042,7 @@ w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
     while (!eof) {
 	prlineitem->get_value(0, aline.L_ORDERKEY);
 	prlineitem->get_value(4, aline.L_QUANTITY);
-	map<int,int>::iterator iter = order_Squant.find( aline.L_ORDERKEY);
+	arena_hash_map_t<int,int>::iterator iter = order_Squant.find( aline.L_ORDERKEY);
 	if( iter != order_Squant.end()){
 	    int c = iter->second;
 	    c+= aline.L_QUANTITY;
@@ -3664,12 +4069,15 @@ w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
     lowrep.set(_pcustomer_desc->maxsize());
     highrep.set(_pcustomer_desc->maxsize());
 
-    for(map<int,int>::iterator it = order_Squant.begin();
+    for(arena_hash_map_t<int,int>::iterator it = order_Squant.begin();
 	it != order_Squant.end();
 	it++){
+	if( it->second <= q18in.l_quantity)
+	    continue;
+
 	// index scan order
 	tpch_orders_tuple anorder;
-	if( it->second > q18in.l_quantity){
+	{
 	    guard<index_scan_iter_impl<orders_t> > o_iter;
 	    {
 		index_scan_iter_impl<orders_t>* tmp_o_iter;
@@ -3684,21 +4092,31 @@ w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
 	    W_DO(o_iter->next(_pssm, eof, *prorders));
 	    prorders->get_value(1, anorder.O_CUSTKEY);
 	    prorders->get_value(3, anorder.O_TOTALPRICE);
-	    prorders->get_value(4, anorder.O_ORDERDATE, 15);
+	    prorders->get_value(4, anorder.O_ORDERDATE);
 	}
 	
+	// LIMIT 100: the customer is probed only if the order makes it
+	date_t the_orderdate = anorder.O_ORDERDATE;     
+	pair<int,Q18_row> row(it->first, Q18_row());
+	row.second.o_orderdate = the_orderdate;
+	row.second.o_totalprice = anorder.O_TOTALPRICE;
+	if (!top100.would_keep(row))
+	    continue;
+
 	//index proble customer
-	time_t the_orderdate = str_to_timet(anorder.O_ORDERDATE);     
 	tpch_customer_tuple acustomer;
 	_pcustomer_man->c_index_probe(_pssm, prcustomer, anorder.O_CUSTKEY);
 	prcustomer->get_value(1, acustomer.C_NAME, 25);
 	_pcustomer_man->give_tuple(prcustomer);
-	result.insert(pair<int,Q18_row>(it->first,Q18_row(acustomer.C_NAME,
+	top100.insert(pair<int,Q18_row>(it->first,Q18_row(acustomer.C_NAME,
 							  anorder.O_CUSTKEY,
 							  the_orderdate,
 							  anorder.O_TOTALPRICE)));
     }
 
+    vector<pair<int,Q18_row> > result;
+    top100.sorted(result);
+
     return RCOK;
 }// EOF: Q18
 
@@ -3710,6 +4128,44 @@ w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
  *
  ********************************************************************/
 
+/* Sums the revenue of the lineitems of the selected parts */
+class q19_lineitem_scan_t : public tpch_scan_consumer_t<lineitem_man_impl>
+{
+    arena_hash_map_t<int, int>& _partkey_brand;
+    q19_input_t& _q19in;
+    tpch_lineitem_tuple _aline;
+
+public:
+    double _revenue;
+
+    q19_lineitem_scan_t(lineitem_man_impl* pmanager, table_desc_t* ptable,
+                        arena_hash_map_t<int, int>& partkey_brand, q19_input_t& q19in)
+        : tpch_scan_consumer_t<lineitem_man_impl>(pmanager, ptable),
+          _partkey_brand(partkey_brand), _q19in(q19in), _revenue(0)
+    { }
+
+    void consume(const char* record) {
+	load(record);
+	_prow->get_value(1, _aline.L_PARTKEY);
+	arena_hash_map_t<int,int>::iterator iter = _partkey_brand.find( _aline.L_PARTKEY );
+	if (iter == _partkey_brand.end())
+	    return;
+	_prow->get_value(4, _aline.L_QUANTITY);
+	_prow->get_value(5, _aline.L_EXTENDEDPRICE);
+	_prow->get_value(6, _aline.L_DISCOUNT);
+	_prow->get_value(13, _aline.L_SHIPINSTRUCT, 25);
+	_prow->get_value(14, _aline.L_SHIPMODE, 10);
+	if(( strcmp( _aline.L_SHIPMODE, "AIR") == 0 ||
+	     strcmp( _aline.L_SHIPMODE, "AIR REG") == 0 ) &&
+	   strcmp( _aline.L_SHIPINSTRUCT, "DELIVER IN PERSON") == 0 &&
+	   _aline.L_QUANTITY  >= _q19in.l_quantity[iter->second-1] &&
+	   _aline.L_QUANTITY <= _q19in.l_quantity[iter->second-1] + 10 ){
+	    _revenue += _aline.L_EXTENDEDPRICE * ( 1 - _aline.L_DISCOUNT );
+	}
+    }
+};
+
+
 w_rc_t ShoreTPCHEnv::xct_q19(const int /* xct_id */, q19_input_t& q19in)
 {
     // ensure a valid environment
@@ -3718,7 +4174,7 @@ w_rc_t ShoreTPCHEnv::xct_q19(const int /* xct_id */, q19_input_t& q19in)
     assert (_loaded);
 
     //phase#1: table scan Part
-    map<int, int> partkey_brand;
+    arena_hash_map_t<int, int> partkey_brand;
     double revenue = 0;
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
@@ -3772,42 +4228,20 @@ w_rc_t ShoreTPCHEnv::xct_q19(const int /* xct_id */, q19_input_t& q19in)
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
     
-    //phase#2 tablescan lineitem
-    tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
-
-    rep_row_t lreprow(_plineitem_man->ts());
-    lreprow.set(_plineitem_desc->maxsize()); 
-
-    prlineitem->_rep = &lreprow;
-
-    guard< table_scan_iter_impl<lineitem_t> > l_iter;
+    //phase#2 parallel table scan lineitem
+    scan_consumers_t<q19_lineitem_scan_t> partials;
+    int const degree = parallel_scan_t::degree(_scan_helpers.get());
+    for (int i=0; i<degree; i++) {
+	partials.add(new q19_lineitem_scan_t(_plineitem_man, _plineitem_desc.get(),
+					     partkey_brand, q19in));
+    }
     {
-	table_scan_iter_impl<lineitem_t>* tmp_l_iter;
-	W_DO(_plineitem_man->get_iter_for_file_scan(_pssm, tmp_l_iter));
-	l_iter = tmp_l_iter;
+	parallel_scan_t l_scan(_pssm, _plineitem_desc.get(), _scan_helpers.get());
+	W_DO(l_scan.run(partials.consumers()));
     }
-        
-    tpch_lineitem_tuple aline;
 
-    W_DO(l_iter->next(_pssm, eof, *prlineitem));
-    
-    while (!eof) {
-	prlineitem->get_value(1, aline.L_PARTKEY);
-	prlineitem->get_value(4, aline.L_QUANTITY);
-	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
-	prlineitem->get_value(6, aline.L_DISCOUNT);
-	prlineitem->get_value(13, aline.L_SHIPINSTRUCT, 25);
-	prlineitem->get_value(14, aline.L_SHIPMODE, 10);
-	map<int,int>::iterator iter = partkey_brand.find( aline.L_PARTKEY );
-	if(iter != partkey_brand.end() &&
-	   ( strcmp( aline.L_SHIPMODE, "AIR") == 0 ||
-	     strcmp( aline.L_SHIPMODE, "AIR REG") == 0 ) &&
-	   strcmp( aline.L_SHIPINSTRUCT, "DELIVER IN PERSON") == 0 &&
-	   aline.L_QUANTITY  >= q19in.l_quantity[iter->second-1] &&
-	   aline.L_QUANTITY <= q19in.l_quantity[iter->second-1] + 10 ){
-	    revenue += aline.L_EXTENDEDPRICE * ( 1 - aline.L_DISCOUNT );
-	}
-	W_DO(l_iter->next(_pssm, eof, *prlineitem));
+    for (uint i=0; i<partials.size(); i++) {
+	revenue += partials[i]->_revenue;
     }
 
     return RCOK;
@@ -3839,7 +4273,7 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
     pname_to_str(q20in.p_color, p_name);
 
     //phase#1 :table scan part
-    map<int,bool> partkey;
+    arena_hash_set_t<int> partkey;
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
 
@@ -3865,13 +4299,13 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
 	prpart->get_value(1, apart.P_NAME, 55);
 	char* s1 = strtok(apart.P_NAME, " ");
 	if( strcmp( s1, p_name) == 0 ) {
-	    partkey.insert(pair<int, bool> (apart.P_PARTKEY, 1));
+	    partkey.insert(apart.P_PARTKEY);
 	}
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
   
     //phase#2 table scan ps
-    map<pair<int,int>, pair<int,int>, int_pair_cmp> supppart_avquant_sumquant;
+    arena_hash_map_t<pair<int,int>, pair<int,int> > supppart_avquant_sumquant;
 
     tuple_guard<partsupp_man_impl> prpartsupp(_ppartsupp_man);
 
@@ -3895,7 +4329,7 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
 	prpartsupp->get_value(0, apartsupp.PS_PARTKEY);
 	prpartsupp->get_value(1, apartsupp.PS_SUPPKEY);
 	prpartsupp->get_value(2, apartsupp.PS_AVAILQTY);
-	if( partkey.find(apartsupp.PS_PARTKEY) != partkey.end() ){
+	if( partkey.contains(apartsupp.PS_PARTKEY) ){
 	    pair< pair <int, int>,pair<int,int> > tmp
 		(pair<int,int>( apartsupp.PS_SUPPKEY, apartsupp.PS_SUPPKEY),
 		 pair<int,int>( apartsupp.PS_AVAILQTY, 0) );
@@ -3944,7 +4378,7 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
 	prlineitem->get_value(1, aline.L_PARTKEY);
 	prlineitem->get_value(2, aline.L_SUPPKEY);
 	prlineitem->get_value(4, aline.L_QUANTITY);
-	map< pair<int,int>, pair<int,int>, int_pair_cmp >::iterator it =
+	arena_hash_map_t<pair<int,int>, pair<int,int> >::iterator it =
 	    supppart_avquant_sumquant.find(pair<int,int>
 					   (aline.L_PARTKEY, aline.L_SUPPKEY));
 	if( it != supppart_avquant_sumquant.end()){
@@ -3958,12 +4392,12 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
     }
     
     //phase#4 : compare the available_quantity with sumof_quantity
-    map<int, bool> suppkey;
-    map< pair<int,int>, pair<int, int> > :: iterator it =
+    arena_hash_set_t<int> suppkey;
+    arena_hash_map_t<pair<int,int>, pair<int,int> >::iterator it =
 	supppart_avquant_sumquant.begin();
     while( it != supppart_avquant_sumquant.end()){
 	if( it->second.first > .5 * it->second.second ){
-	    suppkey.insert( pair<int,bool>(it->first.first, true));
+	    suppkey.insert(it->first.first);
 	}
 	it++;
     }
@@ -3979,10 +4413,10 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
 
     prsupp->_rep = &sreprow;
 
-    for(map<int,bool>::iterator iter = suppkey.begin();
+    for(arena_hash_set_t<int>::iterator iter = suppkey.begin();
 	iter != suppkey.end();
 	iter++){
-       _psupplier_man->s_index_probe(_pssm, prsupp, iter->first);
+       _psupplier_man->s_index_probe(_pssm, prsupp, *iter);
        tpch_supplier_tuple asupp;
        prsupp->get_value(1, asupp.S_NAME, 25);
        prsupp->get_value(2, asupp.S_ADDRESS, 40);
@@ -4003,6 +4437,15 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
  *
  ********************************************************************/
 
+/* ORDER BY numwait DESC, s_suppkey, of (numwait, s_suppkey) pairs */
+struct q21_top_less {
+    bool operator() (const pair<int,int>& lhs, const pair<int,int>& rhs) const
+    {
+        if (lhs.first != rhs.first) return (lhs.first > rhs.first);
+        return (lhs.second < rhs.second);
+    }
+};
+
 w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
 {
     // ensure a valid environment
@@ -4011,7 +4454,7 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
     assert (_loaded);
 
     //phase#1 scan supplier_t for supps which s_nationkey == q21.in
-    map<int, string> suppkey;
+    arena_hash_map_t<int, string> suppkey;
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -4044,7 +4487,7 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
     }
 
     //phase#2 : scan order for tuples which stat = 'F'
-    map<int,bool> orderkey;
+    arena_hash_set_t<int> orderkey;
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
     
@@ -4068,15 +4511,15 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
 	prorder->get_value(0, anorder.O_ORDERKEY);
 	prorder->get_value(2, anorder.O_ORDERSTATUS);
 	if( anorder.O_ORDERSTATUS == 'F' ) {
-	    orderkey.insert( pair <int,bool> (anorder.O_ORDERKEY, true) );
+	    orderkey.insert(anorder.O_ORDERKEY);
 	}
 	W_DO(o_iter->next(_pssm, eof, *prorder));
     }
 
     //table scan lineitem for delayed tuples
     vector<pair<int,int> > suppkey_orderkey;
-    map<int,int> multiOrders;
-    map<int,int> delay2order; //orders with more than 2 supp delay for them
+    arena_hash_map_t<int,int> multiOrders;
+    arena_hash_map_t<int,int> delay2order; //orders with more than 2 supp delay for them
 
     tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
 
@@ -4099,23 +4542,23 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
     while (!eof) {
 	prlineitem->get_value(0, aline.L_ORDERKEY);
 	prlineitem->get_value(2, aline.L_SUPPKEY);	    
-	prlineitem->get_value(11, aline.L_COMMITDATE, 15);
-	prlineitem->get_value(12, aline.L_RECEIPTDATE, 15);
-	time_t the_commitdate = str_to_timet(aline.L_COMMITDATE);
-	time_t the_receiptdate = str_to_timet(aline.L_RECEIPTDATE);
-	if( orderkey.find(aline.L_ORDERKEY) != orderkey.end()){
+	prlineitem->get_value(11, aline.L_COMMITDATE);
+	prlineitem->get_value(12, aline.L_RECEIPTDATE);
+	date_t the_commitdate = aline.L_COMMITDATE;
+	date_t the_receiptdate = aline.L_RECEIPTDATE;
+	if( orderkey.contains(aline.L_ORDERKEY)){
 	    if (the_commitdate < the_receiptdate &&
 		suppkey.find(aline.L_SUPPKEY) != suppkey.end()){
 		suppkey_orderkey.push_back(pair<int,int>
 					   (aline.L_SUPPKEY, aline.L_ORDERKEY));
-		map<int,int>::iterator it = delay2order.find(aline.L_ORDERKEY);
+		arena_hash_map_t<int,int>::iterator it = delay2order.find(aline.L_ORDERKEY);
 		if (it != delay2order.end() && it->second != aline.L_SUPPKEY){
 		    delay2order[it->first] = -1;
 		} else {
 		    delay2order[it->first] = aline.L_SUPPKEY;
 		}
 	    }
-	    map<int,int>::iterator it = multiOrders.find(aline.L_ORDERKEY);
+	    arena_hash_map_t<int,int>::iterator it = multiOrders.find(aline.L_ORDERKEY);
 	    if (it != multiOrders.end() && it->second != aline.L_SUPPKEY){
 		multiOrders[it->first] = -1;
 	    } else {
@@ -4126,7 +4569,7 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
     }
     
     //final phase: computing the scalar
-    map<int,int> supK_numwait;    
+    arena_hash_map_t<int,int> supK_numwait;    
     for(int i = 0; i < suppkey_orderkey.size(); i++){
 	if( multiOrders[suppkey_orderkey[i].second] == -1 &&
 	    delay2order[suppkey_orderkey[i].second] != -1) {
@@ -4139,6 +4582,16 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
 	    }
 	}
     }
+
+    // ORDER BY numwait DESC, s_name LIMIT 100. S_NAME is "Supplier#"
+    // followed by the zero-padded key, so the key gives the name order.
+    top_n_t<pair<int,int>, q21_top_less> top100(100);
+    for (arena_hash_map_t<int,int>::iterator it = supK_numwait.begin();
+	 it != supK_numwait.end(); it++) {
+	top100.insert(pair<int,int>(it->second, it->first));
+    }
+    vector<pair<int,int> > result;
+    top100.sorted(result);
    
     return RCOK;
 }
@@ -4159,7 +4612,7 @@ w_rc_t ShoreTPCHEnv::xct_q22(const int /* xct_id */, q22_input_t& q22in)
     assert (_loaded);
 
     //phase#1 tablescan customer: <ckey,acctbal,code> and AVG(acctbal)
-    map<int, pair<decimal,int> > ckey_acbalCcode;
+    arena_hash_map_t<int, pair<decimal,int> > ckey_acbalCcode;
     decimal bal_avg = 0;
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
@@ -4218,7 +4671,7 @@ w_rc_t ShoreTPCHEnv::xct_q22(const int /* xct_id */, q22_input_t& q22in)
     lowrep.set(_porders_desc->maxsize());
     highrep.set(_porders_desc->maxsize());
 
-    map<int, pair<decimal,int> >::iterator it =  ckey_acbalCcode.begin();
+    arena_hash_map_t<int, pair<decimal,int> >::iterator it =  ckey_acbalCcode.begin();
     while(it != ckey_acbalCcode.end()){
 	guard<index_scan_iter_impl<orders_t> > o_iter;
 	{
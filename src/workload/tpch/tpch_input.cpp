@@ -909,4 +909,49 @@ q22_input_t& q22_input_t::operator=(const q22_input_t& rhs){
     return (*this);
 }
 
+
+/******************************************************************** 
+ *
+ *  RF1 - RF2
+ *
+ *  The refresh stream passes the first order of the transaction as
+ *  the selected id
+ *
+ ********************************************************************/
+
+rf1_input_t& rf1_input_t::operator=(const rf1_input_t& rhs)
+{
+    _first = rhs._first;
+    _count = rhs._count;
+    return (*this);
+};
+
+
+rf1_input_t  create_rf1_input(const double /* sf */, 
+                              const int specificWH)
+{
+    rf1_input_t rf1_input;
+    rf1_input._first = (specificWH>0) ? specificWH : 1;
+    rf1_input._count = RF_ORDERS_PER_XCT;
+    return (rf1_input);
+}
+
+
+rf2_input_t& rf2_input_t::operator=(const rf2_input_t& rhs)
+{
+    _first = rhs._first;
+    _count = rhs._count;
+    return (*this);
+};
+
+
+rf2_input_t  create_rf2_input(const double /* sf */, 
+                              const int specificWH)
+{
+    rf2_input_t rf2_input;
+    rf2_input._first = (specificWH>0) ? specificWH : 1;
+    rf2_input._count = RF_ORDERS_PER_XCT;
+    return (rf2_input);
+}
+
 EXIT_NAMESPACE(tpch);
@@ -0,0 +1,429 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   tpch_streams.cpp
+ *
+ *  @brief:  Implementation of the TPC-H power and throughput tests
+ *
+ */
+
+#include "workload/tpch/tpch_streams.h"
+
+#include "util/config.h"
+#include "util/stopwatch.h"
+
+// the query order of every stream (TPC-H spec, Appendix A)
+#include "workload/tpch/dbgen/permute.h"
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+using namespace std;
+
+
+ENTER_NAMESPACE(tpch);
+
+
+/*********************************************************************
+ *
+ *  tpch_stream_client_t
+ *
+ *********************************************************************/
+
+tpch_stream_client_t::tpch_stream_client_t(c_str tname, const int id,
+                                           ShoreTPCHEnv* env,
+                                           const int stream,
+                                           const int xct_base,
+                                           const int first_set,
+                                           const int pairs,
+                                           processorid_t aprsid)
+    : base_client_t(tname,id,env,MT_NUM_OF_TRXS,-1,TPCH_QUERIES,aprsid),
+      _stream(stream), _xct_base(xct_base),
+      _first_set(first_set), _pairs(pairs), _xct_cnt(0),
+      _rf1time(pairs,0), _rf2time(pairs,0)
+{
+    assert (env);
+    assert (_stream < TPCH_MAX_STREAMS);
+    assert (_stream >= 0 || _pairs > 0);
+    for (int q=0; q<TPCH_QUERIES; q++) _qtime[q] = 0;
+
+    // pick worker thread
+    _worker = _env->worker(_id);
+    assert (_worker);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    work
+ *
+ *  @brief: Runs the query stream and the refresh pairs
+ *
+ *********************************************************************/
+
+void tpch_stream_client_t::work()
+{
+    TRY_TO_BIND(_prs_id,_is_bound);
+
+    if (!_env->is_initialized() || !_env->is_loaded()) {
+        TRACE( TRACE_ALWAYS, "The database is not loaded...\n");
+        _rv = 1;
+        return;
+    }
+
+    // the query stream of the power test runs between RF1 and RF2
+    if (_pairs) {
+        _rf1time[0] = _run_refresh(XCT_TPCH_RF1, _first_set);
+    }
+
+    if (_stream >= 0) {
+        for (int i=0; i<TPCH_QUERIES; i++) {
+            int q = dbgentpch::permutation[_stream][i];
+            _qtime[q-1] = _run_one(_xct_base + q, 0);
+        }
+    }
+
+    if (_pairs) {
+        _rf2time[0] = _run_refresh(XCT_TPCH_RF2, _first_set);
+    }
+
+    for (int i=1; i<_pairs; i++) {
+        _rf1time[i] = _run_refresh(XCT_TPCH_RF1, _first_set+i);
+        _rf2time[i] = _run_refresh(XCT_TPCH_RF2, _first_set+i);
+    }
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _run_one
+ *
+ *  @brief: Submits one trx and waits for the worker to complete it
+ *
+ *  @returns: The seconds it took
+ *
+ *********************************************************************/
+
+double tpch_stream_client_t::_run_one(const int xct_type, const int selid)
+{
+    stopwatch_t timer;
+    _cp->please_take_one();
+    W_COERCE(_submit(xct_type, _xct_cnt++, selid));
+    _cp->wait();
+    return (timer.time());
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _run_refresh
+ *
+ *  @brief: Runs RF1 or RF2 on the orders of the (set) refresh set, in
+ *          transactions of RF_ORDERS_PER_XCT orders each. A set has
+ *          RF_ORDERS orders per SF, rounded up to whole transactions.
+ *
+ *  @returns: The seconds it took
+ *
+ *********************************************************************/
+
+double tpch_stream_client_t::_run_refresh(const int xct_type, const int set)
+{
+    assert (set > 0);
+    double sf = _env->get_sf();
+    int xcts = (int)ceil(RF_ORDERS*sf/RF_ORDERS_PER_XCT);
+    int first = (set-1)*xcts*RF_ORDERS_PER_XCT + 1;
+
+    double total = 0;
+    for (int i=0; i<xcts; i++) {
+        total += _run_one(xct_type, first + i*RF_ORDERS_PER_XCT);
+    }
+    return (total);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    submit_one
+ *
+ *  @brief: Entry point for running one TPC-H query (trx), as the
+ *          baseline client does
+ *
+ *********************************************************************/
+
+w_rc_t tpch_stream_client_t::submit_one(int xct_type, int xctid)
+{
+    return (_submit(xct_type, xctid, 0));
+}
+
+w_rc_t tpch_stream_client_t::_submit(const int xct_type, const int xctid,
+                                     const int selid)
+{
+    // Set input
+    trx_result_tuple_t atrt;
+    bool bWake = false;
+    if (condex* c = _cp->take_one()) {
+        atrt.set_notify(c);
+        bWake = true;
+    }
+
+    // Get one action from the trash stack
+    trx_request_t* arequest = new (_env->_request_pool) trx_request_t;
+    tid_t atid;
+    arequest->set(NULL,atid,xctid,atrt,xct_type,selid);
+
+    // Enqueue to worker thread
+    assert (_worker);
+    _worker->enqueue(arequest,bWake);
+    return (RCOK);
+}
+
+
+
+/*********************************************************************
+ *
+ *  "qphh" command
+ *
+ *********************************************************************/
+
+void tpch_streams_cmd_t::setaliases()
+{
+    _name = string("qphh");
+    _aliases.push_back("qphh");
+    _aliases.push_back("tpch-streams");
+}
+
+int tpch_streams_cmd_t::handle(const char* cmd)
+{
+    char cmd_tag[SERVER_COMMAND_BUFFER_SIZE];
+    char sStreams[SERVER_COMMAND_BUFFER_SIZE];
+    char sImpl[SERVER_COMMAND_BUFFER_SIZE] = "baseline";
+
+    if ( sscanf(cmd, "%s %s %s", cmd_tag, sStreams, sImpl) < 2) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+    assert (_env);
+
+    int streams = atoi(sStreams);
+    if (streams < 0 || streams >= TPCH_MAX_STREAMS) {
+        TRACE( TRACE_ALWAYS, "Up to %d query streams\n", TPCH_MAX_STREAMS-1);
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    int xct_base = XCT_TPCH_MIX;
+    if (strcasecmp(sImpl, "qpipe") == 0) {
+#ifdef CFG_QPIPE
+        xct_base = XCT_QPIPE_TPCH_MIX;
+#else
+        TRACE( TRACE_ALWAYS, "QPipe is not enabled\n");
+        return (SHELL_NEXT_CONTINUE);
+#endif
+    }
+    else if (strcasecmp(sImpl, "baseline") != 0) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    double sf = _env->get_sf();
+    TRACE( TRACE_ALWAYS, "TPC-H (%s) SF (%.1f) Streams (%d)\n",
+           sImpl, sf, streams);
+
+    _env->reset_stats();
+    _env->set_measure(MST_MEASURE);
+
+    double power = _power_test(xct_base);
+    if (power > 0) {
+        TRACE( TRACE_ALWAYS, "Power@Size      = %.2f\n", power);
+    }
+
+    if (streams > 0 && power > 0) {
+        double throughput = _throughput_test(xct_base, streams);
+        if (throughput > 0) {
+            TRACE( TRACE_ALWAYS, "Throughput@Size = %.2f\n", throughput);
+            TRACE( TRACE_ALWAYS, "QphH@Size       = %.2f\n",
+                   sqrt(power*throughput));
+        }
+    }
+
+    _env->set_measure(MST_DONE);
+    return (SHELL_NEXT_CONTINUE);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _power_test
+ *
+ *  @brief: Runs RF1, the first query stream and RF2 one after the
+ *          other
+ *
+ *  @returns: Power@Size, the queries run per hour at the geometric
+ *            mean of the 22 query and 2 refresh times (times shorter
+ *            than 1/1000 of the longest count as such), times the SF.
+ *            Zero on error.
+ *
+ *********************************************************************/
+
+double tpch_streams_cmd_t::_power_test(const int xct_base)
+{
+    TRACE( TRACE_ALWAYS, "Power test\n");
+
+    tpch_stream_client_t* client =
+        new tpch_stream_client_t(c_str("PWR-0"), 0, _env, 0, xct_base, 1, 1);
+    client->fork();
+    client->join();
+    if (client->rv()) {
+        TRACE( TRACE_ALWAYS, "Error in the power test...\n");
+        delete (client);
+        return (0);
+    }
+    _print_streams(&client, 1);
+
+    vector<double> times;
+    for (int q=1; q<=TPCH_QUERIES; q++) times.push_back(client->qtime(q));
+    times.push_back(client->rf1time(0));
+    times.push_back(client->rf2time(0));
+    delete (client);
+
+    double longest = 0;
+    for (uint i=0; i<times.size(); i++) longest = max(longest, times[i]);
+    if (longest <= 0) return (0);
+
+    double logsum = 0;
+    for (uint i=0; i<times.size(); i++) {
+        logsum += log(max(times[i], longest/1000));
+    }
+    return (3600 * _env->get_sf() / exp(logsum/times.size()));
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _throughput_test
+ *
+ *  @brief: Runs (streams) query streams concurrently, next to a
+ *          refresh stream with as many RF1/RF2 pairs
+ *
+ *  @returns: Throughput@Size, the queries run per hour, times the SF.
+ *            Zero on error.
+ *
+ *********************************************************************/
+
+double tpch_streams_cmd_t::_throughput_test(const int xct_base,
+                                            const int streams)
+{
+    TRACE( TRACE_ALWAYS, "Throughput test\n");
+
+    vector<tpch_stream_client_t*> clients;
+    stopwatch_t timer;
+
+    for (int s=1; s<=streams; s++) {
+        clients.push_back(new tpch_stream_client_t(c_str("QS-%d",s), s, _env,
+                                                   s, xct_base, 0, 0));
+        clients.back()->fork();
+    }
+    // the refresh stream on a worker of its own
+    clients.push_back(new tpch_stream_client_t(c_str("RF"), streams+1, _env,
+                                               -1, xct_base, 1, streams));
+    clients.back()->fork();
+
+    bool failed = false;
+    for (uint i=0; i<clients.size(); i++) {
+        clients[i]->join();
+        failed |= (clients[i]->rv() != 0);
+    }
+    double elapsed = timer.time();
+
+    if (!failed) {
+        _print_streams(&clients[0], clients.size());
+        TRACE( TRACE_ALWAYS, "Ts = %.2f secs\n", elapsed);
+    }
+    else {
+        TRACE( TRACE_ALWAYS, "Error in the throughput test...\n");
+    }
+
+    for (uint i=0; i<clients.size(); i++) delete (clients[i]);
+    if (failed || elapsed <= 0) return (0);
+
+    return ((streams * TPCH_QUERIES * 3600.0 / elapsed) * _env->get_sf());
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    _print_streams
+ *
+ *  @brief: Prints the seconds of every query, by query number, and of
+ *          every refresh function per stream
+ *
+ *********************************************************************/
+
+void tpch_streams_cmd_t::_print_streams(tpch_stream_client_t* const* clients,
+                                        const int count) const
+{
+    ostringstream os;
+    os << fixed << setprecision(2);
+
+    os << "Stream";
+    for (int q=1; q<=TPCH_QUERIES; q++) os << setw(8) << "Q" << q;
+    os << endl;
+
+    for (int i=0; i<count; i++) {
+        const tpch_stream_client_t* c = clients[i];
+        if (c->stream() >= 0) {
+            os << setw(6) << c->stream();
+            for (int q=1; q<=TPCH_QUERIES; q++) os << setw(9) << c->qtime(q);
+            os << endl;
+        }
+        for (int p=0; p<c->pairs(); p++) {
+            os << setw(6) << "RF" << " pair " << (p+1)
+               << ": RF1 " << c->rf1time(p)
+               << " RF2 " << c->rf2time(p) << endl;
+        }
+    }
+
+    TRACE( TRACE_ALWAYS, "\n%s", os.str().c_str());
+}
+
+
+void tpch_streams_cmd_t::usage(void)
+{
+    TRACE( TRACE_ALWAYS, "QPHH Usage:\n\n"                                 \
+           "*** qphh <STREAMS> [<IMPL>]\n"                                 \
+           "\nParameters:\n"                                               \
+           "<STREAMS> - The query streams of the throughput test,\n"       \
+           "            0 runs only the power test\n"                      \
+           "<IMPL>    - baseline (default) or qpipe\n\n"                   \
+           "Every stream and the refresh stream use the worker of their\n" \
+           "number, so db-workers should be at least STREAMS+2\n\n");
+}
+
+string tpch_streams_cmd_t::desc() const
+{
+    return (string("Runs the TPC-H power and throughput tests"));
+}
+
+
+EXIT_NAMESPACE(tpch);
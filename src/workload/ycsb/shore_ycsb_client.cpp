@@ -0,0 +1,121 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_ycsb_client.cpp
+ *
+ *  @brief:  Implementation of the client for the YCSB benchmark
+ */
+
+#include "workload/ycsb/shore_ycsb_client.h"
+
+ENTER_NAMESPACE(ycsb);
+
+
+/*********************************************************************
+ *
+ *  baseline_ycsb_client_t
+ *
+ *********************************************************************/
+
+baseline_ycsb_client_t::baseline_ycsb_client_t(c_str tname, const int id,
+                                               ShoreYCSBEnv* env,
+                                               const MeasurementType aType,
+                                               const int trxid,
+                                               const int numOfTrxs,
+                                               processorid_t aprsid,
+                                               const int selID, const double qf)
+    : base_client_t(tname,id,env,aType,trxid,numOfTrxs,aprsid),
+      _selid(selID), _qf(qf)
+{
+    assert (env);
+    assert (_id>=0 && _qf>0);
+
+    // pick worker thread
+    _worker = _env->worker(_id);
+    assert (_worker);
+}
+
+
+int baseline_ycsb_client_t::load_sup_xct(mapSupTrxs& stmap)
+{
+    // clears the supported trx map and loads its own
+    stmap.clear();
+
+    // Baseline YCSB trxs
+    stmap[XCT_YCSB_MIX]      = "YCSB-Mix";
+    stmap[XCT_YCSB_A]        = "YCSB-A";
+    stmap[XCT_YCSB_B]        = "YCSB-B";
+    stmap[XCT_YCSB_C]        = "YCSB-C";
+    stmap[XCT_YCSB_D]        = "YCSB-D";
+    stmap[XCT_YCSB_E]        = "YCSB-E";
+    stmap[XCT_YCSB_F]        = "YCSB-F";
+
+    stmap[XCT_YCSB_READ]     = "YCSB-Read";
+    stmap[XCT_YCSB_UPDATE]   = "YCSB-Update";
+    stmap[XCT_YCSB_INSERT]   = "YCSB-Insert";
+    stmap[XCT_YCSB_SCAN]     = "YCSB-Scan";
+    stmap[XCT_YCSB_RMW]      = "YCSB-ReadModWrite";
+
+    return (stmap.size());
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:    submit_one
+ *
+ *  @brief: Entry point for running one YCSB xct
+ *
+ *  @note:  The execution of this trx will not be stopped even if the
+ *          measure interval has expired.
+ *
+ *********************************************************************/
+
+w_rc_t baseline_ycsb_client_t::submit_one(int xct_type, int xctid)
+{
+    // Set input
+    trx_result_tuple_t atrt;
+    bool bWake = false;
+    if (condex* c = _cp->take_one()) {
+        atrt.set_notify(c);
+        bWake = true;
+    }
+
+    // With spread the client sticks to the records of one SF unit,
+    // otherwise the keys are drawn over all the records (keydist)
+    int selid = _selid;
+
+    // Get one action from the trash stack
+    trx_request_t* arequest = new (_env->_request_pool) trx_request_t;
+    tid_t atid;
+    arequest->set(NULL,atid,xctid,atrt,xct_type,selid);
+
+    // Enqueue to the worker thread
+    assert (_worker);
+    _worker->enqueue(arequest,bWake);
+    return (RCOK);
+}
+
+
+
+EXIT_NAMESPACE(ycsb);
@@ -0,0 +1,677 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_ycsb_env.cpp
+ *
+ *  @brief:  Declaration of the Shore YCSB environment (database)
+ */
+
+#include "workload/ycsb/shore_ycsb_env.h"
+#include "sm/shore/shore_helper_loader.h"
+
+#include <climits>
+
+using namespace shore;
+
+
+ENTER_NAMESPACE(shore);
+DEFINE_ROW_CACHE_TLS(ycsb, ut);
+EXIT_NAMESPACE(shore);
+
+
+ENTER_NAMESPACE(ycsb);
+
+
+/********************************************************************
+ *
+ * ShoreYCSBEnv functions
+ *
+ ********************************************************************/
+
+ShoreYCSBEnv::ShoreYCSBEnv()
+    : ShoreEnv()
+{
+    _scaling_factor = YCSB_DEF_SF;
+    _queried_factor = YCSB_DEF_QF;
+
+    _trxs.add(XCT_YCSB_READ,   &ShoreYCSBEnv::run_read_rec);
+    _trxs.add(XCT_YCSB_UPDATE, &ShoreYCSBEnv::run_update_rec);
+    _trxs.add(XCT_YCSB_INSERT, &ShoreYCSBEnv::run_insert_rec);
+    _trxs.add(XCT_YCSB_SCAN,   &ShoreYCSBEnv::run_scan_rec);
+    _trxs.add(XCT_YCSB_RMW,    &ShoreYCSBEnv::run_rmw_rec);
+
+    for (int w=0; w<YCSB_WORKLOADS; w++)
+        add_mix(XCT_YCSB_A + w, workload_mix(w));
+    add_mix(XCT_YCSB_MIX, workload_mix(y_workload));
+}
+
+
+trx_mix_t ShoreYCSBEnv::workload_mix(const int workload)
+{
+    trx_mix_t mix;
+    for (int t=XCT_YCSB_READ; t<=XCT_YCSB_RMW; t++)
+        if (ycsb_op_pct(workload, t) > 0) mix.add(t, ycsb_op_pct(workload, t));
+    mix.build();
+    return (mix);
+}
+
+ShoreYCSBEnv::~ShoreYCSBEnv()
+{
+}
+
+
+int ShoreYCSBEnv::get_loaded_records() const
+{
+    return ((int)(_scaling_factor*y_records_per_sf));
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    load_schema()
+ *
+ *  @brief: Creates the table_desc_t and table_man_impl objects for
+ *          the YCSB table
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::load_schema()
+{
+    // create the schema
+    _put_desc = new usertable_t(get_pd());
+
+    // initiate the table manager
+    _put_man = new ut_man_impl(_put_desc.get());
+
+    return (RCOK);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    load_and_register_fids()
+ *
+ *  @brief: loads the store ids for each table and index at kits side
+ *          as well as registering the tables
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::load_and_register_fids()
+{
+    W_DO(_put_man->load_and_register_fid(db()));
+    return (RCOK);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    update_partitioning()
+ *
+ *  @brief: Applies the baseline partitioning to the YCSB table
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::update_partitioning()
+{
+    // *** Reminder: The YCSB keys start from 0.
+
+    // First configure
+    conf();
+
+    // Pulling this partitioning out of the thin air
+    uint mrbtparts = envVar::instance()->getVarInt("mrbt-partitions",10);
+    int minKeyVal = 0;
+    int maxKeyVal = get_loaded_records();
+
+    char* minKey = (char*)malloc(sizeof(int));
+    memset(minKey,0,sizeof(int));
+    memcpy(minKey,&minKeyVal,sizeof(int));
+
+    char* maxKey = (char*)malloc(sizeof(int));
+    memset(maxKey,0,sizeof(int));
+    memcpy(maxKey,&maxKeyVal,sizeof(int));
+
+    // The inserted records (keys >= maxKeyVal) fall in the last partition
+    _put_desc->set_partitioning(minKey,sizeof(int),maxKey,sizeof(int),mrbtparts);
+
+    free (minKey);
+    free (maxKey);
+
+    return (RCOK);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    start/stop
+ *
+ *  @brief: Simply call the corresponding functions of shore_env
+ *
+ ********************************************************************/
+
+int ShoreYCSBEnv::start()
+{
+    return (ShoreEnv::start());
+}
+
+int ShoreYCSBEnv::stop()
+{
+    return (ShoreEnv::stop());
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    set_keydist()
+ *
+ *  @brief: sets the key distribution of the records for YCSB
+ *
+ ********************************************************************/
+void ShoreYCSBEnv::set_keydist(const keydist_spec_t& spec)
+{
+    ShoreEnv::set_keydist(spec);
+    y_keydist.set(spec, (long)get_loaded_records());
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    info()
+ *
+ *  @brief: Prints information about the current db instance status
+ *
+ ********************************************************************/
+
+int ShoreYCSBEnv::info() const
+{
+    TRACE( TRACE_ALWAYS, "SF       = (%.1f)\n", _scaling_factor);
+    TRACE( TRACE_ALWAYS, "Records  = (%d) per SF. Next key (%u). Committed (%u)\n",
+           y_records_per_sf, *&y_next_key, *&y_committed_key);
+    TRACE( TRACE_ALWAYS, "Workload = (%c)\n", 'A' + y_workload);
+    TRACE( TRACE_ALWAYS, "Workers  = (%d)\n", _worker_cnt);
+    return (0);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    statistics
+ *
+ *  @brief: Prints statistics for YCSB
+ *
+ ********************************************************************/
+
+int ShoreYCSBEnv::statistics()
+{
+    // read the current trx statistics
+    ShoreYCSBTrxStats rval = _get_stats();
+
+    TRACE( TRACE_STATISTICS, "Read. Att (%d). Abt (%d). Dld (%d)\n",
+           rval.attempted.read_rec,
+           rval.failed.read_rec,
+           rval.deadlocked.read_rec);
+
+    TRACE( TRACE_STATISTICS, "Update. Att (%d). Abt (%d). Dld (%d)\n",
+           rval.attempted.update_rec,
+           rval.failed.update_rec,
+           rval.deadlocked.update_rec);
+
+    TRACE( TRACE_STATISTICS, "Insert. Att (%d). Abt (%d). Dld (%d)\n",
+           rval.attempted.insert_rec,
+           rval.failed.insert_rec,
+           rval.deadlocked.insert_rec);
+
+    TRACE( TRACE_STATISTICS, "Scan. Att (%d). Abt (%d). Dld (%d)\n",
+           rval.attempted.scan_rec,
+           rval.failed.scan_rec,
+           rval.deadlocked.scan_rec);
+
+    TRACE( TRACE_STATISTICS, "ReadModWrite. Att (%d). Abt (%d). Dld (%d)\n",
+           rval.attempted.rmw_rec,
+           rval.failed.rmw_rec,
+           rval.deadlocked.rmw_rec);
+
+    ShoreEnv::statistics();
+
+    return (0);
+}
+
+
+
+
+/******************************************************************
+ *
+ * @struct: table_creator_t
+ *
+ * @brief:  Helper class for creating the environment table and
+ *          loading a number of records in a single-threaded fashion
+ *
+ ******************************************************************/
+
+struct ShoreYCSBEnv::table_creator_t : public thread_t
+{
+    ShoreYCSBEnv* _env;
+    int _loaders;
+    int _recs_per_worker;
+    int _preloads_per_worker;
+
+    table_creator_t(ShoreYCSBEnv* env,
+                    const int loaders, const int recs_per_worker, const int preloads_per_worker)
+	: thread_t("CR"), _env(env),
+          _loaders(loaders),_recs_per_worker(recs_per_worker),_preloads_per_worker(preloads_per_worker)
+    {
+        assert (loaders);
+        assert (recs_per_worker);
+        assert (preloads_per_worker>=0);
+        assert (recs_per_worker>=preloads_per_worker);
+    }
+    virtual void work();
+
+}; // EOF: ShoreYCSBEnv::table_creator_t
+
+
+void  ShoreYCSBEnv::table_creator_t::work()
+{
+    // Create the table
+    W_COERCE(_env->db()->begin_xct());
+    W_COERCE(_env->_put_desc->create_physical_table(_env->db()));
+    W_COERCE(_env->db()->commit_xct());
+
+    // After it obtained its fid, register the manager
+    _env->_put_man->register_table_man();
+
+    // Preload (preloads_per_worker) records for each of the loaders
+    for (int i=0; i<_loaders; i++) {
+        W_COERCE(_env->db()->begin_xct());
+        TRACE( TRACE_ALWAYS, "Preloading (%d). Start (%d). Todo (%d)\n",
+               i, (i*_recs_per_worker), _preloads_per_worker);
+
+        for (int j=0; j<_preloads_per_worker; j++) {
+            W_COERCE(_env->xct_populate_one(i*_recs_per_worker + j));
+        }
+        W_COERCE(_env->db()->commit_xct());
+    }
+}
+
+
+/******************************************************************
+ *
+ * @class: table_builder_t
+ *
+ * @brief:  Helper class for loading the environment table
+ *
+ ******************************************************************/
+
+class ShoreYCSBEnv::table_builder_t : public thread_t
+{
+    ShoreYCSBEnv* _env;
+    int _loader_id;
+    int _start;
+    int _count;
+public:
+    table_builder_t(ShoreYCSBEnv* env, int loaderid, int start, int count)
+	: thread_t(c_str("LD-%d",loaderid)),
+          _env(env), _loader_id(loaderid), _start(start), _count(count)
+    { }
+    virtual void work();
+
+}; // EOF: ShoreYCSBEnv::table_builder_t
+
+
+void ShoreYCSBEnv::table_builder_t::work()
+{
+    assert (_count>=0);
+
+    w_rc_t e = RCOK;
+    int commitmark = 0;
+    int tracemark = 0;
+    int recsadded = 0;
+
+    W_COERCE(_env->db()->begin_xct());
+
+    // add _count number of records
+    int last_commit = 0;
+    for (recsadded=0; recsadded<_count; ++recsadded) {
+    again:
+	int key = _start + recsadded;
+
+        // insert row
+	e = _env->xct_populate_one(key);
+
+	if(e.is_error()) {
+	    W_COERCE(_env->db()->abort_xct());
+	    if(e.err_num() == smlevel_0::eDEADLOCK) {
+		W_COERCE(_env->db()->begin_xct());
+		recsadded = last_commit + 1;
+		goto again;
+	    }
+	    stringstream os;
+	    os << e << ends;
+	    string str = os.str();
+	    TRACE( TRACE_ALWAYS, "Unable to Insert Record (%d) due to:\n%s\n",
+                   key, str.c_str());
+	}
+
+        // Output some information
+        if (recsadded>=tracemark) {
+            TRACE( TRACE_ALWAYS, "Start (%d). Todo (%d). Added (%d)\n",
+                   _start, _count, recsadded);
+            tracemark += YCSB_LOADING_TRACE_INTERVAL;
+        }
+
+        // Commit every now and then
+        if (recsadded>=commitmark) {
+            e = _env->db()->commit_xct();
+
+            if (e.is_error()) {
+                stringstream os;
+                os << e << ends;
+                string str = os.str();
+                TRACE( TRACE_ALWAYS, "Unable to Commit (%d) due to:\n%s\n",
+                       key, str.c_str());
+
+                w_rc_t e2 = _env->db()->abort_xct();
+                if(e2.is_error()) {
+                    TRACE( TRACE_ALWAYS,
+                           "Unable to abort trx for Record (%d) due to [0x%x]\n",
+                           key, e2.err_num());
+                }
+            }
+
+	    last_commit = recsadded;
+            commitmark += YCSB_LOADING_COMMIT_INTERVAL;
+
+            W_COERCE(_env->db()->begin_xct());
+        }
+    }
+
+    // final commit
+    e = _env->db()->commit_xct();
+
+    if (e.is_error()) {
+        stringstream os;
+        os << e << ends;
+        string str = os.str();
+        TRACE( TRACE_ALWAYS, "Unable to final Commit due to:\n%s\n",
+               str.c_str());
+
+        w_rc_t e2 = _env->db()->abort_xct();
+        if(e2.is_error()) {
+            TRACE( TRACE_ALWAYS, "Unable to abort trx due to [0x%x]\n",
+                   e2.err_num());
+        }
+    }
+}
+
+
+/********
+ ******** Caution: The functions below should be invoked inside
+ ******** the context of a smthread
+ ********/
+
+
+/******************************************************************
+ *
+ * @fn:    loaddata()
+ *
+ * @brief: Loads the data of the YCSB table, given the current
+ *         scaling factor value. During the loading the SF cannot be
+ *         changed.
+ *
+ ******************************************************************/
+
+w_rc_t ShoreYCSBEnv::loaddata()
+{
+    // 0. lock the loading status
+    CRITICAL_SECTION(load_cs, _load_mutex);
+    if (_loaded) {
+        TRACE( TRACE_TRX_FLOW,
+               "Env already loaded. Doing nothing...\n");
+        return (RCOK);
+    }
+
+
+    // 1. Create the table and load a number of records
+
+    /* As in TM1, a single thread first loads the first
+       YCSB_RECORDS_TO_PRELOAD records of each loader's partition of
+       the keys, so that the loaders do not all start splitting the
+       same (small) btree.
+     */
+
+    int loaders_to_use = envVar::instance()->getVarInt("db-loaders",YCSB_LOADERS_TO_USE);
+    int creator_loaders_to_use = loaders_to_use;
+
+    int total_recs = get_loaded_records();
+    assert ((total_recs % loaders_to_use) == 0);
+
+    int recs_per_worker = total_recs/loaders_to_use;
+    int preloads_per_worker = envVar::instance()->getVarInt("db-record-preloads",YCSB_RECORDS_TO_PRELOAD);
+
+    // Special case for very small databases where the preloads is larger than
+    // the total records per worker. In that case the table creator does all
+    // the work (no parallel loaders)
+    if (recs_per_worker<preloads_per_worker) {
+        preloads_per_worker = recs_per_worker;
+        loaders_to_use = 0;
+    }
+
+    time_t tstart = time(NULL);
+
+    {
+	guard<table_creator_t> tc;
+	tc = new table_creator_t(this, creator_loaders_to_use, recs_per_worker, preloads_per_worker);
+	tc->fork();
+	tc->join();
+    }
+
+
+    // 2. Fire up the loader threads
+
+    array_guard_t< guard<table_builder_t> > loaders(new guard<table_builder_t>[loaders_to_use]);
+    for (int i=0; i<loaders_to_use; i++) {
+	// the preloader thread picked up a first set of records...
+	int start = i*recs_per_worker + preloads_per_worker;
+	int count = recs_per_worker - preloads_per_worker;
+	loaders[i] = new table_builder_t(this, i, start, count);
+	loaders[i]->fork();
+    }
+
+    for(int i=0; i<loaders_to_use; i++) {
+	loaders[i]->join();
+    }
+
+
+    // 3. Join the loading threads
+    time_t tstop = time(NULL);
+
+    // 4. Print stats
+    TRACE( TRACE_STATISTICS, "Loading finished. %d records loaded in (%d) secs...\n",
+           total_recs, (tstop - tstart));
+
+    // 5. The inserts continue after the loaded keys
+    ycsb_reset_keys(total_recs);
+
+    // 6. Notify that the env is loaded
+    _loaded = true;
+
+    return (RCOK);
+}
+
+
+/******************************************************************
+ *
+ * @fn:    conf()
+ *
+ ******************************************************************/
+
+int ShoreYCSBEnv::conf()
+{
+    // reread the params
+    ShoreEnv::conf();
+    upd_sf();
+    upd_worker_cnt();
+
+    envVar* ev = envVar::instance();
+    y_records_per_sf = ev->getVarInt("ycsb-records-per-sf",YCSB_RECORDS_PER_SF);
+    assert (y_records_per_sf>0);
+
+    // the workload of the YCSB-Mix, if the configuration has one
+    string wl = ev->getSysVar("workload");
+    if (wl != "invalid") {
+        int w = ycsb_workload_from_name(wl.c_str());
+        if (w<0)
+            TRACE( TRACE_ALWAYS, "Invalid YCSB workload (%s). Using (%c)\n",
+                   wl.c_str(), 'A' + y_workload);
+        else
+            y_workload = w;
+    }
+    add_mix(XCT_YCSB_MIX, workload_mix(y_workload));
+    return (0);
+}
+
+
+
+/*********************************************************************
+ *
+ *  @fn:    post_init
+ *
+ *  @brief: On an existing database, the inserts of the previous runs
+ *          are after the loaded records. Finds the largest key so that
+ *          the new inserts continue from there.
+ *
+ *********************************************************************/
+
+int ShoreYCSBEnv::post_init()
+{
+    conf();
+
+    W_COERCE(db()->begin_xct());
+    w_rc_t rc = _post_init_impl();
+    if(rc.is_error()) {
+        cerr << "-> Finding the largest YCSB key failed with: " << rc << endl;
+        rc = db()->abort_xct();
+        return (rc.err_num());
+    }
+    rc = db()->commit_xct();
+    TRACE( TRACE_ALWAYS, "Next YCSB key (%u)\n", *&y_next_key);
+    return (0);
+}
+
+
+w_rc_t ShoreYCSBEnv::_post_init_impl()
+{
+    int loaded = get_loaded_records();
+    int next = loaded;
+
+    tuple_guard<ut_man_impl> prut(_put_man);
+    rep_row_t areprow(_put_man->ts());
+    areprow.set(_put_desc->maxsize());
+    prut->_rep = &areprow;
+
+    rep_row_t lowrep(_put_man->ts());
+    rep_row_t highrep(_put_man->ts());
+    lowrep.set(_put_desc->maxsize());
+    highrep.set(_put_desc->maxsize());
+
+    // scan the keys after the loaded ones, if any
+    guard<index_scan_iter_impl<usertable_t> > ut_iter;
+    {
+        index_scan_iter_impl<usertable_t>* tmp_ut_iter;
+        W_DO(_put_man->ut_get_idx_iter(db(), tmp_ut_iter, prut,
+                                       lowrep, highrep,
+                                       loaded, INT_MAX - loaded,
+                                       SH, true));
+        ut_iter = tmp_ut_iter;
+    }
+
+    // the keys come in order; those missing between them are of inserts
+    // that aborted, and the next inserts take them again
+    ycsb_reset_keys(loaded);
+    bool eof;
+    int key;
+    W_DO(ut_iter->next(db(), eof, *prut));
+    while (!eof) {
+        prut->get_value(0, key);
+        if (key >= next) {
+            for (; next < key; ++next) ycsb_insert_done(next, false);
+            ycsb_insert_done(key, true);
+            next = key + 1;
+        }
+        W_DO(ut_iter->next(db(), eof, *prut));
+    }
+
+    y_next_key = next;
+    return (RCOK);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:   db_print
+ *
+ *  @brief: Prints the current ycsb table to files
+ *
+ *********************************************************************/
+
+w_rc_t ShoreYCSBEnv::db_print(int lines)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    // print table
+    W_DO(_put_man->print_table(_pssm, lines));
+
+    return (RCOK);
+}
+
+
+/*********************************************************************
+ *
+ *  @fn:   db_fetch
+ *
+ *  @brief: Fetches the current ycsb table to buffer pool
+ *
+ *********************************************************************/
+
+w_rc_t ShoreYCSBEnv::db_fetch()
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    // fetch table
+    W_DO(_put_man->fetch_table(_pssm));
+
+    return (RCOK);
+}
+
+
+EXIT_NAMESPACE(ycsb);
@@ -0,0 +1,79 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_ycsb_schema.cpp
+ *
+ *  @brief:  Declaration of the YCSB benchmark table
+ */
+
+#include "workload/ycsb/shore_ycsb_schema.h"
+
+using namespace shore;
+
+ENTER_NAMESPACE(ycsb);
+
+
+
+/*********************************************************************
+ *
+ * YCSB SCHEMA
+ *
+ * This file contains the class for the single table of the YCSB
+ * benchmark.
+ *
+ *********************************************************************/
+
+
+/*
+ * Indices created on the tables are:
+ *
+ * 1. USERTABLE
+ * a. primary (unique) index on usertable(ycsb_key)
+ *
+ * The keys are the integers [0,records), instead of the hashed
+ * "user<n>" strings of the original YCSB, so that the records can be
+ * range-partitioned and scanned in key order.
+ *
+ */
+
+
+usertable_t::usertable_t(const uint4_t& pd)
+    : table_desc_t("USERTABLE", YCSB_FCOUNT, pd)
+{
+    // Schema
+    _desc[0].setup(SQL_INT,         "YCSB_KEY");     // UNIQUE [0..records)
+
+    // FIELD0 .. FIELD9
+    char fname[MAX_FIELDNAME_LEN];
+    for (int i=0; i<YCSB_FIELD_COUNT; i++) {
+        snprintf(fname, sizeof(fname), "FIELD%d", i);
+        _desc[i+1].setup(SQL_FIXCHAR, fname, YCSB_FIELD_LEN);
+    }
+
+    // create unique index ycsb_index on (ycsb_key)
+    uint keys1[1] = { 0 }; // IDX { YCSB_KEY }
+    create_primary_idx_desc("YCSB_IDX", 0, keys1, 1, pd);
+}
+
+
+EXIT_NAMESPACE(ycsb);
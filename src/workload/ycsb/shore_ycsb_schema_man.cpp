@@ -0,0 +1,129 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_ycsb_schema_man.cpp
+ *
+ *  @brief:  Definition of the YCSB table manager
+ */
+
+#include "workload/ycsb/shore_ycsb_schema_man.h"
+
+using namespace shore;
+
+
+ENTER_NAMESPACE(ycsb);
+
+
+/*********************************************************************
+ *
+ * Workload-specific access methods on tables
+ *
+ *********************************************************************/
+
+
+/* ----------------- */
+/* --- USERTABLE --- */
+/* ----------------- */
+
+
+w_rc_t ut_man_impl::ut_idx_probe(ss_m* db,
+                                 ut_tuple* ptuple,
+                                 const int key)
+{
+    assert (ptuple);
+    ptuple->set_value(0, key);
+    return (index_probe_by_name(db, "YCSB_IDX", ptuple));
+}
+
+w_rc_t ut_man_impl::ut_idx_upd(ss_m* db,
+                               ut_tuple* ptuple,
+                               const int key)
+{
+    assert (ptuple);
+    ptuple->set_value(0, key);
+    return (index_probe_forupdate_by_name(db, "YCSB_IDX", ptuple));
+}
+
+w_rc_t ut_man_impl::ut_idx_nl(ss_m* db,
+                              ut_tuple* ptuple,
+                              const int key)
+{
+    assert (ptuple);
+    ptuple->set_value(0, key);
+    return (index_probe_nl_by_name(db, "YCSB_IDX", ptuple));
+}
+
+
+
+w_rc_t ut_man_impl::ut_get_idx_iter(ss_m* db,
+                                    ut_idx_iter* &iter,
+                                    ut_tuple* ptuple,
+                                    rep_row_t &replow,
+                                    rep_row_t &rephigh,
+                                    const int key,
+                                    const int range,
+                                    lock_mode_t alm,
+                                    bool need_tuple)
+{
+    assert (ptuple);
+    assert (range>0);
+
+    // find the index
+    assert (_ptable);
+    index_desc_t* pindex = _ptable->find_index("YCSB_IDX");
+    assert (pindex);
+
+    // YCSB_IDX: { 0 }
+
+    // Low bound
+    ptuple->set_value(0, key);
+    int lowsz = format_key(pindex, ptuple, replow);
+    assert (replow._dest);
+
+    // High bound
+    ptuple->set_value(0, key+range);
+    int highsz = format_key(pindex, ptuple, rephigh);
+    assert (rephigh._dest);
+
+    W_DO(get_iter_for_index_scan(db, pindex, iter,
+                                 alm, need_tuple,
+				 scan_index_i::ge, vec_t(replow._dest, lowsz),
+				 scan_index_i::lt, vec_t(rephigh._dest, highsz)));
+    return (RCOK);
+}
+
+
+w_rc_t ut_man_impl::ut_get_idx_iter_nl(ss_m* db,
+                                       ut_idx_iter* &iter,
+                                       ut_tuple* ptuple,
+                                       rep_row_t &replow,
+                                       rep_row_t &rephigh,
+                                       const int key,
+                                       const int range,
+                                       bool need_tuple)
+{
+    return (ut_get_idx_iter(db,iter,ptuple,replow,rephigh,key,range,NL,need_tuple));
+}
+
+
+EXIT_NAMESPACE(ycsb);
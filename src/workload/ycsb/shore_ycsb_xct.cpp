@@ -0,0 +1,536 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_ycsb_xct.cpp
+ *
+ *  @brief:  Implementation of the Baseline Shore YCSB transactions
+ */
+
+#include "workload/ycsb/shore_ycsb_env.h"
+#include "workload/ycsb/ycsb_input.h"
+
+using namespace shore;
+
+
+ENTER_NAMESPACE(ycsb);
+
+
+
+/********************************************************************
+ *
+ * Thread-local YCSB TRXS Stats
+ *
+ ********************************************************************/
+
+
+static __thread ShoreYCSBTrxStats my_stats;
+
+void ShoreYCSBEnv::env_thread_init()
+{
+    CRITICAL_SECTION(stat_mutex_cs, _statmap_mutex);
+    _statmap[pthread_self()] = &my_stats;
+}
+
+void ShoreYCSBEnv::env_thread_fini()
+{
+    CRITICAL_SECTION(stat_mutex_cs, _statmap_mutex);
+    _statmap.erase(pthread_self());
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    _get_stats
+ *
+ *  @brief: Returns a structure with the currently stats
+ *
+ ********************************************************************/
+
+ShoreYCSBTrxStats ShoreYCSBEnv::_get_stats()
+{
+    CRITICAL_SECTION(cs, _statmap_mutex);
+    ShoreYCSBTrxStats rval;
+    rval -= rval; // dirty hack to set all zeros
+    for (statmap_t::iterator it=_statmap.begin(); it != _statmap.end(); ++it)
+	rval += *it->second;
+    return (rval);
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    reset_stats
+ *
+ *  @brief: Updates the last gathered statistics
+ *
+ ********************************************************************/
+
+void ShoreYCSBEnv::reset_stats()
+{
+    CRITICAL_SECTION(last_stats_cs, _last_stats_mutex);
+    _last_stats = _get_stats();
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    print_throughput
+ *
+ *  @brief: Prints the throughput given measurement delay
+ *
+ ********************************************************************/
+
+void ShoreYCSBEnv::print_throughput(const double iQueriedSF,
+                                    const int iSpread,
+                                    const int iNumOfThreads,
+                                    const double delay,
+                                    const ulong_t mioch,
+                                    const double avgcpuusage)
+{
+    CRITICAL_SECTION(last_stats_cs, _last_stats_mutex);
+
+    // get the current statistics
+    ShoreYCSBTrxStats current_stats = _get_stats();
+
+    // now calculate the diff
+    current_stats -= _last_stats;
+
+    uint trxs_att  = current_stats.attempted.total();
+    uint trxs_abt  = current_stats.failed.total();
+    uint trxs_dld  = current_stats.deadlocked.total();
+
+    TRACE( TRACE_ALWAYS, "*******\n"                \
+           "SF:           (%.1f)\n"                 \
+           "Spread:       (%s)\n"                   \
+           "Threads:      (%d)\n"                   \
+           "Ops R/U/I/S/M:(%d/%d/%d/%d/%d)\n"       \
+           "Trxs Att:     (%d)\n"                   \
+           "Trxs Abt:     (%d)\n"                   \
+           "Trxs Dld:     (%d)\n"                   \
+           "Success Rate: (%.1f%%)\n"               \
+           "Secs:         (%.2f)\n"                 \
+           "IOChars:      (%.2fM/s)\n"              \
+           "AvgCPUs:      (%.1f) (%.1f%%)\n"        \
+           "MQTh/s:       (%.2f)\n",
+           iQueriedSF,
+           (iSpread ? "Yes" : "No"),
+           iNumOfThreads,
+           current_stats.attempted.read_rec,
+           current_stats.attempted.update_rec,
+           current_stats.attempted.insert_rec,
+           current_stats.attempted.scan_rec,
+           current_stats.attempted.rmw_rec,
+           trxs_att, trxs_abt, trxs_dld,
+           ((double)100*(trxs_att-trxs_abt-trxs_dld))/(double)trxs_att,
+           delay, mioch/delay, avgcpuusage,
+           100*avgcpuusage/get_max_cpu_count(),
+           (trxs_att-trxs_abt-trxs_dld)/delay);
+}
+
+
+
+
+/********************************************************************
+ *
+ * YCSB TRXS
+ *
+ * (1) The run_XXX functions are wrappers to the real transactions
+ * (2) The xct_XXX functions are the implementation of the transactions
+ *
+ ********************************************************************/
+
+
+/*********************************************************************
+ *
+ *  @fn:    run_one_xct
+ *
+ *  @brief: Initiates the execution of one YCSB xct
+ *
+ *  @note:  The execution of this trx will not be stopped even if the
+ *          measure internal has expired.
+ *
+ *********************************************************************/
+
+w_rc_t ShoreYCSBEnv::run_one_xct(Request* prequest)
+{
+    assert (prequest);
+
+    // if one of the YCSB workloads, pick one of its operations
+    prequest->set_type(pick_trx(prequest->type()));
+    return (_trxs.run(this, prequest));
+}
+
+
+
+/********************************************************************
+ *
+ * YCSB TRXs Wrappers
+ *
+ * @brief: They are wrappers to the functions that execute the transaction
+ *         body. Their responsibility is to:
+ *
+ *         1. Prepare the corresponding input
+ *         2. Check the return of the trx function and abort the trx,
+ *            if something went wrong
+ *         3. Update the ycsb db environment statistics
+ *
+ ********************************************************************/
+
+
+DEFINE_TRX(ShoreYCSBEnv,read_rec);
+DEFINE_TRX(ShoreYCSBEnv,update_rec);
+DEFINE_RUN_WITH_INPUT_TRX_WRAPPER(ShoreYCSBEnv,insert_rec,insert_rec);
+DEFINE_TRX_STATS(ShoreYCSBEnv,insert_rec);
+DEFINE_TRX(ShoreYCSBEnv,scan_rec);
+DEFINE_TRX(ShoreYCSBEnv,rmw_rec);
+
+// uncomment the line below if want to dump (part of) the trx results
+//#define PRINT_TRX_RESULTS
+
+
+/********************************************************************
+ *
+ * YCSB POPULATE_ONE
+ *
+ * @brief: Inserts the record with the specific key and random fields
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::xct_populate_one(const int key)
+{
+    assert (key>=0);
+
+    // get table tuple from the cache
+    tuple_guard<ut_man_impl> prut(_put_man);
+
+    rep_row_t areprow(_put_man->ts());
+    rep_row_t areprow_key(_put_man->ts());
+    areprow.set(_put_desc->maxsize());
+    areprow_key.set(_put_desc->maxsize());
+    prut->_rep = &areprow;
+    prut->_rep_key = &areprow_key;
+
+    prut->set_value(0, key);
+
+    char afield[STRSIZE(YCSB_FIELD_LEN)];
+    afield[YCSB_FIELD_LEN] = 0;
+    for (int i=0; i<YCSB_FIELD_COUNT; i++) {
+        URandFillStrCaps(afield, YCSB_FIELD_LEN);
+        prut->set_value(i+1, afield);
+    }
+
+    W_DO(_put_man->add_tuple(_pssm, prut));
+
+    TRACE( TRACE_TRX_FLOW, "Added REC - (%d)\n", key);
+    return (RCOK);
+}
+
+
+
+
+/********************************************************************
+ *
+ * YCSB READ
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::xct_read_rec(const int xct_id,
+                                  read_rec_input_t& rrin)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    // Touches 1 table:
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_put_man);
+
+    rep_row_t areprow(_put_man->ts());
+    areprow.set(_put_desc->maxsize());
+    prut->_rep = &areprow;
+
+
+    /* SELECT *
+     * FROM   Usertable
+     * WHERE  ycsb_key = <key>
+     *
+     * plan: index probe on "YCSB_IDX"
+     */
+
+    // 1. retrieve the record (read-only)
+    TRACE( TRACE_TRX_FLOW, "App: %d RD:ut-idx-probe (%d)\n",
+	   xct_id, rrin._key);
+    W_DO(_put_man->ut_idx_probe(_pssm, prut, rrin._key));
+
+    ycsb_rec_t arec;
+    prut->get_value(0, arec.YCSB_KEY);
+    for (int i=0; i<YCSB_FIELD_COUNT; i++)
+        prut->get_value(i+1, arec.FIELD[i], STRSIZE(YCSB_FIELD_LEN));
+
+#ifdef PRINT_TRX_RESULTS
+    // at the end of the transaction
+    // dumps the status of all the table rows used
+    prut->print_tuple();
+#endif
+
+    return RCOK;
+
+} // EOF: READ
+
+
+
+
+/********************************************************************
+ *
+ * YCSB UPDATE
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::xct_update_rec(const int xct_id,
+                                    update_rec_input_t& urin)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    // Touches 1 table:
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_put_man);
+
+    rep_row_t areprow(_put_man->ts());
+    areprow.set(_put_desc->maxsize());
+    prut->_rep = &areprow;
+
+
+    /* UPDATE Usertable
+     * SET    field<field> = <value rnd>
+     * WHERE  ycsb_key = <key>
+     *
+     * plan: index probe on "YCSB_IDX"
+     */
+
+    // 1. update the record
+    TRACE( TRACE_TRX_FLOW, "App: %d UP:ut-idx-upd (%d)\n",
+	   xct_id, urin._key);
+    W_DO(_put_man->ut_idx_upd(_pssm, prut, urin._key));
+
+    char afield[STRSIZE(YCSB_FIELD_LEN)];
+    URandFillStrCaps(afield, YCSB_FIELD_LEN);
+    afield[YCSB_FIELD_LEN] = 0;
+    prut->set_value(urin._field+1, afield);
+    W_DO(_put_man->update_tuple(_pssm, prut));
+
+#ifdef PRINT_TRX_RESULTS
+    // at the end of the transaction
+    // dumps the status of all the table rows used
+    prut->print_tuple();
+#endif
+
+    return RCOK;
+
+} // EOF: UPDATE
+
+
+
+
+/********************************************************************
+ *
+ * YCSB INSERT
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::xct_insert_rec(const int xct_id,
+                                    insert_rec_input_t& irin)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    /* INSERT INTO Usertable
+     * VALUES (<key>, <field0 rnd>, ..., <field9 rnd>)
+     */
+
+    TRACE( TRACE_TRX_FLOW, "App: %d IN:ut-add-tuple (%d)\n",
+	   xct_id, irin._key);
+    return (xct_populate_one(irin._key));
+
+} // EOF: INSERT
+
+
+// As the other run_* without input, but it notes whether the key got
+// inserted, so that the reads see only the committed records
+w_rc_t ShoreYCSBEnv::run_insert_rec(Request* prequest)
+{
+    insert_rec_input_t in;
+    if (prepared_input_t* pin = prequest->input())
+        in = pin->get<insert_rec_input_t>();
+    else
+        in = create_insert_rec_input(_queried_factor, prequest->selectedID());
+    w_rc_t e = run_insert_rec(prequest, in);
+    ycsb_insert_done(in._key, !e.is_error());
+    return (e);
+}
+
+
+
+
+/********************************************************************
+ *
+ * YCSB SCAN
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::xct_scan_rec(const int xct_id,
+                                  scan_rec_input_t& srin)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    // Touches 1 table:
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_put_man);
+
+    rep_row_t areprow(_put_man->ts());
+    areprow.set(_put_desc->maxsize());
+    prut->_rep = &areprow;
+
+    rep_row_t lowrep(_put_man->ts());
+    rep_row_t highrep(_put_man->ts());
+    lowrep.set(_put_desc->maxsize());
+    highrep.set(_put_desc->maxsize());
+
+    bool eof;
+    ycsb_rec_t arec;
+
+
+    /* SELECT *
+     * FROM   Usertable
+     * WHERE  ycsb_key >= <key>
+     * AND    ycsb_key <  <key> + <len>
+     *
+     * plan: iter on index "YCSB_IDX"
+     */
+
+    // 1. retrieve the records (read-only)
+    guard<index_scan_iter_impl<usertable_t> > ut_iter;
+    {
+	index_scan_iter_impl<usertable_t>* tmp_ut_iter;
+	TRACE( TRACE_TRX_FLOW, "App: %d SC:ut-idx-iter (%d) (%d)\n",
+	       xct_id, srin._key, srin._len);
+	W_DO(_put_man->ut_get_idx_iter(_pssm, tmp_ut_iter, prut,
+				       lowrep, highrep,
+				       srin._key, srin._len));
+	ut_iter = tmp_ut_iter;
+    }
+
+    W_DO(ut_iter->next(_pssm, eof, *prut));
+    while (!eof) {
+	prut->get_value(0, arec.YCSB_KEY);
+        for (int i=0; i<YCSB_FIELD_COUNT; i++)
+            prut->get_value(i+1, arec.FIELD[i], STRSIZE(YCSB_FIELD_LEN));
+	TRACE( TRACE_TRX_FLOW, "App: %d SC: read (%d)\n",
+	       xct_id, arec.YCSB_KEY);
+	W_DO(ut_iter->next(_pssm, eof, *prut));
+    }
+
+#ifdef PRINT_TRX_RESULTS
+    // at the end of the transaction
+    // dumps the status of all the table rows used
+    prut->print_tuple();
+#endif
+
+    return RCOK;
+
+} // EOF: SCAN
+
+
+
+
+/********************************************************************
+ *
+ * YCSB READ-MODIFY-WRITE
+ *
+ ********************************************************************/
+
+w_rc_t ShoreYCSBEnv::xct_rmw_rec(const int xct_id,
+                                 rmw_rec_input_t& mrin)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    // Touches 1 table:
+    // Usertable
+    tuple_guard<ut_man_impl> prut(_put_man);
+
+    rep_row_t areprow(_put_man->ts());
+    areprow.set(_put_desc->maxsize());
+    prut->_rep = &areprow;
+
+
+    /* SELECT *
+     * FROM   Usertable
+     * WHERE  ycsb_key = <key>
+     *
+     * UPDATE Usertable
+     * SET    field<field> = <value rnd>
+     * WHERE  ycsb_key = <key>
+     *
+     * plan: index probe on "YCSB_IDX"
+     */
+
+    // 1. read the record, for update
+    TRACE( TRACE_TRX_FLOW, "App: %d RMW:ut-idx-upd (%d)\n",
+	   xct_id, mrin._key);
+    W_DO(_put_man->ut_idx_upd(_pssm, prut, mrin._key));
+
+    ycsb_rec_t arec;
+    prut->get_value(0, arec.YCSB_KEY);
+    for (int i=0; i<YCSB_FIELD_COUNT; i++)
+        prut->get_value(i+1, arec.FIELD[i], STRSIZE(YCSB_FIELD_LEN));
+
+    // 2. write back one of its fields
+    URandFillStrCaps(arec.FIELD[mrin._field], YCSB_FIELD_LEN);
+    arec.FIELD[mrin._field][YCSB_FIELD_LEN] = 0;
+    prut->set_value(mrin._field+1, arec.FIELD[mrin._field]);
+    W_DO(_put_man->update_tuple(_pssm, prut));
+
+#ifdef PRINT_TRX_RESULTS
+    // at the end of the transaction
+    // dumps the status of all the table rows used
+    prut->print_tuple();
+#endif
+
+    return RCOK;
+
+} // EOF: RMW
+
+
+EXIT_NAMESPACE(ycsb);
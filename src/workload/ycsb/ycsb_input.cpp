@@ -0,0 +1,282 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:  ycsb_input.cpp
+ *
+ *  @brief: Implementation of the (common) inputs for the YCSB trxs
+ */
+
+#include "k_defines.h"
+
+#include <set>
+#include <vector>
+
+#include "workload/ycsb/ycsb_input.h"
+
+ENTER_NAMESPACE(ycsb);
+
+
+// key distribution of the records, set by ShoreYCSBEnv::set_keydist()
+keydist_t y_keydist;
+
+// set by ShoreYCSBEnv::conf()
+int y_records_per_sf = YCSB_RECORDS_PER_SF;
+
+// set by ShoreYCSBEnv after loading, or after scanning an existing db
+volatile unsigned int y_next_key = 0;
+volatile unsigned int y_committed_key = 0;
+
+// set by ShoreYCSBEnv::conf()
+int y_workload = YCSB_WORKLOAD_A;
+
+
+/* ------------------------ */
+/* --- INSERTED RECORDS --- */
+/* ------------------------ */
+
+// The inserts take their keys before they commit, and they commit (or
+// abort) out of order. The keys that committed above y_committed_key
+// wait in _ycsb_committed, the aborted ones in _ycsb_free until an
+// insert takes them again.
+static pthread_mutex_t    _ycsb_keys_mutex = PTHREAD_MUTEX_INITIALIZER;
+static std::set<int>      _ycsb_committed;
+static std::vector<int>   _ycsb_free;
+static volatile unsigned int _ycsb_free_cnt = 0;
+
+void ycsb_insert_done(const int key, const bool committed)
+{
+    CRITICAL_SECTION(cs, _ycsb_keys_mutex);
+    if (!committed) {
+        _ycsb_free.push_back(key);
+        _ycsb_free_cnt = _ycsb_free.size();
+        return;
+    }
+
+    if (key != (int)y_committed_key) {
+        _ycsb_committed.insert(key);
+        return;
+    }
+    int next = key + 1;
+    std::set<int>::iterator it = _ycsb_committed.begin();
+    while (it != _ycsb_committed.end() && *it == next) {
+        _ycsb_committed.erase(it++);
+        ++next;
+    }
+    y_committed_key = next;
+}
+
+void ycsb_reset_keys(const int next)
+{
+    CRITICAL_SECTION(cs, _ycsb_keys_mutex);
+    _ycsb_committed.clear();
+    _ycsb_free.clear();
+    _ycsb_free_cnt = 0;
+    y_committed_key = next;
+    y_next_key = next;
+}
+
+// an aborted key to insert again, if there is one
+static bool _ycsb_reuse_key(int& key)
+{
+    if (*&_ycsb_free_cnt == 0) return (false);
+
+    CRITICAL_SECTION(cs, _ycsb_keys_mutex);
+    if (_ycsb_free.empty()) return (false);
+    key = _ycsb_free.back();
+    _ycsb_free.pop_back();
+    _ycsb_free_cnt = _ycsb_free.size();
+    return (true);
+}
+
+
+
+/* ------------------- */
+/* --- KEY PICKING --- */
+/* ------------------- */
+
+// Picks the key of a read/update/scan/rmw. With the "latest" distribution
+// the most popular key is the last one inserted, so the ranks are counted
+// back from y_committed_key instead of from the last loaded record. The
+// keys above it may not be there yet.
+static int _ycsb_key(int sf, int specificSF)
+{
+    assert (sf>0);
+
+    if (specificSF>0)
+        return ((specificSF-1)*y_records_per_sf + y_keydist.next(y_records_per_sf));
+
+    if (y_keydist.spec()._type == KD_LATEST) {
+        int inserted = *&y_committed_key - y_keydist.n();
+        return (y_keydist.next() + (inserted>0 ? inserted : 0));
+    }
+
+    return (y_keydist.next(sf*y_records_per_sf));
+}
+
+
+
+/* ---------------- */
+/* --- READ_REC --- */
+/* ---------------- */
+
+
+read_rec_input_t create_read_rec_input(int sf,
+                                       int specificSF)
+{
+    read_rec_input_t rrin;
+    rrin._key = _ycsb_key(sf, specificSF);
+    return (rrin);
+}
+
+
+
+/* ------------------ */
+/* --- UPDATE_REC --- */
+/* ------------------ */
+
+
+update_rec_input_t create_update_rec_input(int sf,
+                                           int specificSF)
+{
+    update_rec_input_t urin;
+    urin._key = _ycsb_key(sf, specificSF);
+    urin._field = URand(0, YCSB_FIELD_COUNT-1);
+    return (urin);
+}
+
+
+
+/* ------------------ */
+/* --- INSERT_REC --- */
+/* ------------------ */
+
+
+insert_rec_input_t create_insert_rec_input(int sf,
+                                           int /* specificSF */)
+{
+    assert (sf>0);
+
+    // Every insert takes the next key, or one whose insert aborted, so
+    // that the keys below y_next_key end up all inserted
+    insert_rec_input_t irin;
+    if (!_ycsb_reuse_key(irin._key))
+        irin._key = atomic_inc_uint_nv(&y_next_key) - 1;
+    return (irin);
+}
+
+
+
+/* ---------------- */
+/* --- SCAN_REC --- */
+/* ---------------- */
+
+
+scan_rec_input_t create_scan_rec_input(int sf,
+                                       int specificSF)
+{
+    scan_rec_input_t srin;
+    srin._key = _ycsb_key(sf, specificSF);
+    srin._len = URand(1, YCSB_MAX_SCAN_LEN);
+    return (srin);
+}
+
+
+
+/* --------------- */
+/* --- RMW_REC --- */
+/* --------------- */
+
+
+rmw_rec_input_t create_rmw_rec_input(int sf,
+                                     int specificSF)
+{
+    rmw_rec_input_t mrin;
+    mrin._key = _ycsb_key(sf, specificSF);
+    mrin._field = URand(0, YCSB_FIELD_COUNT-1);
+    return (mrin);
+}
+
+
+
+
+/* ------------------- */
+/* --- YCSB MIXES  --- */
+/* ------------------- */
+
+// The percentage of each operation in the core workloads, in the
+// order of the XCT_YCSB_{READ,UPDATE,INSERT,SCAN,RMW} ids
+const int YCSB_OPS = 5;
+
+static const int ycsb_mix[YCSB_WORKLOADS][YCSB_OPS] = {
+    //  READ  UPD  INS  SCAN  RMW
+    {    50,   50,   0,    0,   0 },   // A
+    {    95,    5,   0,    0,   0 },   // B
+    {   100,    0,   0,    0,   0 },   // C
+    {    95,    0,   5,    0,   0 },   // D
+    {     0,    0,   5,   95,   0 },   // E
+    {    50,    0,   0,    0,  50 }    // F
+};
+
+
+int random_ycsb_xct_type(const int workload, const int selected)
+{
+    assert ((workload>=0) && (workload<YCSB_WORKLOADS));
+    assert ((selected>=0) && (selected<100));
+
+    int sum = 0;
+    for (int i=0; i<YCSB_OPS; i++) {
+        sum += ycsb_mix[workload][i];
+        if (selected < sum)
+            return (XCT_YCSB_READ + i);
+    }
+
+    // should not reach this point
+    assert (0);
+    return (0);
+}
+
+
+int ycsb_op_pct(const int workload, const int xct_type)
+{
+    assert ((workload>=0) && (workload<YCSB_WORKLOADS));
+    assert ((xct_type>=XCT_YCSB_READ) && (xct_type<XCT_YCSB_READ+YCSB_OPS));
+    return (ycsb_mix[workload][xct_type - XCT_YCSB_READ]);
+}
+
+
+int ycsb_workload_from_name(const char* name)
+{
+    assert (name);
+    if ((name[0]==0) || (name[1]!=0))
+        return (-1);
+
+    char c = name[0];
+    if ((c>='A') && (c<='Z'))
+        c = c - 'A' + 'a';
+    int w = c - 'a';
+    return (((w>=0) && (w<YCSB_WORKLOADS)) ? w : -1);
+}
+
+
+
+EXIT_NAMESPACE(ycsb);